@@ -86,6 +86,19 @@ static void RxNewData
                 LE_ASSERT(write(fd, "\r\n359377060033064\r\n\r\nOK\r\n", 25) == 25);
                 return;
             }
+            else if (strcmp(buffer, "AT+URC\r") == 0)
+            {
+                static const char urc[] = "\r\nOK\r\n"
+                                          "\r\n+CREG: 1\r\n"
+                                          "\r\n+CMT: \"123\"\r\nhello\r\n"
+                                          "\r\n+CGREG: 2\r\n"
+                                          "\r\nRING\r\n";
+
+                LE_INFO("Received AT command: %s", buffer);
+                // Send the response of AT command, followed by unsolicited responses
+                LE_ASSERT(write(fd, urc, sizeof(urc) - 1) == sizeof(urc) - 1);
+                return;
+            }
         }
     }
 }
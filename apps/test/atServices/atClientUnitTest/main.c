@@ -120,6 +120,97 @@ void Testle_atClientSendFalseTest
                                                           "OK|ERROR|+CME ERROR", 1));
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited responses received by the handlers
+ */
+//--------------------------------------------------------------------------------------------------
+static char UnsolCreg[LE_ATDEFS_UNSOLICITED_MAX_BYTES];
+static char UnsolCmt[LE_ATDEFS_UNSOLICITED_MAX_BYTES];
+static int UnsolPrefixCount;
+static le_sem_Ref_t UnsolSem;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited response handler storing the response in the buffer given as context
+ */
+//--------------------------------------------------------------------------------------------------
+static void StoreUnsolHandler
+(
+    const char* unsolicitedRsp,
+    void* contextPtr
+)
+{
+    LE_INFO("Unsolicited: %s", unsolicitedRsp);
+    le_utf8_Copy(contextPtr, unsolicitedRsp, LE_ATDEFS_UNSOLICITED_MAX_BYTES, NULL);
+    le_sem_Post(UnsolSem);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited response handler counting the responses
+ */
+//--------------------------------------------------------------------------------------------------
+static void CountUnsolHandler
+(
+    const char* unsolicitedRsp,
+    void* contextPtr
+)
+{
+    LE_INFO("Unsolicited prefix: %s", unsolicitedRsp);
+    UnsolPrefixCount++;
+    le_sem_Post(UnsolSem);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the unsolicited responses matching, including patterns sharing a prefix and multi-line
+ * unsolicited responses.
+ */
+//--------------------------------------------------------------------------------------------------
+void Testle_atClientUnsolicited
+(
+    le_atClient_DeviceRef_t devRef
+)
+{
+    le_atClient_UnsolicitedResponseHandlerRef_t cregRef;
+    le_atClient_UnsolicitedResponseHandlerRef_t cmtRef;
+    le_atClient_UnsolicitedResponseHandlerRef_t prefixRef;
+    le_atClient_CmdRef_t cmdRef;
+    le_clk_Time_t timeToWait = {CLIENT_TIMEOUT, 0};
+    int i;
+
+    UnsolSem = le_sem_Create("UnsolSem", 0);
+
+    cregRef = le_atClient_AddUnsolicitedResponseHandler("+CREG:", devRef, StoreUnsolHandler,
+                                                        UnsolCreg, 1);
+    cmtRef = le_atClient_AddUnsolicitedResponseHandler("+CMT:", devRef, StoreUnsolHandler,
+                                                       UnsolCmt, 2);
+    prefixRef = le_atClient_AddUnsolicitedResponseHandler("+C", devRef, CountUnsolHandler,
+                                                          NULL, 1);
+    LE_ASSERT((cregRef != NULL) && (cmtRef != NULL) && (prefixRef != NULL));
+
+    LE_ASSERT_OK(le_atClient_SetCommandAndSend(&cmdRef, devRef, "AT+URC", "", "OK|ERROR",
+                                               LE_ATDEFS_COMMAND_DEFAULT_TIMEOUT));
+    LE_ASSERT_OK(le_atClient_Delete(cmdRef));
+
+    // "+CREG:" once, "+CMT:" once, and "+C" for each of the three lines it starts.
+    for (i = 0; i < 5; i++)
+    {
+        LE_ASSERT_OK(le_sem_WaitWithTimeOut(UnsolSem, timeToWait));
+    }
+
+    LE_ASSERT(strcmp(UnsolCreg, "+CREG: 1") == 0);
+    LE_ASSERT(strcmp(UnsolCmt, "+CMT: \"123\"\r\nhello") == 0);
+    LE_ASSERT(UnsolPrefixCount == 3);
+
+    le_atClient_RemoveUnsolicitedResponseHandler(cregRef);
+    le_atClient_RemoveUnsolicitedResponseHandler(cmtRef);
+    le_atClient_RemoveUnsolicitedResponseHandler(prefixRef);
+
+    le_sem_Delete(UnsolSem);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Client thread function
@@ -193,6 +284,8 @@ static void* AtClient
               == LE_NOT_FOUND);
     LE_ASSERT(le_atClient_Delete(cmdRef) == LE_OK);
 
+    Testle_atClientUnsolicited(devRef);
+
     // Try to stop the device
     LE_ASSERT_OK(le_atClient_Stop(devRef));
     LE_ASSERT(le_atClient_Stop(devRef) == LE_FAULT);
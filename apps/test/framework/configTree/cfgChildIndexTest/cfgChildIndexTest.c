@@ -0,0 +1,333 @@
+/**
+ * This module tests looking up the children of a wide config tree node, after the node's children
+ * have been indexed: once they have been added to, deleted, renamed or cleared, in a shadow tree
+ * and once the shadow tree has been merged.  It is built with its own copy of treeDb.c, which keeps
+ * its files in CFG_TREE_FILE_DIR.
+ *
+ * With LE_CONFIG_CFGTREE_CHILD_INDEX disabled, the same lookups go through the child lists.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "dynamicString.h"
+#include "treeDb.h"
+
+/// Name of the tree used.
+#define TREE_NAME       "childIndex"
+
+/// Number of children the wide node starts with.  Enough for it to be indexed.
+#define NUM_CHILDREN    100
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a node under the root of a tree.
+ *
+ * @return The node, or NULL if it doesn't exist.
+ */
+//--------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t GetNode
+(
+    tdb_NodeRef_t   rootRef,
+    const char*     pathPtr     ///< [IN] Path of the node, from the root.
+)
+{
+    le_pathIter_Ref_t pathRef = le_pathIter_CreateForUnix(pathPtr);
+    tdb_NodeRef_t nodeRef = tdb_GetNode(rootRef, pathRef);
+    le_pathIter_Delete(pathRef);
+
+    return nodeRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a child of the wide node.
+ *
+ * @return The node, or NULL if it doesn't exist.
+ */
+//--------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t GetChild
+(
+    tdb_NodeRef_t   rootRef,
+    const char*     namePtr     ///< [IN] Name of the child.
+)
+{
+    char path[LE_CFG_STR_LEN_BYTES];
+
+    LE_ASSERT(snprintf(path, sizeof(path), "wide/%s", namePtr) < (int)sizeof(path));
+
+    return GetNode(rootRef, path);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a child of the wide node exists.  Deleted nodes of a shadow tree can still be
+ * found, but don't exist.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ChildExists
+(
+    tdb_NodeRef_t   rootRef,
+    const char*     namePtr     ///< [IN] Name of the child.
+)
+{
+    return tdb_GetNodeType(GetChild(rootRef, namePtr)) != LE_CFG_TYPE_DOESNT_EXIST;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the value of a child of the wide node, creating it if needed.  Only valid on a shadow tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetChild
+(
+    tdb_NodeRef_t   rootRef,
+    const char*     namePtr,    ///< [IN] Name of the child.
+    int32_t         value       ///< [IN] Value to set.
+)
+{
+    char path[LE_CFG_STR_LEN_BYTES];
+
+    LE_ASSERT(snprintf(path, sizeof(path), "wide/%s", namePtr) < (int)sizeof(path));
+
+    le_pathIter_Ref_t pathRef = le_pathIter_CreateForUnix(path);
+    tdb_NodeRef_t nodeRef = tdb_CreateNodePath(rootRef, pathRef);
+    le_pathIter_Delete(pathRef);
+
+    LE_ASSERT(nodeRef != NULL);
+    tdb_SetValueAsInt(nodeRef, value);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the wide node's children "child<first>" to "child<last - 1>" can all be found, and
+ * hold their number as their value.
+ *
+ * @return true if they all can.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckChildren
+(
+    tdb_NodeRef_t   rootRef,
+    int             first,      ///< [IN] Number of the first child.
+    int             last        ///< [IN] Number after the last child.
+)
+{
+    char name[LE_CFG_NAME_LEN_BYTES];
+    int i;
+
+    for (i = first; i < last; i++)
+    {
+        snprintf(name, sizeof(name), "child%d", i);
+
+        if (tdb_GetValueAsInt(GetChild(rootRef, name), -1) != i)
+        {
+            LE_TEST_INFO("child%d is missing or has the wrong value", i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Give the wide node its children, and look them all up so that they're indexed.  Then add as
+ * many again, so that the index has to grow.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestAdd
+(
+    void
+)
+{
+    char name[LE_CFG_NAME_LEN_BYTES];
+    tdb_TreeRef_t shadowTreeRef;
+    tdb_NodeRef_t shadowRootRef;
+    int i;
+
+    shadowTreeRef = tdb_ShadowTree(tdb_GetTree(TREE_NAME));
+    shadowRootRef = tdb_GetRootNode(shadowTreeRef);
+    for (i = 0; i < NUM_CHILDREN; i++)
+    {
+        snprintf(name, sizeof(name), "child%d", i);
+        SetChild(shadowRootRef, name, i);
+    }
+    LE_TEST_OK(CheckChildren(shadowRootRef, 0, NUM_CHILDREN), "children found in shadow tree");
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+
+    tdb_NodeRef_t rootRef = tdb_GetRootNode(tdb_GetTree(TREE_NAME));
+    LE_TEST_OK(CheckChildren(rootRef, 0, NUM_CHILDREN), "children found after merge");
+    LE_TEST_OK(!ChildExists(rootRef, "missing"), "child that was never added isn't found");
+
+    shadowTreeRef = tdb_ShadowTree(tdb_GetTree(TREE_NAME));
+    shadowRootRef = tdb_GetRootNode(shadowTreeRef);
+    for (i = NUM_CHILDREN; i < 2 * NUM_CHILDREN; i++)
+    {
+        snprintf(name, sizeof(name), "child%d", i);
+        SetChild(shadowRootRef, name, i);
+    }
+    LE_TEST_OK(CheckChildren(shadowRootRef, 0, 2 * NUM_CHILDREN),
+               "old and new children found in shadow tree");
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+
+    LE_TEST_OK(CheckChildren(rootRef, 0, 2 * NUM_CHILDREN),
+               "old and new children found after merge");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete some children, then add one of them back.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestDelete
+(
+    void
+)
+{
+    tdb_TreeRef_t shadowTreeRef;
+    tdb_NodeRef_t shadowRootRef;
+    tdb_NodeRef_t rootRef = tdb_GetRootNode(tdb_GetTree(TREE_NAME));
+
+    shadowTreeRef = tdb_ShadowTree(tdb_GetTree(TREE_NAME));
+    shadowRootRef = tdb_GetRootNode(shadowTreeRef);
+    tdb_DeleteNode(GetChild(shadowRootRef, "child0"));
+    tdb_DeleteNode(GetChild(shadowRootRef, "child50"));
+    tdb_DeleteNode(GetChild(shadowRootRef, "child199"));
+    LE_TEST_OK(   !ChildExists(shadowRootRef, "child0")
+               && !ChildExists(shadowRootRef, "child50")
+               && !ChildExists(shadowRootRef, "child199"),
+               "deleted children are gone from shadow tree");
+    LE_TEST_OK(ChildExists(rootRef, "child50"), "deleted child is still in the tree until merged");
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+
+    LE_TEST_OK(   (GetChild(rootRef, "child0") == NULL)
+               && (GetChild(rootRef, "child50") == NULL)
+               && (GetChild(rootRef, "child199") == NULL),
+               "deleted children are gone after merge");
+    LE_TEST_OK(   CheckChildren(rootRef, 1, 50)
+               && CheckChildren(rootRef, 51, 2 * NUM_CHILDREN - 1),
+               "other children are still found after merge");
+
+    shadowTreeRef = tdb_ShadowTree(tdb_GetTree(TREE_NAME));
+    shadowRootRef = tdb_GetRootNode(shadowTreeRef);
+    SetChild(shadowRootRef, "child50", 50);
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+
+    LE_TEST_OK(CheckChildren(rootRef, 50, 51), "deleted child is found once added back");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rename a child, then reuse its old name for a new child.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestRename
+(
+    void
+)
+{
+    tdb_TreeRef_t shadowTreeRef;
+    tdb_NodeRef_t shadowRootRef;
+    tdb_NodeRef_t rootRef = tdb_GetRootNode(tdb_GetTree(TREE_NAME));
+
+    shadowTreeRef = tdb_ShadowTree(tdb_GetTree(TREE_NAME));
+    shadowRootRef = tdb_GetRootNode(shadowTreeRef);
+    LE_TEST_OK(tdb_SetNodeName(GetChild(shadowRootRef, "child7"), "child8") == LE_DUPLICATE,
+               "renaming to a sibling's name is refused");
+    LE_TEST_ASSERT(tdb_SetNodeName(GetChild(shadowRootRef, "child7"), "renamed") == LE_OK,
+                   "child is renamed");
+    LE_TEST_OK(   (tdb_GetValueAsInt(GetChild(shadowRootRef, "renamed"), -1) == 7)
+               && !ChildExists(shadowRootRef, "child7"),
+               "renamed child is found by its new name only in shadow tree");
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+
+    LE_TEST_OK(   (tdb_GetValueAsInt(GetChild(rootRef, "renamed"), -1) == 7)
+               && (GetChild(rootRef, "child7") == NULL),
+               "renamed child is found by its new name only after merge");
+
+    shadowTreeRef = tdb_ShadowTree(tdb_GetTree(TREE_NAME));
+    shadowRootRef = tdb_GetRootNode(shadowTreeRef);
+    SetChild(shadowRootRef, "child7", 7);
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+
+    LE_TEST_OK(   CheckChildren(rootRef, 7, 8)
+               && (tdb_GetValueAsInt(GetChild(rootRef, "renamed"), -1) == 7),
+               "old name can be used for a new child");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear the wide node, then give it one child again.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestClear
+(
+    void
+)
+{
+    tdb_TreeRef_t shadowTreeRef;
+    tdb_NodeRef_t shadowRootRef;
+    tdb_NodeRef_t rootRef = tdb_GetRootNode(tdb_GetTree(TREE_NAME));
+
+    shadowTreeRef = tdb_ShadowTree(tdb_GetTree(TREE_NAME));
+    shadowRootRef = tdb_GetRootNode(shadowTreeRef);
+    tdb_SetEmpty(GetNode(shadowRootRef, "wide"));
+    LE_TEST_OK(   !ChildExists(shadowRootRef, "child1")
+               && !ChildExists(shadowRootRef, "renamed"),
+               "children of the cleared node are gone from shadow tree");
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+
+    LE_TEST_OK(   (GetChild(rootRef, "child1") == NULL)
+               && (GetChild(rootRef, "renamed") == NULL),
+               "children of the cleared node are gone after merge");
+
+    shadowTreeRef = tdb_ShadowTree(tdb_GetTree(TREE_NAME));
+    shadowRootRef = tdb_GetRootNode(shadowTreeRef);
+    SetChild(shadowRootRef, "child1", 1);
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+
+    LE_TEST_OK(   CheckChildren(rootRef, 1, 2)
+               && (GetChild(rootRef, "child2") == NULL),
+               "only the new child is found in the cleared node");
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    le_dir_RemoveRecursive(CFG_TREE_FILE_DIR);
+    LE_TEST_ASSERT(le_dir_MakePath(CFG_TREE_FILE_DIR, S_IRWXU) == LE_OK,
+                   "create directory for tree files");
+
+    dstr_Init();
+    tdb_Init();
+
+    TestAdd();
+    TestDelete();
+    TestRename();
+    TestClear();
+
+    le_dir_RemoveRecursive(CFG_TREE_FILE_DIR);
+
+    LE_TEST_EXIT;
+}
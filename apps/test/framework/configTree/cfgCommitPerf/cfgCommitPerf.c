@@ -0,0 +1,166 @@
+/**
+ * cfgCommitPerf.c
+ *
+ * Config tree commit latency benchmark.  Fills the app's tree with trees of increasing size and
+ * measures how long it takes to commit a write transaction that changes a single value.  With
+ * LE_CONFIG_CFGTREE_JOURNAL enabled this should stay flat as the tree grows, while rewriting the
+ * whole tree file on every commit grows with the size of the tree.  After each size is timed, every
+ * value is read back to check that the commits took effect.
+ *
+ * The last tree is left in place, so that the journal replay can be checked too: restart the
+ * config tree (e.g., "legato restart"), which reloads the tree file and replays the journal, then
+ * run "app runProc cfgCommitPerf --exe=cfgCommitPerf -- check" to read the values back again and
+ * delete the tree.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "timing.h"
+
+// Root of config tree to test
+#define TEST_ROOT_NODE "/cfgCommitPerf"
+
+// Number of single-value commits timed for each tree size.
+#define NUM_COMMITS     50
+
+// Number of nodes in each branch of the generated trees.
+#define BRANCH_SIZE     100
+
+// Value written to each node of the generated trees.
+#define FILL_VALUE      "The quick brown fox jumps over the lazy dog."
+
+// Tree sizes to test, in nodes.
+static const int TreeSizes[] = { 100, 1000, 5000 };
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill the test tree with the given number of values, in a single transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillTree
+(
+    int numNodes    ///< [IN] Number of values to create.
+)
+{
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(TEST_ROOT_NODE);
+    char path[LE_CFG_STR_LEN_BYTES];
+    int i;
+
+    le_cfg_DeleteNode(iterRef, "");
+
+    for (i = 0; i < numNodes; i++)
+    {
+        snprintf(path, sizeof(path), "branch%d/value%d", i / BRANCH_SIZE, i % BRANCH_SIZE);
+        le_cfg_SetString(iterRef, path, FILL_VALUE);
+    }
+
+    le_cfg_CommitTxn(iterRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time NUM_COMMITS transactions that each change one value.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TimeCommits
+(
+    int numNodes    ///< [IN] Number of values in the tree.
+)
+{
+    timing_Stats_t stats;
+    int i;
+
+    timing_InitStats(&stats);
+
+    for (i = 0; i < NUM_COMMITS; i++)
+    {
+        le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(TEST_ROOT_NODE);
+
+        le_cfg_SetInt(iterRef, "branch0/counter", i);
+
+        uint64_t startUs = timing_GetTimeUs();
+        le_cfg_CommitTxn(iterRef);
+        timing_AddSample(&stats, timing_GetTimeUs() - startUs);
+    }
+
+    LE_TEST_INFO("%5d nodes: commit avg %" PRIu64 " us, min %" PRIu64 " us, max %" PRIu64 " us",
+                 numNodes,
+                 stats.totalUs / stats.count,
+                 stats.minUs,
+                 stats.maxUs);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the test tree back and check that it holds what FillTree() and TimeCommits() wrote.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckTree
+(
+    int numNodes,       ///< [IN] Number of values that should be in the tree.
+    const char* when    ///< [IN] When the check is made, for the test results.
+)
+{
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateReadTxn(TEST_ROOT_NODE);
+    char path[LE_CFG_STR_LEN_BYTES];
+    char value[sizeof(FILL_VALUE)];
+    int badCount = 0;
+    int i;
+
+    LE_TEST_OK(le_cfg_GetInt(iterRef, "branch0/counter", -1) == NUM_COMMITS - 1,
+               "%5d nodes: last committed counter read back %s", numNodes, when);
+
+    for (i = 0; i < numNodes; i++)
+    {
+        snprintf(path, sizeof(path), "branch%d/value%d", i / BRANCH_SIZE, i % BRANCH_SIZE);
+
+        if (   (le_cfg_GetString(iterRef, path, value, sizeof(value), "") != LE_OK)
+            || (strcmp(value, FILL_VALUE) != 0))
+        {
+            badCount++;
+        }
+    }
+
+    snprintf(path, sizeof(path), "branch%d/value%d", numNodes / BRANCH_SIZE,
+             numNodes % BRANCH_SIZE);
+
+    LE_TEST_OK((badCount == 0) && !le_cfg_NodeExists(iterRef, path),
+               "%5d nodes: all values read back %s (%d wrong)", numNodes, when, badCount);
+
+    le_cfg_CancelTxn(iterRef);
+}
+
+
+COMPONENT_INIT
+{
+    int lastSize = TreeSizes[NUM_ARRAY_MEMBERS(TreeSizes) - 1];
+    size_t i;
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    if ((le_arg_NumArgs() == 1) && (strcmp(le_arg_GetArg(0), "check") == 0))
+    {
+        // The config tree has been restarted since the last run, so this reads the tree file and
+        // the journal written by it.
+        CheckTree(lastSize, "after reload");
+        le_cfg_QuickDeleteNode(TEST_ROOT_NODE);
+
+        LE_TEST_EXIT;
+    }
+
+    LE_TEST_INFO("Timing %d single-value commits per tree size.", NUM_COMMITS);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(TreeSizes); i++)
+    {
+        FillTree(TreeSizes[i]);
+        TimeCommits(TreeSizes[i]);
+        CheckTree(TreeSizes[i], "after commit");
+    }
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,111 @@
+/**
+ * cfgLookupPerf.c
+ *
+ * Config tree lookup benchmark.  Builds a synthetic 100k-node tree in the app's tree, shaped like
+ * the system tree's apps collection (many wide nodes), then measures how many random deep-path
+ * value reads the config tree can serve per second.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "timing.h"
+
+// Root of config tree to test
+#define TEST_ROOT_NODE "/cfgLookupPerf"
+
+// Shape of the tree: NUM_APPS apps, each with NUM_VALUES values, for 100k nodes in total.
+#define NUM_APPS        1000
+#define NUM_VALUES      100
+
+// Number of lookups to time.
+#define NUM_LOOKUPS     20000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the test tree, one app per transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillTree
+(
+    void
+)
+{
+    char path[LE_CFG_STR_LEN_BYTES];
+    int app;
+    int value;
+
+    le_cfg_QuickDeleteNode(TEST_ROOT_NODE);
+
+    for (app = 0; app < NUM_APPS; app++)
+    {
+        snprintf(path, sizeof(path), TEST_ROOT_NODE "/apps/app%d/procs", app);
+
+        le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(path);
+
+        for (value = 0; value < NUM_VALUES; value++)
+        {
+            snprintf(path, sizeof(path), "value%d", value);
+            le_cfg_SetInt(iterRef, path, app * NUM_VALUES + value);
+        }
+
+        le_cfg_CommitTxn(iterRef);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read NUM_LOOKUPS random values by absolute path, checking each one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TimeLookups
+(
+    void
+)
+{
+    char path[LE_CFG_STR_LEN_BYTES];
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateReadTxn(TEST_ROOT_NODE);
+    int i;
+
+    srand(1);
+
+    uint64_t startUs = timing_GetTimeUs();
+
+    for (i = 0; i < NUM_LOOKUPS; i++)
+    {
+        int app = rand() % NUM_APPS;
+        int value = rand() % NUM_VALUES;
+
+        snprintf(path, sizeof(path), TEST_ROOT_NODE "/apps/app%d/procs/value%d", app, value);
+        LE_ASSERT(le_cfg_GetInt(iterRef, path, -1) == app * NUM_VALUES + value);
+    }
+
+    uint64_t elapsedUs = timing_GetTimeUs() - startUs;
+
+    le_cfg_CancelTxn(iterRef);
+
+    LE_INFO("%d lookups in a %d node tree took %" PRIu64 " ms: %" PRIu64 " lookups/s",
+            NUM_LOOKUPS,
+            NUM_APPS * NUM_VALUES,
+            elapsedUs / 1000,
+            (uint64_t)NUM_LOOKUPS * 1000000 / (elapsedUs ? elapsedUs : 1));
+}
+
+
+COMPONENT_INIT
+{
+    uint64_t startUs = timing_GetTimeUs();
+
+    FillTree();
+    LE_INFO("Built the test tree in %" PRIu64 " ms.", (timing_GetTimeUs() - startUs) / 1000);
+
+    TimeLookups();
+
+    le_cfg_QuickDeleteNode(TEST_ROOT_NODE);
+
+    LE_INFO("Done.");
+    exit(EXIT_SUCCESS);
+}
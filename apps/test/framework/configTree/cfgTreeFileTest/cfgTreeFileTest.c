@@ -0,0 +1,472 @@
+/**
+ * This module tests the config tree's files.  For binary tree files: converting a text tree file
+ * to binary, reading a binary tree file back, and falling back when a binary tree file is truncated
+ * or corrupt.  For journals: replaying the changes committed since the tree file was written,
+ * discarding a record that was only partly written, and skipping records made on top of another
+ * revision of the tree file.  It is built with its own copy of treeDb.c, which keeps its files in
+ * CFG_TREE_FILE_DIR.
+ *
+ * Each test loads a tree with a different name, so that it is read from its tree file rather than
+ * found already loaded.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "dynamicString.h"
+#include "treeDb.h"
+
+#if LE_CONFIG_CFGTREE_BINARY || LE_CONFIG_CFGTREE_JOURNAL
+
+/// Text tree file to start from.  It has a value of each type, and stems within stems.
+static const char TextTree[] =
+    "{ \"name\" \"unit test\" \"enabled\" !t \"count\" [-42] \"ratio\" (1.5) "
+    "\"sub\" { \"empty\" ~ \"deep\" { \"leaf\" \"x\" } } } ";
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+/// The same tree with a different count, standing in for a later tree file.
+static const char LaterTextTree[] =
+    "{ \"name\" \"unit test\" \"enabled\" !t \"count\" [-43] \"ratio\" (1.5) "
+    "\"sub\" { \"empty\" ~ \"deep\" { \"leaf\" \"x\" } } } ";
+#endif
+
+/// Revision names of the tree files, in order.
+static const char* const RevisionNames[] = { "paper", "rock", "scissors" };
+
+/// Size of the buffers holding a whole tree, either as a file or as text.
+#define TREE_BUFFER_SIZE 4096
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the path to a tree file or journal.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetFilePath
+(
+    const char* treeNamePtr,    ///< [IN] Name of the tree.
+    const char* revisionPtr,    ///< [IN] Revision name ("paper", "rock" or "scissors"), or
+                                ///<      "journal".
+    char*       pathPtr,        ///< [OUT] Path to the tree file.
+    size_t      pathSize        ///< [IN] Size of the path buffer.
+)
+{
+    LE_ASSERT(snprintf(pathPtr, pathSize, "%s/%s.%s", CFG_TREE_FILE_DIR, treeNamePtr, revisionPtr)
+              < (int)pathSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a tree file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteTreeFile
+(
+    const char* treeNamePtr,    ///< [IN] Name of the tree.
+    const char* revisionPtr,    ///< [IN] Revision name.
+    const void* dataPtr,        ///< [IN] Contents of the file.
+    size_t      size            ///< [IN] Size of the contents.
+)
+{
+    char path[PATH_MAX];
+    GetFilePath(treeNamePtr, revisionPtr, path, sizeof(path));
+
+    FILE* filePtr = fopen(path, "w");
+    LE_ASSERT(filePtr != NULL);
+    LE_ASSERT(fwrite(dataPtr, 1, size, filePtr) == size);
+    LE_ASSERT(fclose(filePtr) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a tree file.
+ *
+ * @return The size of the file, or -1 if it couldn't be opened.
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t ReadTreeFile
+(
+    const char* treeNamePtr,    ///< [IN] Name of the tree.
+    const char* revisionPtr,    ///< [IN] Revision name.
+    void*       bufferPtr,      ///< [OUT] Contents of the file.
+    size_t      bufferSize      ///< [IN] Size of the buffer.
+)
+{
+    char path[PATH_MAX];
+    GetFilePath(treeNamePtr, revisionPtr, path, sizeof(path));
+
+    FILE* filePtr = fopen(path, "r");
+    if (filePtr == NULL)
+    {
+        return -1;
+    }
+
+    size_t size = fread(bufferPtr, 1, bufferSize, filePtr);
+    LE_ASSERT(feof(filePtr));
+    fclose(filePtr);
+
+    return size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a node under the root of a tree.
+ *
+ * @return The node, or NULL if it doesn't exist.
+ */
+//--------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t GetNode
+(
+    tdb_NodeRef_t   rootRef,
+    const char*     pathPtr     ///< [IN] Path of the node, from the root.
+)
+{
+    le_pathIter_Ref_t pathRef = le_pathIter_CreateForUnix(pathPtr);
+    tdb_NodeRef_t nodeRef = tdb_GetNode(rootRef, pathRef);
+    le_pathIter_Delete(pathRef);
+
+    return nodeRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a tree holds the values of the text tree file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckValues
+(
+    tdb_NodeRef_t   rootRef,
+    const char*     whatPtr     ///< [IN] Description of the tree, for the test names.
+)
+{
+    char string[LE_CFG_STR_LEN_BYTES];
+
+    LE_TEST_OK((tdb_GetValueAsString(GetNode(rootRef, "name"), string, sizeof(string), "") ==
+                LE_OK) && (strcmp(string, "unit test") == 0),
+               "%s: string value", whatPtr);
+    LE_TEST_OK(tdb_GetValueAsBool(GetNode(rootRef, "enabled"), false) == true,
+               "%s: boolean value", whatPtr);
+    LE_TEST_OK(tdb_GetValueAsInt(GetNode(rootRef, "count"), 0) == -42,
+               "%s: integer value", whatPtr);
+    LE_TEST_OK(tdb_GetValueAsFloat(GetNode(rootRef, "ratio"), 0.0) == 1.5,
+               "%s: floating point value", whatPtr);
+    LE_TEST_OK(tdb_GetNodeType(GetNode(rootRef, "sub/empty")) == LE_CFG_TYPE_EMPTY,
+               "%s: empty node", whatPtr);
+    LE_TEST_OK((tdb_GetValueAsString(GetNode(rootRef, "sub/deep/leaf"), string, sizeof(string),
+                                     "") == LE_OK) && (strcmp(string, "x") == 0),
+               "%s: value within nested stems", whatPtr);
+}
+
+
+#endif
+
+
+#if LE_CONFIG_CFGTREE_BINARY
+/// First bytes of a binary tree file.
+static const char BinaryMagic[] = { 'C', 'F', 'G', 'B' };
+
+/// Size of a binary tree file's header, and offset of the CRC in it.
+#define HEADER_SIZE 20
+#define CRC_OFFSET  16
+
+/// Text form of the converted tree, to compare reloaded trees with.
+static char ConvertedText[TREE_BUFFER_SIZE];
+
+/// Contents of the binary tree file written by the conversion.
+static uint8_t BinaryFile[TREE_BUFFER_SIZE];
+static size_t BinaryFileSize;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a tree out in the text format.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetTreeText
+(
+    tdb_NodeRef_t   rootRef,
+    char*           textPtr,    ///< [OUT] Text form of the tree.
+    size_t          textSize    ///< [IN] Size of the text buffer.
+)
+{
+    FILE* filePtr = fmemopen(textPtr, textSize, "w");
+    LE_ASSERT(filePtr != NULL);
+    LE_ASSERT(tdb_WriteTreeNode(rootRef, filePtr) == LE_OK);
+    LE_ASSERT(fclose(filePtr) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load a text tree file, and check that it's converted to a binary one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestConvert
+(
+    void
+)
+{
+    WriteTreeFile("convert", "paper", TextTree, sizeof(TextTree) - 1);
+
+    tdb_NodeRef_t rootRef = tdb_GetRootNode(tdb_GetTree("convert"));
+    CheckValues(rootRef, "text tree file");
+    GetTreeText(rootRef, ConvertedText, sizeof(ConvertedText));
+
+    uint8_t buffer[TREE_BUFFER_SIZE];
+
+    LE_TEST_OK(ReadTreeFile("convert", "paper", buffer, sizeof(buffer)) < 0,
+               "text tree file is replaced");
+
+    ssize_t size = ReadTreeFile("convert", "rock", BinaryFile, sizeof(BinaryFile));
+    LE_TEST_ASSERT(size > (ssize_t)sizeof(BinaryMagic), "new revision of the tree file is written");
+    LE_TEST_OK(memcmp(BinaryFile, BinaryMagic, sizeof(BinaryMagic)) == 0,
+               "new revision is a binary tree file");
+
+    BinaryFileSize = size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load a copy of the binary tree file, and check that it holds the same tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestRoundTrip
+(
+    void
+)
+{
+    WriteTreeFile("reload", "paper", BinaryFile, BinaryFileSize);
+
+    tdb_NodeRef_t rootRef = tdb_GetRootNode(tdb_GetTree("reload"));
+    CheckValues(rootRef, "binary tree file");
+
+    char text[TREE_BUFFER_SIZE];
+    GetTreeText(rootRef, text, sizeof(text));
+    LE_TEST_OK(strcmp(text, ConvertedText) == 0, "binary tree file reads back the same tree");
+
+    uint8_t buffer[TREE_BUFFER_SIZE];
+    LE_TEST_OK(ReadTreeFile("reload", "paper", buffer, sizeof(buffer)) == (ssize_t)BinaryFileSize,
+               "binary tree file is loaded in place");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load binary tree files that are truncated or corrupt, and check that they're rejected.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestBadFiles
+(
+    void
+)
+{
+    uint8_t corrupt[TREE_BUFFER_SIZE];
+    tdb_NodeRef_t rootRef;
+
+    // A newer revision that wasn't completely written is ignored in favour of the older one.
+    WriteTreeFile("fallback", "paper", BinaryFile, BinaryFileSize);
+    WriteTreeFile("fallback", "rock", BinaryFile, BinaryFileSize / 2);
+    rootRef = tdb_GetRootNode(tdb_GetTree("fallback"));
+    CheckValues(rootRef, "older revision");
+
+    WriteTreeFile("truncated", "paper", BinaryFile, BinaryFileSize - 1);
+    rootRef = tdb_GetRootNode(tdb_GetTree("truncated"));
+    LE_TEST_OK(tdb_GetFirstChildNode(rootRef) == NULL, "truncated tree file is rejected");
+
+    WriteTreeFile("header", "paper", BinaryFile, sizeof(BinaryMagic));
+    rootRef = tdb_GetRootNode(tdb_GetTree("header"));
+    LE_TEST_OK(tdb_GetFirstChildNode(rootRef) == NULL, "tree file without header is rejected");
+
+    memcpy(corrupt, BinaryFile, BinaryFileSize);
+    corrupt[BinaryFileSize - 2] ^= 0x01;
+    WriteTreeFile("corrupt", "paper", corrupt, BinaryFileSize);
+    rootRef = tdb_GetRootNode(tdb_GetTree("corrupt"));
+    LE_TEST_OK(tdb_GetFirstChildNode(rootRef) == NULL, "corrupt tree file is rejected");
+
+    // Give the root node a first child that isn't the next node, and a valid CRC, so that only
+    // the check of the nodes themselves can catch it.
+    memcpy(corrupt, BinaryFile, BinaryFileSize);
+    uint32_t* rootDataPtr = (uint32_t*)(corrupt + HEADER_SIZE + sizeof(uint32_t));
+    *rootDataPtr += 1;
+    uint32_t crc = le_crc_Crc32(corrupt + HEADER_SIZE, BinaryFileSize - HEADER_SIZE,
+                                LE_CRC_START_CRC32);
+    memcpy(corrupt + CRC_OFFSET, &crc, sizeof(crc));
+    WriteTreeFile("nodes", "paper", corrupt, BinaryFileSize);
+    rootRef = tdb_GetRootNode(tdb_GetTree("nodes"));
+    LE_TEST_OK(tdb_GetFirstChildNode(rootRef) == NULL, "tree file with bad nodes is rejected");
+}
+#endif
+
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commit a write transaction that sets an integer value in a tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CommitInt
+(
+    const char* treeNamePtr,    ///< [IN] Name of the tree.
+    const char* pathPtr,        ///< [IN] Path of the node, from the root.
+    int32_t     value           ///< [IN] Value to set.
+)
+{
+    tdb_TreeRef_t shadowTreeRef = tdb_ShadowTree(tdb_GetTree(treeNamePtr));
+    le_pathIter_Ref_t pathRef = le_pathIter_CreateForUnix(pathPtr);
+
+    tdb_SetValueAsInt(tdb_CreateNodePath(tdb_GetRootNode(shadowTreeRef), pathRef), value);
+    le_pathIter_Delete(pathRef);
+
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a tree's current tree file.
+ *
+ * @return The index of the tree file's revision name in RevisionNames.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t ReadCurrentTreeFile
+(
+    const char* treeNamePtr,    ///< [IN] Name of the tree.
+    void*       bufferPtr,      ///< [OUT] Contents of the file.
+    size_t      bufferSize,     ///< [IN] Size of the buffer.
+    size_t*     sizePtr         ///< [OUT] Size of the file.
+)
+{
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(RevisionNames); i++)
+    {
+        ssize_t size = ReadTreeFile(treeNamePtr, RevisionNames[i], bufferPtr, bufferSize);
+
+        if (size >= 0)
+        {
+            *sizePtr = size;
+            return i;
+        }
+    }
+
+    LE_FATAL("Tree '%s' has no tree file.", treeNamePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commit changes to a tree, then load copies of its tree file and journal: as they are, with the
+ * last record cut short, and with other tree files under the same and the next revision names.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestJournal
+(
+    void
+)
+{
+    uint8_t treeFile[TREE_BUFFER_SIZE];
+    uint8_t journal[TREE_BUFFER_SIZE];
+    uint8_t buffer[TREE_BUFFER_SIZE];
+    size_t treeFileSize;
+    tdb_NodeRef_t rootRef;
+
+    WriteTreeFile("journal", "paper", TextTree, sizeof(TextTree) - 1);
+    tdb_GetTree("journal");
+
+    size_t revision = ReadCurrentTreeFile("journal", treeFile, sizeof(treeFile), &treeFileSize);
+    const char* revisionPtr = RevisionNames[revision];
+
+    CommitInt("journal", "first", 1);
+    ssize_t firstRecordSize = ReadTreeFile("journal", "journal", journal, sizeof(journal));
+    LE_TEST_ASSERT(firstRecordSize > 0, "commit is written to the journal");
+
+    CommitInt("journal", "second", 2);
+    ssize_t journalSize = ReadTreeFile("journal", "journal", journal, sizeof(journal));
+    LE_TEST_ASSERT(journalSize > firstRecordSize, "next commit is appended to the journal");
+
+    LE_TEST_OK(   (ReadTreeFile("journal", revisionPtr, buffer, sizeof(buffer)) ==
+                   (ssize_t)treeFileSize)
+               && (memcmp(buffer, treeFile, treeFileSize) == 0),
+               "tree file isn't rewritten by commits");
+
+    WriteTreeFile("replay", revisionPtr, treeFile, treeFileSize);
+    WriteTreeFile("replay", "journal", journal, journalSize);
+    rootRef = tdb_GetRootNode(tdb_GetTree("replay"));
+    CheckValues(rootRef, "tree file and journal");
+    LE_TEST_OK(   (tdb_GetValueAsInt(GetNode(rootRef, "first"), 0) == 1)
+               && (tdb_GetValueAsInt(GetNode(rootRef, "second"), 0) == 2),
+               "journal is replayed on top of the tree file");
+
+    // The system went down part way through appending the second record.
+    WriteTreeFile("torn", revisionPtr, treeFile, treeFileSize);
+    WriteTreeFile("torn", "journal", journal, journalSize - 3);
+    rootRef = tdb_GetRootNode(tdb_GetTree("torn"));
+    LE_TEST_OK(tdb_GetValueAsInt(GetNode(rootRef, "first"), 0) == 1,
+               "record before a torn record is replayed");
+    LE_TEST_OK(GetNode(rootRef, "second") == NULL, "torn record is discarded");
+    LE_TEST_OK(ReadTreeFile("torn", "journal", buffer, sizeof(buffer)) == firstRecordSize,
+               "torn record is cut off the journal");
+
+    // The system went down after writing the next revision of the tree file, but before emptying
+    // the journal.  The later tree file doesn't have the journal's changes, so they would show if
+    // they were replayed.
+    WriteTreeFile("stale",
+                  RevisionNames[(revision + 1) % NUM_ARRAY_MEMBERS(RevisionNames)],
+                  LaterTextTree,
+                  sizeof(LaterTextTree) - 1);
+    WriteTreeFile("stale", "journal", journal, journalSize);
+    rootRef = tdb_GetRootNode(tdb_GetTree("stale"));
+    LE_TEST_OK(tdb_GetValueAsInt(GetNode(rootRef, "count"), 0) == -43, "tree file is loaded");
+    LE_TEST_OK(   (GetNode(rootRef, "first") == NULL)
+               && (GetNode(rootRef, "second") == NULL),
+               "records made on another revision of the tree file are skipped");
+
+    // Revision names are reused every three tree files, so a journal can outlive its tree file
+    // and find a different one under the same name.
+    WriteTreeFile("reused", revisionPtr, LaterTextTree, sizeof(LaterTextTree) - 1);
+    WriteTreeFile("reused", "journal", journal, journalSize);
+    rootRef = tdb_GetRootNode(tdb_GetTree("reused"));
+    LE_TEST_OK(tdb_GetValueAsInt(GetNode(rootRef, "count"), 0) == -43, "tree file is loaded");
+    LE_TEST_OK(   (GetNode(rootRef, "first") == NULL)
+               && (GetNode(rootRef, "second") == NULL),
+               "records made on another tree file of the same revision are skipped");
+}
+#endif
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+#if LE_CONFIG_CFGTREE_BINARY || LE_CONFIG_CFGTREE_JOURNAL
+    le_dir_RemoveRecursive(CFG_TREE_FILE_DIR);
+    LE_TEST_ASSERT(le_dir_MakePath(CFG_TREE_FILE_DIR, S_IRWXU) == LE_OK,
+                   "create directory for tree files");
+
+    dstr_Init();
+    tdb_Init();
+
+#if LE_CONFIG_CFGTREE_BINARY
+    TestConvert();
+    TestRoundTrip();
+    TestBadFiles();
+#endif
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+    TestJournal();
+#endif
+
+    le_dir_RemoveRecursive(CFG_TREE_FILE_DIR);
+#else
+    LE_TEST_INFO("Binary tree files and journals are not enabled; skipping");
+#endif
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,29 @@
+/**
+ * This module implements stubs for the parts of the config tree daemon that the tree file tests
+ * don't build.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "dynamicString.h"
+#include "treeDb.h"
+#include "treeUser.h"
+#include "nodeIterator.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check to see if the iterator is meant to allow writes.  No iterators are created in these tests.
+ *
+ * @return False.
+ */
+//--------------------------------------------------------------------------------------------------
+bool ni_IsWriteable
+(
+    ni_ConstIteratorRef_t iteratorRef  ///< [IN] Does this iterator represent a write transaction?
+)
+{
+    return false;
+}
@@ -64,6 +64,60 @@ COMPONENT_INIT
     LE_ASSERT(le_ref_Lookup(mapRef1, &mapRef1) == NULL);
     LE_INFO("Looking up a pointer value failed, as expected");
 
+    LE_INFO("Checking that stale references stay invalid when their slots are reused.");
+
+    void* staleRef = safeRef2;
+    le_ref_DeleteRef(mapRef1, safeRef2);
+    safeRef2 = le_ref_CreateRef(mapRef1, (void*)0x2002);
+    LE_ASSERT(safeRef2 != staleRef);
+    LE_ASSERT(le_ref_Lookup(mapRef1, safeRef2) == (void*)0x2002);
+    LE_ASSERT(le_ref_Lookup(mapRef1, staleRef) == NULL);
+    LE_INFO("Deleting stale reference %p (expect ERROR)", staleRef);
+    le_ref_DeleteRef(mapRef1, staleRef);
+    LE_ASSERT(le_ref_Lookup(mapRef1, safeRef2) == (void*)0x2002);
+
+    LE_INFO("Overflowing map %p.", mapRef1);
+
+    #define OVERFLOW_REF_COUNT 200
+    static void* overflowRefs[OVERFLOW_REF_COUNT];
+    int i;
+
+    for (i = 0; i < OVERFLOW_REF_COUNT; i++)
+    {
+        overflowRefs[i] = le_ref_CreateRef(mapRef1, (void*)(uintptr_t)(0x10000 + i));
+        LE_ASSERT(overflowRefs[i] != NULL);
+    }
+    for (i = 0; i < OVERFLOW_REF_COUNT; i++)
+    {
+        LE_ASSERT(le_ref_Lookup(mapRef1, overflowRefs[i]) == (void*)(uintptr_t)(0x10000 + i));
+    }
+    for (i = 0; i < OVERFLOW_REF_COUNT; i += 2)
+    {
+        le_ref_DeleteRef(mapRef1, overflowRefs[i]);
+    }
+
+    int count = 0;
+    le_ref_IterRef_t iterRef = le_ref_GetIterator(mapRef1);
+    while (le_ref_NextNode(iterRef) == LE_OK)
+    {
+        LE_ASSERT(le_ref_Lookup(mapRef1, (void*)le_ref_GetSafeRef(iterRef)) ==
+                  le_ref_GetValue(iterRef));
+        count++;
+    }
+    LE_ASSERT(count == 4 + OVERFLOW_REF_COUNT / 2);
+
+    for (i = 0; i < OVERFLOW_REF_COUNT; i += 2)
+    {
+        LE_ASSERT(le_ref_Lookup(mapRef1, overflowRefs[i]) == NULL);
+        overflowRefs[i] = le_ref_CreateRef(mapRef1, (void*)(uintptr_t)(0x20000 + i));
+    }
+    for (i = 0; i < OVERFLOW_REF_COUNT; i++)
+    {
+        LE_ASSERT(le_ref_Lookup(mapRef1, overflowRefs[i]) ==
+                  (void*)(uintptr_t)((i % 2 ? 0x10000 : 0x20000) + i));
+    }
+    LE_INFO("  Successfully created and looked up %d references.", OVERFLOW_REF_COUNT);
+
 
     LE_INFO("======== SAFE REFERENCES TEST COMPLETE (PASSED) ========");
     exit(EXIT_SUCCESS);
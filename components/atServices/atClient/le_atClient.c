@@ -107,6 +107,20 @@
 //--------------------------------------------------------------------------------------------------
 #define UNSOLICITED_POOL_SIZE 10
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pattern trie nodes pool size
+ */
+//--------------------------------------------------------------------------------------------------
+#define TRIE_NODE_POOL_SIZE 64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of lines received on a device between two logs of its statistics
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATS_REPORT_LINES  10000
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Rx Buffer length
@@ -207,6 +221,41 @@ typedef struct
 }
 RspString_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pattern trie node.
+ *
+ * Response and unsolicited patterns are matched against the start of the received lines, so they
+ * are compiled into a prefix trie: a line is matched against all the patterns in a single walk
+ * along its first characters, instead of comparing it with each pattern in turn.  The root node
+ * stands for the empty prefix.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct TrieNode
+{
+    struct TrieNode* childPtr;      ///< First child, children are sorted by character
+    struct TrieNode* siblingPtr;    ///< Next sibling
+    le_sls_List_t    unsolList;     ///< Unsolicited responses whose pattern ends here
+    bool             isEnd;         ///< A pattern ends here
+    char             character;     ///< Character leading to this node
+}
+TrieNode_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Line statistics of a device
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t    lineCount;          ///< Lines received
+    uint64_t    unsolCount;         ///< Lines handed to unsolicited handlers
+    uint64_t    rspCount;           ///< Lines matching a command response
+    uint64_t    totalTimeUs;        ///< Time spent matching and dispatching lines
+    uint32_t    maxTimeUs;          ///< Longest time spent on a line
+}
+LineStats_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Rx Data structure.
@@ -259,9 +308,13 @@ typedef struct
     uint32_t      lineCount;                                    ///< Unsolicited lines number
     uint32_t      lineCounter;                                  ///< Received line counter
     bool          inProgress;                                   ///< Reception in progress
+    size_t        unsolBufferLen;                               ///< Unsolicited buffer length
+    bool          matched;                                      ///< Pattern matched current line
+    bool          removePending;                                ///< Removal queued to device
     le_atClient_UnsolicitedResponseHandlerRef_t ref;            ///< Unsolicited reference
     DeviceContextPtr_t interfacePtr;                            ///< device context
     le_dls_Link_t link;                                         ///< link in Unsolicited List
+    le_sls_Link_t trieLink;                                     ///< link in pattern trie node
     le_msg_SessionRef_t sessionRef;                             ///< client session reference
 }
 Unsolicited_t;
@@ -283,6 +336,9 @@ typedef struct DeviceContext
     le_timer_Ref_t  timerRef;           ///< command timer
     le_dls_List_t   atCommandList;      ///< List of command waiting for execution
     le_dls_List_t   unsolicitedList;    ///< unsolicited command list
+    TrieNode_t*     unsolTriePtr;       ///< unsolicited patterns trie
+    uint32_t        unsolInProgress;    ///< number of unsolicited responses in progress
+    LineStats_t     stats;              ///< line statistics
     le_sem_Ref_t    waitingSemaphore;   ///< semaphore used for synchronization
     le_atClient_DeviceRef_t ref;        ///< reference of the device context
     le_msg_SessionRef_t sessionRef;     ///< client session reference
@@ -301,6 +357,8 @@ typedef struct AtCmd
                                                                 ///< intermediate response
     le_dls_List_t          expectResponseList;                  ///< List of str  pattern for final
                                                                 ///< response
+    TrieNode_t*            intermediateTriePtr;                 ///< intermediate response trie
+    TrieNode_t*            finalTriePtr;                        ///< final response trie
     char                   text[LE_ATDEFS_TEXT_MAX_BYTES+1];    ///< text to be sent after >
                                                                 ///< +1 for ctrl-z
     size_t                 textSize;                            ///< size of text to send
@@ -347,6 +405,13 @@ static le_mem_PoolRef_t  RspStringPool;
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t  UnsolicitedPool;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for pattern trie nodes
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t  TrieNodePool;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Map for AT commands
@@ -381,6 +446,240 @@ static void UpdateTransitionManager(ClientStatePtr_t  parserStatePtr,
 static void SendLine(RxParserPtr_t charParserPtr);
 static void SendData(RxParserPtr_t charParserPtr);
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function creates a pattern trie node.
+ *
+ * @return pointer to the new node
+ */
+//--------------------------------------------------------------------------------------------------
+static TrieNode_t* CreateTrieNode
+(
+    char character      ///< [IN] Character leading to the node
+)
+{
+    TrieNode_t* nodePtr = le_mem_ForceAlloc(TrieNodePool);
+
+    nodePtr->childPtr = NULL;
+    nodePtr->siblingPtr = NULL;
+    nodePtr->unsolList = LE_SLS_LIST_INIT;
+    nodePtr->isEnd = false;
+    nodePtr->character = character;
+
+    return nodePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function releases a pattern trie.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteTrie
+(
+    TrieNode_t** triePtrPtr     ///< [IN/OUT] Trie to release, set to NULL
+)
+{
+    TrieNode_t* nodePtr = *triePtrPtr;
+
+    while (nodePtr != NULL)
+    {
+        TrieNode_t* siblingPtr = nodePtr->siblingPtr;
+
+        DeleteTrie(&nodePtr->childPtr);
+        le_mem_Release(nodePtr);
+        nodePtr = siblingPtr;
+    }
+
+    *triePtrPtr = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function adds a pattern to a pattern trie, creating the trie if needed.
+ *
+ * @return pointer to the node where the pattern ends
+ */
+//--------------------------------------------------------------------------------------------------
+static TrieNode_t* AddTriePattern
+(
+    TrieNode_t** triePtrPtr,    ///< [IN/OUT] Trie
+    const char*  patternPtr     ///< [IN] Pattern to add
+)
+{
+    if (*triePtrPtr == NULL)
+    {
+        *triePtrPtr = CreateTrieNode('\0');
+    }
+
+    TrieNode_t* nodePtr = *triePtrPtr;
+
+    for (; *patternPtr != '\0'; patternPtr++)
+    {
+        TrieNode_t** childPtrPtr = &nodePtr->childPtr;
+
+        while ((*childPtrPtr != NULL) &&
+               ((unsigned char)(*childPtrPtr)->character < (unsigned char)*patternPtr))
+        {
+            childPtrPtr = &(*childPtrPtr)->siblingPtr;
+        }
+
+        if ((*childPtrPtr == NULL) || ((*childPtrPtr)->character != *patternPtr))
+        {
+            TrieNode_t* newNodePtr = CreateTrieNode(*patternPtr);
+
+            newNodePtr->siblingPtr = *childPtrPtr;
+            *childPtrPtr = newNodePtr;
+        }
+
+        nodePtr = *childPtrPtr;
+    }
+
+    nodePtr->isEnd = true;
+
+    return nodePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the child of a pattern trie node for a character.
+ *
+ * @return pointer to the child, or NULL if there is none
+ */
+//--------------------------------------------------------------------------------------------------
+static const TrieNode_t* GetTrieChild
+(
+    const TrieNode_t* nodePtr,  ///< [IN] Node
+    char              character ///< [IN] Character
+)
+{
+    const TrieNode_t* childPtr = nodePtr->childPtr;
+
+    while ((childPtr != NULL) &&
+           ((unsigned char)childPtr->character < (unsigned char)character))
+    {
+        childPtr = childPtr->siblingPtr;
+    }
+
+    if ((childPtr != NULL) && (childPtr->character == character))
+    {
+        return childPtr;
+    }
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function builds the pattern trie of a list of response strings.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BuildResponseTrie
+(
+    TrieNode_t**   triePtrPtr,      ///< [IN/OUT] Trie to build
+    le_dls_List_t* responseListPtr  ///< [IN] List of response strings
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(responseListPtr);
+
+    DeleteTrie(triePtrPtr);
+
+    while (linkPtr != NULL)
+    {
+        RspString_t* rspPtr = CONTAINER_OF(linkPtr, RspString_t, link);
+
+        AddTriePattern(triePtrPtr, rspPtr->line);
+        linkPtr = le_dls_PeekNext(responseListPtr, linkPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function rebuilds the unsolicited patterns trie of a device.  It must be called in the
+ * device thread, whenever an unsolicited response is added or removed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BuildUnsolicitedTrie
+(
+    DeviceContext_t* interfacePtr   ///< [IN] Device context
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&interfacePtr->unsolicitedList);
+
+    DeleteTrie(&interfacePtr->unsolTriePtr);
+
+    while (linkPtr != NULL)
+    {
+        Unsolicited_t* unsolPtr = CONTAINER_OF(linkPtr, Unsolicited_t, link);
+        TrieNode_t* nodePtr = AddTriePattern(&interfacePtr->unsolTriePtr, unsolPtr->unsolRsp);
+
+        unsolPtr->trieLink = LE_SLS_LINK_INIT;
+        le_sls_Queue(&nodePtr->unsolList, &unsolPtr->trieLink);
+
+        linkPtr = le_dls_PeekNext(&interfacePtr->unsolicitedList, linkPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is used to check if the start of a line matches any pattern of a pattern trie.
+ *
+ * @return
+ *      - true if a pattern matches
+ *      - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool MatchTrie
+(
+    const TrieNode_t* nodePtr,  ///< [IN] Trie
+    const char*       linePtr,  ///< [IN] Line
+    size_t            lineSize  ///< [IN] Line size
+)
+{
+    size_t i = 0;
+
+    while (nodePtr != NULL)
+    {
+        if (nodePtr->isEnd)
+        {
+            return true;
+        }
+
+        if (i == lineSize)
+        {
+            break;
+        }
+
+        nodePtr = GetTrieChild(nodePtr, linePtr[i++]);
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function appends data to the buffer of an unsolicited response, truncating it if the
+ * buffer is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AppendUnsolicited
+(
+    Unsolicited_t* unsolPtr,    ///< [IN] Unsolicited response
+    const char*    dataPtr,     ///< [IN] Data to append
+    size_t         dataSize     ///< [IN] Data size
+)
+{
+    size_t len = LE_ATDEFS_UNSOLICITED_MAX_LEN - unsolPtr->unsolBufferLen;
+
+    if (dataSize < len)
+    {
+        len = dataSize;
+    }
+
+    memcpy(unsolPtr->unsolBuffer + unsolPtr->unsolBufferLen, dataPtr, len);
+    unsolPtr->unsolBufferLen += len;
+    unsolPtr->unsolBuffer[unsolPtr->unsolBufferLen] = '\0';
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function is used to check if the received data matches with a subscribed unsolicited
@@ -392,57 +691,87 @@ static void CheckUnsolicited
 (
     char* unsolRspPtr,
     size_t stringSize,
-    le_dls_List_t *unsolListPtr
+    DeviceContext_t* interfacePtr
 )
 {
+    const TrieNode_t* nodePtr;
+    uint32_t matchCount = 0;
+    size_t i = 0;
+
     LE_DEBUG("Start checking unsolicited");
 
-    le_dls_Link_t* linkPtr = le_dls_Peek(unsolListPtr);
+    // Mark the unsolicited responses whose pattern starts the line.
+    nodePtr = interfacePtr->unsolTriePtr;
+    while (nodePtr != NULL)
+    {
+        le_sls_Link_t* linkPtr = le_sls_Peek(&nodePtr->unsolList);
+
+        while (linkPtr != NULL)
+        {
+            Unsolicited_t* unsolPtr = CONTAINER_OF(linkPtr, Unsolicited_t, trieLink);
+
+            unsolPtr->matched = true;
+            matchCount++;
+            linkPtr = le_sls_PeekNext(&nodePtr->unsolList, linkPtr);
+        }
+
+        if (i == stringSize)
+        {
+            break;
+        }
+        nodePtr = GetTrieChild(nodePtr, unsolRspPtr[i++]);
+    }
+
+    if ((matchCount == 0) && (interfacePtr->unsolInProgress == 0))
+    {
+        LE_DEBUG("Stop checking unsolicited");
+        return;
+    }
+
+    interfacePtr->stats.unsolCount++;
+
+    // Handle the matching and in progress ones in subscription order.
+    le_dls_Link_t* linkPtr = le_dls_Peek(&interfacePtr->unsolicitedList);
 
-    /* Browse all the queue while the string is not found */
     while (linkPtr != NULL)
     {
         Unsolicited_t *unsolPtr = CONTAINER_OF(linkPtr,
                                                Unsolicited_t,
                                                 link);
 
-        if ((strncmp(unsolPtr->unsolRsp,unsolRspPtr,strlen(unsolPtr->unsolRsp)) == 0) ||
-            (unsolPtr->inProgress))
+        if (unsolPtr->matched || unsolPtr->inProgress)
         {
             LE_DEBUG("unsol found");
-            uint32_t len =
-                (stringSize < LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer)) ?
-                stringSize :
-                LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer);
-
-            strncpy(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer), unsolRspPtr, len);
+            AppendUnsolicited(unsolPtr, unsolRspPtr, stringSize);
 
-            unsolPtr->inProgress = true;
-        }
+            unsolPtr->matched = false;
+            if (!unsolPtr->inProgress)
+            {
+                unsolPtr->inProgress = true;
+                interfacePtr->unsolInProgress++;
+            }
 
-        if (unsolPtr->inProgress)
-        {
             if ( (unsolPtr->lineCount - unsolPtr->lineCounter) == 1 )
             {
                 unsolPtr->handlerPtr(unsolPtr->unsolBuffer, unsolPtr->contextPtr );
                 memset(unsolPtr->unsolBuffer,0,LE_ATDEFS_UNSOLICITED_MAX_BYTES);
+                unsolPtr->unsolBufferLen = 0;
                 unsolPtr->lineCounter = 0;
                 unsolPtr->inProgress = false;
+                interfacePtr->unsolInProgress--;
             }
             else
             {
-                if (LE_ATDEFS_UNSOLICITED_MAX_BYTES - strlen(unsolPtr->unsolBuffer) > sizeof("\r\n"))
+                if (LE_ATDEFS_UNSOLICITED_MAX_BYTES - unsolPtr->unsolBufferLen > sizeof("\r\n"))
                 {
-                    snprintf(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer),
-                             sizeof("\r\n") + 1,    // +1 for Null terminator
-                             "\r\n" );
+                    AppendUnsolicited(unsolPtr, "\r\n", sizeof("\r\n") - 1);
                 }
 
                 unsolPtr->lineCounter++;
             }
         }
 
-        linkPtr = le_dls_PeekNext(unsolListPtr, linkPtr);
+        linkPtr = le_dls_PeekNext(&interfacePtr->unsolicitedList, linkPtr);
     }
 
     LE_DEBUG("Stop checking unsolicited");
@@ -654,6 +983,29 @@ static void RxNewData
     LE_DEBUG("read finished");
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function logs the line statistics of a device.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void LogLineStats
+(
+    DeviceContext_t* interfacePtr
+)
+{
+    LineStats_t* statsPtr = &interfacePtr->stats;
+
+    LE_INFO("Device %d: %"PRIu64" lines, %"PRIu64" unsolicited, %"PRIu64" responses, "
+            "avg %"PRIu64" us, max %"PRIu32" us per line",
+            interfacePtr->device.fd,
+            statsPtr->lineCount,
+            statsPtr->unsolCount,
+            statsPtr->rspCount,
+            statsPtr->lineCount ? statsPtr->totalTimeUs / statsPtr->lineCount : 0,
+            statsPtr->maxTimeUs);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Device thread destructor.
@@ -670,12 +1022,27 @@ static void DestroyDeviceThread
 
     LE_DEBUG("Destroy thread for interface %d", interfacePtr->device.fd);
 
+    LogLineStats(interfacePtr);
+
     while ((linkPtr=le_dls_Pop(&interfacePtr->unsolicitedList)) != NULL)
     {
         Unsolicited_t *unsolPtr = CONTAINER_OF(linkPtr, Unsolicited_t, link);
         le_mem_Release(unsolPtr);
     }
 
+    // Handlers whose queued add or remove never ran on this thread are not in the list: release
+    // them from the reference map.
+    le_ref_IterRef_t iter = le_ref_GetIterator(UnsolRefMap);
+    while (LE_OK == le_ref_NextNode(iter))
+    {
+        Unsolicited_t *unsolPtr = (Unsolicited_t *) le_ref_GetValue(iter);
+        if ((unsolPtr) && (unsolPtr->interfacePtr == interfacePtr))
+        {
+            le_mem_Release(unsolPtr);
+        }
+    }
+    DeleteTrie(&interfacePtr->unsolTriePtr);
+
     while ((linkPtr=le_dls_Pop(&interfacePtr->atCommandList)) != NULL)
     {
         AtCmd_t* atCmdPtr = CONTAINER_OF(linkPtr, AtCmd_t, link);
@@ -846,11 +1213,11 @@ static void StartTimer
 //--------------------------------------------------------------------------------------------------
 static bool CheckResponse
 (
-    char*          receivedRspPtr,   ///< [IN] Received line pointer
-    size_t         lineSize,         ///< [IN] Received line size
-    le_dls_List_t* responseListPtr,  ///< [IN] List of response strings of the command
-    le_dls_List_t* resultListPtr,    ///< [OUT] List of matched strings after comparison
-    char*          cmdNamePtr        ///< [IN] Command name pointer
+    char*             receivedRspPtr,   ///< [IN] Received line pointer
+    size_t            lineSize,         ///< [IN] Received line size
+    const TrieNode_t* responseTriePtr,  ///< [IN] Trie of response strings of the command
+    le_dls_List_t*    resultListPtr,    ///< [OUT] List of matched strings after comparison
+    char*             cmdNamePtr        ///< [IN] Command name pointer
 )
 {
     LE_DEBUG("Start checking response");
@@ -860,8 +1227,6 @@ static bool CheckResponse
         return false;
     }
 
-    le_dls_Link_t* linkPtr = le_dls_Peek(responseListPtr);
-
     LE_DEBUG("Command: %s, size: %"PRIuS, cmdNamePtr, strlen(cmdNamePtr));
     LE_DEBUG("Received response: %s, size: %"PRIuS, receivedRspPtr, lineSize);
 
@@ -871,37 +1236,24 @@ static bool CheckResponse
         return false;
     }
 
-    /* Browse all the queue while the string is not found */
-    while (linkPtr != NULL)
+    if (MatchTrie(responseTriePtr, receivedRspPtr, lineSize))
     {
-        RspString_t* currStringPtr = CONTAINER_OF(linkPtr,
-                                                  RspString_t,
-                                                  link);
-        LE_DEBUG("Item: %s, size: %"PRIuS, currStringPtr->line, strlen(currStringPtr->line));
+        LE_DEBUG("Rsp matched, size: %zu", lineSize);
 
-        if ((strlen(currStringPtr->line) == 0) ||
-           ((lineSize >= strlen(currStringPtr->line)) &&
-           (strncmp(currStringPtr->line, receivedRspPtr, strlen(currStringPtr->line)) == 0)))
-        {
-            LE_DEBUG("Rsp matched, size: %zu", lineSize);
-
-            RspString_t* newStringPtr = le_mem_ForceAlloc(RspStringPool);
-            memset(newStringPtr, 0, sizeof(RspString_t));
-
-            if(lineSize>LE_ATDEFS_RESPONSE_MAX_BYTES)
-            {
-                LE_ERROR("String too long");
-                le_mem_Release(newStringPtr);
-                return false;
-            }
+        RspString_t* newStringPtr = le_mem_ForceAlloc(RspStringPool);
+        memset(newStringPtr, 0, sizeof(RspString_t));
 
-            strncpy(newStringPtr->line, receivedRspPtr, lineSize);
-            newStringPtr->link = LE_DLS_LINK_INIT;
-            le_dls_Queue(resultListPtr, &(newStringPtr->link));
-            return true;
+        if(lineSize>LE_ATDEFS_RESPONSE_MAX_BYTES)
+        {
+            LE_ERROR("String too long");
+            le_mem_Release(newStringPtr);
+            return false;
         }
 
-        linkPtr = le_dls_PeekNext(responseListPtr, linkPtr);
+        strncpy(newStringPtr->line, receivedRspPtr, lineSize);
+        newStringPtr->link = LE_DLS_LINK_INIT;
+        le_dls_Queue(resultListPtr, &(newStringPtr->link));
+        return true;
     }
 
     LE_DEBUG("Stop checking response");
@@ -963,10 +1315,11 @@ static void SendingState
             size_t lineSize = newCRLF - parserPtr->idxLastCrLf;
 
             if (CheckResponse((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]), lineSize,
-                              &(cmdPtr->expectResponseList), &(cmdPtr->responseList),
+                              cmdPtr->finalTriePtr, &(cmdPtr->responseList),
                               cmdPtr->cmd))
             {
                 LE_DEBUG("Final command found");
+                interfacePtr->stats.rspCount++;
 
                 le_dls_Pop(&interfacePtr->atCommandList);
 
@@ -980,9 +1333,12 @@ static void SendingState
                 return;
             }
 
-            CheckResponse((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]), lineSize,
-                          &(cmdPtr->ExpectintermediateResponseList), &(cmdPtr->responseList),
-                          cmdPtr->cmd);
+            if (CheckResponse((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]), lineSize,
+                              cmdPtr->intermediateTriePtr, &(cmdPtr->responseList),
+                              cmdPtr->cmd))
+            {
+                interfacePtr->stats.rspCount++;
+            }
             break;
         }
         default:
@@ -1052,7 +1408,7 @@ static void WaitingState
 
             CheckUnsolicited((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]),
                               lineSize,
-                              &interfacePtr->unsolicitedList);
+                              interfacePtr);
             break;
         }
         default:
@@ -1173,10 +1529,27 @@ static void SendLine
     RxParserPtr_t rxParserPtr
 )
 {
-    ClientStatePtr_t clientStatePtr = &rxParserPtr->interfacePtr->clientState;
+    DeviceContext_t* interfacePtr = rxParserPtr->interfacePtr;
+    ClientStatePtr_t clientStatePtr = &interfacePtr->clientState;
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
 
     (clientStatePtr->curState)(clientStatePtr,EVENT_PROCESSLINE);
 
+    le_clk_Time_t lineTime = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    uint64_t lineTimeUs = (uint64_t)lineTime.sec * 1000000 + lineTime.usec;
+
+    interfacePtr->stats.lineCount++;
+    interfacePtr->stats.totalTimeUs += lineTimeUs;
+    if (lineTimeUs > interfacePtr->stats.maxTimeUs)
+    {
+        interfacePtr->stats.maxTimeUs = lineTimeUs;
+    }
+
+    if ((interfacePtr->stats.lineCount % STATS_REPORT_LINES) == 0)
+    {
+        LogLineStats(interfacePtr);
+    }
+
     rxParserPtr->rxData.idxLastCrLf = rxParserPtr->rxData.idx;
 }
 
@@ -1240,6 +1613,8 @@ static void AtCmdPoolDestructor
     ReleaseRspStringList(&(oldPtr->responseList));
     ReleaseRspStringList(&(oldPtr->expectResponseList));
     ReleaseRspStringList(&(oldPtr->ExpectintermediateResponseList));
+    DeleteTrie(&(oldPtr->finalTriePtr));
+    DeleteTrie(&(oldPtr->intermediateTriePtr));
 
     le_ref_DeleteRef(CmdRefMap, oldPtr->ref);
 }
@@ -1273,6 +1648,9 @@ static void DevicesPoolDestructor
 /**
  * This function is the destructor for Unsolicited_t struct
  *
+ * @note Unsolicited responses must only be released in their device thread (by RemoveUnsolicited()
+ *       or DestroyDeviceThread()), as the destructor changes the device's unsolicited list and
+ *       rebuilds its pattern trie.
  */
 //--------------------------------------------------------------------------------------------------
 static void UnsolicitedPoolDestructor
@@ -1284,14 +1662,23 @@ static void UnsolicitedPoolDestructor
     le_dls_List_t* listPtr;
     le_dls_Link_t* linkPtr;
 
+    LE_FATAL_IF(le_thread_GetCurrent() != unsolicitedPtr->interfacePtr->threadRef,
+                "Unsolicited %s released outside its device thread", unsolicitedPtr->unsolRsp);
+
     listPtr = &unsolicitedPtr->interfacePtr->unsolicitedList;
     linkPtr = &unsolicitedPtr->link;
 
     LE_DEBUG("Destroy unsolicited %s", unsolicitedPtr->unsolRsp);
 
+    if (unsolicitedPtr->inProgress)
+    {
+        unsolicitedPtr->interfacePtr->unsolInProgress--;
+    }
+
     if ( le_dls_IsInList(listPtr, linkPtr) )
     {
         le_dls_Remove(listPtr, linkPtr);
+        BuildUnsolicitedTrie(unsolicitedPtr->interfacePtr);
     }
 
     // Delete the reference for unsolicited structure pointer.
@@ -1334,6 +1721,23 @@ static char* GetIntermediateResponse
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function adds an unsolicited response subscription.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddUnsolicited
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    Unsolicited_t* unsolicitedPtr = param1Ptr;
+
+    le_dls_Queue(&unsolicitedPtr->interfacePtr->unsolicitedList, &unsolicitedPtr->link);
+    BuildUnsolicitedTrie(unsolicitedPtr->interfacePtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function removes an unsolicited response subscription.
@@ -1734,6 +2138,9 @@ le_result_t le_atClient_Send
         }
     }
 
+    BuildResponseTrie(&cmdPtr->finalTriePtr, &cmdPtr->expectResponseList);
+    BuildResponseTrie(&cmdPtr->intermediateTriePtr, &cmdPtr->ExpectintermediateResponseList);
+
     cmdPtr->endSem = le_sem_Create("ResultSignal",0);
     le_dls_Queue(&cmdPtr->interfacePtr->atCommandList, &cmdPtr->link);
 
@@ -2049,12 +2456,18 @@ le_atClient_UnsolicitedResponseHandlerRef_t le_atClient_AddUnsolicitedResponseHa
     unsolicitedPtr->handlerPtr = handlerPtr;
     unsolicitedPtr->contextPtr = contextPtr;
     unsolicitedPtr->inProgress = false;
+    unsolicitedPtr->removePending = false;
     unsolicitedPtr->ref = le_ref_CreateRef(UnsolRefMap, unsolicitedPtr);
     unsolicitedPtr->interfacePtr = interfacePtr;
     unsolicitedPtr->link = LE_DLS_LINK_INIT;
+    unsolicitedPtr->trieLink = LE_SLS_LINK_INIT;
     unsolicitedPtr->sessionRef = le_atClient_GetClientSessionRef();
 
-    le_dls_Queue(&interfacePtr->unsolicitedList, &unsolicitedPtr->link);
+    // The unsolicited list and its pattern trie are only used and changed in the device thread.
+    le_event_QueueFunctionToThread(interfacePtr->threadRef,
+                                   AddUnsolicited,
+                                   (void*) unsolicitedPtr,
+                                   (void*) NULL);
 
     return unsolicitedPtr->ref;
 }
@@ -2072,14 +2485,15 @@ void le_atClient_RemoveUnsolicitedResponseHandler
 {
     Unsolicited_t* unsolicitedPtr = le_ref_Lookup(UnsolRefMap, addHandlerRef);
 
-    if (unsolicitedPtr)
+    // The reference is kept until the destructor runs on the device thread, so that a device
+    // thread destroyed before the queued removal runs can still find and release the handler.
+    if ((unsolicitedPtr) && (!unsolicitedPtr->removePending))
     {
+        unsolicitedPtr->removePending = true;
         le_event_QueueFunctionToThread(unsolicitedPtr->interfacePtr->threadRef,
                                    RemoveUnsolicited,
                                    (void*) unsolicitedPtr,
                                    (void*) NULL);
-
-        le_ref_DeleteRef(UnsolRefMap, addHandlerRef);
     }
 }
 
@@ -2106,9 +2520,13 @@ static void CloseSessionEventHandler
         unsolPtr = (Unsolicited_t *) le_ref_GetValue(iter);
         if (unsolPtr)
         {
-            if (sessionRef == unsolPtr->sessionRef)
+            if ((sessionRef == unsolPtr->sessionRef) && (!unsolPtr->removePending))
             {
-                le_mem_Release(unsolPtr);
+                unsolPtr->removePending = true;
+                le_event_QueueFunctionToThread(unsolPtr->interfacePtr->threadRef,
+                                               RemoveUnsolicited,
+                                               (void*) unsolPtr,
+                                               (void*) NULL);
             }
         }
     }
@@ -2250,6 +2668,10 @@ COMPONENT_INIT
     le_mem_SetDestructor(UnsolicitedPool,UnsolicitedPoolDestructor);
     UnsolRefMap = le_ref_CreateMap("UnsolRefMap", UNSOLICITED_POOL_SIZE);
 
+    // Pattern trie nodes pool allocation
+    TrieNodePool = le_mem_CreatePool("AtTrieNodePool",sizeof(TrieNode_t));
+    le_mem_ExpandPool(TrieNodePool,TRIE_NODE_POOL_SIZE);
+
     // Add a handler to the close session service
     le_msg_AddServiceCloseHandler(
         le_atClient_GetServiceRef(), CloseSessionEventHandler, NULL);
@@ -27,6 +27,13 @@
 //--------------------------------------------------------------------------------------------------
 #define NETWORK_SOCKET_MAX_CONNECT_REQUEST_BACKLOG   100
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of data segments sent by one call to sendmsg()
+ */
+//--------------------------------------------------------------------------------------------------
+#define NETWORK_SOCKET_MAX_SEND_SEGMENTS             32
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum number of Socket Handle records
@@ -749,6 +756,87 @@ LE_SHARED le_result_t le_comm_Send (void* handle, const void* buf, size_t len)
     return LE_OK;
 }
 
+#ifdef LE_CONFIG_LINUX
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for Sending a list of data segments over RPC Network-Socket Communication Channel,
+ * using as few system calls as possible
+ *
+ * @return
+ *      - LE_OK if successfully.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t le_comm_SendVector
+(
+    void* handle,
+    const le_comm_Segment_t* segments,
+    size_t count
+)
+{
+    HandleRecord_t* connectionRecordPtr = (HandleRecord_t*) handle;
+    struct iovec iov[NETWORK_SOCKET_MAX_SEND_SEGMENTS];
+    struct msghdr msg;
+    ssize_t bytesSent;
+    size_t i;
+
+    while (count > 0)
+    {
+        size_t iovCount = (count < NETWORK_SOCKET_MAX_SEND_SEGMENTS) ?
+                          count : NETWORK_SOCKET_MAX_SEND_SEGMENTS;
+        size_t len = 0;
+
+        for (i = 0; i < iovCount; i++)
+        {
+            iov[i].iov_base = (void*) segments[i].buf;
+            iov[i].iov_len = segments[i].len;
+            len += segments[i].len;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iovCount;
+
+        // Now send the segments (retry if interrupted by a signal).
+        do
+        {
+            bytesSent = sendmsg(connectionRecordPtr->fd, &msg, 0);
+        }
+        while ((bytesSent < 0) && (errno == EINTR));
+
+        if (bytesSent < 0)
+        {
+            switch (errno)
+            {
+                case EAGAIN:  // Same as EWOULDBLOCK
+                    return LE_NO_MEMORY;
+
+                case ENOTCONN:
+                case ECONNRESET:
+                    LE_WARN("sendmsg() failed with errno %d", errno);
+                    return LE_COMM_ERROR;
+
+                default:
+                    LE_ERROR("sendmsg() failed with errno %d", errno);
+                    return LE_FAULT;
+            }
+        }
+
+        if ((size_t)bytesSent < len)
+        {
+            LE_ERROR("The last %zu data bytes (of %zu total) were discarded by sendmsg()!",
+                     len - bytesSent,
+                     len);
+            return LE_FAULT;
+        }
+
+        segments += iovCount;
+        count -= iovCount;
+    }
+
+    return LE_OK;
+}
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function for Receiving Data over RPC Network-Socket Communication Channel
@@ -120,6 +120,28 @@
  *  in order to have a handler registed for it.  In fact, a handler will be called when a node is
  *  deleted and when it is recreated.
  *
+ *  <b>Persistence:</b>
+ *
+ *  Each tree is stored in a tree file, which holds a complete copy of the tree, and (if
+ *  LE_CONFIG_CFGTREE_JOURNAL is enabled) a journal.  Once a tree has a tree file, committing a
+ *  transaction doesn't rewrite it.  Instead, the final state of each node changed by the
+ *  transaction is appended to the journal as a single record.  When the tree is loaded, the records
+ *  in the journal are applied on top of the tree file.
+ *
+ *  Once the journal grows past LE_CONFIG_CFGTREE_JOURNAL_COMPACT_SIZE, it is compacted: a new
+ *  revision of the tree file is written, and the journal is emptied.  Compaction waits until the
+ *  tree hasn't been changed for LE_CONFIG_CFGTREE_JOURNAL_COMPACT_DELAY ms, unless the journal
+ *  reaches four times the size limit first.  Each record notes the CRC of the tree file it was made
+ *  on top of, and records made on top of any other tree file are skipped when the journal is
+ *  replayed, so it doesn't matter if the system goes down between writing the tree file and
+ *  emptying the journal.  Revision numbers can't be used for this, as they are reused.
+ *
+ *  Tree files are text, unless LE_CONFIG_CFGTREE_BINARY is enabled.  Then they are written in a
+ *  binary format: an array of fixed size node entries, laid out so that the children of each node
+ *  are next to each other, followed by a table of the names and values.  A binary tree file is
+ *  mapped into memory when the tree is loaded, and the children of a node are only created from it
+ *  when they're first needed.  A text tree file is converted to binary as soon as it is loaded.
+ *
  *  Copyright (C) Sierra Wireless Inc.
  *
  */
@@ -134,6 +156,14 @@
 #include "nodeIterator.h"
 #include "sysPaths.h"
 
+#if LE_CONFIG_CFGTREE_JOURNAL
+#include "fileDescriptor.h"
+#endif
+
+#if LE_CONFIG_CFGTREE_BINARY
+#include <sys/mman.h>
+#endif
+
 
 
 /// Maximum path size for the config tree.
@@ -141,6 +171,13 @@
 
 
 
+/// Directory holding the tree files and journals.  Unit tests build this file with their own.
+#ifndef CFG_TREE_FILE_DIR
+#define CFG_TREE_FILE_DIR CFG_TREE_PATH
+#endif
+
+
+
 /// Maximum size (in bytes) of a "small" string, including the null terminator.
 #define SMALL_STR 24
 
@@ -271,12 +308,47 @@ typedef struct Node
         le_dls_List_t children;      ///< The linked list of children belonging to this node.
     }
     info;                            ///< The actual inforation that this node stores.
+
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    struct ChildIndex* childIndexPtr;  ///< Index of this node's children by name, or NULL if the
+                                       ///<   children haven't been indexed.
+    struct Node* indexNextPtr;       ///< Next node in the same bucket of the parent's child index.
+    size_t indexHash;                ///< The name hash this node is filed under in the parent's
+                                     ///<   child index.
+#endif
+
+#if LE_CONFIG_CFGTREE_BINARY
+    struct Snapshot* snapshotPtr;    ///< If the node's children haven't been loaded from the
+                                     ///<   binary tree file yet, the file they're in.  NULL
+                                     ///<   otherwise.
+    uint32_t snapshotIndex;          ///< Index of this node in snapshotPtr's node array.
+#endif
 }
 Node_t;
 
 
 
 
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Hash table of a node's children, keyed by name hash.  Only nodes with enough children to make
+ *  searching the child list slow get one.  The children are still kept in the child list, which
+ *  remains the authority on the order of the children.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct ChildIndex
+{
+    size_t count;                    ///< Number of children in the index.
+    size_t bucketCount;              ///< Number of buckets.  Always a power of two.
+    Node_t** bucketsPtr;             ///< Buckets, each a chain of nodes linked by indexNextPtr.
+}
+ChildIndex_t;
+#endif
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Structure used to keep track of the trees loaded in the configTree daemon.
@@ -307,12 +379,138 @@ typedef struct Tree
 
     le_sls_List_t requestList;            ///< Each tree maintains it's own list of pending
                                           ///<   requests.
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+    int journalFd;                        ///< The tree's journal, opened for appending, or -1.
+    size_t journalSize;                   ///< Size of the valid records in the journal.
+    bool isTreeFileCrcKnown;              ///< Set once treeFileCrc has been worked out.
+    uint32_t treeFileCrc;                 ///< CRC32 of the contents of the current tree file.
+    le_timer_Ref_t compactTimerRef;       ///< Timer used to compact the journal once the tree has
+                                          ///<   stopped changing.  Created when first needed.
+#endif
 }
 Tree_t;
 
 
 
 
+#if LE_CONFIG_CFGTREE_JOURNAL
+/// Magic number found at the start of every journal record ("JRNL").
+#define JOURNAL_RECORD_MAGIC 0x4a524e4c
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of a record in a tree's journal.  The header is followed by the record's contents, which
+ * are in the text tree file format.  See BuildJournalRecord().
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;         ///< JOURNAL_RECORD_MAGIC.
+    uint32_t baseCrc;       ///< CRC32 of the contents of the tree file the record applies on
+                            ///<   top of.
+    uint32_t size;          ///< Size of the record contents, not including this header.
+    uint32_t crc;           ///< CRC32 of the base CRC followed by the record contents.
+}
+JournalRecordHeader_t;
+#endif
+
+
+
+
+#if LE_CONFIG_CFGTREE_BINARY
+/// Magic number found at the start of a binary tree file ("CFGB").
+#define SNAPSHOT_MAGIC 0x42474643
+
+/// Version of the binary tree file format.
+#define SNAPSHOT_VERSION 1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header at the start of a binary tree file.  It is followed by the node array, then the string
+ * table.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;        ///< SNAPSHOT_MAGIC.
+    uint32_t version;      ///< SNAPSHOT_VERSION.
+    uint32_t nodeCount;    ///< Number of entries in the node array.
+    uint32_t stringsSize;  ///< Size of the string table, in bytes.
+    uint32_t crc;          ///< CRC32 of the node array and the string table.
+}
+SnapshotHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A node in a binary tree file.  The root node comes first.  The children of a node are stored
+ * next to each other, in order, somewhere after their parent.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t nameOffset;   ///< Offset of the node's name in the string table.
+    uint32_t data;         ///< For a stem, index of the first child.  For an integer with the
+                           ///<   SNAPSHOT_INLINE flag, the value itself.  For any other value,
+                           ///<   offset of the value (as returned by tdb_GetValueAsString()) in
+                           ///<   the string table.  Unused for an empty node.
+    uint32_t info;         ///< The node's le_cfg_nodeType_t, flags, and for a stem the number of
+                           ///<   children.  See SNAPSHOT_TYPE() and SNAPSHOT_CHILD_COUNT().
+}
+SnapshotNode_t;
+
+/// Flag set in SnapshotNode_t::info when an integer's value is stored in SnapshotNode_t::data.
+#define SNAPSHOT_INLINE 0x100
+
+/// Shift of the child count in SnapshotNode_t::info.
+#define SNAPSHOT_CHILD_SHIFT 9
+
+/// Maximum number of children a node can have in a binary tree file.
+#define SNAPSHOT_MAX_CHILDREN (UINT32_MAX >> SNAPSHOT_CHILD_SHIFT)
+
+/// Get the node type from a SnapshotNode_t.
+#define SNAPSHOT_TYPE(entryPtr) ((le_cfg_nodeType_t)((entryPtr)->info & 0xff))
+
+/// Get the child count from a SnapshotNode_t.
+#define SNAPSHOT_CHILD_COUNT(entryPtr) ((entryPtr)->info >> SNAPSHOT_CHILD_SHIFT)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A binary tree file, mapped into memory.  Each node that still has children to load from the file
+ * holds a reference to it, so it's unmapped once everything in it has been loaded (or thrown away).
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct Snapshot
+{
+    void* mapPtr;                     ///< The mapped file.
+    size_t mapSize;                   ///< Size of the mapping.
+    const SnapshotNode_t* nodesPtr;   ///< The node array.
+    uint32_t nodeCount;               ///< Number of entries in the node array.
+    const char* stringsPtr;           ///< The string table.  Always ends with a NUL.
+    uint32_t stringsSize;             ///< Size of the string table.
+}
+Snapshot_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A string table being built for a binary tree file.  Each string is only stored once.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char* bufferPtr;      ///< The strings, each with a terminating NUL.
+    size_t size;          ///< Number of bytes of the buffer used.
+    size_t capacity;      ///< Size of the buffer.
+    uint32_t* slotsPtr;   ///< Hash table of the strings' offsets plus 1 (0 is an empty slot).
+    size_t slotCount;     ///< Number of slots in the hash table, a power of 2.
+    size_t stringCount;   ///< Number of strings in the table.
+}
+SnapshotStrings_t;
+#endif
+
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Types of lexical tokens that can be found in configuration data files.
@@ -337,6 +535,16 @@ LE_MEM_DEFINE_STATIC_POOL(nodePool, LE_CONFIG_CFGTREE_MAX_NODE_POOL_SIZE, sizeof
 /// The memory pool responsible for tree nodes.
 static le_mem_PoolRef_t NodePoolRef = NULL;
 
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+/// Pool for the child indexes of nodes with many children.
+static le_mem_PoolRef_t ChildIndexPoolRef = NULL;
+#endif
+
+#if LE_CONFIG_CFGTREE_BINARY
+/// Pool for mapped binary tree files.
+static le_mem_PoolRef_t SnapshotPoolRef = NULL;
+#endif
+
 
 /// Define static memory for collection of configuration trees managed by the system
 LE_HASHMAP_DEFINE_STATIC(TreeCollection, LE_CONFIG_CFGTREE_MAX_TREE_POOL_SIZE);
@@ -571,6 +779,15 @@ static tdb_NodeRef_t NewNode
     newNodeRef->nameHash = 0;
     newNodeRef->siblingList = LE_DLS_LINK_INIT;
     memset(&newNodeRef->info, 0, sizeof(newNodeRef->info));
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    newNodeRef->childIndexPtr = NULL;
+    newNodeRef->indexNextPtr = NULL;
+    newNodeRef->indexHash = 0;
+#endif
+#if LE_CONFIG_CFGTREE_BINARY
+    newNodeRef->snapshotPtr = NULL;
+    newNodeRef->snapshotIndex = 0;
+#endif
 
     return newNodeRef;
 }
@@ -578,65 +795,74 @@ static tdb_NodeRef_t NewNode
 
 
 
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
 // -------------------------------------------------------------------------------------------------
 /**
- *  The node destructor function.  This will take care of freeing a node's string values and any
- *  children it may have.  Called automaticly by the memory system when a node is released.
+ *  Add a node to a child index.  The node's indexHash must already be set.
  */
 // -------------------------------------------------------------------------------------------------
-static void NodeDestructor
+static void InsertIndexEntry
 (
-    void* objectPtr  ///< [IN] The generic object to free.
+    ChildIndex_t* indexPtr,  ///< [IN] The index to update.
+    tdb_NodeRef_t childRef   ///< [IN] The child node to add.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_NodeRef_t nodeRef = (tdb_NodeRef_t)objectPtr;
+    Node_t** bucketPtr = &indexPtr->bucketsPtr[childRef->indexHash & (indexPtr->bucketCount - 1)];
 
-    if (nodeRef->nameRef)
-    {
-        dstr_Release(nodeRef->nameRef);
-    }
+    childRef->indexNextPtr = *bucketPtr;
+    *bucketPtr = childRef;
+    indexPtr->count++;
+}
 
-    switch (nodeRef->type)
-    {
-        case LE_CFG_TYPE_EMPTY:
-        case LE_CFG_TYPE_DOESNT_EXIST:
-            // Nothing to do here.
-            break;
 
-        case LE_CFG_TYPE_STRING:
-        case LE_CFG_TYPE_BOOL:
-        case LE_CFG_TYPE_INT:
-        case LE_CFG_TYPE_FLOAT:
-            if (nodeRef->info.valueRef)
-            {
-                dstr_Release(nodeRef->info.valueRef);
-            }
-            break;
 
-        case LE_CFG_TYPE_STEM:
-            {
-                tdb_NodeRef_t childRef = tdb_GetFirstChildNode(nodeRef);
 
-                while (childRef != NULL)
-                {
-                    tdb_NodeRef_t nextChildRef = tdb_GetNextSiblingNode(childRef);
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Replace the buckets of a child index with a new set of the given size, and refile all of the
+ *  children.
+ *
+ *  @return LE_OK if successful, LE_NO_MEMORY if the new buckets couldn't be allocated.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ResizeChildIndex
+(
+    ChildIndex_t* indexPtr,  ///< [IN] The index to resize.
+    size_t bucketCount       ///< [IN] The new number of buckets, a power of two.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    Node_t** newBucketsPtr = calloc(bucketCount, sizeof(Node_t*));
 
-                    le_mem_Release(childRef);
-                    childRef = nextChildRef;
-                }
-            }
-            break;
+    if (newBucketsPtr == NULL)
+    {
+        return LE_NO_MEMORY;
     }
 
-    if (nodeRef->parentRef != NULL)
+    Node_t** oldBucketsPtr = indexPtr->bucketsPtr;
+    size_t oldBucketCount = indexPtr->bucketCount;
+    size_t i;
+
+    indexPtr->bucketsPtr = newBucketsPtr;
+    indexPtr->bucketCount = bucketCount;
+    indexPtr->count = 0;
+
+    for (i = 0; i < oldBucketCount; i++)
     {
-        LE_ASSERT(nodeRef->parentRef->type == LE_CFG_TYPE_STEM);
-        LE_ASSERT(le_dls_IsEmpty(&nodeRef->parentRef->info.children) == false);
-        LE_ASSERT(le_dls_IsInList(&nodeRef->parentRef->info.children, &nodeRef->siblingList));
+        tdb_NodeRef_t childRef = oldBucketsPtr[i];
 
-        le_dls_Remove(&nodeRef->parentRef->info.children, &nodeRef->siblingList);
+        while (childRef != NULL)
+        {
+            tdb_NodeRef_t nextRef = childRef->indexNextPtr;
+
+            InsertIndexEntry(indexPtr, childRef);
+            childRef = nextRef;
+        }
     }
+
+    free(oldBucketsPtr);
+    return LE_OK;
 }
 
 
@@ -644,40 +870,25 @@ static void NodeDestructor
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Allocate a new node from our pool, and turn it into a shadow of an existing node.
- *
- *  @return A new node that shadows the existing node.
+ *  Free a node's child index, if it has one.  Must be done whenever the node's child list is
+ *  thrown away.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t NewShadowNode
+static void DropChildIndex
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The node to shadow.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node whose index is no longer needed.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Allocate a new blank node.
-    tdb_NodeRef_t newShadowRef = NewNode();
+    ChildIndex_t* indexPtr = nodeRef->childIndexPtr;
 
-    // Turn it into a shadow of the original node.  It's possible for nodeRef to be NULL.  We could
-    // be creating a shadow node for which no original exists.  Which is the case when creating a
-    // new path that didn't exist in the original tree.
-    if (nodeRef != NULL)
+    if (indexPtr != NULL)
     {
-        newShadowRef->type = nodeRef->type;
-        newShadowRef->flags = nodeRef->flags;
-        newShadowRef->shadowRef = nodeRef;
+        nodeRef->childIndexPtr = NULL;
 
-        // Now, if the parent node, (if there is a parent node,) is marked as deleted, then do the
-        // same with this new node.
-        if (   (nodeRef->parentRef != NULL)
-            && (IsDeleted(nodeRef->parentRef)))
-        {
-            SetDeletedFlag(newShadowRef);
-        }
+        free(indexPtr->bucketsPtr);
+        le_mem_Release(indexPtr);
     }
-
-    SetShadowFlag(newShadowRef);
-    return newShadowRef;
 }
 
 
@@ -685,133 +896,157 @@ static tdb_NodeRef_t NewShadowNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Create a new node and insert it into the given node's children collection.
- *
- *  @return The newly create node, already inserted into the supplied node's child collection.
+ *  Build an index of a node's current children.  If there isn't enough memory for the index, the
+ *  node is simply left without one.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t NewChildNode
+static void BuildChildIndex
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The node to be given with a new child.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to index the children of.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If the node is currently empty, then turn it into a stem.
-    if (nodeRef->type == LE_CFG_TYPE_EMPTY)
+    size_t bucketCount = 16;
+    size_t childCount = le_dls_NumLinks(&nodeRef->info.children);
+
+    while (bucketCount < childCount * 2)
     {
-        nodeRef->type = LE_CFG_TYPE_STEM;
+        bucketCount *= 2;
     }
 
-    LE_ASSERT(nodeRef->type == LE_CFG_TYPE_STEM);
-
-    // Create a new node.  Then set it's parent to the given node
-    tdb_NodeRef_t newRef = NewNode();
+    ChildIndex_t* indexPtr = le_mem_ForceAlloc(ChildIndexPoolRef);
 
-    newRef->parentRef = nodeRef;
-    newRef->type = LE_CFG_TYPE_EMPTY;
+    indexPtr->count = 0;
+    indexPtr->bucketCount = bucketCount;
+    indexPtr->bucketsPtr = calloc(bucketCount, sizeof(Node_t*));
 
-    // Get the new node to inheret the parent's shadow and deletion flags.
-    if (IsShadow(nodeRef))
+    if (indexPtr->bucketsPtr == NULL)
     {
-        SetShadowFlag(newRef);
-        SetDeletedFlag(newRef);
+        le_mem_Release(indexPtr);
+        return;
     }
 
-    if (IsDeleted(nodeRef))
+    le_dls_Link_t* linkPtr = le_dls_Peek(&nodeRef->info.children);
+
+    while (linkPtr != NULL)
     {
-        SetDeletedFlag(newRef);
-    }
+        tdb_NodeRef_t childRef = CONTAINER_OF(linkPtr, Node_t, siblingList);
 
-    // Now make sure to add the new child node to the end of the parents collection.
-    le_dls_Queue(&nodeRef->info.children, &newRef->siblingList);
+        childRef->indexHash = tdb_GetNodeNameHash(childRef);
+        InsertIndexEntry(indexPtr, childRef);
 
-    // Finally return the newly created node to the caller.
-    return newRef;
+        linkPtr = le_dls_PeekNext(&nodeRef->info.children, linkPtr);
+    }
+
+    nodeRef->childIndexPtr = indexPtr;
 }
+#endif /* end LE_CONFIG_CFGTREE_CHILD_INDEX */
 
 
 
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Called to shadow a node's collection of children.
+ *  File a node under its current name in its parent's child index.  Called whenever a node is
+ *  added to a child list, and after it is renamed.
  */
 // -------------------------------------------------------------------------------------------------
-static void ShadowChildren
+static void IndexChild
 (
-    tdb_NodeRef_t shadowParentRef  ///< [IN] The node we're shadowing the children of.
+    tdb_NodeRef_t childRef  ///< [IN] The child node.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If the parent node isn't a stem then there isn't much else to do here.
-    if (shadowParentRef->type != LE_CFG_TYPE_STEM)
-    {
-        return;
-    }
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    childRef->indexHash = tdb_GetNodeNameHash(childRef);
 
-    // Does this node have any children currently?  If yes, then we don't need to do anything else.
-    if (le_dls_IsEmpty(&shadowParentRef->info.children) == false)
+    if (   (childRef->parentRef == NULL)
+        || (childRef->parentRef->childIndexPtr == NULL))
     {
         return;
     }
 
-    // Has this node been modified?  If so, then the shadow children may have been cleared from
-    // this collection.
-    if (IsModified(shadowParentRef) == true)
+    ChildIndex_t* indexPtr = childRef->parentRef->childIndexPtr;
+
+    // Keep the chains short.  If the index can't grow, stop using it rather than letting lookups
+    // slow down.
+    if (   (indexPtr->count >= indexPtr->bucketCount)
+        && (ResizeChildIndex(indexPtr, indexPtr->bucketCount * 2) != LE_OK))
     {
+        DropChildIndex(childRef->parentRef);
         return;
     }
 
-    // This node has no shadow children.  So what we do now is check the original node... Does it
-    // have any children?  If it does, we simply recreate the whole collection now.  (We do not
-    // recurse into the grandchildren though.)  Doing this now makes life simpler, instead of doing
-    // this piecemeal and possibly out of order.
-    tdb_NodeRef_t originalRef = shadowParentRef->shadowRef;
+    InsertIndexEntry(indexPtr, childRef);
+#else
+    LE_UNUSED(childRef);
+#endif
+}
 
-    if (   (originalRef == NULL)
-        || (originalRef->type != LE_CFG_TYPE_STEM))
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Remove a node from its parent's child index.  Called before a node is removed from a child
+ *  list, and before it is renamed.
+ */
+// -------------------------------------------------------------------------------------------------
+static void UnindexChild
+(
+    tdb_NodeRef_t childRef  ///< [IN] The child node.
+)
+// -------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    if (   (childRef->parentRef == NULL)
+        || (childRef->parentRef->childIndexPtr == NULL))
     {
         return;
     }
 
-    // Simply iterate through the original collection and add a new shadow child to our own
-    // collection.
-    tdb_NodeRef_t originalChildRef = tdb_GetFirstChildNode(originalRef);
+    ChildIndex_t* indexPtr = childRef->parentRef->childIndexPtr;
+    Node_t** entryPtr = &indexPtr->bucketsPtr[childRef->indexHash & (indexPtr->bucketCount - 1)];
 
-    while (originalChildRef != NULL)
+    while (*entryPtr != NULL)
     {
-        tdb_NodeRef_t newShadowRef = NewShadowNode(originalChildRef);
-        newShadowRef->parentRef = shadowParentRef;
-
-        le_dls_Queue(&shadowParentRef->info.children, &newShadowRef->siblingList);
+        if (*entryPtr == childRef)
+        {
+            *entryPtr = childRef->indexNextPtr;
+            childRef->indexNextPtr = NULL;
+            indexPtr->count--;
+            return;
+        }
 
-        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
+        entryPtr = &(*entryPtr)->indexNextPtr;
     }
+
+    LE_CRIT("Node missing from child index.");
+#else
+    LE_UNUSED(childRef);
+#endif
 }
 
 
 
 
+#if LE_CONFIG_CFGTREE_BINARY
 // -------------------------------------------------------------------------------------------------
 /**
- *  Search up through a node tree until we find the root node.
+ *  Destructor called when the last node with children still in a binary tree file has let go of
+ *  it.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t GetRootParentNode
+static void SnapshotDestructor
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] Find the greatest grand parent of this node.
+    void* objectPtr  ///< The memory object to destruct.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_NodeRef_t parentRef = NULL;
-
-    while (nodeRef != NULL)
-    {
-        parentRef = nodeRef;
-        nodeRef = tdb_GetNodeParent(nodeRef);
-    }
+    Snapshot_t* snapshotPtr = (Snapshot_t*)objectPtr;
 
-    return parentRef;
+    LE_ERROR_IF(munmap(snapshotPtr->mapPtr, snapshotPtr->mapSize) != 0,
+                "Failed to unmap tree file (%m).");
 }
 
 
@@ -819,62 +1054,50 @@ static tdb_NodeRef_t GetRootParentNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Called to look for a named child in a given node's child collection.
- *
- *  @return Reference to the found child node, or NULL if a node was not found.
+ *  Give a node the type and value of a node in a binary tree file.  If the node is a stem, its
+ *  children are left in the file until they're needed.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t GetNamedChild
+static void SetFromSnapshot
 (
-    tdb_NodeRef_t nodeRef,  ///< [IN] The node to search.
-    const char* nameRef     ///< [IN] The name we're searching for.
+    tdb_NodeRef_t nodeRef,     ///< [IN] The node to update.  Must be empty.
+    Snapshot_t* snapshotPtr,   ///< [IN] The binary tree file.
+    uint32_t index             ///< [IN] Index of the node in the file.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Is this one of the "special" names?
-    if (strcmp(nameRef, ".") == 0)
-    {
-        return nodeRef;
-    }
+    const SnapshotNode_t* entryPtr = &snapshotPtr->nodesPtr[index];
 
-    if (strcmp(nameRef, "..") == 0)
-    {
-        return nodeRef->parentRef;
-    }
+    nodeRef->type = SNAPSHOT_TYPE(entryPtr);
 
-    // If the current node isn't a stem, then this node can't have any children.
-    if (nodeRef->type != LE_CFG_TYPE_STEM)
+    switch (nodeRef->type)
     {
-        return NULL;
-    }
-
-    // Search the child list for a node with the given name.
-    tdb_NodeRef_t currentRef = tdb_GetFirstChildNode(nodeRef);
-    char currentNameRef[LE_CFG_NAME_LEN_BYTES] = "";
-    size_t stringHash = le_hashmap_HashString(nameRef);
-    size_t nodeHash;
+        case LE_CFG_TYPE_EMPTY:
+            break;
 
-    while (currentRef != NULL)
-    {
-        nodeHash = tdb_GetNodeNameHash(currentRef);
+        case LE_CFG_TYPE_STEM:
+            if (SNAPSHOT_CHILD_COUNT(entryPtr) > 0)
+            {
+                le_mem_AddRef(snapshotPtr);
+                nodeRef->snapshotPtr = snapshotPtr;
+                nodeRef->snapshotIndex = index;
+            }
+            break;
 
-        // if the hash doesn't match, the name is different. If the hash matches, there is
-        // a small possibility of collision, and the string comparison is required.
-        if (stringHash == nodeHash)
-        {
-            tdb_GetNodeName(currentRef, currentNameRef, sizeof(currentNameRef));
+        default:
+            if (entryPtr->info & SNAPSHOT_INLINE)
+            {
+                char buffer[SMALL_STR];
 
-            if (strncmp(currentNameRef, nameRef, sizeof(currentNameRef)) == 0)
+                snprintf(buffer, sizeof(buffer), "%d", (int32_t)entryPtr->data);
+                nodeRef->info.valueRef = dstr_NewFromCstr(buffer);
+            }
+            else
             {
-                return currentRef;
+                nodeRef->info.valueRef = dstr_NewFromCstr(snapshotPtr->stringsPtr + entryPtr->data);
             }
-        }
-
-        currentRef = tdb_GetNextSiblingNode(currentRef);
+            break;
     }
-
-    // Looks like there was no node to return.
-    return NULL;
 }
 
 
@@ -882,106 +1105,149 @@ static tdb_NodeRef_t GetNamedChild
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Called to create a named child in a nodes child collection.  However, this function will only
- *  create nodes on shadow trees.
- *
- *  @return Reference to newly created child node, or NULL if it can not be created.
+ *  If a node's children are still in a binary tree file, create them now.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t CreateNamedChild
+static void LoadSnapshotChildren
 (
-    tdb_NodeRef_t nodeRef,  ///< [IN] The node to search.
-    const char* nameRef     ///< [IN] The name we're searching for.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node whose children are needed.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_NodeRef_t childRef = NULL;
+    Snapshot_t* snapshotPtr = nodeRef->snapshotPtr;
 
-    if (IsShadow(nodeRef) == true)
+    if (snapshotPtr == NULL)
     {
-        // If the node isn't a stem, then convert it into an empty one now.
-        if (   (nodeRef->type != LE_CFG_TYPE_STEM)
-            && (nodeRef->type != LE_CFG_TYPE_EMPTY))
-        {
-            tdb_SetEmpty(nodeRef);
-            nodeRef->type = LE_CFG_TYPE_STEM;
-            nodeRef->info.children = LE_DLS_LIST_INIT;
-        }
+        return;
+    }
 
-        // Create the node, and set it's deleted flag as it hasn't been used for anything yet.
-        childRef = NewChildNode(nodeRef);
-        SetDeletedFlag(childRef);
+    nodeRef->snapshotPtr = NULL;
 
-        // Set the name of the new node, if that fails then the user had given us a bad name for the
-        // new node.  So in that case free the node and return NULL.
-        if (tdb_SetNodeName(childRef, nameRef) != LE_OK)
-        {
-            le_mem_Release(childRef);
-            childRef = NULL;
-        }
+    const SnapshotNode_t* entryPtr = &snapshotPtr->nodesPtr[nodeRef->snapshotIndex];
+    uint32_t childCount = SNAPSHOT_CHILD_COUNT(entryPtr);
+    uint32_t i;
+
+    for (i = 0; i < childCount; i++)
+    {
+        uint32_t childIndex = entryPtr->data + i;
+        const SnapshotNode_t* childEntryPtr = &snapshotPtr->nodesPtr[childIndex];
+        const char* namePtr = snapshotPtr->stringsPtr + childEntryPtr->nameOffset;
+        tdb_NodeRef_t childRef = NewNode();
+
+        childRef->parentRef = nodeRef;
+        childRef->nameRef = dstr_NewFromCstr(namePtr);
+        childRef->nameHash = le_hashmap_HashString(namePtr);
+        SetFromSnapshot(childRef, snapshotPtr, childIndex);
+
+        le_dls_Queue(&nodeRef->info.children, &childRef->siblingList);
+        IndexChild(childRef);
     }
 
-    return childRef;
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    // No point waiting for a slow search to index these.
+    if (childCount >= LE_CONFIG_CFGTREE_CHILD_INDEX_THRESHOLD)
+    {
+        BuildChildIndex(nodeRef);
+    }
+#endif
+
+    le_mem_Release(snapshotPtr);
 }
 
 
+
+
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check to see if a given node exists within a node's child collection.
- *
- *  @return True if the given node exists within the parent node's collection.  False if not.
+ *  If a node's children are still in a binary tree file, forget about them.  Used when the children
+ *  are about to be thrown away anyway.
  */
 // -------------------------------------------------------------------------------------------------
-static bool NodeExists
+static void DropSnapshotChildren
 (
-    tdb_NodeRef_t parentRef,  ///< [IN] The parent node to search.
-    const char* namePtr       ///< [IN] The name to search for.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node whose children aren't needed.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_NodeRef_t currentRef = tdb_GetFirstChildNode(parentRef);
-    char currentName[LE_CFG_NAME_LEN_BYTES] = "";
-
-    while (currentRef != NULL)
+    if (nodeRef->snapshotPtr != NULL)
     {
-        tdb_GetNodeName(currentRef, currentName, sizeof(currentName));
-
-        if (strncmp(currentName, namePtr, sizeof(currentName)) == 0)
-        {
-            return true;
-        }
-
-        currentRef = tdb_GetNextSiblingNode(currentRef);
+        le_mem_Release(nodeRef->snapshotPtr);
+        nodeRef->snapshotPtr = NULL;
     }
-
-    return false;
 }
+#endif /* end LE_CONFIG_CFGTREE_BINARY */
+
+
 
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check the given node type and see if it should have a string value.
- *
- *  @return True if the given node could hold a string value.  False if not.
+ *  The node destructor function.  This will take care of freeing a node's string values and any
+ *  children it may have.  Called automaticly by the memory system when a node is released.
  */
 // -------------------------------------------------------------------------------------------------
-static bool IsStringType
+static void NodeDestructor
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The node to read.
+    void* objectPtr  ///< [IN] The generic object to free.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_cfg_nodeType_t type = tdb_GetNodeType(nodeRef);
+    tdb_NodeRef_t nodeRef = (tdb_NodeRef_t)objectPtr;
 
-    if (   (type == LE_CFG_TYPE_STRING)
-        || (type == LE_CFG_TYPE_BOOL)
-        || (type == LE_CFG_TYPE_INT)
-        || (type == LE_CFG_TYPE_FLOAT))
+    if (nodeRef->nameRef)
     {
-        return true;
+        dstr_Release(nodeRef->nameRef);
     }
 
-    return false;
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    // The children are all about to go, so don't bother taking them out of the index one by one.
+    DropChildIndex(nodeRef);
+#endif
+#if LE_CONFIG_CFGTREE_BINARY
+    DropSnapshotChildren(nodeRef);
+#endif
+
+    switch (nodeRef->type)
+    {
+        case LE_CFG_TYPE_EMPTY:
+        case LE_CFG_TYPE_DOESNT_EXIST:
+            // Nothing to do here.
+            break;
+
+        case LE_CFG_TYPE_STRING:
+        case LE_CFG_TYPE_BOOL:
+        case LE_CFG_TYPE_INT:
+        case LE_CFG_TYPE_FLOAT:
+            if (nodeRef->info.valueRef)
+            {
+                dstr_Release(nodeRef->info.valueRef);
+            }
+            break;
+
+        case LE_CFG_TYPE_STEM:
+            {
+                tdb_NodeRef_t childRef = tdb_GetFirstChildNode(nodeRef);
+
+                while (childRef != NULL)
+                {
+                    tdb_NodeRef_t nextChildRef = tdb_GetNextSiblingNode(childRef);
+
+                    le_mem_Release(childRef);
+                    childRef = nextChildRef;
+                }
+            }
+            break;
+    }
+
+    if (nodeRef->parentRef != NULL)
+    {
+        LE_ASSERT(nodeRef->parentRef->type == LE_CFG_TYPE_STEM);
+        LE_ASSERT(le_dls_IsEmpty(&nodeRef->parentRef->info.children) == false);
+        LE_ASSERT(le_dls_IsInList(&nodeRef->parentRef->info.children, &nodeRef->siblingList));
+
+        UnindexChild(nodeRef);
+        le_dls_Remove(&nodeRef->parentRef->info.children, &nodeRef->siblingList);
+    }
 }
 
 
@@ -989,34 +1255,40 @@ static bool IsStringType
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  This function will copy a string value from an original tree node into a node that has shadowed
- *  it.
+ *  Allocate a new node from our pool, and turn it into a shadow of an existing node.
+ *
+ *  @return A new node that shadows the existing node.
  */
 // -------------------------------------------------------------------------------------------------
-static void PropagateValue
+static tdb_NodeRef_t NewShadowNode
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The node ref to update.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to shadow.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If the node doesn't even have a ref to an original node, then there's nothing left to do
-    // here.
-    tdb_NodeRef_t shadowRef = nodeRef->shadowRef;
+    // Allocate a new blank node.
+    tdb_NodeRef_t newShadowRef = NewNode();
 
-    if (shadowRef == NULL)
+    // Turn it into a shadow of the original node.  It's possible for nodeRef to be NULL.  We could
+    // be creating a shadow node for which no original exists.  Which is the case when creating a
+    // new path that didn't exist in the original tree.
+    if (nodeRef != NULL)
     {
-        return;
-    }
+        newShadowRef->type = nodeRef->type;
+        newShadowRef->flags = nodeRef->flags;
+        newShadowRef->shadowRef = nodeRef;
 
-    // Ok, figure out the type for this node.  If it has a value, and the original
-    if (   (IsStringType(nodeRef) == true)
-        && (IsStringType(shadowRef) == true)
-        && (nodeRef->info.valueRef == NULL)
-        && (shadowRef->info.valueRef != NULL))
-    {
-        // Looks like the value hasn't been propagated or changed yet.  So, do so now.
-        nodeRef->info.valueRef = dstr_NewFromDstr(shadowRef->info.valueRef);
+        // Now, if the parent node, (if there is a parent node,) is marked as deleted, then do the
+        // same with this new node.
+        if (   (nodeRef->parentRef != NULL)
+            && (IsDeleted(nodeRef->parentRef)))
+        {
+            SetDeletedFlag(newShadowRef);
+        }
     }
+
+    SetShadowFlag(newShadowRef);
+    return newShadowRef;
 }
 
 
@@ -1024,124 +1296,240 @@ static void PropagateValue
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Merge a shadow node with the original it represents.
+ *  Create a new node and insert it into the given node's children collection.
+ *
+ *  @return The newly create node, already inserted into the supplied node's child collection.
  */
 // -------------------------------------------------------------------------------------------------
-static void MergeNode
+static tdb_NodeRef_t NewChildNode
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The shadow node to merge.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to be given with a new child.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    LE_ASSERT(nodeRef != NULL);
+#if LE_CONFIG_CFGTREE_BINARY
+    // The new child goes after any existing ones.
+    LoadSnapshotChildren(nodeRef);
+#endif
 
-    // If this shadow node for some reason doesn't have a ref check for an original version of it in
-    // the original tree.  This shadow node may have been destroyed and re-created loosing this
-    // link.
-    if (nodeRef->shadowRef == NULL)
+    // If the node is currently empty, then turn it into a stem.
+    if (nodeRef->type == LE_CFG_TYPE_EMPTY)
     {
-        tdb_NodeRef_t shadowedParentRef = tdb_GetNodeParent(nodeRef)->shadowRef;
+        nodeRef->type = LE_CFG_TYPE_STEM;
+    }
 
-        if (shadowedParentRef != NULL)
-        {
-            char name[LE_CFG_NAME_LEN_BYTES] = "";
+    LE_ASSERT(nodeRef->type == LE_CFG_TYPE_STEM);
 
-            tdb_GetNodeName(nodeRef, name, sizeof(name));
-            nodeRef->shadowRef = GetNamedChild(shadowedParentRef, name);
-        }
+    // Create a new node.  Then set it's parent to the given node
+    tdb_NodeRef_t newRef = NewNode();
+
+    newRef->parentRef = nodeRef;
+    newRef->type = LE_CFG_TYPE_EMPTY;
+
+    // Get the new node to inheret the parent's shadow and deletion flags.
+    if (IsShadow(nodeRef))
+    {
+        SetShadowFlag(newRef);
+        SetDeletedFlag(newRef);
     }
 
-    // If this node has been marked as deleted, then simply drop the original node and move on.
     if (IsDeleted(nodeRef))
     {
-        if (   (nodeRef->shadowRef != NULL)
-            && (tdb_GetNodeParent(nodeRef->shadowRef) != NULL))
-        {
-            le_mem_Release(nodeRef->shadowRef);
-        }
-        else
-        {
-            // We delete every node but the root node.  Since this is the root node, we just need
-            // to clear it out.
-            tdb_SetEmpty(nodeRef->shadowRef);
-        }
-
-        return;
+        SetDeletedFlag(newRef);
     }
 
-    // If the original node doesn't exist, create it now.
-    tdb_NodeRef_t originalRef = nodeRef->shadowRef;
+    // Now make sure to add the new child node to the end of the parents collection.
+    le_dls_Queue(&nodeRef->info.children, &newRef->siblingList);
+    IndexChild(newRef);
 
-    if (originalRef == NULL)
+    // Finally return the newly created node to the caller.
+    return newRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Called to shadow a node's collection of children.
+ */
+// -------------------------------------------------------------------------------------------------
+static void ShadowChildren
+(
+    tdb_NodeRef_t shadowParentRef  ///< [IN] The node we're shadowing the children of.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // If the parent node isn't a stem then there isn't much else to do here.
+    if (shadowParentRef->type != LE_CFG_TYPE_STEM)
     {
-        LE_ASSERT(nodeRef->parentRef != NULL);
-        LE_ASSERT(nodeRef->parentRef->shadowRef != NULL);
+        return;
+    }
 
-        nodeRef->shadowRef = originalRef = NewChildNode(nodeRef->parentRef->shadowRef);
+    // Does this node have any children currently?  If yes, then we don't need to do anything else.
+    if (le_dls_IsEmpty(&shadowParentRef->info.children) == false)
+    {
+        return;
     }
 
-    ClearModifiedFlag(originalRef);
+    // Has this node been modified?  If so, then the shadow children may have been cleared from
+    // this collection.
+    if (IsModified(shadowParentRef) == true)
+    {
+        return;
+    }
 
-    // If the name has been changed, then copy it over now.
-    if (dstr_IsNullOrEmpty(nodeRef->nameRef) == false)
+    // This node has no shadow children.  So what we do now is check the original node... Does it
+    // have any children?  If it does, we simply recreate the whole collection now.  (We do not
+    // recurse into the grandchildren though.)  Doing this now makes life simpler, instead of doing
+    // this piecemeal and possibly out of order.
+    tdb_NodeRef_t originalRef = shadowParentRef->shadowRef;
+
+    if (   (originalRef == NULL)
+        || (originalRef->type != LE_CFG_TYPE_STEM))
     {
-        if (originalRef->nameRef != NULL)
-        {
-            dstr_Copy(originalRef->nameRef, nodeRef->nameRef);
-        }
-        else
-        {
-            originalRef->nameRef = dstr_NewFromDstr(nodeRef->nameRef);
-        }
-        originalRef->nameHash = nodeRef->nameHash;
+        return;
     }
 
-    // Check the types of the original and the shadow nodes.  If the new node has been cleared,
-    // then clear out the original node.  If the types have changed, then clear out the original so
-    // that we can properly populate it again.
-    le_cfg_nodeType_t nodeType = tdb_GetNodeType(nodeRef);
+    // Simply iterate through the original collection and add a new shadow child to our own
+    // collection.
+    tdb_NodeRef_t originalChildRef = tdb_GetFirstChildNode(originalRef);
 
-    // If the nodeRef->type is LE_CFG_TYPE_EMPTY, tdb_GetNodeType will return node type of
-    // original node, which is incorrect. nodeType should be LE_CFG_TYPE_EMPTY.
-    if(nodeRef->type == LE_CFG_TYPE_EMPTY)
+    while (originalChildRef != NULL)
     {
-      nodeType = LE_CFG_TYPE_EMPTY;
+        tdb_NodeRef_t newShadowRef = NewShadowNode(originalChildRef);
+        newShadowRef->parentRef = shadowParentRef;
+
+        le_dls_Queue(&shadowParentRef->info.children, &newShadowRef->siblingList);
+        IndexChild(newShadowRef);
+
+        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
     }
+}
 
-    if (   (nodeType == LE_CFG_TYPE_EMPTY)
-        || (nodeType != originalRef->type))
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Search up through a node tree until we find the root node.
+ */
+// -------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t GetRootParentNode
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] Find the greatest grand parent of this node.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_NodeRef_t parentRef = NULL;
+
+    while (nodeRef != NULL)
     {
-        tdb_SetEmpty(originalRef);
+        parentRef = nodeRef;
+        nodeRef = tdb_GetNodeParent(nodeRef);
     }
 
-    // Ok, we know that the node hasn't been deleted.  Check to see if it's considered empty and
-    // that it isn't a stem.  If not, then copy over the string value.
-    if (   (nodeType != LE_CFG_TYPE_EMPTY)
-        && (nodeType != LE_CFG_TYPE_STEM))
+    return parentRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Called to look for a named child in a given node's child collection.
+ *
+ *  @return Reference to the found child node, or NULL if a node was not found.
+ */
+// -------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t GetNamedChild
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node to search.
+    const char* nameRef     ///< [IN] The name we're searching for.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Is this one of the "special" names?
+    if (strcmp(nameRef, ".") == 0)
     {
-        if (nodeRef->info.valueRef != NULL)
+        return nodeRef;
+    }
+
+    if (strcmp(nameRef, "..") == 0)
+    {
+        return nodeRef->parentRef;
+    }
+
+    // If the current node isn't a stem, then this node can't have any children.
+    if (nodeRef->type != LE_CFG_TYPE_STEM)
+    {
+        return NULL;
+    }
+
+    // Search the child list for a node with the given name.
+    tdb_NodeRef_t currentRef = tdb_GetFirstChildNode(nodeRef);
+    char currentNameRef[LE_CFG_NAME_LEN_BYTES] = "";
+    size_t stringHash = le_hashmap_HashString(nameRef);
+    size_t nodeHash;
+
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    // If the children have been indexed, only the ones with the same hash need to be looked at.
+    ChildIndex_t* indexPtr = nodeRef->childIndexPtr;
+
+    if (indexPtr != NULL)
+    {
+        currentRef = indexPtr->bucketsPtr[stringHash & (indexPtr->bucketCount - 1)];
+
+        while (currentRef != NULL)
         {
-            if (originalRef->info.valueRef != NULL)
+            if (currentRef->indexHash == stringHash)
             {
-                dstr_Copy(originalRef->info.valueRef, nodeRef->info.valueRef);
+                tdb_GetNodeName(currentRef, currentNameRef, sizeof(currentNameRef));
+
+                if (strncmp(currentNameRef, nameRef, sizeof(currentNameRef)) == 0)
+                {
+                    return currentRef;
+                }
             }
-            else
+
+            currentRef = currentRef->indexNextPtr;
+        }
+
+        return NULL;
+    }
+
+    size_t searchCount = 0;
+#endif
+
+    while (currentRef != NULL)
+    {
+        nodeHash = tdb_GetNodeNameHash(currentRef);
+
+        // if the hash doesn't match, the name is different. If the hash matches, there is
+        // a small possibility of collision, and the string comparison is required.
+        if (stringHash == nodeHash)
+        {
+            tdb_GetNodeName(currentRef, currentNameRef, sizeof(currentNameRef));
+
+            if (strncmp(currentNameRef, nameRef, sizeof(currentNameRef)) == 0)
             {
-                originalRef->info.valueRef = dstr_NewFromDstr(nodeRef->info.valueRef);
+                return currentRef;
             }
+        }
 
-            // Propigate over the type as that may have changed, like going from an int value to a
-            // bool value.
+        currentRef = tdb_GetNextSiblingNode(currentRef);
 
-            originalRef->type = nodeRef->type;
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+        // That is a long search.  Index the children so that next time it isn't.
+        if (++searchCount == LE_CONFIG_CFGTREE_CHILD_INDEX_THRESHOLD)
+        {
+            BuildChildIndex(nodeRef);
         }
+#endif
     }
 
-    // Now at this point, if both the original and the shadow node are stems, we'll let the function
-    // InternalMergeTree take care of the children, (if any.)
-
-    // If the original has been cleared out, we can still just rely on InternalMergeTree to
-    // propigate over the new nodes.
+    // Looks like there was no node to return.
+    return NULL;
 }
 
 
@@ -1149,77 +1537,1713 @@ static void MergeNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Called to fire any callbacks registered on the given node path.  If nothing is registered on the
- *  given path, nothing happens.
+ *  Called to create a named child in a nodes child collection.  However, this function will only
+ *  create nodes on shadow trees.
+ *
+ *  @return Reference to newly created child node, or NULL if it can not be created.
  */
 // -------------------------------------------------------------------------------------------------
-static void TriggerCallbacks
+static tdb_NodeRef_t CreateNamedChild
 (
-    le_pathIter_Ref_t pathRef  ///< [IN] The path to search for callback registrations.
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node to search.
+    const char* nameRef     ///< [IN] The name we're searching for.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Read the path out of the buffer.
-    char pathBuffer[CFG_MAX_PATH_SIZE] = { 0 };
-    if (le_pathIter_GetPath(pathRef, pathBuffer, sizeof(pathBuffer)) != LE_OK)
-    {
-        LE_ERROR("Callback path buffer overflow.");
-        return;
-    }
-
-    // Try to find a registration object for this path.  If one is found, flag it for calling once
-    // the merge is complete.
-    Registration_t* foundRegistrationPtr = le_hashmap_Get(HandlerRegistrationMap, pathBuffer);
+    tdb_NodeRef_t childRef = NULL;
 
-    if (foundRegistrationPtr != NULL)
+    if (IsShadow(nodeRef) == true)
     {
-        foundRegistrationPtr->triggered = true;
-    }
-}
+        // If the node isn't a stem, then convert it into an empty one now.
+        if (   (nodeRef->type != LE_CFG_TYPE_STEM)
+            && (nodeRef->type != LE_CFG_TYPE_EMPTY))
+        {
+            tdb_SetEmpty(nodeRef);
+            nodeRef->type = LE_CFG_TYPE_STEM;
+            nodeRef->info.children = LE_DLS_LIST_INIT;
+        }
 
+        // Create the node, and set it's deleted flag as it hasn't been used for anything yet.
+        childRef = NewChildNode(nodeRef);
+        SetDeletedFlag(childRef);
 
+        // Set the name of the new node, if that fails then the user had given us a bad name for the
+        // new node.  So in that case free the node and return NULL.
+        if (tdb_SetNodeName(childRef, nameRef) != LE_OK)
+        {
+            le_mem_Release(childRef);
+            childRef = NULL;
+        }
+    }
 
+    return childRef;
+}
 
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Go through all of the registered event callbacks, and fire the call backs for each of the
- *  registrations that has been makred as triggered.
+ *  Check to see if a given node exists within a node's child collection.
  *
- *  Once this is done, the triggered flag is cleared for next time.
+ *  @return True if the given node exists within the parent node's collection.  False if not.
  */
 // -------------------------------------------------------------------------------------------------
-static void FireTriggeredCallbacks
+static bool NodeExists
 (
-    void
+    tdb_NodeRef_t parentRef,  ///< [IN] The parent node to search.
+    const char* namePtr       ///< [IN] The name to search for.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Go through the registration map.
-    le_hashmap_It_Ref_t handlerIterRef = le_hashmap_GetIterator(HandlerRegistrationMap);
+    return GetNamedChild(parentRef, namePtr) != NULL;
+}
 
-    while (le_hashmap_NextNode(handlerIterRef) == LE_OK)
-    {
-        // For each registration, check to see if it was triggered.
-        Registration_t* registrationPtr = (Registration_t*)le_hashmap_GetValue(handlerIterRef);
 
-        if (registrationPtr->triggered)
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check the given node type and see if it should have a string value.
+ *
+ *  @return True if the given node could hold a string value.  False if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool IsStringType
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to read.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_cfg_nodeType_t type = tdb_GetNodeType(nodeRef);
+
+    if (   (type == LE_CFG_TYPE_STRING)
+        || (type == LE_CFG_TYPE_BOOL)
+        || (type == LE_CFG_TYPE_INT)
+        || (type == LE_CFG_TYPE_FLOAT))
+    {
+        return true;
+    }
+
+    return false;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  This function will copy a string value from an original tree node into a node that has shadowed
+ *  it.
+ */
+// -------------------------------------------------------------------------------------------------
+static void PropagateValue
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The node ref to update.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // If the node doesn't even have a ref to an original node, then there's nothing left to do
+    // here.
+    tdb_NodeRef_t shadowRef = nodeRef->shadowRef;
+
+    if (shadowRef == NULL)
+    {
+        return;
+    }
+
+    // Ok, figure out the type for this node.  If it has a value, and the original
+    if (   (IsStringType(nodeRef) == true)
+        && (IsStringType(shadowRef) == true)
+        && (nodeRef->info.valueRef == NULL)
+        && (shadowRef->info.valueRef != NULL))
+    {
+        // Looks like the value hasn't been propagated or changed yet.  So, do so now.
+        nodeRef->info.valueRef = dstr_NewFromDstr(shadowRef->info.valueRef);
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Merge a shadow node with the original it represents.
+ */
+// -------------------------------------------------------------------------------------------------
+static void MergeNode
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The shadow node to merge.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(nodeRef != NULL);
+
+    // If this shadow node for some reason doesn't have a ref check for an original version of it in
+    // the original tree.  This shadow node may have been destroyed and re-created loosing this
+    // link.
+    if (nodeRef->shadowRef == NULL)
+    {
+        tdb_NodeRef_t shadowedParentRef = tdb_GetNodeParent(nodeRef)->shadowRef;
+
+        if (shadowedParentRef != NULL)
+        {
+            char name[LE_CFG_NAME_LEN_BYTES] = "";
+
+            tdb_GetNodeName(nodeRef, name, sizeof(name));
+            nodeRef->shadowRef = GetNamedChild(shadowedParentRef, name);
+        }
+    }
+
+    // If this node has been marked as deleted, then simply drop the original node and move on.
+    if (IsDeleted(nodeRef))
+    {
+        if (   (nodeRef->shadowRef != NULL)
+            && (tdb_GetNodeParent(nodeRef->shadowRef) != NULL))
+        {
+            le_mem_Release(nodeRef->shadowRef);
+        }
+        else
+        {
+            // We delete every node but the root node.  Since this is the root node, we just need
+            // to clear it out.
+            tdb_SetEmpty(nodeRef->shadowRef);
+        }
+
+        return;
+    }
+
+    // If the original node doesn't exist, create it now.
+    tdb_NodeRef_t originalRef = nodeRef->shadowRef;
+
+    if (originalRef == NULL)
+    {
+        LE_ASSERT(nodeRef->parentRef != NULL);
+        LE_ASSERT(nodeRef->parentRef->shadowRef != NULL);
+
+        nodeRef->shadowRef = originalRef = NewChildNode(nodeRef->parentRef->shadowRef);
+    }
+
+    ClearModifiedFlag(originalRef);
+
+    // If the name has been changed, then copy it over now.
+    if (dstr_IsNullOrEmpty(nodeRef->nameRef) == false)
+    {
+        UnindexChild(originalRef);
+
+        if (originalRef->nameRef != NULL)
+        {
+            dstr_Copy(originalRef->nameRef, nodeRef->nameRef);
+        }
+        else
+        {
+            originalRef->nameRef = dstr_NewFromDstr(nodeRef->nameRef);
+        }
+        originalRef->nameHash = nodeRef->nameHash;
+
+        IndexChild(originalRef);
+    }
+
+    // Check the types of the original and the shadow nodes.  If the new node has been cleared,
+    // then clear out the original node.  If the types have changed, then clear out the original so
+    // that we can properly populate it again.
+    le_cfg_nodeType_t nodeType = tdb_GetNodeType(nodeRef);
+
+    // If the nodeRef->type is LE_CFG_TYPE_EMPTY, tdb_GetNodeType will return node type of
+    // original node, which is incorrect. nodeType should be LE_CFG_TYPE_EMPTY.
+    if(nodeRef->type == LE_CFG_TYPE_EMPTY)
+    {
+      nodeType = LE_CFG_TYPE_EMPTY;
+    }
+
+    if (   (nodeType == LE_CFG_TYPE_EMPTY)
+        || (nodeType != originalRef->type))
+    {
+        tdb_SetEmpty(originalRef);
+    }
+
+    // Ok, we know that the node hasn't been deleted.  Check to see if it's considered empty and
+    // that it isn't a stem.  If not, then copy over the string value.
+    if (   (nodeType != LE_CFG_TYPE_EMPTY)
+        && (nodeType != LE_CFG_TYPE_STEM))
+    {
+        if (nodeRef->info.valueRef != NULL)
+        {
+            if (originalRef->info.valueRef != NULL)
+            {
+                dstr_Copy(originalRef->info.valueRef, nodeRef->info.valueRef);
+            }
+            else
+            {
+                originalRef->info.valueRef = dstr_NewFromDstr(nodeRef->info.valueRef);
+            }
+
+            // Propigate over the type as that may have changed, like going from an int value to a
+            // bool value.
+
+            originalRef->type = nodeRef->type;
+        }
+    }
+
+    // Now at this point, if both the original and the shadow node are stems, we'll let the function
+    // InternalMergeTree take care of the children, (if any.)
+
+    // If the original has been cleared out, we can still just rely on InternalMergeTree to
+    // propigate over the new nodes.
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Called to fire any callbacks registered on the given node path.  If nothing is registered on the
+ *  given path, nothing happens.
+ */
+// -------------------------------------------------------------------------------------------------
+static void TriggerCallbacks
+(
+    le_pathIter_Ref_t pathRef  ///< [IN] The path to search for callback registrations.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Read the path out of the buffer.
+    char pathBuffer[CFG_MAX_PATH_SIZE] = { 0 };
+    if (le_pathIter_GetPath(pathRef, pathBuffer, sizeof(pathBuffer)) != LE_OK)
+    {
+        LE_ERROR("Callback path buffer overflow.");
+        return;
+    }
+
+    // Try to find a registration object for this path.  If one is found, flag it for calling once
+    // the merge is complete.
+    Registration_t* foundRegistrationPtr = le_hashmap_Get(HandlerRegistrationMap, pathBuffer);
+
+    if (foundRegistrationPtr != NULL)
+    {
+        foundRegistrationPtr->triggered = true;
+    }
+}
+
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Go through all of the registered event callbacks, and fire the call backs for each of the
+ *  registrations that has been makred as triggered.
+ *
+ *  Once this is done, the triggered flag is cleared for next time.
+ */
+// -------------------------------------------------------------------------------------------------
+static void FireTriggeredCallbacks
+(
+    void
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Go through the registration map.
+    le_hashmap_It_Ref_t handlerIterRef = le_hashmap_GetIterator(HandlerRegistrationMap);
+
+    while (le_hashmap_NextNode(handlerIterRef) == LE_OK)
+    {
+        // For each registration, check to see if it was triggered.
+        Registration_t* registrationPtr = (Registration_t*)le_hashmap_GetValue(handlerIterRef);
+
+        if (registrationPtr->triggered)
+        {
+            // This registration has been triggered, so call all of the handlers attached to it.
+            le_dls_Link_t* linkPtr = le_dls_Peek(&registrationPtr->handlerList);
+
+            while (linkPtr != NULL)
+            {
+                Handler_t* handlerObjectPtr = CONTAINER_OF(linkPtr, Handler_t, link);
+
+                handlerObjectPtr->handlerPtr(handlerObjectPtr->contextPtr);
+                linkPtr = le_dls_PeekNext(&registrationPtr->handlerList, linkPtr);
+            }
+
+            // Now that that's done, clear the triggered flag.
+            registrationPtr->triggered = false;
+        }
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check the given node to see if it was renamed.
+ *
+ *  @return True if the node was renamed within this transaction.  False if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool WasRenamed
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] Check this node to see if it was renamed in this transaction.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (IsModified(nodeRef) == false)
+    {
+        // The node wasn't even modified, so it can not have been renamed.
+        return false;
+    }
+
+    if (nodeRef->shadowRef == NULL)
+    {
+        // If the node doesn't have a shadow reference, then most likely this is a new node and not
+        // a rename of an existing one.
+        return false;
+    }
+
+    if (nodeRef->nameRef == NULL)
+    {
+        // The shadow node does not have a local copy of a name, so it can not have been renamed.
+        // It must have been modified for other reasons.
+        return false;
+    }
+
+    // Looks like the node has a new name.
+    return true;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check the original non-shadow node to see if it will need to be cleared during the merge.
+ *
+ *  @return True if the merge will clear out the original value.  False if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool OriginalToBeCleared
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The shadow node to check.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_cfg_nodeType_t nodeType = tdb_GetNodeType(nodeRef);
+
+    // If the nodeRef->type is LE_CFG_TYPE_EMPTY, tdb_GetNodeType will return node type of
+    // original node, which is incorrect. nodeType should be LE_CFG_TYPE_EMPTY.
+    if(nodeRef->type == LE_CFG_TYPE_EMPTY)
+    {
+      nodeType = LE_CFG_TYPE_EMPTY;
+    }
+
+    if (   (nodeType == LE_CFG_TYPE_EMPTY)
+        || (nodeType != tdb_GetNodeType(nodeRef->shadowRef)))
+    {
+        return true;
+    }
+
+    return false;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Append the name of a node onto the end of a path object.
+ */
+// -------------------------------------------------------------------------------------------------
+static void AppendNodeName
+(
+    le_pathIter_Ref_t pathRef,  ///< [IN] The path we're appending to.
+    tdb_NodeRef_t nodeRef       ///< [IN] The node we're appending.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
+
+    LE_ASSERT(tdb_GetNodeName(nodeRef, nodeName, sizeof(nodeName)) == LE_OK);
+    le_result_t result = le_pathIter_Append(pathRef, nodeName);
+
+    LE_WARN_IF(result != LE_OK,
+               "Could not append node '%s' onto the update callback tracking path.  "
+               "Reason: %d, '%s'.",
+               nodeName,
+               result,
+               LE_RESULT_TXT(result));
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Create a new config path for the tree name given.
+ *
+ *  @return A new config path, rooted on the given tree.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_pathIter_Ref_t CreateBasePath
+(
+    const char* treeNamePtr  ///< [IN] The tree name to use for the new path object.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char basePath[CFG_MAX_PATH_SIZE] = { 0 };
+
+    snprintf(basePath, sizeof(basePath), "%s:/", treeNamePtr);
+    return le_pathIter_CreateForUnix(basePath);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Generate a config path to the given node.
+ */
+// -------------------------------------------------------------------------------------------------
+static void GeneratePath
+(
+    le_pathIter_Ref_t pathRef,  ///< [IN] The path object we're updating.
+    tdb_NodeRef_t nodeRef       ///< [IN] The node we're creating a path for.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (nodeRef == NULL)
+    {
+        return;
+    }
+
+    GeneratePath(pathRef, nodeRef->parentRef);
+    AppendNodeName(pathRef, nodeRef);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Trigger callbacks for this node and all of it's children.
+ */
+// -------------------------------------------------------------------------------------------------
+static void FireAllChildren
+(
+    le_pathIter_Ref_t pathRef,  ///< [IN] Path to the parent of the current node.
+    tdb_NodeRef_t nodeRef       ///< [IN] Node and any children to merge.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Add this node to the path we're using to find registered callbacks.
+    AppendNodeName(pathRef, nodeRef);
+
+    // If the node is a stem then traverse it's children and try to trigger callbacks for them.  If
+    // there are no callbacks registered for those nodes, then nothing will happen.
+    if (nodeRef->type == LE_CFG_TYPE_STEM)
+    {
+        tdb_NodeRef_t childRef = tdb_GetFirstChildNode(nodeRef);
+
+        while (childRef != NULL)
+        {
+            FireAllChildren(pathRef, childRef);
+            childRef = tdb_GetNextSiblingNode(childRef);
+        }
+    }
+
+    // Like with the children, try to do the same for this node.  Then remove this node from the
+    // tracking path.
+    TriggerCallbacks(pathRef);
+    le_pathIter_Truncate(pathRef);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check a given shadow node and the original node it's shadowing.  If the original has children
+ *  that will be lost because of a merge, then we need to fire callbacks for those nodes that are
+ *  about to go away.
+ *
+ *  The algorithm employed by this function is as follows:
+ *
+ *      1. Check the original node for the given shadow node.  If it exists and is a stem node,
+ *         mark all of the children as deleted.  (This is done with the expectation that the
+ *         original tree does not have nodes with the deleted flag set.)
+ *
+ *      2. Go through the shadow collection, and any shadow children that have links to the original
+ *         nodes, clear the deleted flag.  These nodes are still considered "live."
+ *
+ *      3. Travers the original children one more time.  For any node that is still marked as
+ *         deleted we queue up an event handler.  As this node has been removed from the colection
+ *         and will be removed as part of the final merge.  The delete flag is also cleared at this
+ *         step to ensure that there are no external side effects.
+ */
+// -------------------------------------------------------------------------------------------------
+static void FireLostChildren
+(
+    le_pathIter_Ref_t pathRef,   ///< [IN] Path to the parent of the current node.
+    tdb_NodeRef_t shadowNodeRef  ///< [IN] Node and any children to merge.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Is the original a stem?  If no, then done.
+    tdb_NodeRef_t originalRef = shadowNodeRef->shadowRef;
+
+    if (originalRef->type != LE_CFG_TYPE_STEM)
+    {
+        return;
+    }
+
+    // Mark all originals deleted.
+    tdb_NodeRef_t originalChildRef = tdb_GetFirstChildNode(originalRef);
+
+    while (originalChildRef != NULL)
+    {
+        // Children in the original tree shouldn't currently be marked as deleted.
+        LE_ASSERT(IsDeleted(originalChildRef) == false);
+
+        SetDeletedFlag(originalChildRef);
+        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
+    }
+
+    // Follow through all of the shadow links and unmark deletions.
+    if (shadowNodeRef->type == LE_CFG_TYPE_STEM)
+    {
+        tdb_NodeRef_t shadowChildRef = tdb_GetFirstChildNode(shadowNodeRef);
+
+        while (shadowChildRef != NULL)
+        {
+            if (shadowChildRef->shadowRef != NULL)
+            {
+                ClearDeletedFlag(shadowChildRef->shadowRef);
+            }
+
+            shadowChildRef = tdb_GetNextSiblingNode(shadowChildRef);
+        }
+    }
+
+    // Fire on all original nodes still marked.  But also take care to clear the deleted flags here
+    // in order to leave everything as it was.
+    originalChildRef = tdb_GetFirstChildNode(originalRef);
+
+    while (originalChildRef != NULL)
+    {
+        if (IsDeleted(originalChildRef) == true)
+        {
+            FireAllChildren(pathRef, originalChildRef);
+            ClearDeletedFlag(originalChildRef);
+        }
+
+        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Recursive function to merge a collection of shadow nodes with the original tree.
+ *
+ *  @return True if the given node or any if it's children have been modified.  False if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool InternalMergeTree
+(
+    const char* treeNamePtr,    ///< [IN] The name of the tree we're merging.
+    le_pathIter_Ref_t pathRef,  ///< [IN] Path to the parent of hte current node.
+    tdb_NodeRef_t nodeRef,      ///< [IN] Node and any children to merge.
+    bool forceFire              ///< [IN] Should update handlers be fired for this node and all it's
+                                ///<      children, regardless of wether or not this node has been
+                                ///<      directly modified?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    bool isModified = IsModified(nodeRef);
+    bool renamed = WasRenamed(nodeRef);
+
+    // If this node was renamed, then all children also need to be triggered as well.
+    forceFire = renamed || forceFire;
+
+    // If this node has been renamed, marked as deleted or set empty, then all of the children need
+    // notifications fired on the original nodes.
+    if (   (renamed == true)
+        || (IsDeleted(nodeRef) == true)
+        || (OriginalToBeCleared(nodeRef) == true))
+    {
+        le_pathIter_Ref_t originalPathRef = CreateBasePath(treeNamePtr);
+
+        if (nodeRef->shadowRef != NULL)
+        {
+            GeneratePath(originalPathRef, nodeRef->shadowRef->parentRef);
+            FireAllChildren(originalPathRef, nodeRef->shadowRef);
+        }
+
+        le_pathIter_Delete(originalPathRef);
+    }
+    else if (   (isModified == true)
+             && (nodeRef->type == LE_CFG_TYPE_STEM))
+    {
+        le_pathIter_Ref_t originalPathRef = CreateBasePath(treeNamePtr);
+
+        GeneratePath(originalPathRef, nodeRef->shadowRef);
+        FireLostChildren(originalPathRef, nodeRef);
+
+        le_pathIter_Delete(originalPathRef);
+    }
+
+    AppendNodeName(pathRef, nodeRef);
+
+    // IF this node is modified, mearge it.  If this node is a stem, then merge it's children.  Keep
+    // track of whether any of those children have been modified as well.
+    if (isModified)
+    {
+        MergeNode(nodeRef);
+    }
+
+    if (   (nodeRef->type == LE_CFG_TYPE_STEM)
+        && (IsDeleted(nodeRef) == false))
+    {
+        nodeRef = tdb_GetFirstChildNode(nodeRef);
+
+        while (nodeRef != NULL)
+        {
+            tdb_NodeRef_t nextNodeRef = tdb_GetNextSiblingNode(nodeRef);
+
+            isModified = InternalMergeTree(treeNamePtr, pathRef, nodeRef, forceFire) || isModified;
+            nodeRef = nextNodeRef;
+        }
+    }
+
+    // If this node, or any of it's children have been modified.  Try to fire any callbacks that may
+    // be registered.
+    if (isModified || forceFire)
+    {
+        TriggerCallbacks(pathRef);
+    }
+
+    // Now remove this node from the tracking path and let our caller know if any modifications have
+    // happened at this level or lower.
+    if (le_pathIter_GoToEnd(pathRef) == LE_OK)
+    {
+        le_pathIter_Truncate(pathRef);
+    }
+
+    return isModified;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Create a new tree object and set it to default values.
+ *
+ *  @return A ref to the newly created tree object.
+ */
+// -------------------------------------------------------------------------------------------------
+tdb_TreeRef_t NewTree
+(
+    const char* treeNameRef,   ///< [IN] The name of the new tree.
+    tdb_NodeRef_t rootNodeRef  ///< [IN] The root node of this new tree.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_TreeRef_t treeRef = le_mem_ForceAlloc(TreePoolRef);
+
+    LE_ASSERT(le_utf8_Copy(treeRef->name, treeNameRef, MAX_TREE_NAME_BYTES, NULL) == LE_OK);
+
+    treeRef->isDeletePending = false;
+    treeRef->originalTreeRef = NULL;
+    treeRef->revisionId = 0;
+    treeRef->rootNodeRef = (rootNodeRef != NULL) ? rootNodeRef : NewNode();
+    treeRef->activeReadCount = 0;
+    treeRef->activeWriteIterRef = NULL;
+    treeRef->requestList = LE_SLS_LIST_INIT;
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+    treeRef->journalFd = -1;
+    treeRef->journalSize = 0;
+    treeRef->isTreeFileCrcKnown = false;
+    treeRef->compactTimerRef = NULL;
+#endif
+
+    return treeRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Destructor called when a tree object is to be freed from memory.
+ */
+// -------------------------------------------------------------------------------------------------
+static void TreeDestructor
+(
+    void* objectPtr  ///< The memory object to destruct.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_TreeRef_t treeRef = (tdb_TreeRef_t)objectPtr;
+
+    // Kill the root node.
+    le_mem_Release(treeRef->rootNodeRef);
+    treeRef->rootNodeRef = NULL;
+
+    // Sanity check, is the tree actually ready to clean up?
+    LE_ASSERT(treeRef->activeReadCount == 0);
+    LE_ASSERT(treeRef->activeWriteIterRef == NULL);
+    LE_ASSERT(le_sls_IsEmpty(&treeRef->requestList) == true);
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+    if (treeRef->compactTimerRef != NULL)
+    {
+        le_timer_Delete(treeRef->compactTimerRef);
+        treeRef->compactTimerRef = NULL;
+    }
+
+    if (treeRef->journalFd >= 0)
+    {
+        fd_Close(treeRef->journalFd);
+        treeRef->journalFd = -1;
+    }
+#endif
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Create a path to a tree file with the given revision id.
+ *
+ *  @return A stringBuffer backed string containing the full path to the tree file.
+ */
+// -------------------------------------------------------------------------------------------------
+static void GetTreePath
+(
+    const char* treeNameRef,  ///< [IN] The name of the tree we're generating a name for.
+    int revisionId,           ///< [IN] Generate a name based on the tree revision.
+    char* pathBuffer,         ///< [IN] Buffer to hold the new path.
+    size_t pathSize           ///< [IN] Size of the path buffer.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // paper    --> rock       1 -> 2
+    // rock     --> scissors   2 -> 3
+    // scissors --> paper      3 -> 1
+
+    static const char* revNames[] = { "paper", "rock", "scissors" };
+    int printSize;
+
+    LE_ASSERT((revisionId >= 1) && (revisionId <= 3));
+
+    printSize = snprintf(pathBuffer,
+                         pathSize,
+                         "%s/%s.%s",
+                         CFG_TREE_FILE_DIR,
+                         treeNameRef,
+                         revNames[revisionId - 1]);
+
+    if (printSize >= pathSize)
+    {
+       LE_ERROR("Unable to store config tree path in buffer");
+       pathBuffer[0] = '\0';
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check to see if a configTree file at the given revision already exists in the filesystem.
+ *
+ *  @note If the tree file exists, but is empty, then it is invalid and will be deleted.
+ *
+ *  @return True if the named file exists, false otherwise.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool TreeFileExists
+(
+    const char* treeNameRef,  ///< [IN] Name of the tree to check.
+    int revisionId            ///< [IN] The revision of the tree to check against.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char fullPath[LE_CFG_STR_LEN_BYTES] = "";
+    GetTreePath(treeNameRef, revisionId, fullPath, sizeof(fullPath));
+
+    // Make sure this part was successful.
+    if (fullPath[0] == '\0')
+    {
+        return false;
+    }
+
+    // stat() the file to see if it exists and get its size.
+    struct stat s;
+    if (stat(fullPath, &s) == -1)
+    {
+        LE_DEBUG("Can't stat file '%s' (%m).", fullPath);
+        return false;
+    }
+
+    // Make sure it's a regular file.
+    if (!S_ISREG(s.st_mode))
+    {
+        LE_FATAL("Object at '%s' is not a regular file.", fullPath);
+    }
+
+    // If it's zero size, delete it and report that it doesn't exist.
+    if (s.st_size == 0)
+    {
+        if (unlink(fullPath) == -1)
+        {
+            LE_FATAL("Failed to unlink empty file '%s' (%m).", fullPath);
+        }
+
+        return false;
+    }
+
+    // NOTE: The Config Tree generally runs as root, so permissions should be irrelevant.
+
+    return true;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Check the filesystem and get the current "valid" version of the file and update the tree object
+ * with that version number.
+ *
+ * If there are two files for a given tree, we use the older one.  The idea being, if there are
+ * two versions of the same file in the filesystem then there was a system failure during a save
+ * operation.  So we abandon the newer (probably incomplete) file and go with the older file;
+ * unless the size of the older file is zero, which can happen if deletion of that file is
+ * interrupted.
+ */
+// -------------------------------------------------------------------------------------------------
+static void UpdateRevision
+(
+    tdb_TreeRef_t treeRef  ///< [IN] Update the revision for this tree object.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    int newRevision = 0;
+
+    if (TreeFileExists(treeRef->name, 1))
+    {
+        if (TreeFileExists(treeRef->name, 3))
+        {
+            newRevision = 3;
+        }
+        else
+        {
+            newRevision = 1;
+        }
+    }
+    else if (TreeFileExists(treeRef->name, 3))
+    {
+        if (TreeFileExists(treeRef->name, 2))
+        {
+            newRevision = 2;
+        }
+        else
+        {
+            newRevision = 3;
+        }
+    }
+    else if (TreeFileExists(treeRef->name, 2))
+    {
+        newRevision = 2;
+    }
+
+    treeRef->revisionId = newRevision;
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+    treeRef->isTreeFileCrcKnown = false;
+#endif
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Peek into the input stream one character ahead.
+ */
+// -------------------------------------------------------------------------------------------------
+static signed char PeekChar
+(
+    FILE* filePtr  ///< [IN] The file stream to peek into.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    int next = fgetc(filePtr);
+    ungetc(next, filePtr);
+
+    return next;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Skip any whitespace encountered in the input stream.  Stop skipping once we hit a valid token.
+ *
+ *  @return LE_OK if the whitespace is skiped and there is still more file to read.
+ *          LE_OUT_OF_RANGE if the end of the file is hit.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t SkipWhiteSpace
+(
+    FILE* filePtr  ///< [IN] The file stream to seek through.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    bool done = false;
+    bool isEof = false;
+
+    while (done == false)
+    {
+        switch (PeekChar(filePtr))
+        {
+            case '\n':
+            case '\r':
+            case '\t':
+            case ' ':
+                // Eat the character.
+                fgetc(filePtr);
+                break;
+
+            case EOF:
+                done = true;
+                isEof = true;
+                break;
+
+            default:
+                done = true;
+                break;
+        }
+    }
+
+    return isEof == true ? LE_OUT_OF_RANGE : LE_OK;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Skip to the next occurence of the given character.
+ *
+ *  @return LE_OK if the character is found.
+ *          LE_OUT_OF_RANGE if the end of the file is hit.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t SkipToNextChar
+(
+    FILE* filePtr,          ///< [IN] The file stream to seek through.
+    signed char nextChar    ///< [IN]  The character we're searching for.
+)
+{
+    int next;
+
+    while ((next = fgetc(filePtr)) != nextChar)
+    {
+        if (next == EOF)
+        {
+            return LE_OUT_OF_RANGE;
+        }
+    }
+
+    return LE_OK;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a boolean literal from the input file.
+ *
+ *  @return LE_OK if the literal could be read.
+ *          LE_FORMAT_ERROR if the literal could not be read.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool ReadBoolToken
+(
+    FILE* filePtr,     ///< [IN]  The file we're reading from.
+    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    int next = fgetc(filePtr);
+
+    if (   (next == 't')
+        || (next == 'f'))
+    {
+        stringPtr[0] = next;
+        stringPtr[1] = 0;
+
+        return LE_OK;
+    }
+
+    return LE_FORMAT_ERROR;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a textual literal from the input file, the read is terminated successfuly if the terminal
+ *  character is found.
+ *
+ *  @return LE_OK if the string is read from the file.
+ *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ *          LE_OVERFLOW if the text doesn't fit in provided buffer (truncated).
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadTextLiteral
+(
+    FILE* filePtr,        ///< [IN]  The file we're reading from.
+    char* stringPtr,      ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize,    ///< [IN]  How big is the supplied string buffer?
+    signed char terminal  ///< [IN]  The terminal character we're searching for.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    int next;
+    size_t count = 0;
+
+    char* oldPtr = stringPtr;
+
+    while ((next = fgetc(filePtr)) != terminal)
+    {
+        if (next == EOF)
+        {
+            LE_ERROR("Missing end specifier, ']' in int value.");
+            return LE_FORMAT_ERROR;
+        }
+
+        if (next == '\\')
+        {
+            next = fgetc(filePtr);
+
+            if (next == EOF)
+            {
+                LE_ERROR("Unexpected EOF after finding \\ character.");
+                return LE_FORMAT_ERROR;
+            }
+        }
+
+        if (count >= (stringSize - 1))
+        {
+            // truncate the string to the buffer size
+            *stringPtr = 0;
+
+            LE_ERROR("String literal is too large.  (%" PRIdS "/%" PRIdS ")",
+                     strlen(oldPtr),
+                     stringSize);
+            // move the file pointer to the terminal character (e.g. closing quote)
+            if (LE_OK == SkipToNextChar(filePtr, terminal))
+            {
+                return LE_OVERFLOW;
+            }
+            else
+            {
+                return LE_FORMAT_ERROR;
+            }
+        }
+
+        *stringPtr = next;
+
+        ++stringPtr;
+        ++count;
+    }
+
+    *stringPtr = 0;
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read an integer token string from the file.
+ *
+ *  @return LE_OK if the string is read from the file.
+ *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ *          LE_OVERFLOW if the text doesn't fit in provided buffer (truncated).
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadIntToken
+(
+    FILE* filePtr,     ///< [IN]  The file we're reading from.
+    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, ']');
+
+    // TODO: Validate the int string.
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a floating point token string from the file.
+ *
+ *  @return LE_OK if the string is read from the file.
+ *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ *          LE_OVERFLOW if the text doesn't fit in provided buffer (truncated).
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadFloatToken
+(
+    FILE* filePtr,     ///< [IN]  The file we're reading from.
+    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, ')');
+
+    // TODO: Validate the float string.
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a string from the config tree file.
+ *
+ *  @return LE_OK if the string is read from the file.
+ *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ *          LE_OVERFLOW if the text doesn't fit in provided buffer (truncated).
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadStringToken
+(
+    FILE* filePtr,     ///< [IN]  The file we're reading from.
+    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, '"');
+
+    // TODO: Validate the literal string.
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a token from the input stream.
+ *
+ *  @return LE_OK if a token could be read.  LE_OUT_OF_RANGE if the end of the stream is reached
+ *          before a token could be finished.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadToken
+(
+    FILE* filePtr,         ///< [IN]  The file we're reading from.
+    char* stringPtr,       ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize,     ///< [IN]  How big is the supplied string buffer?
+    TokenType_t* typePtr   ///< [OUT] The type of token read from the file.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    *stringPtr = 0;
+
+    if (SkipWhiteSpace(filePtr) != LE_OK)
+    {
+        return LE_OUT_OF_RANGE;
+    }
+
+    int next;
+
+    while ((next = fgetc(filePtr)) != EOF)
+    {
+        switch (next)
+        {
+            case '~':
+                *typePtr = TT_EMPTY_VALUE;
+                return LE_OK;
+
+            case '!':
+                *typePtr = TT_BOOL_VALUE;
+                return ReadBoolToken(filePtr, stringPtr, stringSize);
+
+            case '[':
+                *typePtr = TT_INT_VALUE;
+                return ReadIntToken(filePtr, stringPtr, stringSize);
+
+            case '(':
+                *typePtr = TT_FLOAT_VALUE;
+                return ReadFloatToken(filePtr, stringPtr, stringSize);
+
+            case '\"':
+                *typePtr = TT_STRING_VALUE;
+                return ReadStringToken(filePtr, stringPtr, stringSize);
+
+            case '{':
+                *typePtr = TT_OPEN_GROUP;
+                return LE_OK;
+
+            case '}':
+                *typePtr = TT_CLOSE_GROUP;
+                return LE_OK;
+
+            default:
+                LE_ERROR("Unexpected character in input stream.");
+                return LE_FORMAT_ERROR;
+        }
+    }
+
+    return LE_OUT_OF_RANGE;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write data to the output stream.  This function will record any faults to the system log.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t WriteFile
+(
+    FILE* filePtr,        ///< [IN] The file being written to.
+    const void* dataPtr,  ///< [IN] The data being written to the file.
+    size_t dataSize       ///< [IN] The amount of data being written.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    ssize_t written = fwrite(dataPtr, 1, dataSize, filePtr);
+
+    if (ferror(filePtr) != 0)
+    {
+        LE_EMERG("Failed to write to config tree file.");
+        return LE_IO_ERROR;
+    }
+
+    if (written < dataSize)
+    {
+        LE_EMERG("Data truncated while writing to configuration file.");
+        return LE_IO_ERROR;
+    }
+
+    return LE_OK;
+}
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a string token to the output stream.  This function will write the string and escape all
+ *  control characters as it does so.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t WriteStringValue
+(
+    FILE* filePtr,         ///< [IN] The file to write to.
+    char startChar,        ///< [IN] The delimiter to use.
+    char endChar,          ///< [IN] The closing delimiter to use.
+    const char* stringPtr  ///< [IN] The actual string to write.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_result_t result = LE_OK;
+
+    result = WriteFile(filePtr, &startChar, 1);
+
+    while (   (*stringPtr != 0)
+           && (result == LE_OK))
+    {
+        if (   (*stringPtr == '\"')
+            || (*stringPtr == '\\'))
+        {
+            result = WriteFile(filePtr, "\\", 1);
+        }
+
+        if (result == LE_OK)
+        {
+            result = WriteFile(filePtr, stringPtr, 1);
+        }
+
+        stringPtr++;
+    }
+
+    if (result == LE_OK)
+    {
+        char strBuffer[2] = { endChar, ' ' };
+        result = WriteFile(filePtr, strBuffer, sizeof(strBuffer));
+    }
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a node value from the given file.  If the value is a collection, then read in those nodes
+ *  too.
+ *
+ *  @return LE_OK if the read is successful.
+ *          LE_FORMAT_ERROR if parse errors are encountered.
+ *          LE_NOT_FOUND if the end of file is reached.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t InternalReadNode
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node we're reading a value for.
+    FILE* filePtr,          ///< [IN] The file we're reading the value from.
+    size_t pathLen          ///< [IN] The length of the path including nodeRef.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char* stringBuffer = le_mem_ForceAlloc(EncodedStringPool);
+    size_t stringBufferSize = TDB_MAX_ENCODED_SIZE;
+    le_result_t result = LE_OK;
+
+    TokenType_t tokenType;
+
+    // Try to read this node's value.
+    result = ReadToken(filePtr, stringBuffer, stringBufferSize, &tokenType);
+    if ((result != LE_OK) && (result != LE_OVERFLOW))
+    {
+        LE_ERROR("Unexpected EOF or bad token in file.");
+        result = LE_FORMAT_ERROR;
+        goto cleanup;
+    }
+    // if result is OVERFLOW (i.e. string is truncated), we still should be able
+    // to proceed with parsing the rest of the file.
+    result = LE_OK;
+
+    tdb_SetEmpty(nodeRef);
+
+    switch (tokenType)
+    {
+        case TT_BOOL_VALUE:
+            tdb_SetValueAsString(nodeRef, stringBuffer);
+            nodeRef->type = LE_CFG_TYPE_BOOL;
+            break;
+
+        case TT_INT_VALUE:
+            tdb_SetValueAsString(nodeRef, stringBuffer);
+            nodeRef->type = LE_CFG_TYPE_INT;
+            break;
+
+        case TT_FLOAT_VALUE:
+            tdb_SetValueAsString(nodeRef, stringBuffer);
+            nodeRef->type = LE_CFG_TYPE_FLOAT;
+            break;
+
+        case TT_STRING_VALUE:
+            tdb_SetValueAsString(nodeRef, stringBuffer);
+            break;
+
+        case TT_EMPTY_VALUE:
+            // The node has already been cleared, so there's nothing left to do but make sure that
+            // the node exists.
+            ClearDeletedFlag(nodeRef);
+            break;
+
+        case TT_OPEN_GROUP:
+            while (tokenType != TT_CLOSE_GROUP)
+            {
+                if (ReadToken(filePtr, stringBuffer, stringBufferSize, &tokenType) != LE_OK)
+                {
+                    LE_ERROR("Unexpected EOF or bad token in file while looking for '}'.");
+                    result = LE_FORMAT_ERROR;
+                    goto cleanup;
+                }
+
+                if (tokenType == TT_STRING_VALUE)
+                {
+                    size_t strLen = le_utf8_NumBytes(stringBuffer);
+                    size_t newPathLen = pathLen + 1 + strLen;
+
+                    if (newPathLen > LE_CFG_STR_LEN)
+                    {
+                        LE_ERROR("New path length for node '%s' is too long.  %" PRIuS
+                                 " of %" PRIuS " bytes.",
+                                 stringBuffer,
+                                 strLen,
+                                 (size_t)LE_CFG_STR_LEN);
+
+                        result = LE_FORMAT_ERROR;
+                        goto cleanup;
+                    }
+
+                    tdb_NodeRef_t childRef = GetNamedChild(nodeRef, stringBuffer);
+
+                    if (childRef == NULL)
+                    {
+                        childRef = NewChildNode(nodeRef);
+                        if (tdb_SetNodeName(childRef, stringBuffer) != LE_OK)
+                        {
+                            LE_ERROR("Bad node name, '%s'.", stringBuffer);
+                            result = LE_FORMAT_ERROR;
+                            goto cleanup;
+                        }
+
+                        LE_DEBUG("New node, %s", stringBuffer);
+                    }
+
+                    tdb_EnsureExists(childRef);
+
+                    result = InternalReadNode(childRef, filePtr, newPathLen);
+
+                    if (result != LE_OK)
+                    {
+                        goto cleanup;
+                    }
+                }
+                else if (tokenType == TT_CLOSE_GROUP)
+                {
+                    break;
+                }
+                else
+                {
+                    LE_ERROR("Unexpected token in found while looking for '}'.");
+                    result = LE_FORMAT_ERROR;
+                    goto cleanup;
+                }
+            }
+            break;
+
+        case TT_CLOSE_GROUP:
+        default:
+            LE_ERROR("Unexpected token found.");
+            result = LE_FORMAT_ERROR;
+            goto cleanup;
+    }
+
+    if (IsShadow(nodeRef) == false)
+    {
+        ClearModifiedFlag(nodeRef);
+    }
+    else
+    {
+        SetModifiedFlag(nodeRef);
+    }
+
+    tdb_EnsureExists(nodeRef);
+
+cleanup:
+    le_mem_Release(stringBuffer);
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Serialize a tree node and it's children to a file in the filesystem.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t InternalWriteNode
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node being written.
+    FILE* filePtr           ///< [IN] The file being written to.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // If there is no node to write, or if the node is marked as having been deleted...  Then write
+    // a blank node.
+    if (   (nodeRef == NULL)
+        || (IsDeleted(nodeRef) == true))
+    {
+        return WriteFile(filePtr, "~ ", 2);
+    }
+
+    // Get the node's value as a string.
+    char* stringBuffer = le_mem_ForceAlloc(EncodedStringPool);
+    size_t stringBufferSize = TDB_MAX_ENCODED_SIZE;
+    le_result_t result = LE_OK;
+
+    tdb_GetValueAsString(nodeRef, stringBuffer, stringBufferSize, "");
+
+    // Now, depending on the type of node, write out any required format information.
+    switch (nodeRef->type)
+    {
+        case LE_CFG_TYPE_EMPTY:
+        case LE_CFG_TYPE_DOESNT_EXIST:
+            result = WriteFile(filePtr, "~ ", 2);
+            break;
+
+        case LE_CFG_TYPE_BOOL:
+            {
+                const char boolBuffer[3] = { '!', stringBuffer[0], ' ' };
+                result = WriteFile(filePtr, boolBuffer, sizeof(boolBuffer));
+            }
+            break;
+
+        case LE_CFG_TYPE_STRING:
+            result = WriteStringValue(filePtr, '\"', '\"', stringBuffer);
+            break;
+
+        case LE_CFG_TYPE_INT:
+            result = WriteStringValue(filePtr, '[', ']', stringBuffer);
+            break;
+
+        case LE_CFG_TYPE_FLOAT:
+            result = WriteStringValue(filePtr, '(', ')', stringBuffer);
+            break;
+
+        // Looks like this node is a collection, so write out it's child nodes now.
+        case LE_CFG_TYPE_STEM:
+            if ((result = WriteFile(filePtr, "{ ", 2)) == LE_OK)
+            {
+                tdb_NodeRef_t childRef = tdb_GetFirstActiveChildNode(nodeRef);
+
+                while (   (childRef != NULL)
+                       && (result == LE_OK))
+                {
+                    tdb_GetNodeName(childRef, stringBuffer, stringBufferSize);
+                    result = WriteStringValue(filePtr, '\"', '\"', stringBuffer);
+
+                    if (result == LE_OK)
+                    {
+                        result = InternalWriteNode(childRef, filePtr);
+                    }
+
+                    childRef = tdb_GetNextActiveSiblingNode(childRef);
+                }
+
+                if (result == LE_OK)
+                {
+                    result = WriteFile(filePtr, "} ", 2);
+                }
+            }
+            break;
+    }
+
+    le_mem_Release(stringBuffer);
+    return result;
+}
+
+
+
+
+#if LE_CONFIG_CFGTREE_BINARY
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Add a string to a string table being built for a binary tree file, unless it's already there.
+ *
+ *  @return LE_OK if the string was added, LE_OVERFLOW if the table has grown too large.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t AddSnapshotString
+(
+    SnapshotStrings_t* tablePtr,  ///< [IN] The string table.
+    const char* valuePtr,         ///< [IN] The string to add.
+    uint32_t* offsetPtr           ///< [OUT] Offset of the string in the table.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    size_t i;
+
+    // Keep the hash table at most half full.
+    if (tablePtr->stringCount * 2 >= tablePtr->slotCount)
+    {
+        size_t slotCount = (tablePtr->slotCount == 0) ? 256 : tablePtr->slotCount * 2;
+        uint32_t* slotsPtr = calloc(slotCount, sizeof(*slotsPtr));
+
+        if (slotsPtr == NULL)
+        {
+            return LE_OVERFLOW;
+        }
+
+        for (i = 0; i < tablePtr->slotCount; i++)
+        {
+            if (tablePtr->slotsPtr[i] != 0)
+            {
+                const char* stringPtr = tablePtr->bufferPtr + tablePtr->slotsPtr[i] - 1;
+                size_t slot = le_hashmap_HashString(stringPtr);
+
+                while (slotsPtr[slot & (slotCount - 1)] != 0)
+                {
+                    slot++;
+                }
+                slotsPtr[slot & (slotCount - 1)] = tablePtr->slotsPtr[i];
+            }
+        }
+
+        free(tablePtr->slotsPtr);
+        tablePtr->slotsPtr = slotsPtr;
+        tablePtr->slotCount = slotCount;
+    }
+
+    for (i = le_hashmap_HashString(valuePtr) & (tablePtr->slotCount - 1);
+         tablePtr->slotsPtr[i] != 0;
+         i = (i + 1) & (tablePtr->slotCount - 1))
+    {
+        if (strcmp(tablePtr->bufferPtr + tablePtr->slotsPtr[i] - 1, valuePtr) == 0)
+        {
+            *offsetPtr = tablePtr->slotsPtr[i] - 1;
+            return LE_OK;
+        }
+    }
+
+    size_t length = strlen(valuePtr) + 1;
+
+    if (tablePtr->size + length >= UINT32_MAX)
+    {
+        return LE_OVERFLOW;
+    }
+
+    if (tablePtr->size + length > tablePtr->capacity)
+    {
+        size_t capacity = (tablePtr->capacity == 0) ? 4096 : tablePtr->capacity * 2;
+
+        while (tablePtr->size + length > capacity)
         {
-            // This registration has been triggered, so call all of the handlers attached to it.
-            le_dls_Link_t* linkPtr = le_dls_Peek(&registrationPtr->handlerList);
-
-            while (linkPtr != NULL)
-            {
-                Handler_t* handlerObjectPtr = CONTAINER_OF(linkPtr, Handler_t, link);
+            capacity *= 2;
+        }
 
-                handlerObjectPtr->handlerPtr(handlerObjectPtr->contextPtr);
-                linkPtr = le_dls_PeekNext(&registrationPtr->handlerList, linkPtr);
-            }
+        char* bufferPtr = realloc(tablePtr->bufferPtr, capacity);
 
-            // Now that that's done, clear the triggered flag.
-            registrationPtr->triggered = false;
+        if (bufferPtr == NULL)
+        {
+            return LE_OVERFLOW;
         }
+
+        tablePtr->bufferPtr = bufferPtr;
+        tablePtr->capacity = capacity;
     }
+
+    memcpy(tablePtr->bufferPtr + tablePtr->size, valuePtr, length);
+    *offsetPtr = tablePtr->size;
+
+    tablePtr->slotsPtr[i] = tablePtr->size + 1;
+    tablePtr->size += length;
+    tablePtr->stringCount++;
+
+    return LE_OK;
 }
 
 
@@ -1227,38 +3251,39 @@ static void FireTriggeredCallbacks
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check the given node to see if it was renamed.
+ *  Check if an integer value can be stored in a binary tree file without going through the string
+ *  table.  That's the case if it reads back exactly as it was written.
  *
- *  @return True if the node was renamed within this transaction.  False if not.
+ *  @return true if the value can be stored inline.
  */
 // -------------------------------------------------------------------------------------------------
-static bool WasRenamed
+static bool GetInlineInt
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] Check this node to see if it was renamed in this transaction.
+    const char* valuePtr,  ///< [IN] The value, as returned by tdb_GetValueAsString().
+    uint32_t* dataPtr      ///< [OUT] The value to store.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    if (IsModified(nodeRef) == false)
-    {
-        // The node wasn't even modified, so it can not have been renamed.
-        return false;
-    }
+    char* endPtr = NULL;
+    char buffer[SMALL_STR];
 
-    if (nodeRef->shadowRef == NULL)
+    errno = 0;
+    long long value = strtoll(valuePtr, &endPtr, 10);
+
+    if (   (errno != 0)
+        || (value < INT32_MIN)
+        || (value > INT32_MAX))
     {
-        // If the node doesn't have a shadow reference, then most likely this is a new node and not
-        // a rename of an existing one.
         return false;
     }
 
-    if (nodeRef->nameRef == NULL)
+    snprintf(buffer, sizeof(buffer), "%d", (int32_t)value);
+    if (strcmp(buffer, valuePtr) != 0)
     {
-        // The shadow node does not have a local copy of a name, so it can not have been renamed.
-        // It must have been modified for other reasons.
         return false;
     }
 
-    // Looks like the node has a new name.
+    *dataPtr = (uint32_t)(int32_t)value;
     return true;
 }
 
@@ -1267,144 +3292,166 @@ static bool WasRenamed
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check the original non-shadow node to see if it will need to be cleared during the merge.
+ *  Serialize a whole tree to a file in the binary tree file format.  The nodes are laid out breadth
+ *  first, so that the children of each node end up next to each other.
  *
- *  @return True if the merge will clear out the original value.  False if not.
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
  */
 // -------------------------------------------------------------------------------------------------
-static bool OriginalToBeCleared
+static le_result_t WriteTreeSnapshot
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The shadow node to check.
+    tdb_NodeRef_t rootRef,  ///< [IN] The root node of the tree.
+    FILE* filePtr           ///< [IN] The file being written to.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_cfg_nodeType_t nodeType = tdb_GetNodeType(nodeRef);
+    le_result_t result = LE_IO_ERROR;
+    size_t capacity = 64;
+    uint32_t nodeCount = 1;
+    tdb_NodeRef_t* orderPtr = malloc(capacity * sizeof(*orderPtr));
+    SnapshotNode_t* nodesPtr = malloc(capacity * sizeof(*nodesPtr));
+    char* stringBuffer = le_mem_ForceAlloc(EncodedStringPool);
+    SnapshotStrings_t strings = { 0 };
+    uint32_t rootName;
+    uint32_t i;
 
-    // If the nodeRef->type is LE_CFG_TYPE_EMPTY, tdb_GetNodeType will return node type of
-    // original node, which is incorrect. nodeType should be LE_CFG_TYPE_EMPTY.
-    if(nodeRef->type == LE_CFG_TYPE_EMPTY)
+    // Offset 0 is the empty string, which is the root node's name.
+    if (   (orderPtr == NULL)
+        || (nodesPtr == NULL)
+        || (AddSnapshotString(&strings, "", &rootName) != LE_OK))
     {
-      nodeType = LE_CFG_TYPE_EMPTY;
+        LE_EMERG("Out of memory while writing binary tree file.");
+        goto cleanup;
     }
 
-    if (   (nodeType == LE_CFG_TYPE_EMPTY)
-        || (nodeType != tdb_GetNodeType(nodeRef->shadowRef)))
-    {
-        return true;
-    }
+    orderPtr[0] = rootRef;
 
-    return false;
-}
+    for (i = 0; i < nodeCount; i++)
+    {
+        tdb_NodeRef_t nodeRef = orderPtr[i];
+        le_cfg_nodeType_t type = tdb_GetNodeType(nodeRef);
+        uint32_t nameOffset = 0;
+        uint32_t data = 0;
+        uint32_t info = 0;
 
+        if (i > 0)
+        {
+            tdb_GetNodeName(nodeRef, stringBuffer, TDB_MAX_ENCODED_SIZE);
+            if (AddSnapshotString(&strings, stringBuffer, &nameOffset) != LE_OK)
+            {
+                LE_EMERG("Config tree too large for a binary tree file.");
+                goto cleanup;
+            }
+        }
 
+        switch (type)
+        {
+            case LE_CFG_TYPE_STEM:
+            {
+                tdb_NodeRef_t childRef = tdb_GetFirstActiveChildNode(nodeRef);
+                uint32_t childCount = 0;
 
+                data = nodeCount;
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Append the name of a node onto the end of a path object.
- */
-// -------------------------------------------------------------------------------------------------
-static void AppendNodeName
-(
-    le_pathIter_Ref_t pathRef,  ///< [IN] The path we're appending to.
-    tdb_NodeRef_t nodeRef       ///< [IN] The node we're appending.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
+                while (childRef != NULL)
+                {
+                    if (childCount == SNAPSHOT_MAX_CHILDREN)
+                    {
+                        LE_EMERG("Config tree node has too many children for a binary tree file.");
+                        goto cleanup;
+                    }
 
-    LE_ASSERT(tdb_GetNodeName(nodeRef, nodeName, sizeof(nodeName)) == LE_OK);
-    le_result_t result = le_pathIter_Append(pathRef, nodeName);
+                    if (nodeCount == capacity)
+                    {
+                        capacity *= 2;
 
-    LE_WARN_IF(result != LE_OK,
-               "Could not append node '%s' onto the update callback tracking path.  "
-               "Reason: %d, '%s'.",
-               nodeName,
-               result,
-               LE_RESULT_TXT(result));
-}
+                        tdb_NodeRef_t* newOrderPtr = realloc(orderPtr,
+                                                             capacity * sizeof(*orderPtr));
+                        if (newOrderPtr != NULL)
+                        {
+                            orderPtr = newOrderPtr;
+                        }
 
+                        SnapshotNode_t* newNodesPtr = realloc(nodesPtr,
+                                                              capacity * sizeof(*nodesPtr));
+                        if (newNodesPtr != NULL)
+                        {
+                            nodesPtr = newNodesPtr;
+                        }
 
+                        if (   (newOrderPtr == NULL)
+                            || (newNodesPtr == NULL))
+                        {
+                            LE_EMERG("Out of memory while writing binary tree file.");
+                            goto cleanup;
+                        }
+                    }
 
+                    orderPtr[nodeCount++] = childRef;
+                    childCount++;
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Create a new config path for the tree name given.
- *
- *  @return A new config path, rooted on the given tree.
- */
-// -------------------------------------------------------------------------------------------------
-static le_pathIter_Ref_t CreateBasePath
-(
-    const char* treeNamePtr  ///< [IN] The tree name to use for the new path object.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    char basePath[CFG_MAX_PATH_SIZE] = { 0 };
+                    childRef = tdb_GetNextActiveSiblingNode(childRef);
+                }
 
-    snprintf(basePath, sizeof(basePath), "%s:/", treeNamePtr);
-    return le_pathIter_CreateForUnix(basePath);
-}
+                info = childCount << SNAPSHOT_CHILD_SHIFT;
+            }
+            break;
 
+            case LE_CFG_TYPE_BOOL:
+            case LE_CFG_TYPE_INT:
+            case LE_CFG_TYPE_FLOAT:
+            case LE_CFG_TYPE_STRING:
+                tdb_GetValueAsString(nodeRef, stringBuffer, TDB_MAX_ENCODED_SIZE, "");
 
+                if (   (type == LE_CFG_TYPE_INT)
+                    && (GetInlineInt(stringBuffer, &data)))
+                {
+                    info = SNAPSHOT_INLINE;
+                }
+                else if (AddSnapshotString(&strings, stringBuffer, &data) != LE_OK)
+                {
+                    LE_EMERG("Config tree too large for a binary tree file.");
+                    goto cleanup;
+                }
+                break;
 
+            default:
+                type = LE_CFG_TYPE_EMPTY;
+                break;
+        }
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Generate a config path to the given node.
- */
-// -------------------------------------------------------------------------------------------------
-static void GeneratePath
-(
-    le_pathIter_Ref_t pathRef,  ///< [IN] The path object we're updating.
-    tdb_NodeRef_t nodeRef       ///< [IN] The node we're creating a path for.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    if (nodeRef == NULL)
-    {
-        return;
+        nodesPtr[i].nameOffset = nameOffset;
+        nodesPtr[i].data = data;
+        nodesPtr[i].info = info | type;
     }
 
-    GeneratePath(pathRef, nodeRef->parentRef);
-    AppendNodeName(pathRef, nodeRef);
-}
-
-
-
-
-// -------------------------------------------------------------------------------------------------
-/**
- *  Trigger callbacks for this node and all of it's children.
- */
-// -------------------------------------------------------------------------------------------------
-static void FireAllChildren
-(
-    le_pathIter_Ref_t pathRef,  ///< [IN] Path to the parent of the current node.
-    tdb_NodeRef_t nodeRef       ///< [IN] Node and any children to merge.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    // Add this node to the path we're using to find registered callbacks.
-    AppendNodeName(pathRef, nodeRef);
+    SnapshotHeader_t header =
+        {
+            .magic = SNAPSHOT_MAGIC,
+            .version = SNAPSHOT_VERSION,
+            .nodeCount = nodeCount,
+            .stringsSize = strings.size,
+            .crc = le_crc_Crc32((uint8_t*)strings.bufferPtr,
+                                strings.size,
+                                le_crc_Crc32((uint8_t*)nodesPtr,
+                                             nodeCount * sizeof(*nodesPtr),
+                                             LE_CRC_START_CRC32))
+        };
 
-    // If the node is a stem then traverse it's children and try to trigger callbacks for them.  If
-    // there are no callbacks registered for those nodes, then nothing will happen.
-    if (nodeRef->type == LE_CFG_TYPE_STEM)
+    if (   ((result = WriteFile(filePtr, &header, sizeof(header))) == LE_OK)
+        && ((result = WriteFile(filePtr, nodesPtr, nodeCount * sizeof(*nodesPtr))) == LE_OK))
     {
-        tdb_NodeRef_t childRef = tdb_GetFirstChildNode(nodeRef);
-
-        while (childRef != NULL)
-        {
-            FireAllChildren(pathRef, childRef);
-            childRef = tdb_GetNextSiblingNode(childRef);
-        }
+        result = WriteFile(filePtr, strings.bufferPtr, strings.size);
     }
 
-    // Like with the children, try to do the same for this node.  Then remove this node from the
-    // tracking path.
-    TriggerCallbacks(pathRef);
-    le_pathIter_Truncate(pathRef);
+cleanup:
+    free(strings.bufferPtr);
+    free(strings.slotsPtr);
+    free(nodesPtr);
+    free(orderPtr);
+    le_mem_Release(stringBuffer);
+
+    return result;
 }
 
 
@@ -1412,82 +3459,98 @@ static void FireAllChildren
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check a given shadow node and the original node it's shadowing.  If the original has children
- *  that will be lost because of a merge, then we need to fire callbacks for those nodes that are
- *  about to go away.
- *
- *  The algorithm employed by this function is as follows:
- *
- *      1. Check the original node for the given shadow node.  If it exists and is a stem node,
- *         mark all of the children as deleted.  (This is done with the expectation that the
- *         original tree does not have nodes with the deleted flag set.)
- *
- *      2. Go through the shadow collection, and any shadow children that have links to the original
- *         nodes, clear the deleted flag.  These nodes are still considered "live."
+ *  Check that the node array of a binary tree file describes a valid tree, so that nodes can be
+ *  loaded from it later without any further checks.
  *
- *      3. Travers the original children one more time.  For any node that is still marked as
- *         deleted we queue up an event handler.  As this node has been removed from the colection
- *         and will be removed as part of the final merge.  The delete flag is also cleared at this
- *         step to ensure that there are no external side effects.
+ *  @return true if the nodes are valid, false if not.
  */
 // -------------------------------------------------------------------------------------------------
-static void FireLostChildren
+static bool CheckSnapshotNodes
 (
-    le_pathIter_Ref_t pathRef,   ///< [IN] Path to the parent of the current node.
-    tdb_NodeRef_t shadowNodeRef  ///< [IN] Node and any children to merge.
+    const Snapshot_t* snapshotPtr  ///< [IN] The mapped file.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Is the original a stem?  If no, then done.
-    tdb_NodeRef_t originalRef = shadowNodeRef->shadowRef;
-
-    if (originalRef->type != LE_CFG_TYPE_STEM)
-    {
-        return;
-    }
-
-    // Mark all originals deleted.
-    tdb_NodeRef_t originalChildRef = tdb_GetFirstChildNode(originalRef);
+    // Each node's children must be the next ones in the array not already claimed by an earlier
+    // node.  That way every node but the root has exactly one parent, which comes before it.
+    uint32_t nextChild = 1;
+    uint32_t i;
 
-    while (originalChildRef != NULL)
+    for (i = 0; i < snapshotPtr->nodeCount; i++)
     {
-        // Children in the original tree shouldn't currently be marked as deleted.
-        LE_ASSERT(IsDeleted(originalChildRef) == false);
-
-        SetDeletedFlag(originalChildRef);
-        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
-    }
+        const SnapshotNode_t* entryPtr = &snapshotPtr->nodesPtr[i];
+        uint32_t childCount = SNAPSHOT_CHILD_COUNT(entryPtr);
+        uint32_t flags = entryPtr->info & ((1 << SNAPSHOT_CHILD_SHIFT) - 1) & ~0xff;
 
-    // Follow through all of the shadow links and unmark deletions.
-    if (shadowNodeRef->type == LE_CFG_TYPE_STEM)
-    {
-        tdb_NodeRef_t shadowChildRef = tdb_GetFirstChildNode(shadowNodeRef);
+        if (entryPtr->nameOffset >= snapshotPtr->stringsSize)
+        {
+            return false;
+        }
 
-        while (shadowChildRef != NULL)
+        if (i > 0)
         {
-            if (shadowChildRef->shadowRef != NULL)
+            const char* namePtr = snapshotPtr->stringsPtr + entryPtr->nameOffset;
+            size_t nameLen = strnlen(namePtr, LE_CFG_NAME_LEN_BYTES);
+
+            if (   (nameLen == 0)
+                || (nameLen > LE_CFG_NAME_LEN)
+                || (strcmp(namePtr, ".") == 0)
+                || (strcmp(namePtr, "..") == 0)
+                || (strchr(namePtr, '/') != NULL)
+                || (strchr(namePtr, ':') != NULL))
             {
-                ClearDeletedFlag(shadowChildRef->shadowRef);
+                return false;
             }
-
-            shadowChildRef = tdb_GetNextSiblingNode(shadowChildRef);
         }
-    }
-
-    // Fire on all original nodes still marked.  But also take care to clear the deleted flags here
-    // in order to leave everything as it was.
-    originalChildRef = tdb_GetFirstChildNode(originalRef);
 
-    while (originalChildRef != NULL)
-    {
-        if (IsDeleted(originalChildRef) == true)
+        switch (SNAPSHOT_TYPE(entryPtr))
         {
-            FireAllChildren(pathRef, originalChildRef);
-            ClearDeletedFlag(originalChildRef);
-        }
+            case LE_CFG_TYPE_EMPTY:
+                if (   (childCount != 0)
+                    || (flags != 0))
+                {
+                    return false;
+                }
+                break;
+
+            case LE_CFG_TYPE_STEM:
+                if (   (flags != 0)
+                    || (entryPtr->data != nextChild)
+                    || (childCount > snapshotPtr->nodeCount - nextChild))
+                {
+                    return false;
+                }
+                nextChild += childCount;
+                break;
+
+            case LE_CFG_TYPE_INT:
+                if (flags == SNAPSHOT_INLINE)
+                {
+                    if (childCount != 0)
+                    {
+                        return false;
+                    }
+                    break;
+                }
+                // Fall through.
+
+            case LE_CFG_TYPE_BOOL:
+            case LE_CFG_TYPE_FLOAT:
+            case LE_CFG_TYPE_STRING:
+                if (   (childCount != 0)
+                    || (flags != 0)
+                    || (entryPtr->data >= snapshotPtr->stringsSize))
+                {
+                    return false;
+                }
+                break;
 
-        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
+            default:
+                return false;
+        }
     }
+
+    return nextChild == snapshotPtr->nodeCount;
 }
 
 
@@ -1495,125 +3558,124 @@ static void FireLostChildren
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Recursive function to merge a collection of shadow nodes with the original tree.
+ *  Map a binary tree file into memory and load its root node.  The rest of the tree is loaded a
+ *  level at a time, as it is accessed.
  *
- *  @return True if the given node or any if it's children have been modified.  False if not.
+ *  @return LE_OK if the tree was loaded.
+ *          LE_FORMAT_ERROR if the file isn't a valid binary tree file.
+ *          LE_IO_ERROR if the file couldn't be mapped.
  */
 // -------------------------------------------------------------------------------------------------
-static bool InternalMergeTree
+static le_result_t LoadTreeSnapshot
 (
-    const char* treeNamePtr,    ///< [IN] The name of the tree we're merging.
-    le_pathIter_Ref_t pathRef,  ///< [IN] Path to the parent of hte current node.
-    tdb_NodeRef_t nodeRef,      ///< [IN] Node and any children to merge.
-    bool forceFire              ///< [IN] Should update handlers be fired for this node and all it's
-                                ///<      children, regardless of wether or not this node has been
-                                ///<      directly modified?
+    tdb_NodeRef_t rootRef,  ///< [IN] The root node to load into.  Must be empty.
+    FILE* filePtr           ///< [IN] The binary tree file.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    bool isModified = IsModified(nodeRef);
-    bool renamed = WasRenamed(nodeRef);
-
-    // If this node was renamed, then all children also need to be triggered as well.
-    forceFire = renamed || forceFire;
+    struct stat fileInfo;
 
-    // If this node has been renamed, marked as deleted or set empty, then all of the children need
-    // notifications fired on the original nodes.
-    if (   (renamed == true)
-        || (IsDeleted(nodeRef) == true)
-        || (OriginalToBeCleared(nodeRef) == true))
+    if (fstat(fileno(filePtr), &fileInfo) != 0)
     {
-        le_pathIter_Ref_t originalPathRef = CreateBasePath(treeNamePtr);
-
-        if (nodeRef->shadowRef != NULL)
-        {
-            GeneratePath(originalPathRef, nodeRef->shadowRef->parentRef);
-            FireAllChildren(originalPathRef, nodeRef->shadowRef);
-        }
-
-        le_pathIter_Delete(originalPathRef);
+        LE_ERROR("Could not get the size of the tree file: %s", LE_ERRNO_TXT(errno));
+        return LE_IO_ERROR;
     }
-    else if (   (isModified == true)
-             && (nodeRef->type == LE_CFG_TYPE_STEM))
+
+    if (   (fileInfo.st_size < (off_t)sizeof(SnapshotHeader_t))
+        || ((uint64_t)fileInfo.st_size > SIZE_MAX))
     {
-        le_pathIter_Ref_t originalPathRef = CreateBasePath(treeNamePtr);
+        LE_ERROR("Bad binary tree file size, %lld bytes.", (long long)fileInfo.st_size);
+        return LE_FORMAT_ERROR;
+    }
 
-        GeneratePath(originalPathRef, nodeRef->shadowRef);
-        FireLostChildren(originalPathRef, nodeRef);
+    size_t mapSize = (size_t)fileInfo.st_size;
+    void* mapPtr = mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE, fileno(filePtr), 0);
 
-        le_pathIter_Delete(originalPathRef);
+    if (mapPtr == MAP_FAILED)
+    {
+        LE_ERROR("Could not map the tree file: %s", LE_ERRNO_TXT(errno));
+        return LE_IO_ERROR;
     }
 
-    AppendNodeName(pathRef, nodeRef);
+    const SnapshotHeader_t* headerPtr = mapPtr;
+    const uint8_t* bodyPtr = (const uint8_t*)mapPtr + sizeof(*headerPtr);
 
-    // IF this node is modified, mearge it.  If this node is a stem, then merge it's children.  Keep
-    // track of whether any of those children have been modified as well.
-    if (isModified)
+    if (   (headerPtr->magic != SNAPSHOT_MAGIC)
+        || (headerPtr->version != SNAPSHOT_VERSION)
+        || (headerPtr->nodeCount == 0)
+        || (headerPtr->stringsSize == 0)
+        || (   (uint64_t)sizeof(*headerPtr)
+             + (uint64_t)headerPtr->nodeCount * sizeof(SnapshotNode_t)
+             + headerPtr->stringsSize != mapSize)
+        || (le_crc_Crc32((uint8_t*)bodyPtr, mapSize - sizeof(*headerPtr), LE_CRC_START_CRC32)
+            != headerPtr->crc))
     {
-        MergeNode(nodeRef);
+        LE_ERROR("Bad binary tree file header.");
+        munmap(mapPtr, mapSize);
+        return LE_FORMAT_ERROR;
     }
 
-    if (   (nodeRef->type == LE_CFG_TYPE_STEM)
-        && (IsDeleted(nodeRef) == false))
-    {
-        nodeRef = tdb_GetFirstChildNode(nodeRef);
+    Snapshot_t* snapshotPtr = le_mem_ForceAlloc(SnapshotPoolRef);
 
-        while (nodeRef != NULL)
-        {
-            tdb_NodeRef_t nextNodeRef = tdb_GetNextSiblingNode(nodeRef);
+    snapshotPtr->mapPtr = mapPtr;
+    snapshotPtr->mapSize = mapSize;
+    snapshotPtr->nodesPtr = (const SnapshotNode_t*)bodyPtr;
+    snapshotPtr->nodeCount = headerPtr->nodeCount;
+    snapshotPtr->stringsPtr = (const char*)(snapshotPtr->nodesPtr + headerPtr->nodeCount);
+    snapshotPtr->stringsSize = headerPtr->stringsSize;
 
-            isModified = InternalMergeTree(treeNamePtr, pathRef, nodeRef, forceFire) || isModified;
-            nodeRef = nextNodeRef;
-        }
-    }
+    le_result_t result = LE_OK;
 
-    // If this node, or any of it's children have been modified.  Try to fire any callbacks that may
-    // be registered.
-    if (isModified || forceFire)
+    if (   (snapshotPtr->stringsPtr[snapshotPtr->stringsSize - 1] != '\0')
+        || (CheckSnapshotNodes(snapshotPtr) == false))
     {
-        TriggerCallbacks(pathRef);
+        LE_ERROR("Bad binary tree file contents.");
+        result = LE_FORMAT_ERROR;
     }
-
-    // Now remove this node from the tracking path and let our caller know if any modifications have
-    // happened at this level or lower.
-    if (le_pathIter_GoToEnd(pathRef) == LE_OK)
+    else
     {
-        le_pathIter_Truncate(pathRef);
+        SetFromSnapshot(rootRef, snapshotPtr, 0);
     }
 
-    return isModified;
+    // If the root has children, it holds its own reference to the file.
+    le_mem_Release(snapshotPtr);
+
+    return result;
 }
+#endif /* end LE_CONFIG_CFGTREE_BINARY */
 
 
 
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Create a new tree object and set it to default values.
+ *  Calculate the number of bytes required to store a node path, including seperators and a trailing
+ *  NULL.
  *
- *  @return A ref to the newly created tree object.
+ *  @return The amount of bytes required to store the whole path string.
  */
 // -------------------------------------------------------------------------------------------------
-tdb_TreeRef_t NewTree
+static size_t ComputePathLength
 (
-    const char* treeNameRef,   ///< [IN] The name of the new tree.
-    tdb_NodeRef_t rootNodeRef  ///< [IN] The root node of this new tree.
+    tdb_NodeRef_t nodeRef  ///< [IN] Compute a path for this node.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_TreeRef_t treeRef = le_mem_ForceAlloc(TreePoolRef);
+    size_t pathLen = 0;
+    char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
 
-    LE_ASSERT(le_utf8_Copy(treeRef->name, treeNameRef, MAX_TREE_NAME_BYTES, NULL) == LE_OK);
+    while (nodeRef != NULL)
+    {
+        LE_ASSERT(tdb_GetNodeName(nodeRef, nodeName, sizeof(nodeName)) == LE_OK);
 
-    treeRef->isDeletePending = false;
-    treeRef->originalTreeRef = NULL;
-    treeRef->revisionId = 0;
-    treeRef->rootNodeRef = (rootNodeRef != NULL) ? rootNodeRef : NewNode();
-    treeRef->activeReadCount = 0;
-    treeRef->activeWriteIterRef = NULL;
-    treeRef->requestList = LE_SLS_LIST_INIT;
+        // Add this path segment's length to our running total, along with the required path
+        // seperator.
+        pathLen += 1 + le_utf8_NumBytes(nodeName);
+        nodeRef = tdb_GetNodeParent(nodeRef);
+    }
 
-    return treeRef;
+    // Don't forget to include a spot for the trailing NULL.
+    return pathLen + 1;
 }
 
 
@@ -1621,25 +3683,21 @@ tdb_TreeRef_t NewTree
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Destructor called when a tree object is to be freed from memory.
+ *  Bump up the version id of this tree.
  */
 // -------------------------------------------------------------------------------------------------
-static void TreeDestructor
+static void IncrementRevision
 (
-    void* objectPtr  ///< The memory object to destruct.
+    tdb_TreeRef_t treeRef  ///< [IN] Increment the revision of this tree.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_TreeRef_t treeRef = (tdb_TreeRef_t)objectPtr;
-
-    // Kill the root node.
-    le_mem_Release(treeRef->rootNodeRef);
-    treeRef->rootNodeRef = NULL;
+    treeRef->revisionId++;
 
-    // Sanity check, is the tree actually ready to clean up?
-    LE_ASSERT(treeRef->activeReadCount == 0);
-    LE_ASSERT(treeRef->activeWriteIterRef == NULL);
-    LE_ASSERT(le_sls_IsEmpty(&treeRef->requestList) == true);
+    if (treeRef->revisionId > 3)
+    {
+        treeRef->revisionId = 1;
+    }
 }
 
 
@@ -1647,40 +3705,20 @@ static void TreeDestructor
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Create a path to a tree file with the given revision id.
- *
- *  @return A stringBuffer backed string containing the full path to the tree file.
+ *  Call this function to delete a tree file from the filesystem.
  */
 // -------------------------------------------------------------------------------------------------
-static void GetTreePath
+static void DeleteTreeFile
 (
-    const char* treeNameRef,  ///< [IN] The name of the tree we're generating a name for.
-    int revisionId,           ///< [IN] Generate a name based on the tree revision.
-    char* pathBuffer,         ///< [IN] Buffer to hold the new path.
-    size_t pathSize           ///< [IN] Size of the path buffer.
+    const char* filePathPtr  ///< Path to the tree file in question.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // paper    --> rock       1 -> 2
-    // rock     --> scissors   2 -> 3
-    // scissors --> paper      3 -> 1
-
-    static const char* revNames[] = { "paper", "rock", "scissors" };
-    int printSize;
-
-    LE_ASSERT((revisionId >= 1) && (revisionId <= 3));
-
-    printSize = snprintf(pathBuffer,
-                         pathSize,
-                         "%s/%s.%s",
-                         CFG_TREE_PATH,
-                         treeNameRef,
-                         revNames[revisionId - 1]);
+    LE_DEBUG("** Deleting tree file, '%s'.", filePathPtr);
 
-    if (printSize >= pathSize)
+    if (unlink(filePathPtr) != 0)
     {
-       LE_ERROR("Unable to store config tree path in buffer");
-       pathBuffer[0] = '\0';
+        LE_ERROR("File delete failure, '%s', reason '%m'.", filePathPtr);
     }
 }
 
@@ -1689,130 +3727,121 @@ static void GetTreePath
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check to see if a configTree file at the given revision already exists in the filesystem.
- *
- *  @note If the tree file exists, but is empty, then it is invalid and will be deleted.
+ *  Serialize a whole tree to a new revision of its tree file, then delete the previous revision.
  *
- *  @return True if the named file exists, false otherwise.
+ *  @return LE_OK if the new tree file was written.
+ *          LE_NOT_PERMITTED if the file system is read-only, so the changes were discarded.
+ *          LE_IO_ERROR if the file couldn't be written.
  */
 // -------------------------------------------------------------------------------------------------
-static bool TreeFileExists
+static le_result_t WriteTreeFile
 (
-    const char* treeNameRef,  ///< [IN] Name of the tree to check.
-    int revisionId            ///< [IN] The revision of the tree to check against.
+    tdb_TreeRef_t treeRef  ///< [IN] The tree to serialize.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    char fullPath[LE_CFG_STR_LEN_BYTES] = "";
-    GetTreePath(treeNameRef, revisionId, fullPath, sizeof(fullPath));
+    // Increment revision of the tree and open a tree file for writing.
+    int oldId = treeRef->revisionId;
 
-    // Make sure this part was successful.
-    if (fullPath[0] == '\0')
-    {
-        return false;
-    }
+    IncrementRevision(treeRef);
 
-    // stat() the file to see if it exists and get its size.
-    struct stat s;
-    if (stat(fullPath, &s) == -1)
-    {
-        LE_DEBUG("Can't stat file '%s' (%m).", fullPath);
-        return false;
-    }
+    char filePath[LE_CFG_STR_LEN_BYTES] = "";
+    GetTreePath(treeRef->name, treeRef->revisionId, filePath, sizeof(filePath));
 
-    // Make sure it's a regular file.
-    if (!S_ISREG(s.st_mode))
+    LE_DEBUG("Attempting to serialize the tree to '%s'.", filePath);
+
+    FILE* filePtr = NULL;
+
+    filePtr = fopen(filePath, "w+");
+
+    if (!filePtr && (EROFS == errno))
     {
-        LE_FATAL("Object at '%s' is not a regular file.", fullPath);
+        // In case we are R/O for the config tree, we discard the update to flash
+        return LE_NOT_PERMITTED;
     }
 
-    // If it's zero size, delete it and report that it doesn't exist.
-    if (s.st_size == 0)
+    if (!filePtr)
     {
-        if (unlink(fullPath) == -1)
-        {
-            LE_FATAL("Failed to unlink empty file '%s' (%m).", fullPath);
-        }
-
-        return false;
+        LE_EMERG("Failed to open config file '%s' (%m).", filePath);
+        LE_EMERG("Changes have been merged in memory, however they could not be committed to the "
+                 "filesystem!!");
+        return LE_IO_ERROR;
     }
 
-    // NOTE: The Config Tree generally runs as root, so permissions should be irrelevant.
-
-    return true;
-}
-
-
-
-
-// -------------------------------------------------------------------------------------------------
-/**
- * Check the filesystem and get the current "valid" version of the file and update the tree object
- * with that version number.
- *
- * If there are two files for a given tree, we use the older one.  The idea being, if there are
- * two versions of the same file in the filesystem then there was a system failure during a save
- * operation.  So we abandon the newer (probably incomplete) file and go with the older file;
- * unless the size of the older file is zero, which can happen if deletion of that file is
- * interrupted.
- */
-// -------------------------------------------------------------------------------------------------
-static void UpdateRevision
-(
-    tdb_TreeRef_t treeRef  ///< [IN] Update the revision for this tree object.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    int newRevision = 0;
+    // We have a tree file to write to, so stream the new tree to it then close the output file.
+#if LE_CONFIG_CFGTREE_BINARY
+    le_result_t writeResult = WriteTreeSnapshot(treeRef->rootNodeRef, filePtr);
+#else
+    le_result_t writeResult = tdb_WriteTreeNode(treeRef->rootNodeRef, filePtr);
+#endif
 
-    if (TreeFileExists(treeRef->name, 1))
+#if LE_CONFIG_CFGTREE_JOURNAL
+    // The journal is emptied once the new tree file has been written, so make sure the file has
+    // really been written first.
+    if (   (writeResult == LE_OK)
+        && ((fflush(filePtr) != 0) || (fsync(fileno(filePtr)) != 0)))
     {
-        if (TreeFileExists(treeRef->name, 3))
-        {
-            newRevision = 3;
-        }
-        else
-        {
-            newRevision = 1;
-        }
+        LE_EMERG("Failed to sync the tree file: %s", LE_ERRNO_TXT(errno));
+        writeResult = LE_IO_ERROR;
     }
-    else if (TreeFileExists(treeRef->name, 3))
-    {
-        if (TreeFileExists(treeRef->name, 2))
-        {
-            newRevision = 2;
-        }
-        else
+#endif
+
+    int retVal = fclose(filePtr);
+    LE_EMERG_IF(retVal == EOF,
+                "An error occurred while closing the tree file: %s", LE_ERRNO_TXT(errno));
+
+    // Finally remove the old version of the tree file, if there is one.
+    if (writeResult == LE_OK)
+    {
+#if LE_CONFIG_CFGTREE_JOURNAL
+        treeRef->isTreeFileCrcKnown = false;
+#endif
+
+        if (   (oldId != 0)
+            && (TreeFileExists(treeRef->name, oldId)))
         {
-            newRevision = 3;
+            GetTreePath(treeRef->name, oldId, filePath, sizeof(filePath));
+            DeleteTreeFile(filePath);
         }
     }
-    else if (TreeFileExists(treeRef->name, 2))
+    else
     {
-        newRevision = 2;
+        // The write failed, delete the new file we attempted to create.
+        LE_EMERG("The attempt to write to the config tree file, '%s,' failed.", filePath);
+        DeleteTreeFile(filePath);
+
+        // The previous revision is still the current one.
+        treeRef->revisionId = oldId;
     }
 
-    treeRef->revisionId = newRevision;
+    return writeResult;
 }
 
 
 
 
+#if LE_CONFIG_CFGTREE_JOURNAL
 // -------------------------------------------------------------------------------------------------
 /**
- *  Peek into the input stream one character ahead.
+ *  Create a path to a tree's journal file.
  */
 // -------------------------------------------------------------------------------------------------
-static signed char PeekChar
+static void GetJournalPath
 (
-    FILE* filePtr  ///< [IN] The file stream to peek into.
+    const char* treeNameRef,  ///< [IN] The name of the tree we're generating a name for.
+    char* pathBuffer,         ///< [IN] Buffer to hold the new path.
+    size_t pathSize           ///< [IN] Size of the path buffer.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    int next = fgetc(filePtr);
-    ungetc(next, filePtr);
+    int printSize = snprintf(pathBuffer, pathSize, "%s/%s.journal", CFG_TREE_FILE_DIR,
+                             treeNameRef);
 
-    return next;
+    if (printSize >= pathSize)
+    {
+       LE_ERROR("Unable to store config tree journal path in buffer");
+       pathBuffer[0] = '\0';
+    }
 }
 
 
@@ -1820,104 +3849,186 @@ static signed char PeekChar
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Skip any whitespace encountered in the input stream.  Stop skipping once we hit a valid token.
+ *  Walk the path of a node in a (non-shadow) tree, starting from its root node.
  *
- *  @return LE_OK if the whitespace is skiped and there is still more file to read.
- *          LE_OUT_OF_RANGE if the end of the file is hit.
+ *  @return The node at the end of the path, or NULL if it doesn't exist and create is false.
+ *          NULL is also returned if a node couldn't be created.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t SkipWhiteSpace
+static tdb_NodeRef_t WalkJournalPath
 (
-    FILE* filePtr  ///< [IN] The file stream to seek through.
+    tdb_NodeRef_t rootRef,  ///< [IN] Root node of the tree.
+    const char* pathPtr,    ///< [IN] Path of the node, relative to the root node.
+    bool create             ///< [IN] Create any nodes along the path that don't exist.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    bool done = false;
-    bool isEof = false;
+    tdb_NodeRef_t nodeRef = rootRef;
+    char name[LE_CFG_NAME_LEN_BYTES];
 
-    while (done == false)
+    while (nodeRef != NULL)
     {
-        switch (PeekChar(filePtr))
+        // Skip the separator and get the next node name.
+        while (*pathPtr == '/')
         {
-            case '\n':
-            case '\r':
-            case '\t':
-            case ' ':
-                // Eat the character.
-                fgetc(filePtr);
-                break;
+            pathPtr++;
+        }
 
-            case EOF:
-                done = true;
-                isEof = true;
-                break;
+        if (*pathPtr == '\0')
+        {
+            break;
+        }
 
-            default:
-                done = true;
-                break;
+        const char* endPtr = strchrnul(pathPtr, '/');
+        size_t nameLen = endPtr - pathPtr;
+
+        if (nameLen >= sizeof(name))
+        {
+            return NULL;
+        }
+
+        memcpy(name, pathPtr, nameLen);
+        name[nameLen] = '\0';
+        pathPtr = endPtr;
+
+        tdb_NodeRef_t childRef = GetNamedChild(nodeRef, name);
+
+        if ((childRef == NULL) && create)
+        {
+            // Values are replaced by collections when a path is created through them.
+            if (   (nodeRef->type != LE_CFG_TYPE_STEM)
+                && (nodeRef->type != LE_CFG_TYPE_EMPTY))
+            {
+                tdb_SetEmpty(nodeRef);
+                ClearModifiedFlag(nodeRef);
+            }
+
+            childRef = NewChildNode(nodeRef);
+
+            if (tdb_SetNodeName(childRef, name) != LE_OK)
+            {
+                le_mem_Release(childRef);
+                return NULL;
+            }
+
+            ClearModifiedFlag(childRef);
         }
+
+        nodeRef = childRef;
     }
 
-    return isEof == true ? LE_OUT_OF_RANGE : LE_OK;
+    return nodeRef;
 }
 
 
+
+
 // -------------------------------------------------------------------------------------------------
 /**
- *  Skip to the next occurence of the given character.
- *
- *  @return LE_OK if the character is found.
- *          LE_OUT_OF_RANGE if the end of the file is hit.
+ *  Record the path of a node in the list of paths changed by a transaction.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t SkipToNextChar
+static void AddJournalPath
 (
-    FILE* filePtr,          ///< [IN] The file stream to seek through.
-    signed char nextChar    ///< [IN]  The character we're searching for.
+    FILE* listPtr,          ///< [IN] Stream the changed paths are written to, separated by NULs.
+    const char* pathPtr,    ///< [IN] Path to the parent of the node (empty for the root).
+    size_t pathLen,         ///< [IN] Length of the parent's path.
+    const char* namePtr     ///< [IN] Name of the node, or NULL for the root.
 )
+// -------------------------------------------------------------------------------------------------
 {
-    int next;
-
-    while ((next = fgetc(filePtr)) != nextChar)
+    if (namePtr == NULL)
     {
-        if (next == EOF)
-        {
-            return LE_OUT_OF_RANGE;
-        }
+        fwrite("/", 1, 2, listPtr);
+    }
+    else
+    {
+        fprintf(listPtr, "%.*s/%s%c", (int)pathLen, pathPtr, namePtr, '\0');
     }
-
-    return LE_OK;
 }
 
 
+
+
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read a boolean literal from the input file.
+ *  Find the nodes that have been changed in a shadow tree, and record their paths.  Must be done
+ *  before the shadow tree is merged, as merging loses track of where deleted and renamed nodes
+ *  used to be.
  *
- *  @return LE_OK if the literal could be read.
- *          LE_FORMAT_ERROR if the literal could not be read.
+ *  Once a changed node is found its children aren't searched, as the whole node will be written to
+ *  the journal.
  */
 // -------------------------------------------------------------------------------------------------
-static bool ReadBoolToken
+static void FindChangedPaths
 (
-    FILE* filePtr,     ///< [IN]  The file we're reading from.
-    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+    tdb_NodeRef_t nodeRef,  ///< [IN] The shadow node to check.
+    char* pathPtr,          ///< [IN] Buffer holding the path to the node's parent.
+    size_t pathLen,         ///< [IN] Length of the parent's path.
+    FILE* listPtr           ///< [IN] Stream the changed paths are written to.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    int next = fgetc(filePtr);
+    char name[LE_CFG_NAME_LEN_BYTES] = "";
+    bool isRoot = (nodeRef->parentRef == NULL);
 
-    if (   (next == 't')
-        || (next == 'f'))
+    if (!isRoot)
     {
-        stringPtr[0] = next;
-        stringPtr[1] = 0;
+        tdb_GetNodeName(nodeRef, name, sizeof(name));
+    }
 
-        return LE_OK;
+    if (IsModified(nodeRef))
+    {
+        AddJournalPath(listPtr, pathPtr, pathLen, isRoot ? NULL : name);
+
+        // A renamed node is also gone from where it used to be.
+        if (WasRenamed(nodeRef))
+        {
+            char oldName[LE_CFG_NAME_LEN_BYTES] = "";
+
+            tdb_GetNodeName(nodeRef->shadowRef, oldName, sizeof(oldName));
+            AddJournalPath(listPtr, pathPtr, pathLen, oldName);
+        }
+
+        return;
     }
 
-    return LE_FORMAT_ERROR;
+    if (   (nodeRef->type != LE_CFG_TYPE_STEM)
+        || (IsDeleted(nodeRef)))
+    {
+        return;
+    }
+
+    size_t childPathLen = pathLen;
+
+    if (!isRoot)
+    {
+        childPathLen += snprintf(pathPtr + pathLen, CFG_MAX_PATH_SIZE - pathLen, "/%s", name);
+
+        if (childPathLen >= CFG_MAX_PATH_SIZE)
+        {
+            // Can't happen, as paths are checked when nodes are created.  Play it safe by
+            // recording the whole (truncated) parent instead.
+            AddJournalPath(listPtr, pathPtr, pathLen, name);
+            pathPtr[pathLen] = '\0';
+            return;
+        }
+    }
+
+    // Only look at the shadow children that already exist.  If there are none, then nothing has
+    // been changed below this node.
+    le_dls_Link_t* linkPtr = le_dls_Peek(&nodeRef->info.children);
+
+    while (linkPtr != NULL)
+    {
+        FindChangedPaths(CONTAINER_OF(linkPtr, Node_t, siblingList),
+                         pathPtr,
+                         childPathLen,
+                         listPtr);
+        linkPtr = le_dls_PeekNext(&nodeRef->info.children, linkPtr);
+    }
+
+    pathPtr[pathLen] = '\0';
 }
 
 
@@ -1925,75 +4036,59 @@ static bool ReadBoolToken
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read a textual literal from the input file, the read is terminated successfuly if the terminal
- *  character is found.
+ *  Build a journal record from the merged state of the paths changed by a transaction.  For each
+ *  path, the record holds either '=' followed by the path and the node's contents in the tree file
+ *  format, or '-' followed by the path if the node no longer exists.
  *
- *  @return LE_OK if the string is read from the file.
- *          LE_FORMAT_ERROR if the text fails to be read from the file.
- *          LE_OVERFLOW if the text doesn't fit in provided buffer (truncated).
+ *  Since each entry holds the final state of a node, replaying a record more than once, or
+ *  replaying it on top of a tree file that already includes it, gives the same result.
+ *
+ *  @return LE_OK if successful, LE_IO_ERROR if the record couldn't be written.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t ReadTextLiteral
+static le_result_t BuildJournalRecord
 (
-    FILE* filePtr,        ///< [IN]  The file we're reading from.
-    char* stringPtr,      ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize,    ///< [IN]  How big is the supplied string buffer?
-    signed char terminal  ///< [IN]  The terminal character we're searching for.
+    tdb_TreeRef_t treeRef,    ///< [IN] The (merged) tree.
+    const char* pathListPtr,  ///< [IN] NUL separated list of changed paths.
+    size_t pathListSize,      ///< [IN] Size of the list.
+    FILE* recordPtr           ///< [IN] Stream to write the record to.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    int next;
-    size_t count = 0;
-
-    char* oldPtr = stringPtr;
+    le_result_t result = LE_OK;
+    const char* pathPtr = pathListPtr;
 
-    while ((next = fgetc(filePtr)) != terminal)
+    while ((result == LE_OK) && (pathPtr < pathListPtr + pathListSize))
     {
-        if (next == EOF)
-        {
-            LE_ERROR("Missing end specifier, ']' in int value.");
-            return LE_FORMAT_ERROR;
-        }
+        tdb_NodeRef_t nodeRef = WalkJournalPath(treeRef->rootNodeRef, pathPtr, false);
 
-        if (next == '\\')
+        if ((nodeRef != NULL) && !IsDeleted(nodeRef))
         {
-            next = fgetc(filePtr);
+            result = WriteFile(recordPtr, "=", 1);
 
-            if (next == EOF)
+            if (result == LE_OK)
             {
-                LE_ERROR("Unexpected EOF after finding \\ character.");
-                return LE_FORMAT_ERROR;
+                result = WriteStringValue(recordPtr, '\"', '\"', pathPtr);
+            }
+            if (result == LE_OK)
+            {
+                result = InternalWriteNode(nodeRef, recordPtr);
             }
         }
-
-        if (count >= (stringSize - 1))
+        else
         {
-            // truncate the string to the buffer size
-            *stringPtr = 0;
+            result = WriteFile(recordPtr, "-", 1);
 
-            LE_ERROR("String literal is too large.  (%" PRIdS "/%" PRIdS ")",
-                     strlen(oldPtr),
-                     stringSize);
-            // move the file pointer to the terminal character (e.g. closing quote)
-            if (LE_OK == SkipToNextChar(filePtr, terminal))
-            {
-                return LE_OVERFLOW;
-            }
-            else
+            if (result == LE_OK)
             {
-                return LE_FORMAT_ERROR;
+                result = WriteStringValue(recordPtr, '\"', '\"', pathPtr);
             }
         }
 
-        *stringPtr = next;
-
-        ++stringPtr;
-        ++count;
+        pathPtr += strlen(pathPtr) + 1;
     }
 
-    *stringPtr = 0;
-
-    return LE_OK;
+    return result;
 }
 
 
@@ -2001,53 +4096,57 @@ static le_result_t ReadTextLiteral
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read an integer token string from the file.
+ *  Get the CRC32 of the contents of a tree's current tree file.  This identifies the tree file the
+ *  journal's records are made on top of.  It is worked out the first time it's needed after the
+ *  tree file is loaded or written.
  *
- *  @return LE_OK if the string is read from the file.
- *          LE_FORMAT_ERROR if the text fails to be read from the file.
- *          LE_OVERFLOW if the text doesn't fit in provided buffer (truncated).
+ *  @return LE_OK if successful, LE_IO_ERROR if the tree file couldn't be read.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t ReadIntToken
+static le_result_t GetTreeFileCrc
 (
-    FILE* filePtr,     ///< [IN]  The file we're reading from.
-    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+    tdb_TreeRef_t treeRef,  ///< [IN] The tree, which must have a tree file.
+    uint32_t* crcPtr        ///< [OUT] The CRC of the tree file.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, ']');
+    if (!treeRef->isTreeFileCrcKnown)
+    {
+        char filePath[LE_CFG_STR_LEN_BYTES] = "";
+        GetTreePath(treeRef->name, treeRef->revisionId, filePath, sizeof(filePath));
 
-    // TODO: Validate the int string.
+        FILE* filePtr = fopen(filePath, "r");
 
-    return result;
-}
+        if (filePtr == NULL)
+        {
+            LE_ERROR("Could not open config tree file '%s' (%m).", filePath);
+            return LE_IO_ERROR;
+        }
 
+        uint8_t buffer[512];
+        uint32_t crc = LE_CRC_START_CRC32;
+        size_t readSize;
 
+        while ((readSize = fread(buffer, 1, sizeof(buffer), filePtr)) > 0)
+        {
+            crc = le_crc_Crc32(buffer, readSize, crc);
+        }
 
+        bool isError = (ferror(filePtr) != 0);
+        fclose(filePtr);
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Read a floating point token string from the file.
- *
- *  @return LE_OK if the string is read from the file.
- *          LE_FORMAT_ERROR if the text fails to be read from the file.
- *          LE_OVERFLOW if the text doesn't fit in provided buffer (truncated).
- */
-// -------------------------------------------------------------------------------------------------
-static le_result_t ReadFloatToken
-(
-    FILE* filePtr,     ///< [IN]  The file we're reading from.
-    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
-)
-// -------------------------------------------------------------------------------------------------
-{
-    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, ')');
+        if (isError)
+        {
+            LE_ERROR("Could not read config tree file '%s'.", filePath);
+            return LE_IO_ERROR;
+        }
 
-    // TODO: Validate the float string.
+        treeRef->treeFileCrc = crc;
+        treeRef->isTreeFileCrcKnown = true;
+    }
 
-    return result;
+    *crcPtr = treeRef->treeFileCrc;
+    return LE_OK;
 }
 
 
@@ -2055,26 +4154,48 @@ static le_result_t ReadFloatToken
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read a string from the config tree file.
+ *  Open a tree's journal for appending, if it isn't already.
  *
- *  @return LE_OK if the string is read from the file.
- *          LE_FORMAT_ERROR if the text fails to be read from the file.
- *          LE_OVERFLOW if the text doesn't fit in provided buffer (truncated).
+ *  @return LE_OK if the journal is open.
+ *          LE_NOT_PERMITTED if the file system is read-only.
+ *          LE_IO_ERROR if the journal couldn't be opened.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t ReadStringToken
+static le_result_t OpenJournal
 (
-    FILE* filePtr,     ///< [IN]  The file we're reading from.
-    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+    tdb_TreeRef_t treeRef  ///< [IN] The tree.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, '"');
+    if (treeRef->journalFd >= 0)
+    {
+        return LE_OK;
+    }
 
-    // TODO: Validate the literal string.
+    char filePath[LE_CFG_STR_LEN_BYTES] = "";
+    GetJournalPath(treeRef->name, filePath, sizeof(filePath));
+
+    int fd;
+
+    do
+    {
+        fd = open(filePath, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0666);
+    }
+    while ((fd == -1) && (errno == EINTR));
+
+    if (fd == -1)
+    {
+        if (errno == EROFS)
+        {
+            return LE_NOT_PERMITTED;
+        }
+
+        LE_ERROR("Failed to open config tree journal '%s' (%m).", filePath);
+        return LE_IO_ERROR;
+    }
 
-    return result;
+    treeRef->journalFd = fd;
+    return LE_OK;
 }
 
 
@@ -2082,69 +4203,36 @@ static le_result_t ReadStringToken
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read a token from the input stream.
- *
- *  @return LE_OK if a token could be read.  LE_OUT_OF_RANGE if the end of the stream is reached
- *          before a token could be finished.
+ *  Empty a tree's journal.  Called once a new tree file has been written.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t ReadToken
+static void ResetJournal
 (
-    FILE* filePtr,         ///< [IN]  The file we're reading from.
-    char* stringPtr,       ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize,     ///< [IN]  How big is the supplied string buffer?
-    TokenType_t* typePtr   ///< [OUT] The type of token read from the file.
+    tdb_TreeRef_t treeRef  ///< [IN] The tree.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    *stringPtr = 0;
-
-    if (SkipWhiteSpace(filePtr) != LE_OK)
+    if (treeRef->compactTimerRef != NULL)
     {
-        return LE_OUT_OF_RANGE;
+        le_timer_Stop(treeRef->compactTimerRef);
     }
 
-    int next;
+    if (treeRef->journalSize == 0)
+    {
+        return;
+    }
 
-    while ((next = fgetc(filePtr)) != EOF)
+    if (OpenJournal(treeRef) == LE_OK)
     {
-        switch (next)
+        if (ftruncate(treeRef->journalFd, 0) == 0)
         {
-            case '~':
-                *typePtr = TT_EMPTY_VALUE;
-                return LE_OK;
-
-            case '!':
-                *typePtr = TT_BOOL_VALUE;
-                return ReadBoolToken(filePtr, stringPtr, stringSize);
-
-            case '[':
-                *typePtr = TT_INT_VALUE;
-                return ReadIntToken(filePtr, stringPtr, stringSize);
-
-            case '(':
-                *typePtr = TT_FLOAT_VALUE;
-                return ReadFloatToken(filePtr, stringPtr, stringSize);
-
-            case '\"':
-                *typePtr = TT_STRING_VALUE;
-                return ReadStringToken(filePtr, stringPtr, stringSize);
-
-            case '{':
-                *typePtr = TT_OPEN_GROUP;
-                return LE_OK;
-
-            case '}':
-                *typePtr = TT_CLOSE_GROUP;
-                return LE_OK;
-
-            default:
-                LE_ERROR("Unexpected character in input stream.");
-                return LE_FORMAT_ERROR;
+            treeRef->journalSize = 0;
+        }
+        else
+        {
+            LE_ERROR("Failed to empty the journal of tree '%s' (%m).", treeRef->name);
         }
     }
-
-    return LE_OUT_OF_RANGE;
 }
 
 
@@ -2152,83 +4240,78 @@ static le_result_t ReadToken
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Write data to the output stream.  This function will record any faults to the system log.
- *
- *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ *  Fold a tree's journal into a new tree file.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t WriteFile
+static void CompactJournal
 (
-    FILE* filePtr,        ///< [IN] The file being written to.
-    const void* dataPtr,  ///< [IN] The data being written to the file.
-    size_t dataSize       ///< [IN] The amount of data being written.
+    tdb_TreeRef_t treeRef  ///< [IN] The tree.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    ssize_t written = fwrite(dataPtr, 1, dataSize, filePtr);
-
-    if (ferror(filePtr) != 0)
-    {
-        LE_EMERG("Failed to write to config tree file.");
-        return LE_IO_ERROR;
-    }
+    LE_DEBUG("Compacting the journal of tree '%s' (%" PRIuS " bytes).",
+             treeRef->name,
+             treeRef->journalSize);
 
-    if (written < dataSize)
+    if (WriteTreeFile(treeRef) == LE_OK)
     {
-        LE_EMERG("Data truncated while writing to configuration file.");
-        return LE_IO_ERROR;
+        ResetJournal(treeRef);
     }
-
-    return LE_OK;
 }
 
 
 
+
 // -------------------------------------------------------------------------------------------------
 /**
- *  Write a string token to the output stream.  This function will write the string and escape all
- *  control characters as it does so.
- *
- *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ *  Called when a tree has gone without commits long enough for its journal to be compacted.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t WriteStringValue
+static void CompactTimerExpired
 (
-    FILE* filePtr,         ///< [IN] The file to write to.
-    char startChar,        ///< [IN] The delimiter to use.
-    char endChar,          ///< [IN] The closing delimiter to use.
-    const char* stringPtr  ///< [IN] The actual string to write.
+    le_timer_Ref_t timerRef  ///< [IN] The tree's compaction timer.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_result_t result = LE_OK;
+    CompactJournal(le_timer_GetContextPtr(timerRef));
+}
 
-    result = WriteFile(filePtr, &startChar, 1);
 
-    while (   (*stringPtr != 0)
-           && (result == LE_OK))
-    {
-        if (   (*stringPtr == '\"')
-            || (*stringPtr == '\\'))
-        {
-            result = WriteFile(filePtr, "\\", 1);
-        }
 
-        if (result == LE_OK)
-        {
-            result = WriteFile(filePtr, stringPtr, 1);
-        }
 
-        stringPtr++;
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Decide whether a tree's journal is due to be compacted, and if so, when.
+ */
+// -------------------------------------------------------------------------------------------------
+static void ScheduleCompaction
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The tree.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (treeRef->journalSize < LE_CONFIG_CFGTREE_JOURNAL_COMPACT_SIZE)
+    {
+        return;
     }
 
-    if (result == LE_OK)
+    // Don't let a tree that is constantly being written to grow its journal forever.
+    if (treeRef->journalSize >= 4 * LE_CONFIG_CFGTREE_JOURNAL_COMPACT_SIZE)
     {
-        char strBuffer[2] = { endChar, ' ' };
-        result = WriteFile(filePtr, strBuffer, sizeof(strBuffer));
+        CompactJournal(treeRef);
+        return;
     }
 
-    return result;
+    if (treeRef->compactTimerRef == NULL)
+    {
+        treeRef->compactTimerRef = le_timer_Create("cfgCompact");
+        le_timer_SetMsInterval(treeRef->compactTimerRef, LE_CONFIG_CFGTREE_JOURNAL_COMPACT_DELAY);
+        le_timer_SetHandler(treeRef->compactTimerRef, CompactTimerExpired);
+        le_timer_SetContextPtr(treeRef->compactTimerRef, treeRef);
+    }
+
+    // Wait for the tree to go quiet.
+    le_timer_Restart(treeRef->compactTimerRef);
 }
 
 
@@ -2236,153 +4319,126 @@ static le_result_t WriteStringValue
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read a node value from the given file.  If the value is a collection, then read in those nodes
- *  too.
+ *  Append a record to a tree's journal.  The record is written with a single write(), so that it is
+ *  either appended as a whole or (if the system goes down part way through) detected as incomplete
+ *  when the journal is replayed.
  *
- *  @return LE_OK if the read is successful.
- *          LE_FORMAT_ERROR if parse errors are encountered.
- *          LE_NOT_FOUND if the end of file is reached.
+ *  @return LE_OK if the record is safely in the journal.
+ *          LE_NOT_PERMITTED if the file system is read-only.
+ *          LE_IO_ERROR if the record couldn't be written.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t InternalReadNode
+static le_result_t AppendJournalRecord
 (
-    tdb_NodeRef_t nodeRef,  ///< [IN] The node we're reading a value for.
-    FILE* filePtr,          ///< [IN] The file we're reading the value from.
-    size_t pathLen          ///< [IN] The length of the path including nodeRef.
+    tdb_TreeRef_t treeRef,  ///< [IN] The tree.
+    char* recordPtr,        ///< [IN] The record: space for the header, followed by the contents.
+    size_t recordSize       ///< [IN] Size of the record, including the header.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    char* stringBuffer = le_mem_ForceAlloc(EncodedStringPool);
-    size_t stringBufferSize = TDB_MAX_ENCODED_SIZE;
-    le_result_t result = LE_OK;
+    uint32_t baseCrc;
+    le_result_t result = GetTreeFileCrc(treeRef, &baseCrc);
 
-    TokenType_t tokenType;
-
-    // Try to read this node's value.
-    result = ReadToken(filePtr, stringBuffer, stringBufferSize, &tokenType);
-    if ((result != LE_OK) && (result != LE_OVERFLOW))
+    if (result == LE_OK)
     {
-        LE_ERROR("Unexpected EOF or bad token in file.");
-        result = LE_FORMAT_ERROR;
-        goto cleanup;
+        result = OpenJournal(treeRef);
     }
-    // if result is OVERFLOW (i.e. string is truncated), we still should be able
-    // to proceed with parsing the rest of the file.
-    result = LE_OK;
 
-    tdb_SetEmpty(nodeRef);
-
-    switch (tokenType)
+    if (result != LE_OK)
     {
-        case TT_BOOL_VALUE:
-            tdb_SetValueAsString(nodeRef, stringBuffer);
-            nodeRef->type = LE_CFG_TYPE_BOOL;
-            break;
-
-        case TT_INT_VALUE:
-            tdb_SetValueAsString(nodeRef, stringBuffer);
-            nodeRef->type = LE_CFG_TYPE_INT;
-            break;
-
-        case TT_FLOAT_VALUE:
-            tdb_SetValueAsString(nodeRef, stringBuffer);
-            nodeRef->type = LE_CFG_TYPE_FLOAT;
-            break;
+        return result;
+    }
 
-        case TT_STRING_VALUE:
-            tdb_SetValueAsString(nodeRef, stringBuffer);
-            break;
+    JournalRecordHeader_t header =
+        {
+            .magic = JOURNAL_RECORD_MAGIC,
+            .baseCrc = baseCrc,
+            .size = recordSize - sizeof(header),
+            .crc = le_crc_Crc32((uint8_t*)recordPtr + sizeof(header),
+                                recordSize - sizeof(header),
+                                le_crc_Crc32((uint8_t*)&baseCrc,
+                                             sizeof(baseCrc),
+                                             LE_CRC_START_CRC32))
+        };
 
-        case TT_EMPTY_VALUE:
-            // The node has already been cleared, so there's nothing left to do but make sure that
-            // the node exists.
-            ClearDeletedFlag(nodeRef);
-            break;
+    memcpy(recordPtr, &header, sizeof(header));
 
-        case TT_OPEN_GROUP:
-            while (tokenType != TT_CLOSE_GROUP)
-            {
-                if (ReadToken(filePtr, stringBuffer, stringBufferSize, &tokenType) != LE_OK)
-                {
-                    LE_ERROR("Unexpected EOF or bad token in file while looking for '}'.");
-                    result = LE_FORMAT_ERROR;
-                    goto cleanup;
-                }
+    ssize_t written;
 
-                if (tokenType == TT_STRING_VALUE)
-                {
-                    size_t strLen = le_utf8_NumBytes(stringBuffer);
-                    size_t newPathLen = pathLen + 1 + strLen;
+    do
+    {
+        written = write(treeRef->journalFd, recordPtr, recordSize);
+    }
+    while ((written == -1) && (errno == EINTR));
 
-                    if (newPathLen > LE_CFG_STR_LEN)
-                    {
-                        LE_ERROR("New path length for node '%s' is too long.  %" PRIuS
-                                 " of %" PRIuS " bytes.",
-                                 stringBuffer,
-                                 strLen,
-                                 (size_t)LE_CFG_STR_LEN);
+    if (   (written != (ssize_t)recordSize)
+        || (fdatasync(treeRef->journalFd) != 0))
+    {
+        LE_ERROR("Failed to write to the journal of tree '%s' (%m).", treeRef->name);
 
-                        result = LE_FORMAT_ERROR;
-                        goto cleanup;
-                    }
+        // Drop anything that made it into the file, so that later records aren't lost behind it.
+        if (ftruncate(treeRef->journalFd, treeRef->journalSize) != 0)
+        {
+            LE_ERROR("Failed to truncate the journal of tree '%s' (%m).", treeRef->name);
+        }
 
-                    tdb_NodeRef_t childRef = GetNamedChild(nodeRef, stringBuffer);
+        return LE_IO_ERROR;
+    }
 
-                    if (childRef == NULL)
-                    {
-                        childRef = NewChildNode(nodeRef);
-                        if (tdb_SetNodeName(childRef, stringBuffer) != LE_OK)
-                        {
-                            LE_ERROR("Bad node name, '%s'.", stringBuffer);
-                            result = LE_FORMAT_ERROR;
-                            goto cleanup;
-                        }
+    treeRef->journalSize += recordSize;
+    return LE_OK;
+}
 
-                        LE_DEBUG("New node, %s", stringBuffer);
-                    }
 
-                    tdb_EnsureExists(childRef);
 
-                    result = InternalReadNode(childRef, filePtr, newPathLen);
 
-                    if (result != LE_OK)
-                    {
-                        goto cleanup;
-                    }
-                }
-                else if (tokenType == TT_CLOSE_GROUP)
-                {
-                    break;
-                }
-                else
-                {
-                    LE_ERROR("Unexpected token in found while looking for '}'.");
-                    result = LE_FORMAT_ERROR;
-                    goto cleanup;
-                }
-            }
-            break;
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write the changes made by a transaction to a tree's journal.
+ *
+ *  @return LE_OK if the changes are safely in the journal.
+ *          LE_NOT_PERMITTED if the file system is read-only.
+ *          LE_IO_ERROR if the changes couldn't be written.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t JournalChanges
+(
+    tdb_TreeRef_t treeRef,    ///< [IN] The (merged) tree.
+    const char* pathListPtr,  ///< [IN] NUL separated list of changed paths.
+    size_t pathListSize       ///< [IN] Size of the list.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char* recordPtr = NULL;
+    size_t recordSize = 0;
+    FILE* streamPtr = open_memstream(&recordPtr, &recordSize);
 
-        case TT_CLOSE_GROUP:
-        default:
-            LE_ERROR("Unexpected token found.");
-            result = LE_FORMAT_ERROR;
-            goto cleanup;
+    if (streamPtr == NULL)
+    {
+        LE_ERROR("Failed to create journal record (%m).");
+        return LE_IO_ERROR;
     }
 
-    if (IsShadow(nodeRef) == false)
+    // Leave room for the header, which is filled in once the contents are known.
+    JournalRecordHeader_t header = { 0 };
+    le_result_t result = WriteFile(streamPtr, &header, sizeof(header));
+
+    if (result == LE_OK)
     {
-        ClearModifiedFlag(nodeRef);
+        result = BuildJournalRecord(treeRef, pathListPtr, pathListSize, streamPtr);
     }
-    else
+
+    if (fclose(streamPtr) != 0)
     {
-        SetModifiedFlag(nodeRef);
+        result = LE_IO_ERROR;
     }
 
-    tdb_EnsureExists(nodeRef);
+    if (result == LE_OK)
+    {
+        result = AppendJournalRecord(treeRef, recordPtr, recordSize);
+    }
 
-cleanup:
-    le_mem_Release(stringBuffer);
+    free(recordPtr);
     return result;
 }
 
@@ -2391,89 +4447,80 @@ cleanup:
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Serialize a tree node and it's children to a file in the filesystem.
+ *  Apply one journal record to a tree.
  *
- *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ *  @return LE_OK if successful, LE_FORMAT_ERROR if the record couldn't be parsed.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t InternalWriteNode
+static le_result_t ApplyJournalRecord
 (
-    tdb_NodeRef_t nodeRef,  ///< [IN] The node being written.
-    FILE* filePtr           ///< [IN] The file being written to.
+    tdb_TreeRef_t treeRef,  ///< [IN] The tree.
+    FILE* filePtr,          ///< [IN] The journal, positioned at the start of the record contents.
+    long endOffset          ///< [IN] Offset of the end of the record.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If there is no node to write, or if the node is marked as having been deleted...  Then write
-    // a blank node.
-    if (   (nodeRef == NULL)
-        || (IsDeleted(nodeRef) == true))
-    {
-        return WriteFile(filePtr, "~ ", 2);
-    }
-
-    // Get the node's value as a string.
-    char* stringBuffer = le_mem_ForceAlloc(EncodedStringPool);
-    size_t stringBufferSize = TDB_MAX_ENCODED_SIZE;
+    char* pathPtr = le_mem_ForceAlloc(EncodedStringPool);
     le_result_t result = LE_OK;
 
-    tdb_GetValueAsString(nodeRef, stringBuffer, stringBufferSize, "");
-
-    // Now, depending on the type of node, write out any required format information.
-    switch (nodeRef->type)
+    while (   (result == LE_OK)
+           && (SkipWhiteSpace(filePtr) == LE_OK)
+           && (ftell(filePtr) < endOffset))
     {
-        case LE_CFG_TYPE_EMPTY:
-        case LE_CFG_TYPE_DOESNT_EXIST:
-            result = WriteFile(filePtr, "~ ", 2);
-            break;
+        int op = fgetc(filePtr);
+        TokenType_t tokenType;
 
-        case LE_CFG_TYPE_BOOL:
-            {
-                const char boolBuffer[3] = { '!', stringBuffer[0], ' ' };
-                result = WriteFile(filePtr, boolBuffer, sizeof(boolBuffer));
-            }
-            break;
-
-        case LE_CFG_TYPE_STRING:
-            result = WriteStringValue(filePtr, '\"', '\"', stringBuffer);
-            break;
-
-        case LE_CFG_TYPE_INT:
-            result = WriteStringValue(filePtr, '[', ']', stringBuffer);
+        if (   (ReadToken(filePtr, pathPtr, TDB_MAX_ENCODED_SIZE, &tokenType) != LE_OK)
+            || (tokenType != TT_STRING_VALUE)
+            || (pathPtr[0] != '/'))
+        {
+            result = LE_FORMAT_ERROR;
             break;
+        }
 
-        case LE_CFG_TYPE_FLOAT:
-            result = WriteStringValue(filePtr, '(', ')', stringBuffer);
-            break;
+        if (op == '=')
+        {
+            tdb_NodeRef_t nodeRef = WalkJournalPath(treeRef->rootNodeRef, pathPtr, true);
 
-        // Looks like this node is a collection, so write out it's child nodes now.
-        case LE_CFG_TYPE_STEM:
-            if ((result = WriteFile(filePtr, "{ ", 2)) == LE_OK)
+            if (nodeRef == NULL)
             {
-                tdb_NodeRef_t childRef = tdb_GetFirstActiveChildNode(nodeRef);
+                result = LE_FORMAT_ERROR;
+            }
+            else
+            {
+                result = InternalReadNode(nodeRef, filePtr, ComputePathLength(nodeRef));
+            }
+        }
+        else if (op == '-')
+        {
+            tdb_NodeRef_t nodeRef = WalkJournalPath(treeRef->rootNodeRef, pathPtr, false);
 
-                while (   (childRef != NULL)
-                       && (result == LE_OK))
+            // As in MergeNode(), the root node is only ever cleared.
+            if (nodeRef != NULL)
+            {
+                if (tdb_GetNodeParent(nodeRef) != NULL)
                 {
-                    tdb_GetNodeName(childRef, stringBuffer, stringBufferSize);
-                    result = WriteStringValue(filePtr, '\"', '\"', stringBuffer);
-
-                    if (result == LE_OK)
-                    {
-                        result = InternalWriteNode(childRef, filePtr);
-                    }
-
-                    childRef = tdb_GetNextActiveSiblingNode(childRef);
+                    le_mem_Release(nodeRef);
                 }
-
-                if (result == LE_OK)
+                else
                 {
-                    result = WriteFile(filePtr, "} ", 2);
+                    tdb_SetEmpty(nodeRef);
+                    ClearModifiedFlag(nodeRef);
                 }
             }
-            break;
+        }
+        else
+        {
+            result = LE_FORMAT_ERROR;
+        }
     }
 
-    le_mem_Release(stringBuffer);
+    if ((result == LE_OK) && (ftell(filePtr) != endOffset))
+    {
+        result = LE_FORMAT_ERROR;
+    }
+
+    le_mem_Release(pathPtr);
     return result;
 }
 
@@ -2482,33 +4529,39 @@ static le_result_t InternalWriteNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Calculate the number of bytes required to store a node path, including seperators and a trailing
- *  NULL.
+ *  Check a journal record's contents against its CRC.  On return, the file position is at the
+ *  end of the record.
  *
- *  @return The amount of bytes required to store the whole path string.
+ *  @return true if the contents are intact.
  */
 // -------------------------------------------------------------------------------------------------
-static size_t ComputePathLength
+static bool CheckJournalRecord
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] Compute a path for this node.
+    FILE* filePtr,                        ///< [IN] The journal, positioned after the header.
+    const JournalRecordHeader_t* hdrPtr   ///< [IN] The record's header.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    size_t pathLen = 0;
-    char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
+    uint8_t buffer[512];
+    uint32_t crc = le_crc_Crc32((uint8_t*)&hdrPtr->baseCrc,
+                                sizeof(hdrPtr->baseCrc),
+                                LE_CRC_START_CRC32);
+    size_t remaining = hdrPtr->size;
 
-    while (nodeRef != NULL)
+    while (remaining > 0)
     {
-        LE_ASSERT(tdb_GetNodeName(nodeRef, nodeName, sizeof(nodeName)) == LE_OK);
+        size_t chunkSize = (remaining < sizeof(buffer)) ? remaining : sizeof(buffer);
 
-        // Add this path segment's length to our running total, along with the required path
-        // seperator.
-        pathLen += 1 + le_utf8_NumBytes(nodeName);
-        nodeRef = tdb_GetNodeParent(nodeRef);
+        if (fread(buffer, 1, chunkSize, filePtr) != chunkSize)
+        {
+            return false;
+        }
+
+        crc = le_crc_Crc32(buffer, chunkSize, crc);
+        remaining -= chunkSize;
     }
 
-    // Don't forget to include a spot for the trailing NULL.
-    return pathLen + 1;
+    return crc == hdrPtr->crc;
 }
 
 
@@ -2516,22 +4569,105 @@ static size_t ComputePathLength
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Bump up the version id of this tree.
+ *  Apply a tree's journal to the tree loaded from its tree file.  A record that was only partly
+ *  written when the system went down (and anything after it) is discarded.  Records made on top of
+ *  any other tree file are skipped.
  */
 // -------------------------------------------------------------------------------------------------
-static void IncrementRevision
+static void ReplayJournal
 (
-    tdb_TreeRef_t treeRef  ///< [IN] Increment the revision of this tree.
+    tdb_TreeRef_t treeRef  ///< [IN] The tree.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    treeRef->revisionId++;
+    char filePath[LE_CFG_STR_LEN_BYTES] = "";
+    GetJournalPath(treeRef->name, filePath, sizeof(filePath));
 
-    if (treeRef->revisionId > 3)
+    FILE* filePtr = fopen(filePath, "r");
+
+    if (filePtr == NULL)
     {
-        treeRef->revisionId = 1;
+        LE_ERROR_IF(errno != ENOENT, "Could not open config tree journal '%s' (%m).", filePath);
+        return;
+    }
+
+    if (treeRef->revisionId == 0)
+    {
+        // There's no tree file, so this must be left over from a deleted tree.
+        fclose(filePtr);
+        DeleteTreeFile(filePath);
+        return;
+    }
+
+    // If the tree file can't be read, no record can be known to apply to it.
+    uint32_t treeFileCrc;
+    bool isTreeFileKnown = (GetTreeFileCrc(treeRef, &treeFileCrc) == LE_OK);
+
+    JournalRecordHeader_t header;
+    long goodSize = 0;
+    size_t count = 0;
+
+    while (fread(&header, sizeof(header), 1, filePtr) == 1)
+    {
+        long startOffset = goodSize + sizeof(header);
+
+        if (   (header.magic != JOURNAL_RECORD_MAGIC)
+            || (CheckJournalRecord(filePtr, &header) == false))
+        {
+            LE_WARN("Discarding incomplete record at offset %ld of '%s'.", goodSize, filePath);
+            break;
+        }
+
+        // A record written on top of another tree file is already in this one (the journal is
+        // emptied after a new tree file is written, but the system may have gone down before
+        // that), or belongs to a tree file that was lost.  Either way, skip it.
+        if (!isTreeFileKnown || (header.baseCrc != treeFileCrc))
+        {
+            LE_WARN("Skipping record at offset %ld of '%s', made on a tree file with CRC 0x%08"
+                    PRIx32 " rather than this one.",
+                    goodSize,
+                    filePath,
+                    header.baseCrc);
+        }
+        else if (   (fseek(filePtr, startOffset, SEEK_SET) != 0)
+                 || (ApplyJournalRecord(treeRef, filePtr, startOffset + header.size) != LE_OK))
+        {
+            LE_ERROR("Could not parse record at offset %ld of '%s'.", goodSize, filePath);
+            break;
+        }
+        else
+        {
+            count++;
+        }
+
+        goodSize = startOffset + header.size;
+
+        // Applying the record may have stopped short of the end of the record (on trailing white
+        // space), so make sure we're at the next one.
+        if (fseek(filePtr, goodSize, SEEK_SET) != 0)
+        {
+            break;
+        }
+    }
+
+    fseek(filePtr, 0, SEEK_END);
+
+    if (ftell(filePtr) != goodSize)
+    {
+        // Chop off the bad part, so that new records aren't appended after it.
+        if (truncate(filePath, goodSize) != 0)
+        {
+            LE_ERROR("Could not truncate config tree journal '%s' (%m).", filePath);
+        }
     }
+
+    fclose(filePtr);
+
+    treeRef->journalSize = goodSize;
+
+    LE_DEBUG("Replayed %" PRIuS " records from '%s'.", count, filePath);
 }
+#endif /* end LE_CONFIG_CFGTREE_JOURNAL */
 
 
 
@@ -2560,6 +4696,11 @@ static void LoadTree
         treeRef->rootNodeRef = NewNode();
     }
 
+#if LE_CONFIG_CFGTREE_BINARY
+    // Set if the tree was loaded from a text tree file, so should be rewritten in binary.
+    bool isText = false;
+#endif
+
     // Ok, if we found a valid revision of the tree in the fs, try to load it now.
     if (treeRef->revisionId != 0)
     {
@@ -2582,16 +4723,62 @@ static void LoadTree
         }
         else
         {
+#if LE_CONFIG_CFGTREE_BINARY
+            uint32_t magic = 0;
+
+            if (   (fread(&magic, sizeof(magic), 1, fileRef) == 1)
+                && (magic == SNAPSHOT_MAGIC))
+            {
+                if (LoadTreeSnapshot(treeRef->rootNodeRef, fileRef) != LE_OK)
+                {
+                    LE_ERROR("Could not load binary configuration tree file: %s.", pathPtr);
+                    le_mem_Release(treeRef->rootNodeRef);
+                    treeRef->rootNodeRef = NewNode();
+                }
+            }
+            else
+            {
+                rewind(fileRef);
+                isText = true;
+#endif
             if (tdb_ReadTreeNode(treeRef->rootNodeRef, fileRef) == false)
             {
                 LE_ERROR("Could not parse configuration tree file: %s.", pathPtr);
                 le_mem_Release(treeRef->rootNodeRef);
                 treeRef->rootNodeRef = NewNode();
+#if LE_CONFIG_CFGTREE_BINARY
+                isText = false;
+#endif
+            }
+#if LE_CONFIG_CFGTREE_BINARY
             }
+#endif
 
             fclose(fileRef);
         }
     }
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+    // Bring the tree up to date with any changes made since the tree file was written.
+    ReplayJournal(treeRef);
+#endif
+
+#if LE_CONFIG_CFGTREE_BINARY
+    // Convert text tree files (e.g., from an older system or an import) to binary the first time
+    // they're loaded.
+    if (isText)
+    {
+        LE_INFO("Converting configuration tree '%s' to the binary format.", treeRef->name);
+
+        if (WriteTreeFile(treeRef) == LE_OK)
+        {
+#if LE_CONFIG_CFGTREE_JOURNAL
+            // The journal's changes are in the new tree file now.
+            ResetJournal(treeRef);
+#endif
+        }
+    }
+#endif
 }
 
 
@@ -2682,28 +4869,6 @@ static bool OnHandlerRegistrationCleanup
 
 
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Call this function to delete a tree file from the filesystem.
- */
-// -------------------------------------------------------------------------------------------------
-static void DeleteTreeFile
-(
-    const char* filePathPtr  ///< Path to the tree file in question.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    LE_DEBUG("** Deleting tree file, '%s'.", filePathPtr);
-
-    if (unlink(filePathPtr) != 0)
-    {
-        LE_ERROR("File delete failure, '%s', reason '%m'.", filePathPtr);
-    }
-}
-
-
-
-
 // -------------------------------------------------------------------------------------------------
 /**
  *  Find the root node represented by the path ref.
@@ -2754,6 +4919,15 @@ void tdb_Init
     le_mem_SetDestructor(NodePoolRef, NodeDestructor);
     le_mem_SetNumObjsToForce(NodePoolRef, 50);    // Grow in chunks of 50 blocks.
 
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    ChildIndexPoolRef = le_mem_CreatePool("childIndex", sizeof(ChildIndex_t));
+#endif
+
+#if LE_CONFIG_CFGTREE_BINARY
+    SnapshotPoolRef = le_mem_CreatePool("snapshot", sizeof(Snapshot_t));
+    le_mem_SetDestructor(SnapshotPoolRef, SnapshotDestructor);
+#endif
+
     TreePoolRef = le_mem_InitStaticPool(treePool, LE_CONFIG_CFGTREE_MAX_TREE_POOL_SIZE,
                                         sizeof(Tree_t));
     le_mem_SetDestructor(TreePoolRef, TreeDestructor);
@@ -2860,6 +5034,16 @@ void tdb_DeleteTree
             }
         }
 
+#if LE_CONFIG_CFGTREE_JOURNAL
+        char journalPath[LE_CFG_STR_LEN_BYTES] = "";
+        GetJournalPath(treeRef->name, journalPath, sizeof(journalPath));
+
+        if (access(journalPath, F_OK) == 0)
+        {
+            DeleteTreeFile(journalPath);
+        }
+#endif
+
         LE_ASSERT(le_hashmap_Remove(TreeCollectionRef, treeRef->name) == treeRef);
         le_mem_Release(treeRef);
     }
@@ -3130,69 +5314,79 @@ void tdb_MergeTree
 )
 // -------------------------------------------------------------------------------------------------
 {
+    tdb_TreeRef_t originalTreeRef = shadowTreeRef->originalTreeRef;
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+    // Note which nodes are being changed before the merge, because after it there is no way to
+    // tell what was deleted or renamed.
+    char* pathListPtr = NULL;
+    size_t pathListSize = 0;
+    FILE* pathListStreamPtr = open_memstream(&pathListPtr, &pathListSize);
+
+    if (pathListStreamPtr != NULL)
+    {
+        char pathBuffer[CFG_MAX_PATH_SIZE] = "";
+
+        FindChangedPaths(shadowTreeRef->rootNodeRef, pathBuffer, 0, pathListStreamPtr);
+
+        if (fclose(pathListStreamPtr) != 0)
+        {
+            free(pathListPtr);
+            pathListPtr = NULL;
+        }
+    }
+#endif
+
     // Get our shadow tree's root node and merge it's changes into the real tree.  Create a path
     // iterator to track the merge and allow for update handlers to be called.
     tdb_NodeRef_t nodeRef = shadowTreeRef->rootNodeRef;
-    le_pathIter_Ref_t pathRef = CreateBasePath(shadowTreeRef->originalTreeRef->name);
+    le_pathIter_Ref_t pathRef = CreateBasePath(originalTreeRef->name);
 
-    InternalMergeTree(shadowTreeRef->originalTreeRef->name, pathRef, nodeRef, false);
+    InternalMergeTree(originalTreeRef->name, pathRef, nodeRef, false);
     le_pathIter_Delete(pathRef);
 
     // Now, go through and call the triggered callbacks.
     FireTriggeredCallbacks();
 
-    // Now increment revision of the tree and open a tree file for writing.
-    tdb_TreeRef_t originalTreeRef = shadowTreeRef->originalTreeRef;
-    int oldId = originalTreeRef->revisionId;
-
-    IncrementRevision(originalTreeRef);
-
-    char filePath[LE_CFG_STR_LEN_BYTES] = "";
-    GetTreePath(originalTreeRef->name, originalTreeRef->revisionId, filePath, sizeof(filePath));
-
-    LE_DEBUG("Changes merged, now attempting to serialize the tree to '%s'.", filePath);
-
-    FILE* filePtr = NULL;
-
-    filePtr = fopen(filePath, "w+");
-
-    if (!filePtr && (EROFS == errno))
-    {
-        // In case we are R/O for the config tree, we discard the update to flash
-        return;
-    }
-
-    if (!filePtr)
+#if LE_CONFIG_CFGTREE_JOURNAL
+    // If the tree has already been written to a tree file, only the changes need to be written to
+    // its journal.  Otherwise, or if the journal can't be written to, fall back to writing the
+    // whole tree.
+    if (   (pathListPtr != NULL)
+        && (originalTreeRef->revisionId != 0))
     {
-        LE_EMERG("Failed to open config file '%s' (%m).", filePath);
-        LE_EMERG("Changes have been merged in memory, however they could not be committed to the "
-                 "filesystem!!");
-        return;
-    }
+        le_result_t result = LE_OK;
 
-    // We have a tree file to write to, so stream the new tree to it then close the output file.
-    le_result_t writeResult = tdb_WriteTreeNode(originalTreeRef->rootNodeRef, filePtr);
+        if (pathListSize > 0)
+        {
+            result = JournalChanges(originalTreeRef, pathListPtr, pathListSize);
+        }
 
-    int retVal = fclose(filePtr);
-    LE_EMERG_IF(retVal == EOF,
-                "An error occurred while closing the tree file: %s", LE_ERRNO_TXT(errno));
+        free(pathListPtr);
 
-    // Finally remove the old version of the tree file, if there is one.
-    if (writeResult == LE_OK)
-    {
-        if (   (oldId != 0)
-            && (TreeFileExists(originalTreeRef->name, oldId)))
+        if (result == LE_OK)
         {
-            GetTreePath(originalTreeRef->name, oldId, filePath, sizeof(filePath));
-            DeleteTreeFile(filePath);
+            ScheduleCompaction(originalTreeRef);
+            return;
+        }
+        else if (result == LE_NOT_PERMITTED)
+        {
+            // In case we are R/O for the config tree, we discard the update to flash
+            return;
         }
     }
     else
     {
-        // The write failed, delete the new file we attempted to create.
-        LE_EMERG("The attempt to write to the config tree file, '%s,' failed.", filePath);
-        DeleteTreeFile(filePath);
+        free(pathListPtr);
     }
+
+    if (WriteTreeFile(originalTreeRef) == LE_OK)
+    {
+        ResetJournal(originalTreeRef);
+    }
+#else
+    WriteTreeFile(originalTreeRef);
+#endif
 }
 
 
@@ -3561,6 +5755,8 @@ le_result_t tdb_SetNodeName
 
     // Copy over the new name.  Note that we don't care if this node is a shadow node.  Coping over
     // the name is taken care of as part of the merge process.
+    UnindexChild(nodeRef);
+
     if (nodeRef->nameRef == NULL)
     {
         nodeRef->nameRef = dstr_NewFromCstr(stringPtr);
@@ -3571,6 +5767,8 @@ le_result_t tdb_SetNodeName
     }
     nodeRef->nameHash = le_hashmap_HashString(stringPtr);
 
+    IndexChild(nodeRef);
+
     // If this is a shadow node and this is the change that modified it, then try to get it's
     // children now.  This is done so that later when this node is merged the merge code doesn't end
     // up thinking that the child nodes where removed.
@@ -3684,6 +5882,11 @@ void tdb_SetEmpty
         return;
     }
 
+#if LE_CONFIG_CFGTREE_BINARY
+    // Don't load children from the tree file just to throw them away.
+    DropSnapshotChildren(nodeRef);
+#endif
+
     le_cfg_nodeType_t type = tdb_GetNodeType(nodeRef);
 
     // If the node is already empty then there isn't much left to do.
@@ -3696,6 +5899,10 @@ void tdb_SetEmpty
     // If this is a stem node, then go through and clear out the children.
     if (nodeRef->type == LE_CFG_TYPE_STEM)
     {
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+        DropChildIndex(nodeRef);
+#endif
+
         tdb_NodeRef_t childRef = tdb_GetFirstChildNode(nodeRef);
 
         while (childRef != NULL)
@@ -3805,6 +6012,10 @@ tdb_NodeRef_t tdb_GetFirstChildNode
 {
     LE_ASSERT(nodeRef != NULL);
 
+#if LE_CONFIG_CFGTREE_BINARY
+    LoadSnapshotChildren(nodeRef);
+#endif
+
     // Is this the type of node that has children?
     if (   (   (nodeRef->type != LE_CFG_TYPE_STEM)
             || (le_dls_IsEmpty(&nodeRef->info.children) == true))
@@ -71,6 +71,11 @@
 #include "linux/logPlatform.h"
 #include "log.h"
 
+#if LE_CONFIG_LOG_BINARY
+#   include "linux/logBinary.h"
+#   include "linux/logFormat.h"
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum number of processes that we expect to see.  Used to set the hashmap and pool sizes.
@@ -225,10 +230,11 @@ typedef struct
     pid_t               pid;            ///< The process ID.
     le_msg_SessionRef_t ipcSessionRef;  ///< Reference to the IPC session connected to this process.
     le_dls_List_t       logSessionList; ///< List of log sessions in this process.
-/* TODO: Implement shared memory.
-    void*               sharedMemAddr;  ///< Address of base of memory region shared with
-                                        ///  this process.
- */
+#if LE_CONFIG_LOG_BINARY
+    logBinary_Reader_t  binReader;      ///< Reader for the process's binary log ring (if any).
+    const char*         binProcNamePtr; ///< Interned process name, for the binary log history.
+    le_sls_List_t       binStringList;  ///< Binary log string IDs defined by this process.
+#endif
 }
 RunningProcess_t;
 
@@ -329,6 +335,138 @@ FdLog_t;
 static le_mem_PoolRef_t FdLogPoolRef;
 
 
+#if LE_CONFIG_LOG_BINARY
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of distinct strings (process names, component names, file names, format strings,
+ * etc.) kept for the binary log history.  These are never forgotten, because entries in the
+ * history may refer to them.  Once the limit is reached, new strings are shown as "?".
+ **/
+//--------------------------------------------------------------------------------------------------
+#define MAX_INTERNED_STRINGS        4096
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sizes of the blocks in the interned string pools.  Most strings are short, so they come from
+ * the smaller reduced pools.
+ **/
+//--------------------------------------------------------------------------------------------------
+#define INTERNED_STRING_BYTES       LOG_BINARY_MAX_STRING_BYTES
+#define INTERNED_STRING_MED_BYTES   64
+#define INTERNED_STRING_SMALL_BYTES 24
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pools from which interned strings are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t InternedStringPoolRef;
+static le_mem_PoolRef_t InternedStringMedPoolRef;
+static le_mem_PoolRef_t InternedStringSmallPoolRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash map of interned strings, keyed by string.  The value is the same as the key.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t InternedStringMapRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key of a Binary String object.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    pid_t       pid;    ///< Process that defined the string ID.
+    uint32_t    id;     ///< String ID.
+}
+BinStringKey_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A string ID defined by a process in its binary log ring.  These objects are kept in the Binary
+ * String Map and on their Running Process object's list of binary strings.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t   link;   ///< Link in the Running Process's list of binary strings.
+    BinStringKey_t  key;    ///< Process ID and string ID.
+    const char*     strPtr; ///< Interned string.
+}
+BinString_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which Binary String objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t BinStringPoolRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash map of Binary String objects, keyed by BinStringKey_t.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t BinStringMapRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An entry in the binary log history.  Followed by the thread name (including its terminator),
+ * then dataSize bytes of captured arguments or, if formatPtr is NULL, the formatted message.
+ *
+ * All the strings pointed to are interned (or literals), so they outlive the entry.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t        size;           ///< Size of the entry, including what follows it.
+    bool            isPad;          ///< true if this just fills the end of the history buffer.
+    pid_t           pid;            ///< Process ID.
+    le_log_Level_t  level;          ///< Severity level (not used for traces).
+    int             savedErrno;     ///< errno at the time of logging, for "%m".
+    unsigned int    lineNumber;     ///< Source line number.
+    uint64_t        timestamp;      ///< Wall clock time of logging (ns since the epoch).
+    const char*     procNamePtr;    ///< Process name.
+    const char*     compNamePtr;    ///< Component name.
+    const char*     keywordPtr;     ///< Trace keyword, or NULL if not a trace.
+    const char*     fileNamePtr;    ///< Source file name.
+    const char*     funcNamePtr;    ///< Function name, or NULL.
+    const char*     formatPtr;      ///< Format string, or NULL if the message is already formatted.
+    uint16_t        threadNameSize; ///< Size of the thread name, including its terminator.
+    uint16_t        dataSize;       ///< Size of the captured arguments or message.
+}
+HistoryEntry_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the binary log history buffer.  Entries are always a multiple of 8 bytes long.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HISTORY_SIZE    ((size_t)LE_CONFIG_LOG_BINARY_HISTORY_SIZE & ~(size_t)7)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The binary log history: the most recent messages collected from the processes' rings, oldest
+ * first, starting at HistoryTail and ending at HistoryHead (positions in bytes, modulo
+ * HISTORY_SIZE).  An entry never straddles the end of the buffer; a pad entry fills the space
+ * instead.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t History[HISTORY_SIZE] __attribute__((aligned(8)));
+static uint64_t HistoryHead;
+static uint64_t HistoryTail;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer used to periodically collect records from the processes' binary log rings.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t BinaryDrainTimerRef;
+#endif /* end LE_CONFIG_LOG_BINARY */
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum length of log messages.
@@ -733,7 +871,11 @@ static RunningProcess_t* CreateRunningProcess
 
     objPtr->pid = pid;
     objPtr->ipcSessionRef = ipcSessionRef;
-//    objPtr->sharedMemAddr = NULL;   // TODO: Implement shared memory.
+#if LE_CONFIG_LOG_BINARY
+    objPtr->binReader.hdrPtr = NULL;
+    objPtr->binProcNamePtr = NULL;
+    objPtr->binStringList = LE_SLS_LIST_INIT;
+#endif
 
     le_hashmap_Put(ProcessIdMapRef, &objPtr->pid, objPtr);
     le_hashmap_Put(IpcSessionMapRef, &objPtr->ipcSessionRef, objPtr);
@@ -954,8 +1096,10 @@ static bool ParseCmdPacket
     }
     packetPtr++;
 
-    // The "list" command has no parameters.
-    if (commandCode == LOG_CMD_LIST_COMPONENTS)
+    // The "list", "dump" and binary ring commands have no parameters.
+    if (   (commandCode == LOG_CMD_LIST_COMPONENTS)
+        || (commandCode == LOG_CMD_DUMP)
+        || (commandCode == LOG_CMD_BINARY_RING) )
     {
         return true;
     }
@@ -1447,6 +1591,632 @@ static void RegComponent
 }
 
 
+#if LE_CONFIG_LOG_BINARY
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash computation function for Binary String keys.
+ *
+ * @return  The hash value computed from a BinStringKey_t.
+ **/
+//--------------------------------------------------------------------------------------------------
+static size_t BinStringHash
+(
+    const void* hashKeyPtr
+)
+{
+    const BinStringKey_t* keyPtr = hashKeyPtr;
+
+    return ((size_t)keyPtr->pid * 65599) ^ keyPtr->id;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Equality comparison function for Binary String keys.
+ *
+ * @return  true = the two keys are the same.
+ **/
+//--------------------------------------------------------------------------------------------------
+static bool BinStringEquals
+(
+    const void* hashKey1Ptr,
+    const void* hashKey2Ptr
+)
+{
+    const BinStringKey_t* key1Ptr = hashKey1Ptr;
+    const BinStringKey_t* key2Ptr = hashKey2Ptr;
+
+    return (key1Ptr->pid == key2Ptr->pid) && (key1Ptr->id == key2Ptr->id);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the one copy of a string that is kept for the binary log history, creating it if needed.
+ * Strings longer than INTERNED_STRING_BYTES are truncated.
+ *
+ * @return  The interned string, or "?" if there are too many strings already.
+ **/
+//--------------------------------------------------------------------------------------------------
+static const char* InternString
+(
+    const char* strPtr
+)
+{
+    char buffer[INTERNED_STRING_BYTES];
+
+    // Truncate long strings first, so that the lookup finds them.
+    le_utf8_Copy(buffer, strPtr, sizeof(buffer), NULL);
+
+    const char* internedPtr = le_hashmap_Get(InternedStringMapRef, buffer);
+
+    if (internedPtr == NULL)
+    {
+        if (le_hashmap_Size(InternedStringMapRef) >= MAX_INTERNED_STRINGS)
+        {
+            return "?";
+        }
+
+        char* copyPtr = le_mem_StrDup(InternedStringSmallPoolRef, buffer);
+        le_hashmap_Put(InternedStringMapRef, copyPtr, copyPtr);
+        internedPtr = copyPtr;
+    }
+
+    return internedPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up a string ID defined by a process in its binary log ring.
+ *
+ * @return  The interned string, NULL for LOG_BINARY_NO_STRING, or "?" if the ID is unknown.
+ **/
+//--------------------------------------------------------------------------------------------------
+static const char* LookUpBinString
+(
+    const RunningProcess_t* procPtr,
+    uint16_t id
+)
+{
+    if (id == LOG_BINARY_NO_STRING)
+    {
+        return NULL;
+    }
+
+    BinStringKey_t key = { .pid = procPtr->pid, .id = id };
+    const BinString_t* binStringPtr = le_hashmap_Get(BinStringMapRef, &key);
+
+    return (binStringPtr != NULL) ? binStringPtr->strPtr : "?";
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record a string ID defined by a process in its binary log ring.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void DefineBinString
+(
+    RunningProcess_t* procPtr,
+    uint16_t id,
+    const char* strPtr
+)
+{
+    BinStringKey_t key = { .pid = procPtr->pid, .id = id };
+    BinString_t* binStringPtr = le_hashmap_Get(BinStringMapRef, &key);
+
+    if (binStringPtr == NULL)
+    {
+        binStringPtr = le_mem_ForceAlloc(BinStringPoolRef);
+        binStringPtr->link = LE_SLS_LINK_INIT;
+        binStringPtr->key = key;
+        le_sls_Stack(&procPtr->binStringList, &binStringPtr->link);
+        le_hashmap_Put(BinStringMapRef, &binStringPtr->key, binStringPtr);
+    }
+
+    binStringPtr->strPtr = InternString(strPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append an entry to the binary log history, discarding the oldest entries to make room for it.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void AddHistoryEntry
+(
+    const HistoryEntry_t* entryPtr,     ///< [IN] Entry.  The size and isPad fields are ignored.
+    const char* threadNamePtr,          ///< [IN] Thread name (entryPtr->threadNameSize bytes).
+    const void* dataPtr                 ///< [IN] Data (entryPtr->dataSize bytes).
+)
+{
+    size_t size = (sizeof(*entryPtr) + entryPtr->threadNameSize + entryPtr->dataSize + 7) & ~7;
+    size_t offset;
+    size_t padSize;
+
+    if (size > HISTORY_SIZE)
+    {
+        return;
+    }
+
+    for (;;)
+    {
+        if (HistoryHead == HistoryTail)
+        {
+            HistoryHead = HistoryTail = 0;
+        }
+
+        offset = HistoryHead % HISTORY_SIZE;
+        padSize = (offset + size > HISTORY_SIZE) ? (HISTORY_SIZE - offset) : 0;
+
+        if (HistoryHead + padSize + size - HistoryTail <= HISTORY_SIZE)
+        {
+            break;
+        }
+
+        // Discard the oldest entry.
+        HistoryTail += ((HistoryEntry_t*)&History[HistoryTail % HISTORY_SIZE])->size;
+    }
+
+    if (padSize > 0)
+    {
+        HistoryEntry_t* padPtr = (HistoryEntry_t*)&History[offset];
+
+        padPtr->size = padSize;
+        padPtr->isPad = true;
+        HistoryHead += padSize;
+        offset = 0;
+    }
+
+    HistoryEntry_t* newEntryPtr = (HistoryEntry_t*)&History[offset];
+    uint8_t* bytePtr = (uint8_t*)(newEntryPtr + 1);
+
+    *newEntryPtr = *entryPtr;
+    newEntryPtr->size = size;
+    newEntryPtr->isPad = false;
+    memcpy(bytePtr, threadNamePtr, entryPtr->threadNameSize);
+    memcpy(bytePtr + entryPtr->threadNameSize, dataPtr, entryPtr->dataSize);
+
+    HistoryHead += size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a warning to the binary log history that a process dropped some messages.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void AddDropNotice
+(
+    const RunningProcess_t* procPtr,
+    uint32_t numDropped
+)
+{
+    char msg[64];
+    struct timespec now = { 0 };
+    HistoryEntry_t entry = { 0 };
+
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    entry.pid = procPtr->pid;
+    entry.level = LE_LOG_WARN;
+    entry.lineNumber = __LINE__;
+    entry.timestamp = (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+    entry.procNamePtr = procPtr->binProcNamePtr;
+    entry.compNamePtr = "logDaemon";
+    entry.fileNamePtr = "logDaemon.c";
+    entry.funcNamePtr = __func__;
+    entry.threadNameSize = sizeof("");
+    entry.dataSize = snprintf(msg, sizeof(msg), "%" PRIu32 " log messages dropped.", numDropped)
+                     + 1;
+
+    AddHistoryEntry(&entry, "", msg);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handle a record read from a process's binary log ring.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void HandleBinaryRecord
+(
+    const logBinary_RecordHeader_t* recPtr, ///< [IN] The record (already checked).
+    void*                           contextPtr  ///< [IN] Running Process object.
+)
+{
+    RunningProcess_t* procPtr = contextPtr;
+
+    if (recPtr->type == LOG_BINARY_REC_STRING)
+    {
+        DefineBinString(procPtr, recPtr->id, (const char*)(recPtr + 1));
+    }
+    else if (recPtr->type == LOG_BINARY_REC_MSG)
+    {
+        const logBinary_MsgRecord_t* msgPtr = (const logBinary_MsgRecord_t*)recPtr;
+        const char* threadNamePtr = (const char*)(msgPtr + 1);
+        HistoryEntry_t entry = { 0 };
+
+        entry.pid = procPtr->pid;
+        entry.level = msgPtr->level;
+        entry.savedErrno = msgPtr->savedErrno;
+        entry.lineNumber = msgPtr->lineNumber;
+        entry.timestamp = msgPtr->timestamp;
+        entry.procNamePtr = procPtr->binProcNamePtr;
+        entry.compNamePtr = LookUpBinString(procPtr, msgPtr->compId);
+        entry.keywordPtr = LookUpBinString(procPtr, msgPtr->keywordId);
+        entry.fileNamePtr = LookUpBinString(procPtr, msgPtr->fileId);
+        entry.funcNamePtr = LookUpBinString(procPtr, msgPtr->funcId);
+        entry.formatPtr = LookUpBinString(procPtr, msgPtr->formatId);
+        entry.threadNameSize = msgPtr->threadNameSize;
+        entry.dataSize = msgPtr->dataSize;
+
+        if (entry.compNamePtr == NULL)
+        {
+            entry.compNamePtr = "?";
+        }
+        if (entry.fileNamePtr == NULL)
+        {
+            entry.fileNamePtr = "?";
+        }
+
+        AddHistoryEntry(&entry, threadNamePtr, threadNamePtr + msgPtr->threadNameSize);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Collect all the records from a process's binary log ring.  If the ring turns out to be
+ * corrupted, it is closed.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void DrainBinaryRing
+(
+    RunningProcess_t* procPtr
+)
+{
+    uint32_t numDropped = 0;
+
+    if (procPtr->binReader.hdrPtr == NULL)
+    {
+        return;
+    }
+
+    le_result_t result = logBinary_Read(&procPtr->binReader,
+                                        HandleBinaryRecord,
+                                        procPtr,
+                                        &numDropped);
+    if (numDropped > 0)
+    {
+        AddDropNotice(procPtr, numDropped);
+    }
+
+    if (result != LE_OK)
+    {
+        LE_ERROR("Binary log ring of process '%s' (pid %d) is corrupted.  Closing it.",
+                 procPtr->binProcNamePtr,
+                 procPtr->pid);
+        logBinary_CloseReader(&procPtr->binReader);
+        procPtr->binReader.hdrPtr = NULL;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Collect the records from all the processes' binary log rings.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void DrainAllBinaryRings
+(
+    void
+)
+{
+    le_hashmap_It_Ref_t iterRef = le_hashmap_GetIterator(ProcessIdMapRef);
+
+    while (le_hashmap_NextNode(iterRef) == LE_OK)
+    {
+        DrainBinaryRing((RunningProcess_t*)le_hashmap_GetValue(iterRef));
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Called periodically to collect records from the processes' binary log rings.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void BinaryDrainTimerExpired
+(
+    le_timer_Ref_t timerRef
+)
+{
+    LE_UNUSED(timerRef);
+
+    DrainAllBinaryRings();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start collecting records from a process's binary log ring.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_DUPLICATE if the process already has a ring.
+ *      LE_FORMAT_ERROR or LE_FAULT if the ring couldn't be opened.
+ **/
+//--------------------------------------------------------------------------------------------------
+static le_result_t OpenBinaryRing
+(
+    RunningProcess_t* procPtr,
+    int fd
+)
+{
+    if (procPtr->binReader.hdrPtr != NULL)
+    {
+        return LE_DUPLICATE;
+    }
+
+    le_result_t result = logBinary_OpenReader(&procPtr->binReader, fd);
+
+    if (result != LE_OK)
+    {
+        procPtr->binReader.hdrPtr = NULL;
+        return result;
+    }
+
+    procPtr->binProcNamePtr = InternString(procPtr->procNameObjPtr->name);
+
+    if (!le_timer_IsRunning(BinaryDrainTimerRef))
+    {
+        le_timer_Start(BinaryDrainTimerRef);
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Collect any remaining records from a process's binary log ring, then close the ring and forget
+ * the string IDs that the process defined.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void CloseBinaryRing
+(
+    RunningProcess_t* procPtr
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    DrainBinaryRing(procPtr);
+
+    if (procPtr->binReader.hdrPtr != NULL)
+    {
+        logBinary_CloseReader(&procPtr->binReader);
+        procPtr->binReader.hdrPtr = NULL;
+    }
+
+    while ((linkPtr = le_sls_Pop(&procPtr->binStringList)) != NULL)
+    {
+        BinString_t* binStringPtr = CONTAINER_OF(linkPtr, BinString_t, link);
+
+        le_hashmap_Remove(BinStringMapRef, &binStringPtr->key);
+        le_mem_Release(binStringPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handle a request from a client process to collect its log messages from a binary log ring.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void RegBinaryRing
+(
+    le_msg_MessageRef_t msgRef      ///< [IN] Request message, with the ring's fd attached.
+)
+{
+    int fd = le_msg_GetFd(msgRef);
+    char* payloadPtr = le_msg_GetPayloadPtr(msgRef);
+    RunningProcess_t* procPtr = FindProcessByIpcSession(le_msg_GetSession(msgRef));
+    le_result_t result = LE_FAULT;
+
+    if (fd < 0)
+    {
+        LE_ERROR("No binary log ring attached to request.");
+    }
+    else if (procPtr == NULL)
+    {
+        LE_ERROR("Binary log ring received from a process with no log sessions.");
+    }
+    else
+    {
+        result = OpenBinaryRing(procPtr, fd);
+
+        LE_ERROR_IF(result != LE_OK,
+                    "Failed to open binary log ring of process '%s' (pid %d) (%s).",
+                    procPtr->procNameObjPtr->name,
+                    procPtr->pid,
+                    LE_RESULT_TXT(result));
+    }
+
+    if (fd >= 0)
+    {
+        fd_Close(fd);
+    }
+
+    // An empty response payload means the ring was accepted.
+    payloadPtr[0] = (result == LE_OK) ? '\0' : '*';
+    payloadPtr[1] = '\0';
+
+    le_msg_Respond(msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Format the timestamp of a binary log history entry, in the same style as the text log.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void FormatTimestamp
+(
+    uint64_t timestamp,     ///< [IN] ns since the epoch.
+    char* bufferPtr,        ///< [OUT] Buffer.
+    size_t bufferSize       ///< [IN] Size of the buffer.
+)
+{
+    time_t seconds = (time_t)(timestamp / 1000000000);
+    unsigned int ms = (unsigned int)((timestamp % 1000000000) / 1000000);
+    struct tm brokenDown;
+    size_t len = 0;
+
+    if (localtime_r(&seconds, &brokenDown) != NULL)
+    {
+        len = strftime(bufferPtr, bufferSize, "%b %e %H:%M:%S", &brokenDown);
+    }
+
+    snprintf(bufferPtr + len, bufferSize - len, ".%03u", ms);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Render a binary log history entry as a line of text.
+ *
+ * @return  The length of the line.
+ **/
+//--------------------------------------------------------------------------------------------------
+static size_t RenderHistoryEntry
+(
+    const HistoryEntry_t* entryPtr, ///< [IN] Entry.
+    char* linePtr,                  ///< [OUT] Buffer for the line.
+    size_t lineSize                 ///< [IN] Size of the buffer.
+)
+{
+    const char* threadNamePtr = (const char*)(entryPtr + 1);
+    const uint8_t* dataPtr = (const uint8_t*)threadNamePtr + entryPtr->threadNameSize;
+    char msg[MAX_MSG_SIZE + LOG_BINARY_MAX_DATA_BYTES];
+    char timeStamp[32];
+    const char* levelPtr = entryPtr->keywordPtr;
+    int len;
+
+    if (levelPtr == NULL)
+    {
+        levelPtr = ((entryPtr->level >= LE_LOG_DEBUG) && (entryPtr->level <= LE_LOG_EMERG)) ?
+                   log_GetSeverityStr(entryPtr->level) : " ??? ";
+    }
+
+    if (entryPtr->formatPtr != NULL)
+    {
+        logFormat_FormatArgs(entryPtr->formatPtr, dataPtr, entryPtr->dataSize,
+                             entryPtr->savedErrno, msg, sizeof(msg));
+    }
+    else
+    {
+        snprintf(msg, sizeof(msg), "%.*s", (int)entryPtr->dataSize, (const char*)dataPtr);
+    }
+
+    FormatTimestamp(entryPtr->timestamp, timeStamp, sizeof(timeStamp));
+
+    if (entryPtr->funcNamePtr == NULL)
+    {
+        len = snprintf(linePtr, lineSize, "%s : %s | %s[%d]/%s T=%s | %s %u | %s\n",
+                       timeStamp, levelPtr, entryPtr->procNamePtr, entryPtr->pid,
+                       entryPtr->compNamePtr, threadNamePtr, entryPtr->fileNamePtr,
+                       entryPtr->lineNumber, msg);
+    }
+    else
+    {
+        len = snprintf(linePtr, lineSize, "%s : %s | %s[%d]/%s T=%s | %s %s() %u | %s\n",
+                       timeStamp, levelPtr, entryPtr->procNamePtr, entryPtr->pid,
+                       entryPtr->compNamePtr, threadNamePtr, entryPtr->fileNamePtr,
+                       entryPtr->funcNamePtr, entryPtr->lineNumber, msg);
+    }
+
+    if (len < 0)
+    {
+        return 0;
+    }
+
+    return ((size_t)len < lineSize) ? (size_t)len : (lineSize - 1);
+}
+#endif /* end LE_CONFIG_LOG_BINARY */
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dump the binary log history to the log control tool, as text in a file whose descriptor is
+ * attached to the response.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void DumpHistory
+(
+    le_msg_SessionRef_t toolIpcSessionRef
+)
+{
+#if LE_CONFIG_LOG_BINARY
+    char buffer[4096];
+    size_t used = 0;
+    uint64_t pos;
+
+    // Get the latest messages first.
+    DrainAllBinaryRings();
+
+    int fd = fd_CreateAnonymous("logDump");
+
+    if (fd < 0)
+    {
+        SendToLogTool(toolIpcSessionRef, "***ERROR: Couldn't create the log dump file.");
+        return;
+    }
+
+    for (pos = HistoryTail; pos != HistoryHead; )
+    {
+        const HistoryEntry_t* entryPtr = (const HistoryEntry_t*)&History[pos % HISTORY_SIZE];
+
+        pos += entryPtr->size;
+
+        if (entryPtr->isPad)
+        {
+            continue;
+        }
+
+        if (sizeof(buffer) - used < MAX_MSG_SIZE * 4)
+        {
+            if (fd_WriteSize(fd, buffer, used) != (ssize_t)used)
+            {
+                break;
+            }
+            used = 0;
+        }
+
+        used += RenderHistoryEntry(entryPtr, buffer + used, sizeof(buffer) - used);
+    }
+
+    if (   ((used > 0) && (fd_WriteSize(fd, buffer, used) != (ssize_t)used))
+        || (lseek(fd, 0, SEEK_SET) != 0) )
+    {
+        LE_ERROR("Failed to write log dump file.  %m.");
+        fd_Close(fd);
+        SendToLogTool(toolIpcSessionRef, "***ERROR: Couldn't write the log dump file.");
+        return;
+    }
+
+    // The file goes with an empty payload.
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(toolIpcSessionRef);
+    *((char*)le_msg_GetPayloadPtr(msgRef)) = '\0';
+    le_msg_SetFd(msgRef, fd);
+    le_msg_Send(msgRef);
+#else
+    SendToLogTool(toolIpcSessionRef, "***ERROR: Binary logging is not enabled.");
+#endif
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Handle the closing of a client IPC session, which signals the death of a process.
@@ -1477,6 +2247,11 @@ static void ClientIpcSessionClosed
              procNameObjPtr->name,
              runningProcObjPtr->pid);
 
+#if LE_CONFIG_LOG_BINARY
+    // Collect whatever the process managed to log before it went away.
+    CloseBinaryRing(runningProcObjPtr);
+#endif
+
     // Remove the process from the PID and IPC Session hash maps.
     le_hashmap_Remove(ProcessIdMapRef, &runningProcObjPtr->pid);
     le_hashmap_Remove(IpcSessionMapRef, &ipcSessionRef);
@@ -2494,11 +3269,20 @@ static void ClientMsgReceiveHandler
 
                 return;
 
+#if LE_CONFIG_LOG_BINARY
+            case LOG_CMD_BINARY_RING:
+
+                RegBinaryRing(msgRef);
+
+                return;
+#endif
+
             case LOG_CMD_SET_LEVEL:
             case LOG_CMD_ENABLE_TRACE:
             case LOG_CMD_DISABLE_TRACE:
             case LOG_CMD_LIST_COMPONENTS:
             case LOG_CMD_FORGET_PROCESS:
+            case LOG_CMD_DUMP:
 
                 LE_ERROR("Client attempted to issue a log control command (%c)!", command);
 
@@ -2586,6 +3370,12 @@ static void ControlToolMsgReceiveHandler
 
                 break;
 
+            case LOG_CMD_DUMP:
+
+                DumpHistory(ipcSessionRef);
+
+                break;
+
             default:
 
                 LE_ERROR("Unknown command byte '%c' received from log control tool.", command);
@@ -2815,6 +3605,32 @@ COMPONENT_INIT
     le_mem_ExpandPool(TracePoolRef, MAX_EXPECTED_TRACES);
     le_mem_ExpandPool(FdLogPoolRef, MAX_EXPECTED_PROCESSES * 2); // Generally 2 fds per process (stderr, stdout).
 
+#if LE_CONFIG_LOG_BINARY
+    InternedStringPoolRef = le_mem_CreatePool("InternedString", INTERNED_STRING_BYTES);
+    InternedStringMedPoolRef = le_mem_CreateReducedPool(InternedStringPoolRef,
+                                                        "InternedStringMed",
+                                                        0, INTERNED_STRING_MED_BYTES);
+    InternedStringSmallPoolRef = le_mem_CreateReducedPool(InternedStringMedPoolRef,
+                                                          "InternedStringSmall",
+                                                          0, INTERNED_STRING_SMALL_BYTES);
+    BinStringPoolRef = le_mem_CreatePool("BinString", sizeof(BinString_t));
+    le_mem_ExpandPool(BinStringPoolRef, LE_CONFIG_LOG_BINARY_MAX_STRINGS);
+
+    InternedStringMapRef = le_hashmap_Create("InternedString",
+                                             MAX_INTERNED_STRINGS,
+                                             le_hashmap_HashString,
+                                             le_hashmap_EqualsString);
+    BinStringMapRef = le_hashmap_Create("BinString",
+                                        LE_CONFIG_LOG_BINARY_MAX_STRINGS,
+                                        BinStringHash,
+                                        BinStringEquals);
+
+    BinaryDrainTimerRef = le_timer_Create("BinaryLogDrain");
+    le_timer_SetMsInterval(BinaryDrainTimerRef, LE_CONFIG_LOG_BINARY_DRAIN_INTERVAL);
+    le_timer_SetRepeat(BinaryDrainTimerRef, 0);
+    le_timer_SetHandler(BinaryDrainTimerRef, BinaryDrainTimerExpired);
+#endif
+
     // Create the hash maps.
     ProcessNameMapRef = le_hashmap_Create("ProcessName",
                                           MAX_EXPECTED_PROCESSES,
@@ -94,6 +94,10 @@
  */
 //--------------------------------------------------------------------------------------------------
 #define LOG_CMD_REG_COMPONENT           'r' // CommandData = string containing the process ID.
+#define LOG_CMD_BINARY_RING             'b' // No ProcessName, ComponentName, or CommandData.
+                                            // The binary log ring's fd is attached (see
+                                            // logBinary.h).  The response payload is empty if the
+                                            // ring was accepted.
 
 
 //--------------------------------------------------------------------------------------------------
@@ -103,6 +107,9 @@
 //--------------------------------------------------------------------------------------------------
 #define LOG_CMD_LIST_COMPONENTS         'c' // No ProcessName, ComponentName, or CommandData
 #define LOG_CMD_FORGET_PROCESS          'x' // No ComponentName or CommandData
+#define LOG_CMD_DUMP                    'p' // No ProcessName, ComponentName, or CommandData.
+                                            // The binary log history is rendered as text into a
+                                            // file whose fd is attached to the response.
 
 
 // =========================================================================
@@ -70,7 +70,7 @@ User List ------> User --+---> Name               |        |        |
 @endverbatim
  *
  * The User object represents a single user account.  It has a unique ID which is used as the key
- * to find it in the User List.  Each User also has
+ * to find it in the User Map.  Each User also has
  *  - list of bindings from a client-side interface name to a server's user name and service name.
  *  - list of services that it offers, and
  *  - list of client connections that are waiting for a binding to be created for them.
@@ -98,6 +98,13 @@ User List ------> User --+---> Name               |        |        |
  * Each Binding object and Connection object holds a reference count on a User object.  A User
  * object will be deleted when all associated Binding objects and Connection objects are deleted.
  *
+ * The lists are walked when something has to be done for every object on them, such as when
+ * the @c sdir tool lists them.  Looking up a single object, which has to be done for every
+ * session opened in the system, goes through a hash map instead:
+ *  - the User Map indexes User objects by user ID,
+ *  - the Service Map indexes Server Connections on Service Lists by user and service name, and
+ *  - the Binding Map indexes Binding objects by client user and client-side interface name.
+ *
  *
  * @section sd_theoryOfOperation Theory of Operation
  *
@@ -252,6 +259,25 @@ static le_mem_PoolRef_t UserPoolRef;
 static le_dls_List_t UserList = LE_DLS_LIST_INIT;
 
 
+//--------------------------------------------------------------------------------------------------
+/// The User Map, which indexes all User objects by user ID.
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t UserMapRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key identifying one of a user's interfaces, used to index Server Connections and Bindings.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const User_t*   userPtr;            ///< Ptr to the User object the interface belongs to.
+    const char*     interfaceName;      ///< Name of the interface.
+}
+InterfaceKey_t;
+
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -267,6 +293,7 @@ typedef struct
     User_t*                     userPtr;        ///< Pointer to the User object for the client uid.
     pid_t                       pid;            ///< Process ID of client process.
     svcdir_InterfaceDetails_t   interface;      ///< IPC interface details.
+    InterfaceKey_t              serviceKey;     ///< Key in the Service Map (once on Service List).
 }
 ServerConnection_t;
 
@@ -277,6 +304,12 @@ ServerConnection_t;
 static le_mem_PoolRef_t ServerConnectionPoolRef;
 
 
+//--------------------------------------------------------------------------------------------------
+/// The Service Map, which indexes the Server Connections on all users' Service Lists.
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t ServiceMapRef;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Represents a binding from a user's client interface to a service.  Objects of this type are
@@ -292,6 +325,7 @@ typedef struct
     char                serverInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES];///< Service name
     ServerConnection_t* serverConnectionPtr;///< Ptr to Server Connection (NULL if service unavail.)
     le_dls_List_t       waitingClientsList; ///< List of Client Connections waiting for the service.
+    InterfaceKey_t      clientKey;          ///< Key in the Binding Map.
 }
 Binding_t;
 
@@ -302,6 +336,12 @@ Binding_t;
 static le_mem_PoolRef_t BindingPoolRef;
 
 
+//--------------------------------------------------------------------------------------------------
+/// The Binding Map, which indexes all Binding objects.
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t BindingMapRef;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Enumeration of the different states that a client connection can be in.
@@ -372,6 +412,48 @@ static le_fdMonitor_Ref_t ServerSocketMonitorRef;
 // =======================================
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash function for Interface Keys.
+ *
+ * @return The hash value of the key.
+ **/
+//--------------------------------------------------------------------------------------------------
+static size_t InterfaceKeyHash
+(
+    const void* keyPtr  ///< [in] Ptr to the Interface Key.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const InterfaceKey_t* interfaceKeyPtr = keyPtr;
+
+    return (le_hashmap_HashString(interfaceKeyPtr->interfaceName) * 31) ^
+           le_hashmap_HashVoidPointer(interfaceKeyPtr->userPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Equality function for Interface Keys.
+ *
+ * @return true if the two keys identify the same interface of the same user.
+ **/
+//--------------------------------------------------------------------------------------------------
+static bool InterfaceKeyEquals
+(
+    const void* firstKeyPtr,    ///< [in] Ptr to the first Interface Key.
+    const void* secondKeyPtr    ///< [in] Ptr to the second Interface Key.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const InterfaceKey_t* firstPtr = firstKeyPtr;
+    const InterfaceKey_t* secondPtr = secondKeyPtr;
+
+    return (firstPtr->userPtr == secondPtr->userPtr) &&
+           (strcmp(firstPtr->interfaceName, secondPtr->interfaceName) == 0);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a User object for a given Unix user ID.
@@ -401,8 +483,9 @@ static User_t* CreateUser
     userPtr->serviceList = LE_DLS_LIST_INIT;
     userPtr->unboundClientsList = LE_DLS_LIST_INIT;
 
-    // Add it to the User List.
+    // Add it to the User List and the User Map.
     le_dls_Queue(&UserList, &userPtr->link);
+    le_hashmap_Put(UserMapRef, &userPtr->uid, userPtr);
 
     return userPtr;
 }
@@ -410,7 +493,7 @@ static User_t* CreateUser
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Searches the User List for a particular Unix user ID.  If found, increments the reference count
+ * Looks up a particular Unix user ID in the User Map.  If found, increments the reference count
  * on that object.  If not found, creates a new User object.
  *
  * @return Pointer to the User object.
@@ -422,19 +505,12 @@ static User_t* GetUser
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&UserList);
+    User_t* userPtr = le_hashmap_Get(UserMapRef, &uid);
 
-    while (linkPtr != NULL)
+    if (userPtr != NULL)
     {
-        User_t* userPtr = CONTAINER_OF(linkPtr, User_t, link);
-
-        if (userPtr->uid == uid)
-        {
-            le_mem_AddRef(userPtr);
-            return userPtr;
-        }
-
-        linkPtr = le_dls_PeekNext(&UserList, linkPtr);
+        le_mem_AddRef(userPtr);
+        return userPtr;
     }
 
     return CreateUser(uid);
@@ -455,14 +531,15 @@ static void UserDestructor
 {
     User_t* userPtr = objPtr;
 
-    // Remove the User object from the User List.
+    // Remove the User object from the User List and the User Map.
     le_dls_Remove(&UserList, &userPtr->link);
+    le_hashmap_Remove(UserMapRef, &userPtr->uid);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Searches a (client) User's Binding List for a particular client-side interface name.
+ * Looks up a (client) User's binding of a particular client-side interface name.
  *
  * @return Pointer to the Binding object or NULL if not found.
  **/
@@ -474,21 +551,9 @@ static Binding_t* FindBinding
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&userPtr->bindingList);
+    InterfaceKey_t key = { .userPtr = userPtr, .interfaceName = interfaceName };
 
-    while (linkPtr != NULL)
-    {
-        Binding_t* bindingPtr = CONTAINER_OF(linkPtr, Binding_t, link);
-
-        if (strcmp(bindingPtr->clientInterfaceName, interfaceName) == 0)
-        {
-            return bindingPtr;
-        }
-
-        linkPtr = le_dls_PeekNext(&userPtr->bindingList, linkPtr);
-    }
-
-    return NULL;
+    return le_hashmap_Get(BindingMapRef, &key);
 }
 
 
@@ -599,7 +664,7 @@ static le_result_t ReceiveMessage
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Searches a User's Service List for a particular service name.
+ * Looks up a particular service name on a User's Service List.
  *
  * @return Pointer to the Server Connection object for the matching service.
  **/
@@ -611,21 +676,9 @@ static ServerConnection_t* FindService
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&userPtr->serviceList);
+    InterfaceKey_t key = { .userPtr = userPtr, .interfaceName = serviceName };
 
-    while (linkPtr != NULL)
-    {
-        ServerConnection_t* serverConnectionPtr = CONTAINER_OF(linkPtr, ServerConnection_t, link);
-
-        if (strcmp(serverConnectionPtr->interface.interfaceName, serviceName) == 0)
-        {
-            return serverConnectionPtr;
-        }
-
-        linkPtr = le_dls_PeekNext(&userPtr->serviceList, linkPtr);
-    }
-
-    return NULL;
+    return le_hashmap_Get(ServiceMapRef, &key);
 }
 
 
@@ -994,8 +1047,11 @@ static void CreateBinding
     bindingPtr->serverConnectionPtr = NULL;
     bindingPtr->waitingClientsList = LE_DLS_LIST_INIT;
 
-    // Add the Binding to the client User's Binding List.
+    // Add the Binding to the client User's Binding List and the Binding Map.
     le_dls_Queue(&bindingPtr->clientUserPtr->bindingList, &bindingPtr->link);
+    bindingPtr->clientKey.userPtr = bindingPtr->clientUserPtr;
+    bindingPtr->clientKey.interfaceName = bindingPtr->clientInterfaceName;
+    le_hashmap_Put(BindingMapRef, &bindingPtr->clientKey, bindingPtr);
 
     // Look for a server serving the binding's destination service.
     bindingPtr->serverConnectionPtr = FindService(bindingPtr->serverUserPtr, serverInterfaceName);
@@ -1153,8 +1209,11 @@ static void ProcessAdvertisementFromServer
     // connection to the service list.
     else
     {
-        // Add the object to the User's Service List.
+        // Add the object to the User's Service List and the Service Map.
         le_dls_Queue(&connectionPtr->userPtr->serviceList, &connectionPtr->link);
+        connectionPtr->serviceKey.userPtr = connectionPtr->userPtr;
+        connectionPtr->serviceKey.interfaceName = connectionPtr->interface.interfaceName;
+        le_hashmap_Put(ServiceMapRef, &connectionPtr->serviceKey, connectionPtr);
 
         LE_DEBUG("Server (uid %u '%s', pid %d) now serving service '%s' (%s).",
                  connectionPtr->userPtr->uid,
@@ -1764,6 +1823,7 @@ static void ServerConnectionDestructor
         if (le_dls_IsInList(&connectionPtr->userPtr->serviceList, &connectionPtr->link))
         {
             le_dls_Remove(&connectionPtr->userPtr->serviceList, &connectionPtr->link);
+            le_hashmap_Remove(ServiceMapRef, &connectionPtr->serviceKey);
         }
     }
 
@@ -1854,8 +1914,9 @@ static void BindingDestructor
 {
     Binding_t* bindingPtr = objPtr;
 
-    // Remove the Binding object from the User's Binding List.
+    // Remove the Binding object from the User's Binding List and the Binding Map.
     le_dls_Remove(&bindingPtr->clientUserPtr->bindingList, &bindingPtr->link);
+    le_hashmap_Remove(BindingMapRef, &bindingPtr->clientKey);
 
     // While the list of waiting clients is not empty, pop one off and process it.
     le_dls_Link_t* linkPtr;
@@ -2654,6 +2715,14 @@ COMPONENT_INIT
     le_mem_SetDestructor(UserPoolRef, UserDestructor);
     le_mem_SetDestructor(BindingPoolRef, BindingDestructor);
 
+    // Create the maps used to look up objects.  They grow as needed.
+    UserMapRef = le_hashmap_CreateOpenAddressed("Users", 30,
+                                                le_hashmap_HashUInt32, le_hashmap_EqualsUInt32);
+    ServiceMapRef = le_hashmap_CreateOpenAddressed("Services", 30,
+                                                   InterfaceKeyHash, InterfaceKeyEquals);
+    BindingMapRef = le_hashmap_CreateOpenAddressed("Bindings", 30,
+                                                   InterfaceKeyHash, InterfaceKeyEquals);
+
     // Create built-in, hard-coded bindings.
     CreateHardCodedBindings();
 
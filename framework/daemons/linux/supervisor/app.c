@@ -30,6 +30,12 @@
  * The working area is not cleaned up by the Supervisor, rather it is left to the installer to
  * clean up.
  *
+ * When @c LE_CONFIG_SUPERV_APP_SANDBOX_CACHE is enabled, an app's SMACK rules and working area
+ * links stay in place when the app stops.  The app object records which version of the app (by
+ * its install hash) they were set up for.  A restart of that same version only re-applies the
+ * rules to the app's servers and its device permissions.  Those rules depend on other apps, and
+ * device nodes may have been re-created since.  The sandbox's tmpfs is always mounted afresh.
+ *
  * @todo Implement support for dynamic files.
  *
  * The application objects instantiated by this class contains a list of process object containers
@@ -61,6 +67,7 @@
 #include "file.h"
 #include "ima.h"
 #include "kernelModules.h"
+#include "installer.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -377,6 +384,11 @@ typedef struct app_Ref
     le_sls_List_t   additionalLinks;    // List of additional links that are temporarily added to
                                         // the app.
     le_sls_List_t   reqModuleName;      // List of required kernel module names
+    char            preparedHash[LIMIT_MD5_STR_BYTES];  // Hash of the app version the SMACK rules
+                                                        // and working area are set up for, or
+                                                        // empty if they are not.
+    uint32_t        preparedConfigCrc;  // CRC of the app's config the SMACK rules and working
+                                        // area are set up for.
 }
 App_t;
 
@@ -1514,6 +1526,38 @@ static le_result_t SetSmackRules
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Re-applies the parts of an app's SMACK rules and permissions that may have been lost while the
+ * app was stopped: the rules between the app and its servers, which are revoked when a server
+ * stops, and the permissions of device files, which may have been re-created.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RefreshSmackRules
+(
+    app_Ref_t appRef                    ///< [IN] Reference to the application.
+)
+{
+    // Get the app label.
+    char appLabel[LIMIT_MAX_SMACK_LABEL_BYTES];
+    smack_GetAppLabel(appRef->name, appLabel, sizeof(appLabel));
+
+    SetSmackRulesForBindings(appRef, appLabel);
+
+    le_result_t result = SetDefaultDevicePermissions(appRef);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    return SetCfgDevicePermissions(appRef);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Tells all the child processes in the list that we are going to kill them.
@@ -1562,15 +1606,15 @@ static le_result_t KillAppProcs
         // Wait till procs are frozen.
         while (1)
         {
-            cgrp_FreezeState_t freezeState = cgrp_frz_GetState(appRef->name);
+            cgrp_FreezeState_t freezeState;
 
-            if (freezeState == CGRP_FROZEN)
+            if (cgrp_frz_GetState(appRef->name, &freezeState) != LE_OK)
             {
+                LE_ERROR("Could not get freeze state of application '%s'.", appRef->name);
                 break;
             }
-            else if ((le_result_t)freezeState == LE_FAULT)
+            else if (freezeState == CGRP_FROZEN)
             {
-                LE_ERROR("Could not get freeze state of application '%s'.", appRef->name);
                 break;
             }
         }
@@ -3396,6 +3440,8 @@ app_Ref_t app_Create
     appPtr->additionalLinks = LE_SLS_LIST_INIT;
     appPtr->state = APP_STATE_STOPPED;
     appPtr->killTimer = NULL;
+    appPtr->preparedHash[0] = '\0';
+    appPtr->preparedConfigCrc = 0;
 
     LE_INFO("Creating app '%s'", appPtr->name);
 
@@ -3596,10 +3642,108 @@ void app_Delete
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the time elapsed since a phase of an app's start began, and begins the next phase.
+ *
+ * @return
+ *      The time spent in the phase, in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t EndStartPhase
+(
+    le_clk_Time_t* phaseStartPtr        ///< [IN/OUT] Time the phase began.  Set to the current
+                                        ///  time.
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    le_clk_Time_t elapsed = le_clk_Sub(now, *phaseStartPtr);
+
+    *phaseStartPtr = now;
+
+    return (uint32_t)(elapsed.sec * 1000 + elapsed.usec / 1000);
+}
+
+
+#if LE_CONFIG_SUPERV_APP_SANDBOX_CACHE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Computes a CRC of an application's configuration: the name, type and value of every node under
+ * /apps/<appName>.  The SMACK rules and working area depend on the configuration as well as on
+ * the app version, and it can be changed without installing the app again.
+ *
+ * @return
+ *      The CRC of the configuration.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetConfigCrc
+(
+    app_Ref_t appRef                    ///< [IN] Reference to the application.
+)
+{
+    uint32_t crc = LE_CRC_START_CRC32;
+    char buffer[LE_CFG_STR_LEN_BYTES];
+    int depth = 0;
+
+    le_cfg_IteratorRef_t cfgIter = le_cfg_CreateReadTxn(appRef->cfgPathRoot);
+
+    if (le_cfg_GoToFirstChild(cfgIter) != LE_OK)
+    {
+        le_cfg_CancelTxn(cfgIter);
+        return crc;
+    }
+
+    // Walk the tree depth first, so that the nodes are always visited in the same order.
+    for (;;)
+    {
+        le_cfg_nodeType_t type = le_cfg_GetNodeType(cfgIter, "");
+
+        // The depth and type keep moved or retyped nodes from giving the same CRC.
+        uint8_t header[2] = { (uint8_t)depth, (uint8_t)type };
+        crc = le_crc_Crc32(header, sizeof(header), crc);
+
+        if (le_cfg_GetNodeName(cfgIter, "", buffer, sizeof(buffer)) == LE_OK)
+        {
+            crc = le_crc_Crc32((uint8_t*)buffer, strlen(buffer) + 1, crc);
+        }
+
+        if (type == LE_CFG_TYPE_STEM)
+        {
+            if (le_cfg_GoToFirstChild(cfgIter) == LE_OK)
+            {
+                depth++;
+                continue;
+            }
+        }
+        else if (le_cfg_GetString(cfgIter, "", buffer, sizeof(buffer), "") == LE_OK)
+        {
+            crc = le_crc_Crc32((uint8_t*)buffer, strlen(buffer) + 1, crc);
+        }
+
+        // Move on to the next sibling, climbing back up past the stems that are done.
+        while (le_cfg_GoToNextSibling(cfgIter) != LE_OK)
+        {
+            if (depth == 0)
+            {
+                le_cfg_CancelTxn(cfgIter);
+                return crc;
+            }
+
+            le_cfg_GoToParent(cfgIter);
+            depth--;
+        }
+    }
+}
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Starts an application.
  *
+ * The time spent in each phase of the start is logged, to show where the app's start-up time
+ * goes.
+ *
  * @return
  *      LE_OK if successful.
  *      LE_FAULT if there was an error.
@@ -3613,6 +3757,8 @@ le_result_t app_Start
     LE_INFO("Starting app '%s'", appRef->name);
 
     bool moduleLoadFailed = false;
+    le_clk_Time_t phaseStart = le_clk_GetRelativeTime();
+    uint32_t modulesMs, smackMs, areaMs, sandboxMs, procsMs;
 
     if (appRef->state == APP_STATE_RUNNING)
     {
@@ -3634,17 +3780,62 @@ le_result_t app_Start
         LE_ERROR("Error in installing dependent kernel modules for app '%s'", appRef->name);
         moduleLoadFailed = true;
     }
+    modulesMs = EndStartPhase(&phaseStart);
 
     appRef->state = APP_STATE_RUNNING;
 
-    // Set SMACK rules for this app.
+    // See if the SMACK rules and runtime area are still set up from the last start.
+    char appHash[LIMIT_MD5_STR_BYTES] = "";
+    uint32_t configCrc = 0;
+#if LE_CONFIG_SUPERV_APP_SANDBOX_CACHE
+    installer_GetAppHashFromSymlink(appRef->installDirPath, appHash);
+    configCrc = GetConfigCrc(appRef);
+#endif
+    bool isPrepared = (appHash[0] != '\0') && (strcmp(appHash, appRef->preparedHash) == 0) &&
+                      (configCrc == appRef->preparedConfigCrc);
+
+    if (isPrepared)
+    {
+        LE_DEBUG("App '%s' is still set up for version %s.", appRef->name, appHash);
+
+        if (RefreshSmackRules(appRef) != LE_OK)
+        {
+            LE_ERROR("Failed to set Smack rules or set up app area.");
+            return LE_FAULT;
+        }
+    }
+    else
+    {
+        // Drop any rules left from a previous version of the app.
+        if (appRef->preparedHash[0] != '\0')
+        {
+            CleanupAppSmackSettings(appRef);
+            appRef->preparedHash[0] = '\0';
+        }
+
+        // Set SMACK rules for this app.
+        if (SetSmackRules(appRef) != LE_OK)
+        {
+            LE_ERROR("Failed to set Smack rules or set up app area.");
+            return LE_FAULT;
+        }
+    }
+    smackMs = EndStartPhase(&phaseStart);
+
     // Setup the runtime area in the file system.
-    if ( (SetSmackRules(appRef) != LE_OK) ||
-         (SetupAppArea(appRef) != LE_OK) )
+    if (!isPrepared)
     {
-        LE_ERROR("Failed to set Smack rules or set up app area.");
-        return LE_FAULT;
+        if (SetupAppArea(appRef) != LE_OK)
+        {
+            LE_ERROR("Failed to set Smack rules or set up app area.");
+            return LE_FAULT;
+        }
+
+        LE_ASSERT(le_utf8_Copy(appRef->preparedHash, appHash, sizeof(appRef->preparedHash),
+                               NULL) == LE_OK);
+        appRef->preparedConfigCrc = configCrc;
     }
+    areaMs = EndStartPhase(&phaseStart);
 
     // Create /tmp for sandboxed apps and link in /tmp files.
     if (appRef->sandboxed)
@@ -3665,6 +3856,7 @@ le_result_t app_Start
             return LE_FAULT;
         }
     }
+    sandboxMs = EndStartPhase(&phaseStart);
 
     // Start all the processes in the application.
     le_dls_Link_t* procLinkPtr = le_dls_Peek(&(appRef->procs));
@@ -3718,6 +3910,12 @@ le_result_t app_Start
         // Get the next process.
         procLinkPtr = le_dls_PeekNext(&(appRef->procs), procLinkPtr);
     }
+    procsMs = EndStartPhase(&phaseStart);
+
+    LE_INFO("App '%s' started in %" PRIu32 " ms (kernel modules %" PRIu32 " ms, SMACK rules %"
+            PRIu32 " ms, app area %" PRIu32 " ms, sandbox /tmp %" PRIu32 " ms, processes %"
+            PRIu32 " ms).", appRef->name, modulesMs + smackMs + areaMs + sandboxMs + procsMs,
+            modulesMs, smackMs, areaMs, sandboxMs, procsMs);
 
     return LE_OK;
 }
@@ -3778,7 +3976,11 @@ void app_Stop
         }
         DeleteModuleNodeList(appRef->reqModuleName);
 
-        CleanupAppSmackSettings(appRef);
+        // Rules set up for the next start are only used by the app's processes, so can be kept.
+        if (appRef->preparedHash[0] == '\0')
+        {
+            CleanupAppSmackSettings(appRef);
+        }
 
         appRef->state = APP_STATE_STOPPED;
     }
@@ -4901,7 +5103,11 @@ void app_StopComplete
         }
     }
     DeleteModuleNodeList(appRef->reqModuleName);
-    CleanupAppSmackSettings(appRef);
+    // Rules set up for the next start are only used by the app's processes, so can be kept.
+    if (appRef->preparedHash[0] == '\0')
+    {
+        CleanupAppSmackSettings(appRef);
+    }
     LE_INFO("app '%s' has stopped.", appRef->name);
 
     appRef->state = APP_STATE_STOPPED;
@@ -23,6 +23,13 @@
  * When an inactive app is started, the app container is moved from the list of inactive apps to
  * the list of active apps.
  *
+ * Apps are auto-started in the order of their bindings: an app is launched only after the
+ * auto-start apps serving its client-side interfaces have been launched.  Apps that do not depend
+ * on one another are launched in batches of up to @c LE_CONFIG_SUPERV_APP_START_PARALLELISM, and
+ * the Supervisor's event loop runs between batches so that it keeps serving the processes that
+ * have already been started.  If the bindings form a cycle, the apps in it are launched in
+ * config tree order.  The time each app spends in each phase of its start is logged.
+ *
  * An app can be stopped by either an IPC call, a shutdown of the framework or when the app
  * terminates either normally or due to a fault action.
  *
@@ -108,6 +115,15 @@
 #define CFG_NODE_SANDBOXED                  "sandboxed"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The name of the node in the config tree that contains the list of bindings for an app.  Each
+ * binding's "app" value is the name of the server app, if the server is in an app.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CFG_NODE_BINDINGS                   "bindings"
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The name of the socket for the AppStop Server and Client.
@@ -250,6 +266,86 @@ static le_mem_PoolRef_t AppProcContainerPool;
 //--------------------------------------------------------------------------------------------------
 static le_ref_MapRef_t AppProcMap;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * App waiting to be auto-started.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char            name[LIMIT_MAX_APP_NAME_BYTES]; ///< Name of the app.
+    le_dls_Link_t   link;           ///< Link in the waiting or ready list.
+    le_sls_List_t   clientList;     ///< Auto-start apps bound to this app's services.
+    size_t          serverCount;    ///< Number of this app's servers not yet launched.
+}
+AutoStartApp_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Entry in an auto-start app's list of clients.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t   link;           ///< Link in the server's client list.
+    AutoStartApp_t* clientPtr;      ///< The client app.
+}
+AutoStartClient_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pools for auto-start apps and their client list entries.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t AutoStartAppPool;
+static le_mem_PoolRef_t AutoStartClientPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Auto-start apps, by name.  Only used while the dependencies between them are worked out.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t AutoStartAppMap;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Auto-start apps waiting for their servers to be launched.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t AutoStartWaitingList = LE_DLS_LIST_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Auto-start apps ready to be launched, in config tree order.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t AutoStartReadyList = LE_DLS_LIST_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Auto-start apps already launched.  They are kept until the auto-start is over, because a client
+ * launched early to break a binding cycle can still be in the client list of a server that hasn't
+ * been launched yet.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t AutoStartLaunchedList = LE_DLS_LIST_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time the auto-start began, and the number of apps it launched so far.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t AutoStartTime;
+static size_t AutoStartLaunchCount;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Timeout value for waiting processes to exit for an app.
@@ -1329,6 +1425,11 @@ void apps_Init
     AppMap = le_ref_CreateMap("App", 5);
     AppAttachHandlerMap = le_ref_CreateMap("AppAttachHandlers", 5);
 
+    AutoStartAppPool = le_mem_CreatePool("autoStartApps", sizeof(AutoStartApp_t));
+    AutoStartClientPool = le_mem_CreatePool("autoStartClients", sizeof(AutoStartClient_t));
+    AutoStartAppMap = le_hashmap_Create("AutoStartApps", 31,
+                                        le_hashmap_HashString, le_hashmap_EqualsString);
+
     le_instStat_AddAppUninstallEventHandler(DeletesInactiveApp, NULL);
     le_instStat_AddAppInstallEventHandler(DeletesInactiveApp, NULL);
 
@@ -1412,9 +1513,224 @@ void apps_SetShutdownHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records that an auto-start app's client must wait for it to be launched, by reading the client's
+ * bindings from the config tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddAutoStartDependencies
+(
+    AutoStartApp_t* appPtr      ///< [IN] The client app.
+)
+{
+    char configPath[LIMIT_MAX_PATH_BYTES] = { 0 };
+
+    if (le_path_Concat("/", configPath, LIMIT_MAX_PATH_BYTES,
+                       CFG_NODE_APPS_LIST, appPtr->name, CFG_NODE_BINDINGS,
+                       (char*)NULL) == LE_OVERFLOW)
+    {
+        // The app can't be launched with a name this long anyway, so don't hold it back.
+        return;
+    }
+
+    le_cfg_IteratorRef_t bindCfg = le_cfg_CreateReadTxn(configPath);
+
+    if (le_cfg_GoToFirstChild(bindCfg) != LE_OK)
+    {
+        // No bindings.
+        le_cfg_CancelTxn(bindCfg);
+        return;
+    }
+
+    do
+    {
+        char serverName[LIMIT_MAX_APP_NAME_BYTES];
+
+        if ( (le_cfg_GetString(bindCfg, "app", serverName, sizeof(serverName), "") != LE_OK) ||
+             (serverName[0] == '\0') )
+        {
+            continue;
+        }
+
+        AutoStartApp_t* serverPtr = le_hashmap_Get(AutoStartAppMap, serverName);
+
+        if ((serverPtr == NULL) || (serverPtr == appPtr))
+        {
+            continue;
+        }
+
+        // Clients are added one at a time, so if this client has another binding to the same
+        // server it is at the head of the server's client list.
+        le_sls_Link_t* headPtr = le_sls_Peek(&serverPtr->clientList);
+
+        if ((headPtr != NULL) &&
+            (CONTAINER_OF(headPtr, AutoStartClient_t, link)->clientPtr == appPtr))
+        {
+            continue;
+        }
+
+        AutoStartClient_t* entryPtr = le_mem_ForceAlloc(AutoStartClientPool);
+
+        entryPtr->link = LE_SLS_LINK_INIT;
+        entryPtr->clientPtr = appPtr;
+        le_sls_Stack(&serverPtr->clientList, &entryPtr->link);
+
+        appPtr->serverCount++;
+    }
+    while (le_cfg_GoToNextSibling(bindCfg) == LE_OK);
+
+    le_cfg_CancelTxn(bindCfg);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases an auto-start app and its client list.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteAutoStartApp
+(
+    AutoStartApp_t* appPtr      ///< [IN] The app.
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Pop(&appPtr->clientList)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, AutoStartClient_t, link));
+    }
+
+    le_mem_Release(appPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases all the auto-start apps, at the end of the auto-start.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteAutoStartApps
+(
+    void
+)
+{
+    le_dls_List_t* listPtrs[] =
+        { &AutoStartReadyList, &AutoStartWaitingList, &AutoStartLaunchedList };
+    le_dls_Link_t* linkPtr;
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(listPtrs); i++)
+    {
+        while ((linkPtr = le_dls_Pop(listPtrs[i])) != NULL)
+        {
+            DeleteAutoStartApp(CONTAINER_OF(linkPtr, AutoStartApp_t, link));
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launches the next batch of auto-start apps that are ready.  Then makes ready the clients of the
+ * batch's apps whose servers have all been launched, and queues itself to launch them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LaunchAutoStartApps
+(
+    void* param1Ptr,            ///< [IN] Not used.
+    void* param2Ptr             ///< [IN] Not used.
+)
+{
+    le_dls_List_t batchList = LE_DLS_LIST_INIT;
+    le_dls_Link_t* linkPtr;
+    int count;
+
+    if (framework_IsStopping())
+    {
+        LE_INFO("Framework is stopping.  Abandoning app auto-start.");
+
+        DeleteAutoStartApps();
+        return;
+    }
+
+    for (count = 0; count < LE_CONFIG_SUPERV_APP_START_PARALLELISM; count++)
+    {
+        linkPtr = le_dls_Pop(&AutoStartReadyList);
+
+        if (linkPtr == NULL)
+        {
+            break;
+        }
+
+        AutoStartApp_t* appPtr = CONTAINER_OF(linkPtr, AutoStartApp_t, link);
+
+        // No need to check for errors other than counting them out, because there is nothing we
+        // can do about them.  The app's clients are launched anyway.
+        if (LaunchApp(appPtr->name) == LE_OK)
+        {
+            AutoStartLaunchCount++;
+        }
+
+        le_dls_Queue(&batchList, &appPtr->link);
+    }
+
+    while ((linkPtr = le_dls_Pop(&batchList)) != NULL)
+    {
+        AutoStartApp_t* appPtr = CONTAINER_OF(linkPtr, AutoStartApp_t, link);
+        le_sls_Link_t* clientLinkPtr = le_sls_Peek(&appPtr->clientList);
+
+        while (clientLinkPtr != NULL)
+        {
+            AutoStartApp_t* clientPtr = CONTAINER_OF(clientLinkPtr, AutoStartClient_t,
+                                                     link)->clientPtr;
+
+            // A client launched early to break a cycle has already been made ready.
+            if ((clientPtr->serverCount > 0) && (--clientPtr->serverCount == 0))
+            {
+                le_dls_Remove(&AutoStartWaitingList, &clientPtr->link);
+                le_dls_Queue(&AutoStartReadyList, &clientPtr->link);
+            }
+
+            clientLinkPtr = le_sls_PeekNext(&appPtr->clientList, clientLinkPtr);
+        }
+
+        le_dls_Queue(&AutoStartLaunchedList, &appPtr->link);
+    }
+
+    if (le_dls_IsEmpty(&AutoStartReadyList) && !le_dls_IsEmpty(&AutoStartWaitingList))
+    {
+        LE_WARN("Apps left to auto-start are bound to each other in a cycle.  "
+                "Launching them in config tree order.");
+
+        while ((linkPtr = le_dls_Pop(&AutoStartWaitingList)) != NULL)
+        {
+            CONTAINER_OF(linkPtr, AutoStartApp_t, link)->serverCount = 0;
+            le_dls_Queue(&AutoStartReadyList, linkPtr);
+        }
+    }
+
+    if (!le_dls_IsEmpty(&AutoStartReadyList))
+    {
+        le_event_QueueFunction(LaunchAutoStartApps, NULL, NULL);
+    }
+    else
+    {
+        le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), AutoStartTime);
+
+        LE_INFO("Auto-started %" PRIuS " apps in %ld ms.", AutoStartLaunchCount,
+                (long)(elapsed.sec * 1000 + elapsed.usec / 1000));
+
+        DeleteAutoStartApps();
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Start all applications marked as 'auto' start.
+ *
+ * The first batch of apps is launched before this function returns, the rest from the event loop.
  */
 //--------------------------------------------------------------------------------------------------
 void apps_AutoStart
@@ -1434,31 +1750,69 @@ void apps_AutoStart
         return;
     }
 
+    AutoStartTime = le_clk_GetRelativeTime();
+    AutoStartLaunchCount = 0;
+
     do
     {
         // Check the start mode for this application.
         if (!le_cfg_GetBool(appCfg, CFG_NODE_START_MANUAL, false))
         {
             // Get the app name.
-            char appName[LIMIT_MAX_APP_NAME_BYTES];
+            AutoStartApp_t* appPtr = le_mem_ForceAlloc(AutoStartAppPool);
 
-            if (le_cfg_GetNodeName(appCfg, "", appName, sizeof(appName)) == LE_OVERFLOW)
+            if (le_cfg_GetNodeName(appCfg, "", appPtr->name, sizeof(appPtr->name)) == LE_OVERFLOW)
             {
                 LE_ERROR("AppName buffer was too small, name truncated to '%s'.  "
                          "Max app name in bytes, %d.  Application not launched.",
-                         appName, LIMIT_MAX_APP_NAME_BYTES);
+                         appPtr->name, LIMIT_MAX_APP_NAME_BYTES);
+
+                le_mem_Release(appPtr);
             }
             else
             {
-                // Launch the application now.  No need to check the return code because there is
-                // nothing we can do about errors.
-                LaunchApp(appName);
+                appPtr->link = LE_DLS_LINK_INIT;
+                appPtr->clientList = LE_SLS_LIST_INIT;
+                appPtr->serverCount = 0;
+
+                le_dls_Queue(&AutoStartWaitingList, &appPtr->link);
+                le_hashmap_Put(AutoStartAppMap, appPtr->name, appPtr);
             }
         }
     }
     while (le_cfg_GoToNextSibling(appCfg) == LE_OK);
 
     le_cfg_CancelTxn(appCfg);
+
+    // Work out which apps must wait for which.
+    le_dls_Link_t* linkPtr = le_dls_Peek(&AutoStartWaitingList);
+
+    while (linkPtr != NULL)
+    {
+        AddAutoStartDependencies(CONTAINER_OF(linkPtr, AutoStartApp_t, link));
+        linkPtr = le_dls_PeekNext(&AutoStartWaitingList, linkPtr);
+    }
+
+    le_hashmap_RemoveAll(AutoStartAppMap);
+
+    // Apps with no servers to wait for are ready to be launched.
+    linkPtr = le_dls_Peek(&AutoStartWaitingList);
+
+    while (linkPtr != NULL)
+    {
+        le_dls_Link_t* nextLinkPtr = le_dls_PeekNext(&AutoStartWaitingList, linkPtr);
+        AutoStartApp_t* appPtr = CONTAINER_OF(linkPtr, AutoStartApp_t, link);
+
+        if (appPtr->serverCount == 0)
+        {
+            le_dls_Remove(&AutoStartWaitingList, linkPtr);
+            le_dls_Queue(&AutoStartReadyList, linkPtr);
+        }
+
+        linkPtr = nextLinkPtr;
+    }
+
+    LaunchAutoStartApps(NULL, NULL);
 }
 
 
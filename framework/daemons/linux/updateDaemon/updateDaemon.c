@@ -1268,7 +1268,8 @@ static void ImportFile
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Checks if given name is a valid config tree.
+ * Checks if given name is a valid config tree.  This includes a tree's journal, which has to be
+ * deleted along with the tree files, or it could be replayed into a new tree of the same name.
  *
  * returns
  *     - true if it is a valid config tree.
@@ -1290,7 +1291,8 @@ static bool IsCfgTree
 
     return (strcmp(extension, ".rock") == 0) ||
            (strcmp(extension, ".paper") == 0) ||
-           (strcmp(extension, ".scissors") == 0);
+           (strcmp(extension, ".scissors") == 0) ||
+           (strcmp(extension, ".journal") == 0);
 }
 
 
@@ -1310,7 +1312,8 @@ static bool IsSystemCfgTree
 {
     return (strcmp(treeName, "system.rock") == 0) ||
            (strcmp(treeName, "system.paper") == 0) ||
-           (strcmp(treeName, "system.scissors") == 0);
+           (strcmp(treeName, "system.scissors") == 0) ||
+           (strcmp(treeName, "system.journal") == 0);
 }
 
 
@@ -474,6 +474,9 @@ void rpcProxy_ClientRequestTimerExpiryHandler
 
     LE_WARN("Client-Request has timed out, proxy id [%" PRIu32 "];", proxyMsgId);
 
+    // Return the request's credit to the link, or take it out of the link's queue
+    rpcProxyNetwork_CompleteRequest(proxyMsgId, LE_TIMEOUT);
+
     // Retrieve Message Reference from hash map, using the Proxy Message Id
     le_msg_MessageRef_t msgRef = le_hashmap_Get(MsgRefMapByProxyId,
                                                 (void*)(uintptr_t) proxyMsgId);
@@ -592,6 +595,9 @@ uint32_t rpcProxy_GenerateProxyMessageId
 //--------------------------------------------------------------------------------------------------
 /**
  * Function for sending Proxy Messages to the far side via the le_comm API
+ *
+ * The message is written at once, or queued to be written later, depending on the state of its
+ * send lane (see rpcProxyNetwork_AdmitMsg()).  A queued message counts as sent.
  */
 //--------------------------------------------------------------------------------------------------
 le_result_t rpcProxy_SendMsg
@@ -601,8 +607,6 @@ le_result_t rpcProxy_SendMsg
 )
 {
     le_result_t         result;
-    size_t              byteCount;
-    void               *sendMessagePtr;
 
     // Retrieve the Network Record for this system
     NetworkRecord_t* networkRecordPtr =
@@ -625,12 +629,61 @@ le_result_t rpcProxy_SendMsg
         return LE_COMM_ERROR;
     }
 
+    // Find out whether the message has to wait for its turn
+    result = rpcProxyNetwork_AdmitMsg(systemName, networkRecordPtr, messagePtr);
+    if (result == LE_WOULD_BLOCK)
+    {
+        LE_DEBUG("Queued %s Proxy Message, proxy id [%" PRIu32 "]",
+                 DisplayMessageType(((rpcProxy_CommonHeader_t*) messagePtr)->type),
+                 ((rpcProxy_CommonHeader_t*) messagePtr)->id);
+        return LE_OK;
+    }
+    else if (result != LE_OK)
+    {
+        return result;
+    }
+
+    return rpcProxy_WriteMsg(systemName, networkRecordPtr, messagePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for writing a Proxy Message to a link, bypassing the send lanes.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcProxy_WriteMsg
+(
+    const char* systemName,            ///< [IN] Name of the system message is being sent to
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the system
+    void* messagePtr                   ///< [IN] Void pointer to the message buffer
+)
+{
+    le_result_t         result;
+    size_t              byteCount;
+    void               *sendMessagePtr;
+    uint32_t            writeCount = 1;
+    uint32_t            proxyId;
+    uint32_t            serviceId;
+    bool                writeFailed;
+
+    // Verify the state of the Network Connection
+    if (networkRecordPtr->state == NETWORK_DOWN)
+    {
+        LE_INFO("Network Status: DOWN, system [%s], handle [%d] - ignore send message request",
+                systemName,
+                le_comm_GetId(networkRecordPtr->handle));
+
+        return LE_COMM_ERROR;
+    }
+
     //
     // Prepare the Proxy Message for sending
     //
 
     // Set a pointer to the common message header
     rpcProxy_CommonHeader_t *commonHeaderPtr = (rpcProxy_CommonHeader_t*) messagePtr;
+    proxyId = commonHeaderPtr->id;
+    serviceId = commonHeaderPtr->serviceId;
 
     switch (commonHeaderPtr->type)
     {
@@ -676,13 +729,10 @@ le_result_t rpcProxy_SendMsg
         case RPC_PROXY_SERVER_RESPONSE:
         case RPC_PROXY_SERVER_ASYNC_EVENT:
         {
-            // For these messages, the header and body are sent out separately.
+            // For these messages, the header and body are streamed out together, and the header
+            // is converted to network byte order as it is streamed.
             byteCount = RPC_PROXY_COMMON_HEADER_SIZE;
 
-            // Prepare the Proxy Message Common Header
-            commonHeaderPtr->id = htobe32(commonHeaderPtr->id);
-            commonHeaderPtr->serviceId = htobe32(commonHeaderPtr->serviceId);
-
             // Set send pointer
             sendMessagePtr = messagePtr;
             break;
@@ -699,26 +749,39 @@ le_result_t rpcProxy_SendMsg
     LE_DEBUG("Sending %s Proxy Message, service-id [%" PRIu32 "], "
              "proxy id [%" PRIu32 "], size [%" PRIuS "]",
              DisplayMessageType(commonHeaderPtr->type),
-             be32toh(commonHeaderPtr->serviceId),
-             be32toh(commonHeaderPtr->id),
+             serviceId,
+             proxyId,
              byteCount);
 
-    // Send the Message Payload as an outgoing Proxy Message to the far-size RPC Proxy
-    result = le_comm_Send(networkRecordPtr->handle, sendMessagePtr, byteCount);
-    if (result != LE_OK)
+    if (IsVariableLengthType(commonHeaderPtr->type))
     {
-        // Delete the Network Communication Channel
-        rpcProxyNetwork_DeleteNetworkCommunicationChannel(systemName);
+        // Send the header and body of the variable length message, in as few writes as possible
+        result = rpcProxy_SendVariableLengthMsg(networkRecordPtr->handle, messagePtr,
+                                                &writeCount);
+        writeFailed = (result == LE_COMM_ERROR);
+    }
+    else
+    {
+        // Send the Message Payload as an outgoing Proxy Message to the far-size RPC Proxy
+        result = le_comm_Send(networkRecordPtr->handle, sendMessagePtr, byteCount);
+        writeFailed = (result != LE_OK);
+
+        // Prepare the Proxy Message Common Header
+        commonHeaderPtr->id = be32toh(commonHeaderPtr->id);
+        commonHeaderPtr->serviceId = be32toh(commonHeaderPtr->serviceId);
     }
 
-    // Prepare the Proxy Message Common Header
-    commonHeaderPtr->id = be32toh(commonHeaderPtr->id);
-    commonHeaderPtr->serviceId = be32toh(commonHeaderPtr->serviceId);
+    // Keep track of how many writes it takes to send a message over this link
+    networkRecordPtr->sendMsgCount++;
+    networkRecordPtr->sendWriteCount += writeCount;
+    LE_DEBUG("Proxy Message sent in %" PRIu32 " write(s), proxy id [%" PRIu32 "]",
+             writeCount,
+             proxyId);
 
-    if (result == LE_OK && IsVariableLengthType(commonHeaderPtr->type))
+    if (writeFailed)
     {
-        //now send the message body for variable length messages:
-        result = rpcProxy_SendVariableLengthMsgBody(networkRecordPtr->handle, messagePtr);
+        // Delete the Network Communication Channel
+        rpcProxyNetwork_DeleteNetworkCommunicationChannel(systemName);
     }
 
     return result;
@@ -955,6 +1018,9 @@ static le_result_t ProcessServerResponse
     rpcProxy_CleanUpLocalMessageResources(serverResponseMsgPtr->commonHeader.id);
 #endif
 
+    // Return the request's credit to the link
+    rpcProxyNetwork_CompleteRequest(serverResponseMsgPtr->commonHeader.id, LE_OK);
+
     // Delete Message Reference from hash map
     le_hashmap_Remove(MsgRefMapByProxyId, (void*)(uintptr_t) serverResponseMsgPtr->commonHeader.id);
     return LE_OK;
@@ -1199,6 +1265,9 @@ static void DeleteClientRequestTimer
 
         if ((sessionRef == NULL) ||(le_msg_GetSession(msgRef) == sessionRef))
         {
+            // Make sure the request won't be sent, and return its credit to the link
+            rpcProxyNetwork_CompleteRequest(proxyMsgId, LE_TERMINATED);
+
             // Free the IPC msgRef
             if (msgRef)
             {
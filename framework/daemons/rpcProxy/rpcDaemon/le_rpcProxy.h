@@ -502,13 +502,14 @@ const char* rpcProxy_GetSystemNameByServiceId
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Send out the body of a variable length message
+ *  Send out a variable length message, header and body, in as few writes as possible
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t rpcProxy_SendVariableLengthMsgBody
+le_result_t rpcProxy_SendVariableLengthMsg
 (
     void* handle, ///< [IN] Opaque handle to the le_comm communication channel
-    void* messagePtr ///< [IN] Void pointer to the message buffer
+    void* messagePtr, ///< [IN] Void pointer to the message buffer
+    uint32_t* writeCountPtr ///< [OUT] Number of writes made to le_comm
 );
 
 #ifdef RPC_PROXY_LOCAL_SERVICE
@@ -0,0 +1,359 @@
+/**
+ * @file le_rpcProxyCompress.c
+ *
+ * This file contains the source code for the compression codec used by the RPC Proxy file
+ * streams.  See le_rpcProxyCompress.h for the block format.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "le_rpcProxyCompress.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bits in the hash used to find matches.  The table costs two bytes per entry.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_COMPRESS_HASH_BITS      11
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of a token nibble that is followed by extra length bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_COMPRESS_NIBBLE_MAX     15
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Last position (plus one) at which each hashed four-byte sequence was seen, or 0 for none.
+ * The RPC Proxy is single-threaded, so one table is shared by all blocks.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint16_t HashTable[1 << RPC_COMPRESS_HASH_BITS];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash the four bytes at a position of the input.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t HashAt
+(
+    const uint8_t* ptr  ///< [IN] Position in the input
+)
+{
+    uint32_t value;
+
+    memcpy(&value, ptr, sizeof(value));
+    return (value * 2654435761U) >> (32 - RPC_COMPRESS_HASH_BITS);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the extra bytes of a length that didn't fit in its token nibble.
+ *
+ * @return
+ *      - Pointer past the bytes written, or
+ *      - NULL if they don't fit.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* PutExtraLength
+(
+    uint8_t* outPtr,        ///< [IN] Output position
+    const uint8_t* endPtr,  ///< [IN] End of the output buffer
+    size_t length           ///< [IN] Length minus RPC_COMPRESS_NIBBLE_MAX
+)
+{
+    while (length >= UINT8_MAX)
+    {
+        if (outPtr >= endPtr)
+        {
+            return NULL;
+        }
+        *outPtr++ = UINT8_MAX;
+        length -= UINT8_MAX;
+    }
+
+    if (outPtr >= endPtr)
+    {
+        return NULL;
+    }
+    *outPtr++ = (uint8_t) length;
+
+    return outPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a sequence: some literals, optionally followed by a match.
+ *
+ * @return
+ *      - Pointer past the sequence written, or
+ *      - NULL if it doesn't fit.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* PutSequence
+(
+    uint8_t* outPtr,            ///< [IN] Output position
+    const uint8_t* endPtr,      ///< [IN] End of the output buffer
+    const uint8_t* literalPtr,  ///< [IN] Literals
+    size_t literalLen,          ///< [IN] Number of literals
+    size_t offset,              ///< [IN] Distance back to the match, or 0 for none
+    size_t matchLen             ///< [IN] Length of the match
+)
+{
+    size_t matchCode = (offset != 0) ? (matchLen - RPC_COMPRESS_MIN_MATCH) : 0;
+    uint8_t* tokenPtr = outPtr;
+
+    if (outPtr >= endPtr)
+    {
+        return NULL;
+    }
+    *tokenPtr = (uint8_t) ((((literalLen < RPC_COMPRESS_NIBBLE_MAX) ?
+                                literalLen : RPC_COMPRESS_NIBBLE_MAX) << 4) |
+                           ((matchCode < RPC_COMPRESS_NIBBLE_MAX) ?
+                                matchCode : RPC_COMPRESS_NIBBLE_MAX));
+    outPtr++;
+
+    if (literalLen >= RPC_COMPRESS_NIBBLE_MAX)
+    {
+        outPtr = PutExtraLength(outPtr, endPtr, literalLen - RPC_COMPRESS_NIBBLE_MAX);
+        if (outPtr == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    if ((size_t) (endPtr - outPtr) < literalLen)
+    {
+        return NULL;
+    }
+    memcpy(outPtr, literalPtr, literalLen);
+    outPtr += literalLen;
+
+    if (offset == 0)
+    {
+        return outPtr;
+    }
+
+    if (endPtr - outPtr < 2)
+    {
+        return NULL;
+    }
+    *outPtr++ = (uint8_t) (offset & 0xFF);
+    *outPtr++ = (uint8_t) (offset >> 8);
+
+    if (matchCode >= RPC_COMPRESS_NIBBLE_MAX)
+    {
+        outPtr = PutExtraLength(outPtr, endPtr, matchCode - RPC_COMPRESS_NIBBLE_MAX);
+    }
+
+    return outPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a length that may continue past its token nibble.
+ *
+ * @return
+ *      - LE_OK if the length was read.
+ *      - LE_FORMAT_ERROR if the input ended first.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetLength
+(
+    const uint8_t** inPtrPtr,   ///< [IN/OUT] Input position
+    const uint8_t* endPtr,      ///< [IN] End of the input
+    size_t nibble,              ///< [IN] Value of the token nibble
+    size_t* lengthPtr           ///< [OUT] Length
+)
+{
+    const uint8_t* inPtr = *inPtrPtr;
+    size_t length = nibble;
+
+    if (nibble == RPC_COMPRESS_NIBBLE_MAX)
+    {
+        uint8_t byte;
+
+        do
+        {
+            if (inPtr >= endPtr)
+            {
+                return LE_FORMAT_ERROR;
+            }
+            byte = *inPtr++;
+            length += byte;
+        }
+        while (byte == UINT8_MAX);
+    }
+
+    *inPtrPtr = inPtr;
+    *lengthPtr = length;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compress a block of data.
+ *
+ * @return
+ *      - Size of the compressed data, or
+ *      - 0 if the compressed data would not fit in the output buffer (pass a buffer smaller than
+ *        the input to only get the compressed data when it is smaller).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t rpcCompress_Encode
+(
+    const uint8_t* srcPtr,  ///< [IN] Data to compress
+    size_t srcSize,         ///< [IN] Size of data to compress
+    uint8_t* dstPtr,        ///< [OUT] Buffer for the compressed data
+    size_t dstSize          ///< [IN] Size of the buffer
+)
+{
+    const uint8_t* endPtr = dstPtr + dstSize;
+    uint8_t* outPtr = dstPtr;
+    size_t anchor = 0;
+    size_t pos = 0;
+
+    if ((srcSize == 0) || (srcSize > RPC_COMPRESS_MAX_BLOCK_SIZE))
+    {
+        return 0;
+    }
+
+    memset(HashTable, 0, sizeof(HashTable));
+
+    while (pos + RPC_COMPRESS_MIN_MATCH <= srcSize)
+    {
+        uint32_t hash = HashAt(srcPtr + pos);
+        size_t candidate = HashTable[hash];
+
+        HashTable[hash] = (uint16_t) (pos + 1);
+
+        // Entries hold position + 1, so that 0 can mean "none".
+        if ((candidate == 0) ||
+            (memcmp(srcPtr + candidate - 1, srcPtr + pos, RPC_COMPRESS_MIN_MATCH) != 0))
+        {
+            pos++;
+            continue;
+        }
+        candidate--;
+
+        size_t matchLen = RPC_COMPRESS_MIN_MATCH;
+        while ((pos + matchLen < srcSize) && (srcPtr[candidate + matchLen] == srcPtr[pos + matchLen]))
+        {
+            matchLen++;
+        }
+
+        outPtr = PutSequence(outPtr, endPtr, srcPtr + anchor, pos - anchor,
+                             pos - candidate, matchLen);
+        if (outPtr == NULL)
+        {
+            return 0;
+        }
+
+        pos += matchLen;
+        anchor = pos;
+    }
+
+    outPtr = PutSequence(outPtr, endPtr, srcPtr + anchor, srcSize - anchor, 0, 0);
+    if (outPtr == NULL)
+    {
+        return 0;
+    }
+
+    return outPtr - dstPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompress a block of data.
+ *
+ * @return
+ *      - LE_OK if the block was decompressed.
+ *      - LE_OVERFLOW if the decompressed data doesn't fit in the output buffer.
+ *      - LE_FORMAT_ERROR if the block is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcCompress_Decode
+(
+    const uint8_t* srcPtr,  ///< [IN] Compressed data
+    size_t srcSize,         ///< [IN] Size of compressed data
+    uint8_t* dstPtr,        ///< [OUT] Buffer for the decompressed data
+    size_t dstSize,         ///< [IN] Size of the buffer
+    size_t* dstLenPtr       ///< [OUT] Size of the decompressed data
+)
+{
+    const uint8_t* inPtr = srcPtr;
+    const uint8_t* inEndPtr = srcPtr + srcSize;
+    size_t outLen = 0;
+
+    if (srcSize > RPC_COMPRESS_MAX_BLOCK_SIZE)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    while (inPtr < inEndPtr)
+    {
+        uint8_t token = *inPtr++;
+        size_t literalLen;
+        size_t matchLen;
+        size_t offset;
+
+        if (GetLength(&inPtr, inEndPtr, token >> 4, &literalLen) != LE_OK)
+        {
+            return LE_FORMAT_ERROR;
+        }
+        if ((size_t) (inEndPtr - inPtr) < literalLen)
+        {
+            return LE_FORMAT_ERROR;
+        }
+        if (dstSize - outLen < literalLen)
+        {
+            return LE_OVERFLOW;
+        }
+        memcpy(dstPtr + outLen, inPtr, literalLen);
+        inPtr += literalLen;
+        outLen += literalLen;
+
+        if (inPtr == inEndPtr)
+        {
+            // Last sequence
+            break;
+        }
+
+        if (inEndPtr - inPtr < 2)
+        {
+            return LE_FORMAT_ERROR;
+        }
+        offset = inPtr[0] | ((size_t) inPtr[1] << 8);
+        inPtr += 2;
+
+        if (GetLength(&inPtr, inEndPtr, token & RPC_COMPRESS_NIBBLE_MAX, &matchLen) != LE_OK)
+        {
+            return LE_FORMAT_ERROR;
+        }
+        matchLen += RPC_COMPRESS_MIN_MATCH;
+
+        if ((offset == 0) || (offset > outLen))
+        {
+            return LE_FORMAT_ERROR;
+        }
+        if (dstSize - outLen < matchLen)
+        {
+            return LE_OVERFLOW;
+        }
+
+        // Byte by byte, as the match may overlap the bytes it produces.
+        const uint8_t* matchPtr = dstPtr + outLen - offset;
+        uint8_t* copyPtr = dstPtr + outLen;
+        size_t i;
+        for (i = 0; i < matchLen; i++)
+        {
+            copyPtr[i] = matchPtr[i];
+        }
+        outLen += matchLen;
+    }
+
+    *dstLenPtr = outLen;
+    return LE_OK;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file le_rpcProxyCompress.h
+ *
+ * Header for the compression codec used by the RPC Proxy file streams.
+ *
+ * The codec is a small LZ77 block format.  A block is a series of sequences, each of which is:
+ *
+@verbatim
+    +-------+--------------------+----------+------------+--------------------+
+    | token | extra literal len  | literals | offset     | extra match len    |
+    | 1 B   | 0 or more B        |          | 2 B, LE    | 0 or more B        |
+    +-------+--------------------+----------+------------+--------------------+
+@endverbatim
+ *
+ * The high nibble of the token is the number of literals, and the low nibble is the match length
+ * minus RPC_COMPRESS_MIN_MATCH.  A nibble of 15 is followed by bytes that are added to it, up to
+ * and including the first byte that isn't 255.  The last sequence of a block has only literals.
+ *
+ * Blocks are at most 65535 bytes long, both before and after compression.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LE_RPC_PROXY_COMPRESS_H_INCLUDE_GUARD
+#define LE_RPC_PROXY_COMPRESS_H_INCLUDE_GUARD
+
+#include "legato.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Shortest match that is encoded as a back-reference.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_COMPRESS_MIN_MATCH      4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Largest block that can be compressed or decompressed.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_COMPRESS_MAX_BLOCK_SIZE UINT16_MAX
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compress a block of data.
+ *
+ * @return
+ *      - Size of the compressed data, or
+ *      - 0 if the compressed data would not fit in the output buffer (pass a buffer smaller than
+ *        the input to only get the compressed data when it is smaller).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t rpcCompress_Encode
+(
+    const uint8_t* srcPtr,  ///< [IN] Data to compress
+    size_t srcSize,         ///< [IN] Size of data to compress
+    uint8_t* dstPtr,        ///< [OUT] Buffer for the compressed data
+    size_t dstSize          ///< [IN] Size of the buffer
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompress a block of data.
+ *
+ * @return
+ *      - LE_OK if the block was decompressed.
+ *      - LE_OVERFLOW if the decompressed data doesn't fit in the output buffer.
+ *      - LE_FORMAT_ERROR if the block is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcCompress_Decode
+(
+    const uint8_t* srcPtr,  ///< [IN] Compressed data
+    size_t srcSize,         ///< [IN] Size of compressed data
+    uint8_t* dstPtr,        ///< [OUT] Buffer for the decompressed data
+    size_t dstSize,         ///< [IN] Size of the buffer
+    size_t* dstLenPtr       ///< [OUT] Size of the decompressed data
+);
+
+#endif /* LE_RPC_PROXY_COMPRESS_H_INCLUDE_GUARD */
@@ -9,6 +9,7 @@
 #include "legato.h"
 #include "le_rpcProxy.h"
 #include "le_rpcProxyFileStream.h"
+#include "le_rpcProxyCompress.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -25,6 +26,30 @@ static le_mem_PoolRef_t FileStreamPoolRef = NULL;
 
 le_dls_List_t FileStreamRefList = LE_DLS_LIST_INIT;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compression counters of the file streams that have been closed, added up.
+ */
+//--------------------------------------------------------------------------------------------------
+static rpcFStream_CompressionStats_t ClosedStreamStats;
+
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data packets smaller than this are always sent raw.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_FSTREAM_COMPRESS_MIN_SIZE  64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Holds the raw data of a data packet: what is read from rpcFd before it is compressed, or what is
+ * decompressed before it is written to rpcFd.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t CompressBuffer[RPC_PROXY_MAX_FILESTREAM_PAYLOAD_SIZE];
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Macros used for creating a unique name for each fd monitor
@@ -66,6 +91,168 @@ static rpcProxy_FileStream_t* GetFileStreamRef
     return NULL;
 }
 
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of microseconds elapsed since a given relative time.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetElapsedUs
+(
+    le_clk_Time_t startTime     ///< [IN] Relative time
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return (uint64_t) elapsed.sec * 1000000 + elapsed.usec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put the data read from rpcFd in the payload of a data packet, compressed if that makes it
+ * smaller.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CompressPayload
+(
+    rpcProxy_FileStream_t* fileStreamRef,           ///< [IN] File stream the packet belongs to
+    rpcProxy_FileStreamMessage_t* fileStreamMsgPtr,  ///< [IN] Data packet
+    const uint8_t* rawPtr,                          ///< [IN] Data read from rpcFd
+    size_t rawSize                                  ///< [IN] Number of bytes read
+)
+{
+    rpcFStream_CompressionStats_t* statsPtr = &fileStreamRef->compressionStats;
+    size_t encodedSize = 0;
+
+    if (rawSize >= RPC_FSTREAM_COMPRESS_MIN_SIZE)
+    {
+        le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+        // Only keep the compressed data if it is smaller
+        encodedSize = rpcCompress_Encode(rawPtr, rawSize, fileStreamMsgPtr->payload, rawSize - 1);
+        statsPtr->encodeTimeUs += GetElapsedUs(startTime);
+    }
+
+    statsPtr->rawBytes += rawSize;
+    if (encodedSize == 0)
+    {
+        memcpy(fileStreamMsgPtr->payload, rawPtr, rawSize);
+        fileStreamMsgPtr->payloadSize = rawSize;
+        statsPtr->wireBytes += rawSize;
+        if (rawSize != 0)
+        {
+            statsPtr->rawPackets++;
+        }
+        return;
+    }
+
+    fileStreamMsgPtr->payloadSize = encodedSize;
+    fileStreamMsgPtr->metaData.fileStreamFlags |= RPC_FSTREAM_COMPRESSED;
+    statsPtr->wireBytes += encodedSize;
+    statsPtr->compressedPackets++;
+}
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompress the payload of a data packet.
+ *
+ * @return
+ *      - LE_OK if the payload was decompressed.
+ *      - LE_UNSUPPORTED if compression is not enabled.
+ *      - LE_FORMAT_ERROR or LE_OVERFLOW if the payload is not valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t DecompressPayload
+(
+    rpcProxy_FileStream_t* fileStreamRef,           ///< [IN] File stream the packet belongs to
+    rpcProxy_FileStreamMessage_t* fileStreamMsgPtr,  ///< [IN] Data packet
+    uint8_t** dataPtrPtr,                           ///< [OUT] Decompressed data
+    size_t* dataSizePtr                             ///< [OUT] Size of decompressed data
+)
+{
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+    rpcFStream_CompressionStats_t* statsPtr = &fileStreamRef->compressionStats;
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    le_result_t result = rpcCompress_Decode(fileStreamMsgPtr->payload,
+                                            fileStreamMsgPtr->payloadSize,
+                                            CompressBuffer,
+                                            sizeof(CompressBuffer),
+                                            dataSizePtr);
+    statsPtr->decodeTimeUs += GetElapsedUs(startTime);
+
+    if (result == LE_OK)
+    {
+        statsPtr->rawBytes += *dataSizePtr;
+        statsPtr->wireBytes += fileStreamMsgPtr->payloadSize;
+        statsPtr->compressedPackets++;
+        *dataPtrPtr = CompressBuffer;
+    }
+    return result;
+#else
+    LE_UNUSED(fileStreamRef);
+    LE_UNUSED(fileStreamMsgPtr);
+    LE_UNUSED(dataPtrPtr);
+    LE_UNUSED(dataSizePtr);
+    return LE_UNSUPPORTED;
+#endif
+}
+
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a set of compression counters to a total.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddCompressionStats
+(
+    rpcFStream_CompressionStats_t* totalPtr,        ///< [IN/OUT] Total
+    const rpcFStream_CompressionStats_t* statsPtr   ///< [IN] Counters to add
+)
+{
+    totalPtr->rawBytes += statsPtr->rawBytes;
+    totalPtr->wireBytes += statsPtr->wireBytes;
+    totalPtr->compressedPackets += statsPtr->compressedPackets;
+    totalPtr->rawPackets += statsPtr->rawPackets;
+    totalPtr->encodeTimeUs += statsPtr->encodeTimeUs;
+    totalPtr->decodeTimeUs += statsPtr->decodeTimeUs;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log the compression counters of a file stream that is being closed, and add them to the totals.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndCompressionStats
+(
+    rpcProxy_FileStream_t* fileStreamRef    ///< [IN] File stream being closed
+)
+{
+    const rpcFStream_CompressionStats_t* statsPtr = &fileStreamRef->compressionStats;
+
+    if (statsPtr->rawBytes == 0)
+    {
+        return;
+    }
+
+    LE_INFO("File stream id:[%" PRIu16 "] of system: [%s] compression: "
+            "%" PRIu64 " bytes as %" PRIu64 " (%" PRIu64 "%%), "
+            "%" PRIu32 " packets compressed, %" PRIu32 " incompressible, "
+            "%" PRIu64 " us compressing, %" PRIu64 " us decompressing",
+            fileStreamRef->streamId,
+            fileStreamRef->remoteSystemName,
+            statsPtr->rawBytes,
+            statsPtr->wireBytes,
+            statsPtr->wireBytes * 100 / statsPtr->rawBytes,
+            statsPtr->compressedPackets,
+            statsPtr->rawPackets,
+            statsPtr->encodeTimeUs,
+            statsPtr->decodeTimeUs);
+
+    AddCompressionStats(&ClosedStreamStats, statsPtr);
+}
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * delete resources in a file stream and release it self. also remove from list.
@@ -86,6 +273,9 @@ static void RemoveFileStreamInstance
     {
         le_fdMonitor_Delete(fileStreamRef->fdMonitorRef);
     }
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+    EndCompressionStats(fileStreamRef);
+#endif
     le_fd_Close(fileStreamRef->rpcFd);
     le_dls_Remove(&FileStreamRefList, &(fileStreamRef->link));
     le_mem_Release(fileStreamRef);
@@ -109,7 +299,9 @@ static le_result_t ValidateStreamIdFlags
     if (((fStreamFlags & RPC_FSTREAM_DATA_PACKET) && (fStreamFlags & RPC_FSTREAM_REQUEST_DATA)) ||
         ((fStreamFlags & RPC_FSTREAM_EOF) && (fStreamFlags & RPC_FSTREAM_REQUEST_DATA)) ||
         ((fStreamFlags & RPC_FSTREAM_IOERROR) && (fStreamFlags & RPC_FSTREAM_REQUEST_DATA)) ||
-        ((fStreamFlags & RPC_FSTREAM_FORCE_CLOSE) && (fStreamFlags & RPC_FSTREAM_REQUEST_DATA)))
+        ((fStreamFlags & RPC_FSTREAM_FORCE_CLOSE) && (fStreamFlags & RPC_FSTREAM_REQUEST_DATA)) ||
+        ((fStreamFlags & RPC_FSTREAM_COMPRESSED) &&
+         !(fStreamFlags & (RPC_FSTREAM_DATA_PACKET | RPC_FSTREAM_REQUEST_DATA))))
     {
         return LE_FAULT;
     }
@@ -246,6 +438,15 @@ static void HandlePollinOutgoing
         size_t totalBytesRead = 0;
         uint8_t* buffPtr = fileStreamMsg.payload;
         int fd = fileStreamRef->rpcFd;
+        uint32_t closeFlag = 0;
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+        bool compress = fileStreamRef->isCompressionAccepted;
+        if (compress)
+        {
+            // Read into the side buffer, to be compressed into the payload
+            buffPtr = CompressBuffer;
+        }
+#endif
         while(totalBytesRead < bytesToRead)
         {
             ssize_t bytesRead = le_fd_Read(fd, buffPtr + totalBytesRead,
@@ -261,9 +462,7 @@ static void HandlePollinOutgoing
                 else
                 {
                     // serious error while reading from fifo:
-                    RemoveFileStreamInstance(fileStreamRef);
-                    metaDataPtr->fileStreamFlags |= RPC_FSTREAM_IOERROR;
-                    fileStreamRef = NULL;
+                    closeFlag = RPC_FSTREAM_IOERROR;
                     break;
                 }
             }
@@ -273,22 +472,43 @@ static void HandlePollinOutgoing
                 if (bytesRead == 0)
                 {
                     // EOF is reached
-                    RemoveFileStreamInstance(fileStreamRef);
-                    metaDataPtr->fileStreamFlags |= RPC_FSTREAM_EOF;
-                    fileStreamRef = NULL;
+                    closeFlag = RPC_FSTREAM_EOF;
                     break;
                 }
             }
         } // End of while
-        fileStreamMsg.payloadSize += totalBytesRead;
-        if (fileStreamRef)
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+        if (compress)
+        {
+            CompressPayload(fileStreamRef, &fileStreamMsg, buffPtr, totalBytesRead);
+        }
+        else
+#endif
+        {
+            fileStreamMsg.payloadSize += totalBytesRead;
+        }
+        // The stream is only removed once the packet is built, so that its counters include it.
+        if (closeFlag != 0)
+        {
+            metaDataPtr->fileStreamFlags |= closeFlag;
+            RemoveFileStreamInstance(fileStreamRef);
+            fileStreamRef = NULL;
+        }
+        else
         {
             /* Reset the requestedSize and disable the fd monitor. The other side will
              * request again with their new buffer amount if they have space upon receiving this
              * data packet.
              */
             fileStreamRef->requestedSize = 0;
-            le_fdMonitor_Disable(fileStreamRef->fdMonitorRef, POLLIN);
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+            fileStreamRef->isCompressionAccepted = false;
+#endif
+            // The fd monitor is gone once localFd has hung up.
+            if (fileStreamRef->fdMonitorRef)
+            {
+                le_fdMonitor_Disable(fileStreamRef->fdMonitorRef, POLLIN);
+            }
         }
 #if RPC_PROXY_HEX_DUMP
         LE_INFO("Sending this rpc filestream data messgae to %s:", systemName);
@@ -334,8 +554,12 @@ static void HandlePolloutIncoming
     metaDataPtr->fileStreamId = fileStreamRef->streamId;
     metaDataPtr->fileStreamFlags |= RPC_FSTREAM_REQUEST_DATA;
     metaDataPtr->fileStreamFlags |= (fileStreamRef->owner)? RPC_FSTREAM_OWNER : 0;
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+    metaDataPtr->fileStreamFlags |= RPC_FSTREAM_COMPRESSED;
+#endif
     metaDataPtr->isFileStreamValid = true;
-    fileStreamMsg.requestedSize = bytesToRequest;
+    // An empty pipe has 64K free, which doesn't fit in the request.
+    fileStreamMsg.requestedSize = (bytesToRequest > UINT16_MAX) ? UINT16_MAX : bytesToRequest;
     fileStreamMsg.payloadSize = 0;
 
     fileStreamMsg.commonHeader.id = rpcProxy_GenerateProxyMessageId();
@@ -539,6 +763,10 @@ le_result_t rpcFStream_HandleFileDescriptor
     fileStreamRef->remoteSystemName = systemName;
     fileStreamRef->direction = direction;
     fileStreamRef->requestedSize = 0;
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+    fileStreamRef->isCompressionAccepted = false;
+    memset(&fileStreamRef->compressionStats, 0, sizeof(fileStreamRef->compressionStats));
+#endif
 
     // create fd monitor for the fd.
     // setup an fd monitor on rpcFd(fd to send), use events according to direction.
@@ -677,6 +905,11 @@ le_result_t rpcFStream_HandleStreamId
     fileStreamRef->streamId = fStreamId;
     fileStreamRef->direction = direction;
     fileStreamRef->owner = false;
+    fileStreamRef->requestedSize = 0;
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+    fileStreamRef->isCompressionAccepted = false;
+    memset(&fileStreamRef->compressionStats, 0, sizeof(fileStreamRef->compressionStats));
+#endif
     int32_t localFd = -1;
     int32_t rpcFd = -1;
     if (rpcFStream_CreateChannel(fileStreamRef, &rpcFd, &localFd, isLocalFdNonBlocking) != LE_OK)
@@ -772,6 +1005,12 @@ le_result_t rpcFStream_ProcessFileStreamMessage
         LE_DEBUG("Found a matching stream id:[%" PRIu16 "], rpcfd:[%" PRId32 "], system: [%s]",
                 fStreamId, fileStreamRef->rpcFd, systemName);
     }
+    else if (fStreamFlags & RPC_FSTREAM_FORCE_CLOSE)
+    {
+        // Both sides closed the stream at the same time; there is nothing left to close.
+        LE_DEBUG("Stream id %"PRIu16" from %s is already closed", fStreamId, systemName);
+        return LE_OK;
+    }
     else
     {
         LE_ERROR("Cannot find file stream id %"PRIu16" send by %s in local list", fStreamId,
@@ -802,6 +1041,23 @@ le_result_t rpcFStream_ProcessFileStreamMessage
         LE_INFO("Received file stream message with DATA_PACKET flag. size: %d", bufferSize);
         ssize_t bytesWritten = 0;
 
+        if ((fStreamFlags & RPC_FSTREAM_COMPRESSED) &&
+            (DecompressPayload(fileStreamRef, fileStreamMsgPtr, &msgBufPtr, &bufferSize) != LE_OK))
+        {
+            LE_ERROR("Cannot decompress data packet of stream id:[%" PRIu16 "] from system: [%s]",
+                     fStreamId, systemName);
+            if (!(fStreamFlags & (RPC_FSTREAM_EOF | RPC_FSTREAM_IOERROR)))
+            {
+                uint32_t flags = RPC_FSTREAM_FORCE_CLOSE;
+                flags |= (owner)? RPC_FSTREAM_OWNER : 0;
+                SendFileStreamErrorMessage(systemName, fileStreamRef->serviceId,
+                                           fileStreamRef->streamId, flags);
+            }
+            RemoveFileStreamInstance(fileStreamRef);
+            fileStreamRef = NULL;
+            return LE_OK;
+        }
+
         if (bufferSize > 0)
         {
             bytesWritten = le_fd_Write(fileStreamRef->rpcFd, msgBufPtr, bufferSize);
@@ -846,6 +1102,9 @@ le_result_t rpcFStream_ProcessFileStreamMessage
         LE_INFO("Other side of stream id:[%" PRIu16 "] at system: [%s] requested [%" PRIu32 "] "
                  "bytes", fStreamId, systemName, requested_size);
         fileStreamRef->requestedSize = requested_size;
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+        fileStreamRef->isCompressionAccepted = ((fStreamFlags & RPC_FSTREAM_COMPRESSED) != 0);
+#endif
         if (fileStreamRef->fdMonitorRef != NULL)
         {
            le_fdMonitor_Enable(fileStreamRef->fdMonitorRef, POLLIN);
@@ -928,6 +1187,29 @@ void rpcFStream_DeleteStreamsByServiceId
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the compression counters of all file streams, open or closed, added up.
+ */
+//--------------------------------------------------------------------------------------------------
+void rpcFStream_GetCompressionStats
+(
+    rpcFStream_CompressionStats_t* statsPtr  ///< [OUT] Compression counters
+)
+{
+    *statsPtr = ClosedStreamStats;
+
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+    le_dls_Link_t* linkPtr = le_dls_Peek(&FileStreamRefList);
+    while (linkPtr != NULL)
+    {
+        rpcProxy_FileStream_t* fileStreamRef = CONTAINER_OF(linkPtr, rpcProxy_FileStream_t, link);
+        AddCompressionStats(statsPtr, &fileStreamRef->compressionStats);
+        linkPtr = le_dls_PeekNext(&FileStreamRefList, linkPtr);
+    }
+#endif
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize file stream pool:
@@ -226,13 +226,13 @@
  *
  * RPC file stream flag format as it is sent:
 @verbatim
-    +----------+-----+--------+-------+------+------+------+----------+----------+------+
-    |   9-15   |  8  |   7    |   6   |  5   |  4   |  3   |    2     |    1     |   0  |
-    ------------------------------------------------------------------------------------+
-    | Reserved | I/O |NonBlock|Request| Data |Force |EOF on|Initialize|Initialize| Owner|
-    |          |Error|Local Fd| Data  |Packet|Close |origin| Outgoing | Incoming |  Bit |
-    |          |     |        | Packet|      |Stream|      |  Stream  |  Stream  |      |
-    +----------+-----+--------+----------------------------+----------+----------+------+
+    +----------+------+-----+--------+-------+------+------+------+----------+----------+------+
+    |  10-15   |  9   |  8  |   7    |   6   |  5   |  4   |  3   |    2     |    1     |   0  |
+    -------------------------------------------------------------------------------------------+
+    | Reserved |Compr-| I/O |NonBlock|Request| Data |Force |EOF on|Initialize|Initialize| Owner|
+    |          |essed |Error|Local Fd| Data  |Packet|Close |origin| Outgoing | Incoming |  Bit |
+    |          |      |     |        | Packet|      |Stream|      |  Stream  |  Stream  |      |
+    +----------+------+-----+--------+----------------------------+----------+----------+------+
 @endverbatim
 
  * @subsection rpcfstream_initflag Initialization flags
@@ -275,6 +275,12 @@
  *
  * @subsection rpcfstream_ioerrorflag I/O Error(F[8])
  *   An error has happened during read or write to rpcFd.
+ *
+ * @subsection rpcfstream_compressedflag Compressed(F[9])
+ *   With Request Data Packet: the requesting side can take compressed data packets for this
+ *   request.  With Data Packet: the payload is compressed (see le_rpcProxyCompress.h), and
+ *   decompresses to at most the requested size.  A side that doesn't know this flag never sets it
+ *   on a request, so it is only ever sent raw data.
  */
 //--------------------------------------------------------------------------------------------------
 #define RPC_FSTREAM_OWNER                           0x1
@@ -286,6 +292,7 @@
 #define RPC_FSTREAM_REQUEST_DATA                    0x40
 #define RPC_FSTREAM_NONBLOCK                        0x80
 #define RPC_FSTREAM_IOERROR                         0x100
+#define RPC_FSTREAM_COMPRESSED                      0x200
 
 
 //--------------------------------------------------------------------------------------------------
@@ -307,6 +314,22 @@ typedef enum FStream_direction
     BIDIRECTIONAL_FILESTREAM = 3 // not supported yet.
 } fStream_direction_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * File stream compression counters.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct rpcFStream_CompressionStats
+{
+    uint64_t rawBytes;                         ///< Data packet bytes before compression
+    uint64_t wireBytes;                        ///< Data packet bytes as sent or received
+    uint32_t compressedPackets;                ///< Data packets sent or received compressed
+    uint32_t rawPackets;                       ///< Data packets sent raw although the other side
+                                               /// takes compressed data (incompressible)
+    uint64_t encodeTimeUs;                     ///< Time spent compressing, in microseconds
+    uint64_t decodeTimeUs;                     ///< Time spent decompressing, in microseconds
+} rpcFStream_CompressionStats_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * RPC Stream element.
@@ -326,6 +349,11 @@ typedef struct rpcProxy_FileStream
     le_fdMonitor_Ref_t fdMonitorRef;           ///< reference to fd monitor for rpcfd
     size_t requestedSize;                      ///< free buffer of the other side.
     fStream_direction_t direction;             ///< stream direction.
+#if LE_CONFIG_RPC_PROXY_FILE_STREAM_COMPRESSION
+    bool isCompressionAccepted;                ///< true if the other side takes compressed data
+                                               /// for its current request
+    rpcFStream_CompressionStats_t compressionStats;  ///< compression counters of this stream
+#endif
 
     le_dls_Link_t  link;
 } rpcProxy_FileStream_t;
@@ -456,6 +484,16 @@ void rpcFStream_DeleteStreamsByServiceId
     uint32_t serviceId              ///< [IN] Id of service being closed.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the compression counters of all file streams, open or closed, added up.
+ */
+//--------------------------------------------------------------------------------------------------
+void rpcFStream_GetCompressionStats
+(
+    rpcFStream_CompressionStats_t* statsPtr  ///< [OUT] Compression counters
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize file stream pool:
@@ -25,6 +25,9 @@
  */
 //--------------------------------------------------------------------------------------------------
 static void AsyncConnectionCallbackHandler(void* handle, short events);
+static void InitFlowControl(NetworkRecord_t* networkRecordPtr);
+static void ResetFlowControl(const char* systemName, NetworkRecord_t* networkRecordPtr);
+static void LogFlowControlMetrics(const char* systemName, NetworkRecord_t* networkRecordPtr);
 
 
 //--------------------------------------------------------------------------------------------------
@@ -72,6 +75,115 @@ LE_HASHMAP_DEFINE_STATIC(NetworkRecordHashMap, RPC_PROXY_NETWORK_SYSTEM_MAX_NUM)
 static le_hashmap_Ref_t NetworkRecordHashMapByName = NULL;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client-Request admitted to the request lane of a link.  It is either waiting in the link's
+ * request queue, or in flight.  Only requests that need a response (and so hold a credit while in
+ * flight) are kept once they have been written.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct NetworkRequest
+{
+    le_dls_Link_t       link;             ///< Link in the request queue or the in-flight list
+    NetworkRecord_t*    networkRecordPtr; ///< Network Record of the link
+    uint32_t            proxyId;          ///< Proxy Message ID
+    uint32_t            serviceId;        ///< Service ID
+    bool                needsResponse;    ///< Holds a credit while in flight
+    bool                inFlight;         ///< Written, and waiting for a Server-Response
+    uint32_t            seq;              ///< Order in which it was queued
+    le_clk_Time_t       sendTime;         ///< When it was written
+    rpcProxy_Message_t  message;          ///< Copy of the request, while it is queued
+}
+NetworkRequest_t;
+
+#define NETWORK_REQUEST_MAX_NUM     (RPC_PROXY_NETWORK_SYSTEM_MAX_NUM *            \
+                                     (RPC_PROXY_NETWORK_MAX_IN_FLIGHT_REQUESTS +   \
+                                      RPC_PROXY_NETWORK_MAX_QUEUED_REQUESTS))
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File Stream message waiting in the bulk lane of a link.  It may not be written before the
+ * Client-Requests that were already queued when it was admitted (up to and including the one
+ * numbered barrierSeq), as it may belong to a stream that one of them opens.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct NetworkBulkMsg
+{
+    le_dls_Link_t                 link;       ///< Link in the bulk queue
+    bool                          hasBarrier; ///< Client-Requests were queued ahead of it
+    uint32_t                      barrierSeq; ///< Last Client-Request queued ahead of it
+    rpcProxy_FileStreamMessage_t  message;    ///< Copy of the message
+}
+NetworkBulkMsg_t;
+
+#define NETWORK_BULK_MSG_MAX_NUM    (RPC_PROXY_NETWORK_SYSTEM_MAX_NUM * \
+                                     RPC_PROXY_NETWORK_MAX_QUEUED_BULK_MSGS)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key of the service metrics hash map.  The same Service ID can be in use on several links, so
+ * the metrics are kept per link.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct NetworkServiceKey
+{
+    const NetworkRecord_t* networkRecordPtr; ///< Network Record of the link
+    uint32_t               serviceId;        ///< Service ID
+}
+NetworkServiceKey_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue depth and round-trip time metrics of the Client-Requests made to one service over one
+ * link.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct NetworkServiceMetrics
+{
+    le_dls_Link_t        link;           ///< Link in the link's list of service metrics
+    NetworkServiceKey_t  key;            ///< Link and Service ID
+    uint32_t             queueDepth;     ///< Requests waiting in the link's request queue
+    uint32_t             peakQueueDepth; ///< Largest number of requests waiting
+    uint32_t             responseCount;  ///< Requests that have been answered
+    uint32_t             timeoutCount;   ///< Requests that have timed out while in flight
+    uint32_t             minRttMs;       ///< Shortest round-trip time (ms)
+    uint32_t             maxRttMs;       ///< Longest round-trip time (ms)
+    uint64_t             totalRttMs;     ///< Sum of the round-trip times (ms)
+}
+NetworkServiceMetrics_t;
+
+#define NETWORK_SERVICE_METRICS_MAX_NUM     (RPC_PROXY_NETWORK_SYSTEM_MAX_NUM * \
+                                             RPC_PROXY_SERVICE_BINDINGS_MAX_NUM)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pools and hash maps for the send lanes.  Requests that need a response are found by Proxy
+ * Message ID, and service metrics by link and Service ID.
+ * Initialized in rpcProxyNetwork_InitializeOnce().
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(NetworkRequestPool, NETWORK_REQUEST_MAX_NUM, sizeof(NetworkRequest_t));
+static le_mem_PoolRef_t NetworkRequestPoolRef = NULL;
+
+LE_HASHMAP_DEFINE_STATIC(NetworkRequestHashMap, NETWORK_REQUEST_MAX_NUM);
+static le_hashmap_Ref_t NetworkRequestByProxyId = NULL;
+
+LE_MEM_DEFINE_STATIC_POOL(NetworkBulkMsgPool, NETWORK_BULK_MSG_MAX_NUM, sizeof(NetworkBulkMsg_t));
+static le_mem_PoolRef_t NetworkBulkMsgPoolRef = NULL;
+
+LE_MEM_DEFINE_STATIC_POOL(NetworkServiceMetricsPool,
+                          NETWORK_SERVICE_METRICS_MAX_NUM,
+                          sizeof(NetworkServiceMetrics_t));
+static le_mem_PoolRef_t NetworkServiceMetricsPoolRef = NULL;
+
+LE_HASHMAP_DEFINE_STATIC(NetworkServiceMetricsHashMap, NETWORK_SERVICE_METRICS_MAX_NUM);
+static le_hashmap_Ref_t NetworkServiceMetricsByKey = NULL;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Handler function for Expired Network-related Timers
@@ -184,6 +296,9 @@ static void NetworkTimerExpiryHandler
 
             if (networkRecordPtr->state == NETWORK_UP)
             {
+                // Report on how the link is being used
+                LogFlowControlMetrics(systemName, networkRecordPtr);
+
                 // Generate a Network Keepalive event
                 rpcProxyNetwork_SendKeepAliveRequest(systemName);
 
@@ -562,6 +677,7 @@ le_result_t rpcProxyNetwork_CreateNetworkCommunicationChannel
         networkRecordPtr->type = UNKNOWN;
         networkRecordPtr->handle = NULL;
         networkRecordPtr->keepAliveTimerRef = NULL;
+        InitFlowControl(networkRecordPtr);
 
         le_hashmap_Put(NetworkRecordHashMapByName, systemName, networkRecordPtr);
     }
@@ -573,6 +689,10 @@ le_result_t rpcProxyNetwork_CreateNetworkCommunicationChannel
     // Reset Network Message Re-assembly State-Machine
     networkRecordPtr->messageState.recvState = NETWORK_MSG_IDLE;
 
+    // Reset send statistics
+    networkRecordPtr->sendMsgCount = 0;
+    networkRecordPtr->sendWriteCount = 0;
+
     LE_ASSERT(networkRecordPtr->handle == NULL);
 
     // Traverse the System-Link array and
@@ -730,6 +850,11 @@ void rpcProxyNetwork_DeleteNetworkCommunicationChannel
             systemName,
             le_comm_GetId(networkRecordPtr->handle));
 
+    LE_INFO("Sent %" PRIu32 " messages in %" PRIu32 " writes, system-name [%s]",
+            networkRecordPtr->sendMsgCount,
+            networkRecordPtr->sendWriteCount,
+            systemName);
+
     // Hide all affected services
     rpcProxy_HideServices(systemName);
     rpcProxy_DisconnectSessions(systemName);
@@ -749,6 +874,9 @@ void rpcProxyNetwork_DeleteNetworkCommunicationChannel
     // Reset Network Message Re-assembly State-Machine
     networkRecordPtr->messageState.recvState = NETWORK_MSG_IDLE;
 
+    // Drop anything still waiting to be sent, and reset the send window
+    ResetFlowControl(systemName, networkRecordPtr);
+
     // Stop Network Keep-Alive service
     StopNetworkKeepAliveService(systemName, networkRecordPtr);
 
@@ -1221,6 +1349,758 @@ static void AsyncConnectionCallbackHandler
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of milliseconds elapsed since a given relative time.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetElapsedMs
+(
+    le_clk_Time_t startTime ///< [IN] Relative time
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return (uint32_t) (elapsed.sec * 1000 + elapsed.usec / 1000);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for retrieving the System-Name of a Network Record (reverse look-up).
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* GetSystemNameByRecord
+(
+    NetworkRecord_t* networkRecordPtr ///< [IN] Network Record
+)
+{
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(NetworkRecordHashMapByName);
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        if (le_hashmap_GetValue(iter) == networkRecordPtr)
+        {
+            return (const char*) le_hashmap_GetKey(iter);
+        }
+    }
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash function for the service metrics keys.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HashServiceKey
+(
+    const void* keyPtr ///< [IN] Service metrics key
+)
+{
+    const NetworkServiceKey_t* serviceKeyPtr = keyPtr;
+
+    return le_hashmap_HashVoidPointer(serviceKeyPtr->networkRecordPtr) ^
+           le_hashmap_HashUInt32(&serviceKeyPtr->serviceId);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Equality function for the service metrics keys.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EqualsServiceKey
+(
+    const void* firstKeyPtr, ///< [IN] First service metrics key
+    const void* secondKeyPtr ///< [IN] Second service metrics key
+)
+{
+    const NetworkServiceKey_t* firstPtr = firstKeyPtr;
+    const NetworkServiceKey_t* secondPtr = secondKeyPtr;
+
+    return (firstPtr->networkRecordPtr == secondPtr->networkRecordPtr) &&
+           (firstPtr->serviceId == secondPtr->serviceId);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for retrieving the metrics of a service on a link.
+ *
+ * @return
+ *      - Pointer to the service metrics, or
+ *      - NULL if there are none yet.
+ */
+//--------------------------------------------------------------------------------------------------
+static NetworkServiceMetrics_t* FindServiceMetrics
+(
+    const NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the link
+    uint32_t serviceId                       ///< [IN] Service ID
+)
+{
+    NetworkServiceKey_t key =
+    {
+        .networkRecordPtr = networkRecordPtr,
+        .serviceId = serviceId
+    };
+
+    return le_hashmap_Get(NetworkServiceMetricsByKey, &key);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for retrieving the metrics of a service, creating them if they don't exist yet.
+ *
+ * @return
+ *      - Pointer to the service metrics, or
+ *      - NULL if there is no room for more.
+ */
+//--------------------------------------------------------------------------------------------------
+static NetworkServiceMetrics_t* GetServiceMetrics
+(
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the link used by the service
+    uint32_t serviceId                 ///< [IN] Service ID
+)
+{
+    NetworkServiceMetrics_t* metricsPtr = FindServiceMetrics(networkRecordPtr, serviceId);
+
+    if (metricsPtr != NULL)
+    {
+        return metricsPtr;
+    }
+
+    metricsPtr = le_mem_TryAlloc(NetworkServiceMetricsPoolRef);
+    if (metricsPtr == NULL)
+    {
+        return NULL;
+    }
+
+    memset(metricsPtr, 0, sizeof(NetworkServiceMetrics_t));
+    metricsPtr->link = LE_DLS_LINK_INIT;
+    metricsPtr->key.networkRecordPtr = networkRecordPtr;
+    metricsPtr->key.serviceId = serviceId;
+    metricsPtr->minRttMs = UINT32_MAX;
+
+    le_dls_Queue(&networkRecordPtr->flowControl.serviceMetrics, &metricsPtr->link);
+    le_hashmap_Put(NetworkServiceMetricsByKey, &metricsPtr->key, metricsPtr);
+
+    return metricsPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log the send window, queue depth and round-trip time metrics of a link.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LogFlowControlMetrics
+(
+    const char* systemName,           ///< [IN] System name
+    NetworkRecord_t* networkRecordPtr ///< [IN] Network Record
+)
+{
+    NetworkFlowControl_t* flowControlPtr = &networkRecordPtr->flowControl;
+    NetworkServiceMetrics_t* metricsPtr;
+
+    LE_INFO("Send window, system-name [%s]: in flight %" PRIu32 " (peak %" PRIu32 "), "
+            "queued requests %" PRIu32 " (peak %" PRIu32 "), "
+            "queued bulk messages %" PRIu32 " (peak %" PRIu32 "), "
+            "requests that waited %" PRIu32,
+            systemName,
+            RPC_PROXY_NETWORK_MAX_IN_FLIGHT_REQUESTS - flowControlPtr->credits,
+            flowControlPtr->peakInFlight,
+            flowControlPtr->queueDepth[NETWORK_LANE_REQUEST],
+            flowControlPtr->peakQueueDepth[NETWORK_LANE_REQUEST],
+            flowControlPtr->queueDepth[NETWORK_LANE_BULK],
+            flowControlPtr->peakQueueDepth[NETWORK_LANE_BULK],
+            flowControlPtr->stallCount);
+
+    LE_DLS_FOREACH(&flowControlPtr->serviceMetrics, metricsPtr, NetworkServiceMetrics_t, link)
+    {
+        LE_INFO("Service metrics, system-name [%s], service-id [%" PRIu32 "]: "
+                "responses %" PRIu32 ", time-outs %" PRIu32 ", "
+                "round-trip min/avg/max %" PRIu32 "/%" PRIu32 "/%" PRIu32 " ms, "
+                "queued %" PRIu32 " (peak %" PRIu32 ")",
+                systemName,
+                metricsPtr->key.serviceId,
+                metricsPtr->responseCount,
+                metricsPtr->timeoutCount,
+                (metricsPtr->responseCount > 0) ? metricsPtr->minRttMs : 0,
+                (metricsPtr->responseCount > 0) ?
+                    (uint32_t) (metricsPtr->totalRttMs / metricsPtr->responseCount) : 0,
+                metricsPtr->maxRttMs,
+                metricsPtr->queueDepth,
+                metricsPtr->peakQueueDepth);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the send window and queues of a newly allocated Network Record.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitFlowControl
+(
+    NetworkRecord_t* networkRecordPtr ///< [IN] Network Record
+)
+{
+    NetworkFlowControl_t* flowControlPtr = &networkRecordPtr->flowControl;
+    int lane;
+
+    memset(flowControlPtr, 0, sizeof(NetworkFlowControl_t));
+    flowControlPtr->credits = RPC_PROXY_NETWORK_MAX_IN_FLIGHT_REQUESTS;
+    flowControlPtr->inFlightList = LE_DLS_LIST_INIT;
+    flowControlPtr->serviceMetrics = LE_DLS_LIST_INIT;
+
+    for (lane = 0; lane < NETWORK_LANE_COUNT; lane++)
+    {
+        flowControlPtr->queue[lane] = LE_DLS_LIST_INIT;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop all the messages waiting to be sent on a link, forget the requests in flight, and reset
+ * the link's send window and metrics.  Called when the link goes down.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ResetFlowControl
+(
+    const char* systemName,           ///< [IN] System name
+    NetworkRecord_t* networkRecordPtr ///< [IN] Network Record
+)
+{
+    NetworkFlowControl_t* flowControlPtr = &networkRecordPtr->flowControl;
+    le_dls_List_t* requestListPtrs[] =
+    {
+        &flowControlPtr->inFlightList,
+        &flowControlPtr->queue[NETWORK_LANE_REQUEST]
+    };
+    le_dls_Link_t* linkPtr;
+    size_t i;
+
+    LogFlowControlMetrics(systemName, networkRecordPtr);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(requestListPtrs); i++)
+    {
+        while ((linkPtr = le_dls_Pop(requestListPtrs[i])) != NULL)
+        {
+            NetworkRequest_t* requestPtr = CONTAINER_OF(linkPtr, NetworkRequest_t, link);
+
+            if (requestPtr->needsResponse)
+            {
+                le_hashmap_Remove(NetworkRequestByProxyId, (void*)(uintptr_t) requestPtr->proxyId);
+            }
+            le_mem_Release(requestPtr);
+        }
+    }
+
+    while ((linkPtr = le_dls_Pop(&flowControlPtr->queue[NETWORK_LANE_BULK])) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, NetworkBulkMsg_t, link));
+    }
+
+    while ((linkPtr = le_dls_Pop(&flowControlPtr->serviceMetrics)) != NULL)
+    {
+        NetworkServiceMetrics_t* metricsPtr = CONTAINER_OF(linkPtr, NetworkServiceMetrics_t, link);
+
+        le_hashmap_Remove(NetworkServiceMetricsByKey, &metricsPtr->key);
+        le_mem_Release(metricsPtr);
+    }
+
+    flowControlPtr->credits = RPC_PROXY_NETWORK_MAX_IN_FLIGHT_REQUESTS;
+    memset(flowControlPtr->queueDepth, 0, sizeof(flowControlPtr->queueDepth));
+    memset(flowControlPtr->peakQueueDepth, 0, sizeof(flowControlPtr->peakQueueDepth));
+    flowControlPtr->peakInFlight = 0;
+    flowControlPtr->stallCount = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a message on one of the queues of a link, and keep track of the queue's depth.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueMsg
+(
+    NetworkFlowControl_t* flowControlPtr, ///< [IN] Flow control state of the link
+    NetworkSendLane_t lane,               ///< [IN] Send lane
+    le_dls_Link_t* linkPtr                ///< [IN] Link of the message
+)
+{
+    le_dls_Queue(&flowControlPtr->queue[lane], linkPtr);
+
+    flowControlPtr->queueDepth[lane]++;
+    if (flowControlPtr->queueDepth[lane] > flowControlPtr->peakQueueDepth[lane])
+    {
+        flowControlPtr->peakQueueDepth[lane] = flowControlPtr->queueDepth[lane];
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take a Client-Request off the request queue of a link.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DequeueRequest
+(
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the link
+    NetworkRequest_t* requestPtr       ///< [IN] Queued request
+)
+{
+    NetworkFlowControl_t* flowControlPtr = &networkRecordPtr->flowControl;
+
+    le_dls_Remove(&flowControlPtr->queue[NETWORK_LANE_REQUEST], &requestPtr->link);
+    flowControlPtr->queueDepth[NETWORK_LANE_REQUEST]--;
+
+    NetworkServiceMetrics_t* metricsPtr =
+        FindServiceMetrics(networkRecordPtr, requestPtr->serviceId);
+    if ((metricsPtr != NULL) && (metricsPtr->queueDepth > 0))
+    {
+        metricsPtr->queueDepth--;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark a Client-Request as in flight.  If it needs a response, it takes one of the link's credits
+ * until rpcProxyNetwork_CompleteRequest() is called for it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartRequest
+(
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the link
+    NetworkRequest_t* requestPtr       ///< [IN] Request
+)
+{
+    NetworkFlowControl_t* flowControlPtr = &networkRecordPtr->flowControl;
+
+    requestPtr->inFlight = true;
+    requestPtr->sendTime = le_clk_GetRelativeTime();
+
+    if (requestPtr->needsResponse)
+    {
+        LE_ASSERT(flowControlPtr->credits > 0);
+        flowControlPtr->credits--;
+        le_dls_Queue(&flowControlPtr->inFlightList, &requestPtr->link);
+
+        uint32_t inFlight = RPC_PROXY_NETWORK_MAX_IN_FLIGHT_REQUESTS - flowControlPtr->credits;
+        if (inFlight > flowControlPtr->peakInFlight)
+        {
+            flowControlPtr->peakInFlight = inFlight;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a record for a Client-Request being admitted to a link.
+ */
+//--------------------------------------------------------------------------------------------------
+static NetworkRequest_t* NewRequest
+(
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the link
+    const rpcProxy_Message_t* msgPtr,  ///< [IN] Client-Request
+    bool needsResponse                 ///< [IN] Whether the request needs a response
+)
+{
+    NetworkRequest_t* requestPtr = le_mem_Alloc(NetworkRequestPoolRef);
+
+    requestPtr->link = LE_DLS_LINK_INIT;
+    requestPtr->networkRecordPtr = networkRecordPtr;
+    requestPtr->proxyId = msgPtr->commonHeader.id;
+    requestPtr->serviceId = msgPtr->commonHeader.serviceId;
+    requestPtr->needsResponse = needsResponse;
+    requestPtr->inFlight = false;
+
+    if (needsResponse)
+    {
+        le_hashmap_Put(NetworkRequestByProxyId, (void*)(uintptr_t) requestPtr->proxyId, requestPtr);
+    }
+
+    return requestPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a queued bulk message has to keep waiting for a Client-Request queued ahead of it.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsBulkMsgBlocked
+(
+    NetworkFlowControl_t* flowControlPtr, ///< [IN] Flow control state of the link
+    const NetworkBulkMsg_t* bulkMsgPtr    ///< [IN] Queued bulk message
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&flowControlPtr->queue[NETWORK_LANE_REQUEST]);
+
+    if ((!bulkMsgPtr->hasBarrier) || (linkPtr == NULL))
+    {
+        return false;
+    }
+
+    // The request queue is in order, so only its head needs to be checked
+    NetworkRequest_t* requestPtr = CONTAINER_OF(linkPtr, NetworkRequest_t, link);
+
+    return ((int32_t) (requestPtr->seq - bulkMsgPtr->barrierSeq) <= 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the messages waiting on a link: first the Client-Requests that the link has credits for,
+ * then a few bulk messages.  If any bulk messages are left, this is scheduled to run again, so that
+ * more urgent messages can be sent in between.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ServiceSendQueues
+(
+    void* param1Ptr,  ///< [IN] Network Record
+    void* param2Ptr   ///< [IN] Unused
+)
+{
+    NetworkRecord_t* networkRecordPtr = param1Ptr;
+    NetworkFlowControl_t* flowControlPtr = &networkRecordPtr->flowControl;
+    le_dls_Link_t* linkPtr;
+    int count;
+
+    LE_UNUSED(param2Ptr);
+
+    flowControlPtr->pumpPending = false;
+
+    const char* systemName = GetSystemNameByRecord(networkRecordPtr);
+    if (systemName == NULL)
+    {
+        return;
+    }
+
+    // Client-Requests, in order, for as long as there are credits
+    while ((networkRecordPtr->state == NETWORK_UP) &&
+           ((linkPtr = le_dls_Peek(&flowControlPtr->queue[NETWORK_LANE_REQUEST])) != NULL))
+    {
+        NetworkRequest_t* requestPtr = CONTAINER_OF(linkPtr, NetworkRequest_t, link);
+        rpcProxy_Message_t message = requestPtr->message;
+
+        if (requestPtr->needsResponse && (flowControlPtr->credits == 0))
+        {
+            break;
+        }
+
+        DequeueRequest(networkRecordPtr, requestPtr);
+        StartRequest(networkRecordPtr, requestPtr);
+        if (!requestPtr->needsResponse)
+        {
+            // Nothing more to keep track of
+            le_mem_Release(requestPtr);
+        }
+
+        if (rpcProxy_WriteMsg(systemName, networkRecordPtr, &message) != LE_OK)
+        {
+            LE_ERROR("Unable to send queued Client-Request, proxy id [%" PRIu32 "]",
+                     message.commonHeader.id);
+        }
+    }
+
+    // Then some bulk messages, as long as they don't overtake a Client-Request
+    for (count = 0;
+         (count < RPC_PROXY_NETWORK_BULK_MSGS_PER_PASS) && (networkRecordPtr->state == NETWORK_UP);
+         count++)
+    {
+        linkPtr = le_dls_Peek(&flowControlPtr->queue[NETWORK_LANE_BULK]);
+        if ((linkPtr == NULL) ||
+            IsBulkMsgBlocked(flowControlPtr, CONTAINER_OF(linkPtr, NetworkBulkMsg_t, link)))
+        {
+            break;
+        }
+        le_dls_Remove(&flowControlPtr->queue[NETWORK_LANE_BULK], linkPtr);
+        flowControlPtr->queueDepth[NETWORK_LANE_BULK]--;
+
+        NetworkBulkMsg_t* bulkMsgPtr = CONTAINER_OF(linkPtr, NetworkBulkMsg_t, link);
+
+        if (rpcProxy_WriteMsg(systemName, networkRecordPtr, &bulkMsgPtr->message) != LE_OK)
+        {
+            LE_ERROR("Unable to send queued File Stream message, proxy id [%" PRIu32 "]",
+                     bulkMsgPtr->message.commonHeader.id);
+        }
+        le_mem_Release(bulkMsgPtr);
+    }
+
+    // Come back for the rest, unless they are waiting for Client-Requests, in which case this runs
+    // again when those go.
+    linkPtr = le_dls_Peek(&flowControlPtr->queue[NETWORK_LANE_BULK]);
+    if ((networkRecordPtr->state == NETWORK_UP) && (linkPtr != NULL) &&
+        !IsBulkMsgBlocked(flowControlPtr, CONTAINER_OF(linkPtr, NetworkBulkMsg_t, link)))
+    {
+        flowControlPtr->pumpPending = true;
+        le_event_QueueFunction(ServiceSendQueues, networkRecordPtr, NULL);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Schedule the messages waiting on a link to be written from the event loop.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScheduleSendQueues
+(
+    NetworkRecord_t* networkRecordPtr ///< [IN] Network Record
+)
+{
+    if (!networkRecordPtr->flowControl.pumpPending)
+    {
+        networkRecordPtr->flowControl.pumpPending = true;
+        le_event_QueueFunction(ServiceSendQueues, networkRecordPtr, NULL);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Admit a Client-Request to the request lane of a link.
+ *
+ * @return
+ *      - LE_OK, if the request should be written now,
+ *      - LE_WOULD_BLOCK, if it has been queued,
+ *      - LE_NO_MEMORY, if it had to wait but the queue is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AdmitRequest
+(
+    const char* systemName,            ///< [IN] System name
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the link
+    rpcProxy_Message_t* msgPtr         ///< [IN] Client-Request
+)
+{
+    NetworkFlowControl_t* flowControlPtr = &networkRecordPtr->flowControl;
+    bool needsResponse = le_msg_NeedsResponse(msgPtr->msgRef);
+    NetworkRequest_t* requestPtr;
+
+    // Requests are sent in order, so a request can only go now if none are waiting
+    if (le_dls_IsEmpty(&flowControlPtr->queue[NETWORK_LANE_REQUEST]) &&
+        (!needsResponse || (flowControlPtr->credits > 0)))
+    {
+        if (needsResponse)
+        {
+            requestPtr = NewRequest(networkRecordPtr, msgPtr, needsResponse);
+            StartRequest(networkRecordPtr, requestPtr);
+        }
+        return LE_OK;
+    }
+
+    if (flowControlPtr->queueDepth[NETWORK_LANE_REQUEST] >= RPC_PROXY_NETWORK_MAX_QUEUED_REQUESTS)
+    {
+        LE_WARN("Client-Request queue is full, system-name [%s], proxy id [%" PRIu32 "] - "
+                "dropping request",
+                systemName,
+                msgPtr->commonHeader.id);
+        return LE_NO_MEMORY;
+    }
+
+    requestPtr = NewRequest(networkRecordPtr, msgPtr, needsResponse);
+    requestPtr->message = *msgPtr;
+    requestPtr->seq = ++flowControlPtr->requestSeq;
+    QueueMsg(flowControlPtr, NETWORK_LANE_REQUEST, &requestPtr->link);
+    flowControlPtr->stallCount++;
+
+    NetworkServiceMetrics_t* metricsPtr =
+        GetServiceMetrics(networkRecordPtr, msgPtr->commonHeader.serviceId);
+    if (metricsPtr != NULL)
+    {
+        metricsPtr->queueDepth++;
+        if (metricsPtr->queueDepth > metricsPtr->peakQueueDepth)
+        {
+            metricsPtr->peakQueueDepth = metricsPtr->queueDepth;
+        }
+    }
+
+    if (flowControlPtr->credits > 0)
+    {
+        ScheduleSendQueues(networkRecordPtr);
+    }
+
+    return LE_WOULD_BLOCK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Admit a File Stream message to the bulk lane of a link.  All File Stream messages go through the
+ * bulk lane, so that the messages of a stream stay in order, and none of them is written before
+ * the Client-Requests queued ahead of it.
+ *
+ * @return
+ *      - LE_WOULD_BLOCK, if it has been queued,
+ *      - LE_NO_MEMORY, if the bulk queue is full and waiting for Client-Requests,
+ *      - LE_COMM_ERROR, if the link went down while making room for it.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AdmitBulkMsg
+(
+    const char* systemName,                      ///< [IN] System name
+    NetworkRecord_t* networkRecordPtr,           ///< [IN] Network Record of the link
+    rpcProxy_FileStreamMessage_t* fileStreamMsgPtr ///< [IN] File Stream message
+)
+{
+    NetworkFlowControl_t* flowControlPtr = &networkRecordPtr->flowControl;
+    NetworkBulkMsg_t* bulkMsgPtr = NULL;
+    le_dls_Link_t* linkPtr;
+
+    if (flowControlPtr->queueDepth[NETWORK_LANE_BULK] >= RPC_PROXY_NETWORK_MAX_QUEUED_BULK_MSGS)
+    {
+        // No room: write out what is allowed to go, so that the messages stay in order
+        LE_DEBUG("Bulk queue is full, system-name [%s] - flushing", systemName);
+
+        while ((networkRecordPtr->state == NETWORK_UP) &&
+               ((linkPtr = le_dls_Peek(&flowControlPtr->queue[NETWORK_LANE_BULK])) != NULL))
+        {
+            bulkMsgPtr = CONTAINER_OF(linkPtr, NetworkBulkMsg_t, link);
+            if (IsBulkMsgBlocked(flowControlPtr, bulkMsgPtr))
+            {
+                break;
+            }
+            le_dls_Remove(&flowControlPtr->queue[NETWORK_LANE_BULK], linkPtr);
+            flowControlPtr->queueDepth[NETWORK_LANE_BULK]--;
+            rpcProxy_WriteMsg(systemName, networkRecordPtr, &bulkMsgPtr->message);
+            le_mem_Release(bulkMsgPtr);
+        }
+        bulkMsgPtr = NULL;
+
+        if (networkRecordPtr->state != NETWORK_UP)
+        {
+            return LE_COMM_ERROR;
+        }
+    }
+
+    if (flowControlPtr->queueDepth[NETWORK_LANE_BULK] < RPC_PROXY_NETWORK_MAX_QUEUED_BULK_MSGS)
+    {
+        bulkMsgPtr = le_mem_TryAlloc(NetworkBulkMsgPoolRef);
+    }
+
+    if (bulkMsgPtr == NULL)
+    {
+        LE_WARN("Bulk queue is full and waiting for Client-Requests, system-name [%s], "
+                "proxy id [%" PRIu32 "] - dropping File Stream message",
+                systemName,
+                fileStreamMsgPtr->commonHeader.id);
+        return LE_NO_MEMORY;
+    }
+
+    bulkMsgPtr->link = LE_DLS_LINK_INIT;
+    bulkMsgPtr->hasBarrier = !le_dls_IsEmpty(&flowControlPtr->queue[NETWORK_LANE_REQUEST]);
+    bulkMsgPtr->barrierSeq = flowControlPtr->requestSeq;
+    memcpy(&bulkMsgPtr->message, fileStreamMsgPtr, sizeof(bulkMsgPtr->message));
+    QueueMsg(flowControlPtr, NETWORK_LANE_BULK, &bulkMsgPtr->link);
+    ScheduleSendQueues(networkRecordPtr);
+
+    return LE_WOULD_BLOCK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decide whether an outgoing Proxy Message can be written to a link now, according to its send
+ * lane.  A message that has to wait is copied into the link's queue for its lane, and written
+ * later by the RPC Proxy Network Service.
+ *
+ * @return
+ *      - LE_OK, if the message should be written now (with rpcProxy_WriteMsg()),
+ *      - LE_WOULD_BLOCK, if the message has been queued,
+ *      - LE_NO_MEMORY, if the message had to wait but the queue is full.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcProxyNetwork_AdmitMsg
+(
+    const char* systemName,            ///< [IN] Name of the system the message is being sent to
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the system
+    void* messagePtr                   ///< [IN] Proxy Message
+)
+{
+    rpcProxy_CommonHeader_t* commonHeaderPtr = (rpcProxy_CommonHeader_t*) messagePtr;
+
+    switch (commonHeaderPtr->type)
+    {
+        case RPC_PROXY_CLIENT_REQUEST:
+            return AdmitRequest(systemName, networkRecordPtr, (rpcProxy_Message_t*) messagePtr);
+
+        case RPC_PROXY_FILESTREAM_MESSAGE:
+            return AdmitBulkMsg(systemName,
+                                networkRecordPtr,
+                                (rpcProxy_FileStreamMessage_t*) messagePtr);
+
+        default:
+            // Control lane
+            return LE_OK;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for retiring a Client-Request that has been admitted to a link, because its
+ * Server-Response has arrived (LE_OK), it has timed out (LE_TIMEOUT) or it has been abandoned
+ * (any other result).  If the request was in flight, its credit is returned to the link; if it was
+ * still queued, it is removed from the queue without being sent.
+ *
+ * Does nothing if the request is not known (e.g., it doesn't need a response).
+ */
+//--------------------------------------------------------------------------------------------------
+void rpcProxyNetwork_CompleteRequest
+(
+    uint32_t proxyId,  ///< [IN] Proxy Message ID of the Client-Request
+    le_result_t result ///< [IN] How the request ended
+)
+{
+    NetworkRequest_t* requestPtr =
+        le_hashmap_Remove(NetworkRequestByProxyId, (void*)(uintptr_t) proxyId);
+
+    if (requestPtr == NULL)
+    {
+        return;
+    }
+
+    NetworkRecord_t* networkRecordPtr = requestPtr->networkRecordPtr;
+    NetworkFlowControl_t* flowControlPtr = &networkRecordPtr->flowControl;
+
+    if (requestPtr->inFlight)
+    {
+        le_dls_Remove(&flowControlPtr->inFlightList, &requestPtr->link);
+        flowControlPtr->credits++;
+
+        NetworkServiceMetrics_t* metricsPtr =
+            GetServiceMetrics(networkRecordPtr, requestPtr->serviceId);
+        if ((metricsPtr != NULL) && (result == LE_OK))
+        {
+            uint32_t rttMs = GetElapsedMs(requestPtr->sendTime);
+
+            metricsPtr->responseCount++;
+            metricsPtr->totalRttMs += rttMs;
+            if (rttMs < metricsPtr->minRttMs)
+            {
+                metricsPtr->minRttMs = rttMs;
+            }
+            if (rttMs > metricsPtr->maxRttMs)
+            {
+                metricsPtr->maxRttMs = rttMs;
+            }
+
+            LE_DEBUG("Server-Response received after %" PRIu32 " ms, "
+                     "service-id [%" PRIu32 "], proxy id [%" PRIu32 "]",
+                     rttMs,
+                     requestPtr->serviceId,
+                     proxyId);
+        }
+        else if ((metricsPtr != NULL) && (result == LE_TIMEOUT))
+        {
+            metricsPtr->timeoutCount++;
+        }
+    }
+    else
+    {
+        DequeueRequest(networkRecordPtr, requestPtr);
+    }
+
+    le_mem_Release(requestPtr);
+
+    // Queued Client-Requests may now be sent, and queued bulk messages may have been waiting for
+    // the one that went.
+    if (((flowControlPtr->credits > 0) &&
+         !le_dls_IsEmpty(&flowControlPtr->queue[NETWORK_LANE_REQUEST])) ||
+        !le_dls_IsEmpty(&flowControlPtr->queue[NETWORK_LANE_BULK]))
+    {
+        ScheduleSendQueues(networkRecordPtr);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function initializes the RPC Proxy Network Services.
@@ -1256,5 +2136,28 @@ le_result_t rpcProxyNetwork_InitializeOnce
                                  le_hashmap_HashVoidPointer,
                                  le_hashmap_EqualsVoidPointer);
 
+    // Initialize the pools and hash maps used by the send lanes.
+    NetworkRequestPoolRef = le_mem_InitStaticPool(NetworkRequestPool,
+                                                  NETWORK_REQUEST_MAX_NUM,
+                                                  sizeof(NetworkRequest_t));
+
+    NetworkRequestByProxyId = le_hashmap_InitStatic(NetworkRequestHashMap,
+                                                    NETWORK_REQUEST_MAX_NUM,
+                                                    le_hashmap_HashVoidPointer,
+                                                    le_hashmap_EqualsVoidPointer);
+
+    NetworkBulkMsgPoolRef = le_mem_InitStaticPool(NetworkBulkMsgPool,
+                                                  NETWORK_BULK_MSG_MAX_NUM,
+                                                  sizeof(NetworkBulkMsg_t));
+
+    NetworkServiceMetricsPoolRef = le_mem_InitStaticPool(NetworkServiceMetricsPool,
+                                                         NETWORK_SERVICE_METRICS_MAX_NUM,
+                                                         sizeof(NetworkServiceMetrics_t));
+
+    NetworkServiceMetricsByKey = le_hashmap_InitStatic(NetworkServiceMetricsHashMap,
+                                                       NETWORK_SERVICE_METRICS_MAX_NUM,
+                                                       HashServiceKey,
+                                                       EqualsServiceKey);
+
     return LE_OK;
 }
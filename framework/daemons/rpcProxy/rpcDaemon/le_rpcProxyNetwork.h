@@ -25,6 +25,34 @@
 #define RPC_PROXY_NETWORK_TIMER_RECORD_MAX_NUM  (RPC_PROXY_NETWORK_SYSTEM_MAX_NUM * 2)
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of Client-Requests that can be in flight on a link (the link's window), and
+ * maximum number that can wait for the window to open.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_PROXY_NETWORK_MAX_IN_FLIGHT_REQUESTS    LE_CONFIG_RPC_PROXY_MAX_IN_FLIGHT_REQUESTS
+#define RPC_PROXY_NETWORK_MAX_QUEUED_REQUESTS       LE_CONFIG_RPC_PROXY_MAX_QUEUED_REQUESTS
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bulk (file stream) messages waiting to be sent on a link.  Each file stream
+ * has at most one data packet and one control message outstanding.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_PROXY_NETWORK_MAX_QUEUED_BULK_MSGS      (RPC_PROXY_FILE_STREAM_MAX_NUM * 2)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bulk messages written each time the send queues are serviced, before giving the
+ * event loop a chance to run (and to send more urgent messages).
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_PROXY_NETWORK_BULK_MSGS_PER_PASS        2
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum receive buffer size must be set to maximum size of RPC message structure.
@@ -146,6 +174,50 @@ typedef struct NetworkMessageState
 NetworkMessageState_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * RPC Proxy Network Send Lanes
+ *
+ * Every outgoing Proxy Message goes through one of these lanes:
+ *  - Control messages (Keep-Alives, Connect/Disconnect-Service, Server-Responses and Async Events)
+ *    are never held back, so they can't be blocked by the other lanes.
+ *  - Client-Requests are written at once while the link has credits (see
+ *    RPC_PROXY_NETWORK_MAX_IN_FLIGHT_REQUESTS), and otherwise wait in order for a response to
+ *    return one.
+ *  - File Stream (bulk) messages are always queued, and written a few at a time from the event
+ *    loop, after any Client-Requests that can be sent.  They never overtake a Client-Request that
+ *    was queued before them.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum NetworkSendLane
+{
+    NETWORK_LANE_CONTROL = 0,   ///< Written immediately
+    NETWORK_LANE_REQUEST,       ///< Limited by the link's window
+    NETWORK_LANE_BULK,          ///< Written when nothing more urgent is waiting
+    NETWORK_LANE_COUNT
+}
+NetworkSendLane_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * RPC Proxy Network Flow Control and Send Queue state of a link
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct NetworkFlowControl
+{
+    uint32_t       credits;       ///< Client-Requests that can be written before a response arrives
+    le_dls_List_t  inFlightList;  ///< Client-Requests written and waiting for a response
+    le_dls_List_t  queue[NETWORK_LANE_COUNT];         ///< Messages waiting to be written
+    uint32_t       queueDepth[NETWORK_LANE_COUNT];    ///< Number of messages in each queue
+    uint32_t       peakQueueDepth[NETWORK_LANE_COUNT];///< Largest number of messages queued
+    uint32_t       peakInFlight;  ///< Largest number of Client-Requests in flight
+    uint32_t       stallCount;    ///< Client-Requests that had to wait for a credit
+    le_dls_List_t  serviceMetrics;///< Round-trip time metrics of each service using the link
+    bool           pumpPending;   ///< Servicing of the queues has been scheduled
+    uint32_t       requestSeq;    ///< Sequence number of the last Client-Request queued
+}
+NetworkFlowControl_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * RPC Proxy Network Record structure
@@ -158,6 +230,9 @@ typedef struct NetworkRecord
     NetworkConnectionType_t  type;      ///< Type of network connection
     le_timer_Ref_t           keepAliveTimerRef; ///< Keep-Alive Timer Ref
     NetworkMessageState_t    messageState; ///< Message Re-assembly State-Machine
+    uint32_t                 sendMsgCount;   ///< Messages sent since the channel was created
+    uint32_t                 sendWriteCount; ///< le_comm writes made to send them
+    NetworkFlowControl_t     flowControl;    ///< Send window, queues and metrics
 }
 NetworkRecord_t;
 
@@ -266,6 +341,53 @@ le_result_t rpcProxyNetwork_ConnectNetworkCommunicationChannel
     void* handle ///< Opaque handle to a le_comm communication channel
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decide whether an outgoing Proxy Message can be written to a link now, according to its send
+ * lane.  A message that has to wait is copied into the link's queue for its lane, and written
+ * later by the RPC Proxy Network Service.
+ *
+ * @return
+ *      - LE_OK, if the message should be written now (with rpcProxy_WriteMsg()),
+ *      - LE_WOULD_BLOCK, if the message has been queued,
+ *      - LE_NO_MEMORY, if the message had to wait but the queue is full.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcProxyNetwork_AdmitMsg
+(
+    const char* systemName,            ///< [IN] Name of the system the message is being sent to
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the system
+    void* messagePtr                   ///< [IN] Proxy Message
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for retiring a Client-Request that has been admitted to a link, because its
+ * Server-Response has arrived (LE_OK), it has timed out (LE_TIMEOUT) or it has been abandoned
+ * (any other result).  If the request was in flight, its credit is returned to the link; if it was
+ * still queued, it is removed from the queue without being sent.
+ *
+ * Does nothing if the request is not known (e.g., it doesn't need a response).
+ */
+//--------------------------------------------------------------------------------------------------
+void rpcProxyNetwork_CompleteRequest
+(
+    uint32_t proxyId,  ///< [IN] Proxy Message ID of the Client-Request
+    le_result_t result ///< [IN] How the request ended
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for writing a Proxy Message to a link, bypassing the send lanes.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcProxy_WriteMsg
+(
+    const char* systemName,            ///< [IN] Name of the system message is being sent to
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the system
+    void* messagePtr                   ///< [IN] Void pointer to the message buffer
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Start Network Connection Retry timer.
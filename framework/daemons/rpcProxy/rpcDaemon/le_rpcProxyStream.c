@@ -41,15 +41,15 @@
  * Alice's rpc engine converts message 5 to message 6, a server response IPC message.
  *
  * This file provides two major API's used by the rest of RPC,
- * @ref rpcProxy_SendVariableLengthMsgBody and @ref rpcProxy_RecvStream. Outgoing messages,
- * messages that are supposed to be sent, are handled by @ref rpcProxy_SendVariableLengthMsgBody
+ * @ref rpcProxy_SendVariableLengthMsg and @ref rpcProxy_RecvStream. Outgoing messages,
+ * messages that are supposed to be sent, are handled by @ref rpcProxy_SendVariableLengthMsg
  * and incoming message, messages that we are receiving from a remote side are handled by
  * @ref rpcProxy_RecvStream.
  *
  *
  * @section stream_send Send Logic
  *
- * The @ref rpcProxy_SendVariableLengthMsgBody function must handle two types of message,
+ * The @ref rpcProxy_SendVariableLengthMsg function must handle two types of message,
  * file stream messages and IPC messages. File stream messages are passed to
  * @ref rpcProxy_SendFileStreamMessageBody, which uses @c cbor_encode_* APIs to send file message
  * components one by one. IPC messages are passed to @ref rpcProxy_SendIpcMessageBody which uses
@@ -62,6 +62,14 @@
  * given an appropriate callback and unexpected CBOR types are given a callback that if called,
  * raises an error.
  *
+ * Nothing is written to @c le_comm while a message is being parsed.  Instead, the pieces of the
+ * outgoing message are collected in a @ref SendBatch_t: items that are passed through unchanged
+ * are referred to where they are in the IPC message buffer (and merged with the previous piece if
+ * they follow on from it), and items that have to be re-encoded are copied into the batch's
+ * scratch buffer.  The whole message, including its common header, is then written with one call
+ * to @c le_comm_SendVector (or one call to @c le_comm_Send per piece if the communication
+ * component doesn't provide @c le_comm_SendVector).
+ *
  * @section stream_receive Receive Logic
  *
  * Receiving an RPC message is driven by the fdmonitor handler given to @c le_comm. This handler is
@@ -121,6 +129,13 @@
 // Initial number of bytes expected to parse an async (event) message:
 // 4 for id, 1 for indef array header, 1 for async handler tag, 2 for async handler tag value
 #define ASYNC_MSG_INITIAL_EXPECTED_SIZE        IPC_MSG_ID_SIZE + 1 + 1 + 2
+// Maximum size of an encoded CBOR item head (initial byte and up to 8 bytes of argument)
+#define CBOR_HEAD_MAX_SIZE                     (1 + sizeof(uint64_t))
+// Maximum number of pieces of an outgoing message written at once
+#define SEND_MAX_SEGMENTS                      LE_CONFIG_RPC_PROXY_SEND_MAX_SEGMENTS
+// Size of the buffer holding re-encoded items of an outgoing message.  Every re-encoded item
+// (including the common header) fits in CBOR_HEAD_MAX_SIZE bytes, and needs at most one segment.
+#define SEND_SCRATCH_SIZE                      (SEND_MAX_SEGMENTS * CBOR_HEAD_MAX_SIZE)
 
 //Type that defines send state:
 typedef enum SendState
@@ -137,6 +152,27 @@ typedef enum SendState
     SEND_NUM_STATES
 } SendState_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Structure collecting the pieces of an outgoing message, so they can be written all at once.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct SendBatch
+{
+    void* handle;                                   ///< Handle to use for writing to le_comm
+    le_comm_Segment_t segments[SEND_MAX_SEGMENTS];  ///< Pieces of the message not yet written
+    size_t segmentCount;                            ///< Number of pieces not yet written
+    uint8_t scratch[SEND_SCRATCH_SIZE];             ///< Re-encoded items not yet written
+    size_t scratchUsed;                             ///< Number of bytes used in scratch buffer
+#ifdef RPC_PROXY_LOCAL_SERVICE
+    rpcProxy_LocalBuffer_t* releaseList[RPC_PROXY_MSG_OUT_PARAMETER_MAX_NUM];
+                                                    ///< Buffers to release once written
+    size_t releaseCount;                            ///< Number of buffers to release
+#endif
+    uint32_t writeCount;                            ///< Number of writes made for this message
+    le_result_t result;                             ///< Result of the first failed write, or LE_OK
+} SendBatch_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Structure holding the context during send
@@ -144,7 +180,7 @@ typedef enum SendState
 //--------------------------------------------------------------------------------------------------
 typedef struct SendContext
 {
-    void* handle;                   ///< Handle to use for writing to le_comm
+    SendBatch_t* batchPtr;          ///< Batch collecting the outgoing message
     SendState_t state;              ///< Send State
     bool squelchThisItem;           ///< Do not send the last parsed value
     rpcProxy_Message_t* messagePtr; ///< Pointer to proxy message being streamed
@@ -909,12 +945,180 @@ static void PrintIpcMessageInfo
             proxyMessagePtr->commonHeader.serviceId);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Batch collecting the message currently being sent.
+ *
+ *  Messages are only ever sent from the RPC Proxy's main thread, one at a time, so one batch is
+ *  enough (and keeps it off the stack).
+ */
+//--------------------------------------------------------------------------------------------------
+static SendBatch_t SendBatch;
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Helper functions used during send:
  */
 //--------------------------------------------------------------------------------------------------
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Start collecting a new outgoing message
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartBatch
+(
+    SendBatch_t* batchPtr,                ///< [IN] pointer to batch
+    void* handle                          ///< [IN] handle to use for writing to le_comm
+)
+{
+    batchPtr->handle = handle;
+    batchPtr->segmentCount = 0;
+    batchPtr->scratchUsed = 0;
+#ifdef RPC_PROXY_LOCAL_SERVICE
+    batchPtr->releaseCount = 0;
+#endif
+    batchPtr->writeCount = 0;
+    batchPtr->result = LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Write out everything collected so far, unless discard is set, and start collecting afresh.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushBatch
+(
+    SendBatch_t* batchPtr,                ///< [IN] pointer to batch
+    bool discard                          ///< [IN] drop the collected pieces instead of writing
+)
+{
+    if ((batchPtr->segmentCount != 0) && (batchPtr->result == LE_OK) && !discard)
+    {
+        le_result_t result = LE_OK;
+
+        if (le_comm_SendVector != NULL)
+        {
+            result = le_comm_SendVector(batchPtr->handle, batchPtr->segments,
+                                        batchPtr->segmentCount);
+            batchPtr->writeCount++;
+        }
+        else
+        {
+            size_t i;
+
+            for (i = 0; (i < batchPtr->segmentCount) && (result == LE_OK); i++)
+            {
+                result = le_comm_Send(batchPtr->handle, batchPtr->segments[i].buf,
+                                      batchPtr->segments[i].len);
+                batchPtr->writeCount++;
+            }
+        }
+
+        if (result != LE_OK)
+        {
+            LE_ERROR("Failed to write proxy message, result %d", result);
+            batchPtr->result = LE_COMM_ERROR;
+        }
+    }
+
+    batchPtr->segmentCount = 0;
+    batchPtr->scratchUsed = 0;
+
+#ifdef RPC_PROXY_LOCAL_SERVICE
+    while (batchPtr->releaseCount > 0)
+    {
+        le_mem_Release(batchPtr->releaseList[--batchPtr->releaseCount]);
+    }
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Add a piece of the outgoing message that will stay where it is until the message is written
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToBatch
+(
+    SendBatch_t* batchPtr,                ///< [IN] pointer to batch
+    const void* buf,                      ///< [IN] pointer to data
+    size_t length                         ///< [IN] size of data
+)
+{
+    if (length == 0)
+    {
+        return;
+    }
+
+    if (batchPtr->segmentCount != 0)
+    {
+        le_comm_Segment_t* lastPtr = &batchPtr->segments[batchPtr->segmentCount - 1];
+
+        if ((const uint8_t*)lastPtr->buf + lastPtr->len == (const uint8_t*)buf)
+        {
+            // Follows on from the previous piece.
+            lastPtr->len += length;
+            return;
+        }
+    }
+
+    if (batchPtr->segmentCount == SEND_MAX_SEGMENTS)
+    {
+        FlushBatch(batchPtr, false);
+    }
+
+    batchPtr->segments[batchPtr->segmentCount].buf = buf;
+    batchPtr->segments[batchPtr->segmentCount].len = length;
+    batchPtr->segmentCount++;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Add a copy of a small piece of the outgoing message, such as a re-encoded CBOR item
+ */
+//--------------------------------------------------------------------------------------------------
+static void CopyToBatch
+(
+    SendBatch_t* batchPtr,                ///< [IN] pointer to batch
+    const void* buf,                      ///< [IN] pointer to data
+    size_t length                         ///< [IN] size of data, at most CBOR_HEAD_MAX_SIZE
+)
+{
+    LE_ASSERT(length <= CBOR_HEAD_MAX_SIZE);
+
+    if ((batchPtr->scratchUsed + length > sizeof(batchPtr->scratch)) ||
+        (batchPtr->segmentCount == SEND_MAX_SEGMENTS))
+    {
+        FlushBatch(batchPtr, false);
+    }
+
+    uint8_t* copyPtr = batchPtr->scratch + batchPtr->scratchUsed;
+    memcpy(copyPtr, buf, length);
+    batchPtr->scratchUsed += length;
+    AddToBatch(batchPtr, copyPtr, length);
+}
+
+#ifdef RPC_PROXY_LOCAL_SERVICE
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Release a local buffer once the pieces of the message that refer to it have been written
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseAfterFlush
+(
+    SendBatch_t* batchPtr,                ///< [IN] pointer to batch
+    rpcProxy_LocalBuffer_t* bufferPtr     ///< [IN] buffer to release
+)
+{
+    if (batchPtr->releaseCount == NUM_ARRAY_MEMBERS(batchPtr->releaseList))
+    {
+        FlushBatch(batchPtr, false);
+    }
+
+    batchPtr->releaseList[batchPtr->releaseCount++] = bufferPtr;
+}
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Write the metadata of proxy message
@@ -927,19 +1131,19 @@ static void WriteMetaData
 {
     if (sendContextPtr->messagePtr->metaData.isFileStreamValid)
     {
-        uint8_t tempBuff[1 + sizeof(uint64_t)];
+        uint8_t tempBuff[CBOR_HEAD_MAX_SIZE];
         size_t encoded_size = cbor_encode_tag(LE_PACK_FILESTREAM_ID, tempBuff, sizeof(tempBuff));
-        le_comm_Send(sendContextPtr->handle, tempBuff, encoded_size);
+        CopyToBatch(sendContextPtr->batchPtr, tempBuff, encoded_size);
 
         encoded_size = cbor_encode_uint(sendContextPtr->messagePtr->metaData.fileStreamId, tempBuff, sizeof(tempBuff));
-        le_comm_Send(sendContextPtr->handle, tempBuff, encoded_size);
+        CopyToBatch(sendContextPtr->batchPtr, tempBuff, encoded_size);
 
         // pack flags:
         encoded_size = cbor_encode_tag(LE_PACK_FILESTREAM_FLAG, tempBuff, sizeof(tempBuff));
-        le_comm_Send(sendContextPtr->handle, tempBuff, encoded_size);
+        CopyToBatch(sendContextPtr->batchPtr, tempBuff, encoded_size);
 
         encoded_size = cbor_encode_uint(sendContextPtr->messagePtr->metaData.fileStreamFlags, tempBuff, sizeof(tempBuff));
-        le_comm_Send(sendContextPtr->handle, tempBuff, encoded_size);
+        CopyToBatch(sendContextPtr->batchPtr, tempBuff, encoded_size);
     }
 }
 
@@ -992,9 +1196,9 @@ static void WriteStringHeader
     uint64_t length                       ///< [IN] length of string.
 )
 {
-    uint8_t tempBuff [1 + sizeof(uint64_t)];
+    uint8_t tempBuff [CBOR_HEAD_MAX_SIZE];
     size_t encoded_size = cbor_encode_string_start(length, tempBuff, sizeof(tempBuff));
-    le_comm_Send(sendContextPtr->handle, tempBuff, encoded_size);
+    CopyToBatch(sendContextPtr->batchPtr, tempBuff, encoded_size);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1008,9 +1212,9 @@ static void WriteByteStringHeader
     uint64_t byteCount                    ///< [IN] length of string.
 )
 {
-    uint8_t tempBuff [1 + sizeof(uint64_t)];
+    uint8_t tempBuff [CBOR_HEAD_MAX_SIZE];
     size_t encoded_size = cbor_encode_bytestring_start(byteCount, tempBuff, sizeof(tempBuff));
-    le_comm_Send(sendContextPtr->handle, tempBuff, encoded_size);
+    CopyToBatch(sendContextPtr->batchPtr, tempBuff, encoded_size);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1026,17 +1230,18 @@ static void WriteOutStringSize
 )
 {
     // This is when we're writing the size for the outstring:
-    uint8_t tempBuff [1 + sizeof(uint64_t)];
+    uint8_t tempBuff [CBOR_HEAD_MAX_SIZE];
     size_t encoded_size = cbor_encode_tag(tag, tempBuff, sizeof(tempBuff));
-    le_comm_Send(sendContextPtr->handle, tempBuff, encoded_size);
+    CopyToBatch(sendContextPtr->batchPtr, tempBuff, encoded_size);
 
     encoded_size = cbor_encode_uint(length, tempBuff, sizeof(tempBuff));
-    le_comm_Send(sendContextPtr->handle, tempBuff, encoded_size);
+    CopyToBatch(sendContextPtr->batchPtr, tempBuff, encoded_size);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Write data that is buffered in a pointer directly to le_comm
+ *  Write data that is buffered in a pointer, without copying it.  The buffer must stay valid
+ *  until the message has been written.
  */
 //--------------------------------------------------------------------------------------------------
 static void WriteBufferedData
@@ -1048,7 +1253,7 @@ static void WriteBufferedData
 {
 
     uint8_t* buff = (uint8_t*) pointer;
-    le_comm_Send(sendContextPtr->handle, buff, length);
+    AddToBatch(sendContextPtr->batchPtr, buff, length);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1067,7 +1272,7 @@ static void WriteStringResponse
     size_t length, encodedSize;
     rpcProxy_LocalBuffer_t *paramBuffer =
         PopNextOutputParameter(sendContextPtr->messagePtr->commonHeader.id);
-    uint8_t tempBuff [1 + sizeof(uint64_t)];
+    uint8_t tempBuff [CBOR_HEAD_MAX_SIZE];
 
     LE_ASSERT(paramBuffer);
 
@@ -1082,12 +1287,13 @@ static void WriteStringResponse
                  length);
 
         encodedSize = cbor_encode_tag(LE_PACK_OUT_STRING_RESPONSE, tempBuff, sizeof(tempBuff));
-        le_comm_Send(sendContextPtr->handle, tempBuff, encodedSize);
+        CopyToBatch(sendContextPtr->batchPtr, tempBuff, encodedSize);
         WriteStringHeader(sendContextPtr, length);
         WriteBufferedData(sendContextPtr, (uintptr_t)paramBuffer->bufferData, length);
     }
 
-    le_mem_Release(paramBuffer);
+    // The string data is written straight from the buffer, so keep it until then.
+    ReleaseAfterFlush(sendContextPtr->batchPtr, paramBuffer);
 }
 #endif
 
@@ -1209,9 +1415,9 @@ static void ReferenceCallback
                                               &newContext,
                                               sendContextPtr->messagePtr);
         //new write the new context:
-        uint8_t tempBuff[1 + sizeof(uint64_t)];
+        uint8_t tempBuff[CBOR_HEAD_MAX_SIZE];
         size_t encoded_size = cbor_encode_uint((uintptr_t)newContext, tempBuff, sizeof(tempBuff));
-        le_comm_Send(sendContextPtr->handle, tempBuff, encoded_size);
+        CopyToBatch(sendContextPtr->batchPtr, tempBuff, encoded_size);
     }
     // clear the tag now:
     sendContextPtr->lastTag = 0;
@@ -1349,7 +1555,8 @@ static void OptByteStringResponseCallback
         WriteBufferedData(sendContextPtr, (uintptr_t)paramBuffer->bufferData, value);
     }
 
-    le_mem_Release(paramBuffer);
+    // The byte string data is written straight from the buffer, so keep it until then.
+    ReleaseAfterFlush(sendContextPtr->batchPtr, paramBuffer);
 
     // clear the tag now:
     sendContextPtr->lastTag = 0;
@@ -1359,83 +1566,62 @@ static void OptByteStringResponseCallback
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Send out a file stream message body
+ * Collect a file stream message body
  * @return
- *      - LE_OK transmission was successful.
- *      - LE_FAULT an error happened during transmission.
+ *      - LE_OK if the message body was collected.
+ *      - LE_FAULT if the message can't be sent.
  */
 //--------------------------------------------------------------------------------------------------
 static le_result_t rpcProxy_SendFileStreamMessageBody
 (
-    void* handle, ///< [IN] Opaque handle to the le_comm communication channel
+    SendBatch_t* batchPtr, ///< [IN] Batch collecting the outgoing message
     rpcProxy_FileStreamMessage_t* messagePtr ///< [IN] Void pointer to the message buffer
 )
 {
     le_result_t ret = LE_OK;
     if (messagePtr->metaData.isFileStreamValid)
     {
-        uint8_t tempBuff[1 + sizeof(uint64_t)];
+        uint8_t tempBuff[CBOR_HEAD_MAX_SIZE];
         size_t encoded_size = cbor_encode_indef_array_start(tempBuff, sizeof(tempBuff));
-        ret = le_comm_Send(handle, tempBuff, encoded_size);
+        CopyToBatch(batchPtr, tempBuff, encoded_size);
 
         // pack the stream id:
-        if (ret == LE_OK)
-        {
-            encoded_size = cbor_encode_tag(LE_PACK_FILESTREAM_ID, tempBuff, sizeof(tempBuff));
-            ret = le_comm_Send(handle, tempBuff, encoded_size);
-        }
+        encoded_size = cbor_encode_tag(LE_PACK_FILESTREAM_ID, tempBuff, sizeof(tempBuff));
+        CopyToBatch(batchPtr, tempBuff, encoded_size);
 
-        if (ret == LE_OK)
-        {
-            encoded_size = cbor_encode_uint(messagePtr->metaData.fileStreamId, tempBuff,
-                                              sizeof(tempBuff));
-            ret = le_comm_Send(handle, tempBuff, encoded_size);
-        }
+        encoded_size = cbor_encode_uint(messagePtr->metaData.fileStreamId, tempBuff,
+                                        sizeof(tempBuff));
+        CopyToBatch(batchPtr, tempBuff, encoded_size);
 
         // pack flags:
-        if (ret == LE_OK)
-        {
-            encoded_size = cbor_encode_tag(LE_PACK_FILESTREAM_FLAG, tempBuff, sizeof(tempBuff));
-            ret = le_comm_Send(handle, tempBuff, encoded_size);
-        }
+        encoded_size = cbor_encode_tag(LE_PACK_FILESTREAM_FLAG, tempBuff, sizeof(tempBuff));
+        CopyToBatch(batchPtr, tempBuff, encoded_size);
 
-        if (ret == LE_OK)
-        {
-            encoded_size = cbor_encode_uint(messagePtr->metaData.fileStreamFlags, tempBuff,
-                                            sizeof(tempBuff));
-            ret = le_comm_Send(handle, tempBuff, encoded_size);
-        }
+        encoded_size = cbor_encode_uint(messagePtr->metaData.fileStreamFlags, tempBuff,
+                                        sizeof(tempBuff));
+        CopyToBatch(batchPtr, tempBuff, encoded_size);
 
         // pack data as byte string:
-        if (ret == LE_OK && messagePtr->payloadSize != 0)
+        if (messagePtr->payloadSize != 0)
         {
             encoded_size = cbor_encode_bytestring_start(messagePtr->payloadSize, tempBuff,
                                                         sizeof(tempBuff));
-            ret = le_comm_Send(handle, tempBuff, encoded_size);
-            if (ret == LE_OK)
-            {
-                ret = le_comm_Send(handle, messagePtr->payload, messagePtr->payloadSize);
-            }
+            CopyToBatch(batchPtr, tempBuff, encoded_size);
+            AddToBatch(batchPtr, messagePtr->payload, messagePtr->payloadSize);
         }
 
-        if (ret == LE_OK && messagePtr->requestedSize != 0)
+        if (messagePtr->requestedSize != 0)
         {
             encoded_size = cbor_encode_tag(LE_PACK_FILESTREAM_REQUEST_SIZE, tempBuff, sizeof(tempBuff));
-            ret = le_comm_Send(handle, tempBuff, encoded_size);
+            CopyToBatch(batchPtr, tempBuff, encoded_size);
 
-            if (ret == LE_OK)
-            {
-                encoded_size = cbor_encode_uint(messagePtr->requestedSize, tempBuff,
-                                                  sizeof(tempBuff));
-                ret = le_comm_Send(handle, tempBuff, encoded_size);
-            }
+            encoded_size = cbor_encode_uint(messagePtr->requestedSize, tempBuff,
+                                            sizeof(tempBuff));
+            CopyToBatch(batchPtr, tempBuff, encoded_size);
         }
         //pack break:
-        if (ret == LE_OK)
-        {
-            encoded_size = cbor_encode_break(tempBuff, sizeof(tempBuff));
-            ret = le_comm_Send(handle, tempBuff, encoded_size);
-        }
+        encoded_size = cbor_encode_break(tempBuff, sizeof(tempBuff));
+        CopyToBatch(batchPtr, tempBuff, encoded_size);
     }
     else
     {
@@ -1447,21 +1633,21 @@ static le_result_t rpcProxy_SendFileStreamMessageBody
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Stream an outgoing message
+ *  Collect the body of an outgoing IPC message
  *  @return
- *      - LE_OK if message was transmitted successfully
- *      - LE_FAULT in case of error in transmission.
+ *      - LE_OK if the message body was collected.
+ *      - LE_FAULT if the message can't be parsed.
  */
 //--------------------------------------------------------------------------------------------------
 static le_result_t rpcProxy_SendIpcMessageBody
 (
-    void* handle, ///< [IN] Opaque handle to the le_comm communication channel
+    SendBatch_t* batchPtr, ///< [IN] Batch collecting the outgoing message
     rpcProxy_Message_t* messagePtr ///< [IN] Void pointer to the message buffer
 )
 {
     SendContext_t context;
     memset(&context, 0, sizeof(context));
-    context.handle = handle;
+    context.batchPtr = batchPtr;
     context.messagePtr = messagePtr;
     context.lastCallbackRes = LE_OK;
     context.state = SEND_INITIAL_STATE;
@@ -1472,7 +1658,7 @@ static le_result_t rpcProxy_SendIpcMessageBody
     uint32_t id = 0;
     memcpy((uint8_t*) &id, msgBuff, IPC_MSG_ID_SIZE);
     id = htobe32(id);
-    le_comm_Send(context.handle, (uint8_t*) &id, sizeof(uint32_t));
+    CopyToBatch(batchPtr, (uint8_t*) &id, sizeof(uint32_t));
     msgBuff += sizeof(uint32_t);
     maxLength -= sizeof(uint32_t);
 
@@ -1497,11 +1683,7 @@ static le_result_t rpcProxy_SendIpcMessageBody
             LE_INFO("RPC Sending:");
             LE_LOG_DUMP(LE_LOG_INFO, msgBuff+bytes_read, decode_result.read);
 #endif
-            if (le_comm_Send(context.handle, msgBuff+bytes_read, decode_result.read) != LE_OK)
-            {
-                ret = LE_COMM_ERROR;
-                break;
-            }
+            AddToBatch(batchPtr, msgBuff+bytes_read, decode_result.read);
         }
 
         // check whether we're done:
@@ -1521,27 +1703,54 @@ static le_result_t rpcProxy_SendIpcMessageBody
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Send out the body of a variable length message
+ *  Send out a variable length message, header and body, in as few writes as possible
  *  @return
  *      - LE_OK if message was transmitted successfully
- *      - LE_FAULT in case of error in transmission.
+ *      - LE_FAULT if the message can't be sent (nothing has been written, unless the message was
+ *        too big to be written all at once).
+ *      - LE_COMM_ERROR in case of error in transmission.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t rpcProxy_SendVariableLengthMsgBody
+le_result_t rpcProxy_SendVariableLengthMsg
 (
     void* handle, ///< [IN] Opaque handle to the le_comm communication channel
-    void* messagePtr ///< [IN] Void pointer to the message buffer
+    void* messagePtr, ///< [IN] Void pointer to the message buffer
+    uint32_t* writeCountPtr ///< [OUT] Number of writes made to le_comm
 )
 {
+    SendBatch_t* batchPtr = &SendBatch;
     rpcProxy_CommonHeader_t* commonHeaderPtr = (rpcProxy_CommonHeader_t*) messagePtr;
+    rpcProxy_CommonHeader_t header;
+    le_result_t result;
+
+    StartBatch(batchPtr, handle);
+
+    // The message itself is left in host byte order, as the body is parsed using it.
+    header.id = htobe32(commonHeaderPtr->id);
+    header.serviceId = htobe32(commonHeaderPtr->serviceId);
+    header.type = commonHeaderPtr->type;
+    CopyToBatch(batchPtr, &header, RPC_PROXY_COMMON_HEADER_SIZE);
+
     if (commonHeaderPtr->type == RPC_PROXY_FILESTREAM_MESSAGE)
     {
-        return rpcProxy_SendFileStreamMessageBody(handle, (rpcProxy_FileStreamMessage_t*)messagePtr);
+        result = rpcProxy_SendFileStreamMessageBody(batchPtr,
+                                                    (rpcProxy_FileStreamMessage_t*)messagePtr);
     }
     else
     {
-        return rpcProxy_SendIpcMessageBody(handle, (rpcProxy_Message_t*) messagePtr);
+        result = rpcProxy_SendIpcMessageBody(batchPtr, (rpcProxy_Message_t*) messagePtr);
+    }
+
+    // Don't write out a message that couldn't be collected in full.
+    FlushBatch(batchPtr, (result != LE_OK));
+
+    if (result == LE_OK)
+    {
+        result = batchPtr->result;
     }
+    *writeCountPtr = batchPtr->writeCount;
+
+    return result;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -3147,6 +3356,9 @@ static le_result_t FileStreamMessageStreamInitializer
 {
     rpcProxy_FileStreamMessage_t* fileStreamMsgPtr = (rpcProxy_FileStreamMessage_t*) proxyMessagePtr;
     fileStreamMsgPtr->metaData.isFileStreamValid = false;
+    // Neither is sent when zero, so don't let them carry over from the previous message.
+    fileStreamMsgPtr->payloadSize = 0;
+    fileStreamMsgPtr->requestedSize = 0;
     GoToCborHeaderState(streamStatePtr);
     return LE_OK;
 }
@@ -510,6 +510,130 @@ bool le_cbor_EncodeNull
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of unsigned 8-bit integers into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as its own
+ * item in the shortest form, so the result is the same as an array header followed by one
+ * le_cbor_EncodePositiveInteger() call per value.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeUint8Array
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const uint8_t* valuesPtr,       ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of unsigned 16-bit integers into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as its own
+ * item in the shortest form, so the result is the same as an array header followed by one
+ * le_cbor_EncodePositiveInteger() call per value.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeUint16Array
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const uint16_t* valuesPtr,      ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of unsigned 32-bit integers into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as its own
+ * item in the shortest form, so the result is the same as an array header followed by one
+ * le_cbor_EncodePositiveInteger() call per value.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeUint32Array
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const uint32_t* valuesPtr,      ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of unsigned 64-bit integers into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as its own
+ * item in the shortest form, so the result is the same as an array header followed by one
+ * le_cbor_EncodePositiveInteger() call per value.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeUint64Array
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const uint64_t* valuesPtr,      ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of floats into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as a
+ * single precision float item.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeFloatArray
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const float* valuesPtr,         ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of doubles into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as a
+ * double precision float item.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeDoubleArray
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const double* valuesPtr,        ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Decode an integer from a buffer, increment the buffer pointer if decoding is successful
@@ -867,6 +991,126 @@ bool le_cbor_DecodeTag
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of unsigned 8-bit integers from a buffer, increment the buffer pointer if decoding is
+ * successful. Values too big for the output
+ * type are rejected.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeUint8Array
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    uint8_t* valuesPtr,             ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of unsigned 16-bit integers from a buffer, increment the buffer pointer if decoding is
+ * successful. Values too big for the output
+ * type are rejected.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeUint16Array
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    uint16_t* valuesPtr,            ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of unsigned 32-bit integers from a buffer, increment the buffer pointer if decoding is
+ * successful. Values too big for the output
+ * type are rejected.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeUint32Array
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    uint32_t* valuesPtr,            ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of unsigned 64-bit integers from a buffer, increment the buffer pointer if decoding is
+ * successful. Values too big for the output
+ * type are rejected.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeUint64Array
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    uint64_t* valuesPtr,            ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of floats from a buffer, increment the buffer pointer if decoding is
+ * successful. Each item must be a single
+ * precision float.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeFloatArray
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    float* valuesPtr,               ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of doubles from a buffer, increment the buffer pointer if decoding is
+ * successful. Each item must be a double
+ * precision float.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeDoubleArray
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    double* valuesPtr,              ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Decode one item from cbor stream in buffer, increment the buffer pointer and decrease the
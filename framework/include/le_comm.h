@@ -127,6 +127,38 @@ LE_SHARED le_result_t le_comm_Send
     size_t len          ///< [IN] Size of data to be sent.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Segment of data to be sent by le_comm_SendVector().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const void* buf;    ///< Pointer to data to be sent.
+    size_t len;         ///< Size of data to be sent.
+}
+le_comm_Segment_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for Sending a list of data segments over a RPC Communication Channel, as if they had
+ * been concatenated and sent with one call to le_comm_Send().
+ *
+ * This function is optional.  Callers must check that it is implemented (i.e., that
+ * le_comm_SendVector is not NULL), and call le_comm_Send() for each segment in turn if it isn't.
+ *
+ * @return
+ *      - LE_OK if successfully.
+ */
+//--------------------------------------------------------------------------------------------------
+__attribute__((weak))
+LE_SHARED le_result_t le_comm_SendVector
+(
+    void* handle,                       ///< [IN] Communication channel.
+    const le_comm_Segment_t* segments,  ///< [IN] Segments of data to be sent, in order.
+    size_t count                        ///< [IN] Number of segments.
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function for Receiving Data over a RPC Communication Channel
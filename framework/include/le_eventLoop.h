@@ -1006,6 +1006,8 @@ void le_event_QueueFunctionToThread
  * It's generally better to ensure the event is only generated once, for example by disabling
  * generating the event until the event handler is run.
  *
+ * @note Only functions that were queued using this function are checked for.
+ *
  * @return LE_OK if the function was queued to the Event Queue
  * @return LE_DUPLICATE if the function was already in the Event Queue
  */
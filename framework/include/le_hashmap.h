@@ -17,13 +17,28 @@
  * type of key that you intend to store. It's unwise to mix types in a single table because
  * implementation of the table has no way to detect this behaviour.
  *
- * Choose the initial size should carefully as the index size remains fixed. The best
- * choice for the initial size is a prime number slightly larger than the
+ * Choose the initial size of a static hashmap carefully as its index size remains fixed. The
+ * best choice for the initial size is a prime number slightly larger than the
  * maximum expected capacity. If a too small size is chosen, there will be an
  * increase in collisions that degrade performance over time.
  *
+ * Hashmaps created on the heap grow automatically once they are more than three-quarters
+ * full.  Growing is incremental: a larger index is allocated and the existing entries are moved
+ * into it a few buckets at a time by subsequent le_hashmap_Put() and le_hashmap_Remove() calls,
+ * so no single call has to rehash the whole map.  The initial capacity of such a map is only a
+ * hint, but choosing it well still avoids the cost of growing.
+ *
  * All hashmaps have names for diagnostic purposes.
  *
+ * @subsection c_hashmap_open Open Addressing
+ *
+ * @c le_hashmap_CreateOpenAddressed() creates a heap hashmap which stores its key-value pairs
+ * directly in the index (Robin Hood open addressing) rather than in per-bucket lists of
+ * separately allocated entries.  The stored hash of each key is kept alongside it, so most failed
+ * comparisons never call the equality function, and lookups walk a contiguous array instead of
+ * chasing list pointers.  This is usually faster for small keys and read-mostly maps, at the cost
+ * of a larger index.  The API, including iteration, is otherwise identical.
+ *
  * @section c_hashmap_insert Adding key-value pairs
  *
  * Key-value pairs are added using le_hashmap_Put(). For example:
@@ -98,8 +113,10 @@
  * This code sample shows the callback function must also be aware of the
  * types stored in the table.
  *
- * However, keep in mind that it is unsafe and undefined to modify the map during
- * this style of iteration.
+ * The callback may add entries to the map and remove the entry it was called with.  The map
+ * does not move its entries until the iteration ends, and it is not guaranteed that newly added
+ * entries will be visited.  Removing any other entry during this style of iteration is unsafe
+ * and undefined.
  *
  * Alternatively, the calling function can control the iteration by first
  * calling @c le_hashmap_GetIterator(). This returns an iterator that is ready
@@ -121,6 +138,12 @@
  * le_hashmap_GetKey, and le_hashmap_GetValue will return NULL until either,
  * le_hashmap_NextNode, or le_hashmap_PrevNode are called.
  *
+ * A heap hashmap does not move existing entries between buckets while its iterator is in the
+ * middle of the map, so growing the map does not cause entries to be skipped or repeated.  The
+ * one exception is an open-addressed map to which so many items are added during a single
+ * iteration that its index fills up; the map is then rebuilt and iteration continues from the
+ * current item's new position, so some items may be skipped or visited twice.
+ *
  * For example (assuming a table of string/string):
  *
  * @code
@@ -265,6 +288,21 @@ typedef struct le_hashmap_Entry
 }
 le_hashmap_Entry_t;
 
+/**
+ * A slot in an open-addressed hashmap
+ *
+ * @note This is an internal structure which should not be instantiated directly
+ */
+typedef struct le_hashmap_Slot
+{
+    const void          *keyPtr;        ///< Pointer to key data.
+    const void          *valuePtr;      ///< Pointer to value data.
+    size_t               hash;          ///< Hash of the key.
+    uint32_t             distance;      ///< Distance of the slot from the key's home slot.
+    uint8_t              state;         ///< Whether the slot is empty, in use or deleted.
+}
+le_hashmap_Slot_t;
+
 /**
  * A hashmap iterator
  *
@@ -274,6 +312,7 @@ typedef struct le_hashmap_It
 {
     size_t               currentIndex;      ///< Current bucket index.
     le_hashmap_Link_t   *currentLinkPtr;    ///< Current bucket list item pointer.
+    le_hashmap_Slot_t   *currentSlotPtr;    ///< Current slot pointer (open addressing only).
 }
 le_hashmap_HashmapIt_t;
 
@@ -290,9 +329,16 @@ typedef struct le_hashmap
     le_hashmap_HashFunc_t    hashFuncPtr;   ///< Hash operator.
 
     le_hashmap_Bucket_t     *bucketsPtr;    ///< Pointer to the array of hash map buckets.
+    le_hashmap_Bucket_t     *oldBucketsPtr; ///< Buckets still being rehashed into bucketsPtr.
+    le_hashmap_Slot_t       *slotsPtr;      ///< Pointer to the array of slots (open addressing).
+    le_hashmap_Slot_t       *oldSlotsPtr;   ///< Slots still being rehashed into slotsPtr.
     le_mem_PoolRef_t         entryPoolRef;  ///< Memory pool to expand into for expanding buckets.
-    size_t                   bucketCount;   ///< Number of buckets.
+    size_t                   bucketCount;   ///< Number of buckets (or slots).
+    size_t                   oldBucketCount;///< Number of old buckets (or slots), 0 if not rehashing.
+    size_t                   rehashIndex;   ///< Next old bucket (or slot) to be rehashed.
     size_t                   size;          ///< Number of inserted entries.
+    size_t                   numDeleted;    ///< Number of deleted slots (open addressing).
+    uint8_t                  flags;         ///< Internal flags.
 
 #if LE_CONFIG_HASHMAP_NAMES_ENABLED
     const char               *nameStr;        ///< Name of the hashmap for diagnostic purposes.
@@ -307,8 +353,8 @@ le_hashmap_Hashmap_t;
 /**
  * Create a HashMap.
  *
- * If you create a hashmap with a smaller capacity than you actually use, then
- * the map will continue to work, but performance will degrade the more you put in the map.
+ * If you create a hashmap with a smaller capacity than you actually use, then the map will grow
+ * as entries are added.  Choosing a capacity close to the number of entries avoids this cost.
  *
  *  @param[in]  nameStr     Name of the HashMap.  This must be a static string as it is not copied.
  *  @param[in]  capacity    Size of the hashmap
@@ -345,8 +391,8 @@ le_hashmap_Ref_t _le_hashmap_Create
 /**
  * Create a HashMap.
  *
- * If you create a hashmap with a smaller capacity than you actually use, then
- * the map will continue to work, but performance will degrade the more you put in the map.
+ * If you create a hashmap with a smaller capacity than you actually use, then the map will grow
+ * as entries are added.  Choosing a capacity close to the number of entries avoids this cost.
  *
  *  @param[in]  nameStr     Name of the HashMap.  This must be a static string as it is not copied.
  *  @param[in]  capacity    Size of the hashmap
@@ -371,6 +417,75 @@ LE_DECLARE_INLINE le_hashmap_Ref_t le_hashmap_Create
 }
 #endif /* end LE_CONFIG_HASHMAP_NAMES_ENABLED */
 
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a HashMap which uses open addressing.
+ *
+ * The map behaves exactly like one created by le_hashmap_Create(), but stores its entries
+ * directly in the index.  See @ref c_hashmap_open.
+ *
+ *  @param[in]  nameStr     Name of the HashMap.  This must be a static string as it is not copied.
+ *  @param[in]  capacity    Expected number of entries in the hashmap
+ *  @param[in]  hashFunc    Hash function
+ *  @param[in]  equalsFunc  Equality function
+ *
+ *  @return  Returns a reference to the map.
+ *
+ *  @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t le_hashmap_CreateOpenAddressed
+(
+    const char                *nameStr,
+    size_t                     capacity,
+    le_hashmap_HashFunc_t      hashFunc,
+    le_hashmap_EqualsFunc_t    equalsFunc
+);
+#else /* if not LE_CONFIG_HASHMAP_NAMES_ENABLED */
+/// @cond HIDDEN_IN_USER_DOCS
+//--------------------------------------------------------------------------------------------------
+/**
+ * Internal function used to implement le_hashmap_CreateOpenAddressed().
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t _le_hashmap_CreateOpenAddressed
+(
+    size_t                     capacity,
+    le_hashmap_HashFunc_t      hashFunc,
+    le_hashmap_EqualsFunc_t    equalsFunc
+);
+/// @endcond
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a HashMap which uses open addressing.
+ *
+ * The map behaves exactly like one created by le_hashmap_Create(), but stores its entries
+ * directly in the index.  See @ref c_hashmap_open.
+ *
+ *  @param[in]  nameStr     Name of the HashMap.  This must be a static string as it is not copied.
+ *  @param[in]  capacity    Expected number of entries in the hashmap
+ *  @param[in]  hashFunc    Hash function
+ *  @param[in]  equalsFunc  Equality function
+ *
+ *  @return  Returns a reference to the map.
+ *
+ *  @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE le_hashmap_Ref_t le_hashmap_CreateOpenAddressed
+(
+    const char                *nameStr,
+    size_t                     capacity,
+    le_hashmap_HashFunc_t      hashFunc,
+    le_hashmap_EqualsFunc_t    equalsFunc
+)
+{
+    LE_UNUSED(nameStr);
+    return _le_hashmap_CreateOpenAddressed(capacity, hashFunc, equalsFunc);
+}
+#endif /* end LE_CONFIG_HASHMAP_NAMES_ENABLED */
+
 
 
 //--------------------------------------------------------------------------------------------------
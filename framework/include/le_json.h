@@ -54,6 +54,14 @@
  * event handler function or any function being called (directly or indirectly) from a JSON
  * parsing event handler.  Calling these functions elsewhere will be fatal to the calling process.
  *
+ * Strings are normally limited to the size of the parser's internal buffer
+ * (@c LE_CONFIG_JSON_PARSER_BUFFER_SIZE), and a longer string is reported as an error.  An event
+ * handler that expects long strings (such as base64-encoded content) can call
+ * le_json_SetStringSlices() to lift this limit, and then fetch strings using
+ * le_json_GetStringSlice(), which returns a pointer to the string where it lies in the parser's
+ * input, without copying it.  le_json_GetStringSlice() can also be used for any string to avoid a
+ * copy, but note that the string it returns is not null-terminated.
+ *
  *  @section c_json_context Context
  *
  * Each JSON object, object member and array in the JSON document is a "context".
@@ -82,6 +90,15 @@
  * To get the number of bytes that have been read by the parser since le_json_Parse() was called,
  * call le_json_GetBytesRead().
  *
+ *  @section c_json_input Input
+ *
+ * When parsing from a file descriptor, the parser never consumes any input beyond the end of the
+ * JSON document, so anything following the document can still be read from the file descriptor
+ * once the LE_JSON_DOC_END event has been reported.  To do this efficiently, regular files are
+ * mapped into memory, other file descriptors that can be repositioned are read in blocks of
+ * @c LE_CONFIG_JSON_READ_BUFFER_SIZE bytes (seeking back over anything not used), and stream
+ * sockets are peeked at.  Pipes and terminals are read one byte at a time.
+ *
  *  @section c_json_example Example
  *
  * If the JSON document is
@@ -385,6 +402,43 @@ LE_API_JSON const char* le_json_GetString
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetches a string value or object member name without copying it.
+ *
+ * The string is not null-terminated, and is only valid until the event handler returns.
+ *
+ * @return Pointer to the first byte of the string.
+ *
+ * @warning This function can only be called inside event handlers when LE_JSON_OBJECT_MEMBER
+ *          or LE_JSON_STRING events are being handled.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_API_JSON const char* le_json_GetStringSlice
+(
+    size_t* lenPtr  ///< [OUT] Length of the string, in bytes.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allows strings that are too long for the parser's internal buffer, from now on in the current
+ * parsing session.  Such strings can only be fetched using le_json_GetStringSlice();
+ * le_json_GetString() will be fatal to the calling process.
+ *
+ * @note A long string that is split across two blocks of input still has to be copied into the
+ *       internal buffer, and will be reported as an error if it doesn't fit.  This can only happen
+ *       when parsing from a file descriptor that isn't a regular file.
+ *
+ * @warning This function can only be called inside event or error handlers.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_API_JSON void le_json_SetStringSlices
+(
+    bool enable     ///< [IN] true to allow long strings.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the value of a parsed number.
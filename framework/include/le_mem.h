@@ -297,6 +297,25 @@
  * the data structure, then the mutex must be held by the thread that calls le_mem_Release() to
  * ensure there's no other thread accessing the data structure when the destructor runs.
  *
+ * @subsection mem_thread_cache Per-Thread Caches
+ *
+ * Every pool operation normally takes a single process-wide lock, so pools that are heavily used
+ * from several threads at once can become a point of contention.  When the
+ * @c LE_CONFIG_MEM_THREAD_CACHE build option is enabled, @c le_mem_EnableThreadCache() can be
+ * used to give such a pool a small cache of free blocks in each thread that uses it.
+ * Allocations and releases are then served from the calling thread's cache without taking the
+ * lock; the cache is refilled from the pool (or flushed back to it) half a cache at a time.
+ *
+ * @code
+ *     MyPool = le_mem_CreatePool("MyPool", sizeof(MyObj_t));
+ *     le_mem_ExpandPool(MyPool, MY_POOL_SIZE);
+ *     le_mem_EnableThreadCache(MyPool, 16);
+ * @endcode
+ *
+ * A thread cache must be enabled before the pool is used, and cannot be enabled on a sub-pool.
+ * Blocks held in a thread's cache are reported as in use by @c le_mem_GetStats(), and are
+ * returned to the pool when the thread exits.
+ *
  * @section mem_pool_sizes Managing Pool Sizes
  *
  * We know it's possible to have pools automatically expand
@@ -529,6 +548,11 @@ typedef struct le_mem_Pool
 #endif
 
     le_mem_Destructor_t destructor;     ///< The destructor for objects in this pool.
+#if LE_CONFIG_MEM_THREAD_CACHE
+    size_t threadCacheSize;             ///< Maximum number of free blocks cached per thread
+                                        ///  (0 if per-thread caching is disabled).
+    pthread_key_t threadCacheKey;       ///< Key for this pool's per-thread cache.
+#endif
 #if LE_CONFIG_MEM_POOL_NAMES_ENABLED
     char name[LE_MEM_LIMIT_MAX_MEM_POOL_NAME_BYTES]; ///< Name of the pool.
 #endif
@@ -1104,6 +1128,26 @@ void le_mem_SetNumObjsToForce
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gives each thread that uses a pool its own cache of free blocks, so that allocations and
+ * releases in that pool don't contend on the memory pool lock.  See @ref mem_thread_cache.
+ *
+ * @return  A reference to the memory pool object (the same value passed into it).
+ *
+ * @note
+ *      - Must be called before any object is allocated from the pool.
+ *      - Sub-pools cannot have thread caches.
+ *      - Does nothing if @c LE_CONFIG_MEM_THREAD_CACHE is not enabled.
+ */
+//--------------------------------------------------------------------------------------------------
+le_mem_PoolRef_t le_mem_EnableThreadCache
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] Pool to enable per-thread caching for.
+    size_t              numObjects  ///< [IN] Maximum number of free objects cached per thread.
+);
+
+
 #if !LE_CONFIG_MEM_TRACE
     //----------------------------------------------------------------------------------------------
     /**
@@ -1048,6 +1048,33 @@ LE_FULL_API le_msg_ProtocolRef_t le_msg_GetProtocolRef
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a reference to refer to a particular version of a particular protocol, with message pools
+ * sized for the protocol's messages.
+ *
+ * Like le_msg_GetProtocolRef(), but also carves a reduced-size message pool out of the protocol's
+ * message pool for each given size class, so that messages created with le_msg_CreateSizedMsg()
+ * don't take up a block big enough for the protocol's largest message.  Each of the protocol's
+ * pools gets at least @c numMsgs messages pre-allocated.
+ *
+ * The size classes are only used by the first call for a given protocol.  Later calls only make
+ * sure that at least @c numMsgs messages are pre-allocated in each pool.
+ *
+ * @return  Protocol reference.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_FULL_API le_msg_ProtocolRef_t le_msg_GetProtocolRefWithPools
+(
+    const char* protocolId,     ///< [in] String uniquely identifying the the protocol and version.
+    size_t largestMsgSize,      ///< [in] Size (in bytes) of the largest message in the protocol.
+    const size_t* sizeClassesPtr, ///< [in] Smaller message sizes (in bytes), largest first.
+                                  ///       May be NULL if numSizeClasses is 0.
+    size_t numSizeClasses,      ///< [in] Number of entries in sizeClassesPtr.
+    size_t numMsgs              ///< [in] Number of messages to pre-allocate in each pool.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the unique identifier string of the protocol.
@@ -1411,6 +1438,30 @@ le_msg_MessageRef_t le_msg_CreateMsg
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a message to be sent over a given session, with a payload buffer of at least a given
+ * size.
+ *
+ * The message is allocated from the smallest of the protocol's message pools that will hold the
+ * payload (see le_msg_GetProtocolRefWithPools()).  le_msg_GetMaxPayloadSize() tells how big the
+ * payload buffer actually is.
+ *
+ * @return  Message reference.
+ *
+ * @note
+ * - Function never returns on failure, there's no need to check the return code.
+ * - It is a fatal error to ask for a payload larger than the protocol's largest message.
+ * - Messages on local sessions are always created with the largest message size.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t le_msg_CreateSizedMsg
+(
+    le_msg_SessionRef_t sessionRef, ///< [in] Reference to the session.
+    size_t              payloadSize ///< [in] Largest payload that will be put in the message.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Adds to the reference count on a message object.
@@ -1480,6 +1531,27 @@ size_t le_msg_GetMaxPayloadSize
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the number of bytes at the start of the message payload that are actually in use.
+ *
+ * Only that many bytes are copied when the message is sent to another process, which saves
+ * copying the unused tail of the payload buffer.  Messages start out with the whole buffer
+ * in use (see le_msg_GetMaxPayloadSize()).
+ *
+ * @note Must be called again if more of the payload is filled in later (e.g., when a received
+ *       request message is re-used for the response).
+ *
+ * @note It is a fatal error to pass a size larger than le_msg_GetMaxPayloadSize().
+ */
+//--------------------------------------------------------------------------------------------------
+void le_msg_SetPayloadSize
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t              size        ///< [in] Number of payload bytes in use.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the file descriptor to be sent with this message.
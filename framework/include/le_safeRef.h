@@ -56,6 +56,11 @@
  * than just acting as if it were a valid reference and clobbering the object's deallocated
  * memory or some other object that's reusing the old object's memory.
  *
+ * A deleted Safe Reference stays invalid after the Reference Map reuses its storage for a new
+ * Safe Reference: each reuse of a slot gives the new Safe Reference a different generation number,
+ * so an old Safe Reference is only mistaken for a new one after the same slot has been reused
+ * 256 times.
+ *
  * @section c_safeRef_map Create Reference Map
  *
  * A <b> Reference Map </b> object can be used to create Safe References and keep track of the
@@ -225,8 +230,10 @@ typedef struct le_ref_Iter *le_ref_IterRef_t;
 struct le_ref_Block;
 
 
-// Internal block sizing
-#define LE_REF_BLOCK_SIZE(numRefs)  (1 + (numRefs))
+// Internal block sizing: a link to the next block, a pointer slot for each reference, then a
+// 32-bit generation and free list word for each reference.
+#define LE_REF_BLOCK_SIZE(numRefs)                                                                \
+    (1 + (numRefs) + ((numRefs) * sizeof(uint32_t) + sizeof(void *) - 1) / sizeof(void *))
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -250,7 +257,12 @@ struct le_ref_Map
     size_t               maxRefs;   ///< Nominal maximum number of safe references.
     uint32_t             mapBase;   ///< Randomized "base" for references in this map.
 
+    size_t               freeIndex; ///< Most recently freed slot (index + 1), or 0 if none.
+    size_t               usedCount; ///< Number of slots that have ever been used.
+
     struct le_ref_Block *blocksPtr; ///< Block list head.
+    struct le_ref_Block **overflowTablePtr; ///< Overflow blocks, indexed by block number - 1.
+    size_t               overflowTableSize; ///< Number of entries allocated in overflowTablePtr.
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -22,6 +22,7 @@
  *  - le_timer_SetInterval() (or le_timer_SetMsInterval())
  *  - le_timer_SetRepeat()
  *  - le_timer_SetContextPtr()
+ *  - le_timer_SetSlack() (or le_timer_SetMsSlack())
  *
  * The following attributes of the timer can be retrieved:
  *  - le_timer_GetInterval() (or le_timer_GetMsInterval())
@@ -67,6 +68,12 @@
  * In addition, a suspended system will also wake up by default if the timer expires. If this behaviour
  * is not desired, user can disable the wake up by passing false into le_timer_SetWakeup().
  *
+ * Timers that do not need to expire at a precise time can be given some slack with
+ * le_timer_SetSlack() or le_timer_SetMsSlack().  The expiry handler of such a timer may be called
+ * up to the slack period after the timer's expiry time, which lets the timer module expire several
+ * timers on a single wakeup rather than waking up the thread (and possibly the system) for each
+ * of them.  The slack defaults to zero.
+ *
  * The number of times that a timer has expired can be retrieved by le_timer_GetExpiryCount(). This
  * count is independent of whether there is an expiry handler for the timer.
  *
@@ -110,6 +117,8 @@
  *     - le_timer_GetTimeRemaining()
  *     - le_timer_GetMsTimeRemaining()
  *     - le_timer_SetWakeup()
+ *     - le_timer_SetSlack()
+ *     - le_timer_SetMsSlack()
  *
  * @section timer_troubleshooting Troubleshooting
  *
@@ -362,6 +371,47 @@ le_result_t le_timer_SetWakeup
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timer slack.
+ *
+ * The slack is how much later than its expiry time the timer may be delivered, allowing timers
+ * with nearby expiry times to be handled on a single wakeup.  The default is zero.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BUSY if the timer is currently running
+ *
+ * @note
+ *      If an invalid timer object is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_timer_SetSlack
+(
+    le_timer_Ref_t timerRef,     ///< [IN] Set slack for this timer object.
+    le_clk_Time_t slack          ///< [IN] Maximum expiry delay allowed for coalescing.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timer slack using milliseconds.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BUSY if the timer is currently running
+ *
+ * @note
+ *      If an invalid timer object is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_timer_SetMsSlack
+(
+    le_timer_Ref_t timerRef,     ///< [IN] Set slack for this timer object.
+    uint32_t slack               ///< [IN] Maximum expiry delay allowed for coalescing (ms).
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set context pointer for the timer.
@@ -72,6 +72,572 @@
     } while(0)
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of argument bytes following the initial byte of a data item, indexed by the initial
+ * byte's additional information (its low 5 bits).
+ */
+//--------------------------------------------------------------------------------------------------
+#define ARG_INDEFINITE  -1      ///< Indefinite length item, or break code.
+#define ARG_RESERVED    -2      ///< Reserved additional information value; not well-formed.
+
+static const int8_t ArgumentBytes[32] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8,
+    ARG_RESERVED, ARG_RESERVED, ARG_RESERVED, ARG_INDEFINITE
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data item type, indexed by major type.  Major type 7 (simple values and floats) is looked up in
+ * SimpleTypes[] instead.
+ */
+//--------------------------------------------------------------------------------------------------
+static const le_cbor_Type_t MajorTypes[8] =
+{
+    [_LE_CBOR_POS_INTEGER] = LE_CBOR_TYPE_POS_INTEGER,
+    [_LE_CBOR_NEG_INTEGER] = LE_CBOR_TYPE_NEG_INTEGER,
+    [_LE_CBOR_BYTE_STRING] = LE_CBOR_TYPE_BYTE_STRING,
+    [_LE_CBOR_TEXT_STRING] = LE_CBOR_TYPE_TEXT_STRING,
+    [_LE_CBOR_ITEM_ARRAY]  = LE_CBOR_TYPE_ITEM_ARRAY,
+    [_LE_CBOR_PAIR_MAP]    = LE_CBOR_TYPE_INVALID_TYPE,
+    [_LE_CBOR_TAG]         = LE_CBOR_TYPE_TAG,
+    [_LE_CBOR_PRIMITVE]    = LE_CBOR_TYPE_INVALID_TYPE
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data item type of major type 7 items, indexed by additional information.
+ */
+//--------------------------------------------------------------------------------------------------
+static const le_cbor_Type_t SimpleTypes[32] =
+{
+    // 0 - 19: unassigned simple values
+    LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE,
+    LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE,
+    LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE,
+    LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE,
+    LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE,
+    LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE,
+    LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE,
+    // 20 - 22: false, true, null
+    LE_CBOR_TYPE_BOOLEAN, LE_CBOR_TYPE_BOOLEAN, LE_CBOR_TYPE_NULL,
+    // 23 - 26: undefined, one byte simple value, half and single precision floats
+    LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE,
+    LE_CBOR_TYPE_INVALID_TYPE,
+    // 27: double precision float
+    LE_CBOR_TYPE_DOUBLE,
+    // 28 - 30: reserved
+    LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE, LE_CBOR_TYPE_INVALID_TYPE,
+    // 31: break
+    LE_CBOR_TYPE_INDEF_END
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of values byte-swapped at a time by the float and double array functions.  The values
+ * are swapped in a separate loop over a contiguous buffer, which the compiler can vectorize, and
+ * then interleaved with the items' initial bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SWAP_CHUNK_COUNT    32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the initial byte of a data item and its integer argument (the value of an integer, or
+ * the length of a string or array) from a buffer, increment the buffer pointer if decoding is
+ * successful.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     if the item is not of the expected major type, has an indefinite length or is
+ *                  not well-formed.  The buffer pointer is not changed.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool DecodeHeader
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    unsigned int expectedMajor,     ///< [IN] Expected CBOR major type
+    uint64_t* valuePtr              ///< [OUT] Decoded argument
+)
+{
+    const uint8_t* buffer = *bufferPtr;
+    unsigned int additional = buffer[0] & 0x1F;
+
+    if ((unsigned int)(buffer[0] >> 5) != expectedMajor)
+    {
+        return false;
+    }
+
+    switch (ArgumentBytes[additional])
+    {
+        case 0:
+            *valuePtr = additional;
+            break;
+        case 1:
+            *valuePtr = buffer[1];
+            break;
+        case 2:
+        {
+            uint16_t value;
+            memcpy(&value, buffer + 1, sizeof(value));
+            *valuePtr = be16toh(value);
+            break;
+        }
+        case 4:
+        {
+            uint32_t value;
+            memcpy(&value, buffer + 1, sizeof(value));
+            *valuePtr = be32toh(value);
+            break;
+        }
+        case 8:
+        {
+            uint64_t value;
+            memcpy(&value, buffer + 1, sizeof(value));
+            *valuePtr = be64toh(value);
+            break;
+        }
+        default:
+            return false;
+    }
+
+    *bufferPtr += 1 + ArgumentBytes[additional];
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes needed to encode an unsigned integer item.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t UnsignedSize
+(
+    uint64_t value                  ///< [IN] Value to be encoded
+)
+{
+    if (value < _LE_CBOR_COMPLEX_THRESHOLD)
+    {
+        return 1;
+    }
+    else if (value <= UINT8_MAX)
+    {
+        return LE_CBOR_UINT8_MAX_SIZE;
+    }
+    else if (value <= UINT16_MAX)
+    {
+        return LE_CBOR_UINT16_MAX_SIZE;
+    }
+    else if (value <= UINT32_MAX)
+    {
+        return LE_CBOR_UINT32_MAX_SIZE;
+    }
+    return LE_CBOR_UINT64_MAX_SIZE;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write an item's initial byte and integer argument in their shortest form, as EncodeInteger()
+ * does.  The caller must have checked that there is room for it.
+ *
+ * @return Pointer to the byte following the item header.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint8_t* PutInteger
+(
+    uint8_t* buffer,                ///< [OUT] Buffer to store the encoded data
+    unsigned int major,             ///< [IN] CBOR major type
+    uint64_t value                  ///< [IN] Value to be encoded
+)
+{
+    uint8_t initial = (major & 0x7) << 5;
+
+    if (value < _LE_CBOR_COMPLEX_THRESHOLD)
+    {
+        buffer[0] = initial | (uint8_t)value;
+        return buffer + 1;
+    }
+    else if (value <= UINT8_MAX)
+    {
+        buffer[0] = initial | _LE_CBOR_COMPLEX_THRESHOLD;
+        buffer[1] = (uint8_t)value;
+        return buffer + LE_CBOR_UINT8_MAX_SIZE;
+    }
+    else if (value <= UINT16_MAX)
+    {
+        uint16_t value2 = htobe16((uint16_t)value);
+        buffer[0] = initial | (_LE_CBOR_COMPLEX_THRESHOLD + 1);
+        memcpy(buffer + 1, &value2, sizeof(value2));
+        return buffer + LE_CBOR_UINT16_MAX_SIZE;
+    }
+    else if (value <= UINT32_MAX)
+    {
+        uint32_t value2 = htobe32((uint32_t)value);
+        buffer[0] = initial | (_LE_CBOR_COMPLEX_THRESHOLD + 2);
+        memcpy(buffer + 1, &value2, sizeof(value2));
+        return buffer + LE_CBOR_UINT32_MAX_SIZE;
+    }
+    else
+    {
+        uint64_t value2 = htobe64(value);
+        buffer[0] = initial | (_LE_CBOR_COMPLEX_THRESHOLD + 3);
+        memcpy(buffer + 1, &value2, sizeof(value2));
+        return buffer + LE_CBOR_UINT64_MAX_SIZE;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of unsigned integers into a buffer, increment the buffer pointer if encoding is
+ * successful.  Produces the same bytes as an array header followed by one
+ * le_cbor_EncodePositiveInteger() call per element.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EncodeUnsignedArray
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const void* valuesPtr,          ///< [IN] Values to be encoded
+    size_t count,                   ///< [IN] Number of values
+    size_t elementSize              ///< [IN] Size of each value (1, 2, 4 or 8 bytes)
+)
+{
+    size_t i;
+
+    if (bufferPtr == NULL || *bufferPtr == NULL || bufLen == NULL ||
+        (valuesPtr == NULL && count > 0) || count > *bufLen)
+    {
+        return false;
+    }
+
+    // Check against the worst case first, so the common case needs no extra pass over the values.
+    size_t needed = UnsignedSize(count) + count * (1 + elementSize);
+    if (needed > *bufLen)
+    {
+        needed = UnsignedSize(count);
+        for (i = 0; i < count; i++)
+        {
+            switch (elementSize)
+            {
+                case sizeof(uint8_t):
+                    needed += UnsignedSize(((const uint8_t*)valuesPtr)[i]);
+                    break;
+                case sizeof(uint16_t):
+                    needed += UnsignedSize(((const uint16_t*)valuesPtr)[i]);
+                    break;
+                case sizeof(uint32_t):
+                    needed += UnsignedSize(((const uint32_t*)valuesPtr)[i]);
+                    break;
+                default:
+                    needed += UnsignedSize(((const uint64_t*)valuesPtr)[i]);
+                    break;
+            }
+        }
+        if (needed > *bufLen)
+        {
+            return false;
+        }
+    }
+
+    uint8_t* buffer = PutInteger(*bufferPtr, _LE_CBOR_ITEM_ARRAY, count);
+
+    // One loop per element size, so each loop body inlines down to the encodings it can need.
+    switch (elementSize)
+    {
+        case sizeof(uint8_t):
+            for (i = 0; i < count; i++)
+            {
+                buffer = PutInteger(buffer, _LE_CBOR_POS_INTEGER, ((const uint8_t*)valuesPtr)[i]);
+            }
+            break;
+        case sizeof(uint16_t):
+            for (i = 0; i < count; i++)
+            {
+                buffer = PutInteger(buffer, _LE_CBOR_POS_INTEGER, ((const uint16_t*)valuesPtr)[i]);
+            }
+            break;
+        case sizeof(uint32_t):
+            for (i = 0; i < count; i++)
+            {
+                buffer = PutInteger(buffer, _LE_CBOR_POS_INTEGER, ((const uint32_t*)valuesPtr)[i]);
+            }
+            break;
+        default:
+            for (i = 0; i < count; i++)
+            {
+                buffer = PutInteger(buffer, _LE_CBOR_POS_INTEGER, ((const uint64_t*)valuesPtr)[i]);
+            }
+            break;
+    }
+
+    *bufLen -= buffer - *bufferPtr;
+    *bufferPtr = buffer;
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of unsigned integers from a buffer, increment the buffer pointer if decoding is
+ * successful.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeUnsignedArray
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    void* valuesPtr,                ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount,                ///< [IN] Maximum number of values
+    size_t elementSize              ///< [IN] Size of each value (1, 2, 4 or 8 bytes)
+)
+{
+    uint8_t* buffer;
+    uint64_t count = 0;
+    uint64_t value = 0;
+    size_t i;
+
+    if (bufferPtr == NULL || *bufferPtr == NULL || countPtr == NULL ||
+        (valuesPtr == NULL && maxCount > 0))
+    {
+        return false;
+    }
+
+    buffer = *bufferPtr;
+    if (!DecodeHeader(&buffer, _LE_CBOR_ITEM_ARRAY, &count) || count > maxCount)
+    {
+        return false;
+    }
+
+    switch (elementSize)
+    {
+        case sizeof(uint8_t):
+            for (i = 0; i < count; i++)
+            {
+                if (!DecodeHeader(&buffer, _LE_CBOR_POS_INTEGER, &value) || value > UINT8_MAX)
+                {
+                    return false;
+                }
+                ((uint8_t*)valuesPtr)[i] = (uint8_t)value;
+            }
+            break;
+        case sizeof(uint16_t):
+            for (i = 0; i < count; i++)
+            {
+                if (!DecodeHeader(&buffer, _LE_CBOR_POS_INTEGER, &value) || value > UINT16_MAX)
+                {
+                    return false;
+                }
+                ((uint16_t*)valuesPtr)[i] = (uint16_t)value;
+            }
+            break;
+        case sizeof(uint32_t):
+            for (i = 0; i < count; i++)
+            {
+                if (!DecodeHeader(&buffer, _LE_CBOR_POS_INTEGER, &value) || value > UINT32_MAX)
+                {
+                    return false;
+                }
+                ((uint32_t*)valuesPtr)[i] = (uint32_t)value;
+            }
+            break;
+        default:
+            for (i = 0; i < count; i++)
+            {
+                if (!DecodeHeader(&buffer, _LE_CBOR_POS_INTEGER, &value))
+                {
+                    return false;
+                }
+                ((uint64_t*)valuesPtr)[i] = value;
+            }
+            break;
+    }
+
+    *countPtr = count;
+    *bufferPtr = buffer;
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of floats or doubles into a buffer, increment the buffer pointer if encoding is
+ * successful.  Each value is encoded at its own precision, as a single or double precision float
+ * item.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EncodeFloatArray
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const void* valuesPtr,          ///< [IN] Values to be encoded
+    size_t count,                   ///< [IN] Number of values
+    size_t elementSize              ///< [IN] sizeof(float) or sizeof(double)
+)
+{
+    uint64_t swapped64[SWAP_CHUNK_COUNT];
+    uint32_t swapped32[SWAP_CHUNK_COUNT];
+    const uint8_t* srcPtr = valuesPtr;
+    uint8_t initial = (_LE_CBOR_PRIMITVE << 5) |
+        (elementSize == sizeof(double) ? _LE_CBOR_PRIMITIVE_DOUBLE : _LE_CBOR_PRIMITIVE_FLOAT);
+    size_t i;
+    size_t j;
+
+    if (bufferPtr == NULL || *bufferPtr == NULL || bufLen == NULL ||
+        (valuesPtr == NULL && count > 0) || count > *bufLen ||
+        UnsignedSize(count) + count * (1 + elementSize) > *bufLen)
+    {
+        return false;
+    }
+
+    uint8_t* buffer = PutInteger(*bufferPtr, _LE_CBOR_ITEM_ARRAY, count);
+
+    for (i = 0; i < count; i += SWAP_CHUNK_COUNT)
+    {
+        size_t chunk = (count - i < SWAP_CHUNK_COUNT) ? (count - i) : SWAP_CHUNK_COUNT;
+
+        if (elementSize == sizeof(double))
+        {
+            memcpy(swapped64, srcPtr + i * elementSize, chunk * elementSize);
+            for (j = 0; j < chunk; j++)
+            {
+                swapped64[j] = htobe64(swapped64[j]);
+            }
+            for (j = 0; j < chunk; j++)
+            {
+                buffer[0] = initial;
+                memcpy(buffer + 1, &swapped64[j], sizeof(uint64_t));
+                buffer += LE_CBOR_DOUBLE_MAX_SIZE;
+            }
+        }
+        else
+        {
+            memcpy(swapped32, srcPtr + i * elementSize, chunk * elementSize);
+            for (j = 0; j < chunk; j++)
+            {
+                swapped32[j] = htobe32(swapped32[j]);
+            }
+            for (j = 0; j < chunk; j++)
+            {
+                buffer[0] = initial;
+                memcpy(buffer + 1, &swapped32[j], sizeof(uint32_t));
+                buffer += LE_CBOR_FLOAT_MAX_SIZE;
+            }
+        }
+    }
+
+    *bufLen -= buffer - *bufferPtr;
+    *bufferPtr = buffer;
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of floats or doubles from a buffer, increment the buffer pointer if decoding is
+ * successful.  Each item must be a float of the same precision as the values.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeFloatArray
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    void* valuesPtr,                ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount,                ///< [IN] Maximum number of values
+    size_t elementSize              ///< [IN] sizeof(float) or sizeof(double)
+)
+{
+    uint64_t swapped64[SWAP_CHUNK_COUNT];
+    uint32_t swapped32[SWAP_CHUNK_COUNT];
+    uint8_t* dstPtr = valuesPtr;
+    uint8_t initial = (_LE_CBOR_PRIMITVE << 5) |
+        (elementSize == sizeof(double) ? _LE_CBOR_PRIMITIVE_DOUBLE : _LE_CBOR_PRIMITIVE_FLOAT);
+    uint8_t* buffer;
+    uint64_t count = 0;
+    size_t i;
+    size_t j;
+
+    if (bufferPtr == NULL || *bufferPtr == NULL || countPtr == NULL ||
+        (valuesPtr == NULL && maxCount > 0))
+    {
+        return false;
+    }
+
+    buffer = *bufferPtr;
+    if (!DecodeHeader(&buffer, _LE_CBOR_ITEM_ARRAY, &count) || count > maxCount)
+    {
+        return false;
+    }
+
+    for (i = 0; i < count; i += SWAP_CHUNK_COUNT)
+    {
+        size_t chunk = (count - i < SWAP_CHUNK_COUNT) ? (count - i) : SWAP_CHUNK_COUNT;
+
+        if (elementSize == sizeof(double))
+        {
+            for (j = 0; j < chunk; j++)
+            {
+                if (buffer[0] != initial)
+                {
+                    return false;
+                }
+                memcpy(&swapped64[j], buffer + 1, sizeof(uint64_t));
+                buffer += LE_CBOR_DOUBLE_MAX_SIZE;
+            }
+            for (j = 0; j < chunk; j++)
+            {
+                swapped64[j] = be64toh(swapped64[j]);
+            }
+            memcpy(dstPtr + i * elementSize, swapped64, chunk * elementSize);
+        }
+        else
+        {
+            for (j = 0; j < chunk; j++)
+            {
+                if (buffer[0] != initial)
+                {
+                    return false;
+                }
+                memcpy(&swapped32[j], buffer + 1, sizeof(uint32_t));
+                buffer += LE_CBOR_FLOAT_MAX_SIZE;
+            }
+            for (j = 0; j < chunk; j++)
+            {
+                swapped32[j] = be32toh(swapped32[j]);
+            }
+            memcpy(dstPtr + i * elementSize, swapped32, chunk * elementSize);
+        }
+    }
+
+    *countPtr = count;
+    *bufferPtr = buffer;
+    return true;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Decode a half float from buffer, increment the buffer pointer if encoding is successful
@@ -238,36 +804,12 @@ static bool DecodePositiveInteger
     unsigned int expectedMajor      ///< [IN] Expected CBOR major type
 )
 {
-    unsigned int additional;
-    unsigned int major;
-
     if (bufferPtr == NULL || *bufferPtr == NULL || valuePtr == NULL)
     {
         return false;
     }
 
-    LE_CBOR_UNPACK_TINY_ITEM();
-    if (major != expectedMajor)
-    {
-        // Restore the pointer position
-        *bufferPtr -= 1;
-        return false;
-    }
-    else
-    {
-        if (additional < _LE_CBOR_COMPLEX_THRESHOLD)
-        {
-            *valuePtr = additional;
-        }
-        else
-        {
-            int length = (additional == _LE_CBOR_COMPLEX_THRESHOLD)?1:
-                2 << (additional-_LE_CBOR_COMPLEX_THRESHOLD-1);
-            LE_CBOR_UNPACK_SIMPLE_BUFFER(((uint8_t*)valuePtr) + sizeof(uint64_t)-length, length);
-            *valuePtr = be64toh(*valuePtr);
-        }
-        return true;
-    }
+    return DecodeHeader(bufferPtr, expectedMajor, valuePtr);
 }
 
 
@@ -312,61 +854,20 @@ le_cbor_Type_t le_cbor_GetType
 
     unsigned int major = (buffer[0] >> 5) & 0x7;
     unsigned int additional = buffer[0] & 0x1F;
+    int argumentBytes = ArgumentBytes[additional];
 
-    if (additional < _LE_CBOR_COMPLEX_THRESHOLD)
-    {
-        *additionalBytes = 0;
-    }
-    else if (additional < _LE_CBOR_PRIMITIVE_INDEFINITE)
-    {
-        *additionalBytes = (additional == _LE_CBOR_COMPLEX_THRESHOLD)?1:
-            2 << (additional-_LE_CBOR_COMPLEX_THRESHOLD-1);
-    }
-    else
+    if (argumentBytes == ARG_RESERVED)
     {
         *additionalBytes = -1;
+        return LE_CBOR_TYPE_INVALID_TYPE;
     }
+    *additionalBytes = argumentBytes;
 
-    le_cbor_Type_t ret;
-
-    switch(major)
+    if (major == _LE_CBOR_PRIMITVE)
     {
-        case (_LE_CBOR_POS_INTEGER):  ret = LE_CBOR_TYPE_POS_INTEGER;  break;
-        case (_LE_CBOR_NEG_INTEGER):  ret = LE_CBOR_TYPE_NEG_INTEGER;  break;
-        case (_LE_CBOR_BYTE_STRING):  ret = LE_CBOR_TYPE_BYTE_STRING;  break;
-        case (_LE_CBOR_TEXT_STRING):  ret = LE_CBOR_TYPE_TEXT_STRING;  break;
-        case (_LE_CBOR_ITEM_ARRAY):   ret = LE_CBOR_TYPE_ITEM_ARRAY;   break;
-        case (_LE_CBOR_TAG):          ret = LE_CBOR_TYPE_TAG;          break;
-        case (_LE_CBOR_PRIMITVE):
-        {
-            if (additional == _LE_CBOR_PRIMITIVE_TRUE ||
-                additional == _LE_CBOR_PRIMITIVE_FALSE)
-            {
-                ret = LE_CBOR_TYPE_BOOLEAN;
-            }
-            else if (additional == _LE_CBOR_PRIMITIVE_DOUBLE)
-            {
-                ret = LE_CBOR_TYPE_DOUBLE;
-            }
-            else if (additional == _LE_CBOR_PRIMITIVE_BREAK)
-            {
-                ret = LE_CBOR_TYPE_INDEF_END;
-            }
-            else if (additional == _LE_CBOR_PRIMITIVE_NULL)
-            {
-                ret = LE_CBOR_TYPE_NULL;
-            }
-            else
-            {
-                ret = LE_CBOR_TYPE_INVALID_TYPE;
-            }
-            break;
-        }
-        default:
-            ret = LE_CBOR_TYPE_INVALID_TYPE;
+        return SimpleTypes[additional];
     }
-
-    return ret;
+    return MajorTypes[major];
 }
 
 
@@ -865,6 +1366,148 @@ bool le_cbor_EncodeNull
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of unsigned 8-bit integers into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as its own
+ * item in the shortest form, so the result is the same as an array header followed by one
+ * le_cbor_EncodePositiveInteger() call per value.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeUint8Array
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const uint8_t* valuesPtr,       ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+)
+{
+    return EncodeUnsignedArray(bufferPtr, bufLen, valuesPtr, count, sizeof(uint8_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of unsigned 16-bit integers into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as its own
+ * item in the shortest form, so the result is the same as an array header followed by one
+ * le_cbor_EncodePositiveInteger() call per value.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeUint16Array
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const uint16_t* valuesPtr,      ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+)
+{
+    return EncodeUnsignedArray(bufferPtr, bufLen, valuesPtr, count, sizeof(uint16_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of unsigned 32-bit integers into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as its own
+ * item in the shortest form, so the result is the same as an array header followed by one
+ * le_cbor_EncodePositiveInteger() call per value.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeUint32Array
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const uint32_t* valuesPtr,      ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+)
+{
+    return EncodeUnsignedArray(bufferPtr, bufLen, valuesPtr, count, sizeof(uint32_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of unsigned 64-bit integers into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as its own
+ * item in the shortest form, so the result is the same as an array header followed by one
+ * le_cbor_EncodePositiveInteger() call per value.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeUint64Array
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const uint64_t* valuesPtr,      ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+)
+{
+    return EncodeUnsignedArray(bufferPtr, bufLen, valuesPtr, count, sizeof(uint64_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of floats into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as a
+ * single precision float item.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeFloatArray
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const float* valuesPtr,         ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+)
+{
+    return EncodeFloatArray(bufferPtr, bufLen, valuesPtr, count, sizeof(float));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an array of doubles into a buffer, increment the buffer pointer if encoding is
+ * successful. Each value is encoded as a
+ * double precision float item.
+ *
+ * @return
+ *      - true      if successfully encoded
+ *      - false     otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_EncodeDoubleArray
+(
+    uint8_t** bufferPtr,            ///< [OUT] Pointer of buffer to store the encoded data
+    size_t* bufLen,                 ///< [IN/OUT] Size of the buffer available
+    const double* valuesPtr,        ///< [IN] Values to be encoded
+    size_t count                    ///< [IN] Number of values
+)
+{
+    return EncodeFloatArray(bufferPtr, bufLen, valuesPtr, count, sizeof(double));
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Decode an integer from a buffer, increment the buffer pointer if decoding is successful
@@ -880,38 +1523,27 @@ bool le_cbor_DecodeInteger
     int64_t* valuePtr               ///< [OUT] Decoded value
 )
 {
-    int additional;
-    unsigned int major;
+    uint64_t value;
 
     if (bufferPtr == NULL || *bufferPtr == NULL || valuePtr == NULL)
     {
         return false;
     }
 
-    LE_CBOR_UNPACK_TINY_ITEM();
-    if (major != _LE_CBOR_POS_INTEGER && major != _LE_CBOR_NEG_INTEGER)
+    if (DecodeHeader(bufferPtr, _LE_CBOR_POS_INTEGER, &value))
     {
-       return false;
+        *valuePtr = value;
+    }
+    else if (DecodeHeader(bufferPtr, _LE_CBOR_NEG_INTEGER, &value))
+    {
+        *valuePtr = -1 - (int64_t)value;
     }
     else
     {
-        bool sign = (major == _LE_CBOR_POS_INTEGER);
-        int length;
-        if (additional < _LE_CBOR_COMPLEX_THRESHOLD)
-        {
-            *valuePtr = (sign)? additional: (-1 - additional);
-        }
-        else
-        {
-            length = (additional == _LE_CBOR_COMPLEX_THRESHOLD)?1:
-                2 << (additional-_LE_CBOR_COMPLEX_THRESHOLD-1);
-            LE_CBOR_UNPACK_SIMPLE_BUFFER(((uint8_t*)valuePtr) + sizeof(int64_t)-length, length);
-            *valuePtr = be64toh(*valuePtr);
-            *valuePtr = (sign)? *valuePtr: (-1 - (*valuePtr));
-        }
-
-        return true;
+        return false;
     }
+
+    return true;
 }
 
 
@@ -1676,6 +2308,144 @@ bool le_cbor_DecodeMapHeader
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of unsigned 8-bit integers from a buffer, increment the buffer pointer if decoding is
+ * successful. Values too big for the output
+ * type are rejected.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeUint8Array
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    uint8_t* valuesPtr,             ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+)
+{
+    return DecodeUnsignedArray(bufferPtr, valuesPtr, countPtr, maxCount, sizeof(uint8_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of unsigned 16-bit integers from a buffer, increment the buffer pointer if decoding is
+ * successful. Values too big for the output
+ * type are rejected.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeUint16Array
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    uint16_t* valuesPtr,            ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+)
+{
+    return DecodeUnsignedArray(bufferPtr, valuesPtr, countPtr, maxCount, sizeof(uint16_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of unsigned 32-bit integers from a buffer, increment the buffer pointer if decoding is
+ * successful. Values too big for the output
+ * type are rejected.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeUint32Array
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    uint32_t* valuesPtr,            ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+)
+{
+    return DecodeUnsignedArray(bufferPtr, valuesPtr, countPtr, maxCount, sizeof(uint32_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of unsigned 64-bit integers from a buffer, increment the buffer pointer if decoding is
+ * successful. Values too big for the output
+ * type are rejected.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeUint64Array
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    uint64_t* valuesPtr,            ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+)
+{
+    return DecodeUnsignedArray(bufferPtr, valuesPtr, countPtr, maxCount, sizeof(uint64_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of floats from a buffer, increment the buffer pointer if decoding is
+ * successful. Each item must be a single
+ * precision float.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeFloatArray
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    float* valuesPtr,               ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+)
+{
+    return DecodeFloatArray(bufferPtr, valuesPtr, countPtr, maxCount, sizeof(float));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array of doubles from a buffer, increment the buffer pointer if decoding is
+ * successful. Each item must be a double
+ * precision float.
+ *
+ * @return
+ *      - true      if successfully decoded
+ *      - false     failed to decode (the buffer pointer is not changed)
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_cbor_DecodeDoubleArray
+(
+    uint8_t** bufferPtr,            ///< [IN/OUT] Pointer of buffer for decoding
+    double* valuesPtr,              ///< [OUT] Decoded values
+    size_t* countPtr,               ///< [OUT] Number of values decoded
+    size_t maxCount                 ///< [IN] Maximum number of values (size of valuesPtr)
+)
+{
+    return DecodeFloatArray(bufferPtr, valuesPtr, countPtr, maxCount, sizeof(double));
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Decode one item from cbor stream in buffer, increment the buffer pointer and decrease the
@@ -59,6 +59,13 @@
  * and unlocked using the functions event_Lock() and event_Unlock().  Framework adaptor
  * functions which end in _NoLock are called with the lock held so should not lock.
  *
+ * Event Queues are the exception.  Reports queued to a thread are pushed onto the thread's
+ * pending stack without taking the Mutex (see QueueReport()).  Only the push that finds the stack
+ * empty wakes up the thread's Event Loop.  The Event Loop then takes everything off the stack in
+ * one go (see event_CollectEventReports()) and processes it as a batch, so a burst of reports
+ * costs one wake-up rather than one for every report.  Once collected, reports are only touched
+ * by the thread that owns the queue.
+ *
  * ----
  *
  * Copyright (C) Sierra Wireless Inc.
@@ -253,6 +260,9 @@ typedef enum
                                     ///  reference-counted object allocated from a memory pool.
 
     LE_EVENT_REPORT_QUEUED_FUNC,    ///< Queued Function.
+
+    LE_EVENT_REPORT_UNIQUE_FUNC,    ///< Queued Function that is also on its thread's Unique List
+                                    ///  (see le_event_QueueFunctionToThreadUnique()).
 }
 EventReportType_t;
 
@@ -310,6 +320,7 @@ typedef struct
     le_event_DeferredFunc_t function;   ///< Address of the function to be called.
     void*                   param1Ptr;  ///< First parameter to pass to the function.
     void*                   param2Ptr;  ///< Second parameter to pass to the function.
+    le_dls_Link_t           uniqueLink; ///< Link in the thread's Unique List (unique only).
 }
 QueuedFunctionReport_t;
 
@@ -545,6 +556,100 @@ static void DeleteHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue an Event Report to a thread (could be the calling thread or some other thread), waking up
+ * its Event Loop if it has nothing else pending.
+ *
+ * @note Doesn't need the Mutex.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueReport
+(
+    event_PerThreadRec_t*   perThreadRecPtr,    ///< [in] Pointer to the thread's event data record.
+    Report_t*               reportPtr           ///< [in] The report.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* headPtr = __atomic_load_n(&perThreadRecPtr->pendingReportsPtr,
+                                             __ATOMIC_RELAXED);
+
+    do
+    {
+        reportPtr->link.nextPtr = headPtr;
+    }
+    while (!__atomic_compare_exchange_n(&perThreadRecPtr->pendingReportsPtr,
+                                        &headPtr,
+                                        &reportPtr->link,
+                                        true,
+                                        __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED));
+
+    // If there was already something pending, then whoever queued it has already woken the
+    // thread up (or is about to), and the thread hasn't collected it yet.
+    if (headPtr == NULL)
+    {
+        // Don't let the thread get cancelled part way through, or the Event Loop would never
+        // find out about anything queued after this.
+        int oldState;
+        int junk;
+
+        LE_ASSERT(pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &oldState) == 0);
+
+        fa_event_TriggerEvent_NoLock(perThreadRecPtr);
+
+        LE_ASSERT(pthread_setcancelstate(oldState, &junk) == 0);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move all the Event Reports that have been queued to the calling thread onto the end of its
+ * Event Queue, in the order they were queued.
+ *
+ * The thread's Event FD must have been read (see fa_event_WaitForEvent()) before this is called,
+ * so that anything queued from now on triggers it again.
+ *
+ * @return The number of Event Reports collected.
+ **/
+//--------------------------------------------------------------------------------------------------
+uint64_t event_CollectEventReports
+(
+    event_PerThreadRec_t* perThreadRecPtr   ///< [in] Ptr to the calling thread's per-thread record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* linkPtr = __atomic_exchange_n(&perThreadRecPtr->pendingReportsPtr,
+                                                 NULL,
+                                                 __ATOMIC_ACQUIRE);
+    le_sls_Link_t* orderedPtr = NULL;
+    uint64_t count = 0;
+
+    // The pending reports are most recent first, so reverse them.
+    while (linkPtr != NULL)
+    {
+        le_sls_Link_t* nextPtr = linkPtr->nextPtr;
+
+        linkPtr->nextPtr = orderedPtr;
+        orderedPtr = linkPtr;
+        linkPtr = nextPtr;
+    }
+
+    while (orderedPtr != NULL)
+    {
+        le_sls_Link_t* nextPtr = orderedPtr->nextPtr;
+
+        *orderedPtr = LE_SLS_LINK_INIT;
+        le_sls_Queue(&perThreadRecPtr->eventQueue, orderedPtr);
+        orderedPtr = nextPtr;
+        count++;
+    }
+
+    return count;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Process one event report from the calling thread's Event Queue.
@@ -559,14 +664,12 @@ void event_ProcessOneEventReport
     le_sls_Link_t* linkPtr;
     Report_t* reportObjPtr;
     Handler_t* handlerPtr;
+    int oldState;
 
-    int oldState = event_Lock();
-
-    // Pop an Event Report off the head of the Event Queue (inside a critical section).
+    // Pop an Event Report off the head of the Event Queue.  Only this thread touches the queue
+    // once reports have been collected onto it, so this doesn't need the Mutex.
     linkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue);
 
-    event_Unlock(oldState);
-
     if (linkPtr == NULL)
     {
         return;
@@ -580,12 +683,21 @@ void event_ProcessOneEventReport
     perThreadRecPtr->currentEvent = reportObjPtr;
 
     // If it's a queued function report,
-    if (reportObjPtr->type == LE_EVENT_REPORT_QUEUED_FUNC)
+    if (   (reportObjPtr->type == LE_EVENT_REPORT_QUEUED_FUNC)
+        || (reportObjPtr->type == LE_EVENT_REPORT_UNIQUE_FUNC))
     {
         // Convert the Report base class pointer into a pointer to a Queued Function Report.
         QueuedFunctionReport_t* queuedFuncReportPtr;
         queuedFuncReportPtr = CONTAINER_OF(reportObjPtr, QueuedFunctionReport_t, baseClass);
 
+        // Once it has been taken off the queue, the same function can be queued again.
+        if (reportObjPtr->type == LE_EVENT_REPORT_UNIQUE_FUNC)
+        {
+            oldState = event_Lock();
+            le_dls_Remove(&perThreadRecPtr->uniqueList, &queuedFuncReportPtr->uniqueLink);
+            event_Unlock(oldState);
+        }
+
         // Call the function.
         queuedFuncReportPtr->function(queuedFuncReportPtr->param1Ptr,
                                       queuedFuncReportPtr->param2Ptr);
@@ -662,9 +774,9 @@ void event_ProcessEventReports
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Read the eventfd to fetch the number of Reports on the Event Queue and reset the count
-    // to zero.
-    uint64_t numReports = fa_event_WaitForEvent(perThreadRecPtr);
+    // Read the eventfd to reset it, then collect everything that has been queued so far.
+    fa_event_WaitForEvent(perThreadRecPtr);
+    uint64_t numReports = event_CollectEventReports(perThreadRecPtr);
 
     // Process only those event reports that are already on the queue.  Anything reported by the
     // event handlers will have to wait until next time ProcessEventReports() is called.
@@ -703,15 +815,14 @@ static void PubSubHandlerFunc
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Queue a function onto a specific thread's Event Queue (could belong to the calling thread or
- * could belong to some other thread).
+ * Create a Queued Function Report.
  *
- * @warning Assumes the mutex is locked and the thread is protected from cancellation.
+ * @return Pointer to the report, ready to be queued.
  */
 //--------------------------------------------------------------------------------------------------
-static void QueueFunction_NoLock
+static QueuedFunctionReport_t* CreateQueuedFunction
 (
-    event_PerThreadRec_t*   perThreadRecPtr, ///< [in] Pointer to the thread's event data record.
+    EventReportType_t       type,       ///< [in] LE_EVENT_REPORT_QUEUED_FUNC or _UNIQUE_FUNC.
     le_event_DeferredFunc_t func,       ///< [in] The function to be called later.
     void*                   param1Ptr,  ///< [in] Value to be passed to the function when called.
     void*                   param2Ptr   ///< [in] Value to be passed to the function when called.
@@ -723,16 +834,13 @@ static void QueueFunction_NoLock
 
     // Initialize it.
     reportPtr->baseClass.link = LE_SLS_LINK_INIT;
-    reportPtr->baseClass.type = LE_EVENT_REPORT_QUEUED_FUNC;
+    reportPtr->baseClass.type = type;
     reportPtr->function = func;
     reportPtr->param1Ptr = param1Ptr;
     reportPtr->param2Ptr = param2Ptr;
+    reportPtr->uniqueLink = LE_DLS_LINK_INIT;
 
-    // Queue it to the Event Queue.
-    le_sls_Queue(&perThreadRecPtr->eventQueue, &reportPtr->baseClass.link);
-
-    // Write to the eventfd to notify the Event Loop that there is something on the queue.
-    fa_event_TriggerEvent_NoLock(perThreadRecPtr);
+    return reportPtr;
 }
 
 
@@ -828,7 +936,9 @@ event_PerThreadRec_t* event_CreatePerThreadInfo
     event_PerThreadRec_t* recPtr = fa_event_CreatePerThreadInfo();
 
     // Initialize the various thread-specific lists and queues.
+    recPtr->pendingReportsPtr = NULL;
     recPtr->eventQueue = LE_SLS_LIST_INIT;
+    recPtr->uniqueList = LE_DLS_LIST_INIT;
     recPtr->handlerList = LE_DLS_LIST_INIT;
     recPtr->fdMonitorList = LE_DLS_LIST_INIT;
 
@@ -910,6 +1020,9 @@ void event_DestructThread
         DeleteHandler(handlerPtr);
     }
 
+    // Everything on the Unique List is about to be discarded.
+    perThreadRecPtr->uniqueList = LE_DLS_LIST_INIT;
+
     // We are finished accessing the Event List and structures under it.  Furthermore,
     // we know that all the handlers have been deleted now, so there's no risk of anyone adding
     // anything to the Event Queue anymore (unless the API user has done something stupid and
@@ -921,7 +1034,9 @@ void event_DestructThread
     // Delete all the FD Monitors for this thread.
     fdMon_DestructThread(perThreadRecPtr);
 
-    // Discard everything on the Event Queue.
+    // Discard everything on the Event Queue, including anything not collected yet.
+    event_CollectEventReports(perThreadRecPtr);
+
     while (NULL != (singleLinkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue)))
     {
         Report_t* reportPtr = CONTAINER_OF(singleLinkPtr, Report_t, link);
@@ -1245,11 +1360,9 @@ void le_event_Report
         reportObjPtr->handlerRef = handlerPtr->safeRef;
         memset(reportObjPtr->payload, 0, eventPtr->payloadSize);
         memcpy(reportObjPtr->payload, payloadPtr, payloadSize);
-        le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
 
-        // Increment the eventfd for the handler's thread's Event Queue.
-        // This will wake up the thread and tell it that it has something on its Event Queue.
-        fa_event_TriggerEvent_NoLock(perThreadRecPtr);
+        // Queue it to the handler's thread, waking the thread up if need be.
+        QueueReport(perThreadRecPtr, &reportObjPtr->baseClass);
 
         linkPtr = le_dls_PeekNext(&eventPtr->handlerList, linkPtr);
     }
@@ -1306,11 +1419,9 @@ void le_event_ReportWithRefCounting
         reportObjPtr->handlerRef = handlerPtr->safeRef;
         reportObjPtr->payload[0] = objectPtr;
         le_mem_AddRef(objectPtr);
-        le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
 
-        // Increment the eventfd for the handler's thread's Event Queue.
-        // This will wake up the thread and tell it that it has something on its Event Queue.
-        fa_event_TriggerEvent_NoLock(perThreadRecPtr);
+        // Queue it to the handler's thread, waking the thread up if need be.
+        QueueReport(perThreadRecPtr, &reportObjPtr->baseClass);
 
         linkPtr = le_dls_PeekNext(&eventPtr->handlerList, linkPtr);
     }
@@ -1416,11 +1527,12 @@ void le_event_QueueFunction
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int oldState = event_Lock();
+    QueuedFunctionReport_t* reportPtr = CreateQueuedFunction(LE_EVENT_REPORT_QUEUED_FUNC,
+                                                             func,
+                                                             param1Ptr,
+                                                             param2Ptr);
 
-    QueueFunction_NoLock(thread_GetEventRecPtr(), func, param1Ptr, param2Ptr);
-
-    event_Unlock(oldState);
+    QueueReport(thread_GetEventRecPtr(), &reportPtr->baseClass);
 }
 
 
@@ -1439,11 +1551,13 @@ void le_event_QueueFunctionToThread
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int oldState = event_Lock();
-
-    QueueFunction_NoLock(thread_GetOtherEventRecPtr(thread), func, param1Ptr, param2Ptr);
+    event_PerThreadRec_t* perThreadRecPtr = thread_GetOtherEventRecPtr(thread);
+    QueuedFunctionReport_t* reportPtr = CreateQueuedFunction(LE_EVENT_REPORT_QUEUED_FUNC,
+                                                             func,
+                                                             param1Ptr,
+                                                             param2Ptr);
 
-    event_Unlock(oldState);
+    QueueReport(perThreadRecPtr, &reportPtr->baseClass);
 }
 
 
@@ -1471,15 +1585,16 @@ le_result_t le_event_QueueFunctionToThreadUnique
 {
     QueuedFunctionReport_t* reportPtr = NULL;
 
-    int oldState = event_Lock();
-
     event_PerThreadRec_t* perThreadRecPtr = thread_GetOtherEventRecPtr(thread);
 
-    LE_SLS_FOREACH(&perThreadRecPtr->eventQueue,
-                   reportPtr, QueuedFunctionReport_t, baseClass.link)
+    // The Event Queue itself can't be searched, because it is changed without the Mutex.  So
+    // functions queued using this function are also kept on the Unique List until they are called.
+    int oldState = event_Lock();
+
+    LE_DLS_FOREACH(&perThreadRecPtr->uniqueList,
+                   reportPtr, QueuedFunctionReport_t, uniqueLink)
     {
-        if (reportPtr->baseClass.type == LE_EVENT_REPORT_QUEUED_FUNC &&
-            reportPtr->function == func &&
+        if (reportPtr->function == func &&
             reportPtr->param1Ptr == param1Ptr &&
             reportPtr->param2Ptr == param2Ptr)
         {
@@ -1489,7 +1604,10 @@ le_result_t le_event_QueueFunctionToThreadUnique
         }
     }
 
-    QueueFunction_NoLock(thread_GetOtherEventRecPtr(thread), func, param1Ptr, param2Ptr);
+    reportPtr = CreateQueuedFunction(LE_EVENT_REPORT_UNIQUE_FUNC, func, param1Ptr, param2Ptr);
+    le_dls_Queue(&perThreadRecPtr->uniqueList, &reportPtr->uniqueLink);
+
+    QueueReport(perThreadRecPtr, &reportPtr->baseClass);
 
     event_Unlock(oldState);
 
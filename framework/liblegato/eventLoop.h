@@ -89,6 +89,23 @@ void event_SetCurrentContextPtr
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move all the Event Reports that have been queued to the calling thread onto the end of its
+ * Event Queue, in the order they were queued.
+ *
+ * The thread's Event FD must have been read (see fa_event_WaitForEvent()) before this is called,
+ * so that anything queued from now on triggers it again.
+ *
+ * @return The number of Event Reports collected.
+ **/
+//--------------------------------------------------------------------------------------------------
+uint64_t event_CollectEventReports
+(
+    event_PerThreadRec_t* perThreadRecPtr   ///< [in] Ptr to the calling thread's per-thread record.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Process one event report from the calling thread's Event Queue.
@@ -41,14 +41,21 @@ event_LoopState_t;
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    le_sls_List_t        eventQueue;        ///< The thread's event queue.
+    le_sls_Link_t       *pendingReportsPtr; ///< Reports queued to the thread that the event loop
+                                            ///< hasn't collected yet, most recent first.  Pushed
+                                            ///< to by any thread without locking.
+    le_sls_List_t        eventQueue;        ///< Reports collected by the event loop, in order.
+                                            ///< Only accessed by the thread itself.
+    le_dls_List_t        uniqueList;        ///< Queued functions that were queued using
+                                            ///< le_event_QueueFunctionToThreadUnique() and
+                                            ///< haven't been called yet.  Protected by the mutex.
     le_dls_List_t        handlerList;       ///< List of handlers registered with this thread.
     le_dls_List_t        fdMonitorList;     ///< List of FD Monitors created by this thread.
     void                *contextPtr;        ///< Context pointer from last Handler called.
     event_LoopState_t    state;             ///< Current state of the event loop.
-    uint64_t             liveEventCount;    ///< Number of events ready for dequeing.  Ensures
-                                            ///< balance between queued events and monitored fds
-                                            ///< in le_event_ServiceLoop().
+    uint64_t             liveEventCount;    ///< Number of collected events ready for dequeing.
+                                            ///< Ensures balance between queued events and
+                                            ///< monitored fds in le_event_ServiceLoop().
     void*                currentEvent;      ///< Pointer to the current event report being processed
 }
 event_PerThreadRec_t;
@@ -102,6 +109,9 @@ void fa_event_ThreadInit
 //--------------------------------------------------------------------------------------------------
 /**
  * Inform event loop an event has fired.  Wakes the event loop if it is asleep.
+ *
+ * This is done when a thread's pending Event Reports go from none to some, not for every report.
+ * It doesn't need the mutex to be held.
  */
 //--------------------------------------------------------------------------------------------------
 void fa_event_TriggerEvent_NoLock
@@ -112,9 +122,9 @@ void fa_event_TriggerEvent_NoLock
 //--------------------------------------------------------------------------------------------------
 /**
  * Wait for an event to trigger.  This fetches the value of the Event FD (which is
- * the number of event reports on the Event Queue) and resets the Event FD value to zero.
+ * the number of times the event was triggered) and resets the Event FD value to zero.
  *
- * @return The number of Event Reports on the thread's Event Queue.
+ * @return The number of times the event was triggered.
  */
 //--------------------------------------------------------------------------------------------------
 uint64_t fa_event_WaitForEvent
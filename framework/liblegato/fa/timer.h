@@ -33,7 +33,7 @@ timer_Type_t;
  * Timer object.  Created by le_timer_Create().
  */
 //--------------------------------------------------------------------------------------------------
-typedef struct
+typedef struct Timer
 {
     // Settable attributes
 #if LE_CONFIG_TIMER_NAMES_ENABLED
@@ -43,9 +43,19 @@ typedef struct
     le_clk_Time_t interval;                  ///< Interval
     uint32_t repeatCount;                    ///< Number of times the timer will repeat
     void* contextPtr;                        ///< Context for timer expiry
+    le_clk_Time_t slack;                     ///< How late the expiry may be delivered so that it
+                                             ///  can share a wakeup with other timers.
 
     // Internal State
-    le_dls_Link_t link;                      ///< For adding to the timer list
+    le_dls_Link_t link;                      ///< For adding to the (unordered) timer list
+    struct Timer* heapChildPtr;              ///< First child in the timer heap
+    struct Timer* heapNextPtr;               ///< Next sibling in the timer heap
+    struct Timer* heapPrevPtr;               ///< Previous sibling in the timer heap, or the
+                                             ///  parent if this is the parent's first child.
+    le_clk_Time_t deadline;                  ///< Latest expiry time (expiry time + slack); this
+                                             ///  is the timer heap key.
+    uint32_t heapSeq;                        ///< Insertion sequence number; keeps timers with
+                                             ///  equal deadlines in first-in first-out order.
     bool isActive;                           ///< Is the timer active/running?
     le_clk_Time_t expiryTime;                ///< Time at which the timer should expire
     uint32_t expiryCount;                    ///< Number of times the counter has expired
@@ -71,11 +81,16 @@ Timer_t;
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    le_dls_List_t activeTimerList;      ///< Linked list of running legato timers for this thread
+    le_dls_List_t activeTimerList;      ///< Linked list of running legato timers for this thread.
+                                        ///  This list is not sorted; expiry order is kept by
+                                        ///  the timer heap.
+    Timer_t* heapRootPtr;               ///< Root of the timer heap (pairing heap ordered by
+                                        ///  deadline), or NULL if no timers are running.
+    uint32_t heapSeq;                   ///< Next insertion sequence number for the timer heap.
     Timer_t* firstTimerPtr;             ///< Pointer to the timer on the active list that is
                                         ///  associated with the currently running timerFD,
                                         ///  or NULL if there are no timers on the active list.
-                                        ///  This is normally the first timer on the list.
+                                        ///  This is normally the root of the timer heap.
 }
 timer_ThreadRec_t;
 
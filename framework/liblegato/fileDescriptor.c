@@ -12,6 +12,17 @@
 #include "fileDescriptor.h"
 #include "limit.h"
 
+#if defined(LE_CONFIG_LINUX)
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+
+// Not defined by older C libraries.
+#   ifndef MFD_CLOEXEC
+#       define MFD_CLOEXEC          0x0001U
+#       define MFD_ALLOW_SEALING    0x0002U
+#   endif
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets a file descriptor non-blocking.
@@ -388,3 +399,49 @@ le_result_t fd_ReadFromOffset
     return LE_OK;
 }
 #endif
+
+
+#if defined(LE_CONFIG_LINUX)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates an anonymous, memory-backed file, e.g., to be mapped into memory and shared with another
+ * process by passing it the file descriptor.  The file is initially empty and the descriptor has
+ * the close-on-exec flag set.  If supported, seals can be added to the file (see F_ADD_SEALS).
+ *
+ * @return
+ *      The file descriptor, or LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+int fd_CreateAnonymous
+(
+    const char* namePtr     ///< [IN] Name for the file, for debugging purposes only.
+)
+{
+    int fd = -1;
+
+#ifdef SYS_memfd_create
+    fd = syscall(SYS_memfd_create, namePtr, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if ((fd == -1) && (errno != ENOSYS))
+    {
+        LE_ERROR("Could not create memory file '%s'.  %m.", namePtr);
+        return LE_FAULT;
+    }
+#endif
+
+#ifdef O_TMPFILE
+    if (fd == -1)
+    {
+        // Kernels older than 3.17 don't have memfd_create().  Use an unnamed file in tmpfs instead.
+        fd = open("/dev/shm", O_TMPFILE | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    }
+#endif
+
+    if (fd == -1)
+    {
+        LE_ERROR("Could not create anonymous file '%s'.  %m.", namePtr);
+        return LE_FAULT;
+    }
+
+    return fd;
+}
+#endif
@@ -150,4 +150,20 @@ LE_FULL_API le_result_t fd_ReadFromOffset
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates an anonymous, memory-backed file, e.g., to be mapped into memory and shared with another
+ * process by passing it the file descriptor.  The file is initially empty and the descriptor has
+ * the close-on-exec flag set.  If supported, seals can be added to the file (see F_ADD_SEALS).
+ *
+ * @return
+ *      The file descriptor, or LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_FULL_API int fd_CreateAnonymous
+(
+    const char* namePtr     ///< [IN] Name for the file, for debugging purposes only.
+);
+
+
 #endif // LE_FILE_DESCRIPTOR_H_INCLUDE_GUARD
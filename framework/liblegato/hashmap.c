@@ -45,6 +45,13 @@ LE_DEFINE_INLINE le_hashmap_Ref_t le_hashmap_Create
     le_hashmap_HashFunc_t      hashFunc,
     le_hashmap_EqualsFunc_t    equalsFunc
 );
+LE_DEFINE_INLINE le_hashmap_Ref_t le_hashmap_CreateOpenAddressed
+(
+    const char                *nameStr,
+    size_t                     capacity,
+    le_hashmap_HashFunc_t      hashFunc,
+    le_hashmap_EqualsFunc_t    equalsFunc
+);
 #endif
 
 //--------------------------------------------------------------------------------------------------
@@ -138,6 +145,52 @@ static inline le_sls_Link_t *bucket_PeekPrev
 #   define HASHMAP_TRACE(mapRef, ...)   (void) (mapRef)
 #endif /* end LE_CONFIG_HASHMAP_NAMES_ENABLED */
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum load factor (in percent) of a heap hashmap before it starts growing.  This is the same
+ * 0.75 load factor used to size the index when the map is created.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_LOAD_PERCENT        75
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load factor (in percent) at which an open-addressed map finishes a pending rehash even if its
+ * iterator is in the middle of the map.  Open-addressed maps cannot hold more entries than they
+ * have slots, so they cannot wait indefinitely for an iteration to end.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_OPEN_LOAD_PERCENT   90
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of old buckets (or slots) moved into the new index by each le_hashmap_Put() or
+ * le_hashmap_Remove() while a map is being rehashed.  As the index is doubled when it is 3/4 full,
+ * this is enough to finish rehashing long before the new index needs to grow again.
+ */
+//--------------------------------------------------------------------------------------------------
+#define REHASH_STEP             4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hashmap flags.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HASHMAP_FLAG_RESIZABLE      0x01    ///< Index is heap allocated and may grow.
+#define HASHMAP_FLAG_OPEN           0x02    ///< Map uses open addressing instead of bucket lists.
+#define HASHMAP_FLAG_UNORDERED      0x04    ///< Slots were filled without Robin Hood ordering.
+#define HASHMAP_FLAG_OLD_UNORDERED  0x08    ///< Old slots were filled without Robin Hood ordering.
+#define HASHMAP_FLAG_WALKING        0x10    ///< le_hashmap_ForEach() is walking the map.
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open addressing slot states.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SLOT_EMPTY      0   ///< Slot has never been used since the index was created.
+#define SLOT_USED       1   ///< Slot holds an entry.
+#define SLOT_DELETED    2   ///< Slot held an entry which has been removed.
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -236,6 +289,66 @@ static inline bool EqualKeys
     return equalsFuncPtr(keyAPtr, keyBPtr);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Check if a map uses open addressing.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsOpen
+(
+    const le_hashmap_Hashmap_t  *mapRef     ///< Map instance.
+)
+{
+    return ((mapRef->flags & HASHMAP_FLAG_OPEN) != 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Check if a map is part way through moving its entries into a new index.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsRehashing
+(
+    const le_hashmap_Hashmap_t  *mapRef     ///< Map instance.
+)
+{
+    return (mapRef->oldBucketCount != 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Check if an iteration is in progress, i.e. the map's iterator is positioned on an entry or
+ *  le_hashmap_ForEach() is walking the map.
+ *
+ *  Entries must not be moved between buckets (or slots) while this is the case, or the iteration
+ *  could skip or repeat them.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsIterating
+(
+    const le_hashmap_Hashmap_t  *mapRef     ///< Map instance.
+)
+{
+    return ((mapRef->flags & HASHMAP_FLAG_WALKING) != 0 ||
+            mapRef->iterator.currentLinkPtr != NULL || mapRef->iterator.currentSlotPtr != NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the total number of buckets (or slots) in a map, including those of the old index if the
+ *  map is being rehashed.
+ *
+ *  Bucket indices used for iteration cover the old index first, then the new one.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t TotalBucketCount
+(
+    const le_hashmap_Hashmap_t  *mapRef     ///< Map instance.
+)
+{
+    return mapRef->oldBucketCount + mapRef->bucketCount;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Look up the head of a bucket list by index.
@@ -249,9 +362,97 @@ static le_hashmap_Bucket_t *IndexToBucket
     size_t                   index      ///< Bucket index.
 )
 {
+    if (index < mapRef->oldBucketCount)
+    {
+        return &mapRef->oldBucketsPtr[index];
+    }
+    index -= mapRef->oldBucketCount;
+
     return (index < mapRef->bucketCount ? &mapRef->bucketsPtr[index] : NULL);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the index of a bucket list.  This is the inverse of IndexToBucket().
+ *
+ *  @return  Bucket index.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t BucketToIndex
+(
+    le_hashmap_Hashmap_t    *mapRef,    ///< Map instance.
+    le_hashmap_Bucket_t     *listHeadPtr///< Bucket list.
+)
+{
+    if (mapRef->oldBucketsPtr != NULL &&
+        listHeadPtr >= mapRef->oldBucketsPtr &&
+        listHeadPtr < mapRef->oldBucketsPtr + mapRef->oldBucketCount)
+    {
+        return listHeadPtr - mapRef->oldBucketsPtr;
+    }
+
+    return mapRef->oldBucketCount + (listHeadPtr - mapRef->bucketsPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Look up a slot of an open-addressed map by index.
+ *
+ *  @return  Slot, or NULL if the index is past the end of the map.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Slot_t *IndexToSlot
+(
+    le_hashmap_Hashmap_t    *mapRef,    ///< Map instance.
+    size_t                   index      ///< Slot index.
+)
+{
+    if (index < mapRef->oldBucketCount)
+    {
+        return &mapRef->oldSlotsPtr[index];
+    }
+    index -= mapRef->oldBucketCount;
+
+    return (index < mapRef->bucketCount ? &mapRef->slotsPtr[index] : NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Check if a slot belongs to the old index of a map which is being rehashed.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsOldSlot
+(
+    le_hashmap_Hashmap_t    *mapRef,    ///< Map instance.
+    le_hashmap_Slot_t       *slotPtr    ///< Slot.
+)
+{
+    return (mapRef->oldSlotsPtr != NULL &&
+            slotPtr >= mapRef->oldSlotsPtr &&
+            slotPtr < mapRef->oldSlotsPtr + mapRef->oldBucketCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the index of a slot.  This is the inverse of IndexToSlot().
+ *
+ *  @return  Slot index.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t SlotToIndex
+(
+    le_hashmap_Hashmap_t    *mapRef,    ///< Map instance.
+    le_hashmap_Slot_t       *slotPtr    ///< Slot.
+)
+{
+    if (IsOldSlot(mapRef, slotPtr))
+    {
+        return slotPtr - mapRef->oldSlotsPtr;
+    }
+
+    return mapRef->oldBucketCount + (slotPtr - mapRef->slotsPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get number of buckets required for a given capacity
@@ -280,336 +481,821 @@ size_t GetBucketCount
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Internal function to initialize a statically-defined hashmap
+ *  Search a bucket list for a key.
  *
- * @note use le_hashmap_InitStatic() macro instead
+ *  @return  Matching entry, or NULL if the key is not in the bucket.
  */
 //--------------------------------------------------------------------------------------------------
-le_hashmap_Ref_t _le_hashmap_InitStatic
+static le_hashmap_Entry_t *FindEntryInBucket
 (
-#if LE_CONFIG_HASHMAP_NAMES_ENABLED
-    const char*                nameStr,          ///< [in] Name of the HashMap
-#endif
-    size_t                     capacity,         ///< [in] Expected capacity of the map
-    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
-    le_hashmap_EqualsFunc_t    equalsFunc,       ///< [in] The equality function
-    le_hashmap_Hashmap_t*      mapPtr,           ///< [in] The static hash map to initialize
-    le_mem_PoolRef_t           entryPoolRef,     ///< [in] The memory pool for map entries
-    le_hashmap_Bucket_t*       bucketsPtr        ///< [in] The bucket lists
+    le_hashmap_Hashmap_t     *mapRef,           ///< Map instance.
+    le_hashmap_Bucket_t      *listHeadPtr,      ///< Bucket list to search.
+    const void               *keyPtr,           ///< Key to search for.
+    le_hashmap_Link_t       **prevLinkPtrPtr    ///< [OUT] Link before the entry, or NULL if the
+                                                ///<       entry is first.  May be NULL.
 )
 {
-#if LE_CONFIG_HASHMAP_NAMES_ENABLED
-    LE_ASSERT(nameStr);
-#endif
-    LE_ASSERT(hashFunc);
-    LE_ASSERT(equalsFunc);
-    LE_ASSERT(mapPtr);
-    LE_ASSERT(entryPoolRef);
-    LE_ASSERT(bucketsPtr);
+    le_hashmap_Link_t *prevLinkPtr = NULL;
+    le_hashmap_Link_t *theLinkPtr = bucket_Peek(listHeadPtr);
 
-    // Do not zero members as these are pre-zeroed entering this function.
-    // Not zeroing also helps debug double-initialization bugs.
-
-    mapPtr->bucketCount = LE_HASHMAP_BUCKET_COUNT(capacity);
-
-    mapPtr->entryPoolRef = entryPoolRef;
-    le_mem_SetNumObjsToForce(mapPtr->entryPoolRef, mapPtr->bucketCount / 8);
-
-    mapPtr->bucketsPtr = bucketsPtr;
+    while (theLinkPtr != NULL)
+    {
+        le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
+                                                           le_hashmap_Entry_t,
+                                                           entryListLink);
+        if (EqualKeys(currentEntryPtr->keyPtr, keyPtr, mapRef->equalsFuncPtr))
+        {
+            if (prevLinkPtrPtr != NULL)
+            {
+                *prevLinkPtrPtr = prevLinkPtr;
+            }
+            return currentEntryPtr;
+        }
 
-    mapPtr->hashFuncPtr = hashFunc;
-    mapPtr->equalsFuncPtr = equalsFunc;
-#if LE_CONFIG_HASHMAP_NAMES_ENABLED
-    mapPtr->nameStr = nameStr;
-#endif
+        prevLinkPtr = theLinkPtr;
+        theLinkPtr = bucket_PeekNext(listHeadPtr, theLinkPtr);
+    }
 
-    le_hashmap_GetIterator(mapPtr);
-    return mapPtr;
+    return NULL;
 }
 
-
 //--------------------------------------------------------------------------------------------------
 /**
- * Create a HashMap
- *
- * @return  Returns a reference to the map.
+ *  Find the entry for a key in a map which uses bucket lists.  If the map is being rehashed, both
+ *  the new and old buckets are searched.
  *
- * @note Terminates the process on failure, so no need to check the return value for errors.
+ *  @return  Matching entry, or NULL if the key is not in the map.
  */
 //--------------------------------------------------------------------------------------------------
-#if LE_CONFIG_HASHMAP_NAMES_ENABLED
-le_hashmap_Ref_t le_hashmap_Create
-(
-    const char*                nameStr,          ///< [in] Name of the HashMap
-    size_t                     capacity,         ///< [in] Expected capacity of the map
-    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
-    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] The equality function
-)
-#else
-le_hashmap_Ref_t _le_hashmap_Create
+static le_hashmap_Entry_t *FindEntry
 (
-    size_t                     capacity,         ///< [in] Expected capacity of the map
-    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
-    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] The equality function
+    le_hashmap_Hashmap_t     *mapRef,           ///< Map instance.
+    size_t                    hash,             ///< Hash of the key.
+    const void               *keyPtr,           ///< Key to search for.
+    le_hashmap_Bucket_t     **listHeadPtrPtr,   ///< [OUT] Bucket holding the entry.  May be NULL.
+    le_hashmap_Link_t       **prevLinkPtrPtr    ///< [OUT] Link before the entry.  May be NULL.
 )
-#endif
 {
-#if LE_CONFIG_HASHMAP_NAMES_ENABLED
-    char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES] = "hashMap_";
-    le_utf8_Append(poolName, nameStr, sizeof(poolName), NULL);
-#else
-    char poolName[] = "";
-#endif
+    size_t               index = CalculateIndex(mapRef->bucketCount, hash);
+    le_hashmap_Bucket_t *listHeadPtr = &(mapRef->bucketsPtr[index]);
+    le_hashmap_Entry_t  *entryPtr;
 
-    size_t bucketCount = GetBucketCount(capacity);
+    HASHMAP_TRACE(
+        mapRef,
+        "Hashmap %s: Generated index of %" PRIuS " for hash %" PRIuS,
+        mapRef->nameStr,
+        index,
+        hash
+    );
+    HASHMAP_TRACE(
+        mapRef,
+        "Hashmap %s: Looked up list contains %" PRIuS " links",
+        mapRef->nameStr,
+        bucket_NumLinks(listHeadPtr)
+    );
 
-    // Use same function internally as static allocation, but take pointers from
-    // heap instead of static memory
-    return _le_hashmap_InitStatic(
-#if LE_CONFIG_HASHMAP_NAMES_ENABLED
-        nameStr,
-#endif
-        capacity,
-        hashFunc,
-        equalsFunc,
-        calloc(1, sizeof(le_hashmap_Hashmap_t)),
-        le_mem_ExpandPool(le_mem_CreatePool(poolName,
-                                            sizeof(le_hashmap_Entry_t)),
-                          bucketCount / 2),
-        calloc(bucketCount, sizeof(le_hashmap_Bucket_t)));
+    entryPtr = FindEntryInBucket(mapRef, listHeadPtr, keyPtr, prevLinkPtrPtr);
+    if (entryPtr == NULL && IsRehashing(mapRef))
+    {
+        listHeadPtr = &(mapRef->oldBucketsPtr[CalculateIndex(mapRef->oldBucketCount, hash)]);
+        entryPtr = FindEntryInBucket(mapRef, listHeadPtr, keyPtr, prevLinkPtrPtr);
+    }
+
+    if (listHeadPtrPtr != NULL)
+    {
+        *listHeadPtrPtr = listHeadPtr;
+    }
+    return entryPtr;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add a key-value pair to a HashMap. If the key already exists in the map then the previous value
- * will be replaced with the new value passed into this function.
+ *  Search one index of an open-addressed map for a key.
  *
- * The process will terminate if this fails as it implies an inability to allocate any more memory
+ *  Unless some entries were placed without Robin Hood ordering, the search stops as soon as it
+ *  reaches a slot whose entry is closer to its home slot than the key would be.
  *
+ *  @return  Matching slot, or NULL if the key is not in the index.
  */
 //--------------------------------------------------------------------------------------------------
-
-void* le_hashmap_Put
+static le_hashmap_Slot_t *FindSlotInIndex
 (
-    le_hashmap_Ref_t mapRef,   ///< [in] Reference to the map
-    const void* keyPtr,        ///< [in] Pointer to the key to be stored
-    const void* valuePtr       ///< [in] Pointer to the value to be stored
+    le_hashmap_Hashmap_t    *mapRef,    ///< Map instance.
+    le_hashmap_Slot_t       *slotsPtr,  ///< Slot array.
+    size_t                   slotCount, ///< Number of slots.  Must be a power of 2.
+    bool                     isOrdered, ///< Whether the slots are in Robin Hood order.
+    size_t                   hash,      ///< Hash of the key.
+    const void              *keyPtr     ///< Key to search for.
 )
 {
-    size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
-
-    HASHMAP_TRACE(
-        mapRef,
-        "Hashmap %s: Generated index of %" PRIuS " for hash %u",
-        mapRef->nameStr,
-        index,
-        (int)hash
-    );
+    size_t distance;
 
-    le_hashmap_Bucket_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
-
-    if (bucket_IsEmpty(listHeadPtr))
+    for (distance = 0; distance < slotCount; ++distance)
     {
-        le_hashmap_Entry_t* newEntryPtr = CreateEntry(keyPtr, valuePtr, mapRef->entryPoolRef);
-        LE_ASSERT(newEntryPtr);
+        le_hashmap_Slot_t *slotPtr = &slotsPtr[CalculateIndex(slotCount, hash + distance)];
 
-        bucket_Stack(listHeadPtr, &(newEntryPtr->entryListLink));
-        mapRef->size++;
+        if (slotPtr->state == SLOT_EMPTY || (isOrdered && slotPtr->distance < distance))
+        {
+            break;
+        }
+        if (slotPtr->state == SLOT_USED &&
+            slotPtr->hash == hash &&
+            EqualKeys(slotPtr->keyPtr, keyPtr, mapRef->equalsFuncPtr))
+        {
+            return slotPtr;
+        }
+    }
 
-        HASHMAP_TRACE(
-            mapRef,
-            "Hashmap %s: Added first entry to bucket. Total map size now %" PRIuS,
-            mapRef->nameStr,
-            mapRef->size
-        );
+    return NULL;
+}
 
-        return NULL;
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Find the slot for a key in an open-addressed map.  If the map is being rehashed, both the new
+ *  and old slots are searched.
+ *
+ *  @return  Matching slot, or NULL if the key is not in the map.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Slot_t *FindSlot
+(
+    le_hashmap_Hashmap_t    *mapRef,    ///< Map instance.
+    size_t                   hash,      ///< Hash of the key.
+    const void              *keyPtr     ///< Key to search for.
+)
+{
+    le_hashmap_Slot_t *slotPtr;
+
+    HASHMAP_TRACE(
+        mapRef,
+        "Hashmap %s: Generated index of %" PRIuS " for hash %" PRIuS,
+        mapRef->nameStr,
+        CalculateIndex(mapRef->bucketCount, hash),
+        hash
+    );
+
+    slotPtr = FindSlotInIndex(mapRef, mapRef->slotsPtr, mapRef->bucketCount,
+                              !(mapRef->flags & HASHMAP_FLAG_UNORDERED), hash, keyPtr);
+    if (slotPtr == NULL && IsRehashing(mapRef))
+    {
+        slotPtr = FindSlotInIndex(mapRef, mapRef->oldSlotsPtr, mapRef->oldBucketCount,
+                                  !(mapRef->flags & HASHMAP_FLAG_OLD_UNORDERED), hash, keyPtr);
     }
-    else
+    return slotPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Place a new entry in the current slots of an open-addressed map.  The key must not already be
+ *  in the map, and there must be at least one free slot.
+ *
+ *  With Robin Hood ordering, the new entry takes the place of any entry it passes which is closer
+ *  to its own home slot, and that entry is then placed further along in the same way.  Without
+ *  it, no existing entry is moved.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InsertSlot
+(
+    le_hashmap_Hashmap_t    *mapRef,    ///< Map instance.
+    size_t                   hash,      ///< Hash of the key.
+    const void              *keyPtr,    ///< Key.
+    const void              *valuePtr,  ///< Value.
+    bool                     robinHood  ///< Use Robin Hood ordering.
+)
+{
+    le_hashmap_Slot_t  newSlot =
     {
-        le_hashmap_Link_t* theLinkPtr = bucket_Peek(listHeadPtr);
+        .keyPtr = keyPtr,
+        .valuePtr = valuePtr,
+        .hash = hash,
+        .distance = 0,
+        .state = SLOT_USED
+    };
+    size_t index = CalculateIndex(mapRef->bucketCount, hash);
 
-        while (true) {
-            le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
-                                                               le_hashmap_Entry_t,
-                                                               entryListLink);
+    for (;;)
+    {
+        le_hashmap_Slot_t *slotPtr = &mapRef->slotsPtr[index];
 
-            // Replace existing value if the keys match.
-            if (EqualKeys(currentEntryPtr->keyPtr,
-                          keyPtr,
-                          mapRef->equalsFuncPtr)
-                          )
+        // A deleted slot can be reused without disturbing the ordering of later entries as long
+        // as the new entry is at least as far from its home as the removed one was.
+        if (slotPtr->state == SLOT_EMPTY ||
+            (slotPtr->state == SLOT_DELETED &&
+             (!robinHood || slotPtr->distance <= newSlot.distance)))
+        {
+            if (slotPtr->state == SLOT_DELETED)
             {
-                const void* oldValue = currentEntryPtr->valuePtr;
-                currentEntryPtr->valuePtr = valuePtr;
-                currentEntryPtr->keyPtr = keyPtr;
-
-                HASHMAP_TRACE(
-                    mapRef,
-                    "Hashmap %s: Replaced entry in bucket. Total map size now %" PRIuS,
-                    mapRef->nameStr,
-                    mapRef->size
-                );
-
-                return (void *)oldValue;
+                mapRef->numDeleted--;
             }
+            *slotPtr = newSlot;
+            return;
+        }
 
-            // Add a new entry if we are at the tail
-            if (bucket_PeekNext(listHeadPtr, theLinkPtr) == NULL) {
-                le_hashmap_Entry_t* newEntryPtr = CreateEntry(keyPtr,
-                                                              valuePtr,
-                                                              mapRef->entryPoolRef);
-                LE_ASSERT(newEntryPtr);
+        if (robinHood && slotPtr->state == SLOT_USED && slotPtr->distance < newSlot.distance)
+        {
+            le_hashmap_Slot_t displacedSlot = *slotPtr;
 
-                bucket_Queue(listHeadPtr, &(newEntryPtr->entryListLink));
-                mapRef->size++;
+            *slotPtr = newSlot;
+            newSlot = displacedSlot;
+        }
 
-                HASHMAP_TRACE(
-                    mapRef,
-                    "Hashmap %s: Added entry to bucket at tail. Map size now %" PRIuS,
-                    mapRef->nameStr,
-                    mapRef->size
-                );
+        index = CalculateIndex(mapRef->bucketCount, index + 1);
+        newSlot.distance++;
+    }
+}
 
-                HASHMAP_TRACE(
-                    mapRef,
-                    "Hashmap %s: Bucket now contains %" PRIuS " entries",
-                    mapRef->nameStr,
-                    bucket_NumLinks(listHeadPtr)
-                );
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Move the entries of one old bucket (or slot) into the new index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RehashBucket
+(
+    le_hashmap_Hashmap_t    *mapRef,    ///< Map instance.
+    size_t                   index      ///< Index of the old bucket (or slot).
+)
+{
+    if (IsOpen(mapRef))
+    {
+        le_hashmap_Slot_t *slotPtr = &mapRef->oldSlotsPtr[index];
 
-                return NULL;
-            }
+        if (slotPtr->state == SLOT_USED)
+        {
+            InsertSlot(mapRef, slotPtr->hash, slotPtr->keyPtr, slotPtr->valuePtr, true);
+
+            // Leave a deleted marker behind so that searches for the remaining old entries still
+            // work.
+            slotPtr->state = SLOT_DELETED;
+        }
+    }
+    else
+    {
+        le_hashmap_Bucket_t *oldListHeadPtr = &mapRef->oldBucketsPtr[index];
+        le_hashmap_Link_t   *theLinkPtr;
 
-            // Move to next entry.
-            theLinkPtr = bucket_PeekNext(listHeadPtr, theLinkPtr);
+        while ((theLinkPtr = bucket_Peek(oldListHeadPtr)) != NULL)
+        {
+            le_hashmap_Entry_t *entryPtr = CONTAINER_OF(theLinkPtr,
+                                                        le_hashmap_Entry_t,
+                                                        entryListLink);
+            size_t newIndex = CalculateIndex(mapRef->bucketCount,
+                                             HashKey(mapRef, entryPtr->keyPtr));
+
+            bucket_Remove(oldListHeadPtr, theLinkPtr, NULL);
+            *theLinkPtr = BUCKET_LINK_INIT;
+            bucket_Queue(&mapRef->bucketsPtr[newIndex], theLinkPtr);
         }
     }
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Retrieve a value from a HashMap.
- *
- * @return  Returns a pointer to the value or NULL if the key is not found.
+ *  Move some of the entries of a map which is being rehashed into its new index.  Once the old
+ *  index is empty it is freed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RehashStep
+(
+    le_hashmap_Hashmap_t    *mapRef,    ///< Map instance.
+    size_t                   count      ///< Maximum number of old buckets (or slots) to move.
+)
+{
+    while (count > 0 && mapRef->rehashIndex < mapRef->oldBucketCount)
+    {
+        RehashBucket(mapRef, mapRef->rehashIndex);
+        mapRef->rehashIndex++;
+        count--;
+    }
+
+    if (mapRef->rehashIndex >= mapRef->oldBucketCount)
+    {
+        free(mapRef->oldBucketsPtr);
+        free(mapRef->oldSlotsPtr);
+        mapRef->oldBucketsPtr = NULL;
+        mapRef->oldSlotsPtr = NULL;
+        mapRef->oldBucketCount = 0;
+        mapRef->rehashIndex = 0;
+        mapRef->flags &= ~HASHMAP_FLAG_OLD_UNORDERED;
+
+        HASHMAP_TRACE(
+            mapRef,
+            "Hashmap %s: Rehash complete, bucket count now %" PRIuS,
+            mapRef->nameStr,
+            mapRef->bucketCount
+        );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Do a step of any pending rehash, unless an iteration is in progress.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void ContinueRehash
+(
+    le_hashmap_Hashmap_t    *mapRef     ///< Map instance.
+)
+{
+    if (IsRehashing(mapRef) && !IsIterating(mapRef))
+    {
+        RehashStep(mapRef, REHASH_STEP);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Finish any pending rehash in one go.
  *
+ *  If the iterator of an open-addressed map is positioned on an entry, it is moved to the entry's
+ *  new slot.  Maps using bucket lists are only rehashed like this when their iterator is reset or
+ *  le_hashmap_ForEach() starts.
  */
 //--------------------------------------------------------------------------------------------------
+static void FinishRehash
+(
+    le_hashmap_Hashmap_t    *mapRef     ///< Map instance.
+)
+{
+    le_hashmap_Slot_t *currentSlotPtr = mapRef->iterator.currentSlotPtr;
+    size_t             currentHash = 0;
+    const void        *currentKeyPtr = NULL;
 
-void* le_hashmap_Get
+    if (!IsRehashing(mapRef))
+    {
+        return;
+    }
+
+    if (currentSlotPtr != NULL)
+    {
+        currentHash = currentSlotPtr->hash;
+        currentKeyPtr = currentSlotPtr->keyPtr;
+    }
+
+    RehashStep(mapRef, SIZE_MAX);
+
+    if (currentSlotPtr != NULL)
+    {
+        currentSlotPtr = FindSlot(mapRef, currentHash, currentKeyPtr);
+        LE_ASSERT(currentSlotPtr != NULL);
+
+        mapRef->iterator.currentSlotPtr = currentSlotPtr;
+        mapRef->iterator.currentIndex = SlotToIndex(mapRef, currentSlotPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Make room for one more entry in a heap map, starting to grow its index if it is too full.
+ *
+ *  Static maps never grow.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReserveEntry
 (
-    le_hashmap_Ref_t mapRef,   ///< [in] Reference to the map
-    const void* keyPtr         ///< [in] Pointer to the key to be retrieved
+    le_hashmap_Hashmap_t    *mapRef     ///< Map instance.
 )
 {
-    size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
-    HASHMAP_TRACE(
-        mapRef,
-        "Hashmap %s: Generated index of %" PRIuS " for hash %" PRIuS,
-        mapRef->nameStr,
-        index,
-        hash
-    );
+    size_t used = mapRef->size + mapRef->numDeleted + 1;
+    size_t newCount;
+
+    if (!(mapRef->flags & HASHMAP_FLAG_RESIZABLE))
+    {
+        return;
+    }
+
+    // le_hashmap_ForEach() holds on to bucket (or slot) positions, so the index is left alone
+    // until the walk ends.  An open-addressed map only has to grow once every slot is used, and
+    // may then start a new index, which doesn't move anything, but can't finish a pending one.
+    if (mapRef->flags & HASHMAP_FLAG_WALKING)
+    {
+        if (!IsOpen(mapRef) || mapRef->size < mapRef->bucketCount)
+        {
+            return;
+        }
+        LE_FATAL_IF(IsRehashing(mapRef), "Hashmap full while being walked by le_hashmap_ForEach()");
+    }
+
+    if (IsRehashing(mapRef))
+    {
+        // Normally the rehash finishes long before the new index fills up.  Bucket lists can
+        // hold any number of entries so they can always wait for an iteration to end, but open
+        // addressing cannot.
+        if (!IsOpen(mapRef) || used * 100 <= mapRef->bucketCount * MAX_OPEN_LOAD_PERCENT)
+        {
+            return;
+        }
+        FinishRehash(mapRef);
+    }
+
+    if (used * 100 <= mapRef->bucketCount * MAX_LOAD_PERCENT)
+    {
+        return;
+    }
+
+    // An open-addressed map which is mostly deleted slots is rebuilt at the same size.
+    newCount = mapRef->bucketCount;
+    if ((mapRef->size + 1) * 200 > mapRef->bucketCount * MAX_LOAD_PERCENT)
+    {
+        newCount *= 2;
+    }
 
-    le_hashmap_Bucket_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
     HASHMAP_TRACE(
         mapRef,
-        "Hashmap %s: Looked up list contains %" PRIuS " links",
+        "Hashmap %s: Rehashing %" PRIuS " entries into %" PRIuS " buckets",
         mapRef->nameStr,
-        bucket_NumLinks(listHeadPtr)
+        mapRef->size,
+        newCount
     );
 
-    le_hashmap_Link_t* theLinkPtr = bucket_Peek(listHeadPtr);
+    // The current index becomes the old one.  As old buckets are numbered first, the iterator's
+    // position is unchanged.
+    mapRef->oldBucketCount = mapRef->bucketCount;
+    mapRef->bucketCount = newCount;
+    mapRef->rehashIndex = 0;
+    if (IsOpen(mapRef))
+    {
+        mapRef->oldSlotsPtr = mapRef->slotsPtr;
+        mapRef->slotsPtr = calloc(newCount, sizeof(le_hashmap_Slot_t));
+        LE_ASSERT(mapRef->slotsPtr);
 
-    while (theLinkPtr != NULL) {
-        le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
-                                                           le_hashmap_Entry_t,
-                                                           entryListLink);
-        if (EqualKeys(currentEntryPtr->keyPtr,
-                          keyPtr,
-                          mapRef->equalsFuncPtr)
-                          )
+        mapRef->numDeleted = 0;
+        if (mapRef->flags & HASHMAP_FLAG_UNORDERED)
         {
-            HASHMAP_TRACE(
-                mapRef,
-                "Hashmap %s: Returning found value for key",
-                mapRef->nameStr
-            );
-            return (void*)(currentEntryPtr->valuePtr);
+            mapRef->flags |= HASHMAP_FLAG_OLD_UNORDERED;
         }
-        theLinkPtr = bucket_PeekNext(listHeadPtr, theLinkPtr);
+        mapRef->flags &= ~HASHMAP_FLAG_UNORDERED;
+    }
+    else
+    {
+        mapRef->oldBucketsPtr = mapRef->bucketsPtr;
+        mapRef->bucketsPtr = calloc(newCount, sizeof(le_hashmap_Bucket_t));
+        LE_ASSERT(mapRef->bucketsPtr);
     }
+}
 
-    HASHMAP_TRACE(
-        mapRef,
-        "Hashmap %s: Key not found",
-        mapRef->nameStr
-    );
-    return NULL;
+//--------------------------------------------------------------------------------------------------
+/**
+ * Internal function to initialize a statically-defined hashmap
+ *
+ * @note use le_hashmap_InitStatic() macro instead
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t _le_hashmap_InitStatic
+(
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+    const char*                nameStr,          ///< [in] Name of the HashMap
+#endif
+    size_t                     capacity,         ///< [in] Expected capacity of the map
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
+    le_hashmap_EqualsFunc_t    equalsFunc,       ///< [in] The equality function
+    le_hashmap_Hashmap_t*      mapPtr,           ///< [in] The static hash map to initialize
+    le_mem_PoolRef_t           entryPoolRef,     ///< [in] The memory pool for map entries
+    le_hashmap_Bucket_t*       bucketsPtr        ///< [in] The bucket lists
+)
+{
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+    LE_ASSERT(nameStr);
+#endif
+    LE_ASSERT(hashFunc);
+    LE_ASSERT(equalsFunc);
+    LE_ASSERT(mapPtr);
+    LE_ASSERT(entryPoolRef);
+    LE_ASSERT(bucketsPtr);
+
+    // Do not zero members as these are pre-zeroed entering this function.
+    // Not zeroing also helps debug double-initialization bugs.
+
+    mapPtr->bucketCount = LE_HASHMAP_BUCKET_COUNT(capacity);
+
+    mapPtr->entryPoolRef = entryPoolRef;
+    le_mem_SetNumObjsToForce(mapPtr->entryPoolRef, mapPtr->bucketCount / 8);
+
+    mapPtr->bucketsPtr = bucketsPtr;
+
+    mapPtr->hashFuncPtr = hashFunc;
+    mapPtr->equalsFuncPtr = equalsFunc;
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+    mapPtr->nameStr = nameStr;
+#endif
+
+    le_hashmap_GetIterator(mapPtr);
+    return mapPtr;
 }
 
+
 //--------------------------------------------------------------------------------------------------
 /**
- * Retrieve a stored key from a HashMap.
+ * Create a HashMap
  *
- * @return  Returns a pointer to the key that was stored in the HashMap by le_hashmap_Put() or
- *          NULL if the key is not found.
+ * @return  Returns a reference to the map.
  *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
  */
 //--------------------------------------------------------------------------------------------------
-void* le_hashmap_GetStoredKey
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+le_hashmap_Ref_t le_hashmap_Create
 (
-    le_hashmap_Ref_t mapRef,   ///< [in] Reference to the map.
-    const void* keyPtr         ///< [in] Pointer to the key to be retrieved.
+    const char*                nameStr,          ///< [in] Name of the HashMap
+    size_t                     capacity,         ///< [in] Expected capacity of the map
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
+    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] The equality function
+)
+#else
+le_hashmap_Ref_t _le_hashmap_Create
+(
+    size_t                     capacity,         ///< [in] Expected capacity of the map
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
+    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] The equality function
+)
+#endif
+{
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+    char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES] = "hashMap_";
+    le_utf8_Append(poolName, nameStr, sizeof(poolName), NULL);
+#else
+    char poolName[] = "";
+#endif
+
+    size_t bucketCount = GetBucketCount(capacity);
+
+    // Use same function internally as static allocation, but take pointers from
+    // heap instead of static memory
+    le_hashmap_Ref_t mapRef = _le_hashmap_InitStatic(
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+        nameStr,
+#endif
+        capacity,
+        hashFunc,
+        equalsFunc,
+        calloc(1, sizeof(le_hashmap_Hashmap_t)),
+        le_mem_ExpandPool(le_mem_CreatePool(poolName,
+                                            sizeof(le_hashmap_Entry_t)),
+                          bucketCount / 2),
+        calloc(bucketCount, sizeof(le_hashmap_Bucket_t)));
+
+    // The bucket count is calculated at run-time here, and may differ from the static one.
+    mapRef->bucketCount = bucketCount;
+    mapRef->flags = HASHMAP_FLAG_RESIZABLE;
+    return mapRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a HashMap which uses open addressing.
+ *
+ * @return  Returns a reference to the map.
+ *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+le_hashmap_Ref_t le_hashmap_CreateOpenAddressed
+(
+    const char*                nameStr,          ///< [in] Name of the HashMap
+    size_t                     capacity,         ///< [in] Expected capacity of the map
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
+    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] The equality function
+)
+#else
+le_hashmap_Ref_t _le_hashmap_CreateOpenAddressed
+(
+    size_t                     capacity,         ///< [in] Expected capacity of the map
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
+    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] The equality function
+)
+#endif
+{
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+    LE_ASSERT(nameStr);
+#endif
+    LE_ASSERT(hashFunc);
+    LE_ASSERT(equalsFunc);
+
+    le_hashmap_Hashmap_t *mapPtr = calloc(1, sizeof(le_hashmap_Hashmap_t));
+    LE_ASSERT(mapPtr);
+
+    mapPtr->bucketCount = GetBucketCount(capacity);
+    mapPtr->slotsPtr = calloc(mapPtr->bucketCount, sizeof(le_hashmap_Slot_t));
+    LE_ASSERT(mapPtr->slotsPtr);
+
+    mapPtr->hashFuncPtr = hashFunc;
+    mapPtr->equalsFuncPtr = equalsFunc;
+    mapPtr->flags = HASHMAP_FLAG_RESIZABLE | HASHMAP_FLAG_OPEN;
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+    mapPtr->nameStr = nameStr;
+#endif
+
+    le_hashmap_GetIterator(mapPtr);
+    return mapPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a key-value pair to a HashMap. If the key already exists in the map then the previous value
+ * will be replaced with the new value passed into this function.
+ *
+ * The process will terminate if this fails as it implies an inability to allocate any more memory
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+void* le_hashmap_Put
+(
+    le_hashmap_Ref_t mapRef,   ///< [in] Reference to the map
+    const void* keyPtr,        ///< [in] Pointer to the key to be stored
+    const void* valuePtr       ///< [in] Pointer to the value to be stored
 )
 {
     size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+
+    ContinueRehash(mapRef);
+
+    if (IsOpen(mapRef))
+    {
+        le_hashmap_Slot_t *slotPtr = FindSlot(mapRef, hash, keyPtr);
+
+        if (slotPtr != NULL)
+        {
+            const void* oldValue = slotPtr->valuePtr;
+            slotPtr->valuePtr = valuePtr;
+            slotPtr->keyPtr = keyPtr;
+
+            HASHMAP_TRACE(
+                mapRef,
+                "Hashmap %s: Replaced entry in slot. Total map size now %" PRIuS,
+                mapRef->nameStr,
+                mapRef->size
+            );
+
+            return (void *)oldValue;
+        }
+
+        ReserveEntry(mapRef);
+
+        // Robin Hood insertion moves existing entries, so it can't be used mid-iteration.
+        if (IsIterating(mapRef))
+        {
+            InsertSlot(mapRef, hash, keyPtr, valuePtr, false);
+            mapRef->flags |= HASHMAP_FLAG_UNORDERED;
+        }
+        else
+        {
+            InsertSlot(mapRef, hash, keyPtr, valuePtr, true);
+        }
+        mapRef->size++;
+
+        HASHMAP_TRACE(
+            mapRef,
+            "Hashmap %s: Added entry to slot. Map size now %" PRIuS,
+            mapRef->nameStr,
+            mapRef->size
+        );
+
+        return NULL;
+    }
+
+    le_hashmap_Entry_t* currentEntryPtr = FindEntry(mapRef, hash, keyPtr, NULL, NULL);
+
+    // Replace existing value if the keys match.
+    if (currentEntryPtr != NULL)
+    {
+        const void* oldValue = currentEntryPtr->valuePtr;
+        currentEntryPtr->valuePtr = valuePtr;
+        currentEntryPtr->keyPtr = keyPtr;
+
+        HASHMAP_TRACE(
+            mapRef,
+            "Hashmap %s: Replaced entry in bucket. Total map size now %" PRIuS,
+            mapRef->nameStr,
+            mapRef->size
+        );
+
+        return (void *)oldValue;
+    }
+
+    ReserveEntry(mapRef);
+
+    // New entries always go in the new index when rehashing.
+    le_hashmap_Bucket_t* listHeadPtr =
+        &(mapRef->bucketsPtr[CalculateIndex(mapRef->bucketCount, hash)]);
+    le_hashmap_Entry_t* newEntryPtr = CreateEntry(keyPtr, valuePtr, mapRef->entryPoolRef);
+    LE_ASSERT(newEntryPtr);
+
+    bucket_Queue(listHeadPtr, &(newEntryPtr->entryListLink));
+    mapRef->size++;
+
     HASHMAP_TRACE(
         mapRef,
-        "Hashmap %s: Generated index of %" PRIuS " for hash %" PRIuS,
+        "Hashmap %s: Added entry to bucket at tail. Map size now %" PRIuS,
         mapRef->nameStr,
-        index,
-        hash
+        mapRef->size
     );
 
-    le_hashmap_Bucket_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
     HASHMAP_TRACE(
         mapRef,
-        "Hashmap %s: Looked up list contains %" PRIuS " links",
+        "Hashmap %s: Bucket now contains %" PRIuS " entries",
         mapRef->nameStr,
         bucket_NumLinks(listHeadPtr)
     );
 
-    le_hashmap_Link_t* theLinkPtr = bucket_Peek(listHeadPtr);
+    return NULL;
+}
 
-    while (theLinkPtr != NULL) {
-        le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
-                                                           le_hashmap_Entry_t,
-                                                           entryListLink);
-        if (EqualKeys(currentEntryPtr->keyPtr,
-                          keyPtr,
-                          mapRef->equalsFuncPtr)
-                          )
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up a key in a HashMap.
+ *
+ * @return  Returns true if the key is found, false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool LookUp
+(
+    le_hashmap_Ref_t mapRef,        ///< [in] Reference to the map
+    const void* keyPtr,             ///< [in] Pointer to the key to be retrieved
+    const void** storedKeyPtrPtr,   ///< [out] Stored key.  May be NULL.
+    const void** valuePtrPtr        ///< [out] Stored value.  May be NULL.
+)
+{
+    size_t hash = HashKey(mapRef, keyPtr);
+    const void* storedKeyPtr;
+    const void* valuePtr;
+
+    if (IsOpen(mapRef))
+    {
+        le_hashmap_Slot_t *slotPtr = FindSlot(mapRef, hash, keyPtr);
+        if (slotPtr == NULL)
         {
-            HASHMAP_TRACE(
-                mapRef,
-                "Hashmap %s: Returning original key",
-                mapRef->nameStr
-            );
-            return (void*)(currentEntryPtr->keyPtr);
+            HASHMAP_TRACE(mapRef, "Hashmap %s: Key not found", mapRef->nameStr);
+            return false;
         }
-        theLinkPtr = bucket_PeekNext(listHeadPtr, theLinkPtr);
+        storedKeyPtr = slotPtr->keyPtr;
+        valuePtr = slotPtr->valuePtr;
     }
+    else
+    {
+        le_hashmap_Entry_t *entryPtr = FindEntry(mapRef, hash, keyPtr, NULL, NULL);
+        if (entryPtr == NULL)
+        {
+            HASHMAP_TRACE(mapRef, "Hashmap %s: Key not found", mapRef->nameStr);
+            return false;
+        }
+        storedKeyPtr = entryPtr->keyPtr;
+        valuePtr = entryPtr->valuePtr;
+    }
+
+    HASHMAP_TRACE(mapRef, "Hashmap %s: Key found", mapRef->nameStr);
+
+    if (storedKeyPtrPtr != NULL)
+    {
+        *storedKeyPtrPtr = storedKeyPtr;
+    }
+    if (valuePtrPtr != NULL)
+    {
+        *valuePtrPtr = valuePtr;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve a value from a HashMap.
+ *
+ * @return  Returns a pointer to the value or NULL if the key is not found.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+void* le_hashmap_Get
+(
+    le_hashmap_Ref_t mapRef,   ///< [in] Reference to the map
+    const void* keyPtr         ///< [in] Pointer to the key to be retrieved
+)
+{
+    const void* valuePtr = NULL;
+
+    LookUp(mapRef, keyPtr, NULL, &valuePtr);
+    return (void*)valuePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve a stored key from a HashMap.
+ *
+ * @return  Returns a pointer to the key that was stored in the HashMap by le_hashmap_Put() or
+ *          NULL if the key is not found.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_hashmap_GetStoredKey
+(
+    le_hashmap_Ref_t mapRef,   ///< [in] Reference to the map.
+    const void* keyPtr         ///< [in] Pointer to the key to be retrieved.
+)
+{
+    const void* storedKeyPtr = NULL;
 
-    HASHMAP_TRACE(
-        mapRef,
-        "Hashmap %s: Key not found",
-        mapRef->nameStr
-    );
-    return NULL;
+    LookUp(mapRef, keyPtr, &storedKeyPtr, NULL);
+    return (void*)storedKeyPtr;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -630,59 +1316,66 @@ void* le_hashmap_Remove
    const void* keyPtr       ///< [in] Pointer to the key to be removed
 )
 {
-    int hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
-
-    HASHMAP_TRACE(
-        mapRef,
-        "Hashmap %s: Generated index of %" PRIuS " for hash %u",
-        mapRef->nameStr,
-        index,
-        hash
-    );
+    size_t hash = HashKey(mapRef, keyPtr);
+    void* value;
 
-    le_hashmap_Bucket_t *listHeadPtr = &(mapRef->bucketsPtr[index]);
-    le_hashmap_Link_t   *theLinkPtr = bucket_Peek(listHeadPtr);
-    le_hashmap_Link_t   *prevLinkPtr = NULL;
+    ContinueRehash(mapRef);
 
-    while (theLinkPtr != NULL) {
-        le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
-                                                           le_hashmap_Entry_t,
-                                                           entryListLink);
-        if (EqualKeys(currentEntryPtr->keyPtr,
-                          keyPtr,
-                          mapRef->equalsFuncPtr)
-                          )
+    if (IsOpen(mapRef))
+    {
+        le_hashmap_Slot_t *slotPtr = FindSlot(mapRef, hash, keyPtr);
+        if (slotPtr == NULL)
         {
-            if (mapRef->iterator.currentLinkPtr == theLinkPtr)
-            {
-                le_hashmap_PrevNode(&mapRef->iterator);
-            }
+            HASHMAP_TRACE(mapRef, "Hashmap %s: Key not found", mapRef->nameStr);
+            return NULL;
+        }
 
-            void* value = (void*)(currentEntryPtr->valuePtr);
-            bucket_Remove(listHeadPtr, theLinkPtr, prevLinkPtr);
-            le_mem_Release( currentEntryPtr );
-            mapRef->size--;
+        if (mapRef->iterator.currentSlotPtr == slotPtr)
+        {
+            le_hashmap_PrevNode(&mapRef->iterator);
+        }
 
-            HASHMAP_TRACE(
-                mapRef,
-                "Hashmap %s: Removing key from map",
-                mapRef->nameStr
-            );
+        // Entries after the slot are left where they are, so the slot is marked as deleted
+        // rather than empty.
+        value = (void*)(slotPtr->valuePtr);
+        slotPtr->keyPtr = NULL;
+        slotPtr->valuePtr = NULL;
+        slotPtr->state = SLOT_DELETED;
+        if (!IsOldSlot(mapRef, slotPtr))
+        {
+            mapRef->numDeleted++;
+        }
+    }
+    else
+    {
+        le_hashmap_Bucket_t *listHeadPtr;
+        le_hashmap_Link_t   *prevLinkPtr = NULL;
+        le_hashmap_Entry_t  *currentEntryPtr = FindEntry(mapRef, hash, keyPtr,
+                                                         &listHeadPtr, &prevLinkPtr);
+        if (currentEntryPtr == NULL)
+        {
+            HASHMAP_TRACE(mapRef, "Hashmap %s: Key not found", mapRef->nameStr);
+            return NULL;
+        }
 
-            return value;
+        if (mapRef->iterator.currentLinkPtr == &currentEntryPtr->entryListLink)
+        {
+            le_hashmap_PrevNode(&mapRef->iterator);
         }
 
-        prevLinkPtr = theLinkPtr;
-        theLinkPtr = bucket_PeekNext(listHeadPtr, theLinkPtr);
+        value = (void*)(currentEntryPtr->valuePtr);
+        bucket_Remove(listHeadPtr, &currentEntryPtr->entryListLink, prevLinkPtr);
+        le_mem_Release( currentEntryPtr );
     }
+    mapRef->size--;
 
     HASHMAP_TRACE(
         mapRef,
-        "Hashmap %s: Key not found",
+        "Hashmap %s: Removing key from map",
         mapRef->nameStr
     );
-    return NULL;
+
+    return value;
 }
 
 
@@ -735,47 +1428,7 @@ bool le_hashmap_ContainsKey
     const void* keyPtr        ///< [in] Pointer to the key to be searched for
 )
 {
-    int hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
-
-    HASHMAP_TRACE(
-        mapRef,
-        "Hashmap %s: Generated index of %" PRIuS " for hash %u",
-        mapRef->nameStr,
-        index,
-        hash
-    );
-
-    le_hashmap_Bucket_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
-    le_hashmap_Link_t* theLinkPtr = bucket_Peek(listHeadPtr);
-
-    while (theLinkPtr != NULL) {
-        le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
-                                                           le_hashmap_Entry_t,
-                                                           entryListLink);
-        if (EqualKeys(currentEntryPtr->keyPtr,
-                          keyPtr,
-                          mapRef->equalsFuncPtr)
-                          )
-        {
-            HASHMAP_TRACE(
-                mapRef,
-                "Hashmap %s: Key found",
-                mapRef->nameStr
-            );
-
-            return true;
-        }
-        theLinkPtr = bucket_PeekNext(listHeadPtr, theLinkPtr);
-    }
-
-    HASHMAP_TRACE(
-       mapRef,
-       "Hashmap %s: Key not found",
-       mapRef->nameStr
-    );
-
-    return false;
+    return LookUp(mapRef, keyPtr, NULL, NULL);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -792,24 +1445,33 @@ void le_hashmap_RemoveAll
     le_hashmap_Ref_t mapRef    ///< [in] Reference to the map
 )
 {
-    // Reset the iterator
+    // Reset the iterator.  This also finishes any pending rehash.
     le_hashmap_GetIterator(mapRef);
 
-    uint32_t i;
-    for (i = 0; i < mapRef->bucketCount; i++) {
-        le_hashmap_Bucket_t *listHeadPtr = &(mapRef->bucketsPtr[i]);
-        le_hashmap_Link_t   *theLinkPtr = bucket_Peek(listHeadPtr);
+    if (IsOpen(mapRef))
+    {
+        memset(mapRef->slotsPtr, 0, mapRef->bucketCount * sizeof(le_hashmap_Slot_t));
+        mapRef->numDeleted = 0;
+        mapRef->flags &= ~HASHMAP_FLAG_UNORDERED;
+    }
+    else
+    {
+        uint32_t i;
+        for (i = 0; i < mapRef->bucketCount; i++) {
+            le_hashmap_Bucket_t *listHeadPtr = &(mapRef->bucketsPtr[i]);
+            le_hashmap_Link_t   *theLinkPtr = bucket_Peek(listHeadPtr);
 
-        while (theLinkPtr != NULL) {
-            le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
-                                                               le_hashmap_Entry_t,
-                                                               entryListLink);
-            le_hashmap_Link_t* linkPtrToRemove = theLinkPtr;
-            theLinkPtr = bucket_PeekNext(listHeadPtr, theLinkPtr);
-            bucket_Remove(listHeadPtr, linkPtrToRemove, NULL);
-            le_mem_Release( currentEntryPtr );
+            while (theLinkPtr != NULL) {
+                le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
+                                                                   le_hashmap_Entry_t,
+                                                                   entryListLink);
+                le_hashmap_Link_t* linkPtrToRemove = theLinkPtr;
+                theLinkPtr = bucket_PeekNext(listHeadPtr, theLinkPtr);
+                bucket_Remove(listHeadPtr, linkPtrToRemove, NULL);
+                le_mem_Release( currentEntryPtr );
+            }
+            mapRef->bucketsPtr[i] = BUCKET_LIST_INIT;
         }
-        mapRef->bucketsPtr[i] = BUCKET_LIST_INIT;
     }
     mapRef->size = 0;
 
@@ -821,6 +1483,59 @@ void le_hashmap_RemoveAll
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the first used slot of an open-addressed map at or after a given index.
+ *
+ * @return  The slot, or NULL if there are no more entries.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Slot_t *NextUsedSlot
+(
+    le_hashmap_Ref_t    mapRef, ///< [in] Reference to the map
+    size_t             *indexPtr///< [in,out] Index to start searching from, updated to the
+                                ///<          index of the returned slot.
+)
+{
+    le_hashmap_Slot_t *slotPtr;
+
+    for (; (slotPtr = IndexToSlot(mapRef, *indexPtr)) != NULL; ++(*indexPtr))
+    {
+        if (slotPtr->state == SLOT_USED)
+        {
+            return slotPtr;
+        }
+    }
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the first non-empty bucket of a map at or after a given index.
+ *
+ * @return  The first link in the bucket, or NULL if there are no more entries.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Link_t *NextUsedBucket
+(
+    le_hashmap_Ref_t    mapRef, ///< [in] Reference to the map
+    size_t             *indexPtr///< [in,out] Index to start searching from, updated to the
+                                ///<          index of the returned bucket.
+)
+{
+    le_hashmap_Bucket_t *listHeadPtr;
+
+    for (; (listHeadPtr = IndexToBucket(mapRef, *indexPtr)) != NULL; ++(*indexPtr))
+    {
+        le_hashmap_Link_t *theLinkPtr = bucket_Peek(listHeadPtr);
+        if (theLinkPtr != NULL)
+        {
+            return theLinkPtr;
+        }
+    }
+    return NULL;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Iterates over the whole map, calling the supplied callback with each key-value pair. If the
@@ -838,9 +1553,38 @@ bool le_hashmap_ForEach
                                             ///<      callback
 )
 {
-    uint32_t i;
-    for (i = 0; i < mapRef->bucketCount; i++) {
-        le_hashmap_Bucket_t* listHeadPtr = &(mapRef->bucketsPtr[i]);
+    bool wasWalking = ((mapRef->flags & HASHMAP_FLAG_WALKING) != 0);
+    bool result = true;
+    size_t i;
+
+    // Like le_hashmap_GetIterator(), start from a fully rehashed map, unless another iteration is
+    // already going on.  Then hold off rehashing and growing while the callback is free to put and
+    // remove entries, as the walk keeps its place by bucket (or slot).
+    if (!IsIterating(mapRef))
+    {
+        FinishRehash(mapRef);
+    }
+    mapRef->flags |= HASHMAP_FLAG_WALKING;
+
+    if (IsOpen(mapRef))
+    {
+        le_hashmap_Slot_t *slotPtr;
+
+        for (i = 0; (slotPtr = NextUsedSlot(mapRef, &i)) != NULL; ++i)
+        {
+            if (!forEachFn(slotPtr->keyPtr, slotPtr->valuePtr, context))
+            {
+                // Check to see if this is the last element, and return false if not.
+                ++i;
+                result = (NextUsedSlot(mapRef, &i) == NULL);
+                goto end;
+            }
+        }
+        goto end;
+    }
+
+    for (i = 0; i < TotalBucketCount(mapRef); i++) {
+        le_hashmap_Bucket_t* listHeadPtr = IndexToBucket(mapRef, i);
         le_hashmap_Link_t* theLinkPtr = bucket_Peek(listHeadPtr);
 
         while (theLinkPtr != NULL) {
@@ -853,24 +1597,24 @@ bool le_hashmap_ForEach
                 // Check to see if this is the last element, and return false if not.
                 if (nextLinkPtr != NULL)
                 {
-                     return false;
+                    result = false;
+                    goto end;
                 }
-                uint32_t j;
-                for (j = i; j < mapRef->bucketCount; ++j)
-                {
-                    le_hashmap_Bucket_t* listHeadPtr = &(mapRef->bucketsPtr[j]);
-                    if (bucket_Peek(listHeadPtr))
-                    {
-                        return false;
-                    }
-                }
-                return true;   // Despite stopping early, all elements have been examined.
+                size_t j = i + 1;
+                // Despite stopping early, all elements may have been examined.
+                result = (NextUsedBucket(mapRef, &j) == NULL);
+                goto end;
             }
             theLinkPtr = nextLinkPtr;
         }
     }
 
-    return true;
+end:
+    if (!wasWalking)
+    {
+        mapRef->flags &= ~HASHMAP_FLAG_WALKING;
+    }
+    return result;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -892,6 +1636,12 @@ le_hashmap_It_Ref_t le_hashmap_GetIterator
 {
     mapRef->iterator.currentIndex = 0;
     mapRef->iterator.currentLinkPtr = NULL;
+    mapRef->iterator.currentSlotPtr = NULL;
+
+    // Iterating over the map costs as much as rehashing it, so finish any pending rehash now
+    // rather than holding it up for the whole iteration.
+    FinishRehash(mapRef);
+
     return &mapRef->iterator;
 }
 
@@ -922,6 +1672,29 @@ le_result_t le_hashmap_NextNode
         return LE_NOT_FOUND;
     }
 
+    if (IsOpen(mapRef))
+    {
+        if (iteratorRef->currentSlotPtr != NULL)
+        {
+            ++iteratorRef->currentIndex;
+        }
+
+        iteratorRef->currentSlotPtr = NextUsedSlot(mapRef, &iteratorRef->currentIndex);
+        if (iteratorRef->currentSlotPtr == NULL)
+        {
+            // At end of map.  Stay there even if the map grows.
+            iteratorRef->currentIndex = SIZE_MAX;
+            return LE_NOT_FOUND;
+        }
+
+        HASHMAP_TRACE(
+            mapRef,
+            "Found index match, index is %" PRIuS,
+            iteratorRef->currentIndex
+        );
+        return LE_OK;
+    }
+
     for (;;)
     {
         listHeadPtr = IndexToBucket(mapRef, iteratorRef->currentIndex);
@@ -958,9 +1731,10 @@ le_result_t le_hashmap_NextNode
         else
         {
             ++iteratorRef->currentIndex;
-            if (iteratorRef->currentIndex >= mapRef->bucketCount)
+            if (iteratorRef->currentIndex >= TotalBucketCount(mapRef))
             {
-                // At end of map
+                // At end of map.  Stay there even if the map grows.
+                iteratorRef->currentIndex = SIZE_MAX;
                 return LE_NOT_FOUND;
             }
         }
@@ -987,14 +1761,46 @@ le_result_t le_hashmap_PrevNode
 
     // If the map is empty or we are at the beginning immediately return LE_NOT_FOUND
     if (le_hashmap_isEmpty(mapRef) ||
-        (iteratorRef->currentIndex == 0 && iteratorRef->currentLinkPtr == NULL))
+        (iteratorRef->currentIndex == 0 &&
+         iteratorRef->currentLinkPtr == NULL &&
+         iteratorRef->currentSlotPtr == NULL))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if (IsOpen(mapRef))
     {
+        // When not on an entry the iterator is past the end of the map.
+        size_t index = (iteratorRef->currentSlotPtr != NULL ?
+                            iteratorRef->currentIndex : TotalBucketCount(mapRef));
+
+        while (index > 0)
+        {
+            le_hashmap_Slot_t *slotPtr = IndexToSlot(mapRef, --index);
+
+            if (slotPtr->state == SLOT_USED)
+            {
+                iteratorRef->currentIndex = index;
+                iteratorRef->currentSlotPtr = slotPtr;
+
+                HASHMAP_TRACE(
+                    mapRef,
+                    "Found index match, index is %" PRIuS,
+                    iteratorRef->currentIndex
+                );
+                return LE_OK;
+            }
+        }
+
+        // Reached start of map
+        iteratorRef->currentIndex = 0;
+        iteratorRef->currentSlotPtr = NULL;
         return LE_NOT_FOUND;
     }
 
-    if (iteratorRef->currentIndex >= mapRef->bucketCount)
+    if (iteratorRef->currentIndex >= TotalBucketCount(mapRef))
     {
-        iteratorRef->currentIndex = mapRef->bucketCount - 1;
+        iteratorRef->currentIndex = TotalBucketCount(mapRef) - 1;
     }
     for (;;)
     {
@@ -1046,6 +1852,11 @@ const void* le_hashmap_GetKey
 {
     le_hashmap_Entry_t *entryPtr;
 
+    if (iteratorRef->currentSlotPtr != NULL)
+    {
+        return iteratorRef->currentSlotPtr->keyPtr;
+    }
+
     if (iteratorRef->currentLinkPtr == NULL)
     {
         return NULL;
@@ -1070,6 +1881,11 @@ void* le_hashmap_GetValue
 {
     le_hashmap_Entry_t *entryPtr;
 
+    if (iteratorRef->currentSlotPtr != NULL)
+    {
+        return (void *) iteratorRef->currentSlotPtr->valuePtr;
+    }
+
     if (iteratorRef->currentLinkPtr == NULL)
     {
         return NULL;
@@ -1115,22 +1931,31 @@ le_result_t le_hashmap_GetFirstNode
 
     // Find the first list head
     size_t index = 0;
-    for (
-           ;
-           index < mapRef->bucketCount;
-           index++ )
+    if (IsOpen(mapRef))
     {
-        le_hashmap_Bucket_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
-        le_hashmap_Link_t* theLinkPtr = bucket_Peek(listHeadPtr);
-
+        le_hashmap_Slot_t* slotPtr = NextUsedSlot(mapRef, &index);
+        if (NULL != slotPtr)
+        {
+            *firstKeyPtr = (void *)slotPtr->keyPtr;
+            if (NULL != firstValuePtr)
+            {
+                *firstValuePtr = (void *)slotPtr->valuePtr;
+            }
+        }
+    }
+    else
+    {
+        le_hashmap_Link_t* theLinkPtr = NextUsedBucket(mapRef, &index);
         if (NULL != theLinkPtr)
         {
             le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
                                                                le_hashmap_Entry_t,
                                                                entryListLink);
             *firstKeyPtr = (void *)currentEntryPtr->keyPtr;
-            *firstValuePtr = (void *)currentEntryPtr->valuePtr;
-            break;
+            if (NULL != firstValuePtr)
+            {
+                *firstValuePtr = (void *)currentEntryPtr->valuePtr;
+            }
         }
     }
     return LE_OK;
@@ -1170,86 +1995,69 @@ le_result_t le_hashmap_GetNodeAfter
 
     // Find the node pointed to by the key
     size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
-    HASHMAP_TRACE(
-        mapRef,
-        "Hashmap %s: Generated index of %" PRIuS " for hash %" PRIuS,
-        mapRef->nameStr,
-        index,
-        hash
-    );
+    size_t index;
+
+    if (IsOpen(mapRef))
+    {
+        le_hashmap_Slot_t* slotPtr = FindSlot(mapRef, hash, keyPtr);
+        if (NULL == slotPtr)
+        {
+            // The original key was never found
+            return LE_BAD_PARAMETER;
+        }
+
+        // Now find the next node, if there is one
+        index = SlotToIndex(mapRef, slotPtr) + 1;
+        slotPtr = NextUsedSlot(mapRef, &index);
+        if (NULL == slotPtr)
+        {
+            // We are off the end of the map
+            return LE_NOT_FOUND;
+        }
+
+        *nextKeyPtr = (void *)slotPtr->keyPtr;
+        if (NULL != nextValuePtr)
+        {
+            *nextValuePtr = (void *)slotPtr->valuePtr;
+        }
+        return LE_OK;
+    }
+
+    le_hashmap_Bucket_t* listHeadPtr;
+    le_hashmap_Entry_t* currentEntryPtr = FindEntry(mapRef, hash, keyPtr, &listHeadPtr, NULL);
+    if (NULL == currentEntryPtr)
+    {
+        // The original key was never found
+        return LE_BAD_PARAMETER;
+    }
 
-    le_hashmap_Bucket_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
     HASHMAP_TRACE(
         mapRef,
-        "Hashmap %s: Looked up list contains %" PRIuS " links",
-        mapRef->nameStr,
-        bucket_NumLinks(listHeadPtr)
+        "Hashmap %s: Found value for key",
+        mapRef->nameStr
     );
 
-    le_hashmap_Link_t* theLinkPtr = bucket_Peek(listHeadPtr);
-
-    while (theLinkPtr != NULL) {
-        le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
-                                                           le_hashmap_Entry_t,
-                                                           entryListLink);
-        if (EqualKeys(currentEntryPtr->keyPtr,
-                          keyPtr,
-                          mapRef->equalsFuncPtr)
-                          )
+    // Now find the next node, if there is one
+    le_hashmap_Link_t* theLinkPtr = bucket_PeekNext(listHeadPtr, &currentEntryPtr->entryListLink);
+    if (NULL == theLinkPtr)
+    {
+        // Find the next list head
+        index = BucketToIndex(mapRef, listHeadPtr) + 1;
+        theLinkPtr = NextUsedBucket(mapRef, &index);
+        if (NULL == theLinkPtr)
         {
-            HASHMAP_TRACE(
-                mapRef,
-                "Hashmap %s: Found value for key",
-                mapRef->nameStr
-            );
-            // Now find the next node, if there is one
-            theLinkPtr = bucket_PeekNext(listHeadPtr, theLinkPtr);
-            if (NULL == theLinkPtr)
-            {
-                // Find the next list head
-                for (
-                       index++;
-                       index < mapRef->bucketCount;
-                       index++ )
-                {
-                    listHeadPtr = &(mapRef->bucketsPtr[index]);
-                    theLinkPtr = bucket_Peek(listHeadPtr);
-
-                    if (NULL != theLinkPtr)
-                    {
-                        le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
-                                                                           le_hashmap_Entry_t,
-                                                                           entryListLink);
-                        *nextKeyPtr = (void *)currentEntryPtr->keyPtr;
-                        if (NULL != nextValuePtr)
-                        {
-                            *nextValuePtr = (void *)currentEntryPtr->valuePtr;
-                        }
-                        return LE_OK;
-                    }
-                }
-                // There was no list head - we are off the end of the map
-                return LE_NOT_FOUND;
-            }
-            else
-            {
-                le_hashmap_Entry_t* currentEntryPtr = CONTAINER_OF(theLinkPtr,
-                                                                   le_hashmap_Entry_t,
-                                                                   entryListLink);
-                *nextKeyPtr = (void *)currentEntryPtr->keyPtr;
-                if (NULL != nextValuePtr)
-                {
-                    *nextValuePtr = (void *)currentEntryPtr->valuePtr;
-                }
-                return LE_OK;
-            }
+            // There was no list head - we are off the end of the map
+            return LE_NOT_FOUND;
         }
-        theLinkPtr = bucket_PeekNext(listHeadPtr, theLinkPtr);
     }
 
-    // The original key was never found
-    return LE_BAD_PARAMETER;
+    currentEntryPtr = CONTAINER_OF(theLinkPtr, le_hashmap_Entry_t, entryListLink);
+    *nextKeyPtr = (void *)currentEntryPtr->keyPtr;
+    if (NULL != nextValuePtr)
+    {
+        *nextValuePtr = (void *)currentEntryPtr->valuePtr;
+    }
+    return LE_OK;
 }
 
 
@@ -1258,6 +2066,8 @@ le_result_t le_hashmap_GetNodeAfter
  * Counts the total number of collisions in the map. A collision occurs
  * when more than one entry is stored in the map at the same index.
  *
+ * For an open-addressed map, this is the number of entries not stored in their home slot.
+ *
  * @return  Returns The sum of the collisions in the map
  *
  */
@@ -1269,8 +2079,23 @@ size_t le_hashmap_CountCollisions
 )
 {
     size_t i, collCount = 0;
-    for (i = 0; i < mapRef->bucketCount; i++) {
-        size_t chainLength = bucket_NumLinks(&mapRef->bucketsPtr[i]);
+
+    if (IsOpen(mapRef))
+    {
+        le_hashmap_Slot_t *slotPtr;
+
+        for (i = 0; (slotPtr = NextUsedSlot(mapRef, &i)) != NULL; ++i)
+        {
+            if (slotPtr->distance > 0)
+            {
+                collCount++;
+            }
+        }
+        return collCount;
+    }
+
+    for (i = 0; i < TotalBucketCount(mapRef); i++) {
+        size_t chainLength = bucket_NumLinks(IndexToBucket(mapRef, i));
         if (chainLength > 1)
         {
             collCount += chainLength - 1;
@@ -1280,6 +2105,7 @@ size_t le_hashmap_CountCollisions
 }
 
 
+
 //--------------------------------------------------------------------------------------------------
 /**
  * String hashing function. This can be used as a parameter to le_hashmap_Create if the key to
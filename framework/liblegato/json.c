@@ -2,6 +2,16 @@
 /**
  * @file json.c JSON Parsing API implementation
  *
+ * Input is processed a block at a time (see ProcessInput()).  Runs of whitespace are skipped in a
+ * tight loop, and strings are scanned for their closing quote using memchr().  A string that lies
+ * entirely within the block and has no escaped quotes in it is reported where it is, rather than
+ * being copied into the parser's buffer; it is only copied if le_json_GetString() is called.
+ *
+ * How blocks are read from a file descriptor depends on what it refers to (see ReadMode_t).  The
+ * parser never consumes anything after the end of the document: anything read beyond it is given
+ * back (see SyncInputPosition()), and descriptors that can't give input back are read a byte at a
+ * time.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 //--------------------------------------------------------------------------------------------------
@@ -10,10 +20,17 @@
 
 #if LE_CONFIG_ENABLE_LE_JSON_API
 
+#if LE_CONFIG_LINUX
+#   include <sys/mman.h>
+#endif
+
 /// Maximum number of bytes allowed in a string value, object member name, or number's text
 /// including the null terminator.
 #define MAX_STRING_BYTES    LE_CONFIG_JSON_PARSER_BUFFER_SIZE
 
+/// Number of bytes read from a file descriptor at a time.
+#define READ_BUFFER_BYTES   LE_CONFIG_JSON_READ_BUFFER_SIZE
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -40,6 +57,22 @@ typedef enum
 Expected_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ways of reading the JSON document from a file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    READ_MODE_UNKNOWN,  ///< Not decided yet.
+    READ_MODE_BYTE,     ///< One byte at a time (pipes, terminals, etc.)
+    READ_MODE_BLOCK,    ///< A block at a time, seeking back over anything not used.
+    READ_MODE_PEEK,     ///< Peek at a block, then receive the bytes used (stream sockets).
+    READ_MODE_MAP,      ///< Map the rest of the file into memory (regular files).
+}
+ReadMode_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Each instance of the parser needs one of these to keep track of its state.
@@ -55,11 +88,18 @@ typedef struct le_json_ParsingSession
     size_t numBytes;                ///< # of bytes of content in the buffer.
     double number;                  ///< Value of last number parsed.
 
+    const char* stringPtr;          ///< Last string parsed (in the buffer or in the input).
+    size_t stringLen;               ///< Length of the last string parsed.
+    bool useSlices;                 ///< true if strings needn't fit in the buffer.
+
     int fd;                         ///< File descriptor to read the JSON document from, if parsing
                                     ///< from a document.
     le_fdMonitor_Ref_t fdMonitor;   ///< File Descriptor Monitor used to monitor the fd.
+    ReadMode_t readMode;            ///< How the file descriptor is read.
+    char readBuffer[READ_BUFFER_BYTES]; ///< Block of input read from the file descriptor.
+    size_t bytesFetched;            ///< # of bytes the fd position is past the document start.
     const char *jsonString;         ///< String to read from, if parsing from a string.
-    size_t bytesRead;               ///< # of bytes read from the file descriptor.
+    size_t bytesRead;               ///< # of bytes of the document processed.
     size_t line;                    ///< Line number of the JSON document (starts at 1).
 
     size_t valueStart;              ///< Start of the innermost value being parsed.
@@ -127,6 +167,57 @@ static inline bool NotStopped
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves the file descriptor's position to just after the last byte processed, giving back
+ * anything that was read but not used, or consuming anything that was used without being read.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SyncInputPosition
+(
+    Parser_t* parserPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (parserPtr->bytesFetched == parserPtr->bytesRead)
+    {
+        return;
+    }
+
+#if LE_CONFIG_LINUX
+    if ((parserPtr->readMode == READ_MODE_BLOCK) || (parserPtr->readMode == READ_MODE_MAP))
+    {
+        if (lseek(parserPtr->fd,
+                  (off_t)parserPtr->bytesRead - (off_t)parserPtr->bytesFetched,
+                  SEEK_CUR) == (off_t)-1)
+        {
+            LE_WARN("Failed to reposition JSON input (%m).");
+        }
+    }
+    else if (parserPtr->readMode == READ_MODE_PEEK)
+    {
+        // The bytes used are still at the start of the read buffer (they were peeked at), so
+        // receiving them into the same place leaves the buffer unchanged.
+        size_t count = parserPtr->bytesRead - parserPtr->bytesFetched;
+        ssize_t result;
+
+        do
+        {
+            result = recv(parserPtr->fd, parserPtr->readBuffer, count, MSG_DONTWAIT);
+        }
+        while ((result == -1) && (errno == EINTR));
+
+        if (result != (ssize_t)count)
+        {
+            LE_WARN("Failed to consume JSON input (%m).");
+        }
+    }
+#endif
+
+    parserPtr->bytesFetched = parserPtr->bytesRead;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Stops parsing.  (Stopping a stopped parser is okay.)
@@ -141,6 +232,7 @@ static void StopParsing
     if (NotStopped(parserPtr))
     {
         parserPtr->next = EXPECT_NOTHING;
+        SyncInputPosition(parserPtr);
         if (parserPtr->fdMonitor != NULL)
         {
             le_fdMonitor_Delete(parserPtr->fdMonitor);
@@ -375,7 +467,7 @@ static void PushContext
     le_sls_Stack(&parserPtr->contextStack, &contextPtr->link);
 
     // Clear the value buffer.
-    memset(parserPtr->buffer, 0, sizeof(parserPtr->buffer));
+    parserPtr->buffer[0] = '\0';
     parserPtr->numBytes = 0;
 }
 
@@ -448,25 +540,104 @@ static void PopContext
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Adds a byte to the parser's string buffer.
+ * Adds bytes to the parser's string buffer, keeping it null-terminated.
  */
 //--------------------------------------------------------------------------------------------------
-static void AddToBuffer
+static void AddBytesToBuffer
 (
     Parser_t* parserPtr,
-    char c
+    const char* bytesPtr,
+    size_t numBytes
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (parserPtr->numBytes >= (sizeof(parserPtr->buffer) - 1))
+    if (numBytes >= (sizeof(parserPtr->buffer) - parserPtr->numBytes))
     {
         Error(parserPtr, LE_JSON_READ_ERROR, "Content item too long to fit in internal buffer.");
     }
     else
     {
-        parserPtr->buffer[parserPtr->numBytes] = c;
-        parserPtr->numBytes++;
+        memcpy(parserPtr->buffer + parserPtr->numBytes, bytesPtr, numBytes);
+        parserPtr->numBytes += numBytes;
+        parserPtr->buffer[parserPtr->numBytes] = '\0';
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a byte to the parser's string buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void AddToBuffer
+(
+    Parser_t* parserPtr,
+    char c
+)
+//--------------------------------------------------------------------------------------------------
+{
+    AddBytesToBuffer(parserPtr, &c, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a character is whitespace (as isspace() does in the "C" locale).
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsSpace
+(
+    char c
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t') || (c == '\v') || (c == '\f');
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a length-delimited string is valid UTF-8.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsUtf8
+(
+    const char* strPtr,
+    size_t len
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t i = 0;
+
+    while (i < len)
+    {
+        // Most JSON is ASCII, so skip over that quickly.
+        if ((strPtr[i] & 0x80) == 0)
+        {
+            i++;
+            continue;
+        }
+
+        size_t charBytes = le_utf8_NumBytesInChar(strPtr[i]);
+        size_t j;
+
+        if ((charBytes == 0) || (charBytes > len - i))
+        {
+            return false;
+        }
+
+        for (j = 1; j < charBytes; j++)
+        {
+            if (!le_utf8_IsContinuationByte(strPtr[i + j]))
+            {
+                return false;
+            }
+        }
+
+        i += charBytes;
     }
+
+    return true;
 }
 
 
@@ -614,6 +785,55 @@ static void ProcessNumber
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process a string that we have just received all the characters for.  Could be a string value or
+ * an object member name.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndString
+(
+    Parser_t* parserPtr,
+    const char* strPtr,     ///< String (in the buffer or the input).  Not null-terminated.
+    size_t len              ///< Length of the string.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    parserPtr->stringPtr = strPtr;
+    parserPtr->stringLen = len;
+
+    // Make we have a valid UTF-8 string.
+    if (!IsUtf8(strPtr, len))
+    {
+        Error(parserPtr, LE_JSON_SYNTAX_ERROR, "String is not valid UTF-8.");
+    }
+    else
+    {
+        // Handling of the end of the string depends on the context.
+        le_json_ContextType_t contextType = GetContext(parserPtr)->type;
+
+        if (contextType == LE_JSON_CONTEXT_STRING)
+        {
+            Report(parserPtr, LE_JSON_STRING);
+            PopContext(parserPtr);
+        }
+        else if (contextType == LE_JSON_CONTEXT_MEMBER)
+        {
+            Report(parserPtr, LE_JSON_OBJECT_MEMBER);
+            if (NotStopped(parserPtr))
+            {
+                parserPtr->next = EXPECT_COLON;
+            }
+        }
+        else
+        {
+            LE_FATAL("Unexpected context '%s' for string termination.",
+                     le_json_GetContextName(contextType));
+        }
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Parse string characters.  Could be in a string value or an object member name.
@@ -636,35 +856,7 @@ static void ParseString
         }
         else
         {
-            // Make we have a valid UTF-8 string.
-            if (!le_utf8_IsFormatCorrect(parserPtr->buffer))
-            {
-                Error(parserPtr, LE_JSON_SYNTAX_ERROR, "String is not valid UTF-8.");
-            }
-            else
-            {
-                // Handling of the end of the string depends on the context.
-                le_json_ContextType_t contextType = GetContext(parserPtr)->type;
-
-                if (contextType == LE_JSON_CONTEXT_STRING)
-                {
-                    Report(parserPtr, LE_JSON_STRING);
-                    PopContext(parserPtr);
-                }
-                else if (contextType == LE_JSON_CONTEXT_MEMBER)
-                {
-                    Report(parserPtr, LE_JSON_OBJECT_MEMBER);
-                    if (NotStopped(parserPtr))
-                    {
-                        parserPtr->next = EXPECT_COLON;
-                    }
-                }
-                else
-                {
-                    LE_FATAL("Unexpected context '%s' for string termination.",
-                             le_json_GetContextName(contextType));
-                }
-            }
+            EndString(parserPtr, parserPtr->buffer, parserPtr->numBytes);
         }
     }
     else
@@ -875,6 +1067,281 @@ static void ProcessChar
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Scan string characters, up to and including the closing quote if it is in the input.
+ *
+ * @return Pointer to the first input byte not scanned.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* ScanString
+(
+    Parser_t* parserPtr,
+    const char* posPtr,     ///< First input byte to scan.
+    const char* endPtr      ///< End of the input.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* quotePtr = memchr(posPtr, '"', endPtr - posPtr);
+    const char* spanEndPtr = (quotePtr != NULL) ? quotePtr : endPtr;
+    size_t spanLen = spanEndPtr - posPtr;
+    const char* newlinePtr = posPtr;
+
+    while ((newlinePtr = memchr(newlinePtr, '\n', spanEndPtr - newlinePtr)) != NULL)
+    {
+        parserPtr->line++;
+        newlinePtr++;
+    }
+    parserPtr->bytesRead += spanLen;
+
+    // If the whole string is here and has no escaped quotes in it, report it where it is.
+    if (   (quotePtr != NULL)
+        && (parserPtr->numBytes == 0)
+        && ((spanLen == 0) || (quotePtr[-1] != '\\')))
+    {
+        parserPtr->bytesRead++;
+
+        if ((spanLen >= sizeof(parserPtr->buffer)) && !parserPtr->useSlices)
+        {
+            Error(parserPtr, LE_JSON_READ_ERROR, "Content item too long to fit in internal buffer.");
+        }
+        else
+        {
+            EndString(parserPtr, posPtr, spanLen);
+        }
+        return quotePtr + 1;
+    }
+
+    AddBytesToBuffer(parserPtr, posPtr, spanLen);
+
+    if ((quotePtr != NULL) && NotStopped(parserPtr))
+    {
+        parserPtr->bytesRead++;
+        ParseString(parserPtr, '"');
+        return quotePtr + 1;
+    }
+
+    return spanEndPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether whitespace is skipped in a given parser state.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool SkipsWhitespace
+(
+    Expected_t next
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (next)
+    {
+        case EXPECT_OBJECT_OR_ARRAY:
+        case EXPECT_MEMBER_OR_OBJECT_END:
+        case EXPECT_COLON:
+        case EXPECT_VALUE:
+        case EXPECT_COMMA_OR_OBJECT_END:
+        case EXPECT_MEMBER:
+        case EXPECT_VALUE_OR_ARRAY_END:
+        case EXPECT_COMMA_OR_ARRAY_END:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process a block of the JSON document, stopping early if parsing stops.
+ *
+ * @return The number of bytes processed.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t ProcessInput
+(
+    Parser_t* parserPtr,
+    const char* dataPtr,
+    size_t dataLen
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* posPtr = dataPtr;
+    const char* endPtr = dataPtr + dataLen;
+
+    while ((posPtr < endPtr) && NotStopped(parserPtr))
+    {
+        if (parserPtr->next == EXPECT_STRING)
+        {
+            posPtr = ScanString(parserPtr, posPtr, endPtr);
+        }
+        else if (IsSpace(*posPtr) && SkipsWhitespace(parserPtr->next))
+        {
+            const char* startPtr = posPtr;
+
+            do
+            {
+                if (*posPtr == '\n')
+                {
+                    parserPtr->line++;
+                }
+                posPtr++;
+            }
+            while ((posPtr < endPtr) && IsSpace(*posPtr));
+
+            parserPtr->bytesRead += posPtr - startPtr;
+        }
+        else
+        {
+            char c = *posPtr++;
+
+            parserPtr->bytesRead++;
+            if (c == '\n')
+            {
+                parserPtr->line++;
+            }
+            ProcessChar(parserPtr, c);
+        }
+    }
+
+    return posPtr - dataPtr;
+}
+
+
+#if LE_CONFIG_LINUX
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decide how to read the JSON document from a file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static ReadMode_t ChooseReadMode
+(
+    int fd
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct stat st;
+
+    if (fstat(fd, &st) == 0)
+    {
+        if (S_ISREG(st.st_mode))
+        {
+            return READ_MODE_MAP;
+        }
+
+        if (S_ISSOCK(st.st_mode))
+        {
+            int type;
+            socklen_t len = sizeof(type);
+
+            if (   (getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &len) == 0)
+                && (type == SOCK_STREAM))
+            {
+                return READ_MODE_PEEK;
+            }
+        }
+    }
+
+    if (lseek(fd, 0, SEEK_CUR) != (off_t)-1)
+    {
+        return READ_MODE_BLOCK;
+    }
+
+    return READ_MODE_BYTE;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map the rest of a regular file into memory and process it.
+ *
+ * @return LE_OK if the file was processed, LE_UNSUPPORTED if it couldn't be mapped.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ParseMappedFile
+(
+    Parser_t* parserPtr,
+    int fd
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct stat st;
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+
+    if ((offset == (off_t)-1) || (fstat(fd, &st) != 0) || (st.st_size <= offset))
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    size_t pageOffset = (size_t)offset % (size_t)sysconf(_SC_PAGESIZE);
+    size_t len = (size_t)(st.st_size - offset);
+    char* mapPtr = mmap(NULL, pageOffset + len, PROT_READ, MAP_PRIVATE, fd, offset - pageOffset);
+
+    if (mapPtr == MAP_FAILED)
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    // The fd position isn't moved until parsing stops (see SyncInputPosition()).
+    ProcessInput(parserPtr, mapPtr + pageOffset, len);
+
+    if (NotStopped(parserPtr))
+    {
+        Error(parserPtr, LE_JSON_READ_ERROR, "Unexpected end-of-file.");
+    }
+
+    munmap(mapPtr, pageOffset + len);
+
+    return LE_OK;
+}
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a block of data from the JSON document file descriptor.
+ *
+ * @return The number of bytes read, 0 at end-of-file, or -1 on error (errno is set).
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t FetchInput
+(
+    Parser_t* parserPtr,
+    int fd
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ssize_t bytesRead;
+
+    switch (parserPtr->readMode)
+    {
+#if LE_CONFIG_LINUX
+        case READ_MODE_BLOCK:
+            bytesRead = le_fd_Read(fd, parserPtr->readBuffer, sizeof(parserPtr->readBuffer));
+            break;
+
+        case READ_MODE_PEEK:
+            // Only the bytes used are received, by SyncInputPosition().
+            return recv(fd, parserPtr->readBuffer, sizeof(parserPtr->readBuffer), MSG_PEEK);
+#endif
+
+        default:
+            bytesRead = le_fd_Read(fd, parserPtr->readBuffer, 1);
+            break;
+    }
+
+    if (bytesRead > 0)
+    {
+        parserPtr->bytesFetched += bytesRead;
+    }
+
+    return bytesRead;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Read data from the JSON document file descriptor and process it.
@@ -887,13 +1354,30 @@ static void ReadData
 )
 //--------------------------------------------------------------------------------------------------
 {
+#if LE_CONFIG_LINUX
+    if (parserPtr->readMode == READ_MODE_UNKNOWN)
+    {
+        parserPtr->readMode = ChooseReadMode(fd);
+    }
+
+    if (parserPtr->readMode == READ_MODE_MAP)
+    {
+        if (ParseMappedFile(parserPtr, fd) == LE_OK)
+        {
+            return;
+        }
+        parserPtr->readMode = READ_MODE_BLOCK;
+    }
+#else
+    parserPtr->readMode = READ_MODE_BYTE;
+#endif
+
     while (NotStopped(parserPtr))
     {
-        char c;
         ssize_t bytesRead;
         do
         {
-            bytesRead = le_fd_Read(fd, &c, 1);
+            bytesRead = FetchInput(parserPtr, fd);
         }
         while ((bytesRead == -1) && (errno == EINTR));
 
@@ -938,12 +1422,11 @@ static void ReadData
         }
         else
         {
-            parserPtr->bytesRead++;
-            if (c == '\n')
-            {
-                parserPtr->line++;
-            }
-            ProcessChar(parserPtr, c);
+            ProcessInput(parserPtr, parserPtr->readBuffer, bytesRead);
+
+            // If parsing stopped part way through the block, StopParsing() has already given
+            // back the rest.
+            SyncInputPosition(parserPtr);
         }
     }
 }
@@ -1007,32 +1490,20 @@ static void StringEventHandler
     void        *unused
 )
 {
-    char c;
-
     LE_UNUSED(unused);
 
     // Increment the reference count on the Parser object so it won't go away until we are done
     // with it, even if the client calls le_json_Cleanup() for this parser.
     le_mem_AddRef(parserPtr);
 
-    while (NotStopped(parserPtr))
+    const char* dataPtr = parserPtr->jsonString + parserPtr->bytesRead;
+
+    ProcessInput(parserPtr, dataPtr, strlen(dataPtr));
+
+    if (NotStopped(parserPtr))
     {
-        c = parserPtr->jsonString[parserPtr->bytesRead];
-        if (c == '\0') // End of string?
-        {
-            // The document has been truncated.
-            Error(parserPtr, LE_JSON_READ_ERROR, "Unexpected end of JSON string");
-            break;
-        }
-        else
-        {
-            parserPtr->bytesRead++;
-            if (c == '\n')
-            {
-                parserPtr->line++;
-            }
-            ProcessChar(parserPtr, c);
-        }
+        // The document has been truncated.
+        Error(parserPtr, LE_JSON_READ_ERROR, "Unexpected end of JSON string");
     }
 
     // We are finished with the parser object now.
@@ -1335,10 +1806,68 @@ const char* le_json_GetString
         LE_FATAL("String not available.");
     }
 
+    // If the string was reported where it was in the input, copy it now.
+    if (parserPtr->stringPtr != parserPtr->buffer)
+    {
+        LE_FATAL_IF(parserPtr->stringLen >= sizeof(parserPtr->buffer),
+                    "String too long for internal buffer (use le_json_GetStringSlice()).");
+
+        memcpy(parserPtr->buffer, parserPtr->stringPtr, parserPtr->stringLen);
+        parserPtr->buffer[parserPtr->stringLen] = '\0';
+        parserPtr->numBytes = parserPtr->stringLen;
+        parserPtr->stringPtr = parserPtr->buffer;
+    }
+
     return parserPtr->buffer;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetches a string value or object member name without copying it.
+ *
+ * @return Pointer to the first byte of the string.  The string is not null-terminated.
+ *
+ * @warning This function can only be called inside event handlers when LE_JSON_OBJECT_MEMBER
+ *          or LE_JSON_STRING events are being handled.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* le_json_GetStringSlice
+(
+    size_t* lenPtr  ///< [OUT] Length of the string, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Parser_t* parserPtr = GetCurrentParser(__func__);
+
+    if (parserPtr->next != EXPECT_STRING)
+    {
+        LE_FATAL("String not available.");
+    }
+
+    *lenPtr = parserPtr->stringLen;
+    return parserPtr->stringPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allow strings that are too long for the parser's internal buffer, as long as they are only
+ * fetched using le_json_GetStringSlice().
+ *
+ * @warning This function can only be called inside event or error handlers.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_json_SetStringSlices
+(
+    bool enable     ///< [IN] true to allow long strings.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    GetCurrentParser(__func__)->useSlices = enable;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the value of a parsed number.
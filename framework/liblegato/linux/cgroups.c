@@ -87,6 +87,33 @@ static const char* SubSysName[CGRP_NUM_SUBSYSTEMS] = {"cpu,cpuacct", "memory", "
 #define MAX_FREEZE_STATE_BYTES      20
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handle to a cgroup, which keeps the control files written most often open.  A cgroup has the same
+ * name in every sub-system, so one handle covers all of them.
+ *
+ * The tasks and procs files are not read through kept-open descriptors, because the kernel may
+ * serve a re-read from a PID list it built a moment before.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char    name[LIMIT_MAX_PATH_BYTES];         ///< Name of the cgroup.
+    int     procsFd[CGRP_NUM_SUBSYSTEMS];       ///< Procs file of each sub-system, or -1.
+    int     freezeStateFd;                      ///< Freezer state file, or -1.
+}
+Handle_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool and map (by cgroup name) of cgroup handles.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t HandlePool;
+static le_hashmap_Ref_t HandleMap;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks if all cgroup subsystems are mounted.
@@ -185,6 +212,13 @@ void cgrp_Init
             MountSubSys();
         }
     }
+
+    if (HandlePool == NULL)
+    {
+        HandlePool = le_mem_CreatePool("CgroupHandles", sizeof(Handle_t));
+        HandleMap = le_hashmap_Create("CgroupHandles", 31,
+                                      le_hashmap_HashString, le_hashmap_EqualsString);
+    }
 }
 
 
@@ -231,7 +265,88 @@ static int OpenCgrpFile
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Writes a string to a cgroup file.  Overwrites what is currently in the file.
+ * Gets the handle of a cgroup, creating it if it does not exist yet.
+ *
+ * @return
+ *      Pointer to the handle.
+ */
+//--------------------------------------------------------------------------------------------------
+static Handle_t* GetHandle
+(
+    const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
+)
+{
+    Handle_t* handlePtr = le_hashmap_Get(HandleMap, cgroupNamePtr);
+
+    if (handlePtr == NULL)
+    {
+        handlePtr = le_mem_ForceAlloc(HandlePool);
+
+        LE_ASSERT(le_utf8_Copy(handlePtr->name, cgroupNamePtr, sizeof(handlePtr->name),
+                               NULL) == LE_OK);
+
+        cgrp_SubSys_t subSys = 0;
+        for (; subSys < CGRP_NUM_SUBSYSTEMS; subSys++)
+        {
+            handlePtr->procsFd[subSys] = -1;
+        }
+        handlePtr->freezeStateFd = -1;
+
+        le_hashmap_Put(HandleMap, handlePtr->name, handlePtr);
+    }
+
+    return handlePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a cgroup file kept open in a handle, opening it if it is not open yet.
+ *
+ * @return
+ *      The file descriptor if successful.
+ *      A negative value if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static int GetHandleFile
+(
+    int* fdPtr,                     ///< [IN/OUT] The handle's file descriptor for the file.
+    cgrp_SubSys_t subsystem,        ///< [IN] Sub-system of the cgroup.
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup.
+    const char* fileNamePtr,        ///< [IN] Name of the file.
+    int accessMode                  ///< [IN] Either O_RDONLY, O_WRONLY, or O_RDWR.
+)
+{
+    if (*fdPtr < 0)
+    {
+        *fdPtr = OpenCgrpFile(subsystem, cgroupNamePtr, fileNamePtr, accessMode | O_CLOEXEC);
+    }
+
+    return *fdPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Closes a cgroup file kept open in a handle.  It will be re-opened the next time it is needed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CloseHandleFile
+(
+    int* fdPtr                      ///< [IN/OUT] The handle's file descriptor for the file.
+)
+{
+    if (*fdPtr >= 0)
+    {
+        fd_Close(*fdPtr);
+        *fdPtr = -1;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a string to an open cgroup file.  Overwrites what is currently in the file.
  *
  * @note  Certain file types cannot accept certain types of data, and the write may fail with a
  *        specific errno value.  If the write fails with errno ESRCH this function will return
@@ -243,11 +358,11 @@ static int OpenCgrpFile
  *      LE_FAULT if there was some other error.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t WriteToFile
+static le_result_t WriteToFd
 (
-    cgrp_SubSys_t subsystem,        ///< [IN] Sub-system of the cgroup.
+    int fd,                         ///< [IN] File descriptor of the file.
     const char* cgroupNamePtr,      ///< [IN] Name of the cgroup.
-    const char* fileNamePtr,        ///< [IN] File to write to.
+    const char* fileNamePtr,        ///< [IN] Name of the file.
     const char* string              ///< [IN] String to write into the file.
 )
 {
@@ -255,14 +370,6 @@ static le_result_t WriteToFile
     size_t len = strlen(string);
     LE_ASSERT(len > 0);
 
-    // Open the file.
-    int fd = OpenCgrpFile(subsystem, cgroupNamePtr, fileNamePtr, O_WRONLY);
-
-    if (fd < 0)
-    {
-        return LE_FAULT;
-    }
-
     // Write the string to the file.
     le_result_t result = LE_OK;
     ssize_t numBytesWritten = 0;
@@ -288,6 +395,38 @@ static le_result_t WriteToFile
         }
     }
 
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a string to a cgroup file.  Overwrites what is currently in the file.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OUT_OF_RANGE if an attempt was made to write a value that the file cannot accept.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteToFile
+(
+    cgrp_SubSys_t subsystem,        ///< [IN] Sub-system of the cgroup.
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup.
+    const char* fileNamePtr,        ///< [IN] File to write to.
+    const char* string              ///< [IN] String to write into the file.
+)
+{
+    // Open the file.
+    int fd = OpenCgrpFile(subsystem, cgroupNamePtr, fileNamePtr, O_WRONLY);
+
+    if (fd < 0)
+    {
+        return LE_FAULT;
+    }
+
+    le_result_t result = WriteToFd(fd, cgroupNamePtr, fileNamePtr, string);
+
     fd_Close(fd);
 
     return result;
@@ -296,38 +435,68 @@ static le_result_t WriteToFile
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Gets a value from a cgroup file.  The value is read as a string and so a NULL-terminator is
- * always appended to the end of the read value in bufPtr.
+ * Writes a string to a cgroup file kept open in the cgroup's handle.  On an error other than an
+ * unacceptable value the file is closed, so that it is re-opened by the next write.
  *
  * @return
  *      LE_OK if successful.
- *      LE_OVERFLOW if the provided buffer is too small.
- *      LE_FAULT if there was an error.
+ *      LE_OUT_OF_RANGE if an attempt was made to write a value that the file cannot accept.
+ *      LE_FAULT if there was some other error.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t GetValue
+static le_result_t WriteToHandleFile
 (
+    int* fdPtr,                     ///< [IN/OUT] The handle's file descriptor for the file.
     cgrp_SubSys_t subsystem,        ///< [IN] Sub-system of the cgroup.
     const char* cgroupNamePtr,      ///< [IN] Name of the cgroup.
-    const char* fileNamePtr,        ///< [IN] File name to read from.
-    char* bufPtr,                   ///< [OUT] Buffer to store the value in.
-    size_t bufSize                  ///< [IN] Size of the buffer.
+    const char* fileNamePtr,        ///< [IN] File to write to.
+    const char* string              ///< [IN] String to write into the file.
 )
 {
-    // Open the file.
-    int fd = OpenCgrpFile(subsystem, cgroupNamePtr, fileNamePtr, O_RDONLY);
+    int fd = GetHandleFile(fdPtr, subsystem, cgroupNamePtr, fileNamePtr, O_RDWR);
 
     if (fd < 0)
     {
         return LE_FAULT;
     }
 
-    // Read the value from the file.
+    le_result_t result = WriteToFd(fd, cgroupNamePtr, fileNamePtr, string);
+
+    if (result == LE_FAULT)
+    {
+        CloseHandleFile(fdPtr);
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a value from an open cgroup file.  The value is read as a string and so a NULL-terminator
+ * is always appended to the end of the read value in bufPtr.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if the provided buffer is too small.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetValueFromFd
+(
+    int fd,                         ///< [IN] File descriptor of the file.
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup.
+    const char* fileNamePtr,        ///< [IN] File name to read from.
+    char* bufPtr,                   ///< [OUT] Buffer to store the value in.
+    size_t bufSize                  ///< [IN] Size of the buffer.
+)
+{
+    // Read the value from the start of the file, which makes the kernel generate it afresh.
     ssize_t numBytesRead;
 
     do
     {
-        numBytesRead = read(fd, bufPtr, bufSize);
+        numBytesRead = pread(fd, bufPtr, bufSize, 0);
     }
     while ( (numBytesRead == -1) && (errno == EINTR) );
 
@@ -360,6 +529,40 @@ static le_result_t GetValue
         result = LE_OK;
     }
 
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a value from a cgroup file.  The value is read as a string and so a NULL-terminator is
+ * always appended to the end of the read value in bufPtr.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OVERFLOW if the provided buffer is too small.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetValue
+(
+    cgrp_SubSys_t subsystem,        ///< [IN] Sub-system of the cgroup.
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup.
+    const char* fileNamePtr,        ///< [IN] File name to read from.
+    char* bufPtr,                   ///< [OUT] Buffer to store the value in.
+    size_t bufSize                  ///< [IN] Size of the buffer.
+)
+{
+    // Open the file.
+    int fd = OpenCgrpFile(subsystem, cgroupNamePtr, fileNamePtr, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return LE_FAULT;
+    }
+
+    le_result_t result = GetValueFromFd(fd, cgroupNamePtr, fileNamePtr, bufPtr, bufSize);
+
     fd_Close(fd);
 
     return result;
@@ -493,13 +696,55 @@ le_result_t cgrp_AddProc
     pid_t pidToAdd                  ///< PID of the process to add.
 )
 {
-    // Convert the pid to a string.
-    char pidStr[MAX_DIGITS];
+    return cgrp_AddProcs(subsystem, cgroupNamePtr, &pidToAdd, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a number of processes to a cgroup.  The cgroup's procs file is kept open between calls, so
+ * adding processes costs one write each.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OUT_OF_RANGE if one of the processes doesn't exist.  The others are still added.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_AddProcs
+(
+    cgrp_SubSys_t subsystem,        ///< Sub-system of the cgroup.
+    const char* cgroupNamePtr,      ///< Name of the cgroup to add the processes to.
+    const pid_t* pidListPtr,        ///< PIDs of the processes to add.
+    size_t numPids                  ///< Number of PIDs in the list.
+)
+{
+    Handle_t* handlePtr = GetHandle(cgroupNamePtr);
+    le_result_t result = LE_OK;
+    size_t i;
+
+    for (i = 0; i < numPids; i++)
+    {
+        // Convert the pid to a string.
+        char pidStr[MAX_DIGITS];
 
-    LE_ASSERT(snprintf(pidStr, sizeof(pidStr), "%d", pidToAdd) < sizeof(pidStr));
+        LE_ASSERT(snprintf(pidStr, sizeof(pidStr), "%d", pidListPtr[i]) < sizeof(pidStr));
 
-    // Write the pid to the file.
-    return WriteToFile(subsystem, cgroupNamePtr, PROCS_FILENAME, pidStr);
+        // Write the pid to the file.  The kernel takes one pid per write.
+        le_result_t writeResult = WriteToHandleFile(&handlePtr->procsFd[subsystem], subsystem,
+                                                    cgroupNamePtr, PROCS_FILENAME, pidStr);
+
+        if (writeResult == LE_FAULT)
+        {
+            return LE_FAULT;
+        }
+        else if (writeResult != LE_OK)
+        {
+            result = writeResult;
+        }
+    }
+
+    return result;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -835,6 +1080,32 @@ le_result_t cgrp_Delete
     LE_ASSERT(le_path_Concat("/", path, sizeof(path), SubSysName[subsystem], cgroupNamePtr,
                              (char*)NULL) == LE_OK);
 
+    // Close the files of this sub-system kept open in the cgroup's handle, and drop the handle
+    // once none are left.
+    Handle_t* handlePtr = le_hashmap_Get(HandleMap, cgroupNamePtr);
+
+    if (handlePtr != NULL)
+    {
+        CloseHandleFile(&handlePtr->procsFd[subsystem]);
+        if (subsystem == CGRP_SUBSYS_FREEZE)
+        {
+            CloseHandleFile(&handlePtr->freezeStateFd);
+        }
+
+        bool isOpen = (handlePtr->freezeStateFd >= 0);
+        cgrp_SubSys_t subSys = 0;
+        for (; subSys < CGRP_NUM_SUBSYSTEMS; subSys++)
+        {
+            isOpen = isOpen || (handlePtr->procsFd[subSys] >= 0);
+        }
+
+        if (!isOpen)
+        {
+            le_hashmap_Remove(HandleMap, handlePtr->name);
+            le_mem_Release(handlePtr);
+        }
+    }
+
     // Attempt to remove the cgroup directory.
     if (rmdir(path) != 0)
     {
@@ -1002,7 +1273,10 @@ le_result_t cgrp_frz_Freeze
     const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
 )
 {
-    if (WriteToFile(CGRP_SUBSYS_FREEZE, cgroupNamePtr, FREEZE_STATE_FILENAME, "FROZEN") != LE_OK)
+    Handle_t* handlePtr = GetHandle(cgroupNamePtr);
+
+    if (WriteToHandleFile(&handlePtr->freezeStateFd, CGRP_SUBSYS_FREEZE, cgroupNamePtr,
+                          FREEZE_STATE_FILENAME, "FROZEN") != LE_OK)
     {
         return LE_FAULT;
     }
@@ -1028,7 +1302,10 @@ le_result_t cgrp_frz_Thaw
     const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
 )
 {
-    if (WriteToFile(CGRP_SUBSYS_FREEZE, cgroupNamePtr, FREEZE_STATE_FILENAME, "THAWED") != LE_OK)
+    Handle_t* handlePtr = GetHandle(cgroupNamePtr);
+
+    if (WriteToHandleFile(&handlePtr->freezeStateFd, CGRP_SUBSYS_FREEZE, cgroupNamePtr,
+                          FREEZE_STATE_FILENAME, "THAWED") != LE_OK)
     {
         return LE_FAULT;
     }
@@ -1042,27 +1319,39 @@ le_result_t cgrp_frz_Thaw
  * Gets the freeze state of the cgroup.
  *
  * @return
- *      Freeze state of the cgroup if successful.
+ *      LE_OK if successful.
  *      LE_FAULT if there was an error.
  */
 //--------------------------------------------------------------------------------------------------
-cgrp_FreezeState_t cgrp_frz_GetState
+le_result_t cgrp_frz_GetState
 (
-    const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup.
+    cgrp_FreezeState_t* statePtr    ///< [OUT] Freeze state of the cgroup.
 )
 {
     char stateStr[MAX_FREEZE_STATE_BYTES] = {0};
+    Handle_t* handlePtr = GetHandle(cgroupNamePtr);
+
+    // This is polled while an app is being frozen, so the file is kept open.
+    int fd = GetHandleFile(&handlePtr->freezeStateFd, CGRP_SUBSYS_FREEZE, cgroupNamePtr,
+                           FREEZE_STATE_FILENAME, O_RDWR);
+
+    if (fd < 0)
+    {
+        return LE_FAULT;
+    }
 
-    le_result_t result = GetValue(CGRP_SUBSYS_FREEZE,
-                                  cgroupNamePtr,
-                                  FREEZE_STATE_FILENAME,
-                                  stateStr,
-                                  sizeof(stateStr));
+    le_result_t result = GetValueFromFd(fd,
+                                        cgroupNamePtr,
+                                        FREEZE_STATE_FILENAME,
+                                        stateStr,
+                                        sizeof(stateStr));
 
     LE_FATAL_IF(result == LE_OVERFLOW, "Freeze state string '%s...' is too long.", stateStr);
 
     if (result == LE_FAULT)
     {
+        CloseHandleFile(&handlePtr->freezeStateFd);
         return LE_FAULT;
     }
 
@@ -1071,11 +1360,13 @@ cgrp_FreezeState_t cgrp_frz_GetState
     if ( (strcmp(stateStr, "THAWED") == 0) ||
          (strcmp(stateStr, "FREEZING") == 0) )
     {
-        return CGRP_THAWED;
+        *statePtr = CGRP_THAWED;
+        return LE_OK;
     }
     else if (strcmp(stateStr, "FROZEN") == 0)
     {
-        return CGRP_FROZEN;
+        *statePtr = CGRP_FROZEN;
+        return LE_OK;
     }
 
     LE_FATAL("Unrecognized freeze state '%s'.", stateStr);
@@ -82,6 +82,8 @@
  * to a cgroup is added to another cgroup in the same hierarchy, the process is moved but not copied
  * to the second cgroup, because processes can only be in one cgroup per hierarchy.
  *
+ * Several processes can be added at once using cgrp_AddProcs().
+ *
  * Processes that are forked by other processes always inherit the cgroup of their parent.
  *
  * When a process dies it is automatically removed from all cgroups it belongs to.
@@ -91,6 +93,9 @@
  * To delete a cgroup call cgrp_Delete().  Cgroups can only be deleted if they do not contain any
  * processes.
  *
+ * The procs and freezer state files written when processes are started and apps are frozen are
+ * kept open from their first use until cgrp_Delete() is called for the cgroup.
+ *
  *
  * @section c_cgrp_threadSafety Thread Safety
  *
@@ -189,6 +194,25 @@ le_result_t cgrp_AddProc
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a number of processes to a cgroup.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_OUT_OF_RANGE if one of the processes doesn't exist.  The others are still added.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_AddProcs
+(
+    cgrp_SubSys_t subsystem,        ///< [IN] Sub-system of the cgroup.
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup to add the processes to.
+    const pid_t* pidListPtr,        ///< [IN] PIDs of the processes to add.
+    size_t numPids                  ///< [IN] Number of PIDs in the list.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets a list of threads that are in a cgroup.  The number of threads in the cgroup may be
@@ -399,13 +423,14 @@ le_result_t cgrp_frz_Thaw
  * Gets the freeze state of the cgroup.
  *
  * @return
- *      Freeze state of the cgroup if successful.
+ *      LE_OK if successful.
  *      LE_FAULT if there was an error.
  */
 //--------------------------------------------------------------------------------------------------
-cgrp_FreezeState_t cgrp_frz_GetState
+le_result_t cgrp_frz_GetState
 (
-    const char* cgroupNamePtr       ///< [IN] Name of the cgroup.
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup.
+    cgrp_FreezeState_t* statePtr    ///< [OUT] Freeze state of the cgroup.
 );
 
 //--------------------------------------------------------------------------------------------------
@@ -19,14 +19,16 @@
  * Included in the set of file descriptors that are being monitored by epoll is an eventfd
  * (see 'man eventfd') monitored in "level-triggered" mode.
  *
- * Whenever an Event Report is added to the Event Queue for a thread, the number 1 is written to
- * that thread's eventfd.  When Event Reports are popped off a thread's Event Queue, that thread's
- * eventfd is read to decrement it.  As long as the eventfd's value is greater than 0, epoll_wait()
- * will return immediately, reporting that there is something to read from that fd.
+ * Whenever an Event Report is queued to a thread that had no Event Reports pending, the number 1
+ * is written to that thread's eventfd.  Reports queued while others are still pending don't touch
+ * the eventfd.  As long as the eventfd's value is greater than 0, epoll_wait() will return
+ * immediately, reporting that there is something to read from that fd.  The thread then reads the
+ * eventfd to reset it to zero, and collects all the pending Event Reports onto its Event Queue
+ * (in that order, so that anything queued after the collection triggers the eventfd again).
  *
  * The Event Loop is an infinite loop that calls epoll_wait() and then responds to any fd events
- * that epoll_wait() reports.  If epoll_wait() reports an event on the eventfd, then an Event Report
- * is popped off the Event Queue and processed.  If epoll_wait() reports an event on any other fd,
+ * that epoll_wait() reports.  If epoll_wait() reports an event on the eventfd, then the pending
+ * Event Reports are collected and processed.  If epoll_wait() reports an event on any other fd,
  * FD Event Reports are created and pushed onto Event Queues according to what handlers are
  * registered for those events.  All pending Event Reports are processed until the Event Queue is
  * empty before returning to epoll_wait().  (NOTE: This choice was made to save system call
@@ -219,7 +221,7 @@ void fa_event_DestructThread
 /**
  * Write to a thread's Event File Descriptor.  This increments it by one.
  *
- * This must be done exactly once for each Event Report pushed onto the thread's Event Queue.
+ * This must be done whenever an Event Report is queued to a thread that had none pending.
  */
 //--------------------------------------------------------------------------------------------------
 void fa_event_TriggerEvent_NoLock
@@ -260,9 +262,9 @@ void fa_event_TriggerEvent_NoLock
 //--------------------------------------------------------------------------------------------------
 /**
  * Read a thread's Event File Descriptor.  This fetches the value of the Event FD (which is
- * the number of event reports on the Event Queue) and resets the Event FD value to zero.
+ * the number of times it has been triggered) and resets the Event FD value to zero.
  *
- * @return The number of Event Reports on the thread's Event Queue.
+ * @return The number of times the Event FD was triggered.
  */
 //--------------------------------------------------------------------------------------------------
 uint64_t fa_event_WaitForEvent
@@ -514,8 +516,9 @@ le_result_t le_event_ServiceLoop
     }
 
     // Read the eventfd to reset it to zero so epoll stops telling us about it until more
-    // are added.
-    perThreadRecPtr->liveEventCount = fa_event_WaitForEvent(perThreadRecPtr);
+    // are added, then collect the reports that have been queued.
+    fa_event_WaitForEvent(perThreadRecPtr);
+    perThreadRecPtr->liveEventCount = event_CollectEventReports(perThreadRecPtr);
 
     LE_DEBUG("perThreadRecPtr->liveEventCount is" "%" PRIu64, perThreadRecPtr->liveEventCount);
 
@@ -12,6 +12,8 @@
 #include "limit.h"
 #include "log.h"
 #include "logDaemon/logDaemon.h"
+#include "logBinary.h"
+#include "logFormat.h"
 #include "logPlatform.h"
 #include "messagingSession.h"
 
@@ -123,6 +125,11 @@ static le_log_TraceRef_t TraceRef;
 static pthread_mutex_t Mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
 
 
+#if LE_CONFIG_LOG_ASYNC
+static void StartAsync(void);
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Default log session and log filter level, for when outside a component.
@@ -874,6 +881,57 @@ static void RegisterWithLogControlDaemon
 }
 
 
+#if LE_CONFIG_LOG_BINARY
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hands the Log Control Daemon a binary log ring and, if it accepts it, starts sending log messages
+ * through it instead of writing them out as text.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void StartBinaryLogging
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = logBinary_CreateRing();
+    if (fd < 0)
+    {
+        return;
+    }
+
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(IpcSessionRef);
+    char* packetPtr = le_msg_GetPayloadPtr(msgRef);
+
+    packetPtr[0] = LOG_CMD_BINARY_RING;
+    packetPtr[1] = '\0';
+
+    // The fd is closed once it has been sent.
+    le_msg_SetFd(msgRef, fd);
+
+    msgRef = le_msg_RequestSyncResponse(msgRef);
+
+    // The response payload is empty if the ring was accepted.
+    if (msgRef == NULL)
+    {
+        LE_ERROR("Binary log ring registration failed!");
+        return;
+    }
+
+    if (((char*)le_msg_GetPayloadPtr(msgRef))[0] == '\0')
+    {
+        logBinary_Start();
+    }
+    else
+    {
+        LE_DEBUG("Log Control Daemon did not accept binary log ring.");
+    }
+
+    le_msg_ReleaseMsg(msgRef);
+}
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize the logging system.
@@ -911,6 +969,11 @@ void fa_log_Init
 
     // Set the syslog format.
     openlog("Legato", 0, LOG_USER);
+
+#if LE_CONFIG_LOG_ASYNC
+    // Start the background thread that writes out log messages.
+    StartAsync();
+#endif
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1003,6 +1066,10 @@ void le_log_ConnectToControlDaemon
 
             linkPtr = le_sls_PeekNext(&SessionList, linkPtr);
         }
+
+#if LE_CONFIG_LOG_BINARY
+        StartBinaryLogging();
+#endif
     }
 }
 
@@ -1020,6 +1087,10 @@ void log_DisconnectFromControlDaemon
         {
             return;
         }
+#if LE_CONFIG_LOG_BINARY
+        // Nobody would be reading the binary log ring any more.
+        logBinary_Stop();
+#endif
         le_msg_DeleteSession(IpcSessionRef);
         IpcSessionRef = NULL;
 }
@@ -1111,6 +1182,501 @@ static int ConvertToSyslogLevel
 }
 #endif
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a fully built log message out to the log.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteLogMsg
+(
+    le_log_Level_t  level,              ///< [IN] Severity level.
+    const char*     levelPtr,           ///< [IN] Severity level or trace keyword string.
+    const char*     procNamePtr,        ///< [IN] Process name.
+    const char*     compNamePtr,        ///< [IN] Component name.
+    const char*     threadNamePtr,      ///< [IN] Thread name.
+    const char*     baseFileNamePtr,    ///< [IN] Source file name, without the directory.
+    const char*     functionNamePtr,    ///< [IN] Function name, or NULL.
+    unsigned int    lineNumber,         ///< [IN] Source line number.
+    const char*     msgPtr,             ///< [IN] The user message.
+    time_t          now                 ///< [IN] Time the message was logged.
+)
+{
+    // If running on an embedded target, write the message out to the log.
+#ifdef LEGATO_EMBEDDED
+
+    LE_UNUSED(now);
+
+    if (functionNamePtr == NULL)
+    {
+        syslog(ConvertToSyslogLevel(level), "%s | %s[%d]/%s T=%s | %s %d | %s\n",
+           levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr, baseFileNamePtr,
+           lineNumber, msgPtr);
+    }
+    else
+    {
+        syslog(ConvertToSyslogLevel(level), "%s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
+           levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr, baseFileNamePtr,
+           functionNamePtr, lineNumber, msgPtr);
+    }
+
+    // If running on a PC, write the message to standard error with a timestamp added.
+#else
+
+    LE_UNUSED(level);
+
+    char timeStamp[26] = "";
+    char* timeStampPtr = timeStamp;
+
+    if ( (now != ((time_t)-1)) && (ctime_r(&now, timeStamp) != NULL) )
+    {
+        // Tue Jan 14 18:01:56 2014
+        // 0123456789012345678901234
+        timeStampPtr = timeStamp + 4; // Skip day of week.
+        timeStamp[19] = '\0';  // Exclude the year.
+    }
+
+    if (functionNamePtr == NULL)
+    {
+        fprintf(stderr, "%s : %s | %s[%d]/%s T=%s | %s %d | %s\n",
+                timeStampPtr, levelPtr, procNamePtr, getpid(), compNamePtr,
+                threadNamePtr, baseFileNamePtr, lineNumber, msgPtr);
+    }
+    else
+    {
+        fprintf(stderr, "%s : %s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
+            timeStampPtr, levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr,
+            baseFileNamePtr, functionNamePtr, lineNumber, msgPtr);
+    }
+
+#endif
+}
+
+
+#if LE_CONFIG_LOG_ASYNC
+//--------------------------------------------------------------------------------------------------
+/**
+ * Asynchronous logging.
+ *
+ * Log messages are put into a fixed-size ring of records by the threads that log them, and written
+ * out to the log by a background flusher thread.  The ring is a bounded multi-producer queue
+ * (a sequence number in each record tells whether it is free, being filled in, or ready to be
+ * written), so logging threads never wait on a lock or on the log itself.  If the ring is full,
+ * the message is dropped and counted; the flusher reports the number dropped in the log.
+ *
+ * Where possible, the message is not formatted by the logging thread.  Instead, the values of the
+ * format arguments (and copies of any strings) are captured in binary and the flusher does the
+ * formatting.  Formats that can't be captured this way (e.g., ones using '*' widths or positional
+ * arguments) are formatted by the logging thread.
+ *
+ * Critical and emergency messages are written synchronously, after writing out whatever is
+ * already in the ring, because they are typically followed by the process terminating.
+ */
+//--------------------------------------------------------------------------------------------------
+
+/// Number of records in the ring.
+#define ASYNC_RING_SIZE     LE_CONFIG_LOG_ASYNC_RING_SIZE
+
+#if (ASYNC_RING_SIZE & (ASYNC_RING_SIZE - 1)) != 0
+#error "LE_CONFIG_LOG_ASYNC_RING_SIZE must be a power of two"
+#endif
+
+/// How long the flusher waits for a wake-up before checking the ring anyway (seconds).
+#define FLUSHER_IDLE_TIMEOUT    1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A log record in the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t          seq;                ///< Equals the record's position if free, position + 1
+                                        ///  once filled in and ready to be written.
+    le_log_Level_t  level;              ///< Severity level.
+    const char*     levelPtr;           ///< Severity level or trace keyword string.
+    const char*     compNamePtr;        ///< Component name.
+    const char*     baseFileNamePtr;    ///< Source file name.
+    const char*     functionNamePtr;    ///< Function name, or NULL.
+    unsigned int    lineNumber;         ///< Source line number.
+    int             savedErrno;         ///< errno at the time of logging, for "%m".
+    time_t          timestamp;          ///< Time of logging.
+    const char*     formatPtr;          ///< Format string if data holds captured arguments, or NULL
+                                        ///  if data holds the formatted message.
+    char            threadName[LIMIT_MAX_THREAD_NAME_BYTES];    ///< Logging thread's name.
+    uint8_t         data[MAX_MSG_SIZE]; ///< Captured arguments or formatted message.
+}
+AsyncRecord_t;
+
+/// The ring of log records.
+static AsyncRecord_t AsyncRing[ASYNC_RING_SIZE];
+
+/// Position of the next record to be claimed by a logging thread.
+static size_t AsyncEnqueuePos;
+
+/// Position of the next record to be written out.  Protected by AsyncConsumerMutex.
+static size_t AsyncDequeuePos;
+
+/// Serializes the flusher with threads that write out the ring synchronously.
+static pthread_mutex_t AsyncConsumerMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/// Number of messages dropped because the ring was full, and the number already reported.
+static size_t AsyncDropCount;
+static size_t AsyncDropReportedCount;
+
+/// true if the flusher thread is running.  Logging is synchronous if not.
+static bool IsAsyncRunning;
+
+/// true if the flusher is about to sleep (or is sleeping) and needs a wake-up.
+static bool IsFlusherIdle;
+
+/// Used to wake up the flusher.
+static sem_t FlusherSem;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write out all the records that are ready in the ring, plus a report of any dropped messages.
+ *
+ * @warning Assumes that AsyncConsumerMutex is locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DrainRing
+(
+    void
+)
+{
+    const char* procNamePtr = le_arg_GetProgramName();
+    char msg[MAX_MSG_SIZE];
+
+    if (procNamePtr == NULL)
+    {
+        procNamePtr = "n/a";
+    }
+
+    for (;;)
+    {
+        size_t pos = AsyncDequeuePos;
+        AsyncRecord_t* recPtr = &AsyncRing[pos & (ASYNC_RING_SIZE - 1)];
+
+        if (__atomic_load_n(&recPtr->seq, __ATOMIC_ACQUIRE) != pos + 1)
+        {
+            // Not filled in yet.
+            break;
+        }
+
+        const char* msgPtr = (const char*)recPtr->data;
+        if (recPtr->formatPtr != NULL)
+        {
+            logFormat_FormatArgs(recPtr->formatPtr, recPtr->data, sizeof(recPtr->data),
+                                 recPtr->savedErrno, msg, sizeof(msg));
+            msgPtr = msg;
+        }
+
+        WriteLogMsg(recPtr->level, recPtr->levelPtr, procNamePtr, recPtr->compNamePtr,
+                    recPtr->threadName, recPtr->baseFileNamePtr, recPtr->functionNamePtr,
+                    recPtr->lineNumber, msgPtr, recPtr->timestamp);
+
+        // Hand the record back to the producers for use on the next lap around the ring.
+        __atomic_store_n(&recPtr->seq, pos + ASYNC_RING_SIZE, __ATOMIC_RELEASE);
+        AsyncDequeuePos = pos + 1;
+    }
+
+    size_t dropCount = __atomic_load_n(&AsyncDropCount, __ATOMIC_RELAXED);
+    if (dropCount != AsyncDropReportedCount)
+    {
+        snprintf(msg, sizeof(msg), "%zu log messages dropped (%zu in total).",
+                 dropCount - AsyncDropReportedCount, dropCount);
+        AsyncDropReportedCount = dropCount;
+
+        WriteLogMsg(LE_LOG_WARN, log_GetSeverityStr(LE_LOG_WARN), procNamePtr,
+                    LE_LOG_SESSION->componentNamePtr, "LogFlusher", "log.c", __func__,
+                    __LINE__, msg, time(NULL));
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether there's a record ready to be written out.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsRingReady
+(
+    void
+)
+{
+    size_t pos = AsyncDequeuePos;
+
+    return __atomic_load_n(&AsyncRing[pos & (ASYNC_RING_SIZE - 1)].seq, __ATOMIC_ACQUIRE) ==
+           pos + 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write out whatever is in the ring from the calling thread, waiting for the flusher first if it
+ * is busy doing it.
+ *
+ * The ring is left locked, so that the flusher can't write out anything logged after this point
+ * until the caller has written its own message and called UnlockRing().
+ */
+//--------------------------------------------------------------------------------------------------
+static void LockAndFlushRing
+(
+    void
+)
+{
+    pthread_mutex_lock(&AsyncConsumerMutex);
+    DrainRing();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Let the flusher write out the ring again after LockAndFlushRing().
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnlockRing
+(
+    void
+)
+{
+    pthread_mutex_unlock(&AsyncConsumerMutex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flusher thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* FlusherThreadMain
+(
+    void* contextPtr    ///< [IN] Not used.
+)
+{
+    LE_UNUSED(contextPtr);
+
+    for (;;)
+    {
+        pthread_mutex_lock(&AsyncConsumerMutex);
+        DrainRing();
+
+        // Announce that a wake-up is needed, then check again, so that a record published just
+        // before the announcement isn't left waiting.
+        __atomic_store_n(&IsFlusherIdle, true, __ATOMIC_SEQ_CST);
+        bool isReady = IsRingReady();
+        pthread_mutex_unlock(&AsyncConsumerMutex);
+
+        if (!isReady)
+        {
+            struct timespec timeout;
+
+            clock_gettime(CLOCK_REALTIME, &timeout);
+            timeout.tv_sec += FLUSHER_IDLE_TIMEOUT;
+
+            while ((sem_timedwait(&FlusherSem, &timeout) != 0) && (errno == EINTR))
+            {
+            }
+        }
+
+        __atomic_store_n(&IsFlusherIdle, false, __ATOMIC_SEQ_CST);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a log message into the ring.  If the ring is still full after trying to drain it, the
+ * message is dropped and counted.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AsyncSend
+(
+    le_log_Level_t  level,              ///< [IN] Severity level.
+    const char*     levelPtr,           ///< [IN] Severity level or trace keyword string.
+    const char*     compNamePtr,        ///< [IN] Component name.
+    const char*     baseFileNamePtr,    ///< [IN] Source file name.
+    const char*     functionNamePtr,    ///< [IN] Function name, or NULL.
+    unsigned int    lineNumber,         ///< [IN] Source line number.
+    int             savedErrno,         ///< [IN] errno at the time of logging.
+    const char*     formatPtr,          ///< [IN] The user message format.
+    va_list         args                ///< [IN] Positional parameters.
+)
+{
+    AsyncRecord_t* recPtr;
+    bool isDrainTried = false;
+    size_t pos = __atomic_load_n(&AsyncEnqueuePos, __ATOMIC_RELAXED);
+
+    // Claim a free record.
+    for (;;)
+    {
+        recPtr = &AsyncRing[pos & (ASYNC_RING_SIZE - 1)];
+        size_t seq = __atomic_load_n(&recPtr->seq, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&AsyncEnqueuePos, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+            // pos has been updated to the current value; try again.
+        }
+        else if (diff < 0)
+        {
+            // The ring is full.  Rather than drop the message straight away, drain the ring from
+            // this thread (e.g., because the flusher hasn't been scheduled yet), or wait for the
+            // flusher to finish draining it, then try again.
+            if (!isDrainTried)
+            {
+                LockAndFlushRing();
+                UnlockRing();
+                isDrainTried = true;
+                pos = __atomic_load_n(&AsyncEnqueuePos, __ATOMIC_RELAXED);
+                continue;
+            }
+
+            LE_ATOMIC_ADD_FETCH(&AsyncDropCount, 1, LE_ATOMIC_ORDER_RELAXED);
+            return;
+        }
+        else
+        {
+            pos = __atomic_load_n(&AsyncEnqueuePos, __ATOMIC_RELAXED);
+        }
+    }
+
+    // Fill it in.
+    const char* threadNamePtr = le_thread_GetMyName();
+    size_t i;
+
+    for (i = 0; (i < sizeof(recPtr->threadName) - 1) && (threadNamePtr[i] != '\0'); i++)
+    {
+        recPtr->threadName[i] = threadNamePtr[i];
+    }
+    recPtr->threadName[i] = '\0';
+
+    recPtr->level = level;
+    recPtr->levelPtr = levelPtr;
+    recPtr->compNamePtr = compNamePtr;
+    recPtr->baseFileNamePtr = baseFileNamePtr;
+    recPtr->functionNamePtr = functionNamePtr;
+    recPtr->lineNumber = lineNumber;
+    recPtr->savedErrno = savedErrno;
+    recPtr->timestamp = time(NULL);
+
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    if (logFormat_CaptureArgs(formatPtr, argsCopy, recPtr->data, sizeof(recPtr->data), NULL))
+    {
+        recPtr->formatPtr = formatPtr;
+    }
+    else
+    {
+        recPtr->formatPtr = NULL;
+        errno = savedErrno;
+        vsnprintf((char*)recPtr->data, sizeof(recPtr->data), formatPtr, args);
+    }
+    va_end(argsCopy);
+
+    // Publish it, then wake the flusher if it's waiting for work.
+    __atomic_store_n(&recPtr->seq, pos + 1, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&IsFlusherIdle, __ATOMIC_RELAXED) &&
+        __atomic_exchange_n(&IsFlusherIdle, false, __ATOMIC_SEQ_CST))
+    {
+        sem_post(&FlusherSem);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write out anything left in the ring when the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushRingAtExit
+(
+    void
+)
+{
+    if (IsAsyncRunning)
+    {
+        LockAndFlushRing();
+        UnlockRing();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Called in the child process after a fork().  The flusher thread doesn't exist in the child, so
+ * the child logs synchronously.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopAsyncInChild
+(
+    void
+)
+{
+    IsAsyncRunning = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the flusher thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartAsync
+(
+    void
+)
+{
+    pthread_t thread;
+    sigset_t allSignals;
+    sigset_t oldSignals;
+    size_t i;
+
+    for (i = 0; i < ASYNC_RING_SIZE; i++)
+    {
+        AsyncRing[i].seq = i;
+    }
+
+    if (sem_init(&FlusherSem, 0, 0) != 0)
+    {
+        return;
+    }
+
+    // The flusher must not receive any signals meant for the process's other threads.
+    sigfillset(&allSignals);
+    pthread_sigmask(SIG_SETMASK, &allSignals, &oldSignals);
+    int result = pthread_create(&thread, NULL, FlusherThreadMain, NULL);
+    pthread_sigmask(SIG_SETMASK, &oldSignals, NULL);
+
+    if (result != 0)
+    {
+        // Fall back to synchronous logging.
+        return;
+    }
+
+#if LE_CONFIG_THREAD_SETNAME
+    pthread_setname_np(thread, "LogFlusher");
+#endif
+    pthread_detach(thread);
+
+    atexit(FlushRingAtExit);
+    pthread_atfork(NULL, NULL, StopAsyncInChild);
+
+    IsAsyncRunning = true;
+}
+#endif /* end LE_CONFIG_LOG_ASYNC */
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Builds the log message and sends it to the logging system.
@@ -1153,6 +1719,9 @@ void fa_log_Send
 
     // Get either the log level or the trace keyword.
     const char* levelPtr;
+#if LE_CONFIG_LOG_BINARY
+    const char* keywordPtr = NULL;
+#endif
 
     if ( (level <= LOG_DEBUG) && (level >= LOG_EMERG) )
     {
@@ -1167,6 +1736,9 @@ void fa_log_Send
 
         // Add the trace keyword.
         levelPtr = keywordObjPtr->keyword;
+#if LE_CONFIG_LOG_BINARY
+        keywordPtr = levelPtr;
+#endif
     }
 
     // Get the component name.
@@ -1176,6 +1748,38 @@ void fa_log_Send
     // Get the file name.
     char* baseFileNamePtr = le_path_GetBasenamePtr((char*)filenamePtr, "/");
 
+#if LE_CONFIG_LOG_BINARY
+    // Critical and emergency messages always go to the log as text, so that they can be seen
+    // without the Log Control Daemon's help.
+    if (logBinary_IsStarted() && ((level < LE_LOG_CRIT) || (level > LE_LOG_EMERG)))
+    {
+        if (logBinary_Send(level, keywordPtr, compNamePtr, baseFileNamePtr, functionNamePtr,
+                           lineNumber, savedErrno, formatPtr, args) == LE_OK)
+        {
+            return;
+        }
+    }
+#endif
+
+#if LE_CONFIG_LOG_ASYNC
+    bool isRingLocked = false;
+
+    if (IsAsyncRunning)
+    {
+        if ((level < LE_LOG_CRIT) || (level > LE_LOG_EMERG))
+        {
+            AsyncSend(level, levelPtr, compNamePtr, baseFileNamePtr, functionNamePtr, lineNumber,
+                      savedErrno, formatPtr, args);
+            return;
+        }
+
+        // Critical and emergency messages are often the last thing a process does, so write them
+        // out right away, after anything that is still waiting in the ring.
+        LockAndFlushRing();
+        isRingLocked = true;
+    }
+#endif
+
     // Get the thread name.
     const char* threadNamePtr = le_thread_GetMyName();
 
@@ -1196,50 +1800,14 @@ void fa_log_Send
     // it.  If there was a truncation then that'll just show up in the logs.
     vsnprintf(msg, sizeof(msg), formatPtr, args);
 
-    // If running on an embedded target, write the message out to the log.
-#ifdef LEGATO_EMBEDDED
+    WriteLogMsg(level, levelPtr, procNamePtr, compNamePtr, threadNamePtr, baseFileNamePtr,
+                functionNamePtr, lineNumber, msg, time(NULL));
 
-    if (functionNamePtr == NULL)
+#if LE_CONFIG_LOG_ASYNC
+    if (isRingLocked)
     {
-        syslog(ConvertToSyslogLevel(level), "%s | %s[%d]/%s T=%s | %s %d | %s\n",
-           levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr, baseFileNamePtr,
-           lineNumber, msg);
-    }
-    else
-    {
-        syslog(ConvertToSyslogLevel(level), "%s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
-           levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr, baseFileNamePtr,
-           functionNamePtr, lineNumber, msg);
+        UnlockRing();
     }
-
-    // If running on a PC, write the message to standard error with a timestamp added.
-#else
-
-    time_t now;
-    char timeStamp[26] = "";
-    char* timeStampPtr = timeStamp;
-
-    if ( (time(&now) != ((time_t)-1)) && (ctime_r(&now, timeStamp) != NULL) )
-    {
-        // Tue Jan 14 18:01:56 2014
-        // 0123456789012345678901234
-        timeStampPtr = timeStamp + 4; // Skip day of week.
-        timeStamp[19] = '\0';  // Exclude the year.
-    }
-
-    if (functionNamePtr == NULL)
-    {
-        fprintf(stderr, "%s : %s | %s[%d]/%s T=%s | %s %d | %s\n",
-                timeStampPtr, levelPtr, procNamePtr, getpid(), compNamePtr,
-                threadNamePtr, baseFileNamePtr, lineNumber, msg);
-    }
-    else
-    {
-        fprintf(stderr, "%s : %s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
-            timeStampPtr, levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr,
-            baseFileNamePtr, functionNamePtr, lineNumber, msg);
-    }
-
 #endif
 }
 
@@ -0,0 +1,748 @@
+/** @file logBinary.c
+ *
+ * Binary log transport.  See logBinary.h for an overview.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+#include "fileDescriptor.h"
+#include "limit.h"
+#include "logBinary.h"
+#include "logFormat.h"
+
+#include <sys/mman.h>
+
+#if LE_CONFIG_LOG_BINARY
+
+// Not defined by older C libraries.
+#ifndef F_ADD_SEALS
+#   define F_ADD_SEALS      1033
+#   define F_GET_SEALS      1034
+#endif
+#ifndef F_SEAL_SEAL
+#   define F_SEAL_SEAL      0x0001
+#   define F_SEAL_SHRINK    0x0002
+#   define F_SEAL_GROW      0x0004
+#endif
+
+/// Size of the record area of a process's ring.
+#define RING_DATA_SIZE      LE_CONFIG_LOG_BINARY_RING_SIZE
+
+#if (RING_DATA_SIZE & (RING_DATA_SIZE - 1)) != 0
+#error "LE_CONFIG_LOG_BINARY_RING_SIZE must be a power of two"
+#endif
+
+/// Maximum number of string IDs a process can define.
+#define MAX_STRINGS         LE_CONFIG_LOG_BINARY_MAX_STRINGS
+
+/// Number of slots in the string table.  Kept at least half empty so that probe sequences are
+/// short and always end at an empty slot.
+#define STRING_TABLE_SIZE   (MAX_STRINGS * 2)
+
+/// Round a record size up to a multiple of 8 bytes.
+#define RECORD_SIZE(size)   (((size) + 7) & ~(size_t)7)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Slot in the string table, which maps string addresses in this process to string IDs.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* keyPtr;     ///< Address of the string, or NULL if the slot is empty.
+    uint16_t    id;         ///< ID assigned to the string.
+}
+StringSlot_t;
+
+/// This process's ring, or NULL if it hasn't been created.
+static logBinary_RingHeader_t* RingPtr;
+
+/// The ring's record area.
+static uint8_t* RingDataPtr;
+
+/// true once the Log Control Daemon has accepted the ring.
+static bool IsStarted;
+
+/// String table.  Entries are only ever added, so it can be searched without locking.
+static StringSlot_t StringTable[STRING_TABLE_SIZE];
+
+/// Number of string IDs assigned so far.  Protected by StringMutex.
+static uint16_t StringCount;
+
+/// Serializes the assignment of string IDs.
+static pthread_mutex_t StringMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the string table slot where the search for a string starts.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t HashString
+(
+    const char* strPtr
+)
+{
+    return (((uintptr_t)strPtr >> 2) * 2654435761u) % STRING_TABLE_SIZE;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up the ID of a string (by address).
+ *
+ * @return The ID, or LOG_BINARY_NO_STRING if none has been assigned yet.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint16_t LookUpString
+(
+    const char* strPtr
+)
+{
+    size_t i = HashString(strPtr);
+
+    for (;;)
+    {
+        const char* keyPtr = __atomic_load_n(&StringTable[i].keyPtr, __ATOMIC_ACQUIRE);
+
+        if (keyPtr == strPtr)
+        {
+            return StringTable[i].id;
+        }
+        if (keyPtr == NULL)
+        {
+            return LOG_BINARY_NO_STRING;
+        }
+
+        i = (i + 1) % STRING_TABLE_SIZE;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a string to the string table.
+ *
+ * @warning Assumes that StringMutex is locked and that the string isn't in the table already.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddString
+(
+    const char* strPtr,
+    uint16_t    id
+)
+{
+    size_t i = HashString(strPtr);
+
+    while (StringTable[i].keyPtr != NULL)
+    {
+        i = (i + 1) % STRING_TABLE_SIZE;
+    }
+
+    // Fill in the ID before publishing the key, so that readers never see a key without its ID.
+    StringTable[i].id = id;
+    __atomic_store_n(&StringTable[i].keyPtr, strPtr, __ATOMIC_RELEASE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Claim contiguous space in the ring.  If there isn't enough space left before the end of the
+ * ring, a pad record is written to fill it and the space is claimed at the start.
+ *
+ * @return true if successful, false if the ring is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Reserve
+(
+    uint32_t    size,       ///< [IN] Number of bytes needed (a multiple of 8).
+    uint32_t*   offsetPtr   ///< [OUT] Offset of the space in the record area.
+)
+{
+    uint32_t head = __atomic_load_n(&RingPtr->head, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        // The consumer zeroes the space it frees up before moving the tail past it.
+        uint32_t tail = __atomic_load_n(&RingPtr->tail, __ATOMIC_ACQUIRE);
+        uint32_t offset = head & (RING_DATA_SIZE - 1);
+        uint32_t padSize = (offset + size > RING_DATA_SIZE) ? RING_DATA_SIZE - offset : 0;
+
+        if ((head - tail) + padSize + size > RING_DATA_SIZE)
+        {
+            return false;
+        }
+
+        if (__atomic_compare_exchange_n(&RingPtr->head, &head, head + padSize + size, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            if (padSize != 0)
+            {
+                logBinary_RecordHeader_t* padPtr =
+                    (logBinary_RecordHeader_t*)(RingDataPtr + offset);
+
+                padPtr->type = LOG_BINARY_REC_PAD;
+                __atomic_store_n(&padPtr->size, padSize, __ATOMIC_RELEASE);
+                offset = 0;
+            }
+
+            *offsetPtr = offset;
+            return true;
+        }
+        // head has been updated to the current value; try again.
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a string record into claimed space in the ring.
+ *
+ * @return The size of the record.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t WriteStringRecord
+(
+    uint32_t    offset,     ///< [IN] Where to write it.
+    uint16_t    id,         ///< [IN] String ID.
+    const char* strPtr,     ///< [IN] The string.
+    size_t      strSize     ///< [IN] Number of bytes of the string to write, including terminator.
+)
+{
+    logBinary_RecordHeader_t* recPtr = (logBinary_RecordHeader_t*)(RingDataPtr + offset);
+    char* destPtr = (char*)(recPtr + 1);
+    uint32_t size = RECORD_SIZE(sizeof(*recPtr) + strSize);
+
+    recPtr->type = LOG_BINARY_REC_STRING;
+    recPtr->id = id;
+    memcpy(destPtr, strPtr, strSize - 1);
+    destPtr[strSize - 1] = '\0';
+
+    __atomic_store_n(&recPtr->size, size, __ATOMIC_RELEASE);
+
+    return size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create this process's ring.
+ *
+ * @return
+ *      The ring's file descriptor, to be passed to the Log Control Daemon, or LE_FAULT if there was
+ *      an error.  The descriptor can be closed once it has been passed on.
+ */
+//--------------------------------------------------------------------------------------------------
+int logBinary_CreateRing
+(
+    void
+)
+{
+    size_t fileSize = sizeof(logBinary_RingHeader_t) + RING_DATA_SIZE;
+
+    if (RingPtr != NULL)
+    {
+        // Already created (e.g., reconnecting to the Log Control Daemon).
+        return LE_FAULT;
+    }
+
+    int fd = fd_CreateAnonymous("LegatoLog");
+    if (fd < 0)
+    {
+        return LE_FAULT;
+    }
+
+    if (ftruncate(fd, fileSize) != 0)
+    {
+        LE_ERROR("Could not size binary log ring.  %m.");
+        fd_Close(fd);
+        return LE_FAULT;
+    }
+
+    // Seal the size so that the Log Control Daemon can safely map the file.  This is checked
+    // by the daemon, so it doesn't matter here if sealing isn't supported.
+    fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+
+    void* addr = mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        LE_ERROR("Could not map binary log ring.  %m.");
+        fd_Close(fd);
+        return LE_FAULT;
+    }
+
+    RingPtr = addr;
+    RingDataPtr = (uint8_t*)addr + sizeof(logBinary_RingHeader_t);
+
+    RingPtr->magic = LOG_BINARY_MAGIC;
+    RingPtr->version = LOG_BINARY_VERSION;
+    RingPtr->dataSize = RING_DATA_SIZE;
+
+    return fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop writing to the ring in a child process, because the Log Control Daemon only knows about the
+ * parent.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopInChild
+(
+    void
+)
+{
+    IsStarted = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start writing log messages to the ring.  Called once the Log Control Daemon has accepted it.
+ */
+//--------------------------------------------------------------------------------------------------
+void logBinary_Start
+(
+    void
+)
+{
+    LE_ASSERT(RingPtr != NULL);
+
+    pthread_atfork(NULL, NULL, StopInChild);
+
+    __atomic_store_n(&IsStarted, true, __ATOMIC_RELEASE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop writing log messages to the ring, e.g., because the connection to the Log Control Daemon
+ * has been closed.  Writing can't be restarted.
+ */
+//--------------------------------------------------------------------------------------------------
+void logBinary_Stop
+(
+    void
+)
+{
+    __atomic_store_n(&IsStarted, false, __ATOMIC_RELEASE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether log messages should be written to the ring.
+ *
+ * @return true if the ring has been started (and the process hasn't forked since).
+ */
+//--------------------------------------------------------------------------------------------------
+bool logBinary_IsStarted
+(
+    void
+)
+{
+    return __atomic_load_n(&IsStarted, __ATOMIC_ACQUIRE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a log message to the ring.  If the ring is full, the message is dropped and counted.
+ *
+ * @return
+ *      LE_OK if the message was written (or dropped).
+ *      LE_NOT_POSSIBLE if the message needs a new string ID but there are none left.  The caller
+ *      should log the message some other way.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logBinary_Send
+(
+    le_log_Level_t  level,              ///< [IN] Severity level, or -1 for a trace.
+    const char*     keywordPtr,         ///< [IN] Trace keyword (traces only, otherwise NULL).
+    const char*     compNamePtr,        ///< [IN] Component name.
+    const char*     baseFileNamePtr,    ///< [IN] Source file name.
+    const char*     functionNamePtr,    ///< [IN] Function name, or NULL.
+    unsigned int    lineNumber,         ///< [IN] Source line number.
+    int             savedErrno,         ///< [IN] errno at the time of logging.
+    const char*     formatPtr,          ///< [IN] The user message format.
+    va_list         args                ///< [IN] Positional parameters.
+)
+{
+    uint8_t data[LOG_BINARY_MAX_DATA_BYTES];
+    size_t dataSize;
+    const char* capturedFormatPtr = formatPtr;
+
+    // Capture the arguments, or failing that, format the message.  The caller's argument list is
+    // left untouched in case it has to log the message some other way.
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    if (!logFormat_CaptureArgs(formatPtr, argsCopy, data, sizeof(data), &dataSize))
+    {
+        va_end(argsCopy);
+        va_copy(argsCopy, args);
+
+        capturedFormatPtr = NULL;
+        errno = savedErrno;
+        vsnprintf((char*)data, sizeof(data), formatPtr, argsCopy);
+        dataSize = strlen((char*)data) + 1;
+    }
+    va_end(argsCopy);
+
+    const char* threadNamePtr = le_thread_GetMyName();
+    size_t threadNameSize = strnlen(threadNamePtr, LIMIT_MAX_THREAD_NAME_LEN) + 1;
+
+    // Look up the IDs of the strings the message refers to.
+    enum { KEYWORD, COMP, FILE_NAME, FUNC, FORMAT, NUM_STRINGS };
+    const char* strings[NUM_STRINGS] =
+        { keywordPtr, compNamePtr, baseFileNamePtr, functionNamePtr, capturedFormatPtr };
+    uint16_t ids[NUM_STRINGS];
+    bool isIdMissing = false;
+    int i;
+
+    for (i = 0; i < NUM_STRINGS; i++)
+    {
+        ids[i] = LOG_BINARY_NO_STRING;
+        if (strings[i] != NULL)
+        {
+            ids[i] = LookUpString(strings[i]);
+            isIdMissing |= (ids[i] == LOG_BINARY_NO_STRING);
+        }
+    }
+
+    uint32_t msgSize = RECORD_SIZE(sizeof(logBinary_MsgRecord_t) + threadNameSize + dataSize);
+    uint32_t offset;
+
+    if (!isIdMissing)
+    {
+        if (!Reserve(msgSize, &offset))
+        {
+            __atomic_add_fetch(&RingPtr->dropCount, 1, __ATOMIC_RELAXED);
+            return LE_OK;
+        }
+    }
+    else
+    {
+        // Assign IDs to the new strings and put their definitions in the ring just ahead of the
+        // message.  The IDs are only published after the space has been claimed, so that any
+        // other thread that uses them claims space after the definitions.
+        size_t strSizes[NUM_STRINGS];
+        uint32_t totalSize = msgSize;
+        uint16_t newCount = 0;
+
+        pthread_mutex_lock(&StringMutex);
+
+        for (i = 0; i < NUM_STRINGS; i++)
+        {
+            strSizes[i] = 0;
+            if (strings[i] != NULL)
+            {
+                ids[i] = LookUpString(strings[i]);
+            }
+            if ((strings[i] != NULL) && (ids[i] == LOG_BINARY_NO_STRING))
+            {
+                int j;
+
+                for (j = 0; (j < i) && (strings[j] != strings[i]); j++)
+                {
+                }
+                if (j < i)
+                {
+                    // Same string as an earlier one in this message.
+                    continue;
+                }
+
+                strSizes[i] = strnlen(strings[i], LOG_BINARY_MAX_STRING_BYTES - 1) + 1;
+                totalSize += RECORD_SIZE(sizeof(logBinary_RecordHeader_t) + strSizes[i]);
+                newCount++;
+            }
+        }
+
+        if (StringCount + newCount > MAX_STRINGS)
+        {
+            pthread_mutex_unlock(&StringMutex);
+            return LE_NOT_POSSIBLE;
+        }
+
+        if (!Reserve(totalSize, &offset))
+        {
+            pthread_mutex_unlock(&StringMutex);
+            __atomic_add_fetch(&RingPtr->dropCount, 1, __ATOMIC_RELAXED);
+            return LE_OK;
+        }
+
+        for (i = 0; i < NUM_STRINGS; i++)
+        {
+            if (strSizes[i] != 0)
+            {
+                ids[i] = ++StringCount;
+                offset += WriteStringRecord(offset, ids[i], strings[i], strSizes[i]);
+                AddString(strings[i], ids[i]);
+            }
+            else if ((strings[i] != NULL) && (ids[i] == LOG_BINARY_NO_STRING))
+            {
+                // Duplicate of an earlier string in this message.
+                ids[i] = LookUpString(strings[i]);
+            }
+        }
+
+        pthread_mutex_unlock(&StringMutex);
+    }
+
+    // Fill in the message record and commit it.
+    logBinary_MsgRecord_t* recPtr = (logBinary_MsgRecord_t*)(RingDataPtr + offset);
+    struct timespec now;
+
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    recPtr->hdr.type = LOG_BINARY_REC_MSG;
+    recPtr->hdr.id = 0;
+    recPtr->timestamp = (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+    recPtr->savedErrno = savedErrno;
+    recPtr->lineNumber = lineNumber;
+    recPtr->level = level;
+    recPtr->keywordId = ids[KEYWORD];
+    recPtr->compId = ids[COMP];
+    recPtr->fileId = ids[FILE_NAME];
+    recPtr->funcId = ids[FUNC];
+    recPtr->formatId = ids[FORMAT];
+    recPtr->threadNameSize = threadNameSize;
+    recPtr->dataSize = dataSize;
+
+    char* threadNameDestPtr = (char*)(recPtr + 1);
+    memcpy(threadNameDestPtr, threadNamePtr, threadNameSize - 1);
+    threadNameDestPtr[threadNameSize - 1] = '\0';
+    memcpy(threadNameDestPtr + threadNameSize, data, dataSize);
+
+    __atomic_store_n(&recPtr->hdr.size, msgSize, __ATOMIC_RELEASE);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map a process's ring for reading.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FORMAT_ERROR if the file isn't a valid ring.
+ *      LE_FAULT if it couldn't be mapped.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logBinary_OpenReader
+(
+    logBinary_Reader_t* readerPtr,  ///< [OUT] Reader to initialize.
+    int                 fd          ///< [IN] The ring's file descriptor.  Not closed.
+)
+{
+    struct stat fileInfo;
+
+    readerPtr->hdrPtr = NULL;
+
+    // The writer must not be able to shrink the file out from under the mapping, or reading it
+    // would crash the daemon.
+    int seals = fcntl(fd, F_GET_SEALS);
+    if ((seals == -1) || !(seals & F_SEAL_SHRINK))
+    {
+        LE_WARN("Binary log ring isn't sealed.");
+        return LE_FORMAT_ERROR;
+    }
+
+    if (fstat(fd, &fileInfo) != 0)
+    {
+        LE_ERROR("Could not stat binary log ring.  %m.");
+        return LE_FAULT;
+    }
+
+    if ((size_t)fileInfo.st_size <= sizeof(logBinary_RingHeader_t))
+    {
+        LE_WARN("Binary log ring is too small (%zu bytes).", (size_t)fileInfo.st_size);
+        return LE_FORMAT_ERROR;
+    }
+
+    void* addr = mmap(NULL, fileInfo.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        LE_ERROR("Could not map binary log ring.  %m.");
+        return LE_FAULT;
+    }
+
+    logBinary_RingHeader_t* hdrPtr = addr;
+    uint32_t dataSize = hdrPtr->dataSize;
+
+    if (   (hdrPtr->magic != LOG_BINARY_MAGIC)
+        || (hdrPtr->version != LOG_BINARY_VERSION)
+        || (dataSize < LOG_BINARY_MAX_RECORD_BYTES)
+        || ((dataSize & (dataSize - 1)) != 0)
+        || (sizeof(*hdrPtr) + dataSize != (size_t)fileInfo.st_size) )
+    {
+        LE_WARN("Invalid binary log ring.");
+        munmap(addr, fileInfo.st_size);
+        return LE_FORMAT_ERROR;
+    }
+
+    readerPtr->hdrPtr = hdrPtr;
+    readerPtr->dataPtr = (uint8_t*)addr + sizeof(*hdrPtr);
+    readerPtr->dataSize = dataSize;
+    readerPtr->tail = hdrPtr->tail;
+    readerPtr->dropCount = hdrPtr->dropCount;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmap a process's ring.
+ */
+//--------------------------------------------------------------------------------------------------
+void logBinary_CloseReader
+(
+    logBinary_Reader_t* readerPtr   ///< [IN] Reader.
+)
+{
+    if (readerPtr->hdrPtr != NULL)
+    {
+        munmap(readerPtr->hdrPtr, sizeof(logBinary_RingHeader_t) + readerPtr->dataSize);
+        readerPtr->hdrPtr = NULL;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a record copied out of a ring is well-formed, and make sure its strings are
+ * terminated.
+ *
+ * @return true if it's OK, false if not.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckRecord
+(
+    logBinary_RecordHeader_t*   recPtr,     ///< [IN] Record.
+    uint32_t                    size        ///< [IN] Size of the record.
+)
+{
+    switch (recPtr->type)
+    {
+        case LOG_BINARY_REC_STRING:
+            if ((size <= sizeof(*recPtr)) || (recPtr->id == LOG_BINARY_NO_STRING))
+            {
+                return false;
+            }
+            ((char*)recPtr)[size - 1] = '\0';
+            return true;
+
+        case LOG_BINARY_REC_MSG:
+        {
+            logBinary_MsgRecord_t* msgPtr = (logBinary_MsgRecord_t*)recPtr;
+
+            if (   (size < sizeof(*msgPtr))
+                || (msgPtr->threadNameSize == 0)
+                || (sizeof(*msgPtr) + msgPtr->threadNameSize + msgPtr->dataSize > size) )
+            {
+                return false;
+            }
+            ((char*)(msgPtr + 1))[msgPtr->threadNameSize - 1] = '\0';
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read all the committed records from a ring, in order, freeing up their space for the writer.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FORMAT_ERROR if the ring has been corrupted.  It should be closed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logBinary_Read
+(
+    logBinary_Reader_t*         readerPtr,      ///< [IN] Reader.
+    logBinary_RecordHandler_t   handlerFunc,    ///< [IN] Function to call for each record.
+    void*                       contextPtr,     ///< [IN] Passed to handlerFunc.
+    uint32_t*                   newDropsPtr     ///< [OUT] Number of messages dropped by the writer
+                                                ///        since the last read.
+)
+{
+    logBinary_RingHeader_t* hdrPtr = readerPtr->hdrPtr;
+    uint64_t recBuff[LOG_BINARY_MAX_RECORD_BYTES / sizeof(uint64_t)];
+    logBinary_RecordHeader_t* recPtr = (logBinary_RecordHeader_t*)recBuff;
+    uint32_t tail = readerPtr->tail;
+    uint32_t head = __atomic_load_n(&hdrPtr->head, __ATOMIC_ACQUIRE);
+    le_result_t result = LE_OK;
+
+    if (head - tail > readerPtr->dataSize)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    while (tail != head)
+    {
+        uint32_t offset = tail & (readerPtr->dataSize - 1);
+        logBinary_RecordHeader_t* ringRecPtr =
+            (logBinary_RecordHeader_t*)(readerPtr->dataPtr + offset);
+        uint32_t size = __atomic_load_n(&ringRecPtr->size, __ATOMIC_ACQUIRE);
+
+        if (size == 0)
+        {
+            // Not committed yet.
+            break;
+        }
+
+        if (   (size % 8 != 0)
+            || (size > head - tail)
+            || (size > readerPtr->dataSize - offset) )
+        {
+            result = LE_FORMAT_ERROR;
+            break;
+        }
+
+        bool isPad = (ringRecPtr->type == LOG_BINARY_REC_PAD);
+
+        if (!isPad)
+        {
+            if (size > sizeof(recBuff))
+            {
+                result = LE_FORMAT_ERROR;
+                break;
+            }
+            memcpy(recBuff, ringRecPtr, size);
+            recPtr->size = size;
+        }
+
+        // Hand the space back to the writers.
+        memset(ringRecPtr, 0, size);
+        tail += size;
+        __atomic_store_n(&hdrPtr->tail, tail, __ATOMIC_RELEASE);
+
+        if (!isPad)
+        {
+            if (!CheckRecord(recPtr, size))
+            {
+                result = LE_FORMAT_ERROR;
+                break;
+            }
+            handlerFunc(recPtr, contextPtr);
+        }
+    }
+
+    readerPtr->tail = tail;
+
+    uint32_t dropCount = __atomic_load_n(&hdrPtr->dropCount, __ATOMIC_RELAXED);
+    *newDropsPtr = dropCount - readerPtr->dropCount;
+    readerPtr->dropCount = dropCount;
+
+    return result;
+}
+
+#endif /* end LE_CONFIG_LOG_BINARY */
@@ -0,0 +1,289 @@
+/** @file logBinary.h
+ *
+ * Binary log transport.
+ *
+ * When binary logging is enabled (LE_CONFIG_LOG_BINARY), a process that is connected to the
+ * Log Control Daemon doesn't format its log messages as text.  Instead, it writes compact binary
+ * records into a ring in a memory-backed file that it shares with the Log Control Daemon (it
+ * passes the daemon the file descriptor over the @ref c_messaging when it connects).  The daemon
+ * periodically collects the records from all the processes' rings and keeps the most recent ones,
+ * so that they can be rendered as text when needed (see "log dump").
+ *
+ * There are three kinds of records:
+ *
+ *  - A @b message record holds the timestamp, severity level, source line number, errno, the
+ *    logging thread's name, and the format arguments captured by logFormat_CaptureArgs() (or the
+ *    formatted message, if the arguments couldn't be captured).  The component name, trace
+ *    keyword, source file name, function name and format string are referred to by ID.
+ *  - A @b string record defines a string ID.  A process writes one the first time it uses a
+ *    string, before the first message record that refers to it.  IDs are only meaningful within the
+ *    process that defines them.
+ *  - A @b pad record fills the space at the end of the ring when the next record doesn't fit.
+ *
+ * The ring is a multi-producer, single-consumer byte queue.  Producers (the process's threads)
+ * claim space for records by advancing the head position with a compare-and-swap, and commit each
+ * record by writing its size into its header last.  The consumer (the daemon) reads committed
+ * records from the tail position, zeroes the space they occupied, and then advances the tail.
+ * Records never straddle the end of the ring and are always a multiple of 8 bytes long.
+ *
+ * Nothing in the ring is trusted by the daemon; everything is copied out of the ring and checked
+ * before use.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_LOG_BINARY_H_INCLUDE_GUARD
+#define LEGATO_LOG_BINARY_H_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic number and version found at the start of a binary log ring.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_BINARY_MAGIC            0x4c474252  // "LGBR"
+#define LOG_BINARY_VERSION          1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record types.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_BINARY_REC_PAD          0
+#define LOG_BINARY_REC_STRING       1
+#define LOG_BINARY_REC_MSG          2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * String ID meaning "no string".
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_BINARY_NO_STRING        0
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a string in a string record, including the terminator.  Longer strings are
+ * truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_BINARY_MAX_STRING_BYTES 256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of the captured arguments (or formatted message) in a message record.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_BINARY_MAX_DATA_BYTES   256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of any record.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_BINARY_MAX_RECORD_BYTES 512
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header at the start of the shared ring.  The records follow, starting at offset
+ * sizeof(logBinary_RingHeader_t).
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t    magic;          ///< LOG_BINARY_MAGIC.
+    uint32_t    version;        ///< LOG_BINARY_VERSION.
+    uint32_t    dataSize;       ///< Size of the record area (a power of two).
+    uint32_t    dropCount;      ///< Number of messages dropped because the ring was full.
+    uint32_t    head __attribute__((aligned(64)));  ///< Producers' position (bytes, wraps).
+    uint32_t    tail __attribute__((aligned(64)));  ///< Consumer's position (bytes, wraps).
+}
+__attribute__((aligned(64)))
+logBinary_RingHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header at the start of every record.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t    size;           ///< Size of the record, including this header.  0 until committed.
+    uint16_t    type;           ///< LOG_BINARY_REC_xxx.
+    uint16_t    id;             ///< String ID (string records only).
+}
+logBinary_RecordHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message record.  Followed by the thread name (including its terminator), then dataSize bytes of
+ * captured arguments or, if formatId is LOG_BINARY_NO_STRING, the formatted message.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    logBinary_RecordHeader_t hdr;   ///< Record header.
+    uint64_t    timestamp;          ///< Wall clock time of logging (ns since the epoch).
+    int32_t     savedErrno;         ///< errno at the time of logging, for "%m".
+    uint32_t    lineNumber;         ///< Source line number.
+    int16_t     level;              ///< Severity level, or -1 for a trace.
+    uint16_t    keywordId;          ///< Trace keyword string ID (traces only).
+    uint16_t    compId;             ///< Component name string ID.
+    uint16_t    fileId;             ///< Source file name string ID.
+    uint16_t    funcId;             ///< Function name string ID.
+    uint16_t    formatId;           ///< Format string ID.
+    uint16_t    threadNameSize;     ///< Size of the thread name, including its terminator.
+    uint16_t    dataSize;           ///< Size of the captured arguments or message.
+}
+logBinary_MsgRecord_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The daemon's handle for reading a process's ring.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    logBinary_RingHeader_t* hdrPtr;     ///< Mapped ring, or NULL if not open.
+    uint8_t*    dataPtr;                ///< Record area.
+    uint32_t    dataSize;               ///< Size of the record area.
+    uint32_t    tail;                   ///< Position of the next record to read.
+    uint32_t    dropCount;              ///< Drop count as of the last call to logBinary_Read().
+}
+logBinary_Reader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function called by logBinary_Read() for each record read.  The record has been copied out of
+ * the ring and its size checked against the sizes of the fixed-size parts of its type.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*logBinary_RecordHandler_t)
+(
+    const logBinary_RecordHeader_t* recPtr,     ///< [IN] The record.
+    void*                           contextPtr  ///< [IN] Context pointer given to logBinary_Read().
+);
+
+
+// =============================================
+//  WRITER (CLIENT PROCESS) FUNCTIONS
+// =============================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create this process's ring.
+ *
+ * @return
+ *      The ring's file descriptor, to be passed to the Log Control Daemon, or LE_FAULT if there was
+ *      an error.  The descriptor can be closed once it has been passed on.
+ */
+//--------------------------------------------------------------------------------------------------
+int logBinary_CreateRing
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start writing log messages to the ring.  Called once the Log Control Daemon has accepted it.
+ */
+//--------------------------------------------------------------------------------------------------
+void logBinary_Start
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop writing log messages to the ring, e.g., because the connection to the Log Control Daemon
+ * has been closed.  Writing can't be restarted.
+ */
+//--------------------------------------------------------------------------------------------------
+void logBinary_Stop
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether log messages should be written to the ring.
+ *
+ * @return true if the ring has been started (and the process hasn't forked since).
+ */
+//--------------------------------------------------------------------------------------------------
+bool logBinary_IsStarted
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a log message to the ring.  If the ring is full, the message is dropped and counted.
+ *
+ * @return
+ *      LE_OK if the message was written (or dropped).
+ *      LE_NOT_POSSIBLE if the message needs a new string ID but there are none left.  The caller
+ *      should log the message some other way.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logBinary_Send
+(
+    le_log_Level_t  level,              ///< [IN] Severity level, or -1 for a trace.
+    const char*     keywordPtr,         ///< [IN] Trace keyword (traces only, otherwise NULL).
+    const char*     compNamePtr,        ///< [IN] Component name.
+    const char*     baseFileNamePtr,    ///< [IN] Source file name.
+    const char*     functionNamePtr,    ///< [IN] Function name, or NULL.
+    unsigned int    lineNumber,         ///< [IN] Source line number.
+    int             savedErrno,         ///< [IN] errno at the time of logging.
+    const char*     formatPtr,          ///< [IN] The user message format.
+    va_list         args                ///< [IN] Positional parameters.
+);
+
+
+// =============================================
+//  READER (LOG CONTROL DAEMON) FUNCTIONS
+// =============================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map a process's ring for reading.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FORMAT_ERROR if the file isn't a valid ring.
+ *      LE_FAULT if it couldn't be mapped.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logBinary_OpenReader
+(
+    logBinary_Reader_t* readerPtr,  ///< [OUT] Reader to initialize.
+    int                 fd          ///< [IN] The ring's file descriptor.  Not closed.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmap a process's ring.
+ */
+//--------------------------------------------------------------------------------------------------
+void logBinary_CloseReader
+(
+    logBinary_Reader_t* readerPtr   ///< [IN] Reader.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read all the committed records from a ring, in order, freeing up their space for the writer.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FORMAT_ERROR if the ring has been corrupted.  It should be closed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logBinary_Read
+(
+    logBinary_Reader_t*         readerPtr,      ///< [IN] Reader.
+    logBinary_RecordHandler_t   handlerFunc,    ///< [IN] Function to call for each record.
+    void*                       contextPtr,     ///< [IN] Passed to handlerFunc.
+    uint32_t*                   newDropsPtr     ///< [OUT] Number of messages dropped by the writer
+                                                ///        since the last read.
+);
+
+#endif // LEGATO_LOG_BINARY_H_INCLUDE_GUARD
@@ -0,0 +1,415 @@
+/** @file logFormat.c
+ *
+ * Deferred formatting of log messages.  See logFormat.h.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+#include "logFormat.h"
+
+#if LE_CONFIG_LOG_ASYNC || LE_CONFIG_LOG_BINARY
+
+/// Maximum length of a single conversion specification that can be formatted later.
+#define MAX_CONV_SPEC_SIZE  32
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Type of the argument consumed by a printf conversion specification.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    ARG_NONE,       ///< No argument (e.g., "%%" or "%m").
+    ARG_INT,
+    ARG_LONG,
+    ARG_LLONG,
+    ARG_INTMAX,
+    ARG_SIZE,
+    ARG_PTRDIFF,
+    ARG_DOUBLE,
+    ARG_LDOUBLE,
+    ARG_PTR,
+    ARG_STR,
+    ARG_UNSUPPORTED ///< Conversion that can't be deferred.
+}
+ArgType_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A parsed printf conversion specification.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    ArgType_t   type;       ///< Type of argument consumed.
+    int         precision;  ///< Precision, or -1 if none given.
+    size_t      len;        ///< Length of the specification, including the '%'.
+}
+ConvSpec_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a printf conversion specification.
+ *
+ * @return Pointer to the first character after the specification.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* ParseConvSpec
+(
+    const char* specPtr,    ///< [IN] Points to the '%' that starts the specification.
+    ConvSpec_t* convPtr     ///< [OUT] Parsed specification.
+)
+{
+    const char* ptr = specPtr + 1;
+    int lengthMod = 0;      // Number of 'l's, or 'L', 'j', 'z', 't', 'h'.
+
+    convPtr->type = ARG_UNSUPPORTED;
+    convPtr->precision = -1;
+
+    // Flags.
+    while ((*ptr != '\0') && (strchr("-+ #0'I", *ptr) != NULL))
+    {
+        ptr++;
+    }
+
+    // Field width.  Neither '*' nor positional arguments ("%1$d") are supported.
+    if (*ptr == '*')
+    {
+        goto done;
+    }
+    while (isdigit((unsigned char)*ptr))
+    {
+        ptr++;
+    }
+    if (*ptr == '$')
+    {
+        goto done;
+    }
+
+    // Precision.
+    if (*ptr == '.')
+    {
+        ptr++;
+        if (*ptr == '*')
+        {
+            goto done;
+        }
+        convPtr->precision = 0;
+        while (isdigit((unsigned char)*ptr))
+        {
+            convPtr->precision = convPtr->precision * 10 + (*ptr - '0');
+            ptr++;
+        }
+    }
+
+    // Length modifier.
+    switch (*ptr)
+    {
+        case 'h':
+            lengthMod = 'h';
+            ptr += (ptr[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            lengthMod = (ptr[1] == 'l') ? 2 : 1;
+            ptr += lengthMod;
+            break;
+        case 'q':
+            lengthMod = 2;
+            ptr++;
+            break;
+        case 'L':
+        case 'j':
+        case 'z':
+        case 't':
+            lengthMod = *ptr;
+            ptr++;
+            break;
+        case 'Z':
+            lengthMod = 'z';
+            ptr++;
+            break;
+    }
+
+    // Conversion.
+    switch (*ptr)
+    {
+        case 'd':
+        case 'i':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            switch (lengthMod)
+            {
+                case 0:
+                case 'h':   convPtr->type = ARG_INT;        break;
+                case 1:     convPtr->type = ARG_LONG;       break;
+                case 2:     convPtr->type = ARG_LLONG;      break;
+                case 'j':   convPtr->type = ARG_INTMAX;     break;
+                case 'z':   convPtr->type = ARG_SIZE;       break;
+                case 't':   convPtr->type = ARG_PTRDIFF;    break;
+            }
+            break;
+
+        case 'c':
+            if (lengthMod == 0)
+            {
+                convPtr->type = ARG_INT;
+            }
+            break;
+
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            if ((lengthMod == 0) || (lengthMod == 1))
+            {
+                convPtr->type = ARG_DOUBLE;
+            }
+            else if (lengthMod == 'L')
+            {
+                convPtr->type = ARG_LDOUBLE;
+            }
+            break;
+
+        case 's':
+            if (lengthMod == 0)
+            {
+                convPtr->type = ARG_STR;
+            }
+            break;
+
+        case 'p':
+            convPtr->type = ARG_PTR;
+            break;
+
+        case '%':
+        case 'm':
+            if (ptr == specPtr + 1)
+            {
+                convPtr->type = ARG_NONE;
+            }
+            break;
+    }
+
+    if (*ptr != '\0')
+    {
+        ptr++;
+    }
+
+done:
+    convPtr->len = ptr - specPtr;
+    if (convPtr->len >= MAX_CONV_SPEC_SIZE)
+    {
+        convPtr->type = ARG_UNSUPPORTED;
+    }
+
+    return ptr;
+}
+
+
+/// Append a value of a given type to a capture buffer, giving up if it doesn't fit.
+#define CAPTURE_VALUE(type, promotedType)                                   \
+    do {                                                                    \
+        type value = (type)va_arg(args, promotedType);                      \
+        if (usedSize + sizeof(value) > bufSize)                             \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        memcpy(bufPtr + usedSize, &value, sizeof(value));                   \
+        usedSize += sizeof(value);                                          \
+    } while (0)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Capture the arguments for a format string in binary, so that the message can be formatted
+ * later by logFormat_FormatArgs().  String arguments are copied.
+ *
+ * @return true if successful, false if the format can't be deferred or the arguments don't fit.
+ */
+//--------------------------------------------------------------------------------------------------
+bool logFormat_CaptureArgs
+(
+    const char* formatPtr,      ///< [IN] Format string.
+    va_list     args,           ///< [IN] Arguments.
+    uint8_t*    bufPtr,         ///< [OUT] Buffer to capture the arguments into.
+    size_t      bufSize,        ///< [IN] Size of the buffer.
+    size_t*     usedSizePtr     ///< [OUT] Number of bytes of the buffer used.  Can be NULL.
+)
+{
+    size_t usedSize = 0;
+    const char* ptr = formatPtr;
+    ConvSpec_t conv;
+
+    while ((ptr = strchr(ptr, '%')) != NULL)
+    {
+        ptr = ParseConvSpec(ptr, &conv);
+
+        switch (conv.type)
+        {
+            case ARG_NONE:                                          break;
+            case ARG_INT:       CAPTURE_VALUE(int, int);            break;
+            case ARG_LONG:      CAPTURE_VALUE(long, long);          break;
+            case ARG_LLONG:     CAPTURE_VALUE(long long, long long); break;
+            case ARG_INTMAX:    CAPTURE_VALUE(intmax_t, intmax_t);  break;
+            case ARG_SIZE:      CAPTURE_VALUE(size_t, size_t);      break;
+            case ARG_PTRDIFF:   CAPTURE_VALUE(ptrdiff_t, ptrdiff_t); break;
+            case ARG_DOUBLE:    CAPTURE_VALUE(double, double);      break;
+            case ARG_LDOUBLE:   CAPTURE_VALUE(long double, long double); break;
+            case ARG_PTR:       CAPTURE_VALUE(void*, void*);        break;
+
+            case ARG_STR:
+            {
+                const char* strPtr = va_arg(args, const char*);
+                size_t strLen;
+
+                if (strPtr == NULL)
+                {
+                    strPtr = "(null)";
+                }
+                strLen = strnlen(strPtr, (conv.precision >= 0) ? (size_t)conv.precision : bufSize);
+                if (usedSize + strLen + 1 > bufSize)
+                {
+                    return false;
+                }
+                memcpy(bufPtr + usedSize, strPtr, strLen);
+                bufPtr[usedSize + strLen] = '\0';
+                usedSize += strLen + 1;
+                break;
+            }
+
+            default:
+                return false;
+        }
+    }
+
+    if (usedSizePtr != NULL)
+    {
+        *usedSizePtr = usedSize;
+    }
+
+    return true;
+}
+
+
+/// Format the next captured value of a given type using the current conversion specification,
+/// stopping if the captured data runs out.
+#define FORMAT_VALUE(type)                                                  \
+    do {                                                                    \
+        type value;                                                         \
+        if (usedSize + sizeof(value) > bufSize)                             \
+        {                                                                   \
+            goto done;                                                      \
+        }                                                                   \
+        memcpy(&value, bufPtr + usedSize, sizeof(value));                   \
+        usedSize += sizeof(value);                                          \
+        count = snprintf(msgPtr + msgLen, msgSize - msgLen, spec, value);   \
+    } while (0)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Format a message from arguments captured by logFormat_CaptureArgs().  The result is the same as
+ * vsnprintf() would have produced from the original arguments.
+ */
+//--------------------------------------------------------------------------------------------------
+void logFormat_FormatArgs
+(
+    const char*     formatPtr,  ///< [IN] Format string.
+    const uint8_t*  bufPtr,     ///< [IN] Captured arguments.
+    size_t          bufSize,    ///< [IN] Number of bytes of captured arguments.
+    int             savedErrno, ///< [IN] errno to use for "%m".
+    char*           msgPtr,     ///< [OUT] Buffer for the formatted message.
+    size_t          msgSize     ///< [IN] Size of the message buffer.
+)
+{
+    size_t usedSize = 0;
+    size_t msgLen = 0;
+    const char* ptr = formatPtr;
+    char spec[MAX_CONV_SPEC_SIZE];
+    ConvSpec_t conv;
+
+    while ((*ptr != '\0') && (msgLen < msgSize - 1))
+    {
+        if (*ptr != '%')
+        {
+            // Copy literal text up to the next conversion.
+            const char* endPtr = strchrnul(ptr, '%');
+            size_t len = endPtr - ptr;
+
+            if (len > msgSize - 1 - msgLen)
+            {
+                len = msgSize - 1 - msgLen;
+            }
+            memcpy(msgPtr + msgLen, ptr, len);
+            msgLen += len;
+            ptr = endPtr;
+            continue;
+        }
+
+        const char* nextPtr = ParseConvSpec(ptr, &conv);
+        int count = 0;
+
+        memcpy(spec, ptr, conv.len);
+        spec[conv.len] = '\0';
+
+        switch (conv.type)
+        {
+            case ARG_NONE:
+                errno = savedErrno;
+                count = snprintf(msgPtr + msgLen, msgSize - msgLen, spec, 0);
+                break;
+
+            case ARG_INT:       FORMAT_VALUE(int);          break;
+            case ARG_LONG:      FORMAT_VALUE(long);         break;
+            case ARG_LLONG:     FORMAT_VALUE(long long);    break;
+            case ARG_INTMAX:    FORMAT_VALUE(intmax_t);     break;
+            case ARG_SIZE:      FORMAT_VALUE(size_t);       break;
+            case ARG_PTRDIFF:   FORMAT_VALUE(ptrdiff_t);    break;
+            case ARG_DOUBLE:    FORMAT_VALUE(double);       break;
+            case ARG_LDOUBLE:   FORMAT_VALUE(long double);  break;
+            case ARG_PTR:       FORMAT_VALUE(void*);        break;
+
+            case ARG_STR:
+            {
+                const char* strPtr = (const char*)bufPtr + usedSize;
+                size_t strLen = strnlen(strPtr, bufSize - usedSize);
+
+                if (strLen == bufSize - usedSize)
+                {
+                    // Not terminated within the captured data.
+                    goto done;
+                }
+                usedSize += strLen + 1;
+                count = snprintf(msgPtr + msgLen, msgSize - msgLen, spec, strPtr);
+                break;
+            }
+
+            default:
+                // Captured data can't go with this format.
+                goto done;
+        }
+
+        if (count > 0)
+        {
+            msgLen += count;
+            if (msgLen > msgSize - 1)
+            {
+                msgLen = msgSize - 1;
+            }
+        }
+
+        ptr = nextPtr;
+    }
+
+done:
+    msgPtr[msgLen] = '\0';
+}
+
+#endif /* end LE_CONFIG_LOG_ASYNC || LE_CONFIG_LOG_BINARY */
@@ -0,0 +1,59 @@
+/** @file logFormat.h
+ *
+ * Deferred formatting of log messages.
+ *
+ * The values of a log message's format arguments (and copies of any strings they point to) can be
+ * captured in a compact binary form by the thread doing the logging, and the message formatted
+ * from them later, possibly by another thread or process.  This is used by the asynchronous and
+ * binary logging back-ends.
+ *
+ * Only formats whose arguments can all be captured this way are supported: conversion
+ * specifications using '*' widths or precisions, positional arguments ("%1$d"), "%n" and wide
+ * characters or strings are not.  Callers must fall back to formatting the message immediately
+ * when capturing fails.
+ *
+ * The captured form is not portable between architectures.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_LOG_FORMAT_H_INCLUDE_GUARD
+#define LEGATO_LOG_FORMAT_H_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Capture the arguments for a format string in binary, so that the message can be formatted
+ * later by logFormat_FormatArgs().  String arguments are copied.
+ *
+ * @return true if successful, false if the format can't be deferred or the arguments don't fit.
+ */
+//--------------------------------------------------------------------------------------------------
+bool logFormat_CaptureArgs
+(
+    const char* formatPtr,      ///< [IN] Format string.
+    va_list     args,           ///< [IN] Arguments.
+    uint8_t*    bufPtr,         ///< [OUT] Buffer to capture the arguments into.
+    size_t      bufSize,        ///< [IN] Size of the buffer.
+    size_t*     usedSizePtr     ///< [OUT] Number of bytes of the buffer used.  Can be NULL.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Format a message from arguments captured by logFormat_CaptureArgs().  The result is the same as
+ * vsnprintf() would have produced from the original arguments.
+ *
+ * The captured arguments are not trusted: if they don't match the format string, the message is
+ * cut short rather than reading beyond the end of the captured data.
+ */
+//--------------------------------------------------------------------------------------------------
+void logFormat_FormatArgs
+(
+    const char*     formatPtr,  ///< [IN] Format string.
+    const uint8_t*  bufPtr,     ///< [IN] Captured arguments.
+    size_t          bufSize,    ///< [IN] Number of bytes of captured arguments.
+    int             savedErrno, ///< [IN] errno to use for "%m".
+    char*           msgPtr,     ///< [OUT] Buffer for the formatted message.
+    size_t          msgSize     ///< [IN] Size of the message buffer.
+);
+
+#endif // LEGATO_LOG_FORMAT_H_INCLUDE_GUARD
@@ -13,9 +13,30 @@
 #include "messagingSession.h"
 #include "messagingInterface.h"
 #include "messagingLocal.h"
+#include "messagingShm.h"
 #include "fileDescriptor.h"
 #include "unixSocket.h"
 
+#if LE_CONFIG_MSG_SHM
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value sent in place of the transaction ID of a message whose payload is in shared memory.
+ *
+ * Transaction IDs are Safe References, which are always odd, or zero for messages that aren't
+ * part of a transaction, so this can't be mistaken for one.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SHM_TXN_MARKER  ((void*)(uintptr_t)2)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes sent through the socket for a message whose payload is in shared memory: the
+ * marker, followed by the transaction ID and the descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SHM_MSG_BYTES   (2 * sizeof(void*) + sizeof(msgShm_Desc_t))
+#endif
+
 // =======================================
 //  PRIVATE FUNCTIONS
 // =======================================
@@ -106,6 +127,80 @@ static void MessageDestructor
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes a newly allocated Message object to be sent over a given session.
+ *
+ * @return  The message reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_msg_MessageRef_t InitMessage
+(
+    UnixMessage_t*      msgPtr,         ///< [in] Message object.
+    le_msg_SessionRef_t sessionRef,     ///< [in] Reference to the session.
+    size_t              maxPayloadSize  ///< [in] Size of the message's payload buffer, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Initialize the Message object's data members.
+    msgPtr->link = LE_DLS_LINK_INIT;
+    msgPtr->message.sessionRef = sessionRef;
+    le_mem_AddRef(sessionRef);  // Message object holds a reference to the Session object.
+
+    msgInterface_Type_t interfaceType = msgSession_GetInterfaceType(sessionRef);
+    switch (interfaceType)
+    {
+        case LE_MSG_INTERFACE_CLIENT:
+            msgPtr->clientServer.client.completionCallback = NULL;
+            msgPtr->clientServer.client.contextPtr = NULL;
+            break;
+
+        case LE_MSG_INTERFACE_SERVER:
+            msgPtr->clientServer.server.responseFd = -1;
+            break;
+
+        default:
+            LE_FATAL("Unhandled interface type (%d).", interfaceType);
+    }
+
+    msgPtr->maxPayloadSize = maxPayloadSize;
+    msgPtr->payloadSize = maxPayloadSize;
+    msgPtr->fd = -1;
+    msgPtr->txnId = 0;
+    memset(msgPtr->payload, 0, maxPayloadSize);
+
+    return msgMessage_GetMessageRef(msgPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the name of a Message Pool from a prefix and the protocol name.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BuildPoolName
+(
+    char* poolName,         ///< [out] Buffer of LIMIT_MAX_MEM_POOL_NAME_BYTES bytes.
+    const char* prefix,     ///< [in] Prefix.
+    const char* name        ///< [in] Name of the protocol.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t bytesCopied;
+    le_result_t result;
+
+    le_utf8_Copy(poolName, prefix, LIMIT_MAX_MEM_POOL_NAME_BYTES, &bytesCopied);
+    result = le_utf8_Copy(poolName + bytesCopied,
+                          name,
+                          LIMIT_MAX_MEM_POOL_NAME_BYTES - bytesCopied,
+                          NULL);
+    if (result != LE_OK)
+    {
+        LE_DEBUG("Pool name truncated to '%s' for protocol '%s'.", poolName, name);
+    }
+}
+
+
 // =======================================
 //  PROTECTED (INTER-MODULE) FUNCTIONS
 // =======================================
@@ -136,31 +231,186 @@ void msgMessage_Init
 le_mem_PoolRef_t msgMessage_CreatePool
 (
     const char* name,       ///< [in] Name of the pool.
-    size_t largestMsgSize   ///< [in] Size of the largest message payload, in bytes.
+    size_t largestMsgSize,  ///< [in] Size of the largest message payload, in bytes.
+    size_t numMsgs          ///< [in] Number of messages to pre-allocate.
 )
 //--------------------------------------------------------------------------------------------------
 {
     char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES];
-    size_t bytesCopied;
-    le_result_t result;
 
-    le_utf8_Copy(poolName, "msgs-", sizeof(poolName), &bytesCopied);
-    result = le_utf8_Copy(poolName + bytesCopied, name, sizeof(poolName) - bytesCopied, NULL);
-    if (result != LE_OK)
-    {
-        LE_DEBUG("Pool name truncated to '%s' for protocol '%s'.", poolName, name);
-    }
+    BuildPoolName(poolName, "msgs-", name);
 
     le_mem_PoolRef_t poolRef = le_mem_CreatePool(poolName, sizeof(UnixMessage_t) + largestMsgSize);
 
     le_mem_SetDestructor(poolRef, MessageDestructor);
 
-    le_mem_ExpandPool(poolRef, 10); /// @todo Make this configurable.
+    le_mem_ExpandPool(poolRef, numMsgs);
 
     return poolRef;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a reduced-size Message Pool for messages with smaller payloads, carved out of a larger
+ * Message Pool.
+ *
+ * The reduced pool inherits the larger pool's destructor.
+ *
+ * @return  A reference to the pool, or NULL if the payload size is too close to the size of the
+ *          larger pool's payloads for a reduced pool to save anything.
+ */
+//--------------------------------------------------------------------------------------------------
+le_mem_PoolRef_t msgMessage_CreateReducedPool
+(
+    le_mem_PoolRef_t superPoolRef,  ///< [in] Pool of larger messages.
+    const char* name,               ///< [in] Name of the protocol.
+    size_t msgSize,                 ///< [in] Size of the message payloads, in bytes.
+    size_t numMsgs                  ///< [in] Number of messages to pre-allocate.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Each block of the larger pool must hold at least two of the smaller messages, or the
+    // reduced pool would only add overhead.
+    if ((sizeof(UnixMessage_t) + msgSize) * 2 > le_mem_GetObjectSize(superPoolRef))
+    {
+        return NULL;
+    }
+
+    char prefix[24];
+    char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES];
+
+    snprintf(prefix, sizeof(prefix), "msgs%" PRIuS "-", msgSize);
+    BuildPoolName(poolName, prefix, name);
+
+    return le_mem_CreateReducedPool(superPoolRef,
+                                    poolName,
+                                    numMsgs,
+                                    sizeof(UnixMessage_t) + msgSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a message ready to be written to its socket.  If it is a response message, this moves the
+ * response fd (if any) into the position of the fd to be sent.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrepareForSend
+(
+    UnixMessage_t* msgPtr   ///< [IN] The Message to be sent.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // If this is a response message,
+    if (le_msg_NeedsResponse(msgMessage_GetMessageRef(msgPtr)))
+    {
+        // If there was an fd that was received from the client but not fetched from the message
+        // generate a warning and close that fd.
+        if (msgPtr->fd >= 0)
+        {
+            LE_WARN("File descriptor not retrieved from message received from client.");
+            fd_Close(msgPtr->fd);
+        }
+
+        // Move the responseFd to the normal fd position in the message object.
+        msgPtr->fd = msgPtr->clientServer.server.responseFd;
+        msgPtr->clientServer.server.responseFd = -1;
+    }
+}
+
+
+#if LE_CONFIG_MSG_SHM
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a message's payload in the session's shared memory, if it qualifies, and build the
+ * (transaction ID + descriptor) data to send through the socket in its place.
+ *
+ * @return true if the payload was put in shared memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool PutInShm
+(
+    msgShm_RegionRef_t  shmRef,             ///< [IN] The session's shared memory.
+    UnixMessage_t*      msgPtr,             ///< [IN] The Message to be sent.
+    uint8_t             bufPtr[SHM_MSG_BYTES]   ///< [OUT] Data to send.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    msgShm_Desc_t desc;
+
+    if (!msgShm_Put(shmRef, msgPtr->payload, msgPtr->payloadSize, &desc))
+    {
+        return false;
+    }
+
+    void* marker = SHM_TXN_MARKER;
+
+    memcpy(bufPtr, &marker, sizeof(marker));
+    memcpy(bufPtr + sizeof(marker), &msgPtr->txnId, sizeof(msgPtr->txnId));
+    memcpy(bufPtr + sizeof(marker) + sizeof(msgPtr->txnId), &desc, sizeof(desc));
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * If a received message is marked as having its payload in the session's shared memory, fetch the
+ * payload into the Message object.
+ *
+ * @return
+ * - LE_OK if successful (or the message didn't come through shared memory).
+ * - LE_COMM_ERROR if the message or its descriptor was not valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetFromShm
+(
+    le_msg_MessageRef_t msgRef,     ///< [IN] Message object holding the received message.
+    size_t              byteCount   ///< [IN] Number of bytes received (including the transaction
+                                    ///       ID).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+
+    if ((byteCount < sizeof(msgPtr->txnId)) || (msgPtr->txnId != SHM_TXN_MARKER))
+    {
+        return LE_OK;
+    }
+
+    msgShm_RegionRef_t shmRef = msgSession_GetShmRef(msgRef->sessionRef);
+    uint8_t* dataPtr = (uint8_t*)msgPtr->payload;
+    msgShm_Desc_t desc;
+
+    if ((shmRef == NULL) || (byteCount != SHM_MSG_BYTES))
+    {
+        LE_ERROR("Unexpected shared memory message (%zu bytes).", byteCount);
+        msgPtr->txnId = 0;
+        return LE_COMM_ERROR;
+    }
+
+    // Take the transaction ID and descriptor out first, because the payload is copied over them.
+    memcpy(&msgPtr->txnId, dataPtr, sizeof(msgPtr->txnId));
+    memcpy(&desc, dataPtr + sizeof(msgPtr->txnId), sizeof(desc));
+
+    if (msgShm_Get(shmRef, &desc, dataPtr, le_msg_GetMaxPayloadSize(msgRef)) != LE_OK)
+    {
+        return LE_COMM_ERROR;
+    }
+
+    // Don't leave any of the descriptor behind in an otherwise zeroed buffer.
+    size_t dataSize = SHM_MSG_BYTES - sizeof(msgPtr->txnId);
+    if (desc.size < dataSize)
+    {
+        memset(dataPtr + desc.size, 0, dataSize - desc.size);
+    }
+
+    return LE_OK;
+}
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Send a single message over a connected socket.
@@ -183,33 +433,115 @@ le_result_t msgMessage_Send
 {
     UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
 
-    // If this is a response message,
-    if (le_msg_NeedsResponse(msgRef))
+    PrepareForSend(msgPtr);
+
+#if LE_CONFIG_MSG_SHM
+    msgShm_RegionRef_t shmRef = msgSession_GetShmRef(msgRef->sessionRef);
+    if (shmRef != NULL)
     {
-        // If there was an fd that was received from the client but not fetched from the message
-        // generate a warning and close that fd.
-        if (msgPtr->fd >= 0)
+        uint8_t shmMsg[SHM_MSG_BYTES];
+        uint32_t mark = msgShm_GetMark(shmRef);
+
+        if (PutInShm(shmRef, msgPtr, shmMsg))
         {
-            LE_WARN("File descriptor not retrieved from message received from client.");
-            fd_Close(msgPtr->fd);
+            le_result_t result = unixSocket_SendMsg(socketFd,
+                                                    shmMsg,
+                                                    sizeof(shmMsg),
+                                                    msgPtr->fd,
+                                                    false); // Don't send process credentials.
+            if (result != LE_OK)
+            {
+                // Not sent, so the payload will be put in again when it is retried.
+                msgShm_Rewind(shmRef, mark);
+            }
+            return result;
         }
-
-        // Move the responseFd to the normal fd position in the message object.
-        msgPtr->fd = msgPtr->clientServer.server.responseFd;
-        msgPtr->clientServer.server.responseFd = -1;
     }
+#endif
 
     // The first bytes come from our transaction ID and the rest (if any)
     // from our Message object's payload section, which comes right after the transaction ID.
+    // Only the part of the payload that is in use goes over the socket.
     return unixSocket_SendMsg(  socketFd,
                                 &msgPtr->txnId,
-                                sizeof(msgPtr->txnId) +
-                                le_msg_GetMaxPayloadSize(msgMessage_GetMessageRef(msgPtr)),
+                                sizeof(msgPtr->txnId) + msgPtr->payloadSize,
                                 msgPtr->fd,
                                 false   ); // Don't send process credentials.
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a batch of messages over a connected socket using a single system call.
+ *
+ * @return
+ * - LE_OK if at least one message was sent (the first *sentCountPtr messages were sent).
+ * - LE_NO_MEMORY if the socket doesn't have enough send buffer space available right now.
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_SendBatch
+(
+    int                  socketFd,      ///< [IN] Connected socket's file descriptor.
+    le_msg_MessageRef_t* msgRefs,       ///< [IN] The Messages to be sent, in order.
+    size_t               msgCount,      ///< [IN] Number of messages (at most
+                                        ///       UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t*              sentCountPtr   ///< [OUT] Number of messages that were sent.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    unixSocket_MsgBuff_t buffs[UNIXSOCKET_MAX_BATCH_MSGS];
+    size_t i;
+
+    LE_ASSERT(msgCount <= UNIXSOCKET_MAX_BATCH_MSGS);
+
+#if LE_CONFIG_MSG_SHM
+    uint8_t shmMsgs[UNIXSOCKET_MAX_BATCH_MSGS][SHM_MSG_BYTES];
+    uint32_t marks[UNIXSOCKET_MAX_BATCH_MSGS];
+    msgShm_RegionRef_t shmRef = msgSession_GetShmRef(msgRefs[0]->sessionRef);
+#endif
+
+    for (i = 0; i < msgCount; i++)
+    {
+        UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRefs[i]);
+
+        PrepareForSend(msgPtr);
+
+        buffs[i].dataPtr = &msgPtr->txnId;
+        buffs[i].dataSize = sizeof(msgPtr->txnId) + msgPtr->payloadSize;
+        buffs[i].fd = msgPtr->fd;
+
+#if LE_CONFIG_MSG_SHM
+        if (shmRef != NULL)
+        {
+            marks[i] = msgShm_GetMark(shmRef);
+
+            if (PutInShm(shmRef, msgPtr, shmMsgs[i]))
+            {
+                buffs[i].dataPtr = shmMsgs[i];
+                buffs[i].dataSize = SHM_MSG_BYTES;
+            }
+        }
+#endif
+    }
+
+    le_result_t result = unixSocket_SendMsgBatch(socketFd, buffs, msgCount, sentCountPtr);
+
+#if LE_CONFIG_MSG_SHM
+    // Take back the shared memory used by any messages that didn't get sent, since they will be
+    // put in again when they are retried.
+    size_t sentCount = (result == LE_OK) ? *sentCountPtr : 0;
+    if ((shmRef != NULL) && (sentCount < msgCount))
+    {
+        msgShm_Rewind(shmRef, marks[sentCount]);
+    }
+#endif
+
+    return result;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Receive a single message from a connected socket.
@@ -243,10 +575,116 @@ le_result_t msgMessage_Receive
         msgPtr->clientServer.server.responseFd = -1;
     }
 
+#if LE_CONFIG_MSG_SHM
+    if (result == LE_OK)
+    {
+        result = GetFromShm(msgRef, byteCount);
+    }
+#endif
+
     return result;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive a batch of messages from a connected socket using a single system call.
+ *
+ * On return, the first *countPtr Message objects hold the messages that were received
+ * successfully, in the order they were received.  They are followed by the Message objects that
+ * held messages that were received but could not be delivered (dropped, as with
+ * msgMessage_Receive()), up to *usedCountPtr in total.  The remaining Message objects are
+ * untouched and can be used again.
+ *
+ * @return
+ * - LE_OK if at least one message was received.
+ * - LE_WOULD_BLOCK if there's nothing there to receive and the socket is set non-blocking.
+ * - LE_CLOSED if the connection has closed.
+ * - LE_COMM_ERROR if an error was encountered.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_ReceiveBatch
+(
+    int                  socketFd,  ///< [IN] The socket's file descriptor.
+    le_msg_MessageRef_t* msgRefs,   ///< [IN+OUT] Message objects to store the messages in.
+    size_t*              countPtr,  ///< [IN+OUT] Number of Message objects (at most
+                                    ///     UNIXSOCKET_MAX_BATCH_MSGS), updated to the number of
+                                    ///     messages received.
+    size_t*              usedCountPtr ///< [OUT] Number of Message objects written to, including
+                                      ///     the ones holding dropped messages.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    unixSocket_MsgBuff_t buffs[UNIXSOCKET_MAX_BATCH_MSGS];
+    size_t msgCount = *countPtr;
+    size_t receivedCount = 0;
+    size_t goodCount = 0;
+    size_t i;
+
+    LE_ASSERT((msgCount > 0) && (msgCount <= UNIXSOCKET_MAX_BATCH_MSGS));
+
+    *countPtr = 0;
+    *usedCountPtr = 0;
+
+    for (i = 0; i < msgCount; i++)
+    {
+        UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRefs[i]);
+
+        buffs[i].dataPtr = &msgPtr->txnId;
+        buffs[i].dataSize = sizeof(msgPtr->txnId) + le_msg_GetMaxPayloadSize(msgRefs[i]);
+    }
+
+    le_result_t result = unixSocket_ReceiveMsgBatch(socketFd, buffs, msgCount, &receivedCount);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    *usedCountPtr = receivedCount;
+
+    bool isServer =
+        (msgSession_GetInterfaceType(msgRefs[0]->sessionRef) == LE_MSG_INTERFACE_SERVER);
+
+    // Pack the successfully received messages at the start of the array, keeping their order.
+    // The dropped ones end up after them.
+    for (i = 0; i < receivedCount; i++)
+    {
+        UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRefs[i]);
+
+        msgPtr->fd = buffs[i].fd;
+        if (isServer)
+        {
+            msgPtr->clientServer.server.responseFd = -1;
+        }
+
+#if LE_CONFIG_MSG_SHM
+        if (buffs[i].result == LE_OK)
+        {
+            buffs[i].result = GetFromShm(msgRefs[i], buffs[i].dataSize);
+        }
+#endif
+
+        if (buffs[i].result != LE_OK)
+        {
+            result = buffs[i].result;
+            continue;
+        }
+
+        if (goodCount != i)
+        {
+            le_msg_MessageRef_t tmpRef = msgRefs[goodCount];
+            msgRefs[goodCount] = msgRefs[i];
+            msgRefs[i] = tmpRef;
+        }
+        goodCount++;
+    }
+
+    *countPtr = goodCount;
+
+    return (goodCount > 0) ? LE_OK : result;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets a Message object's transaction ID.
@@ -343,32 +781,57 @@ le_msg_MessageRef_t le_msg_CreateMsg
     le_msg_ProtocolRef_t protocolRef = le_msg_GetSessionProtocol(sessionRef);
     UnixMessage_t* msgPtr = msgProto_AllocMessage(protocolRef);
 
-    // Initialize the Message object's data members.
-    msgPtr->link = LE_DLS_LINK_INIT;
-    msgPtr->message.sessionRef = sessionRef;
-    le_mem_AddRef(sessionRef);  // Message object holds a reference to the Session object.
+    return InitMessage(msgPtr, sessionRef, le_msg_GetProtocolMaxMsgSize(protocolRef));
+}
 
-    msgInterface_Type_t interfaceType = msgSession_GetInterfaceType(sessionRef);
-    switch (interfaceType)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a message to be sent over a given session, with a payload buffer of at least a given
+ * size.
+ *
+ * @return  The message reference.
+ *
+ * @note
+ * - This function never returns on failure, so no need to check the return code.
+ * - If you see warnings about message pools expanding, then you may be forgetting to
+ *   release the messages you have received.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t le_msg_CreateSizedMsg
+(
+    le_msg_SessionRef_t sessionRef, ///< [in] Reference to the session.
+    size_t              payloadSize ///< [in] Largest payload that will be put in the message.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(sessionRef);
+    if (sessionRef->type == LE_MSG_SESSION_LOCAL)
     {
-        case LE_MSG_INTERFACE_CLIENT:
-            msgPtr->clientServer.client.completionCallback = NULL;
-            msgPtr->clientServer.client.contextPtr = NULL;
-            break;
+        return msgLocal_CreateMsg(sessionRef);
+    }
 
-        case LE_MSG_INTERFACE_SERVER:
-            msgPtr->clientServer.server.responseFd = -1;
-            break;
+    LE_FATAL_IF(sessionRef->type != LE_MSG_SESSION_UNIX_SOCKET,
+                "Corrupted session type: %d", sessionRef->type);
 
-        default:
-            LE_FATAL("Unhandled interface type (%d).", interfaceType);
+    le_msg_ProtocolRef_t protocolRef = le_msg_GetSessionProtocol(sessionRef);
+    size_t maxPayloadSize = le_msg_GetProtocolMaxMsgSize(protocolRef);
+    LE_FATAL_IF(payloadSize > maxPayloadSize,
+                "Payload size %" PRIuS " exceeds maximum %" PRIuS " for protocol '%s'.",
+                payloadSize,
+                maxPayloadSize,
+                le_msg_GetProtocolIdStr(protocolRef));
+
+    UnixMessage_t* msgPtr = msgProto_AllocSizedMessage(protocolRef, payloadSize);
+
+    // The block may be bigger than asked for; make all of it usable, up to the protocol maximum.
+    size_t capacity = le_mem_GetBlockSize(msgPtr) - sizeof(UnixMessage_t);
+    if (capacity > maxPayloadSize)
+    {
+        capacity = maxPayloadSize;
     }
 
-    msgPtr->fd = -1;
-    msgPtr->txnId = 0;
-    memset(msgPtr->payload, 0, le_msg_GetProtocolMaxMsgSize(protocolRef));
-
-    return msgMessage_GetMessageRef(msgPtr);
+    return InitMessage(msgPtr, sessionRef, capacity);
 }
 
 
@@ -511,7 +974,41 @@ size_t le_msg_GetMaxPayloadSize
         case LE_MSG_SESSION_LOCAL:
             return msgLocal_GetMaxPayloadSize(msgRef);
         case LE_MSG_SESSION_UNIX_SOCKET:
-            return le_msg_GetProtocolMaxMsgSize(le_msg_GetSessionProtocol(msgRef->sessionRef));
+            return msgMessage_GetUnixMessagePtr(msgRef)->maxPayloadSize;
+        default:
+            LE_FATAL("Corrupted session type: %d", msgRef->sessionRef->type);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the number of payload bytes that are actually in use.
+ *
+ * Only that many bytes of the payload will be sent when the message is sent.  Messages are
+ * created with the whole payload buffer in use.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_msg_SetPayloadSize
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t              size        ///< [in] Number of payload bytes in use.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(msgRef);
+    switch (msgRef->sessionRef->type)
+    {
+        case LE_MSG_SESSION_LOCAL:
+            // Local messages are never copied, so there is nothing to trim.
+            break;
+        case LE_MSG_SESSION_UNIX_SOCKET:
+            LE_FATAL_IF(size > le_msg_GetMaxPayloadSize(msgRef),
+                        "Payload size %" PRIuS " exceeds maximum %" PRIuS ".",
+                        size,
+                        le_msg_GetMaxPayloadSize(msgRef));
+            msgMessage_GetUnixMessagePtr(msgRef)->payloadSize = size;
+            break;
         default:
             LE_FATAL("Corrupted session type: %d", msgRef->sessionRef->type);
     }
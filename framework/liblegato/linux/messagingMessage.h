@@ -40,6 +40,8 @@ typedef struct le_msg_UnixMessage
     }
     clientServer;
 
+    size_t                      maxPayloadSize;///< Size of the payload buffer, in bytes.
+    size_t                      payloadSize;///< Number of payload bytes to send.
     int                         fd;         ///< File descriptor to send or received (-1 = no fd)
     void*                       txnId;      ///< Safe reference value used as a transaction ID.
     void*                       payload[0]; ///< Variable-length payload buffer appears at the end.
@@ -69,7 +71,26 @@ void msgMessage_Init
 le_mem_PoolRef_t msgMessage_CreatePool
 (
     const char* name,       ///< [in] Name of the pool.
-    size_t largestMsgSize   ///< [in] Size of the largest message payload, in bytes.
+    size_t largestMsgSize,  ///< [in] Size of the largest message payload, in bytes.
+    size_t numMsgs          ///< [in] Number of messages to pre-allocate.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a reduced-size Message Pool for messages with smaller payloads, carved out of a larger
+ * Message Pool.
+ *
+ * @return  A reference to the pool, or NULL if the payload size is too close to the size of the
+ *          larger pool's payloads for a reduced pool to save anything.
+ */
+//--------------------------------------------------------------------------------------------------
+le_mem_PoolRef_t msgMessage_CreateReducedPool
+(
+    le_mem_PoolRef_t superPoolRef,  ///< [in] Pool of larger messages.
+    const char* name,               ///< [in] Name of the protocol.
+    size_t msgSize,                 ///< [in] Size of the message payloads, in bytes.
+    size_t numMsgs                  ///< [in] Number of messages to pre-allocate.
 );
 
 
@@ -90,6 +111,26 @@ le_result_t msgMessage_Send
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a batch of messages over a connected socket using a single system call.
+ *
+ * @return
+ * - LE_OK if at least one message was sent (the first *sentCountPtr messages were sent).
+ * - LE_NO_MEMORY if the socket doesn't have enough send buffer space available right now.
+ * - LE_COMM_ERROR if the socket reported an error on the send operation.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_SendBatch
+(
+    int                  socketFd,      ///< [IN] Connected socket's file descriptor.
+    le_msg_MessageRef_t* msgRefs,       ///< [IN] The Messages to be sent, in order.
+    size_t               msgCount,      ///< [IN] Number of messages (at most
+                                        ///       UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t*              sentCountPtr   ///< [OUT] Number of messages that were sent.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Receive a single message from a connected socket.
@@ -108,6 +149,33 @@ le_result_t msgMessage_Receive
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive a batch of messages from a connected socket using a single system call.
+ *
+ * On return, the first *countPtr Message objects hold the messages that were received
+ * successfully, in the order they were received.  They are followed by the ones that held
+ * dropped messages, up to *usedCountPtr in total.  The rest are untouched.
+ *
+ * @return
+ * - LE_OK if at least one message was received.
+ * - LE_WOULD_BLOCK if there's nothing there to receive and the socket is set non-blocking.
+ * - LE_CLOSED if the connection has closed.
+ * - LE_COMM_ERROR if an error was encountered.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_ReceiveBatch
+(
+    int                  socketFd,  ///< [IN] The socket's file descriptor.
+    le_msg_MessageRef_t* msgRefs,   ///< [IN+OUT] Message objects to store the messages in.
+    size_t*              countPtr,  ///< [IN+OUT] Number of Message objects (at most
+                                    ///     UNIXSOCKET_MAX_BATCH_MSGS), updated to the number of
+                                    ///     messages received.
+    size_t*              usedCountPtr ///< [OUT] Number of Message objects written to, including
+                                      ///     the ones holding dropped messages.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets a pointer to the queue link inside a Message object.
@@ -51,6 +51,14 @@ static le_sls_List_t ProtocolList = LE_SLS_LIST_INIT;
 static le_mem_PoolRef_t ProtocolPoolRef;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages pre-allocated for protocols that don't say how many they need.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_NUM_MSGS    10
+
+
 // =======================================
 //  PRIVATE FUNCTIONS
 // =======================================
@@ -102,7 +110,10 @@ static msgProtocol_Protocol_t* FindProtocol
 static msgProtocol_Protocol_t* CreateProtocol
 (
     const char* protocolId,     ///< [in] String uniquely identifying the the protocol and version.
-    size_t largestMsgSize       ///< [in] Size (in bytes) of the largest message in the protocol.
+    size_t largestMsgSize,      ///< [in] Size (in bytes) of the largest message in the protocol.
+    const size_t* sizeClassesPtr, ///< [in] Smaller message sizes (in bytes), largest first.
+    size_t numSizeClasses,      ///< [in] Number of entries in sizeClassesPtr.
+    size_t numMsgs              ///< [in] Number of messages to pre-allocate in each pool.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -115,7 +126,43 @@ static msgProtocol_Protocol_t* CreateProtocol
         LE_CRIT("Protocol identifier truncated from '%s' to '%s'.", protocolId, protocolPtr->id);
     }
 
-    protocolPtr->messagePoolRef = msgMessage_CreatePool(protocolId, largestMsgSize);
+    protocolPtr->messagePoolRef = msgMessage_CreatePool(protocolId, largestMsgSize, numMsgs);
+    protocolPtr->numMsgs = numMsgs;
+
+    // Carve a reduced pool for each size class out of the pool for the next larger class, so
+    // small messages don't each take up a block big enough for the largest message.
+    protocolPtr->numSizedPools = 0;
+    le_mem_PoolRef_t superPoolRef = protocolPtr->messagePoolRef;
+    size_t superMsgSize = largestMsgSize;
+    size_t i;
+    for (i = 0; i < numSizeClasses; i++)
+    {
+        if (protocolPtr->numSizedPools >= MSG_PROTOCOL_MAX_SIZE_CLASSES)
+        {
+            LE_WARN("Protocol '%s' has too many message size classes; only %d will be used.",
+                    protocolId,
+                    MSG_PROTOCOL_MAX_SIZE_CLASSES);
+            break;
+        }
+        if (sizeClassesPtr[i] >= superMsgSize)
+        {
+            LE_WARN("Message size class %" PRIuS " of protocol '%s' is out of order.",
+                    sizeClassesPtr[i],
+                    protocolId);
+            continue;
+        }
+
+        le_mem_PoolRef_t poolRef = msgMessage_CreateReducedPool(superPoolRef,
+                                                                protocolId,
+                                                                sizeClassesPtr[i],
+                                                                numMsgs);
+        if (poolRef != NULL)
+        {
+            protocolPtr->sizedPoolRefs[protocolPtr->numSizedPools++] = poolRef;
+            superPoolRef = poolRef;
+            superMsgSize = sizeClassesPtr[i];
+        }
+    }
 
     LOCK
 
@@ -127,6 +174,44 @@ static msgProtocol_Protocol_t* CreateProtocol
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Makes sure at least a given number of messages are pre-allocated in each of a Protocol's
+ * Message Pools.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReserveMessages
+(
+    msgProtocol_Protocol_t* protocolPtr,
+    size_t numMsgs              ///< [in] Number of messages to pre-allocate in each pool.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t extraMsgs = 0;
+
+    LOCK
+
+    if (numMsgs > protocolPtr->numMsgs)
+    {
+        extraMsgs = numMsgs - protocolPtr->numMsgs;
+        protocolPtr->numMsgs = numMsgs;
+    }
+
+    UNLOCK
+
+    if (extraMsgs > 0)
+    {
+        size_t i;
+
+        le_mem_ExpandPool(protocolPtr->messagePoolRef, extraMsgs);
+        for (i = 0; i < protocolPtr->numSizedPools; i++)
+        {
+            le_mem_ExpandPool(protocolPtr->sizedPoolRefs[i], extraMsgs);
+        }
+    }
+}
+
+
 // =======================================
 //  PROTECTED (INTER-MODULE) FUNCTIONS
 // =======================================
@@ -166,6 +251,33 @@ UnixMessage_t *msgProto_AllocMessage
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a Message object big enough for a given payload size from the smallest of a given
+ * Protocol's Message Pools that will hold it.
+ *
+ * @return A pointer to the (uninitialized) Message object memory.
+ */
+//--------------------------------------------------------------------------------------------------
+UnixMessage_t *msgProto_AllocSizedMessage
+(
+    le_msg_ProtocolRef_t protocolRef,
+    size_t payloadSize                  ///< [in] Size of the payload, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (protocolRef->numSizedPools == 0)
+    {
+        return le_mem_ForceAlloc(protocolRef->messagePoolRef);
+    }
+
+    // Allocating from the smallest pool falls back to its larger parent pools when the payload
+    // won't fit.
+    return le_mem_ForceVarAlloc(protocolRef->sizedPoolRefs[protocolRef->numSizedPools - 1],
+                                sizeof(UnixMessage_t) + payloadSize);
+}
+
+
 // =======================================
 //  PUBLIC API FUNCTIONS
 // =======================================
@@ -183,11 +295,42 @@ le_msg_ProtocolRef_t le_msg_GetProtocolRef
     size_t largestMsgSize       ///< [in] Size (in bytes) of the largest message in the protocol.
 )
 //--------------------------------------------------------------------------------------------------
+{
+    return le_msg_GetProtocolRefWithPools(protocolId, largestMsgSize, NULL, 0, DEFAULT_NUM_MSGS);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a reference that can be used to refer to a particular version of a particular protocol,
+ * with Message Pools sized for the protocol's messages.
+ *
+ * Besides the pool of messages big enough for the largest message, a reduced pool is carved out
+ * for each given size class, so that le_msg_CreateSizedMsg() can allocate small messages from
+ * small blocks.  The size classes are only used when the protocol is first created.  If the
+ * protocol already exists, its pools are expanded to hold at least numMsgs messages each.
+ *
+ * @return  The protocol reference.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_ProtocolRef_t le_msg_GetProtocolRefWithPools
+(
+    const char* protocolId,     ///< [in] String uniquely identifying the the protocol and version.
+    size_t largestMsgSize,      ///< [in] Size (in bytes) of the largest message in the protocol.
+    const size_t* sizeClassesPtr, ///< [in] Smaller message sizes (in bytes), largest first.
+    size_t numSizeClasses,      ///< [in] Number of entries in sizeClassesPtr.
+    size_t numMsgs              ///< [in] Number of messages to pre-allocate in each pool.
+)
+//--------------------------------------------------------------------------------------------------
 {
     msgProtocol_Protocol_t* protocolPtr = FindProtocol(protocolId);
     if (protocolPtr == NULL)
     {
-        protocolPtr = CreateProtocol(protocolId, largestMsgSize);
+        protocolPtr = CreateProtocol(protocolId,
+                                     largestMsgSize,
+                                     sizeClassesPtr,
+                                     numSizeClasses,
+                                     numMsgs);
     }
     else if (protocolPtr->maxPayloadSize != largestMsgSize)
     {
@@ -196,6 +339,10 @@ le_msg_ProtocolRef_t le_msg_GetProtocolRef
                  protocolId,
                  protocolPtr->maxPayloadSize);
     }
+    else
+    {
+        ReserveMessages(protocolPtr, numMsgs);
+    }
 
     return protocolPtr;
 }
@@ -11,6 +11,14 @@
 #include "limit.h"
 #include "messagingMessage.h"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of message size classes a protocol can have, besides its largest message size.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSG_PROTOCOL_MAX_SIZE_CLASSES   3
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Represents a messaging protocol.
@@ -22,6 +30,10 @@ typedef struct le_msg_Protocol
     char id[LIMIT_MAX_PROTOCOL_ID_BYTES];   ///< Unique identifier for the protocol.
     size_t maxPayloadSize;                  ///< Max payload size (in bytes) in this protocol.
     le_mem_PoolRef_t messagePoolRef;        ///< Pool of Message objects.
+    le_mem_PoolRef_t sizedPoolRefs[MSG_PROTOCOL_MAX_SIZE_CLASSES]; ///< Reduced pools of Message
+                                            ///  objects for smaller payloads, largest first.
+    size_t numSizedPools;                   ///< Number of reduced pools in sizedPoolRefs.
+    size_t numMsgs;                         ///< Number of messages pre-allocated in each pool.
 }
 msgProtocol_Protocol_t;
 
@@ -51,4 +63,19 @@ UnixMessage_t *msgProto_AllocMessage
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a Message object big enough for a given payload size from the smallest of a given
+ * Protocol's Message Pools that will hold it.
+ *
+ * @return A pointer to the (uninitialized) Message object memory.
+ */
+//--------------------------------------------------------------------------------------------------
+UnixMessage_t *msgProto_AllocSizedMessage
+(
+    le_msg_ProtocolRef_t protocolRef,
+    size_t payloadSize                  ///< [in] Size of the payload, in bytes.
+);
+
+
 #endif // MESSAGING_PROTOCOL_H_INCLUDE_GUARD
@@ -31,6 +31,15 @@
 #define MAX_EXPECTED_TXNS 32
 
 
+//--------------------------------------------------------------------------------------------------
+/// The maximum number of messages sent or received by a single socket system call.
+//--------------------------------------------------------------------------------------------------
+#if LE_CONFIG_MSG_BATCH_SIZE > UNIXSOCKET_MAX_BATCH_MSGS
+#   error "LE_CONFIG_MSG_BATCH_SIZE is larger than UNIXSOCKET_MAX_BATCH_MSGS"
+#endif
+#define MSG_BATCH_SIZE LE_CONFIG_MSG_BATCH_SIZE
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Mutex used to protect data structures in this module from multi-threaded race conditions.
@@ -91,6 +100,7 @@ static msgSession_UnixSession_t *msgSession_GetUnixSessionPtr(le_msg_SessionRef_
 static le_msg_SessionRef_t msgSession_GetSessionRef(msgSession_UnixSession_t *unixSessionPtr);
 
 static void AttemptOpen(msgSession_UnixSession_t* sessionPtr);
+static void SendFromTransmitQueue(msgSession_UnixSession_t* sessionPtr);
 
 
 //--------------------------------------------------------------------------------------------------
@@ -111,6 +121,7 @@ static void PushTransmitQueue
 
     LOCK
     le_dls_Queue(&sessionPtr->transmitQueue, linkPtr);
+    sessionPtr->transmitCount++;
     UNLOCK
 }
 
@@ -135,6 +146,10 @@ static le_msg_MessageRef_t PopTransmitQueue
 
     LOCK
     linkPtr = le_dls_Pop(&sessionPtr->transmitQueue);
+    if (linkPtr != NULL)
+    {
+        sessionPtr->transmitCount--;
+    }
     UNLOCK
 
     if (linkPtr != NULL)
@@ -164,6 +179,7 @@ static void UnPopTransmitQueue
 
     LOCK
     le_dls_Stack(&sessionPtr->transmitQueue, linkPtr);
+    sessionPtr->transmitCount++;
     UNLOCK
 }
 
@@ -417,6 +433,25 @@ static void PurgeReceiveQueue
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes the spare Message objects that a session keeps ready to receive into.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseReceiveSpares
+(
+    msgSession_UnixSession_t* sessionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (sessionPtr->rxSpareCount > 0)
+    {
+        sessionPtr->rxSpareCount--;
+        le_msg_ReleaseMsg(sessionPtr->rxSpareRefs[sessionPtr->rxSpareCount]);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a Session object.
@@ -443,7 +478,11 @@ static msgSession_UnixSession_t* CreateSession
 
     sessionPtr->txnList = LE_DLS_LIST_INIT;
     sessionPtr->transmitQueue = LE_DLS_LIST_INIT;
+    sessionPtr->transmitCount = 0;
+    sessionPtr->isFlushQueued = false;
+    sessionPtr->isTxBlocked = false;
     sessionPtr->receiveQueue = LE_DLS_LIST_INIT;
+    sessionPtr->rxSpareCount = 0;
 
     sessionPtr->contextPtr = NULL;
     sessionPtr->rxHandler = NULL;
@@ -453,6 +492,15 @@ static msgSession_UnixSession_t* CreateSession
     sessionPtr->closeHandler = NULL;
     sessionPtr->closeContextPtr = NULL;
 
+    sessionPtr->txMsgCount = 0;
+    sessionPtr->txCallCount = 0;
+    sessionPtr->rxMsgCount = 0;
+    sessionPtr->rxCallCount = 0;
+
+#if LE_CONFIG_MSG_SHM
+    sessionPtr->shmRef = NULL;
+#endif
+
     sessionPtr->interfaceRef = interfaceRef;
 
     SessionObjListChangeCount++;
@@ -475,6 +523,15 @@ static void CloseSession
 )
 //--------------------------------------------------------------------------------------------------
 {
+    // On the server side, messages may be waiting on the Transmit Queue for a deferred send.
+    // Give them a chance to go out before the socket is closed.
+    if ((sessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_SERVER) &&
+        (sessionPtr->state == LE_MSG_SESSION_STATE_OPEN) &&
+        (sessionPtr->transmitCount > 0))
+    {
+        SendFromTransmitQueue(sessionPtr);
+    }
+
     sessionPtr->state = LE_MSG_SESSION_STATE_CLOSED;
 
     // Always notify the server on close.
@@ -497,6 +554,14 @@ static void CloseSession
     fd_Close(sessionPtr->socketFd);
     sessionPtr->socketFd = -1;
 
+#if LE_CONFIG_MSG_SHM
+    if (sessionPtr->shmRef != NULL)
+    {
+        msgShm_Delete(sessionPtr->shmRef);
+        sessionPtr->shmRef = NULL;
+    }
+#endif
+
     // If there are any messages stranded on the transmit queue, the pending transaction list,
     // or the receive queue, clean them all up.
     if (sessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_SERVER)
@@ -505,6 +570,7 @@ static void CloseSession
     }
     PurgeTransmitQueue(sessionPtr);
     PurgeReceiveQueue(sessionPtr);
+    ReleaseReceiveSpares(sessionPtr);
 }
 
 
@@ -604,7 +670,11 @@ static void EnableWriteabilityNotification
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_fdMonitor_Enable(sessionPtr->fdMonitorRef, POLLOUT);
+    if (!sessionPtr->isTxBlocked)
+    {
+        le_fdMonitor_Enable(sessionPtr->fdMonitorRef, POLLOUT);
+        sessionPtr->isTxBlocked = true;
+    }
 }
 
 
@@ -620,7 +690,12 @@ static inline void DisableWriteabilityNotification
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_fdMonitor_Disable(sessionPtr->fdMonitorRef, POLLOUT);
+    // Avoid an epoll_ctl() call every time the Transmit Queue is emptied.
+    if (sessionPtr->isTxBlocked)
+    {
+        le_fdMonitor_Disable(sessionPtr->fdMonitorRef, POLLOUT);
+        sessionPtr->isTxBlocked = false;
+    }
 }
 
 
@@ -668,18 +743,31 @@ static le_result_t ReceiveSessionOpenResponse
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // We expect to receive a very small message (one le_result_t).
+    // We expect to receive a very small message (one le_result_t), possibly along with the
+    // file descriptor of the session's shared memory.
     le_result_t serverResponse;
     size_t  bytesReceived = sizeof(serverResponse);
+    int shmFd = -1;
 
     // Receive the message.
     le_result_t result;
-    result = unixSocket_ReceiveDataMsg(sessionPtr->socketFd, &serverResponse, &bytesReceived);
+    result = unixSocket_ReceiveMsg(sessionPtr->socketFd,
+                                   &serverResponse,
+                                   &bytesReceived,
+                                   &shmFd,
+                                   NULL);   // Don't receive credentials.
 
     if (result == LE_OK)
     {
         if (serverResponse == LE_OK)
         {
+#if LE_CONFIG_MSG_SHM
+            // If the shared memory can't be used, large messages just go through the socket.
+            if (shmFd >= 0)
+            {
+                sessionPtr->shmRef = msgShm_Attach(shmFd);
+            }
+#endif
             le_msg_InterfaceRef_t interfaceRef =
                 le_msg_GetSessionInterface(msgSession_GetSessionRef(sessionPtr));
             TRACE("Session opened on interface (%s:%s)",
@@ -706,6 +794,11 @@ static le_result_t ReceiveSessionOpenResponse
         LE_FATAL("Failed to receive session open response (%s)", LE_RESULT_TXT(result));
     }
 
+    if (shmFd >= 0)
+    {
+        fd_Close(shmFd);
+    }
+
     return result;
 }
 
@@ -721,13 +814,24 @@ static le_result_t ReceiveSessionOpenResponse
 //--------------------------------------------------------------------------------------------------
 static le_result_t SendSessionOpenResponse
 (
-    int socketFd    ///< [IN] Connected socket to send through.
+    int socketFd,   ///< [IN] Connected socket to send through.
+    int shmFd       ///< [IN] File descriptor of the session's shared memory (-1 = none).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    const le_result_t response = LE_OK;
+    le_result_t response = LE_OK;
     ssize_t bytesSent;
 
+    if (shmFd >= 0)
+    {
+        // Pass the shared memory to the client along with the response.
+        if (unixSocket_SendMsg(socketFd, &response, sizeof(response), shmFd, false) != LE_OK)
+        {
+            return LE_COMM_ERROR;
+        }
+        return LE_OK;
+    }
+
     do
     {
         bytesSent = send(socketFd, &response, sizeof(response), MSG_EOR);
@@ -926,6 +1030,13 @@ static void ClientSocketError
 //--------------------------------------------------------------------------------------------------
 /**
  * Receive messages from the socket and put them on the Receive Queue.
+ *
+ * Messages are received in batches.  The first batch is a single message, so that the common
+ * case of one message per wake-up costs no more than it did before.  If that one comes back full,
+ * the rest are received MSG_BATCH_SIZE at a time.
+ *
+ * Messages are received into spare Message objects that the session keeps.  Only the ones that
+ * get filled are replaced, so a wake-up doesn't create and delete a whole batch of them.
  */
 //--------------------------------------------------------------------------------------------------
 static void ReceiveMessages
@@ -934,25 +1045,63 @@ static void ReceiveMessages
 )
 //--------------------------------------------------------------------------------------------------
 {
+    size_t batchSize = 1;
+
     for (;;)
     {
-        // Create a Message object.
-        le_msg_MessageRef_t msgRef = le_msg_CreateMsg(msgSession_GetSessionRef(sessionPtr));
+        size_t i;
+        size_t count = batchSize;
+        size_t usedCount;
 
-        // Receive from the socket into the Message object.
-        le_result_t result = msgMessage_Receive(sessionPtr->socketFd, msgRef);
+        // Top up the spare Message objects to fill this batch.
+        while (sessionPtr->rxSpareCount < batchSize)
+        {
+            sessionPtr->rxSpareRefs[sessionPtr->rxSpareCount++] =
+                le_msg_CreateMsg(msgSession_GetSessionRef(sessionPtr));
+        }
+
+        // Receive from the socket into the Message objects.
+        le_result_t result = msgMessage_ReceiveBatch(sessionPtr->socketFd,
+                                                     sessionPtr->rxSpareRefs,
+                                                     &count,
+                                                     &usedCount);
 
         if (result == LE_OK)
         {
+            sessionPtr->rxCallCount++;
+            sessionPtr->rxMsgCount += count;
+
             // Received something.  Push it onto the Receive Queue for later processing.
-            PushReceiveQueue(sessionPtr, msgRef);
+            for (i = 0; i < count; i++)
+            {
+                PushReceiveQueue(sessionPtr, sessionPtr->rxSpareRefs[i]);
+            }
         }
         else
         {
-            // Nothing left to receive from the socket.  We are done.
-            le_msg_ReleaseMsg(msgRef);
+            count = 0;
+        }
+
+        // Release the Message objects that held dropped messages.
+        for (i = count; i < usedCount; i++)
+        {
+            le_msg_ReleaseMsg(sessionPtr->rxSpareRefs[i]);
+        }
+
+        // Keep the untouched ones for next time.
+        sessionPtr->rxSpareCount -= usedCount;
+        memmove(&sessionPtr->rxSpareRefs[0],
+                &sessionPtr->rxSpareRefs[usedCount],
+                sessionPtr->rxSpareCount * sizeof(sessionPtr->rxSpareRefs[0]));
+
+        // If the batch didn't fill up, there is (probably) nothing left to receive from the
+        // socket.  If there is, the FD Monitor will tell us again.
+        if (count < batchSize)
+        {
             break;
         }
+
+        batchSize = MSG_BATCH_SIZE;
     }
 }
 
@@ -1003,10 +1152,58 @@ static void ServerSocketError
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finish off a message after it has been written to the session's socket.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MessageSent
+(
+    msgSession_UnixSession_t* sessionPtr,
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (sessionPtr->interfaceRef->interfaceType)
+    {
+        // If this is the client side of the session,
+        case LE_MSG_INTERFACE_CLIENT:
+            // If a response is expected from the other side later, then put this
+            // message on the Transaction List.
+            if (msgMessage_GetTxnId(msgRef) != 0)
+            {
+                AddToTxnList(sessionPtr, msgRef);
+            }
+            // Otherwise, release it.
+            else
+            {
+                le_msg_ReleaseMsg(msgRef);
+            }
+
+            break;
+
+        // If this is the server side of the session,
+        case LE_MSG_INTERFACE_SERVER:
+            // Release the message, but first clear out the transaction ID so that
+            // the message knows that it is not being deleted without a reponse message
+            // being sent if one was expected.
+            msgMessage_SetTxnId(msgRef, 0);
+            le_msg_ReleaseMsg(msgRef);
+
+            break;
+
+        default:
+            LE_FATAL("Unhandled interface type (%d)",
+                     sessionPtr->interfaceRef->interfaceType);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Send messages from a session's Transmit Queue until either the socket becomes full or there
- * are no more messages waiting on the queue.
+ * are no more messages waiting on the queue.  Up to MSG_BATCH_SIZE messages are sent by each
+ * socket system call.
  */
 //--------------------------------------------------------------------------------------------------
 static void SendFromTransmitQueue
@@ -1015,11 +1212,25 @@ static void SendFromTransmitQueue
 )
 //--------------------------------------------------------------------------------------------------
 {
+    le_msg_MessageRef_t msgRefs[MSG_BATCH_SIZE];
+
     for (;;)
     {
-        le_msg_MessageRef_t msgRef = PopTransmitQueue(sessionPtr);
+        size_t count = 0;
+        size_t sentCount = 0;
+        size_t i;
 
-        if (msgRef == NULL)
+        while (count < MSG_BATCH_SIZE)
+        {
+            le_msg_MessageRef_t msgRef = PopTransmitQueue(sessionPtr);
+            if (msgRef == NULL)
+            {
+                break;
+            }
+            msgRefs[count++] = msgRef;
+        }
+
+        if (count == 0)
         {
             // Since the Transmit Queue is empty, tell the FD Monitor that we don't need to be
             // notified about writeability anymore.
@@ -1027,51 +1238,37 @@ static void SendFromTransmitQueue
             break;
         }
 
-        le_result_t result = msgMessage_Send(sessionPtr->socketFd, msgRef);
+        le_result_t result = msgMessage_SendBatch(sessionPtr->socketFd,
+                                                  msgRefs,
+                                                  count,
+                                                  &sentCount);
+
+        if (result == LE_OK)
+        {
+            sessionPtr->txCallCount++;
+            sessionPtr->txMsgCount += sentCount;
+
+            for (i = 0; i < sentCount; i++)
+            {
+                MessageSent(sessionPtr, msgRefs[i]);
+            }
+        }
+
+        // Put any messages that didn't get sent back on the head of the queue, in their
+        // original order.
+        for (i = count; i > sentCount; i--)
+        {
+            UnPopTransmitQueue(sessionPtr, msgRefs[i - 1]);
+        }
 
         switch (result)
         {
             case LE_OK:
-                switch (sessionPtr->interfaceRef->interfaceType)
-                {
-                    // If this is the client side of the session,
-                    case LE_MSG_INTERFACE_CLIENT:
-                        // If a response is expected from the other side later, then put this
-                        // message on the Transaction List.
-                        if (msgMessage_GetTxnId(msgRef) != 0)
-                        {
-                            AddToTxnList(sessionPtr, msgRef);
-                        }
-                        // Otherwise, release it.
-                        else
-                        {
-                            le_msg_ReleaseMsg(msgRef);
-                        }
-
-                        break;
-
-                    // If this is the server side of the session,
-                    case LE_MSG_INTERFACE_SERVER:
-                        // Release the message, but first clear out the transaction ID so that
-                        // the message knows that it is not being deleted without a reponse message
-                        // being sent if one was expected.
-                        msgMessage_SetTxnId(msgRef, 0);
-                        le_msg_ReleaseMsg(msgRef);
-
-                        break;
-
-                    default:
-                        LE_FATAL("Unhandled interface type (%d)",
-                                 sessionPtr->interfaceRef->interfaceType);
-                }
-
-                break;  // Continue to loop around and send another.
+                break;  // Continue to loop around and send another batch.
 
             case LE_NO_MEMORY:
-                // Have to wait for the socket to become writeable.  Put the message back on
-                // the head of the queue and ask the FD Monitor to tell us when the socket becomes
-                // writeable again.
-                UnPopTransmitQueue(sessionPtr, msgRef);
+                // Have to wait for the socket to become writeable.  Ask the FD Monitor to tell
+                // us when the socket becomes writeable again.
                 EnableWriteabilityNotification(sessionPtr);
 
                 return;
@@ -1079,10 +1276,8 @@ static void SendFromTransmitQueue
             case LE_COMM_ERROR:
                 // In this case, we expect a handler function to be called by the FD Monitor,
                 // so we don't need to handle this case here.  However, we must stop
-                // trying to transmit now.  Stick the current message back on the Transmit Queue
-                // so it gets cleaned up with the others when the session closes.
-                UnPopTransmitQueue(sessionPtr, msgRef);
-
+                // trying to transmit now.  The unsent messages are back on the Transmit Queue
+                // so they get cleaned up with the others when the session closes.
                 return;
 
             default:
@@ -1092,6 +1287,42 @@ static void SendFromTransmitQueue
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send whatever is waiting on a session's Transmit Queue.  This is queued to the Event Loop by
+ * msgSession_SendMessage() so that messages sent by the server while handling one event go out
+ * together.
+ *
+ * @note    This function is called by the session's thread's Event Loop as a "queued function".
+ *          That's why the parameter list looks unusual.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushTransmitQueue
+(
+    void* param1Ptr,    ///< [IN] Pointer to a Session object.
+    void* param2Ptr     ///< not used
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(param2Ptr);
+
+    msgSession_UnixSession_t* sessionPtr = param1Ptr;
+
+    LE_ASSERT(le_thread_GetCurrent() == sessionPtr->threadRef);
+
+    sessionPtr->isFlushQueued = false;
+
+    if (sessionPtr->state == LE_MSG_SESSION_STATE_OPEN)
+    {
+        SendFromTransmitQueue(sessionPtr);
+    }
+
+    // NOTE: The queued function holds a reference to the session object so that the session
+    //       object doesn't go away.  But it could go away as soon as we release it.
+    le_mem_Release(sessionPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Client-side handler for when a Session's socket becomes ready for reading (i.e., handle
@@ -1312,6 +1543,7 @@ static void StartSocketMonitoring
                                                    sessionPtr->socketFd,
                                                    handlerFunc,
                                                    POLLIN);
+    sessionPtr->isTxBlocked = false;
 
     le_fdMonitor_SetContextPtr(sessionPtr->fdMonitorRef, sessionPtr);
 }
@@ -1563,6 +1795,10 @@ void msgSession_Init
     SessionPoolRef = le_mem_CreatePool("Session", sizeof(msgSession_UnixSession_t));
     le_mem_ExpandPool(SessionPoolRef, 10); /// @todo Make this configurable.
 
+#if LE_CONFIG_MSG_SHM
+    msgShm_Init();
+#endif
+
     TxnMapRef = le_ref_CreateMap("MsgTxnIDs", MAX_EXPECTED_TXNS);
 
     // Get a reference to the trace keyword that is used to control tracing in this module.
@@ -1588,6 +1824,25 @@ msgInterface_Type_t msgSession_GetInterfaceType
 }
 
 
+#if LE_CONFIG_MSG_SHM
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a session's shared memory for large messages.
+ *
+ * @return  The shared memory region, or NULL if the session doesn't have any.
+ */
+//--------------------------------------------------------------------------------------------------
+msgShm_RegionRef_t msgSession_GetShmRef
+(
+    le_msg_SessionRef_t sessionRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return msgSession_GetUnixSessionPtr(sessionRef)->shmRef;
+}
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks whether a given Session reference is for an open session.
@@ -1637,8 +1892,40 @@ void msgSession_SendMessage
         // Put the message on the Transmit Queue.
         PushTransmitQueue(unixSessionPtr, messageRef);
 
-        // Try to send something from the Transmit Queue.
-        SendFromTransmitQueue(unixSessionPtr);
+        if (unixSessionPtr->isTxBlocked)
+        {
+            // The socket is full.  The message will be sent with the others on the Transmit
+            // Queue when the socket becomes writeable again.
+        }
+        // On the server side, hold indications until the current handler returns to the Event
+        // Loop, so that they can be sent together with any others that the handler sends.  Don't
+        // let more than a batch build up, though.  Responses are sent right away, so as not to
+        // add latency to request-response transactions, and clients may not be running an Event
+        // Loop, so their messages are always sent right away too.
+        else if ((MSG_BATCH_SIZE > 1) &&
+                 (unixSessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_SERVER) &&
+                 (msgMessage_GetTxnId(messageRef) == 0) &&
+                 (unixSessionPtr->transmitCount < MSG_BATCH_SIZE))
+        {
+            if (!unixSessionPtr->isFlushQueued)
+            {
+                // NOTE: The queued function holds a reference to the session object so that
+                //       the session object doesn't go away before the queued function is run.
+                //       It is queued to the session's own thread, which is the only one that
+                //       touches the Transmit Queue and its flags (see the check above).
+                unixSessionPtr->isFlushQueued = true;
+                le_mem_AddRef(unixSessionPtr);
+                le_event_QueueFunctionToThread(unixSessionPtr->threadRef,
+                                               FlushTransmitQueue,
+                                               unixSessionPtr,
+                                               NULL);
+            }
+        }
+        else
+        {
+            // Try to send something from the Transmit Queue.
+            SendFromTransmitQueue(unixSessionPtr);
+        }
     }
 }
 
@@ -1678,6 +1965,38 @@ void msgSession_RequestResponse
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Block until a session's socket is ready for reading or writing, or has hung up or failed.
+ *
+ * This is used instead of switching the socket into blocking mode for synchronous transactions,
+ * which would cost four fcntl() calls per transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WaitForSocket
+(
+    int   socketFd,     ///< [IN] The socket's file descriptor.
+    short events        ///< [IN] POLLIN or POLLOUT.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct pollfd pollFd;
+    int result;
+
+    pollFd.fd = socketFd;
+    pollFd.events = events;
+    pollFd.revents = 0;
+
+    do
+    {
+        result = poll(&pollFd, 1, -1);
+    }
+    while ((result == -1) && (errno == EINTR));
+
+    LE_FATAL_IF(result == -1, "poll() failed on fd %d: %m", socketFd);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Do a synchronous request-response transaction.
@@ -1702,11 +2021,12 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
     // Create an ID for this transaction.
     CreateTxnId(msgRef);
 
-    // Put the socket into blocking mode.
-    fd_SetBlocking(unixSessionPtr->socketFd);
-
-    // Send the Request Message.
-    msgMessage_Send(unixSessionPtr->socketFd, msgRef);
+    // Send the Request Message.  The socket is left in non-blocking mode, so if there's no room
+    // in the socket's send buffer right now, wait for some.
+    while (msgMessage_Send(unixSessionPtr->socketFd, msgRef) == LE_NO_MEMORY)
+    {
+        WaitForSocket(unixSessionPtr->socketFd, POLLOUT);
+    }
 
     // While we have not yet received the response we are waiting for, keep
     // receiving messages.  Any that we receive that don't match the transaction ID
@@ -1714,11 +2034,19 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
     // function call.
     for (;;)
     {
+        WaitForSocket(unixSessionPtr->socketFd, POLLIN);
+
         rxMsgRef = le_msg_CreateMsg(sessionRef);
 
         le_result_t result = msgMessage_Receive(unixSessionPtr->socketFd, rxMsgRef);
 
-        if (result != LE_OK)
+        if (result == LE_WOULD_BLOCK)
+        {
+            // Nothing there after all.  Go back to waiting.
+            le_msg_ReleaseMsg(rxMsgRef);
+            continue;
+        }
+        else if (result != LE_OK)
         {
             // The socket experienced an error or the connection was closed.
             // No message was received.
@@ -1753,9 +2081,6 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
     // Don't need the request message anymore.
     le_msg_ReleaseMsg(msgRef);
 
-    // Put the socket back into non-blocking mode.
-    fd_SetNonBlocking(unixSessionPtr->socketFd);
-
     return rxMsgRef;
 }
 
@@ -1894,10 +2219,32 @@ le_msg_SessionRef_t msgSession_CreateServerSideSession
     msgInterface_UnixService_t* servicePtr = CONTAINER_OF(serviceRef,
                                                           msgInterface_UnixService_t,
                                                           service);
+    int shmFd = -1;
+
+#if LE_CONFIG_MSG_SHM
+    // Set up shared memory for large messages, if this protocol has any.
+    size_t maxMsgSize = le_msg_GetProtocolMaxMsgSize(
+                            msgInterface_GetProtocolRef(&servicePtr->interface));
+    msgShm_RegionRef_t shmRef = msgShm_Create(maxMsgSize, &shmFd);
+#endif
+
     // Send a Hello message (LE_OK) to the client.
-    if (SendSessionOpenResponse(fd) != LE_OK)
+    le_result_t result = SendSessionOpenResponse(fd, shmFd);
+
+    if (shmFd >= 0)
+    {
+        fd_Close(shmFd);
+    }
+
+    if (result != LE_OK)
     {
         // Something went wrong.  Abort.
+#if LE_CONFIG_MSG_SHM
+        if (shmRef != NULL)
+        {
+            msgShm_Delete(shmRef);
+        }
+#endif
         fd_Close(fd);
         return NULL;
     }
@@ -1912,6 +2259,10 @@ le_msg_SessionRef_t msgSession_CreateServerSideSession
     // Record the client connection file descriptor.
     sessionPtr->socketFd = fd;
 
+#if LE_CONFIG_MSG_SHM
+    sessionPtr->shmRef = shmRef;
+#endif
+
     // Start monitoring the server-side session connection socket for events.
     StartSocketMonitoring(sessionPtr, ServerSocketEventHandler);
 
@@ -12,6 +12,7 @@
 
 #include "messagingCommon.h"
 #include "messagingInterface.h"
+#include "messagingShm.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -51,10 +52,20 @@ typedef struct msg_UnixSession
     le_dls_List_t                   txnList;        ///< List of request messages that have been
                                                     ///  sent and are waiting for their response.
 
+    // The Transmit Queue and the flags below are only accessed by the session's thread.
     le_dls_List_t                   transmitQueue;  ///< Queue of messages waiting to be sent.
+    size_t                          transmitCount;  ///< Number of messages on the Transmit Queue.
+    bool                            isFlushQueued;  ///< true if a deferred send of the Transmit
+                                                    ///  Queue has been queued to the session's
+                                                    ///  thread's Event Loop.
+    bool                            isTxBlocked;    ///< true if waiting for the socket to become
+                                                    ///  writeable.
 
     le_dls_List_t                   receiveQueue;   ///< Queue of received messages waiting to be
                                                     /// processed.
+    le_msg_MessageRef_t             rxSpareRefs[LE_CONFIG_MSG_BATCH_SIZE];
+                                                    ///< Message objects kept ready to receive into.
+    size_t                          rxSpareCount;   ///< Number of entries in rxSpareRefs.
 
     void*                           contextPtr;     ///< The session's context pointer.
     le_msg_ReceiveHandler_t         rxHandler;      ///< Receive handler function.
@@ -63,6 +74,16 @@ typedef struct msg_UnixSession
     void*                           openContextPtr; ///< Open handler's context pointer.
     le_msg_SessionEventHandler_t    closeHandler;   ///< Close handler function.
     void*                           closeContextPtr;///< Close handler's context pointer.
+
+    size_t                          txMsgCount;     ///< Messages sent by batched socket calls.
+    size_t                          txCallCount;    ///< Batched socket send calls made.
+    size_t                          rxMsgCount;     ///< Messages received by batched socket calls.
+    size_t                          rxCallCount;    ///< Batched socket receive calls made.
+
+#if LE_CONFIG_MSG_SHM
+    msgShm_RegionRef_t              shmRef;         ///< Shared memory for large messages, or NULL
+                                                    ///  if the session doesn't have any.
+#endif
 }
 msgSession_UnixSession_t;
 
@@ -103,6 +124,21 @@ msgInterface_Type_t msgSession_GetInterfaceType
 );
 
 
+#if LE_CONFIG_MSG_SHM
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a session's shared memory for large messages.
+ *
+ * @return  The shared memory region, or NULL if the session doesn't have any.
+ */
+//--------------------------------------------------------------------------------------------------
+msgShm_RegionRef_t msgSession_GetShmRef
+(
+    le_msg_SessionRef_t sessionRef
+);
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks whether a given Session reference is for an open session.
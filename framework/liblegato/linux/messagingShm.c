@@ -0,0 +1,425 @@
+/** @file messagingShm.c
+ *
+ * Shared-memory transport for large IPC messages.  See messagingShm.h for an overview.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+#include "fileDescriptor.h"
+#include "messagingShm.h"
+
+#include <sys/mman.h>
+
+#if LE_CONFIG_MSG_SHM
+
+// Not defined by older C libraries.
+#ifndef F_ADD_SEALS
+#   define F_ADD_SEALS      1033
+#   define F_GET_SEALS      1034
+#endif
+#ifndef F_SEAL_SEAL
+#   define F_SEAL_SEAL      0x0001
+#   define F_SEAL_SHRINK    0x0002
+#   define F_SEAL_GROW      0x0004
+#endif
+
+/// Magic number and version found at the start of a region.
+#define REGION_MAGIC        0x4c474d53  // "LGMS"
+#define REGION_VERSION      2
+
+/// Size of each ring created by this process.
+#define RING_SIZE           LE_CONFIG_MSG_SHM_RING_SIZE
+
+#if (RING_SIZE & (RING_SIZE - 1)) != 0
+#error "LE_CONFIG_MSG_SHM_RING_SIZE must be a power of two"
+#endif
+
+/// Smallest payload worth putting in shared memory.
+#define THRESHOLD           LE_CONFIG_MSG_SHM_THRESHOLD
+
+/// Index of the ring that carries messages from the client to the server, and the reverse.
+#define CLIENT_TO_SERVER    0
+#define SERVER_TO_CLIENT    1
+
+/// Round a payload size up to a multiple of 8 bytes.
+#define RECORD_SIZE(size)   (((size) + 7) & ~(uint32_t)7)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Consumer's position in a ring, on a cache line of its own.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t    tail;           ///< Position up to which the consumer has freed space.
+    uint8_t     reserved[60];
+}
+RingTail_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header at the start of a region.  The record areas of the two rings follow it.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t    magic;          ///< REGION_MAGIC.
+    uint32_t    version;        ///< REGION_VERSION.
+    uint32_t    ringSize;       ///< Size of each ring's record area (a power of two).
+    uint32_t    clientAttached; ///< Set to 1 by the client once it has mapped the region.
+    uint8_t     reserved[48];
+    RingTail_t  tails[2];       ///< Consumer positions, indexed by ring.
+}
+RegionHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A session's view of its shared memory region.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct msgShm_Region
+{
+    RegionHeader_t* hdrPtr;         ///< Start of the mapping.
+    size_t          mapSize;        ///< Size of the mapping.
+    uint32_t        ringSize;       ///< Size of each ring's record area.
+    bool            isPeerAttached; ///< true once the other side is known to use the region.
+
+    uint8_t*        txDataPtr;      ///< Record area of the ring this side sends through.
+    uint32_t*       txTailPtr;      ///< Shared tail position of that ring.
+    uint32_t        txHead;         ///< Position up to which this side has put payloads.
+
+    uint8_t*        rxDataPtr;      ///< Record area of the ring this side receives through.
+    uint32_t*       rxTailPtr;      ///< Shared tail position of that ring.
+    uint32_t        rxTail;         ///< Position up to which this side has taken payloads.
+}
+Region_t;
+
+/// Pool from which Region objects are allocated.
+static le_mem_PoolRef_t RegionPoolRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a Region object for a mapping and point it at the rings for one side of a session.
+ */
+//--------------------------------------------------------------------------------------------------
+static Region_t* CreateRegion
+(
+    void*       addr,       ///< [IN] Start of the mapping.
+    size_t      mapSize,    ///< [IN] Size of the mapping.
+    uint32_t    ringSize,   ///< [IN] Size of each ring's record area.
+    int         txRing      ///< [IN] Index of the ring this side sends through.
+)
+{
+    Region_t* regionPtr = le_mem_ForceAlloc(RegionPoolRef);
+    uint8_t* dataPtr = (uint8_t*)addr + sizeof(RegionHeader_t);
+    int rxRing = (txRing == CLIENT_TO_SERVER) ? SERVER_TO_CLIENT : CLIENT_TO_SERVER;
+
+    regionPtr->hdrPtr = addr;
+    regionPtr->mapSize = mapSize;
+    regionPtr->ringSize = ringSize;
+    regionPtr->isPeerAttached = false;
+
+    regionPtr->txDataPtr = dataPtr + (size_t)txRing * ringSize;
+    regionPtr->txTailPtr = &regionPtr->hdrPtr->tails[txRing].tail;
+    regionPtr->txHead = __atomic_load_n(regionPtr->txTailPtr, __ATOMIC_ACQUIRE);
+
+    regionPtr->rxDataPtr = dataPtr + (size_t)rxRing * ringSize;
+    regionPtr->rxTailPtr = &regionPtr->hdrPtr->tails[rxRing].tail;
+    regionPtr->rxTail = __atomic_load_n(regionPtr->rxTailPtr, __ATOMIC_ACQUIRE);
+
+    return regionPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes this module.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgShm_Init
+(
+    void
+)
+{
+    RegionPoolRef = le_mem_CreatePool("MsgShmRegion", sizeof(Region_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates the shared memory region for the server side of a session.
+ *
+ * @return A reference to the region, or NULL if none was created.
+ */
+//--------------------------------------------------------------------------------------------------
+msgShm_RegionRef_t msgShm_Create
+(
+    size_t  maxMsgSize,     ///< [IN] Size of the protocol's largest message payload.
+    int*    fdPtr           ///< [OUT] File descriptor to pass to the client.
+)
+{
+    size_t fileSize = sizeof(RegionHeader_t) + 2 * (size_t)RING_SIZE;
+
+    // Don't bother if no message of this protocol could ever go through the rings.
+    if ((maxMsgSize < THRESHOLD) || (RECORD_SIZE(THRESHOLD) > RING_SIZE))
+    {
+        return NULL;
+    }
+
+    int fd = fd_CreateAnonymous("LegatoMsg");
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    if (ftruncate(fd, fileSize) != 0)
+    {
+        LE_ERROR("Could not size IPC shared memory.  %m.");
+        fd_Close(fd);
+        return NULL;
+    }
+
+    // Seal the size so that the client can safely map the file.  This is checked by the client,
+    // so it doesn't matter here if sealing isn't supported.
+    fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+
+    void* addr = mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        LE_ERROR("Could not map IPC shared memory.  %m.");
+        fd_Close(fd);
+        return NULL;
+    }
+
+    // The file starts out zeroed, so both rings are empty and the client hasn't attached.
+    RegionHeader_t* hdrPtr = addr;
+    hdrPtr->magic = REGION_MAGIC;
+    hdrPtr->version = REGION_VERSION;
+    hdrPtr->ringSize = RING_SIZE;
+
+    *fdPtr = fd;
+
+    return CreateRegion(addr, fileSize, RING_SIZE, SERVER_TO_CLIENT);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps a shared memory region received from the server.
+ *
+ * @return A reference to the region, or NULL if the file isn't a valid region.
+ */
+//--------------------------------------------------------------------------------------------------
+msgShm_RegionRef_t msgShm_Attach
+(
+    int fd      ///< [IN] File descriptor received from the server.
+)
+{
+    struct stat fileInfo;
+
+    // The server must not be able to shrink the file out from under the mapping, or reading it
+    // would crash this process.
+    int seals = fcntl(fd, F_GET_SEALS);
+    if ((seals == -1) || !(seals & F_SEAL_SHRINK))
+    {
+        LE_WARN("IPC shared memory isn't sealed.");
+        return NULL;
+    }
+
+    if (fstat(fd, &fileInfo) != 0)
+    {
+        LE_ERROR("Could not stat IPC shared memory.  %m.");
+        return NULL;
+    }
+
+    if ((size_t)fileInfo.st_size <= sizeof(RegionHeader_t))
+    {
+        LE_WARN("IPC shared memory is too small (%zu bytes).", (size_t)fileInfo.st_size);
+        return NULL;
+    }
+
+    void* addr = mmap(NULL, fileInfo.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        LE_ERROR("Could not map IPC shared memory.  %m.");
+        return NULL;
+    }
+
+    RegionHeader_t* hdrPtr = addr;
+    uint32_t ringSize = hdrPtr->ringSize;
+
+    if (   (hdrPtr->magic != REGION_MAGIC)
+        || (hdrPtr->version != REGION_VERSION)
+        || (ringSize == 0)
+        || ((ringSize & (ringSize - 1)) != 0)
+        || (sizeof(*hdrPtr) + 2 * (size_t)ringSize != (size_t)fileInfo.st_size) )
+    {
+        LE_WARN("Invalid IPC shared memory.");
+        munmap(addr, fileInfo.st_size);
+        return NULL;
+    }
+
+    Region_t* regionPtr = CreateRegion(addr, fileInfo.st_size, ringSize, CLIENT_TO_SERVER);
+
+    // The server created the region, so it's ready to receive through it.
+    regionPtr->isPeerAttached = true;
+    __atomic_store_n(&hdrPtr->clientAttached, 1, __ATOMIC_RELEASE);
+
+    return regionPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmaps a session's shared memory region.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgShm_Delete
+(
+    msgShm_RegionRef_t regionRef
+)
+{
+    munmap(regionRef->hdrPtr, regionRef->mapSize);
+    le_mem_Release(regionRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a message payload into the sending ring, if it is big enough to be worth it and there is
+ * room.
+ *
+ * @return true if the payload was put in the ring and *descPtr should be sent in its place.
+ */
+//--------------------------------------------------------------------------------------------------
+bool msgShm_Put
+(
+    msgShm_RegionRef_t  regionRef,
+    const void*         dataPtr,    ///< [IN] Payload.
+    size_t              size,       ///< [IN] Size of the payload, in bytes.
+    msgShm_Desc_t*      descPtr     ///< [OUT] Descriptor to send.
+)
+{
+    uint32_t ringSize = regionRef->ringSize;
+
+    if ((size < THRESHOLD) || (size > ringSize))
+    {
+        return false;
+    }
+
+    if (!regionRef->isPeerAttached)
+    {
+        if (__atomic_load_n(&regionRef->hdrPtr->clientAttached, __ATOMIC_ACQUIRE) == 0)
+        {
+            return false;
+        }
+        regionRef->isPeerAttached = true;
+    }
+
+    uint32_t recordSize = RECORD_SIZE((uint32_t)size);
+    uint32_t head = regionRef->txHead;
+    uint32_t tail = __atomic_load_n(regionRef->txTailPtr, __ATOMIC_ACQUIRE);
+    uint32_t offset = head & (ringSize - 1);
+
+    // Payloads never straddle the end of the ring.  Skip the space left at the end if needed.
+    uint32_t padSize = (offset + recordSize > ringSize) ? ringSize - offset : 0;
+
+    if ((head - tail) + padSize + recordSize > ringSize)
+    {
+        // Full.  The consumer is behind; send this one through the socket instead.
+        return false;
+    }
+
+    uint32_t start = head + padSize;
+
+    memcpy(regionRef->txDataPtr + (start & (ringSize - 1)), dataPtr, size);
+    regionRef->txHead = start + recordSize;
+
+    descPtr->start = start;
+    descPtr->size = (uint32_t)size;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the current position of the sending ring's head.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t msgShm_GetMark
+(
+    msgShm_RegionRef_t  regionRef
+)
+{
+    return regionRef->txHead;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Takes back the space claimed by payloads put in the sending ring since a given position.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgShm_Rewind
+(
+    msgShm_RegionRef_t  regionRef,
+    uint32_t            mark        ///< [IN] Position returned by msgShm_GetMark().
+)
+{
+    regionRef->txHead = mark;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies the payload that a received descriptor refers to out of the receiving ring.
+ *
+ * @return
+ *  - LE_OK if the payload was copied into the buffer.
+ *  - LE_FORMAT_ERROR if the descriptor is not valid.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgShm_Get
+(
+    msgShm_RegionRef_t      regionRef,
+    const msgShm_Desc_t*    descPtr,    ///< [IN] Descriptor received from the socket.
+    void*                   bufPtr,     ///< [OUT] Buffer to copy the payload into.
+    size_t                  bufSize     ///< [IN] Size of the buffer.
+)
+{
+    uint32_t ringSize = regionRef->ringSize;
+    uint32_t tail = regionRef->rxTail;
+    uint32_t start = descPtr->start;
+    uint32_t size = descPtr->size;
+    uint32_t offset = start & (ringSize - 1);
+    uint32_t skipSize = start - tail;
+
+    // The payload must start where the previous one ended, or at the start of the ring if it
+    // didn't fit at the end, and it must fit within the ring.
+    if (   (size > bufSize)
+        || (size > ringSize)
+        || (offset + size > ringSize)
+        || (   (skipSize != 0)
+            && ((offset != 0) || ((tail & (ringSize - 1)) + skipSize != ringSize))) )
+    {
+        LE_ERROR("Invalid IPC shared memory descriptor (start %" PRIu32 ", size %" PRIu32
+                 ", tail %" PRIu32 ").",
+                 start,
+                 size,
+                 tail);
+        return LE_FORMAT_ERROR;
+    }
+
+    memcpy(bufPtr, regionRef->rxDataPtr + offset, size);
+
+    regionRef->rxTail = start + RECORD_SIZE(size);
+    __atomic_store_n(regionRef->rxTailPtr, regionRef->rxTail, __ATOMIC_RELEASE);
+
+    return LE_OK;
+}
+
+#endif // LE_CONFIG_MSG_SHM
@@ -0,0 +1,174 @@
+/** @file messagingShm.h
+ *
+ * Shared-memory transport for large IPC messages.
+ *
+ * When LE_CONFIG_MSG_SHM is enabled, the server side of a session whose protocol has messages of
+ * at least LE_CONFIG_MSG_SHM_THRESHOLD bytes creates a memory-backed file holding two rings, one
+ * for each direction, and passes its file descriptor to the client with the session open
+ * response.  The client maps it and marks it as attached.  From then on, a message whose payload
+ * is at least the threshold size is copied into the sender's ring and only a small descriptor
+ * (the message's position and size in the ring) is sent through the socket, along with the
+ * message's transaction ID and file descriptor, if any.  Such messages are marked by a value in
+ * the transaction ID's place that no real transaction ID can have, so the receiver never has to
+ * guess from a payload's contents whether it is a descriptor.  The receiver copies the payload
+ * out of the ring into its Message object and frees the space.
+ *
+ * Each ring has exactly one producer (the thread that owns the session on the sending side) and
+ * one consumer (the thread that owns the session on the receiving side), and messages are placed
+ * in the ring in the same order as their descriptors go through the socket, so the consumer
+ * always frees space in order.  Only the consumer's tail position is shared; the producer keeps
+ * its head position to itself, which lets it take back space claimed for a message that could
+ * not be sent after all.
+ *
+ * If the client does not attach (e.g., it can't map the file), the ring is full, or a message is
+ * too big for the ring, the message goes through the socket in full, as it would without shared
+ * memory.  Nothing in the shared memory is trusted by the receiver; positions and sizes are
+ * checked before use.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_MESSAGING_SHM_H_INCLUDE_GUARD
+#define LEGATO_MESSAGING_SHM_H_INCLUDE_GUARD
+
+#if LE_CONFIG_MSG_SHM
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a session's shared memory region.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct msgShm_Region* msgShm_RegionRef_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Descriptor sent through the socket in place of a payload that was put in shared memory.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t    start;      ///< Position of the payload in the sender's ring.
+    uint32_t    size;       ///< Size of the payload, in bytes.
+}
+msgShm_Desc_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes this module.  This must be called only once at start-up, before any other functions
+ * in this module are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgShm_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates the shared memory region for the server side of a session, if the session's protocol
+ * has messages big enough to benefit from it.
+ *
+ * @return A reference to the region, or NULL if none was created.  If a region was created, the
+ *         file descriptor to pass to the client is stored in *fdPtr and must be closed by the
+ *         caller once it has been sent.
+ */
+//--------------------------------------------------------------------------------------------------
+msgShm_RegionRef_t msgShm_Create
+(
+    size_t  maxMsgSize,     ///< [IN] Size of the protocol's largest message payload.
+    int*    fdPtr           ///< [OUT] File descriptor to pass to the client.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps a shared memory region received from the server, on the client side of a session, and
+ * tells the server that it may start using it.
+ *
+ * @return A reference to the region, or NULL if the file isn't a valid region.  The file descriptor
+ *         is not closed.
+ */
+//--------------------------------------------------------------------------------------------------
+msgShm_RegionRef_t msgShm_Attach
+(
+    int fd      ///< [IN] File descriptor received from the server.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmaps a session's shared memory region.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgShm_Delete
+(
+    msgShm_RegionRef_t regionRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a message payload into the sending ring, if it is big enough to be worth it and there is
+ * room.
+ *
+ * @return true if the payload was put in the ring and *descPtr should be sent in its place.
+ */
+//--------------------------------------------------------------------------------------------------
+bool msgShm_Put
+(
+    msgShm_RegionRef_t  regionRef,
+    const void*         dataPtr,    ///< [IN] Payload.
+    size_t              size,       ///< [IN] Size of the payload, in bytes.
+    msgShm_Desc_t*      descPtr     ///< [OUT] Descriptor to send.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the current position of the sending ring's head, so that payloads put in the ring after
+ * this point can be taken back with msgShm_Rewind() if they can't be sent.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t msgShm_GetMark
+(
+    msgShm_RegionRef_t  regionRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Takes back the space claimed by payloads put in the sending ring since msgShm_GetMark()
+ * returned a given position.  Their descriptors must not have been sent.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgShm_Rewind
+(
+    msgShm_RegionRef_t  regionRef,
+    uint32_t            mark        ///< [IN] Position returned by msgShm_GetMark().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies the payload that a received descriptor refers to out of the receiving ring and frees the
+ * space it occupied.
+ *
+ * @return
+ *  - LE_OK if the payload was copied into the buffer.
+ *  - LE_FORMAT_ERROR if the descriptor is not valid.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgShm_Get
+(
+    msgShm_RegionRef_t      regionRef,
+    const msgShm_Desc_t*    descPtr,    ///< [IN] Descriptor received from the socket.
+    void*                   bufPtr,     ///< [OUT] Buffer to copy the payload into.
+    size_t                  bufSize     ///< [IN] Size of the buffer.
+);
+
+#endif // LE_CONFIG_MSG_SHM
+
+#endif // LEGATO_MESSAGING_SHM_H_INCLUDE_GUARD
@@ -760,6 +760,266 @@ le_result_t unixSocket_ReceiveDataMsg
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ancillary data buffer for one message in a received batch.  This is the same size as the one
+ * used by unixSocket_ReceiveMsg().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef union
+{
+    struct cmsghdr align;               ///< Ensures the buffer is aligned for a cmsghdr.
+    char buff[CMSG_BUFF_SIZE];          ///< Ancillary data buffer.
+}
+BatchCmsgBuff_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a batch of messages through a connected Unix domain datagram or sequenced-packet socket
+ * using a single system call.  Each message can contain a data payload and a file descriptor.
+ *
+ * The messages are sent in order.  If the socket runs out of buffer space part way through the
+ * batch, only the first *sentCountPtr messages will have been sent.
+ *
+ * @return
+ * - LE_OK if at least one message was sent (check *sentCountPtr).
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ * - LE_NO_MEMORY if the send socket is set to non-blocking and it doesn't have enough buffer
+ *                  space to send right now. Wait for the "writeable" event on the file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_SendMsgBatch
+(
+    int localSocketFd,              ///< [IN] fd of the local socket that will be used to send.
+    unixSocket_MsgBuff_t* msgsPtr,  ///< [IN] Array of messages to send.
+    size_t msgCount,                ///< [IN] Number of messages in the array (at most
+                                    ///       UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t* sentCountPtr            ///< [OUT] Number of messages that were sent.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct mmsghdr msgHeaders[UNIXSOCKET_MAX_BATCH_MSGS];
+    struct iovec ioVectors[UNIXSOCKET_MAX_BATCH_MSGS];
+    char cmsgBuffers[UNIXSOCKET_MAX_BATCH_MSGS][CMSG_SPACE(sizeof(int))]
+        __attribute__((aligned(__alignof__(struct cmsghdr))));
+    size_t i;
+
+    LE_ASSERT((msgCount > 0) && (msgCount <= UNIXSOCKET_MAX_BATCH_MSGS));
+    LE_ASSERT(sentCountPtr != NULL);
+
+    *sentCountPtr = 0;
+
+    memset(msgHeaders, 0, msgCount * sizeof(msgHeaders[0]));
+
+    for (i = 0; i < msgCount; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        if ((msgsPtr[i].dataPtr != NULL) && (msgsPtr[i].dataSize > 0))
+        {
+            ioVectors[i].iov_base = msgsPtr[i].dataPtr;
+            ioVectors[i].iov_len = msgsPtr[i].dataSize;
+            msgHeaderPtr->msg_iov = &ioVectors[i];
+            msgHeaderPtr->msg_iovlen = 1;
+        }
+
+        // If we are sending a file descriptor, fill in an SCM_RIGHTS control message for it.
+        if (msgsPtr[i].fd >= 0)
+        {
+            msgHeaderPtr->msg_control = cmsgBuffers[i];
+            msgHeaderPtr->msg_controllen = sizeof(cmsgBuffers[i]);
+
+            struct cmsghdr* cmsgHeaderPtr = CMSG_FIRSTHDR(msgHeaderPtr);
+            cmsgHeaderPtr->cmsg_level = SOL_SOCKET;
+            cmsgHeaderPtr->cmsg_type = SCM_RIGHTS;
+            cmsgHeaderPtr->cmsg_len = CMSG_LEN(sizeof(int));
+            memcpy(CMSG_DATA(cmsgHeaderPtr), &msgsPtr[i].fd, sizeof(int));
+
+            msgHeaderPtr->msg_controllen = cmsgHeaderPtr->cmsg_len;
+
+            LE_DEBUG("Sending fd %d.", msgsPtr[i].fd);
+        }
+    }
+
+    // Now send the messages (retry if interrupted by a signal).
+    int sentCount;
+    do
+    {
+        sentCount = sendmmsg(localSocketFd, msgHeaders, msgCount, 0);
+    }
+    while ((sentCount < 0) && (errno == EINTR));
+
+    if (sentCount < 0)
+    {
+        switch (errno)
+        {
+            case EAGAIN:  // Same as EWOULDBLOCK
+                return LE_NO_MEMORY;
+
+            case ENOTCONN:
+            case ECONNRESET:
+            case EPIPE:
+                LE_WARN("sendmmsg() failed with errno %d (%m).", errno);
+                return LE_COMM_ERROR;
+
+            default:
+                LE_ERROR("sendmmsg() failed with errno %d (%m).", errno);
+                return LE_FAULT;
+        }
+    }
+
+    for (i = 0; i < (size_t)sentCount; i++)
+    {
+        if (msgHeaders[i].msg_len < msgsPtr[i].dataSize)
+        {
+            LE_ERROR("The last %"PRIuS" data bytes (of %"PRIuS" total) of message %"PRIuS
+                     " were discarded by sendmmsg()!",
+                     msgsPtr[i].dataSize - msgHeaders[i].msg_len,
+                     msgsPtr[i].dataSize,
+                     i);
+        }
+    }
+
+    *sentCountPtr = sentCount;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receives up to a given number of messages through a connected Unix domain datagram or
+ * sequenced-packet socket using a single system call.  Each message can contain a data payload
+ * and a file descriptor.
+ *
+ * This does not wait for more messages once at least one has been received, even if the socket
+ * is in blocking mode.
+ *
+ * The result of receiving each individual message is stored in its result field.
+ *
+ * @return
+ * - LE_OK if at least one message was received (check *receivedCountPtr).
+ * - LE_WOULD_BLOCK if the socket is set non-blocking and there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_ReceiveMsgBatch
+(
+    int localSocketFd,              ///< [IN] fd of local socket that will be used to receive.
+    unixSocket_MsgBuff_t* msgsPtr,  ///< [IN+OUT] Array of receive buffers.
+    size_t msgCount,                ///< [IN] Number of buffers in the array (at most
+                                    ///       UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t* receivedCountPtr        ///< [OUT] Number of messages that were received.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct mmsghdr msgHeaders[UNIXSOCKET_MAX_BATCH_MSGS];
+    struct iovec ioVectors[UNIXSOCKET_MAX_BATCH_MSGS];
+    BatchCmsgBuff_t cmsgBuffers[UNIXSOCKET_MAX_BATCH_MSGS];
+    size_t i;
+
+    LE_ASSERT((msgCount > 0) && (msgCount <= UNIXSOCKET_MAX_BATCH_MSGS));
+    LE_ASSERT(receivedCountPtr != NULL);
+
+    *receivedCountPtr = 0;
+
+    memset(msgHeaders, 0, msgCount * sizeof(msgHeaders[0]));
+
+    for (i = 0; i < msgCount; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        msgHeaderPtr->msg_control = cmsgBuffers[i].buff;
+        msgHeaderPtr->msg_controllen = sizeof(cmsgBuffers[i].buff);
+
+        if ((msgsPtr[i].dataPtr != NULL) && (msgsPtr[i].dataSize > 0))
+        {
+            ioVectors[i].iov_base = msgsPtr[i].dataPtr;
+            ioVectors[i].iov_len = msgsPtr[i].dataSize;
+            msgHeaderPtr->msg_iov = &ioVectors[i];
+            msgHeaderPtr->msg_iovlen = 1;
+        }
+
+        msgsPtr[i].dataSize = 0;
+        msgsPtr[i].fd = -1;
+        msgsPtr[i].result = LE_FAULT;
+    }
+
+    // Keep trying to receive until we don't get interrupted by a signal.  MSG_WAITFORONE makes
+    // the call return as soon as there is nothing more to receive once it has got a message.
+    int receivedCount;
+    do
+    {
+        receivedCount = recvmmsg(localSocketFd, msgHeaders, msgCount, MSG_WAITFORONE, NULL);
+    }
+    while ((receivedCount < 0) && (errno == EINTR));
+
+    if (receivedCount < 0)
+    {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return LE_WOULD_BLOCK;
+        }
+        else if (errno == ECONNRESET)
+        {
+            return LE_CLOSED;
+        }
+        else
+        {
+            LE_ERROR("recvmmsg() failed with errno %d (%m).", errno);
+            return LE_FAULT;
+        }
+    }
+
+    if (receivedCount == 0)
+    {
+        return LE_CLOSED;
+    }
+
+    for (i = 0; i < (size_t)receivedCount; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        // Check if ancillary data was discarded (likely a fd rejected by SMACK).
+        if ((msgHeaderPtr->msg_flags & MSG_CTRUNC) != 0)
+        {
+            LE_ERROR("Unable to receive fd because control data has been truncated");
+            msgsPtr[i].result = LE_NOT_PERMITTED;
+            continue;
+        }
+
+        if (msgHeaderPtr->msg_controllen > 0)
+        {
+            ExtractAncillaryData(msgHeaderPtr, &msgsPtr[i].fd, NULL);
+        }
+        else if (msgHeaders[i].msg_len == 0)
+        {
+            msgsPtr[i].result = LE_CLOSED;
+            continue;
+        }
+
+        msgsPtr[i].dataSize = msgHeaders[i].msg_len;
+
+        if ((msgHeaderPtr->msg_flags & MSG_TRUNC) != 0)
+        {
+            msgsPtr[i].result = LE_NO_MEMORY;
+        }
+        else
+        {
+            msgsPtr[i].result = LE_OK;
+        }
+    }
+
+    *receivedCountPtr = receivedCount;
+
+    return LE_OK;
+}
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the socket error state code (SO_ERROR).
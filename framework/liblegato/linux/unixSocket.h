@@ -157,6 +157,10 @@
  * - unixSocket_ReceiveMsg() receives a message containing any combination of normal
  *   data, a file descriptor, and authenticated credentials.
  *
+ * - unixSocket_SendMsgBatch() and unixSocket_ReceiveMsgBatch() send or receive several
+ *   data (and file descriptor) messages through a datagram or sequenced-packet socket using
+ *   a single sendmmsg() or recvmmsg() system call.
+ *
  * When file descriptors are sent, they are duplicated in the receiving process as if they had
  * been created using the POSIX dup() function.  This means that they remain open in the sending
  * process and must be closed by the sending process when it doesn't need them anymore.
@@ -519,6 +523,88 @@ le_result_t unixSocket_ReceiveDataMsg
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of messages that can be passed to unixSocket_SendMsgBatch() or
+ * unixSocket_ReceiveMsgBatch() in one call.
+ */
+//--------------------------------------------------------------------------------------------------
+#define UNIXSOCKET_MAX_BATCH_MSGS   32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Describes one message in a batch sent by unixSocket_SendMsgBatch() or received by
+ * unixSocket_ReceiveMsgBatch().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    void*       dataPtr;    ///< [IN] Data payload to send, or buffer to receive the payload into.
+    size_t      dataSize;   ///< [IN+OUT] Number of bytes to send, or size of the receive buffer
+                            ///     (updated to the number of bytes received).
+    int         fd;         ///< [IN+OUT] File descriptor to send, or the one received
+                            ///     (-1 = none).
+    le_result_t result;     ///< [OUT] Result of receiving this message (receive only; see
+                            ///     unixSocket_ReceiveMsg() for the possible values).
+}
+unixSocket_MsgBuff_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a batch of messages through a connected Unix domain datagram or sequenced-packet socket
+ * using a single system call.  Each message can contain a data payload and a file descriptor.
+ *
+ * The messages are sent in order.  If the socket runs out of buffer space part way through the
+ * batch, only the first *sentCountPtr messages will have been sent.
+ *
+ * @return
+ * - LE_OK if at least one message was sent (check *sentCountPtr).
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ * - LE_NO_MEMORY if the send socket is set to non-blocking and it doesn't have enough buffer
+ *                  space to send right now. Wait for the "writeable" event on the file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_SendMsgBatch
+(
+    int localSocketFd,              ///< [IN] fd of the local socket that will be used to send.
+    unixSocket_MsgBuff_t* msgsPtr,  ///< [IN] Array of messages to send.
+    size_t msgCount,                ///< [IN] Number of messages in the array (at most
+                                    ///       UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t* sentCountPtr            ///< [OUT] Number of messages that were sent.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receives up to a given number of messages through a connected Unix domain datagram or
+ * sequenced-packet socket using a single system call.  Each message can contain a data payload
+ * and a file descriptor.
+ *
+ * This does not wait for more messages once at least one has been received, even if the socket
+ * is in blocking mode.
+ *
+ * The result of receiving each individual message is stored in its result field.
+ *
+ * @return
+ * - LE_OK if at least one message was received (check *receivedCountPtr).
+ * - LE_WOULD_BLOCK if the socket is set non-blocking and there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_ReceiveMsgBatch
+(
+    int localSocketFd,              ///< [IN] fd of local socket that will be used to receive.
+    unixSocket_MsgBuff_t* msgsPtr,  ///< [IN+OUT] Array of receive buffers.
+    size_t msgCount,                ///< [IN] Number of buffers in the array (at most
+                                    ///       UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t* receivedCountPtr        ///< [OUT] Number of messages that were received.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the socket error state code (SO_ERROR).
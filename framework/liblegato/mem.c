@@ -153,6 +153,27 @@ typedef struct
 MemBlock_t;
 
 
+#if LE_CONFIG_MEM_THREAD_CACHE
+//--------------------------------------------------------------------------------------------------
+/**
+ * A thread's cache of free blocks for one pool.  Only accessed by the thread that owns it.
+ *
+ * Blocks on a thread cache's free list are counted as "in use" by the pool they belong to.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_mem_Pool_t* poolPtr;     ///< Pool that the cached blocks belong to.
+    le_sls_List_t freeList;     ///< List of free blocks held by this thread.
+    size_t numBlocks;           ///< Number of blocks on the free list.
+#if LE_CONFIG_MEM_POOL_STATS
+    uint64_t numAllocations;    ///< Allocations served since the pool's stats were last updated.
+#endif
+}
+ThreadCache_t;
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Local list of all memory pools created with le_mem_CreatePool and le_mem_CreateSubPool
@@ -1047,6 +1068,234 @@ le_mem_PoolRef_t le_mem_ExpandPool
 }
 
 
+#if LE_CONFIG_MEM_THREAD_CACHE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves blocks from a thread cache back onto its pool's free list.
+ *
+ * @note
+ *      Assumes that the mutex is locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushThreadCache_NoLock
+(
+    ThreadCache_t*  cachePtr,   ///< [IN] The thread cache to flush.
+    size_t          numBlocks   ///< [IN] The number of blocks to return to the pool.
+)
+{
+    le_mem_Pool_t* poolPtr = cachePtr->poolPtr;
+    size_t i;
+
+    for (i = 0; i < numBlocks; i++)
+    {
+        le_sls_Link_t* blockLinkPtr = le_sls_Pop(&(cachePtr->freeList));
+        LE_ASSERT(blockLinkPtr != NULL);
+
+        *blockLinkPtr = LE_SLS_LINK_INIT;
+        le_sls_Stack(&(poolPtr->freeList), blockLinkPtr);
+    }
+
+    cachePtr->numBlocks -= numBlocks;
+    poolPtr->numBlocksInUse -= numBlocks;
+
+#if LE_CONFIG_MEM_POOL_STATS
+    poolPtr->numAllocations += cachePtr->numAllocations;
+    cachePtr->numAllocations = 0;
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves up to half a thread cache's worth of blocks from the pool's free list into a thread cache.
+ *
+ * @note
+ *      Assumes that the mutex is locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RefillThreadCache_NoLock
+(
+    ThreadCache_t*  cachePtr    ///< [IN] The thread cache to refill.
+)
+{
+    le_mem_Pool_t* poolPtr = cachePtr->poolPtr;
+    size_t numBlocks = (poolPtr->threadCacheSize + 1) / 2;
+    size_t i;
+
+    for (i = 0; i < numBlocks; i++)
+    {
+        le_sls_Link_t* blockLinkPtr = le_sls_Pop(&(poolPtr->freeList));
+        if (blockLinkPtr == NULL)
+        {
+            break;
+        }
+
+        *blockLinkPtr = LE_SLS_LINK_INIT;
+        le_sls_Stack(&(cachePtr->freeList), blockLinkPtr);
+    }
+
+    cachePtr->numBlocks += i;
+    poolPtr->numBlocksInUse += i;
+
+#if LE_CONFIG_MEM_POOL_STATS
+    poolPtr->numAllocations += cachePtr->numAllocations;
+    cachePtr->numAllocations = 0;
+
+    if (poolPtr->numBlocksInUse > poolPtr->maxNumBlocksUsed)
+    {
+        poolPtr->maxNumBlocksUsed = poolPtr->numBlocksInUse;
+    }
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread cache destructor.  Called by pthreads when a thread that has a cache for a pool exits;
+ * returns all of the cached blocks to the pool.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ThreadCacheDestructor
+(
+    void* cachePtr          ///< [IN] The exiting thread's cache.
+)
+{
+    mem_Lock();
+    FlushThreadCache_NoLock(cachePtr, ((ThreadCache_t*)cachePtr)->numBlocks);
+    mem_Unlock();
+
+    free(cachePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the calling thread's cache for a pool, creating it if necessary.
+ *
+ * @return The thread cache.
+ */
+//--------------------------------------------------------------------------------------------------
+static ThreadCache_t* GetThreadCache
+(
+    le_mem_PoolRef_t    pool    ///< [IN] A pool with per-thread caching enabled.
+)
+{
+    ThreadCache_t* cachePtr = pthread_getspecific(pool->threadCacheKey);
+
+    if (cachePtr == NULL)
+    {
+        cachePtr = calloc(1, sizeof(ThreadCache_t));
+        LE_ASSERT(cachePtr);
+
+        cachePtr->poolPtr = pool;
+        cachePtr->freeList = LE_SLS_LIST_INIT;
+
+        LE_ASSERT(pthread_setspecific(pool->threadCacheKey, cachePtr) == 0);
+    }
+
+    return cachePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Takes a free block from the calling thread's cache, refilling the cache from the pool if it is
+ * empty.
+ *
+ * @return The block, or NULL if neither the cache nor the pool have any free blocks.
+ */
+//--------------------------------------------------------------------------------------------------
+static MemBlock_t* ThreadCacheAlloc
+(
+    le_mem_PoolRef_t    pool    ///< [IN] A pool with per-thread caching enabled.
+)
+{
+    ThreadCache_t* cachePtr = GetThreadCache(pool);
+
+    if (cachePtr->numBlocks == 0)
+    {
+        mem_Lock();
+        RefillThreadCache_NoLock(cachePtr);
+        mem_Unlock();
+
+        if (cachePtr->numBlocks == 0)
+        {
+            return NULL;
+        }
+    }
+
+    le_sls_Link_t* blockLinkPtr = le_sls_Pop(&(cachePtr->freeList));
+    cachePtr->numBlocks--;
+#if LE_CONFIG_MEM_POOL_STATS
+    cachePtr->numAllocations++;
+#endif
+
+    return CONTAINER_OF(blockLinkPtr, MemBlock_t, data[0].link);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Puts a free block into the calling thread's cache, flushing half of the cache back to the pool
+ * if it has grown past its maximum size.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ThreadCacheFree
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] A pool with per-thread caching enabled.
+    MemBlock_t*         blockPtr    ///< [IN] The free block.
+)
+{
+    ThreadCache_t* cachePtr = GetThreadCache(pool);
+
+    blockPtr->data[0].link = LE_SLS_LINK_INIT;
+    le_sls_Stack(&(cachePtr->freeList), &(blockPtr->data[0].link));
+    cachePtr->numBlocks++;
+
+    if (cachePtr->numBlocks > pool->threadCacheSize)
+    {
+        mem_Lock();
+        FlushThreadCache_NoLock(cachePtr, cachePtr->numBlocks - (pool->threadCacheSize / 2));
+        mem_Unlock();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases an object from a pool with per-thread caching enabled.  The reference count is
+ * maintained with atomic operations instead of under the mutex.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ThreadCacheRelease
+(
+    void*       objPtr,     ///< [IN] Pointer to the object to be released.
+    MemBlock_t* blockPtr    ///< [IN] The object's block.
+)
+{
+    le_mem_Pool_t* poolPtr = blockPtr->poolPtr;
+
+    size_t refCount = LE_ATOMIC_SUB_FETCH(&(blockPtr->refCount), 1, LE_ATOMIC_ORDER_ACQ_REL);
+
+    if (refCount == SIZE_MAX)
+    {
+        LE_EMERG("Releasing free block.");
+        LE_FATAL("Free block released from pool '%" PRIpool "'.", REPR(poolPtr));
+    }
+    else if (refCount == 0)
+    {
+        if (poolPtr->destructor)
+        {
+            poolPtr->destructor(objPtr);
+        }
+
+        memset(blockPtr->data, 0, poolPtr->blockSize - offsetof(MemBlock_t, data));
+        ThreadCacheFree(poolPtr, blockPtr);
+    }
+}
+#endif /* end LE_CONFIG_MEM_THREAD_CACHE */
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Attempts to allocate an object from a pool.
@@ -1066,6 +1315,26 @@ void* le_mem_TryAlloc
     MemBlock_t* blockPtr = NULL;
     void* userPtr = NULL;
 
+#if LE_CONFIG_MEM_THREAD_CACHE
+    if (pool->threadCacheSize != 0)
+    {
+        blockPtr = ThreadCacheAlloc(pool);
+        if (blockPtr == NULL)
+        {
+            return NULL;
+        }
+
+        blockPtr->refCount = 1;
+
+#   if LE_CONFIG_USE_GUARD_BAND
+        InitGuardBands(blockPtr);
+        return &blockPtr->data[0].item + GUARD_BAND_SIZE;
+#   else
+        return blockPtr->data;
+#   endif
+    }
+#endif
+
     mem_Lock();
 
 #if LE_CONFIG_MEM_POOLS
@@ -1339,6 +1608,54 @@ void le_mem_SetNumObjsToForce
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gives each thread that uses a pool its own cache of free blocks, so that allocations and
+ * releases in that pool don't contend on the memory pool lock.
+ *
+ * @return  A reference to the memory pool object (the same value passed into it).
+ */
+//--------------------------------------------------------------------------------------------------
+le_mem_PoolRef_t le_mem_EnableThreadCache
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] Pool to enable per-thread caching for.
+    size_t              numObjects  ///< [IN] Maximum number of free objects cached per thread.
+)
+{
+    LE_ASSERT(pool != NULL);
+
+#if LE_CONFIG_MEM_THREAD_CACHE
+    LE_FATAL_IF(pool->superPoolPtr != NULL,
+                "Sub-pool '%" PRIpool "' cannot have a thread cache.", REPR(pool));
+
+    // Do not allow caching less than 1 object
+    if (numObjects == 0)
+    {
+        numObjects = 1;
+    }
+
+    mem_Lock();
+
+    LE_FATAL_IF(pool->numBlocksInUse != 0,
+                "Thread cache enabled on pool '%" PRIpool "' while %" PRIuS " blocks are in use.",
+                REPR(pool),
+                pool->numBlocksInUse);
+
+    if (pool->threadCacheSize == 0)
+    {
+        LE_ASSERT(pthread_key_create(&(pool->threadCacheKey), ThreadCacheDestructor) == 0);
+    }
+    pool->threadCacheSize = numObjects;
+
+    mem_Unlock();
+#else
+    LE_UNUSED(numObjects);
+#endif
+
+    return pool;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Releases an object.  If the object's reference count has reached zero, it will be destructed
@@ -1374,6 +1691,14 @@ void le_mem_Release
     CheckGuardBands(blockPtr);
 #endif
 
+#if LE_CONFIG_MEM_THREAD_CACHE
+    if (blockPtr->poolPtr->threadCacheSize != 0)
+    {
+        ThreadCacheRelease(objPtr, blockPtr);
+        return;
+    }
+#endif
+
     mem_Lock();
 
     switch (blockPtr->refCount)
@@ -1459,6 +1784,14 @@ void le_mem_AddRef
     CheckGuardBands(memBlockPtr);
 #endif
 
+#if LE_CONFIG_MEM_THREAD_CACHE
+    if (memBlockPtr->poolPtr->threadCacheSize != 0)
+    {
+        LE_ASSERT(LE_ATOMIC_ADD_FETCH(&(memBlockPtr->refCount), 1, LE_ATOMIC_ORDER_RELAXED) > 1);
+        return;
+    }
+#endif
+
     mem_Lock();
 
     LE_ASSERT(memBlockPtr->refCount != 0);
@@ -287,6 +287,28 @@ le_msg_MessageRef_t le_msg_CreateMsg
     return msgLocal_CreateMsg(sessionRef);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a message to be sent over a given session, with a payload buffer of at least a given
+ * size.
+ *
+ * Local messages all come from the service's message pool, so this is the same as
+ * le_msg_CreateMsg().
+ *
+ * @return  Message reference.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t le_msg_CreateSizedMsg
+(
+    le_msg_SessionRef_t sessionRef, ///< [in] Reference to the session.
+    size_t              payloadSize ///< [in] Largest payload that will be put in the message.
+)
+{
+    LE_UNUSED(payloadSize);
+
+    return msgLocal_CreateMsg(sessionRef);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Adds to the reference count on a message object.
@@ -367,6 +389,23 @@ size_t le_msg_GetMaxPayloadSize
     return msgLocal_GetMaxPayloadSize(msgRef);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the number of payload bytes that are actually in use.
+ *
+ * Local messages are never copied, so this does nothing.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_msg_SetPayloadSize
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t              size        ///< [in] Number of payload bytes in use.
+)
+{
+    LE_UNUSED(msgRef);
+    LE_UNUSED(size);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the file descriptor to be sent with this message.
@@ -9,6 +9,14 @@
  *       processor architectures.  Also, if they try to use a memory address as a Safe Ref,
  *       the memory address is guaranteed to be detected as an invalid Safe Reference.
  *
+ * Each slot has a 32-bit word alongside it, holding the slot's generation number and, while the
+ * slot is free, a link to the next free slot.  The free slots form a stack, so creating a Safe
+ * Reference takes a slot from the top of the stack (or the first slot that has never been used)
+ * rather than searching for one.  Deleting a Safe Reference increments the slot's generation
+ * number, which is mixed into the map base bits of the references made for the slot, so a
+ * reference to a slot that has since been reused is still detected as invalid.  Overflow blocks
+ * are found through a table indexed by block number, so lookups don't walk the block list.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
@@ -36,6 +44,14 @@
 // Offset of index in a safe ref
 #define REF_INDEX_MASK      UINT32_C(0x7FFFFF)
 
+// Bitmask for the generation number in a slot's bookkeeping word
+#define SLOT_GEN_MASK       UINT32_C(0xFF)
+// Offset of the next free slot (index + 1) in a slot's bookkeeping word
+#define SLOT_NEXT_OFFSET    UINT32_C(8)
+
+// Initial number of entries in a map's overflow block table
+#define OVERFLOW_TABLE_INITIAL_SIZE 4
+
 // Buffer length for dumping a safe reference
 #define REF_DBG_BUFFER_LENGTH   64
 
@@ -178,21 +194,45 @@ static inline size_t SlotsInBlock
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Compose a reference index from a block number and a slot number.
+ *  Get a block from its block number.
+ *
+ *  @return The block.
  */
 //--------------------------------------------------------------------------------------------------
-static inline size_t BlockAndSlotToIndex
+static inline struct le_ref_Block *GetBlock
 (
     le_ref_MapRef_t mapRef,     ///< Reference map instance.
-    size_t          blockNum,   ///< Block number.
-    size_t          slotNum     ///< Slot number.
+    size_t          blockNum    ///< Block number.  Must be less than the number of blocks.
 )
 {
     if (blockNum == 0)
     {
-        return slotNum;
+        return mapRef->blocksPtr;
     }
-    return mapRef->maxRefs + (blockNum - 1) * OVERFLOW_BLOCK_SIZE + slotNum;
+    return mapRef->overflowTablePtr[blockNum - 1];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the pointer slot and bookkeeping word for a reference index.
+ *
+ *  @return The pointer slot.
+ */
+//--------------------------------------------------------------------------------------------------
+static void **GetSlot
+(
+    le_ref_MapRef_t   mapRef,   ///< [IN]   Reference map instance.
+    size_t            index,    ///< [IN]   Reference index.  Must be less than the map size.
+    uint32_t        **infoPtr   ///< [OUT]  The slot's bookkeeping word.
+)
+{
+    size_t               blockNum = IndexToBlockNum(mapRef, index);
+    size_t               slot = IndexToSlot(mapRef, index);
+    struct le_ref_Block *block = GetBlock(mapRef, blockNum);
+
+    // The bookkeeping words follow the pointer slots.
+    *infoPtr = (uint32_t *) &block->slots[SlotsInBlock(mapRef, blockNum)] + slot;
+    return &block->slots[slot];
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -237,6 +277,8 @@ static void InitMap
     mapPtr->index = maxRefs;
     mapPtr->maxRefs = maxRefs;
     mapPtr->blocksPtr = initialBlock;
+    mapPtr->overflowTablePtr = NULL;
+    mapPtr->overflowTableSize = 0;
 
     ++RefMapListChangeCount;
     le_dls_Stack(&RefMapList, &mapPtr->entry);
@@ -253,13 +295,14 @@ static void InitMap
 static inline void *MakeRef
 (
     uint32_t    mapBase,    ///< Map's base value.
+    uint32_t    info,       ///< Slot's bookkeeping word (for the generation number).
     size_t      index       ///< Pointer index.
 )
 {
     uintptr_t ref = 0;
 
     ref |= REF_SAFETY_MASK << REF_SAFETY_OFFSET;
-    ref |= (mapBase & REF_BASE_MASK) << REF_BASE_OFFSET;
+    ref |= ((mapBase ^ info) & REF_BASE_MASK) << REF_BASE_OFFSET;
     ref |= (index & REF_INDEX_MASK) << REF_INDEX_OFFSET;
 
     return (void *) ref;
@@ -267,32 +310,27 @@ static inline void *MakeRef
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Decompose a safe reference into the corresponding block index and slot.
+ *  Decompose a safe reference into its index and generation number.
  *
- *  @return Validity of the safe reference.
+ *  @return Validity of the safe reference's format (the generation number is not checked).
  */
 //--------------------------------------------------------------------------------------------------
 static bool ReadRef
 (
     const le_ref_MapRef_t    mapRef,    ///< [IN]   Reference map instance.
     const void              *safeRef,   ///< [IN]   Safe reference to decompose.
-    size_t                  *blockNum,  ///< [OUT]  Block index.
-    size_t                  *slot       ///< [OUT]  Slot number within block.
+    size_t                  *index,     ///< [OUT]  Reference index.
+    uint32_t                *gen        ///< [OUT]  Generation number.
 )
 {
-    size_t      index;
-    uint32_t    base;
     uintptr_t   ref = (uintptr_t) safeRef;
     uintptr_t   safety;
 
     safety = (ref >> REF_SAFETY_OFFSET) & REF_SAFETY_MASK;
-    base = (ref >> REF_BASE_OFFSET) & REF_BASE_MASK;
-    index = (ref >> REF_INDEX_OFFSET) & REF_INDEX_MASK;
+    *gen = (((uint32_t) (ref >> REF_BASE_OFFSET)) ^ mapRef->mapBase) & REF_BASE_MASK;
+    *index = (ref >> REF_INDEX_OFFSET) & REF_INDEX_MASK;
 
-    *blockNum = IndexToBlockNum(mapRef, index);
-    *slot = IndexToSlot(mapRef, index);
-
-    return (safety == REF_SAFETY_MASK && base == mapRef->mapBase && index < mapRef->size);
+    return (safety == REF_SAFETY_MASK && *index < mapRef->size);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -308,27 +346,23 @@ static void **FindSlot
     const void              *safeRef    ///< [IN]   Safe reference.
 )
 {
-    size_t               blockNum;
-    size_t               i;
-    size_t               slot;
-    struct le_ref_Block *block;
+    size_t      index;
+    uint32_t    gen;
+    uint32_t   *info;
+    void      **slot;
 
-    if (!ReadRef(mapRef, safeRef, &blockNum, &slot))
+    if (!ReadRef(mapRef, safeRef, &index, &gen))
     {
         return NULL;
     }
 
-    block = mapRef->blocksPtr;
-    for (i = 1; i <= blockNum; ++i)
+    slot = GetSlot(mapRef, index, &info);
+    if ((*info & SLOT_GEN_MASK) != gen)
     {
-        if (block->nextPtr == NULL)
-        {
-            return NULL;
-        }
-        block = block->nextPtr;
+        return NULL;
     }
 
-    return &block->slots[slot];
+    return slot;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -347,36 +381,56 @@ const char *DebugSafeRef
 )
 {
     bool        valid;
-    size_t      blockNum;
-    size_t      slot;
-    uint32_t    base;
+    size_t      index;
+    uint32_t    gen;
 
-    valid = ReadRef(mapRef, ref, &blockNum, &slot);
-    base = (uint32_t) ((uintptr_t) ref >> REF_BASE_OFFSET) & REF_BASE_MASK;
+    ReadRef(mapRef, ref, &index, &gen);
+    valid = (FindSlot(mapRef, ref) != NULL);
     snprintf(buffer, REF_DBG_BUFFER_LENGTH,
-        "<%p>(Bm:%" PRIX32 " Br:%" PRIX32 " N:%" PRIuS " S:%" PRIuS " V:%c)",
-        ref, mapRef->mapBase, base, blockNum, slot, (valid ? 'T' : 'F'));
+        "<%p>(Bm:%" PRIX32 " G:%" PRIu32 " N:%" PRIuS " S:%" PRIuS " V:%c)",
+        ref, mapRef->mapBase, gen, IndexToBlockNum(mapRef, index), IndexToSlot(mapRef, index),
+        (valid ? 'T' : 'F'));
 
     return buffer;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Allocate a new overflow block.  This occurs if the maxRefs limit is exceeded.
- *
- *  @return The new overflow block.
+ *  Allocate a new overflow block and add it to the end of the map.  This occurs if the maxRefs
+ *  limit is exceeded.
  */
 //--------------------------------------------------------------------------------------------------
-static struct le_ref_Block *NewOverflowBlock
+static void AddOverflowBlock
 (
-    void
+    le_ref_MapRef_t mapRef  ///< Reference map instance.
 )
 {
-    struct le_ref_Block *block = malloc(LE_REF_BLOCK_SIZE(OVERFLOW_BLOCK_SIZE) * sizeof(void *));
+    size_t               blockCount = IndexToBlockNum(mapRef, mapRef->size - 1) + 1;
+    struct le_ref_Block *lastBlock = GetBlock(mapRef, blockCount - 1);
+    struct le_ref_Block *block = calloc(LE_REF_BLOCK_SIZE(OVERFLOW_BLOCK_SIZE), sizeof(void *));
     LE_ASSERT(block != NULL);
 
-    memset(block, 0, LE_REF_BLOCK_SIZE(OVERFLOW_BLOCK_SIZE) * sizeof(void *));
-    return block;
+    // Grow the overflow block table if it's full.
+    if (blockCount > mapRef->overflowTableSize)
+    {
+        size_t newSize = (mapRef->overflowTableSize == 0 ?
+                            OVERFLOW_TABLE_INITIAL_SIZE : mapRef->overflowTableSize * 2);
+
+        mapRef->overflowTablePtr = realloc(mapRef->overflowTablePtr,
+                                           newSize * sizeof(*mapRef->overflowTablePtr));
+        LE_ASSERT(mapRef->overflowTablePtr != NULL);
+        mapRef->overflowTableSize = newSize;
+    }
+
+    lastBlock->nextPtr = block;
+    mapRef->overflowTablePtr[blockCount - 1] = block;
+    mapRef->size += OVERFLOW_BLOCK_SIZE;
+    LE_FATAL_IF(mapRef->size > REF_INDEX_MASK + 1, "Safe reference map %s is full",
+                SAFEREF_NAME(mapRef->name));
+
+    SAFE_REF_TRACE(mapRef, "    Created new overflow block %p", block);
+    LE_WARN("Safe reference map maximum exceeded for %s, new size %" PRIuS,
+            SAFEREF_NAME(mapRef->name), mapRef->size);
 }
 
 
@@ -499,15 +553,12 @@ void *le_ref_CreateRef
 //--------------------------------------------------------------------------------------------------
 {
 #if LE_CONFIG_SAFE_REF_NAMES_ENABLED
-    char                 buffer[REF_DBG_BUFFER_LENGTH];
+    char      buffer[REF_DBG_BUFFER_LENGTH];
 #endif
-    size_t               blockCount = IndexToBlockNum(mapRef, mapRef->size - 1) + 1;
-    size_t               i;
-    size_t               index;
-    size_t               j;
-    size_t               slotCount;
-    struct le_ref_Block *block;
-    void                *result = NULL;
+    size_t    index;
+    uint32_t *info;
+    void    **slot;
+    void     *result = NULL;
 
     SAFE_REF_TRACE(mapRef, "Creating safe reference for %p in %s", ptr, SAFEREF_NAME(mapRef->name));
     if (ptr == NULL)
@@ -515,42 +566,29 @@ void *le_ref_CreateRef
         goto end;
     }
 
-    block = mapRef->blocksPtr;
-    for (i = 0; i < blockCount; ++i)
+    if (mapRef->freeIndex != 0)
     {
-        slotCount = SlotsInBlock(mapRef, i);
-        for (j = 0; j < slotCount; ++j)
-        {
-            if (block->slots[j] == NULL)
-            {
-                index = BlockAndSlotToIndex(mapRef, i, j);
-                block->slots[j] = ptr;
-                SAFE_REF_TRACE(mapRef, "    Inserted %p at %" PRIuS " (%p)", ptr, index,
-                    &block->slots[j]);
-                result = MakeRef(mapRef->mapBase, index);
-                goto end;
-            }
-        }
-
-        if (block->nextPtr == NULL)
+        // Reuse the most recently freed slot.
+        index = mapRef->freeIndex - 1;
+        slot = GetSlot(mapRef, index, &info);
+        mapRef->freeIndex = *info >> SLOT_NEXT_OFFSET;
+        *info &= SLOT_GEN_MASK;
+    }
+    else
+    {
+        // Use the first slot that has never been used, making room for it if need be.
+        if (mapRef->usedCount == mapRef->size)
         {
-            break;
+            AddOverflowBlock(mapRef);
+            mapRef->index = mapRef->size;
         }
-        block = block->nextPtr;
+        index = mapRef->usedCount++;
+        slot = GetSlot(mapRef, index, &info);
     }
 
-    index = BlockAndSlotToIndex(mapRef, blockCount, 0);
-    block->nextPtr = NewOverflowBlock();
-    block = block->nextPtr;
-    SAFE_REF_TRACE(mapRef, "    Created new overflow block %p", block);
-
-    block->slots[0] = ptr;
-    SAFE_REF_TRACE(mapRef, "    Inserted %p at %" PRIuS " (%p)", ptr, index, &block->slots[0]);
-    result = MakeRef(mapRef->mapBase, index);
-    mapRef->size += OVERFLOW_BLOCK_SIZE;
-    LE_WARN("Safe reference map maximum exceeded for %s, new size %" PRIuS,
-            SAFEREF_NAME(mapRef->name), mapRef->size);
-    mapRef->index = mapRef->size;
+    *slot = ptr;
+    SAFE_REF_TRACE(mapRef, "    Inserted %p at %" PRIuS " (%p)", ptr, index, slot);
+    result = MakeRef(mapRef->mapBase, *info, index);
 
 end:
     SAFE_REF_TRACE(mapRef, "    Resulting safe reference is %s",
@@ -594,6 +632,9 @@ void le_ref_DeleteRef
 #if LE_CONFIG_SAFE_REF_NAMES_ENABLED
     char      buffer[REF_DBG_BUFFER_LENGTH];
 #endif
+    size_t    index;
+    uint32_t  gen;
+    uint32_t *info;
     void    **slot;
 
     SAFE_REF_TRACE(mapRef, "Deleting safe reference %s in %s",
@@ -607,6 +648,12 @@ void le_ref_DeleteRef
     }
     else
     {
+        // Invalidate all outstanding references to the slot by moving it on to the next
+        // generation, then push it onto the free list.
+        ReadRef(mapRef, safeRef, &index, &gen);
+        GetSlot(mapRef, index, &info);
+        *info = ((gen + 1) & SLOT_GEN_MASK) | ((uint32_t) mapRef->freeIndex << SLOT_NEXT_OFFSET);
+        mapRef->freeIndex = index + 1;
         *slot = NULL;
     }
 }
@@ -650,6 +697,7 @@ le_result_t le_ref_NextNode
 )
 {
     le_ref_MapRef_t   mapRef = (le_ref_MapRef_t) iteratorRef;
+    uint32_t         *info;
     void            **slot;
 
     SAFE_REF_TRACE(mapRef, "Continuing iteration in %s", SAFEREF_NAME(mapRef->name));
@@ -667,8 +715,8 @@ le_result_t le_ref_NextNode
 
     while (mapRef->index < mapRef->size)
     {
-        slot = FindSlot(mapRef, MakeRef(mapRef->mapBase, mapRef->index));
-        if (slot != NULL && *slot != NULL)
+        slot = GetSlot(mapRef, mapRef->index, &info);
+        if (*slot != NULL)
         {
             SAFE_REF_TRACE(mapRef, "    Found next item at index %" PRIuS, mapRef->index);
             mapRef->advance = true;
@@ -702,10 +750,12 @@ const void* le_ref_GetSafeRef
 )
 {
     le_ref_MapRef_t mapRef = (le_ref_MapRef_t) iteratorRef;
+    uint32_t       *info;
 
     if (mapRef->index < mapRef->size)
     {
-        return MakeRef(mapRef->mapBase, mapRef->index);
+        GetSlot(mapRef, mapRef->index, &info);
+        return MakeRef(mapRef->mapBase, *info, mapRef->index);
     }
 
     return NULL;
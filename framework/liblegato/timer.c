@@ -117,7 +117,13 @@ static Timer_t* CreateTimer
     timerPtr->interval = (le_clk_Time_t){0, 0};
     timerPtr->repeatCount = 1;
     timerPtr->contextPtr = NULL;
+    timerPtr->slack = (le_clk_Time_t){0, 0};
     timerPtr->link = LE_DLS_LINK_INIT;
+    timerPtr->heapChildPtr = NULL;
+    timerPtr->heapNextPtr = NULL;
+    timerPtr->heapPrevPtr = NULL;
+    timerPtr->deadline = (le_clk_Time_t){0, 0};
+    timerPtr->heapSeq = 0;
     timerPtr->isActive = false;
     timerPtr->expiryTime = (le_clk_Time_t){0, 0};
     timerPtr->expiryCount = 0;
@@ -134,53 +140,204 @@ static Timer_t* CreateTimer
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add the timer record to the given list, sorted according to the timer value
+ * Check whether one timer should expire before another in the timer heap.
+ *
+ * Timers are ordered by deadline.  Timers with equal deadlines are ordered by the sequence in
+ * which they were started, so that they expire in first-in first-out order.
+ *
+ * @return true if timer A should expire before timer B.
  */
 //--------------------------------------------------------------------------------------------------
-static void AddToTimerList
+static inline bool TimerBefore
 (
-    le_dls_List_t* listPtr,               ///< [IN] The list to add to.
-    Timer_t* newTimerPtr                  ///< [IN] The timer to add
+    const Timer_t* aPtr,                ///< [IN] Timer A
+    const Timer_t* bPtr                 ///< [IN] Timer B
 )
 {
-    Timer_t* timerPtr;
-    le_dls_Link_t* linkPtr;
+    if (le_clk_Equal(aPtr->deadline, bPtr->deadline))
+    {
+        return ((int32_t)(aPtr->heapSeq - bPtr->heapSeq) < 0);
+    }
+    return le_clk_GreaterThan(bPtr->deadline, aPtr->deadline);
+}
 
-    if ( newTimerPtr->isActive )
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Meld two timer heaps together.
+ *
+ * Both heaps must be detached (root sibling pointers unused).
+ *
+ * @return Root of the combined heap.
+ */
+//--------------------------------------------------------------------------------------------------
+static Timer_t* HeapMeld
+(
+    Timer_t* aPtr,                      ///< [IN] Root of the first heap (may be NULL)
+    Timer_t* bPtr                       ///< [IN] Root of the second heap (may be NULL)
+)
+{
+    if (aPtr == NULL)
     {
-        LE_ERROR("Timer '%s' is already active", TIMER_NAME(newTimerPtr->name));
-        return;
+        return bPtr;
+    }
+    if (bPtr == NULL)
+    {
+        return aPtr;
     }
 
-    // Get the start of the list
-    linkPtr = le_dls_Peek(listPtr);
+    if (TimerBefore(bPtr, aPtr))
+    {
+        Timer_t* tmpPtr = aPtr;
+        aPtr = bPtr;
+        bPtr = tmpPtr;
+    }
 
-    // Find the timer whose expiry time is greater than the new timer.
-    while ( linkPtr != NULL )
+    // Make B the first child of A.
+    bPtr->heapPrevPtr = aPtr;
+    bPtr->heapNextPtr = aPtr->heapChildPtr;
+    if (bPtr->heapNextPtr != NULL)
     {
-        timerPtr = CONTAINER_OF(linkPtr, Timer_t, link);
+        bPtr->heapNextPtr->heapPrevPtr = bPtr;
+    }
+    aPtr->heapChildPtr = bPtr;
+
+    aPtr->heapNextPtr = NULL;
+    aPtr->heapPrevPtr = NULL;
+
+    return aPtr;
+}
 
-        if ( le_clk_GreaterThan(timerPtr->expiryTime, newTimerPtr->expiryTime) )
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Combine a list of sibling sub-heaps into a single heap, using the standard two-pass pairing.
+ *
+ * @return Root of the combined heap, or NULL if the list was empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static Timer_t* HeapMergePairs
+(
+    Timer_t* firstPtr                   ///< [IN] First sub-heap in the sibling list
+)
+{
+    Timer_t* pairsPtr = NULL;
+
+    // First pass: meld siblings in pairs, left to right, pushing each result onto a stack that
+    // is linked through heapNextPtr.
+    while (firstPtr != NULL)
+    {
+        Timer_t* secondPtr = firstPtr->heapNextPtr;
+        Timer_t* restPtr = NULL;
+
+        if (secondPtr != NULL)
         {
-            break;
+            restPtr = secondPtr->heapNextPtr;
         }
 
-        linkPtr = le_dls_PeekNext(listPtr, linkPtr);
+        Timer_t* pairPtr = HeapMeld(firstPtr, secondPtr);
+        if (secondPtr == NULL)
+        {
+            pairPtr->heapNextPtr = NULL;
+            pairPtr->heapPrevPtr = NULL;
+        }
+        pairPtr->heapNextPtr = pairsPtr;
+        pairsPtr = pairPtr;
+
+        firstPtr = restPtr;
     }
 
-    TimerListChangeCount++;
-    if (linkPtr == NULL)
+    // Second pass: meld the pairs together, right to left.
+    Timer_t* rootPtr = NULL;
+    while (pairsPtr != NULL)
+    {
+        Timer_t* nextPtr = pairsPtr->heapNextPtr;
+
+        pairsPtr->heapNextPtr = NULL;
+        rootPtr = HeapMeld(rootPtr, pairsPtr);
+
+        pairsPtr = nextPtr;
+    }
+
+    return rootPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a timer from the timer heap.
+ */
+//--------------------------------------------------------------------------------------------------
+static void HeapRemove
+(
+    timer_ThreadRec_t* threadRecPtr,    ///< [IN] Thread timer record holding the heap
+    Timer_t* timerPtr                   ///< [IN] The timer to remove
+)
+{
+    Timer_t* childrenPtr = HeapMergePairs(timerPtr->heapChildPtr);
+
+    if (timerPtr == threadRecPtr->heapRootPtr)
     {
-        // The list is either empty, or the new timer has the largest expiry time.
-        // In either case, add the new timer to the end of the list.
-        le_dls_Queue(listPtr, &newTimerPtr->link);
+        threadRecPtr->heapRootPtr = childrenPtr;
     }
     else
     {
-        // Found a timer with larger expiry time; insert the new timer before it.
-        le_dls_AddBefore(listPtr, linkPtr, &newTimerPtr->link);
+        // Unlink the sub-heap rooted at this timer from its parent or previous sibling, then
+        // meld its children back into the heap.
+        Timer_t* prevPtr = timerPtr->heapPrevPtr;
+
+        if (prevPtr->heapChildPtr == timerPtr)
+        {
+            prevPtr->heapChildPtr = timerPtr->heapNextPtr;
+        }
+        else
+        {
+            prevPtr->heapNextPtr = timerPtr->heapNextPtr;
+        }
+        if (timerPtr->heapNextPtr != NULL)
+        {
+            timerPtr->heapNextPtr->heapPrevPtr = prevPtr;
+        }
+
+        threadRecPtr->heapRootPtr = HeapMeld(threadRecPtr->heapRootPtr, childrenPtr);
+    }
+
+    timerPtr->heapChildPtr = NULL;
+    timerPtr->heapNextPtr = NULL;
+    timerPtr->heapPrevPtr = NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the timer record to the given thread's active timers.
+ *
+ * The timer is put on the active timer list and inserted in the timer heap, keyed on its deadline
+ * (expiry time plus slack).
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToTimerList
+(
+    timer_ThreadRec_t* threadRecPtr,    ///< [IN] Thread timer record to add to.
+    Timer_t* newTimerPtr                ///< [IN] The timer to add
+)
+{
+    if ( newTimerPtr->isActive )
+    {
+        LE_ERROR("Timer '%s' is already active", TIMER_NAME(newTimerPtr->name));
+        return;
     }
 
+    TimerListChangeCount++;
+    le_dls_Queue(&threadRecPtr->activeTimerList, &newTimerPtr->link);
+
+    newTimerPtr->deadline = le_clk_Add(newTimerPtr->expiryTime, newTimerPtr->slack);
+    newTimerPtr->heapSeq = threadRecPtr->heapSeq++;
+    newTimerPtr->heapChildPtr = NULL;
+    newTimerPtr->heapNextPtr = NULL;
+    newTimerPtr->heapPrevPtr = NULL;
+    threadRecPtr->heapRootPtr = HeapMeld(threadRecPtr->heapRootPtr, newTimerPtr);
+
     // The new timer is now on the active list
     newTimerPtr->isActive = true;
 }
@@ -188,69 +345,59 @@ static void AddToTimerList
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Peek at the first timer from the given timer list
+ * Peek at the first timer to expire from the given thread's active timers
  *
  * @return:
- *      - pointer to the first timer on the list
- *      - NULL if the list is empty
+ *      - pointer to the first timer to expire
+ *      - NULL if there are no active timers
  */
 //--------------------------------------------------------------------------------------------------
-static Timer_t* PeekFromTimerList
+static inline Timer_t* PeekFromTimerList
 (
-    le_dls_List_t* listPtr              ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] Thread timer record to look at.
 )
 {
-    le_dls_Link_t* linkPtr;
-
-    linkPtr = le_dls_Peek(listPtr);
-    if (linkPtr != NULL)
-    {
-        return ( CONTAINER_OF(linkPtr, Timer_t, link) );
-    }
-    return NULL;
+    return threadRecPtr->heapRootPtr;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Pop the first timer from the given timer list
+ * Pop the first timer to expire from the given thread's active timers
  *
  * @return:
- *      - pointer to the first timer on the list
- *      - NULL if the list is empty
+ *      - pointer to the first timer to expire
+ *      - NULL if there are no active timers
  */
 //--------------------------------------------------------------------------------------------------
 static Timer_t* PopFromTimerList
 (
-    le_dls_List_t* listPtr              ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] Thread timer record to look at.
 )
 {
-    le_dls_Link_t* linkPtr;
-    Timer_t* timerPtr;
+    Timer_t* timerPtr = threadRecPtr->heapRootPtr;
 
-    linkPtr = le_dls_Pop(listPtr);
-    if (linkPtr != NULL)
+    if (timerPtr != NULL)
     {
         TimerListChangeCount++;
-        timerPtr = CONTAINER_OF(linkPtr, Timer_t, link);
+        HeapRemove(threadRecPtr, timerPtr);
+        le_dls_Remove(&threadRecPtr->activeTimerList, &timerPtr->link);
 
         // The timer is no longer on the active list
         timerPtr->isActive = false;
-
-        return timerPtr;
     }
-    return NULL;
+    return timerPtr;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Remove the timer from the given timer list
+ * Remove the timer from the given thread's active timers
  */
 //--------------------------------------------------------------------------------------------------
 static void RemoveFromTimerList
 (
-    le_dls_List_t* listPtr,             ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr,    ///< [IN] Thread timer record to look at.
     Timer_t* timerPtr                   ///< [IN] The timer to remove
 )
 {
@@ -263,7 +410,8 @@ static void RemoveFromTimerList
     // Remove the timer from the active list
     timerPtr->isActive = false;
     TimerListChangeCount++;
-    le_dls_Remove(listPtr, &timerPtr->link);
+    HeapRemove(threadRecPtr, timerPtr);
+    le_dls_Remove(&threadRecPtr->activeTimerList, &timerPtr->link);
 }
 
 
@@ -281,11 +429,12 @@ static void RestartTimerPhys
 
     struct itimerspec timerInterval;
 
-    // Set the timer to expire at the expiry time of the given timer
+    // Set the timer to expire at the deadline of the given timer.  Any other timer whose expiry
+    // time has been reached by then is processed on the same wakeup.
     // There is a small possibility that the time set now will be slightly in the past
     // at this point but it will just cause the timerfd to expire immediately.
-    timerInterval.it_value.tv_sec = timerPtr->expiryTime.sec;
-    timerInterval.it_value.tv_nsec = timerPtr->expiryTime.usec * 1000;
+    timerInterval.it_value.tv_sec = timerPtr->deadline.sec;
+    timerInterval.it_value.tv_nsec = timerPtr->deadline.usec * 1000;
 
     // The timer does not repeat
     timerInterval.it_interval.tv_sec = 0;
@@ -332,11 +481,11 @@ static void RunTimer
 
     Timer_t* firstTimerPtr;
 
-    AddToTimerList(&threadRecPtr->activeTimerList, timerPtr);
+    AddToTimerList(threadRecPtr, timerPtr);
 
     // Get the first timer from the active list. This is needed to determine whether the timer
     // needs to be restarted, in case the new timer was put at the beginning of the list.
-    firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+    firstTimerPtr = PeekFromTimerList(threadRecPtr);
 
     // If the timer is not running, or it is running a timer that is no longer at the beginning
     // of the active list, then (re)start the timer.
@@ -361,7 +510,7 @@ static void StopTimer
 {
     timer_ThreadRec_t* threadRecPtr = fa_timer_GetThreadTimerRec(timerPtr);
 
-    RemoveFromTimerList(&threadRecPtr->activeTimerList, timerPtr);
+    RemoveFromTimerList(threadRecPtr, timerPtr);
 
     // If the timer was at the start of the active list, then restart the timerFD using the next
     // timer on the active list, if any.  Otherwise, stop the timerFD.
@@ -370,7 +519,7 @@ static void StopTimer
         TRACE("Stopping the first active timer");
         threadRecPtr->firstTimerPtr = NULL;
 
-        Timer_t* firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+        Timer_t* firstTimerPtr = PeekFromTimerList(threadRecPtr);
         if (firstTimerPtr != NULL)
         {
             RestartTimerPhys(firstTimerPtr);
@@ -414,7 +563,7 @@ static void ProcessExpiredTimer
         expiredTimer->expiryTime = le_clk_Add(expiredTimer->expiryTime, expiredTimer->interval);
 
         // Add the timer back to the timer list
-        AddToTimerList(&threadRecPtr->activeTimerList, expiredTimer);
+        AddToTimerList(threadRecPtr, expiredTimer);
         //PrintTimerList(&threadRecPtr->activeTimerList);
     }
 
@@ -462,7 +611,7 @@ void timer_Handler
     Timer_t* firstTimerPtr;
 
     // Pop off the first timer from the active list, and make sure it is the expected timer.
-    firstTimerPtr = PopFromTimerList(&threadRecPtr->activeTimerList);
+    firstTimerPtr = PopFromTimerList(threadRecPtr);
     LE_ASSERT( NULL != firstTimerPtr);
 
     LE_ASSERT( threadRecPtr->firstTimerPtr == firstTimerPtr );
@@ -477,17 +626,17 @@ void timer_Handler
 
     // Check if there are any other timers that have since expired, pop them off the
     // list and process them.
-    firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+    firstTimerPtr = PeekFromTimerList(threadRecPtr);
     while ( firstTimerPtr != NULL &&
             le_clk_GreaterThan(clk_GetRelativeTime(firstTimerPtr->isWakeupEnabled),
                                firstTimerPtr->expiryTime) )
     {
         // Pop off the timer and process it
-        firstTimerPtr = PopFromTimerList(&threadRecPtr->activeTimerList);
+        firstTimerPtr = PopFromTimerList(threadRecPtr);
         ProcessExpiredTimer(firstTimerPtr);
 
         // Try the next timer on the list
-        firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+        firstTimerPtr = PeekFromTimerList(threadRecPtr);
     }
 
     // While processing expired timers in the above loop, it is possible that a timer was started,
@@ -575,6 +724,8 @@ timer_ThreadRec_t *timer_InitThread
     threadRecPtr = fa_timer_InitThread(timerType, threadPtr);
 
     threadRecPtr->activeTimerList = LE_DLS_LIST_INIT;
+    threadRecPtr->heapRootPtr = NULL;
+    threadRecPtr->heapSeq = 0;
     threadRecPtr->firstTimerPtr = NULL;
 
     return threadRecPtr;
@@ -628,6 +779,7 @@ void timer_DestructThread
 
             le_mem_Release(timerPtr);
         }
+        threadRecPtr->heapRootPtr = NULL;
         fa_timer_DestructThread(threadRecPtr);
     }
 }
@@ -930,6 +1082,72 @@ le_result_t le_timer_SetWakeup
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timer slack
+ *
+ * The slack is how much later than its expiry time the timer may be delivered.  The timer module
+ * uses it to expire timers whose deadlines are close together on a single wakeup, instead of
+ * waking up the thread (and possibly the system) once for each of them.  The default slack is
+ * zero, so that the timer is delivered as close to its expiry time as possible.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BUSY if the timer is currently running
+ *
+ * @note
+ *      If an invalid timer object is given, the process exits
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_timer_SetSlack
+(
+    le_timer_Ref_t timerRef,     ///< [IN] Set slack for this timer object
+    le_clk_Time_t slack          ///< [IN] Maximum expiry delay allowed for coalescing
+)
+{
+    Timer_t* timerPtr = GetTimer(timerRef);
+    LE_FATAL_IF(NULL == timerPtr, "Invalid timer reference %p.", timerRef);
+
+    if ( timerPtr->isActive )
+    {
+        return LE_BUSY;
+    }
+
+    timerPtr->slack = slack;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timer slack using milliseconds.
+ *
+ * See le_timer_SetSlack() for details.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BUSY if the timer is currently running
+ *
+ * @note
+ *      If an invalid timer object is given, the process exits
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_timer_SetMsSlack
+(
+    le_timer_Ref_t timerRef,     ///< [IN] Set slack for this timer object
+    uint32_t slack               ///< [IN] Maximum expiry delay allowed for coalescing, in ms
+)
+{
+    time_t seconds = slack / 1000;
+    le_clk_Time_t timeStruct;
+    timeStruct.sec = seconds;
+    timeStruct.usec = (slack - (seconds * 1000)) * 1000;
+
+    return le_timer_SetSlack(timerRef, timeStruct);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set context pointer for the timer
@@ -0,0 +1,233 @@
+/**
+ * Test of the le_cbor batch array functions' handling of bad input: reserved additional
+ * information values, arrays longer than the output, values too big for the output type and
+ * arrays mixing float precisions must all be rejected, leaving the buffer pointer where it was.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+/// Size of the buffers used for encoding.
+#define BUFFER_SIZE     64
+
+/// Initial bytes of the float items (major type 7) of each precision.
+#define HALF_FLOAT_INITIAL      0xF9
+#define FLOAT_INITIAL           0xFA
+#define DOUBLE_INITIAL          0xFB
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the reserved additional information values (28 to 30) are rejected, whether in an
+ * integer item or an array header.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestReservedAdditionalInfo
+(
+    void
+)
+{
+    uint8_t buffer[BUFFER_SIZE] = { 0 };
+    uint8_t values[1];
+    uint8_t* bufPtr;
+    int64_t value;
+    ssize_t additionalBytes;
+    size_t count;
+    uint8_t additional;
+
+    for (additional = 28; additional <= 30; additional++)
+    {
+        // Major type 0: unsigned integer.
+        buffer[0] = additional;
+        LE_TEST_OK(le_cbor_GetType(buffer, &additionalBytes) == LE_CBOR_TYPE_INVALID_TYPE,
+                   "Integer with additional info %u has an invalid type", additional);
+
+        bufPtr = buffer;
+        LE_TEST_OK(!le_cbor_DecodeInteger(&bufPtr, &value) && bufPtr == buffer,
+                   "Integer with additional info %u is rejected", additional);
+
+        // Major type 4: array.
+        buffer[0] = 0x80 | additional;
+        bufPtr = buffer;
+        LE_TEST_OK(!le_cbor_DecodeUint8Array(&bufPtr, values, &count, NUM_ARRAY_MEMBERS(values)) &&
+                   bufPtr == buffer,
+                   "Array header with additional info %u is rejected", additional);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that an array with more values than the output can hold is rejected.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestCountOverMax
+(
+    void
+)
+{
+    const uint16_t values[] = { 1, 300, 65535 };
+    uint16_t decoded[NUM_ARRAY_MEMBERS(values)];
+    uint8_t buffer[BUFFER_SIZE];
+    uint8_t* bufPtr = buffer;
+    size_t len = sizeof(buffer);
+    size_t count = 0;
+
+    LE_TEST_ASSERT(le_cbor_EncodeUint16Array(&bufPtr, &len, values, NUM_ARRAY_MEMBERS(values)),
+                   "Encode uint16 array");
+
+    bufPtr = buffer;
+    LE_TEST_OK(!le_cbor_DecodeUint16Array(&bufPtr, decoded, &count,
+                                          NUM_ARRAY_MEMBERS(values) - 1) && bufPtr == buffer,
+               "Array longer than maxCount is rejected");
+
+    bufPtr = buffer;
+    LE_TEST_OK(!le_cbor_DecodeUint16Array(&bufPtr, NULL, &count, 0) && bufPtr == buffer,
+               "Non-empty array is rejected with maxCount 0");
+
+    bufPtr = buffer;
+    LE_TEST_OK(le_cbor_DecodeUint16Array(&bufPtr, decoded, &count, NUM_ARRAY_MEMBERS(values)) &&
+               count == NUM_ARRAY_MEMBERS(values) &&
+               memcmp(decoded, values, sizeof(values)) == 0 &&
+               bufPtr == buffer + sizeof(buffer) - len,
+               "Array of exactly maxCount is decoded");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that an array holding a value too big for the output type is rejected, and that the
+ * largest value that fits is not.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestElementOverflow
+(
+    void
+)
+{
+    const uint16_t values16[] = { 1, 255, 256 };
+    const uint64_t values64[] = { 0, UINT32_MAX, (uint64_t)UINT32_MAX + 1 };
+    uint8_t decoded8[NUM_ARRAY_MEMBERS(values16)];
+    uint32_t decoded32[NUM_ARRAY_MEMBERS(values64)];
+    uint8_t buffer[BUFFER_SIZE];
+    uint8_t* bufPtr;
+    size_t len;
+    size_t count;
+
+    bufPtr = buffer;
+    len = sizeof(buffer);
+    LE_TEST_ASSERT(le_cbor_EncodeUint16Array(&bufPtr, &len, values16,
+                                             NUM_ARRAY_MEMBERS(values16)),
+                   "Encode uint16 array");
+
+    bufPtr = buffer;
+    LE_TEST_OK(!le_cbor_DecodeUint8Array(&bufPtr, decoded8, &count,
+                                         NUM_ARRAY_MEMBERS(decoded8)) && bufPtr == buffer,
+               "256 is rejected as a uint8");
+
+    bufPtr = buffer;
+    len = sizeof(buffer);
+    LE_TEST_ASSERT(le_cbor_EncodeUint16Array(&bufPtr, &len, values16,
+                                             NUM_ARRAY_MEMBERS(values16) - 1),
+                   "Encode uint16 array");
+
+    bufPtr = buffer;
+    LE_TEST_OK(le_cbor_DecodeUint8Array(&bufPtr, decoded8, &count, NUM_ARRAY_MEMBERS(decoded8)) &&
+               count == 2 && decoded8[1] == UINT8_MAX,
+               "255 is decoded as a uint8");
+
+    bufPtr = buffer;
+    len = sizeof(buffer);
+    LE_TEST_ASSERT(le_cbor_EncodeUint64Array(&bufPtr, &len, values64,
+                                             NUM_ARRAY_MEMBERS(values64)),
+                   "Encode uint64 array");
+
+    bufPtr = buffer;
+    LE_TEST_OK(!le_cbor_DecodeUint32Array(&bufPtr, decoded32, &count,
+                                          NUM_ARRAY_MEMBERS(decoded32)) && bufPtr == buffer,
+               "UINT32_MAX + 1 is rejected as a uint32");
+
+    bufPtr = buffer;
+    len = sizeof(buffer);
+    LE_TEST_ASSERT(le_cbor_EncodeUint64Array(&bufPtr, &len, values64,
+                                             NUM_ARRAY_MEMBERS(values64) - 1),
+                   "Encode uint64 array");
+
+    bufPtr = buffer;
+    LE_TEST_OK(le_cbor_DecodeUint32Array(&bufPtr, decoded32, &count,
+                                         NUM_ARRAY_MEMBERS(decoded32)) &&
+               count == 2 && decoded32[1] == UINT32_MAX,
+               "UINT32_MAX is decoded as a uint32");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that an array mixing float precisions is rejected by both the float and double array
+ * decoders.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestMixedFloatPrecision
+(
+    void
+)
+{
+    const float values[] = { 1.5f, -2.25f };
+    float decodedFloats[3];
+    double decodedDoubles[3];
+    uint8_t buffer[BUFFER_SIZE];
+    uint8_t* bufPtr;
+    size_t len;
+    size_t count;
+    size_t halfOffset;
+
+    // Two single precision floats followed by a half precision 1.0.
+    bufPtr = buffer;
+    len = sizeof(buffer);
+    LE_TEST_ASSERT(le_cbor_EncodeFloatArray(&bufPtr, &len, values, NUM_ARRAY_MEMBERS(values)),
+                   "Encode float array");
+    buffer[0]++;
+    halfOffset = bufPtr - buffer;
+    buffer[halfOffset] = HALF_FLOAT_INITIAL;
+    buffer[halfOffset + 1] = 0x3C;
+    buffer[halfOffset + 2] = 0x00;
+
+    bufPtr = buffer;
+    LE_TEST_OK(!le_cbor_DecodeFloatArray(&bufPtr, decodedFloats, &count,
+                                         NUM_ARRAY_MEMBERS(decodedFloats)) && bufPtr == buffer,
+               "Float array holding a half float is rejected");
+
+    // The same with the half float replaced by a double.
+    bufPtr = buffer + halfOffset;
+    len = sizeof(buffer) - halfOffset;
+    LE_TEST_ASSERT(le_cbor_EncodeDouble(&bufPtr, &len, 1.0), "Encode double");
+    LE_TEST_ASSERT(buffer[halfOffset] == DOUBLE_INITIAL, "Double encoded in double precision");
+
+    bufPtr = buffer;
+    LE_TEST_OK(!le_cbor_DecodeFloatArray(&bufPtr, decodedFloats, &count,
+                                         NUM_ARRAY_MEMBERS(decodedFloats)) && bufPtr == buffer,
+               "Float array holding a double is rejected");
+
+    // A double followed by a single precision float.
+    bufPtr = buffer;
+    len = sizeof(buffer);
+    LE_TEST_ASSERT(le_cbor_EncodeArrayHeader(&bufPtr, &len, 2) &&
+                   le_cbor_EncodeDouble(&bufPtr, &len, 1.0),
+                   "Encode array header and double");
+    bufPtr[0] = FLOAT_INITIAL;
+    memset(bufPtr + 1, 0, sizeof(float));
+
+    bufPtr = buffer;
+    LE_TEST_OK(!le_cbor_DecodeDoubleArray(&bufPtr, decodedDoubles, &count,
+                                          NUM_ARRAY_MEMBERS(decodedDoubles)) && bufPtr == buffer,
+               "Double array holding a float is rejected");
+}
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    TestReservedAdditionalInfo();
+    TestCountOverMax();
+    TestElementOverflow();
+    TestMixedFloatPrecision();
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,451 @@
+/**
+ * This module is a microbenchmark for the le_cbor encoder and decoder.  It measures the throughput
+ * (in MB/s of encoded CBOR) of encoding and decoding arrays the way the RPC Proxy's generated code
+ * does, one item at a time, against the batch array functions, and checks that both produce and
+ * accept the same bytes.  It also measures how fast a typical proxied call message can be walked
+ * item by item.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "timing.h"
+
+/// Number of times each array is encoded and decoded.
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_ITERATIONS   100
+#else
+#   define NUM_ITERATIONS   10000
+#endif
+
+/// Number of values in each array.
+#define NUM_VALUES          256
+
+/// Size of the encoding buffers; enough for any array of NUM_VALUES values.
+#define BUFFER_SIZE         (LE_CBOR_ARRAY_HEADER_MAX_SIZE + NUM_VALUES * LE_CBOR_UINT64_MAX_SIZE)
+
+/// Types of array measured.
+typedef enum
+{
+    ARRAY_UINT8,
+    ARRAY_UINT16,
+    ARRAY_UINT32,
+    ARRAY_DOUBLE
+}
+ArrayType_t;
+
+/// Values to encode.
+static union
+{
+    uint8_t     u8[NUM_VALUES];
+    uint16_t    u16[NUM_VALUES];
+    uint32_t    u32[NUM_VALUES];
+    double      d[NUM_VALUES];
+}
+Values;
+
+/// Values decoded.
+static union
+{
+    uint8_t     u8[NUM_VALUES];
+    uint16_t    u16[NUM_VALUES];
+    uint32_t    u32[NUM_VALUES];
+    double      d[NUM_VALUES];
+}
+Decoded;
+
+/// Output of the item by item encoder.
+static uint8_t ItemBuffer[BUFFER_SIZE];
+
+/// Output of the batch encoder.
+static uint8_t BatchBuffer[BUFFER_SIZE];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode the test values one item at a time.
+ *
+ * @return Number of bytes encoded.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t EncodeItems
+(
+    ArrayType_t type    ///< [IN] Type of the values.
+)
+{
+    uint8_t* bufPtr = ItemBuffer;
+    size_t bufLen = sizeof(ItemBuffer);
+    bool ok = le_cbor_EncodeArrayHeader(&bufPtr, &bufLen, NUM_VALUES);
+    int i;
+
+    for (i = 0; ok && (i < NUM_VALUES); i++)
+    {
+        switch (type)
+        {
+            case ARRAY_UINT8:
+                ok = le_cbor_EncodePositiveInteger(&bufPtr, &bufLen, Values.u8[i]);
+                break;
+            case ARRAY_UINT16:
+                ok = le_cbor_EncodePositiveInteger(&bufPtr, &bufLen, Values.u16[i]);
+                break;
+            case ARRAY_UINT32:
+                ok = le_cbor_EncodePositiveInteger(&bufPtr, &bufLen, Values.u32[i]);
+                break;
+            case ARRAY_DOUBLE:
+                ok = le_cbor_EncodeDouble(&bufPtr, &bufLen, Values.d[i]);
+                break;
+        }
+    }
+
+    LE_FATAL_IF(!ok, "Item encoding failed");
+    return bufPtr - ItemBuffer;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode the test values with one batch call.
+ *
+ * @return Number of bytes encoded.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t EncodeBatch
+(
+    ArrayType_t type    ///< [IN] Type of the values.
+)
+{
+    uint8_t* bufPtr = BatchBuffer;
+    size_t bufLen = sizeof(BatchBuffer);
+    bool ok = false;
+
+    switch (type)
+    {
+        case ARRAY_UINT8:
+            ok = le_cbor_EncodeUint8Array(&bufPtr, &bufLen, Values.u8, NUM_VALUES);
+            break;
+        case ARRAY_UINT16:
+            ok = le_cbor_EncodeUint16Array(&bufPtr, &bufLen, Values.u16, NUM_VALUES);
+            break;
+        case ARRAY_UINT32:
+            ok = le_cbor_EncodeUint32Array(&bufPtr, &bufLen, Values.u32, NUM_VALUES);
+            break;
+        case ARRAY_DOUBLE:
+            ok = le_cbor_EncodeDoubleArray(&bufPtr, &bufLen, Values.d, NUM_VALUES);
+            break;
+    }
+
+    LE_FATAL_IF(!ok, "Batch encoding failed");
+    return bufPtr - BatchBuffer;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array one item at a time.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DecodeItems
+(
+    ArrayType_t type,       ///< [IN] Type of the values.
+    const uint8_t* bufPtr   ///< [IN] Encoded array.
+)
+{
+    uint8_t* itemPtr = (uint8_t*)bufPtr;
+    size_t count = 0;
+    bool ok = le_cbor_DecodeArrayHeader(&itemPtr, &count) && (count == NUM_VALUES);
+    size_t i;
+
+    for (i = 0; ok && (i < count); i++)
+    {
+        switch (type)
+        {
+            case ARRAY_UINT8:
+                ok = le_cbor_DecodeUint8(&itemPtr, &Decoded.u8[i]);
+                break;
+            case ARRAY_UINT16:
+                ok = le_cbor_DecodeUint16(&itemPtr, &Decoded.u16[i]);
+                break;
+            case ARRAY_UINT32:
+                ok = le_cbor_DecodeUint32(&itemPtr, &Decoded.u32[i]);
+                break;
+            case ARRAY_DOUBLE:
+                ok = le_cbor_DecodeDouble(&itemPtr, &Decoded.d[i]);
+                break;
+        }
+    }
+
+    LE_FATAL_IF(!ok, "Item decoding failed");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode an array with one batch call.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DecodeBatch
+(
+    ArrayType_t type,       ///< [IN] Type of the values.
+    const uint8_t* bufPtr   ///< [IN] Encoded array.
+)
+{
+    uint8_t* itemPtr = (uint8_t*)bufPtr;
+    size_t count = 0;
+    bool ok = false;
+
+    switch (type)
+    {
+        case ARRAY_UINT8:
+            ok = le_cbor_DecodeUint8Array(&itemPtr, Decoded.u8, &count, NUM_VALUES);
+            break;
+        case ARRAY_UINT16:
+            ok = le_cbor_DecodeUint16Array(&itemPtr, Decoded.u16, &count, NUM_VALUES);
+            break;
+        case ARRAY_UINT32:
+            ok = le_cbor_DecodeUint32Array(&itemPtr, Decoded.u32, &count, NUM_VALUES);
+            break;
+        case ARRAY_DOUBLE:
+            ok = le_cbor_DecodeDoubleArray(&itemPtr, Decoded.d, &count, NUM_VALUES);
+            break;
+    }
+
+    LE_FATAL_IF(!ok || (count != NUM_VALUES), "Batch decoding failed");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the throughput of one run, in MB/s of encoded data.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportRate
+(
+    const char* name,       ///< [IN] Name of the test.
+    const char* what,       ///< [IN] What was measured.
+    size_t size,            ///< [IN] Size of the encoded data, in bytes.
+    uint64_t elapsedUs      ///< [IN] Time taken for NUM_ITERATIONS runs, in microseconds.
+)
+{
+    LE_TEST_INFO("%s: %s %.1f MB/s (%" PRIu64 " ns per array)",
+                 name, what,
+                 (double)size * NUM_ITERATIONS / elapsedUs,
+                 elapsedUs * 1000 / NUM_ITERATIONS);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode and decode the test values NUM_ITERATIONS times each way, check that the results agree,
+ * and report the throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunArrayTest
+(
+    const char* name,       ///< [IN] Name of the test.
+    ArrayType_t type        ///< [IN] Type of the values.
+)
+{
+    size_t itemSize = 0;
+    size_t batchSize = 0;
+    uint64_t startUs;
+    int i;
+
+    startUs = timing_GetTimeUs();
+    for (i = 0; i < NUM_ITERATIONS; i++)
+    {
+        itemSize = EncodeItems(type);
+    }
+    ReportRate(name, "item encode", itemSize, timing_GetTimeUs() - startUs);
+
+    startUs = timing_GetTimeUs();
+    for (i = 0; i < NUM_ITERATIONS; i++)
+    {
+        batchSize = EncodeBatch(type);
+    }
+    ReportRate(name, "batch encode", batchSize, timing_GetTimeUs() - startUs);
+
+    LE_TEST_OK((itemSize == batchSize) && (memcmp(ItemBuffer, BatchBuffer, itemSize) == 0),
+               "%s: batch encoding matches item encoding (%" PRIuS " bytes)", name, batchSize);
+
+    startUs = timing_GetTimeUs();
+    for (i = 0; i < NUM_ITERATIONS; i++)
+    {
+        DecodeItems(type, BatchBuffer);
+    }
+    ReportRate(name, "item decode", batchSize, timing_GetTimeUs() - startUs);
+
+    memset(&Decoded, 0, sizeof(Decoded));
+    startUs = timing_GetTimeUs();
+    for (i = 0; i < NUM_ITERATIONS; i++)
+    {
+        DecodeBatch(type, BatchBuffer);
+    }
+    ReportRate(name, "batch decode", batchSize, timing_GetTimeUs() - startUs);
+
+    LE_TEST_OK(memcmp(&Values, &Decoded, sizeof(Values)) == 0,
+               "%s: batch decoding returns the original values", name);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode a message shaped like a proxied function call: a handful of scalar parameters, a string,
+ * and an output array.
+ *
+ * @return Number of bytes encoded.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t EncodeCall
+(
+    uint8_t* buffer,        ///< [OUT] Buffer to encode into.
+    size_t bufLen           ///< [IN] Size of the buffer.
+)
+{
+    uint8_t* bufPtr = buffer;
+    bool ok = le_cbor_EncodeArrayHeader(&bufPtr, &bufLen, 7) &&
+              le_cbor_EncodePositiveInteger(&bufPtr, &bufLen, 0x12345678) &&
+              le_cbor_EncodeInteger(&bufPtr, &bufLen, -40) &&
+              le_cbor_EncodeBool(&bufPtr, &bufLen, true) &&
+              le_cbor_EncodeString(&bufPtr, &bufLen, "/sys/temperature", 64) &&
+              le_cbor_EncodeDouble(&bufPtr, &bufLen, 49.2827) &&
+              le_cbor_EncodeNull(&bufPtr, &bufLen) &&
+              le_cbor_EncodeUint16Array(&bufPtr, &bufLen, Values.u16, 16);
+
+    LE_FATAL_IF(!ok, "Call encoding failed");
+    return bufPtr - buffer;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Walk a call message item by item, the way the RPC Proxy does when it looks for parameters to
+ * repack.
+ *
+ * @return Number of items seen.
+ */
+//--------------------------------------------------------------------------------------------------
+static int WalkCall
+(
+    const uint8_t* buffer,  ///< [IN] Encoded message.
+    size_t size             ///< [IN] Size of the message.
+)
+{
+    uint8_t* bufPtr = (uint8_t*)buffer;
+    const uint8_t* endPtr = buffer + size;
+    char string[64];
+    int items = 0;
+
+    while (bufPtr < endPtr)
+    {
+        ssize_t additionalBytes;
+        size_t count;
+        int64_t intValue;
+        bool boolValue;
+        double doubleValue;
+        bool ok;
+
+        switch (le_cbor_GetType(bufPtr, &additionalBytes))
+        {
+            case LE_CBOR_TYPE_ITEM_ARRAY:
+                ok = le_cbor_DecodeArrayHeader(&bufPtr, &count);
+                break;
+            case LE_CBOR_TYPE_POS_INTEGER:
+            case LE_CBOR_TYPE_NEG_INTEGER:
+                ok = le_cbor_DecodeInteger(&bufPtr, &intValue);
+                break;
+            case LE_CBOR_TYPE_BOOLEAN:
+                ok = le_cbor_DecodeBool(&bufPtr, &boolValue);
+                break;
+            case LE_CBOR_TYPE_TEXT_STRING:
+                ok = le_cbor_DecodeString(&bufPtr, string, sizeof(string));
+                break;
+            case LE_CBOR_TYPE_DOUBLE:
+                ok = le_cbor_DecodeDouble(&bufPtr, &doubleValue);
+                break;
+            case LE_CBOR_TYPE_NULL:
+                bufPtr += LE_CBOR_NULL_MAX_SIZE;
+                ok = true;
+                break;
+            default:
+                ok = false;
+                break;
+        }
+
+        if (!ok)
+        {
+            return -1;
+        }
+        items++;
+    }
+
+    return items;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Walk a call message NUM_ITERATIONS times and report the throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunCallTest
+(
+    void
+)
+{
+    size_t size = EncodeCall(ItemBuffer, sizeof(ItemBuffer));
+    int items = 0;
+    int i;
+
+    uint64_t startUs = timing_GetTimeUs();
+    for (i = 0; i < NUM_ITERATIONS; i++)
+    {
+        items = WalkCall(ItemBuffer, size);
+    }
+    ReportRate("call message", "walk", size, timing_GetTimeUs() - startUs);
+
+    // 8 items before the nested array, plus its 16 values.
+    LE_TEST_OK(items == 8 + 16, "call message: walked %d items in %" PRIuS " bytes", items, size);
+}
+
+
+COMPONENT_INIT
+{
+    int i;
+
+    LE_TEST_PLAN(9);
+
+    // Sensor readings: mostly small, so most items take one or two bytes.
+    for (i = 0; i < NUM_VALUES; i++)
+    {
+        Values.u32[i] = (i * 37) % 1000;
+    }
+    RunArrayTest("uint32 readings", ARRAY_UINT32);
+
+    // Raw samples spread over the full range.
+    memset(&Values, 0, sizeof(Values));
+    for (i = 0; i < NUM_VALUES; i++)
+    {
+        Values.u16[i] = (uint16_t)(i * 2579);
+    }
+    RunArrayTest("uint16 samples", ARRAY_UINT16);
+
+    // Opaque bytes.
+    memset(&Values, 0, sizeof(Values));
+    for (i = 0; i < NUM_VALUES; i++)
+    {
+        Values.u8[i] = (uint8_t)(i * 7);
+    }
+    RunArrayTest("uint8 bytes", ARRAY_UINT8);
+
+    // Positions.
+    memset(&Values, 0, sizeof(Values));
+    for (i = 0; i < NUM_VALUES; i++)
+    {
+        Values.d[i] = 49.2827 + i * 0.0001;
+    }
+    RunArrayTest("double positions", ARRAY_DOUBLE);
+
+    RunCallTest();
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,312 @@
+/**
+ * This module is a microbenchmark for cross-thread event reporting.  It measures how many events
+ * per second 1 to MAX_THREADS threads can report to (or queue functions to) a single event loop
+ * thread, and how many read() and write() system calls were made per event to wake it up.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "timing.h"
+
+/// Maximum number of threads to run concurrently.
+#define MAX_THREADS         4
+
+/// Number of events each thread reports in a burst, before waiting for them to be handled.
+#define BURST_SIZE          100
+
+/// Number of bursts each thread reports.
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_BURSTS       20
+#else
+#   define NUM_BURSTS       500
+#endif
+
+/// Ways of getting work to the event loop thread.
+typedef enum
+{
+    MODE_REPORT,            ///< le_event_Report()
+    MODE_QUEUE_FUNCTION     ///< le_event_QueueFunctionToThread()
+}
+Mode_t;
+
+/// Event reported to the event loop thread.
+static le_event_Id_t EventId;
+
+/// The event loop thread.
+static le_thread_Ref_t LoopThread;
+
+/// Number of events handled in the current burst.  Only accessed by the event loop thread.
+static int HandledCount;
+
+/// Number of events expected in the current burst.
+static int BurstCount;
+
+/// How events are being delivered in the current run.
+static Mode_t CurrentMode;
+
+/// Number of threads reporting in the current run.
+static int ProducerCount;
+
+/// Released once all the threads of a run have been created, so they start reporting together.
+static le_sem_Ref_t StartSem;
+
+/// Released (one for each thread) when all the events of a burst have been handled.
+static le_sem_Ref_t BurstDoneSems[MAX_THREADS];
+
+/// Released by the event loop thread once its handler has been registered.
+static le_sem_Ref_t ReadySem;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of read() and write() system calls made by this process so far.
+ *
+ * @return LE_OK if successful, LE_UNAVAILABLE if /proc/self/io can't be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetSyscallCounts
+(
+    uint64_t* readCountPtr,     ///< [OUT] Number of read() calls.
+    uint64_t* writeCountPtr     ///< [OUT] Number of write() calls.
+)
+{
+    FILE* filePtr = fopen("/proc/self/io", "r");
+    char line[64];
+    int found = 0;
+
+    if (filePtr == NULL)
+    {
+        return LE_UNAVAILABLE;
+    }
+
+    while (fgets(line, sizeof(line), filePtr) != NULL)
+    {
+        if (sscanf(line, "syscr: %" SCNu64, readCountPtr) == 1)
+        {
+            found++;
+        }
+        else if (sscanf(line, "syscw: %" SCNu64, writeCountPtr) == 1)
+        {
+            found++;
+        }
+    }
+
+    fclose(filePtr);
+
+    return (found == 2) ? LE_OK : LE_UNAVAILABLE;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count an event handled by the event loop thread, and release the producers once the whole burst
+ * has been handled.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CountEvent
+(
+    void
+)
+{
+    if (++HandledCount == BurstCount)
+    {
+        int i;
+
+        HandledCount = 0;
+        for (i = 0; i < ProducerCount; i++)
+        {
+            le_sem_Post(BurstDoneSems[i]);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler for the reported events.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EventHandler
+(
+    void* reportPtr     ///< [IN] Report payload (unused).
+)
+{
+    LE_UNUSED(reportPtr);
+    CountEvent();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function queued to the event loop thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueuedFunction
+(
+    void* param1Ptr,    ///< [IN] Unused.
+    void* param2Ptr     ///< [IN] Unused.
+)
+{
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+    CountEvent();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event loop thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* LoopThreadMain
+(
+    void* contextPtr    ///< [IN] Unused.
+)
+{
+    LE_UNUSED(contextPtr);
+
+    le_event_AddHandler("eventLoopPerf", EventId, EventHandler);
+    le_sem_Post(ReadySem);
+
+    le_event_RunLoop();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report NUM_BURSTS bursts of BURST_SIZE events to the event loop thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ProducerThread
+(
+    void* contextPtr    ///< [IN] Thread index, cast to a pointer.
+)
+{
+    int index = (int)(intptr_t)contextPtr;
+    uint32_t value = 0;
+    int i;
+    int j;
+
+    le_sem_Wait(StartSem);
+
+    for (i = 0; i < NUM_BURSTS; i++)
+    {
+        for (j = 0; j < BURST_SIZE; j++)
+        {
+            if (CurrentMode == MODE_REPORT)
+            {
+                value++;
+                le_event_Report(EventId, &value, sizeof(value));
+            }
+            else
+            {
+                le_event_QueueFunctionToThread(LoopThread, QueuedFunction, NULL, NULL);
+            }
+        }
+
+        le_sem_Wait(BurstDoneSems[index]);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the benchmark with a given number of threads and report the results.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunTest
+(
+    Mode_t  mode,           ///< [IN] How to get work to the event loop thread.
+    int     threadCount     ///< [IN] Number of threads reporting at the same time.
+)
+{
+    le_thread_Ref_t threads[MAX_THREADS];
+    uint64_t startReads = 0, startWrites = 0, endReads = 0, endWrites = 0;
+    uint64_t eventCount = (uint64_t)threadCount * NUM_BURSTS * BURST_SIZE;
+    const char* modeName = (mode == MODE_REPORT) ? "le_event_Report" :
+                                                   "le_event_QueueFunctionToThread";
+    int i;
+
+    CurrentMode = mode;
+    ProducerCount = threadCount;
+    BurstCount = threadCount * BURST_SIZE;
+
+    for (i = 0; i < threadCount; i++)
+    {
+        char name[32];
+
+        snprintf(name, sizeof(name), "eventPerf%d", i);
+        threads[i] = le_thread_Create(name, ProducerThread, (void*)(intptr_t)i);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+
+    le_result_t countResult = GetSyscallCounts(&startReads, &startWrites);
+    uint64_t startUs = timing_GetTimeUs();
+
+    for (i = 0; i < threadCount; i++)
+    {
+        le_sem_Post(StartSem);
+    }
+
+    for (i = 0; i < threadCount; i++)
+    {
+        le_thread_Join(threads[i], NULL);
+    }
+
+    uint64_t elapsedUs = timing_GetTimeUs() - startUs;
+    if (countResult == LE_OK)
+    {
+        countResult = GetSyscallCounts(&endReads, &endWrites);
+    }
+
+    LE_TEST_OK(elapsedUs > 0, "%s: %d thread(s) reported %d events each",
+               modeName, threadCount, NUM_BURSTS * BURST_SIZE);
+    LE_TEST_INFO("%s: %d thread(s): %" PRIu64 " events/s",
+                 modeName, threadCount, eventCount * 1000000 / elapsedUs);
+    if (countResult == LE_OK)
+    {
+        LE_TEST_INFO("%s: %d thread(s): %.3f reads, %.3f writes per event",
+                     modeName, threadCount,
+                     (double)(endReads - startReads) / eventCount,
+                     (double)(endWrites - startWrites) / eventCount);
+    }
+}
+
+
+COMPONENT_INIT
+{
+    int threadCount;
+
+    LE_TEST_PLAN(6);
+
+    StartSem = le_sem_Create("eventPerfStart", 0);
+    for (threadCount = 0; threadCount < MAX_THREADS; threadCount++)
+    {
+        char name[32];
+
+        snprintf(name, sizeof(name), "eventPerfBurst%d", threadCount);
+        BurstDoneSems[threadCount] = le_sem_Create(name, 0);
+    }
+    ReadySem = le_sem_Create("eventPerfReady", 0);
+    EventId = le_event_CreateId("eventLoopPerf", sizeof(uint32_t));
+
+    LoopThread = le_thread_Create("eventPerfLoop", LoopThreadMain, NULL);
+    le_thread_Start(LoopThread);
+    le_sem_Wait(ReadySem);
+
+    for (threadCount = 1; threadCount <= MAX_THREADS; threadCount *= 2)
+    {
+        RunTest(MODE_REPORT, threadCount);
+    }
+
+    for (threadCount = 1; threadCount <= MAX_THREADS; threadCount *= 2)
+    {
+        RunTest(MODE_QUEUE_FUNCTION, threadCount);
+    }
+
+    LE_TEST_EXIT;
+}
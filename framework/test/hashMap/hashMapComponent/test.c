@@ -26,6 +26,8 @@ size_t le_hashmap_HashCustom(const void* keyPtr);
 bool le_hashmap_EqualsCustom(const void* firstPtr, const void* secondPtr);
 bool itHandler(const void* keyPtr, const void* valuePtr, void* contextPtr);
 void TestIterRemove(le_hashmap_Ref_t map);
+void TestGrowDuringIter(le_hashmap_Ref_t map);
+void TestModifyDuringForEach(le_hashmap_Ref_t map);
 
 typedef struct Key Key_t;
 struct Key {
@@ -75,6 +77,46 @@ static void InitStaticMaps
     *map7 = le_hashmap_InitStatic(Map7, 13, &le_hashmap_HashUInt32, &le_hashmap_EqualsUInt32);
 }
 
+static void InitOpenMaps
+(
+    le_hashmap_Ref_t *map1,
+    le_hashmap_Ref_t *map2,
+    le_hashmap_Ref_t *map3,
+    le_hashmap_Ref_t *map4,
+    le_hashmap_Ref_t *map5,
+    le_hashmap_Ref_t *map6,
+    le_hashmap_Ref_t *map7
+)
+{
+    LE_TEST_INFO("Creating open-addressed int/int map");
+    *map1 = le_hashmap_CreateOpenAddressed("OpenMap1", 200, &le_hashmap_HashUInt32,
+        &le_hashmap_EqualsUInt32);
+
+    LE_TEST_INFO("Creating open-addressed string/string map");
+    *map2 = le_hashmap_CreateOpenAddressed("OpenMap2", 200, &le_hashmap_HashString,
+        &le_hashmap_EqualsString);
+
+    LE_TEST_INFO("Creating open-addressed custom map");
+    *map3 = le_hashmap_CreateOpenAddressed("OpenMap3", 200, &le_hashmap_HashCustom,
+        &le_hashmap_EqualsCustom);
+
+    LE_TEST_INFO("Creating open-addressed tiny map");
+    *map4 = le_hashmap_CreateOpenAddressed("OpenMap4", 1, &le_hashmap_HashUInt32,
+        &le_hashmap_EqualsUInt32);
+
+    LE_TEST_INFO("Creating open-addressed pointer map");
+    *map5 = le_hashmap_CreateOpenAddressed("OpenMap5", 100, &le_hashmap_HashVoidPointer,
+        &le_hashmap_EqualsVoidPointer);
+
+    LE_TEST_INFO("Creating open-addressed long int/long int map");
+    *map6 = le_hashmap_CreateOpenAddressed("OpenMap6", 200, &le_hashmap_HashUInt64,
+        &le_hashmap_EqualsUInt64);
+
+    LE_TEST_INFO("Creating open-addressed int/int map for iter tests");
+    *map7 = le_hashmap_CreateOpenAddressed("OpenMap7", 13, &le_hashmap_HashUInt32,
+        &le_hashmap_EqualsUInt32);
+}
+
 static void InitDynamicMaps
 (
     le_hashmap_Ref_t *map1,
@@ -138,6 +180,25 @@ COMPONENT_INIT
     TestLongIntHashMap(map6);
     TestNewIter(map7);
     TestIterRemove(map1);
+    TestGrowDuringIter(map1);
+    TestModifyDuringForEach(le_hashmap_Create("ForEachMap", 1, &le_hashmap_HashUInt32,
+        &le_hashmap_EqualsUInt32));
+
+    LE_TEST_INFO("*** Creating hash maps required for open addressing tests. ***");
+    InitOpenMaps(&map1, &map2, &map3, &map4, &map5, &map6, &map7);
+    LE_TEST(map1 && map2 && map3 && map4 && map5 && map6 && map7);
+
+    TestIntHashMap(map1);
+    TestStringHashMap(map2);
+    TestCustomHashMap(map3);
+    TestTinyMap(map4);
+    TestPointerMap(map5);
+    TestLongIntHashMap(map6);
+    TestNewIter(map7);
+    TestIterRemove(map1);
+    TestGrowDuringIter(map1);
+    TestModifyDuringForEach(le_hashmap_CreateOpenAddressed("OpenForEachMap", 1,
+        &le_hashmap_HashUInt32, &le_hashmap_EqualsUInt32));
 
     LE_TEST_INFO("*** Creating hash maps required for static tests. ***");
     InitStaticMaps(&map1, &map2, &map3, &map4, &map5, &map6, &map7);
@@ -151,6 +212,9 @@ COMPONENT_INIT
     TestLongIntHashMap(map6);
     TestNewIter(map7);
     TestIterRemove(map1);
+    TestGrowDuringIter(map1);
+    le_hashmap_RemoveAll(map1);
+    TestModifyDuringForEach(map1);
 
     LE_TEST_INFO("==== Hashmap Tests PASSED ====\n");
 
@@ -580,6 +644,96 @@ void TestIterRemove(le_hashmap_Ref_t map)
     LE_TEST(le_hashmap_Size(map) == TEST_SIZE / 2);
 }
 
+void TestGrowDuringIter(le_hashmap_Ref_t map)
+{
+    // Start with half the keys, then add the other half while iterating.  This crosses at least
+    // one growth threshold, so a heap map starts rehashing part way through the iteration.
+    static uint32_t iKeys[TEST_SIZE];
+    static uint32_t iVals[TEST_SIZE];
+    static uint8_t  visited[TEST_SIZE];
+    int itercnt = 0;
+    int added = TEST_SIZE / 2;
+    int j;
+
+    LE_TEST_INFO("*** Running grow during iteration hashmap tests ***");
+
+    le_hashmap_RemoveAll(map);
+    memset(visited, 0, sizeof(visited));
+    for (j = 0; j < TEST_SIZE; j++)
+    {
+        iKeys[j] = j;
+        iVals[j] = j * 2;
+    }
+    for (j = 0; j < TEST_SIZE / 2; j++)
+    {
+        le_hashmap_Put(map, &iKeys[j], &iVals[j]);
+    }
+
+    le_hashmap_It_Ref_t mapIt = le_hashmap_GetIterator(map);
+    while (le_hashmap_NextNode(mapIt) == LE_OK)
+    {
+        const uint32_t* keyPtr = le_hashmap_GetKey(mapIt);
+        LE_TEST_ASSERT(NULL != keyPtr, "get key from iterator");
+        LE_TEST_ASSERT(*keyPtr < TEST_SIZE, "key %" PRIu32 " in range", *keyPtr);
+        visited[*keyPtr]++;
+        itercnt++;
+
+        if (added < TEST_SIZE)
+        {
+            le_hashmap_Put(map, &iKeys[added], &iVals[added]);
+            added++;
+        }
+    }
+    LE_TEST_INFO("Iterator count = %d", itercnt);
+
+    int missed = 0;
+    int repeated = 0;
+    for (j = 0; j < TEST_SIZE / 2; j++)
+    {
+        if (visited[j] == 0)
+        {
+            missed++;
+        }
+        else if (visited[j] > 1)
+        {
+            repeated++;
+        }
+    }
+    LE_TEST_OK(missed == 0, "no original keys missed (%d)", missed);
+    LE_TEST_OK(repeated == 0, "no original keys repeated (%d)", repeated);
+    LE_TEST(le_hashmap_Size(map) == TEST_SIZE);
+
+    int found = 0;
+    for (j = 0; j < TEST_SIZE; j++)
+    {
+        const uint32_t* valuePtr = le_hashmap_Get(map, &iKeys[j]);
+        if (valuePtr != NULL && *valuePtr == iVals[j])
+        {
+            found++;
+        }
+    }
+    LE_TEST_OK(found == TEST_SIZE, "all %d keys found after growing", found);
+
+    for (j = 0; j < TEST_SIZE; j += 2)
+    {
+        le_hashmap_Remove(map, &iKeys[j]);
+    }
+    LE_TEST(le_hashmap_Size(map) == TEST_SIZE / 2);
+
+    found = 0;
+    for (j = 0; j < TEST_SIZE; j++)
+    {
+        if (le_hashmap_ContainsKey(map, &iKeys[j]) != (j % 2 == 0))
+        {
+            found++;
+        }
+    }
+    LE_TEST_OK(found == TEST_SIZE, "odd keys kept, even keys removed");
+
+    le_hashmap_RemoveAll(map);
+    LE_TEST(le_hashmap_isEmpty(map));
+}
+
 void TestLongIntHashMap(le_hashmap_Ref_t map)
 {
     uint64_t ikey1 = 1412320402000;
@@ -678,3 +832,133 @@ void TestLongIntHashMap(le_hashmap_Ref_t map)
     mapIt = le_hashmap_GetIterator(map);
     LE_TEST(le_hashmap_NextNode(mapIt) == LE_NOT_FOUND);
 }
+
+// Number of keys the map is filled up to, one at a time, by TestModifyDuringForEach().
+#define FOREACH_KEYS    (TEST_SIZE / 4)
+
+// State of a le_hashmap_ForEach() walk which changes the map it is walking.
+typedef struct
+{
+    le_hashmap_Ref_t map;
+    uint32_t        *keysPtr;           // FOREACH_KEYS keys to walk, then as many to add.
+    uint8_t         *visitedPtr;        // Number of visits of each key.
+    uint32_t         addedCount;        // Number of keys added by the walk.
+}
+ForEachModify_t;
+
+static bool ForEachModifyHandler
+(
+    const void* keyPtr,
+    const void* valuePtr,
+    void* contextPtr
+)
+{
+    ForEachModify_t *modifyPtr = contextPtr;
+    uint32_t key = *(const uint32_t *)keyPtr;
+
+    LE_UNUSED(valuePtr);
+    LE_ASSERT(key < 2 * FOREACH_KEYS);
+
+    modifyPtr->visitedPtr[key]++;
+    if (key < FOREACH_KEYS)
+    {
+        // Remove odd keys as they are visited, and add a new key for every key visited.
+        if (key % 2 != 0)
+        {
+            le_hashmap_Remove(modifyPtr->map, keyPtr);
+        }
+
+        uint32_t *newKeyPtr = &modifyPtr->keysPtr[FOREACH_KEYS + modifyPtr->addedCount];
+        le_hashmap_Put(modifyPtr->map, newKeyPtr, newKeyPtr);
+        modifyPtr->addedCount++;
+    }
+    return true;
+}
+
+void TestModifyDuringForEach(le_hashmap_Ref_t map)
+{
+    // Add keys one at a time, and after each one walk the map with a callback which puts and
+    // removes entries.  As a heap map is created small and grows as keys are added, many of the
+    // walks start with a rehash in progress.
+    static uint32_t keys[2 * FOREACH_KEYS];
+    static uint8_t  visited[2 * FOREACH_KEYS];
+    ForEachModify_t modify =
+    {
+        .map = map,
+        .keysPtr = keys,
+        .visitedPtr = visited
+    };
+    int missed = 0;
+    int repeated = 0;
+    int lost = 0;
+    uint32_t n;
+    uint32_t j;
+
+    LE_TEST_INFO("*** Running modify during ForEach hashmap tests ***");
+
+    LE_TEST(le_hashmap_isEmpty(map));
+    for (j = 0; j < 2 * FOREACH_KEYS; j++)
+    {
+        keys[j] = j;
+    }
+
+    for (n = 1; n <= FOREACH_KEYS; n++)
+    {
+        le_hashmap_Put(map, &keys[n - 1], &keys[n - 1]);
+
+        memset(visited, 0, sizeof(visited));
+        modify.addedCount = 0;
+        le_hashmap_ForEach(map, ForEachModifyHandler, &modify);
+
+        for (j = 0; j < n; j++)
+        {
+            if (visited[j] == 0)
+            {
+                missed++;
+            }
+            else if (visited[j] > 1)
+            {
+                repeated++;
+            }
+        }
+        for (j = FOREACH_KEYS; j < FOREACH_KEYS + modify.addedCount; j++)
+        {
+            if (visited[j] > 1)
+            {
+                repeated++;
+            }
+            if (le_hashmap_Remove(map, &keys[j]) != &keys[j])
+            {
+                lost++;
+            }
+        }
+
+        // Put the odd keys back for the next round.
+        for (j = 1; j < n; j += 2)
+        {
+            if (le_hashmap_Get(map, &keys[j]) != NULL)
+            {
+                lost++;
+            }
+            le_hashmap_Put(map, &keys[j], &keys[j]);
+        }
+        for (j = 0; j < n; j++)
+        {
+            if (le_hashmap_Get(map, &keys[j]) != &keys[j])
+            {
+                lost++;
+            }
+        }
+        if (modify.addedCount != n || le_hashmap_Size(map) != n)
+        {
+            lost++;
+        }
+    }
+
+    LE_TEST_OK(missed == 0, "no keys missed by ForEach (%d)", missed);
+    LE_TEST_OK(repeated == 0, "no keys repeated by ForEach (%d)", repeated);
+    LE_TEST_OK(lost == 0, "entries put and removed during ForEach kept (%d)", lost);
+
+    le_hashmap_RemoveAll(map);
+    LE_TEST(le_hashmap_isEmpty(map));
+}
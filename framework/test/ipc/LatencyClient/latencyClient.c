@@ -0,0 +1,57 @@
+/**
+ * Measures the round-trip latency of synchronous calls made through the generated client stubs.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "timing.h"
+
+/// Number of timed calls.
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define CALL_COUNT       1000
+#else
+#   define CALL_COUNT       50000
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make one call, and check it echoes its value back.
+ *
+ * @return true if it did.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Call
+(
+    uint32_t    index,      ///< [IN] Number of the call.
+    void*       contextPtr  ///< [IN] Not used.
+)
+{
+    uint32_t outValue = 0;
+
+    LE_UNUSED(contextPtr);
+
+    ipcPerf_Echo(index, &outValue);
+    return (outValue == index);
+}
+
+
+COMPONENT_INIT
+{
+    timing_Stats_t stats;
+
+    LE_TEST_PLAN(1);
+
+    uint32_t mismatchCount = timing_TimeCalls(Call, NULL, CALL_COUNT, &stats);
+
+    LE_TEST_OK(mismatchCount == 0, "all %d echoed values matched", CALL_COUNT);
+
+    LE_TEST_INFO("%d sync calls: min %" PRIu64 " us, avg %" PRIu64 ".%02" PRIu64
+                 " us, max %" PRIu64 " us",
+                 CALL_COUNT, stats.minUs, stats.totalUs / CALL_COUNT,
+                 (stats.totalUs * 100 / CALL_COUNT) % 100, stats.maxUs);
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,98 @@
+/**
+ * Measures how the amount of data in a message affects the cost of a synchronous call made through
+ * the generated client stubs.
+ *
+ * The ipcPerf API has one function (EchoBlob) whose largest message is much bigger than any of
+ * its other messages.  If every message were sent with its whole payload buffer, a call would
+ * cost the same no matter how much data it carries, so small calls should now be much cheaper
+ * than full-size ones.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "timing.h"
+
+/// Number of timed calls for each blob size.
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define CALL_COUNT       1000
+#else
+#   define CALL_COUNT       20000
+#endif
+
+/// Blob sizes to time.  Zero means the Echo function is used instead of EchoBlob.
+static const size_t BlobSizes[] = { 0, 16, 256, 2048, IPCPERF_MAX_BLOB_BYTES };
+
+/// Buffers for the blob data.
+static uint8_t InData[IPCPERF_MAX_BLOB_BYTES];
+static uint8_t OutData[IPCPERF_MAX_BLOB_BYTES];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make one call carrying a blob of a given size.
+ *
+ * @return true if the echoed data matched.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Call
+(
+    uint32_t    index,      ///< [IN] Number of the call.
+    void*       contextPtr  ///< [IN] Blob size, or 0 to call Echo.
+)
+{
+    size_t blobSize = (size_t)(uintptr_t)contextPtr;
+
+    LE_UNUSED(index);
+
+    if (blobSize == 0)
+    {
+        uint32_t outValue = 0;
+
+        ipcPerf_Echo(UINT32_C(0x5a5a5a5a), &outValue);
+        return (outValue == UINT32_C(0x5a5a5a5a));
+    }
+
+    size_t outSize = sizeof(OutData);
+
+    ipcPerf_EchoBlob(InData, blobSize, OutData, &outSize);
+    return ((outSize == blobSize) && (memcmp(InData, OutData, blobSize) == 0));
+}
+
+
+COMPONENT_INIT
+{
+    uint32_t maxPayloadSize = 0;
+    timing_Stats_t stats;
+    size_t i;
+
+    LE_TEST_PLAN((int)NUM_ARRAY_MEMBERS(BlobSizes));
+
+    for (i = 0; i < sizeof(InData); i++)
+    {
+        InData[i] = (uint8_t)i;
+    }
+
+    ipcPerf_GetMaxPayloadSize(&maxPayloadSize);
+
+    // A request and its response each used to carry a transaction ID and the whole payload buffer.
+    LE_TEST_INFO("payload buffer %" PRIu32 " bytes; previously %" PRIuS " bytes copied per call",
+                 maxPayloadSize,
+                 2 * (sizeof(void*) + maxPayloadSize));
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(BlobSizes); i++)
+    {
+        uint32_t mismatchCount = timing_TimeCalls(Call, (void*)(uintptr_t)BlobSizes[i],
+                                                  CALL_COUNT, &stats);
+
+        LE_TEST_OK(mismatchCount == 0, "all %d calls with %" PRIuS " data bytes matched",
+                   CALL_COUNT, BlobSizes[i]);
+
+        LE_TEST_INFO("%" PRIuS " data bytes: avg %" PRIu64 ".%02" PRIu64 " us per call",
+                     BlobSizes[i], stats.totalUs / CALL_COUNT,
+                     (stats.totalUs * 100 / CALL_COUNT) % 100);
+    }
+
+    LE_TEST_EXIT;
+}
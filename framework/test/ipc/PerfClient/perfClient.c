@@ -0,0 +1,120 @@
+/**
+ * Client side of the IPC performance tests.
+ *
+ * Measures how many server-to-client messages per second the IPC layer can deliver.  To compare
+ * against unbatched socket I/O, rebuild the framework with LE_CONFIG_MSG_BATCH_SIZE=1; the number
+ * of messages carried by each sendmmsg()/recvmmsg() call can be seen with
+ * "inspect ipc <pid> sessions -v" while the test is running.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "timing.h"
+
+/// Number of flood events to receive.
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define FLOOD_COUNT      2000
+#else
+#   define FLOOD_COUNT      200000
+#endif
+
+/// Time to wait for the flood to complete, in ms.
+#define FLOOD_TIMEOUT       60000
+
+/// Number of flood events received so far.
+static uint32_t RxCount;
+
+/// True if any event arrived out of order.
+static bool IsOutOfOrder;
+
+/// Time the flood was started, in microseconds.
+static uint64_t StartUs;
+
+static ipcPerf_FloodHandlerRef_t FloodHandlerRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report results and exit.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FinishFlood
+(
+    void
+)
+{
+    uint64_t elapsedUs = timing_GetTimeUs() - StartUs;
+
+    ipcPerf_RemoveFloodHandler(FloodHandlerRef);
+
+    LE_TEST_OK(RxCount == FLOOD_COUNT, "received %" PRIu32 " of %d events", RxCount, FLOOD_COUNT);
+    LE_TEST_OK(!IsOutOfOrder, "events received in order");
+
+    if (elapsedUs > 0)
+    {
+        LE_TEST_INFO("%" PRIu32 " events in %" PRIu64 " us: %" PRIu64 " msgs/s",
+                     RxCount, elapsedUs, (uint64_t)RxCount * 1000000 / elapsedUs);
+    }
+
+    LE_TEST_EXIT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count flood events.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FloodHandler
+(
+    uint32_t seq,           ///< [IN] Sequence number of the event.
+    void* contextPtr        ///< [IN] Not used.
+)
+{
+    if (seq != RxCount)
+    {
+        IsOutOfOrder = true;
+    }
+
+    if (++RxCount == FLOOD_COUNT)
+    {
+        FinishFlood();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Give up if the flood does not complete in time.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TimeoutHandler
+(
+    le_timer_Ref_t timerRef     ///< [IN] Expired timer.
+)
+{
+    LE_TEST_INFO("Timed out waiting for flood events");
+    FinishFlood();
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(3);
+
+    ipcPerf_ConnectService();
+
+    FloodHandlerRef = ipcPerf_AddFloodHandler(FloodHandler, NULL);
+    LE_TEST_ASSERT(FloodHandlerRef != NULL, "flood handler registered");
+
+    le_timer_Ref_t timer = le_timer_Create("FloodTimeout");
+    le_timer_SetMsInterval(timer, FLOOD_TIMEOUT);
+    le_timer_SetHandler(timer, TimeoutHandler);
+    le_timer_Start(timer);
+
+    LE_TEST_INFO("Starting flood of %d events", FLOOD_COUNT);
+    StartUs = timing_GetTimeUs();
+    ipcPerf_StartFlood(FLOOD_COUNT);
+}
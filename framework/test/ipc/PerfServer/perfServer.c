@@ -0,0 +1,146 @@
+/**
+ * Server side of the IPC performance tests.
+ *
+ * Flood events are sent from a queued function rather than from inside StartFlood() so that the
+ * client receives them through its event loop, which is the path that batches socket reads.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+/// Maximum number of events sent per pass through the event loop.
+#define FLOOD_CHUNK_SIZE    256
+
+/// Registered flood handler, if any.
+static ipcPerf_FloodHandlerFunc_t FloodHandlerPtr = NULL;
+static void* FloodContextPtr = NULL;
+
+/// Sequence number of the next flood event and number of events still to send.
+static uint32_t FloodSeq;
+static uint32_t FloodRemaining;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send the next chunk of flood events, and re-queue itself if there are more to send.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendFloodChunk
+(
+    void* param1Ptr,    ///< [IN] Not used.
+    void* param2Ptr     ///< [IN] Not used.
+)
+{
+    uint32_t i;
+
+    for (i = 0; (i < FLOOD_CHUNK_SIZE) && (FloodRemaining > 0); i++, FloodRemaining--)
+    {
+        if (FloodHandlerPtr == NULL)
+        {
+            FloodRemaining = 0;
+            return;
+        }
+
+        FloodHandlerPtr(FloodSeq++, FloodContextPtr);
+    }
+
+    if (FloodRemaining > 0)
+    {
+        le_event_QueueFunction(SendFloodChunk, NULL, NULL);
+    }
+}
+
+
+ipcPerf_FloodHandlerRef_t ipcPerf_AddFloodHandler
+(
+    ipcPerf_FloodHandlerFunc_t handlerPtr,
+    void* contextPtr
+)
+{
+    // For simplicity, only allow a single event handler
+    if (FloodHandlerPtr)
+    {
+        return NULL;
+    }
+
+    FloodHandlerPtr = handlerPtr;
+    FloodContextPtr = contextPtr;
+
+    return (ipcPerf_FloodHandlerRef_t)1;
+}
+
+void ipcPerf_RemoveFloodHandler
+(
+    ipcPerf_FloodHandlerRef_t handlerRef
+)
+{
+    if ((size_t)handlerRef == 1)
+    {
+        FloodHandlerPtr = NULL;
+        FloodContextPtr = NULL;
+    }
+}
+
+void ipcPerf_StartFlood
+(
+    uint32_t count
+)
+{
+    bool isIdle = (FloodRemaining == 0);
+
+    FloodSeq = 0;
+    FloodRemaining = count;
+
+    if (isIdle && (count > 0))
+    {
+        le_event_QueueFunction(SendFloodChunk, NULL, NULL);
+    }
+}
+
+void ipcPerf_Echo
+(
+    uint32_t inValue,
+    uint32_t* outValuePtr
+)
+{
+    if (outValuePtr)
+    {
+        *outValuePtr = inValue;
+    }
+}
+
+void ipcPerf_EchoBlob
+(
+    const uint8_t* inDataPtr,
+    size_t inDataSize,
+    uint8_t* outDataPtr,
+    size_t* outDataSizePtr
+)
+{
+    if (outDataPtr && outDataSizePtr)
+    {
+        size_t size = (inDataSize < *outDataSizePtr) ? inDataSize : *outDataSizePtr;
+
+        memcpy(outDataPtr, inDataPtr, size);
+        *outDataSizePtr = size;
+    }
+}
+
+void ipcPerf_GetMaxPayloadSize
+(
+    uint32_t* sizePtr
+)
+{
+    if (sizePtr)
+    {
+        le_msg_SessionRef_t sessionRef = ipcPerf_GetClientSessionRef();
+
+        *sizePtr = le_msg_GetProtocolMaxMsgSize(le_msg_GetSessionProtocol(sessionRef));
+    }
+}
+
+COMPONENT_INIT
+{
+}
@@ -0,0 +1,124 @@
+/**
+ * Measures how long the Service Directory takes to open sessions when many clients ask at once.
+ *
+ * Each round starts a batch of threads which all open a session to the server at the same time,
+ * make one call through it and close it again.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "timing.h"
+
+/// Number of sessions opened concurrently in each round.
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define SESSION_COUNT    4
+#else
+#   define SESSION_COUNT    32
+#endif
+
+/// Number of rounds.
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define ROUND_COUNT      10
+#else
+#   define ROUND_COUNT      100
+#endif
+
+/// Semaphore the threads of a round wait on, so that they all open their sessions together.
+static le_sem_Ref_t StartSemRef;
+
+/// Time each thread took to open its session, in microseconds.
+static uint64_t OpenTimeUs[SESSION_COUNT];
+
+/// Number of calls through the opened sessions which did not echo their value back.
+static uint32_t MismatchCount;
+
+/// Protects MismatchCount.
+static le_mutex_Ref_t MismatchMutexRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a session, check it works and close it again.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* SessionThread
+(
+    void* contextPtr    ///< Index of the thread in the round.
+)
+{
+    uint32_t index = (uint32_t)(uintptr_t)contextPtr;
+    uint32_t outValue = 0;
+
+    le_sem_Wait(StartSemRef);
+
+    uint64_t startUs = timing_GetTimeUs();
+    ipcPerf_ConnectService();
+    OpenTimeUs[index] = timing_GetTimeUs() - startUs;
+
+    ipcPerf_Echo(index, &outValue);
+    if (outValue != index)
+    {
+        le_mutex_Lock(MismatchMutexRef);
+        MismatchCount++;
+        le_mutex_Unlock(MismatchMutexRef);
+    }
+
+    ipcPerf_DisconnectService();
+
+    return NULL;
+}
+
+
+COMPONENT_INIT
+{
+    le_thread_Ref_t threadRefs[SESSION_COUNT];
+    timing_Stats_t stats;
+    timing_Stats_t roundStats;
+    uint32_t round;
+    uint32_t i;
+
+    LE_TEST_PLAN(1);
+
+    StartSemRef = le_sem_Create("SessionOpenStart", 0);
+    MismatchMutexRef = le_mutex_CreateNonRecursive("SessionOpenMismatch");
+    timing_InitStats(&stats);
+    timing_InitStats(&roundStats);
+
+    for (round = 0; round < ROUND_COUNT; round++)
+    {
+        for (i = 0; i < SESSION_COUNT; i++)
+        {
+            threadRefs[i] = le_thread_Create("SessionOpen", SessionThread, (void*)(uintptr_t)i);
+            le_thread_SetJoinable(threadRefs[i]);
+            le_thread_Start(threadRefs[i]);
+        }
+
+        uint64_t roundStartUs = timing_GetTimeUs();
+        for (i = 0; i < SESSION_COUNT; i++)
+        {
+            le_sem_Post(StartSemRef);
+        }
+        for (i = 0; i < SESSION_COUNT; i++)
+        {
+            le_thread_Join(threadRefs[i], NULL);
+        }
+        timing_AddSample(&roundStats, timing_GetTimeUs() - roundStartUs);
+
+        for (i = 0; i < SESSION_COUNT; i++)
+        {
+            timing_AddSample(&stats, OpenTimeUs[i]);
+        }
+    }
+
+    LE_TEST_OK(MismatchCount == 0, "all %d sessions echoed their value",
+               SESSION_COUNT * ROUND_COUNT);
+
+    LE_TEST_INFO("%d rounds of %d concurrent session opens: min %" PRIu64 " us, avg %" PRIu64
+                 ".%02" PRIu64 " us, max %" PRIu64 " us; slowest round %" PRIu64 " us",
+                 ROUND_COUNT, SESSION_COUNT, stats.minUs, stats.totalUs / stats.count,
+                 (stats.totalUs * 100 / stats.count) % 100, stats.maxUs, roundStats.maxUs);
+
+    LE_TEST_EXIT;
+}
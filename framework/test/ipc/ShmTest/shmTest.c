@@ -0,0 +1,231 @@
+/**
+ * This module tests the shared memory rings used to pass large IPC messages: attaching, wrapping
+ * around the end of a ring, falling back to the socket when a ring is full, and taking back the
+ * space claimed by the unsent part of a batch.  Both sides of a session are played by this
+ * process.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "messagingShm.h"
+
+#if LE_CONFIG_MSG_SHM
+
+/// Size of each ring.
+#define RING_SIZE       LE_CONFIG_MSG_SHM_RING_SIZE
+
+/// Size of the payloads used.  Two of them fit in a ring, but not three.
+#define PAYLOAD_SIZE    (RING_SIZE / 8 * 3)
+
+/// Offset of the version number in a region's header.  It follows the magic number.
+#define VERSION_OFFSET  4
+
+/// Payload to send and buffer to receive it in.
+static uint8_t TxPayload[PAYLOAD_SIZE];
+static uint8_t RxPayload[PAYLOAD_SIZE];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a payload filled with a pattern in the server's sending ring.
+ *
+ * @return true if the payload went in the ring, false if it would go through the socket.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Put
+(
+    msgShm_RegionRef_t  regionRef,
+    uint8_t             seed,       ///< [IN] Seed of the pattern.
+    msgShm_Desc_t*      descPtr     ///< [OUT] Descriptor to "send".
+)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(TxPayload); i++)
+    {
+        TxPayload[i] = (uint8_t)(seed + i);
+    }
+
+    return msgShm_Put(regionRef, TxPayload, sizeof(TxPayload), descPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take a payload out of the client's receiving ring and check its pattern.
+ *
+ * @return true if the payload was received intact.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Get
+(
+    msgShm_RegionRef_t      regionRef,
+    uint8_t                 seed,       ///< [IN] Seed of the expected pattern.
+    const msgShm_Desc_t*    descPtr     ///< [IN] Descriptor "received".
+)
+{
+    size_t i;
+
+    memset(RxPayload, 0, sizeof(RxPayload));
+
+    if ((msgShm_Get(regionRef, descPtr, RxPayload, sizeof(RxPayload)) != LE_OK) ||
+        (descPtr->size != sizeof(RxPayload)))
+    {
+        return false;
+    }
+
+    for (i = 0; i < sizeof(RxPayload); i++)
+    {
+        if (RxPayload[i] != (uint8_t)(seed + i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that clients that don't attach, or that don't support the region's version, are never
+ * sent anything through the ring, then attach a client.
+ *
+ * @return The client side of the region.
+ */
+//--------------------------------------------------------------------------------------------------
+static msgShm_RegionRef_t TestAttach
+(
+    msgShm_RegionRef_t  serverRef,
+    int                 fd          ///< [IN] File descriptor passed to the client.
+)
+{
+    msgShm_Desc_t desc;
+    uint32_t version;
+    uint32_t otherVersion;
+
+    LE_TEST_OK(!Put(serverRef, 0, &desc),
+               "payload goes through the socket until client attaches");
+
+    LE_ASSERT(pread(fd, &version, sizeof(version), VERSION_OFFSET) == sizeof(version));
+    otherVersion = version + 1;
+    LE_ASSERT(pwrite(fd, &otherVersion, sizeof(otherVersion), VERSION_OFFSET) ==
+              sizeof(otherVersion));
+    LE_TEST_OK(msgShm_Attach(fd) == NULL, "client rejects a region of another version");
+    LE_ASSERT(pwrite(fd, &version, sizeof(version), VERSION_OFFSET) == sizeof(version));
+    LE_TEST_OK(!Put(serverRef, 0, &desc),
+               "payload goes through the socket if client rejects it");
+
+    msgShm_RegionRef_t clientRef = msgShm_Attach(fd);
+    LE_TEST_ASSERT(clientRef != NULL, "client attaches");
+
+    LE_TEST_OK(Put(serverRef, 1, &desc), "payload goes in the ring once client has attached");
+    LE_TEST_OK(desc.start == 0, "first payload is at the start of the ring");
+    LE_TEST_OK(Get(clientRef, 1, &desc), "client gets the payload");
+
+    return clientRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a batch of two payloads, of which only the first goes through the socket, then send the
+ * second again.  The second one doesn't fit at the end of the ring, so it wraps around.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestWrapAndRewind
+(
+    msgShm_RegionRef_t  serverRef,
+    msgShm_RegionRef_t  clientRef
+)
+{
+    msgShm_Desc_t firstDesc;
+    msgShm_Desc_t secondDesc;
+    msgShm_Desc_t resentDesc;
+
+    LE_ASSERT(Put(serverRef, 2, &firstDesc));
+    uint32_t mark = msgShm_GetMark(serverRef);
+    LE_TEST_OK(Put(serverRef, 3, &secondDesc), "second payload of batch goes in the ring");
+    LE_TEST_OK(secondDesc.start == RING_SIZE, "it wraps around to the start of the ring");
+
+    msgShm_Rewind(serverRef, mark);
+    LE_TEST_OK(msgShm_GetMark(serverRef) == mark, "unsent payload's space is taken back");
+
+    LE_TEST_OK(Put(serverRef, 4, &resentDesc), "unsent payload is put in again");
+    LE_TEST_OK(resentDesc.start == secondDesc.start, "it takes the same space");
+
+    LE_TEST_OK(Get(clientRef, 2, &firstDesc), "client gets the sent payload");
+    LE_TEST_OK(Get(clientRef, 4, &resentDesc), "client gets the wrapped payload");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill the ring, then check that the next payload goes through the socket until the client has
+ * freed some space.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestFull
+(
+    msgShm_RegionRef_t  serverRef,
+    msgShm_RegionRef_t  clientRef
+)
+{
+    msgShm_Desc_t firstDesc;
+    msgShm_Desc_t secondDesc;
+    msgShm_Desc_t thirdDesc;
+    msgShm_Desc_t badDesc;
+
+    LE_ASSERT(Put(serverRef, 5, &firstDesc));
+    LE_ASSERT(Put(serverRef, 6, &secondDesc));
+    LE_TEST_OK(!Put(serverRef, 7, &thirdDesc), "payload goes through the socket if ring is full");
+
+    LE_TEST_OK(Get(clientRef, 5, &firstDesc), "client gets the first payload in the full ring");
+    LE_TEST_OK(Put(serverRef, 8, &thirdDesc), "payload goes in the ring once there is room");
+
+    badDesc = thirdDesc;
+    LE_TEST_OK(msgShm_Get(clientRef, &badDesc, RxPayload, sizeof(RxPayload)) == LE_FORMAT_ERROR,
+               "client rejects a descriptor out of order");
+    badDesc = secondDesc;
+    LE_TEST_OK(msgShm_Get(clientRef, &badDesc, RxPayload, sizeof(RxPayload) - 1) ==
+               LE_FORMAT_ERROR,
+               "client rejects a payload too big for its buffer");
+    LE_TEST_OK(Get(clientRef, 6, &secondDesc), "client then gets the payloads in order");
+    LE_TEST_OK(Get(clientRef, 8, &thirdDesc), "including the one sent once there was room");
+}
+
+#endif
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+#if LE_CONFIG_MSG_SHM
+    if (PAYLOAD_SIZE < LE_CONFIG_MSG_SHM_THRESHOLD)
+    {
+        LE_TEST_INFO("Ring of %d bytes is too small for threshold of %d bytes; skipping",
+                     RING_SIZE,
+                     LE_CONFIG_MSG_SHM_THRESHOLD);
+        LE_TEST_EXIT;
+    }
+
+    int fd = -1;
+    msgShm_RegionRef_t serverRef = msgShm_Create(PAYLOAD_SIZE, &fd);
+    LE_TEST_ASSERT(serverRef != NULL, "server creates a region");
+
+    msgShm_RegionRef_t clientRef = TestAttach(serverRef, fd);
+    close(fd);
+
+    TestWrapAndRewind(serverRef, clientRef);
+    TestFull(serverRef, clientRef);
+
+    msgShm_Delete(clientRef);
+    msgShm_Delete(serverRef);
+#else
+    LE_TEST_INFO("IPC shared memory is not enabled; skipping");
+#endif
+
+    LE_TEST_EXIT;
+}
@@ -50,8 +50,15 @@ static struct JsonExpectation Expected[] =
     { LE_JSON_OBJECT_END,       NULL,       0, 0, 147 }
 };
 
+/// Text following the JSON document when parsing from a file descriptor.
+static const char *Trailer = "\ntrailer";
+
+/// Length of the long string in the string slice test.
+#define LONG_STRING_BYTES   (LE_CONFIG_JSON_PARSER_BUFFER_SIZE + 100)
+
 static size_t TestIndex;
 static bool testDone = false;
+static bool LongStringError;
 
 static void OnEvent
 (
@@ -132,16 +139,217 @@ static void OnError
     LE_TEST_FATAL("Parse error (%d): %s", error, msg);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a file descriptor is positioned just after the JSON document.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckTrailer
+(
+    int fd,
+    const char *kind
+)
+{
+    char buffer[32] = "";
+    ssize_t len = read(fd, buffer, sizeof(buffer) - 1);
+
+    LE_TEST_OK(len == (ssize_t)strlen(Trailer) && strncmp(buffer, Trailer, len) == 0,
+               "%s positioned after document", kind);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse the test document from a regular file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestFile
+(
+    void
+)
+{
+    char path[] = "/tmp/testJsonXXXXXX";
+    int fd = mkstemp(path);
+    ssize_t jsonLen = strlen(StaticJson) - 1;
+    ssize_t trailerLen = strlen(Trailer);
+
+    LE_TEST_ASSERT(fd >= 0, "Created temporary file");
+    unlink(path);
+    LE_TEST_ASSERT(write(fd, StaticJson, jsonLen) == jsonLen &&
+                   write(fd, Trailer, trailerLen) == trailerLen &&
+                   lseek(fd, 0, SEEK_SET) == 0,
+                   "Wrote temporary file");
+
+    TestIndex = 0;
+    le_json_SyncParse(fd, &OnEvent, &OnError, NULL);
+    CheckTrailer(fd, "File");
+
+    close(fd);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse the test document from a pipe.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestPipe
+(
+    void
+)
+{
+    int fds[2];
+    ssize_t jsonLen = strlen(StaticJson) - 1;
+    ssize_t trailerLen = strlen(Trailer);
+
+    LE_TEST_ASSERT(pipe(fds) == 0, "Created pipe");
+    LE_TEST_ASSERT(write(fds[1], StaticJson, jsonLen) == jsonLen &&
+                   write(fds[1], Trailer, trailerLen) == trailerLen,
+                   "Wrote to pipe");
+    close(fds[1]);
+
+    TestIndex = 0;
+    le_json_SyncParse(fds[0], &OnEvent, &OnError, NULL);
+    CheckTrailer(fds[0], "Pipe");
+
+    close(fds[0]);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse the test document from a stream socket.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestSocket
+(
+    void
+)
+{
+    int fds[2];
+    ssize_t jsonLen = strlen(StaticJson) - 1;
+    ssize_t trailerLen = strlen(Trailer);
+
+    LE_TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, "Created socket pair");
+    LE_TEST_ASSERT(write(fds[1], StaticJson, jsonLen) == jsonLen &&
+                   write(fds[1], Trailer, trailerLen) == trailerLen,
+                   "Wrote to socket");
+    close(fds[1]);
+
+    TestIndex = 0;
+    le_json_SyncParse(fds[0], &OnEvent, &OnError, NULL);
+    CheckTrailer(fds[0], "Socket");
+
+    close(fds[0]);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event handler for the string slice test.
+ */
+//--------------------------------------------------------------------------------------------------
+static void OnSliceEvent
+(
+    le_json_Event_t event
+)
+{
+    const char *slicePtr;
+    size_t len;
+
+    switch (event)
+    {
+        case LE_JSON_OBJECT_START:
+            le_json_SetStringSlices(true);
+            break;
+
+        case LE_JSON_STRING:
+            slicePtr = le_json_GetStringSlice(&len);
+            if (len == LONG_STRING_BYTES)
+            {
+                LE_TEST_OK(slicePtr[0] == 'a' && slicePtr[len - 1] == 'a' && slicePtr[len] == '"',
+                           "Got long string slice");
+            }
+            else
+            {
+                LE_TEST_OK(strcmp(le_json_GetString(), "short") == 0, "Got short string");
+            }
+            break;
+
+        case LE_JSON_DOC_END:
+            le_json_Cleanup(le_json_GetSession());
+            break;
+
+        default:
+            break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event handler for the long string test.
+ */
+//--------------------------------------------------------------------------------------------------
+static void OnLongStringEvent
+(
+    le_json_Event_t event
+)
+{
+    LE_UNUSED(event);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Error handler for the long string test.
+ */
+//--------------------------------------------------------------------------------------------------
+static void OnLongStringError
+(
+    le_json_Error_t  error,
+    const char      *msg
+)
+{
+    LE_TEST_INFO("Parse error (%d): %s", error, msg);
+    LongStringError = (error == LE_JSON_READ_ERROR);
+    le_json_Cleanup(le_json_GetSession());
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a string that's too long for the parser's buffer, with and without string slices.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestStringSlices
+(
+    void
+)
+{
+    static const char prefix[] = "{ \"long\": \"";
+    static const char suffix[] = "\", \"s\": \"short\" }";
+    static char json[sizeof(prefix) + LONG_STRING_BYTES + sizeof(suffix)];
+
+    strcpy(json, prefix);
+    memset(json + strlen(prefix), 'a', LONG_STRING_BYTES);
+    strcpy(json + strlen(prefix) + LONG_STRING_BYTES, suffix);
+
+    le_json_SyncParseString(json, &OnSliceEvent, &OnError, NULL);
+
+    LongStringError = false;
+    le_json_SyncParseString(json, &OnLongStringEvent, &OnLongStringError, NULL);
+    LE_TEST_OK(LongStringError, "Long string rejected without string slices");
+}
+
 COMPONENT_INIT
 {
     int testCount = NUM_ARRAY_MEMBERS(Expected) * 4 + 3;
 
     LE_TEST_INFO("======== BEGIN JSON TEST ========");
-    LE_TEST_PLAN(testCount * 2);
+    LE_TEST_PLAN(testCount * 2 + (testCount + 2) * 3 + 3);
 
     TestIndex = 0;
     le_json_SyncParseString(StaticJson, &OnEvent, &OnError, NULL);
 
+    TestFile();
+    TestPipe();
+    TestSocket();
+    TestStringSlices();
+
     TestIndex = 0;
     LE_TEST_OK(le_json_ParseString(StaticJson, &OnEvent, &OnError, NULL) != NULL, "Created parser");
 
@@ -0,0 +1,148 @@
+/**
+ * This module is a microbenchmark for the logging API.  It measures how long LE_INFO() holds up the
+ * calling thread, with 1 to MAX_THREADS threads logging at the same time.  Build with
+ * LE_CONFIG_LOG_ASYNC=y to compare the asynchronous backend against direct output.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "timing.h"
+
+/// Maximum number of threads to run concurrently.
+#define MAX_THREADS         4
+
+/// Number of messages each thread logs.
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_MESSAGES     500
+#else
+#   define NUM_MESSAGES     10000
+#endif
+
+/// Per-thread times of the logging calls.
+static timing_Stats_t Results[MAX_THREADS];
+
+/// Released once all the threads of a run have been created, so they start logging together.
+static le_sem_Ref_t StartSem;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log a message, using a mix of formats.
+ *
+ * @return true.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool LogMessage
+(
+    uint32_t index,     ///< [IN] Number of the message.
+    void* contextPtr    ///< [IN] Not used.
+)
+{
+    LE_UNUSED(contextPtr);
+
+    switch (index % 3)
+    {
+        case 0:
+            LE_INFO("Message %" PRIu32, index);
+            break;
+        case 1:
+            LE_INFO("Message %" PRIu32 " from '%s' (0x%08" PRIx32 ")",
+                    index, le_thread_GetMyName(), index);
+            break;
+        default:
+            LE_INFO("Message %" PRIu32 ": %.3f, %" PRIu64,
+                    index, index / 7.0, (uint64_t)index * 1000003);
+            break;
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log NUM_MESSAGES messages, timing each call.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* LogThread
+(
+    void* contextPtr    ///< [IN] Pointer to this thread's results.
+)
+{
+    le_sem_Wait(StartSem);
+
+    timing_TimeCalls(LogMessage, NULL, NUM_MESSAGES, contextPtr);
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the benchmark with a given number of threads and report the results.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunTest
+(
+    int threadCount     ///< [IN] Number of threads logging at the same time.
+)
+{
+    le_thread_Ref_t threads[MAX_THREADS];
+    uint64_t totalUs = 0;
+    uint64_t maxUs = 0;
+    uint32_t count = 0;
+    int i;
+
+    for (i = 0; i < threadCount; i++)
+    {
+        char name[32];
+
+        snprintf(name, sizeof(name), "logPerf%d", i);
+        threads[i] = le_thread_Create(name, LogThread, &Results[i]);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+
+    for (i = 0; i < threadCount; i++)
+    {
+        le_sem_Post(StartSem);
+    }
+
+    for (i = 0; i < threadCount; i++)
+    {
+        le_thread_Join(threads[i], NULL);
+
+        totalUs += Results[i].totalUs;
+        count += Results[i].count;
+        if (Results[i].maxUs > maxUs)
+        {
+            maxUs = Results[i].maxUs;
+        }
+    }
+
+    LE_TEST_OK(count == (uint32_t)threadCount * NUM_MESSAGES,
+               "%d thread(s) logged %d messages each", threadCount, NUM_MESSAGES);
+    LE_TEST_INFO("%d thread(s): avg %" PRIu64 " ns, max %" PRIu64 " us per call",
+                 threadCount, totalUs * 1000 / count, maxUs);
+}
+
+
+COMPONENT_INIT
+{
+    int threadCount;
+
+    LE_TEST_PLAN(3);
+
+    LE_TEST_INFO("Asynchronous logging is %s",
+                 LE_CONFIG_IS_ENABLED(LE_CONFIG_LOG_ASYNC) ? "enabled" : "disabled");
+
+    StartSem = le_sem_Create("logPerfStart", 0);
+
+    for (threadCount = 1; threadCount <= MAX_THREADS; threadCount *= 2)
+    {
+        RunTest(threadCount);
+    }
+
+    LE_TEST_EXIT;
+}
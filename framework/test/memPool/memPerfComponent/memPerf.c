@@ -0,0 +1,158 @@
+/**
+ * This module is a microbenchmark for the le_mem module in the legato runtime library
+ * (liblegato.so).  It compares the throughput of allocating and releasing objects from a shared
+ * pool with and without per-thread caches, with 1 to MAX_THREADS threads hammering the same pool.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "timing.h"
+
+/// Maximum number of threads to run concurrently.
+#define MAX_THREADS         8
+
+/// Number of objects each thread holds at once.
+#define BURST_SIZE          8
+
+/// Number of allocate/release bursts each thread performs.
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_BURSTS       2000
+#else
+#   define NUM_BURSTS       50000
+#endif
+
+/// Per-thread cache size for the cached pool.
+#define THREAD_CACHE_SIZE   16
+
+typedef struct
+{
+    uint32_t id;
+    uint8_t  payload[60];
+}
+PerfObj_t;
+
+/// Pool allocated from without per-thread caches.
+static le_mem_PoolRef_t SharedPool;
+
+/// Pool allocated from with per-thread caches.
+static le_mem_PoolRef_t CachedPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread that repeatedly allocates a burst of objects from a pool and releases them again.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* AllocReleaseThread
+(
+    void* contextPtr    ///< [IN] Pool to allocate from.
+)
+{
+    le_mem_PoolRef_t pool = contextPtr;
+    PerfObj_t* objPtrs[BURST_SIZE];
+    int burst;
+    int i;
+
+    for (burst = 0; burst < NUM_BURSTS; burst++)
+    {
+        for (i = 0; i < BURST_SIZE; i++)
+        {
+            objPtrs[i] = le_mem_ForceAlloc(pool);
+            objPtrs[i]->id = i;
+        }
+
+        for (i = 0; i < BURST_SIZE; i++)
+        {
+            le_mem_Release(objPtrs[i]);
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs the allocate/release loop on a number of threads at once.
+ *
+ * @return Throughput, in allocate/release pairs per millisecond.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t RunThreads
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] Pool to allocate from.
+    int                 numThreads  ///< [IN] Number of threads to run.
+)
+{
+    le_thread_Ref_t threads[MAX_THREADS];
+    int i;
+
+    for (i = 0; i < numThreads; i++)
+    {
+        threads[i] = le_thread_Create("memPerf", AllocReleaseThread, pool);
+        le_thread_SetJoinable(threads[i]);
+    }
+
+    uint64_t startUs = timing_GetTimeUs();
+
+    for (i = 0; i < numThreads; i++)
+    {
+        le_thread_Start(threads[i]);
+    }
+
+    for (i = 0; i < numThreads; i++)
+    {
+        LE_ASSERT(le_thread_Join(threads[i], NULL) == LE_OK);
+    }
+
+    uint64_t elapsedUs = timing_GetTimeUs() - startUs;
+    uint64_t numOps = (uint64_t)numThreads * NUM_BURSTS * BURST_SIZE;
+
+    return (numOps * 1000) / (elapsedUs ? elapsedUs : 1);
+}
+
+
+COMPONENT_INIT
+{
+    le_mem_PoolStats_t stats;
+    int numThreads;
+
+    LE_TEST_PLAN(MAX_THREADS * 2 + 1);
+
+    SharedPool = le_mem_CreatePool("SharedPool", sizeof(PerfObj_t));
+    le_mem_ExpandPool(SharedPool, MAX_THREADS * BURST_SIZE);
+
+    CachedPool = le_mem_CreatePool("CachedPool", sizeof(PerfObj_t));
+    le_mem_ExpandPool(CachedPool, MAX_THREADS * (BURST_SIZE + THREAD_CACHE_SIZE));
+    le_mem_EnableThreadCache(CachedPool, THREAD_CACHE_SIZE);
+
+    LE_TEST_INFO("%d bursts of %d objects per thread", NUM_BURSTS, BURST_SIZE);
+    LE_TEST_INFO("threads | shared (ops/ms) | per-thread cache (ops/ms)");
+
+    for (numThreads = 1; numThreads <= MAX_THREADS; numThreads++)
+    {
+        uint64_t sharedRate = RunThreads(SharedPool, numThreads);
+        uint64_t cachedRate = RunThreads(CachedPool, numThreads);
+
+        LE_TEST_INFO("%7d | %15" PRIu64 " | %25" PRIu64, numThreads, sharedRate, cachedRate);
+
+        le_mem_GetStats(SharedPool, &stats);
+        LE_TEST_OK(stats.numBlocksInUse == 0, "all shared pool blocks released (%d threads)",
+                   numThreads);
+
+        // Thread caches are flushed back to the pool when their threads exit.
+        le_mem_GetStats(CachedPool, &stats);
+        LE_TEST_OK(stats.numBlocksInUse == 0, "all cached pool blocks released (%d threads)",
+                   numThreads);
+    }
+
+    LE_TEST_BEGIN_SKIP(!LE_CONFIG_IS_ENABLED(LE_CONFIG_MEM_POOL_STATS), 1);
+    le_mem_GetStats(CachedPool, &stats);
+    LE_TEST_OK(stats.numAllocs == (uint64_t)NUM_BURSTS * BURST_SIZE *
+                                  (MAX_THREADS * (MAX_THREADS + 1) / 2),
+               "cached pool allocation count is exact (%" PRIu64 ")", stats.numAllocs);
+    LE_TEST_END_SKIP();
+
+    LE_TEST_EXIT;
+}
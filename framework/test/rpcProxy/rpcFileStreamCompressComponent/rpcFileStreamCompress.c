@@ -0,0 +1,722 @@
+/**
+ * This module tests RPC Proxy file stream compression.  It checks the codec on its own, and then
+ * passes file streams between two RPC Proxy "sides" in the same process, with local socket pairs
+ * standing in for the le_comm network link.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "le_rpcProxy.h"
+#include "le_rpcProxyNetwork.h"
+#include "le_rpcProxyEventHandler.h"
+#include "le_rpcProxyFileStream.h"
+#include "le_rpcProxyCompress.h"
+
+/// Maximum size of an IPC message payload.
+#define MAX_PAYLOAD_SIZE    512
+
+/// Protocol of the IPC messages carrying the file descriptors.
+#define PROTOCOL_ID         "rpcFileStreamCompress"
+
+/// Service the file streams belong to.
+#define SERVICE_ID          7
+
+/// Largest amount of data sent through a file stream.
+#define MAX_DATA_SIZE       (64 * 1024)
+
+/// Names of the two sides.
+#define SIDE_A              "sideA"
+#define SIDE_B              "sideB"
+
+/// Session the IPC messages belong to.  It is never opened.
+static le_msg_SessionRef_t SessionRef;
+
+/// Links between the sides: [0] carries messages to side B, [1] carries messages to side A.
+/// Element [i][0] is written to, element [i][1] is read from.
+static int LinkFds[2][2];
+
+/// Thread running the event loop.
+static le_thread_Ref_t MainThread;
+
+/// Last Proxy Message ID handed out.
+static uint32_t ProxyMessageId;
+
+/// Remove the compression offer from data requests, like a side without compression support.
+static bool IsOfferStripped;
+
+/// Data being sent through the current file stream, and what came out of the other end.
+static uint8_t SentData[MAX_DATA_SIZE];
+static uint8_t ReceivedData[MAX_DATA_SIZE];
+static size_t DataSize;
+static size_t ReceivedSize;
+
+/// Write end of the pipe feeding the current file stream, and read end of the pipe it empties into.
+static int SourceFd;
+static int DestinationFd;
+
+/// Counters at the start of the current file stream.
+static rpcFStream_CompressionStats_t StartStats;
+
+/// Name of the current file stream test.
+static const char* TestName;
+
+/// State of the pseudo-random data generator.
+static uint32_t RandomState = 0x12345678;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the next pseudo-random number.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t NextRandom
+(
+    void
+)
+{
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+    return RandomState;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a buffer with text that compresses well.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillText
+(
+    uint8_t* bufPtr,    ///< [OUT] Buffer.
+    size_t size         ///< [IN] Size of buffer.
+)
+{
+    static const char* words[] = { "legato ", "rpc ", "proxy ", "file ", "stream ", "data\n" };
+    size_t i = 0;
+
+    while (i < size)
+    {
+        const char* wordPtr = words[NextRandom() % NUM_ARRAY_MEMBERS(words)];
+
+        while ((*wordPtr != '\0') && (i < size))
+        {
+            bufPtr[i++] = (uint8_t)*wordPtr++;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a buffer with data that doesn't compress.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillRandom
+(
+    uint8_t* bufPtr,    ///< [OUT] Buffer.
+    size_t size         ///< [IN] Size of buffer.
+)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        bufPtr[i] = (uint8_t)NextRandom();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the codec gets back what it was given.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RoundTrip
+(
+    const uint8_t* dataPtr,     ///< [IN] Data.
+    size_t size,                ///< [IN] Size of data.
+    size_t* encodedSizePtr      ///< [OUT] Size of the compressed data.
+)
+{
+    static uint8_t encoded[MAX_DATA_SIZE * 2];
+    static uint8_t decoded[MAX_DATA_SIZE];
+    size_t decodedSize = 0;
+
+    *encodedSizePtr = rpcCompress_Encode(dataPtr, size, encoded, sizeof(encoded));
+    if (*encodedSizePtr == 0)
+    {
+        return false;
+    }
+
+    return (rpcCompress_Decode(encoded, *encodedSizePtr, decoded, sizeof(decoded),
+                               &decodedSize) == LE_OK) &&
+           (decodedSize == size) &&
+           (memcmp(decoded, dataPtr, size) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the codec on its own.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestCodec
+(
+    void
+)
+{
+    static uint8_t data[MAX_DATA_SIZE];
+    uint8_t encoded[64];
+    uint8_t decoded[64];
+    size_t encodedSize;
+    size_t decodedSize;
+    int i;
+
+    FillText(data, 4096);
+    LE_TEST_OK(RoundTrip(data, 4096, &encodedSize) && (encodedSize < 4096 / 2),
+               "text: 4096 bytes compress to %" PRIuS, encodedSize);
+
+    memset(data, 0, sizeof(data));
+    LE_TEST_OK(RoundTrip(data, RPC_COMPRESS_MAX_BLOCK_SIZE, &encodedSize) && (encodedSize < 512),
+               "zeros: %d bytes compress to %" PRIuS, RPC_COMPRESS_MAX_BLOCK_SIZE, encodedSize);
+
+    FillRandom(data, 512);
+    LE_TEST_OK(rpcCompress_Encode(data, 512, SentData, 511) == 0,
+               "random data is reported as incompressible");
+
+    bool ok = true;
+    for (i = 0; (i < 500) && ok; i++)
+    {
+        size_t size = 1 + NextRandom() % 2048;
+        size_t split = NextRandom() % size;
+
+        // Mix of text and noise, to get literal runs and matches of all lengths.
+        FillText(data, split);
+        FillRandom(data + split, size - split);
+        ok = RoundTrip(data, size, &encodedSize);
+    }
+    LE_TEST_OK(ok, "mixed blocks of random sizes round-trip");
+
+    FillText(data, 256);
+    encodedSize = rpcCompress_Encode(data, 256, SentData, sizeof(SentData));
+    ok = (rpcCompress_Decode(SentData, encodedSize / 2, ReceivedData, sizeof(ReceivedData),
+                             &decodedSize) != LE_OK) || (decodedSize < 256);
+    LE_TEST_OK(ok && (rpcCompress_Decode(SentData, encodedSize, decoded, sizeof(decoded),
+                                         &decodedSize) == LE_OVERFLOW),
+               "truncated block and short output buffer are detected");
+
+    // A match reaching back before the start of the output.
+    encoded[0] = 0x10;
+    encoded[1] = 'x';
+    encoded[2] = 2;
+    encoded[3] = 0;
+    LE_TEST_OK(rpcCompress_Decode(encoded, 4, decoded, sizeof(decoded),
+                                  &decodedSize) == LE_FORMAT_ERROR,
+               "bad match offset is detected");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write all of a buffer to a file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteAll
+(
+    int fd,             ///< [IN] File descriptor.
+    const void* buf,    ///< [IN] Data.
+    size_t len          ///< [IN] Size of data.
+)
+{
+    const uint8_t* dataPtr = buf;
+
+    while (len > 0)
+    {
+        ssize_t result = write(fd, dataPtr, len);
+
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return LE_COMM_ERROR;
+        }
+
+        dataPtr += result;
+        len -= result;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * le_comm stand-in: send data to the far side.  The handle is the socket's file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_comm_Send
+(
+    void* handle,
+    const void* buf,
+    size_t len
+)
+{
+    return WriteAll((int)(intptr_t)handle, buf, len);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * le_comm stand-in: send a list of data segments to the far side.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_comm_SendVector
+(
+    void* handle,
+    const le_comm_Segment_t* segments,
+    size_t count
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (le_comm_Send(handle, segments[i].buf, segments[i].len) != LE_OK)
+        {
+            return LE_COMM_ERROR;
+        }
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * le_comm stand-in: receive data from the far side.  Messages are written whole before the far
+ * side gets to run, so this waits for all the data asked for.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_comm_Receive
+(
+    void* handle,
+    void* buf,
+    size_t* len
+)
+{
+    int fd = (int)(intptr_t)handle;
+    uint8_t* dataPtr = buf;
+    size_t received = 0;
+
+    while (received < *len)
+    {
+        ssize_t result = read(fd, dataPtr + received, *len - received);
+
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return LE_COMM_ERROR;
+        }
+        if (result == 0)
+        {
+            break;
+        }
+        received += result;
+    }
+
+    *len = received;
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stand-ins for the parts of the RPC Proxy that file streams use.  Messages sent to a side are
+ * written to the link that side reads from.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcProxy_SendMsg
+(
+    const char* systemName,
+    void* messagePtr
+)
+{
+    rpcProxy_FileStreamMessage_t* fileStreamMsgPtr = messagePtr;
+    int link = (strcmp(systemName, SIDE_B) == 0) ? 0 : 1;
+    uint32_t writeCount;
+
+    if (fileStreamMsgPtr->commonHeader.type != RPC_PROXY_FILESTREAM_MESSAGE)
+    {
+        LE_TEST_FATAL("Unexpected message type %" PRIu8, fileStreamMsgPtr->commonHeader.type);
+    }
+
+    if (IsOfferStripped && (fileStreamMsgPtr->metaData.fileStreamFlags & RPC_FSTREAM_REQUEST_DATA))
+    {
+        fileStreamMsgPtr->metaData.fileStreamFlags &= ~RPC_FSTREAM_COMPRESSED;
+    }
+
+    return rpcProxy_SendVariableLengthMsg((void*)(intptr_t)LinkFds[link][0], messagePtr,
+                                          &writeCount);
+}
+
+uint32_t rpcProxy_GenerateProxyMessageId
+(
+    void
+)
+{
+    return ++ProxyMessageId;
+}
+
+le_result_t rpcEventHandler_RepackOutgoingContext
+(
+    le_pack_SemanticTag_t    tagId,
+    void*                    contextPtr,
+    void**                   contextPtrPtr,
+    rpcProxy_Message_t*      proxyMessagePtr
+)
+{
+    LE_UNUSED(tagId);
+    LE_UNUSED(proxyMessagePtr);
+
+    *contextPtrPtr = contextPtr;
+    return LE_OK;
+}
+
+le_result_t rpcEventHandler_RepackIncomingContext
+(
+    le_pack_SemanticTag_t    tagId,
+    void*                    contextPtr,
+    void**                   contextPtrPtr,
+    rpcProxy_Message_t*      proxyMessagePtr
+)
+{
+    LE_UNUSED(tagId);
+    LE_UNUSED(proxyMessagePtr);
+
+    *contextPtrPtr = contextPtr;
+    return LE_OK;
+}
+
+void rpcProxyNetwork_DeleteNetworkCommunicationChannelByHandle
+(
+    void* handle
+)
+{
+    LE_TEST_FATAL("Unexpected deletion of communication channel %p", handle);
+}
+
+le_msg_MessageRef_t rpcProxy_GetMsgRefById
+(
+    uint32_t proxyId
+)
+{
+    LE_UNUSED(proxyId);
+    return NULL;
+}
+
+le_msg_ServiceRef_t rpcProxy_GetServiceRefById
+(
+    uint32_t serviceId
+)
+{
+    LE_UNUSED(serviceId);
+    return NULL;
+}
+
+le_msg_SessionRef_t rpcProxy_GetSessionRefById
+(
+    uint32_t serviceId
+)
+{
+    LE_UNUSED(serviceId);
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive the messages waiting on a link, as the RPC Proxy's network message handler would.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LinkHandler
+(
+    int fd,
+    short events
+)
+{
+    // The stream state machine finishes by updating the network message state it is part of.
+    static NetworkMessageState_t msgState;
+    rpcProxy_FileStreamMessage_t* messagePtr = (rpcProxy_FileStreamMessage_t*)msgState.buffer;
+    const char* systemName = le_fdMonitor_GetContextPtr();
+    void* handle = (void*)(intptr_t)fd;
+    int pending = 0;
+
+    LE_UNUSED(events);
+
+    do
+    {
+        size_t size = RPC_PROXY_COMMON_HEADER_SIZE;
+
+        if ((le_comm_Receive(handle, messagePtr, &size) != LE_OK) ||
+            (size != RPC_PROXY_COMMON_HEADER_SIZE))
+        {
+            LE_TEST_FATAL("Failed to receive message header");
+        }
+        messagePtr->commonHeader.id = be32toh(messagePtr->commonHeader.id);
+        messagePtr->commonHeader.serviceId = be32toh(messagePtr->commonHeader.serviceId);
+
+        if (rpcProxy_InitializeStreamState(&msgState.streamState, messagePtr) != LE_OK)
+        {
+            LE_TEST_FATAL("Failed to start receiving message from %s", systemName);
+        }
+
+        // The whole message has been received even if it is refused.  Once one side has closed a
+        // stream, the messages already on their way to it for that stream are refused.
+        if (rpcFStream_ProcessFileStreamMessage(handle, systemName, &msgState.streamState,
+                                                messagePtr) != LE_OK)
+        {
+            LE_TEST_INFO("File stream message from %s refused", systemName);
+        }
+
+        if (ioctl(fd, FIONREAD, &pending) != 0)
+        {
+            pending = 0;
+        }
+    }
+    while (pending > 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread writing the test data into the file stream's source pipe.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* WriterThread
+(
+    void* contextPtr    ///< [IN] Unused.
+)
+{
+    LE_UNUSED(contextPtr);
+
+    if (WriteAll(SourceFd, SentData, DataSize) != LE_OK)
+    {
+        LE_TEST_FATAL("Failed to write test data (%m)");
+    }
+    close(SourceFd);
+
+    return NULL;
+}
+
+
+static void RunNextTest(void* param1Ptr, void* param2Ptr);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread reading what comes out of the file stream, until the stream is closed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ReaderThread
+(
+    void* contextPtr    ///< [IN] Unused.
+)
+{
+    ssize_t result;
+
+    LE_UNUSED(contextPtr);
+
+    ReceivedSize = 0;
+    while ((result = read(DestinationFd, ReceivedData + ReceivedSize,
+                          sizeof(ReceivedData) - ReceivedSize)) != 0)
+    {
+        if (result < 0)
+        {
+            if (errno != EINTR)
+            {
+                LE_TEST_FATAL("Failed to read test data (%m)");
+            }
+            continue;
+        }
+        ReceivedSize += result;
+        if (ReceivedSize == sizeof(ReceivedData))
+        {
+            break;
+        }
+    }
+    close(DestinationFd);
+
+    le_event_QueueFunctionToThread(MainThread, RunNextTest, NULL, NULL);
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set up a file stream from side A to side B, and start sending data through it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartFileStream
+(
+    const char* name,       ///< [IN] Name of the test.
+    size_t size,            ///< [IN] Amount of data to send.
+    bool isOfferStripped    ///< [IN] Whether side B acts as if it can't take compressed data.
+)
+{
+    rpcProxy_MessageMetadata_t metaData;
+    int pipeFds[2];
+
+    TestName = name;
+    DataSize = size;
+    IsOfferStripped = isOfferStripped;
+    rpcFStream_GetCompressionStats(&StartStats);
+
+    if (pipe(pipeFds) != 0)
+    {
+        LE_TEST_FATAL("Failed to create pipe (%m)");
+    }
+    SourceFd = pipeFds[1];
+
+    // Side A gets the read end of the pipe in an IPC message, and makes an outgoing stream of it.
+    memset(&metaData, 0, sizeof(metaData));
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(SessionRef);
+    le_msg_SetFd(msgRef, pipeFds[0]);
+    if (rpcFStream_HandleFileDescriptor(msgRef, &metaData, SERVICE_ID, SIDE_B) != LE_OK)
+    {
+        LE_TEST_FATAL("%s: side A failed to create the stream", name);
+    }
+    le_msg_ReleaseMsg(msgRef);
+
+    // Side B receives the stream in the proxied message, and hands on the read end of its pipe.
+    msgRef = le_msg_CreateMsg(SessionRef);
+    if (rpcFStream_HandleStreamId(msgRef, &metaData, SERVICE_ID, SIDE_A) != LE_OK)
+    {
+        LE_TEST_FATAL("%s: side B failed to create the stream", name);
+    }
+    DestinationFd = le_msg_GetFd(msgRef);
+    le_msg_ReleaseMsg(msgRef);
+    if (DestinationFd < 0)
+    {
+        LE_TEST_FATAL("%s: side B has no local fd", name);
+    }
+
+    le_thread_Ref_t reader = le_thread_Create("fsReader", ReaderThread, NULL);
+    le_thread_Start(reader);
+    le_thread_Ref_t writer = le_thread_Create("fsWriter", WriterThread, NULL);
+    le_thread_Start(writer);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the results of the file stream that just finished, and start the next one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunNextTest
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    static int testNum = 0;
+    rpcFStream_CompressionStats_t stats;
+
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    if (testNum > 0)
+    {
+        rpcFStream_GetCompressionStats(&stats);
+
+        uint64_t rawBytes = stats.rawBytes - StartStats.rawBytes;
+        uint64_t wireBytes = stats.wireBytes - StartStats.wireBytes;
+        uint32_t compressedPackets = stats.compressedPackets - StartStats.compressedPackets;
+        uint32_t rawPackets = stats.rawPackets - StartStats.rawPackets;
+
+        LE_TEST_OK((ReceivedSize == DataSize) && (memcmp(ReceivedData, SentData, DataSize) == 0),
+                   "%s: %" PRIuS " bytes arrived intact", TestName, ReceivedSize);
+        LE_TEST_INFO("%s: %" PRIu64 " bytes as %" PRIu64 ", %" PRIu32 " packets compressed, "
+                     "%" PRIu32 " raw, %" PRIu64 " us compressing, %" PRIu64 " us decompressing",
+                     TestName, rawBytes, wireBytes, compressedPackets, rawPackets,
+                     stats.encodeTimeUs - StartStats.encodeTimeUs,
+                     stats.decodeTimeUs - StartStats.decodeTimeUs);
+
+        switch (testNum)
+        {
+            case 1:
+                LE_TEST_OK((compressedPackets > 0) && (wireBytes < rawBytes),
+                           "%s: data was sent compressed", TestName);
+                break;
+
+            case 2:
+                LE_TEST_OK((compressedPackets == 0) && (rawPackets > 0),
+                           "%s: data was sent raw", TestName);
+                break;
+
+            case 3:
+                LE_TEST_OK((compressedPackets == 0) && (rawPackets == 0),
+                           "%s: compression was not used", TestName);
+                break;
+        }
+    }
+
+    testNum++;
+    switch (testNum)
+    {
+        case 1:
+            FillText(SentData, MAX_DATA_SIZE);
+            StartFileStream("text", MAX_DATA_SIZE, false);
+            break;
+
+        case 2:
+            FillRandom(SentData, MAX_DATA_SIZE / 4);
+            StartFileStream("random", MAX_DATA_SIZE / 4, false);
+            break;
+
+        case 3:
+            FillText(SentData, MAX_DATA_SIZE / 4);
+            StartFileStream("no offer", MAX_DATA_SIZE / 4, true);
+            break;
+
+        default:
+            LE_TEST_EXIT;
+    }
+}
+
+
+COMPONENT_INIT
+{
+    static const char* sideNames[] = { SIDE_B, SIDE_A };
+    int i;
+
+    LE_TEST_PLAN(12);
+
+    TestCodec();
+
+    MainThread = le_thread_GetCurrent();
+    le_msg_ProtocolRef_t protocolRef = le_msg_GetProtocolRef(PROTOCOL_ID, MAX_PAYLOAD_SIZE);
+    SessionRef = le_msg_CreateSession(protocolRef, "rpcFileStreamCompress");
+    rpcFStream_InitFileStreamPool();
+
+    // Each link is read by the side it carries messages to; messages on it come from the other.
+    for (i = 0; i < 2; i++)
+    {
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, LinkFds[i]) != 0)
+        {
+            LE_TEST_FATAL("Failed to create socket pair (%m)");
+        }
+        le_fdMonitor_Ref_t monitor = le_fdMonitor_Create(sideNames[i], LinkFds[i][1],
+                                                         LinkHandler, POLLIN);
+        le_fdMonitor_SetContextPtr(monitor, (void*)sideNames[1 - i]);
+    }
+
+    RunNextTest(NULL, NULL);
+}
@@ -0,0 +1,696 @@
+/**
+ * This module tests the send lanes of the RPC Proxy Network Service: the Client-Request window,
+ * the request queue, and the ordering of bulk (File Stream) and control messages around queued
+ * Client-Requests.  The le_comm link and the rest of the RPC Proxy are replaced by stand-ins that
+ * record the messages written to the link.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "le_rpcProxy.h"
+#include "le_rpcProxyConfig.h"
+#include "le_rpcProxyNetwork.h"
+#include "le_rpcProxyFileStream.h"
+
+/// Name of the far-side system.
+#define SYSTEM_NAME         "flowControlPeer"
+
+/// Service ID used by all the Client-Requests.
+#define SERVICE_ID          7
+
+/// Proxy Message IDs of the bulk and control messages, kept apart from the Client-Requests.
+#define BULK_ID_BASE        1000
+#define CONTROL_ID_BASE     2000
+
+/// Size of the window and of the request queue.
+#define WINDOW              RPC_PROXY_NETWORK_MAX_IN_FLIGHT_REQUESTS
+#define QUEUE_SIZE          RPC_PROXY_NETWORK_MAX_QUEUED_REQUESTS
+
+/// Largest number of writes recorded.
+#define MAX_WRITES          (4 * (WINDOW + QUEUE_SIZE) + 16)
+
+/// Handle of the stand-in le_comm link.
+#define LINK_HANDLE         ((void*)(uintptr_t)0x1234)
+
+/// Size of the IPC messages used as the payload of the Client-Requests.
+#define MAX_PAYLOAD_SIZE    16
+
+/// Proxy Message IDs written to the link, in order.
+static uint32_t WrittenIds[MAX_WRITES];
+static size_t WrittenCount;
+
+/// Number of written messages already checked.
+static size_t CheckedCount;
+
+/// IPC messages standing in for a request that needs a response, and one that doesn't.
+static le_msg_MessageRef_t NeedsResponseMsgRef;
+static le_msg_MessageRef_t NoResponseMsgRef;
+
+/// Local service the IPC messages are sent to.
+static le_msg_LocalService_t FlowControlService;
+LE_MEM_DEFINE_STATIC_POOL(FlowControlMessage, 2, LE_MSG_LOCAL_HEADER_SIZE + MAX_PAYLOAD_SIZE);
+
+/// Proxy Message IDs of the Client-Requests queued when the window was exhausted.
+static uint32_t QueuedIds[QUEUE_SIZE];
+static size_t QueuedCount;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * le_comm stand-ins: the link is always created and connected at once.
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_comm_Create
+(
+    const int argc,
+    const char *argv[],
+    le_result_t* resultPtr
+)
+{
+    LE_UNUSED(argc);
+    LE_UNUSED(argv);
+
+    *resultPtr = LE_OK;
+    return LINK_HANDLE;
+}
+
+le_result_t le_comm_RegisterHandleMonitor
+(
+    void* handle,
+    le_comm_CallbackHandlerFunc_t handlerFunc,
+    short events
+)
+{
+    LE_UNUSED(handle);
+    LE_UNUSED(handlerFunc);
+    LE_UNUSED(events);
+
+    return LE_OK;
+}
+
+le_result_t le_comm_Connect
+(
+    void* handle
+)
+{
+    LE_UNUSED(handle);
+    return LE_OK;
+}
+
+le_result_t le_comm_Delete
+(
+    void* handle
+)
+{
+    LE_UNUSED(handle);
+    return LE_OK;
+}
+
+int le_comm_GetId
+(
+    void* handle
+)
+{
+    return (handle == NULL) ? -1 : 1;
+}
+
+void* le_comm_GetParentHandle
+(
+    void* handle
+)
+{
+    return handle;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * RPC Proxy stand-in: record a message written to the link.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcProxy_WriteMsg
+(
+    const char* systemName,
+    NetworkRecord_t* networkRecordPtr,
+    void* messagePtr
+)
+{
+    LE_UNUSED(systemName);
+    LE_UNUSED(networkRecordPtr);
+
+    LE_ASSERT(WrittenCount < MAX_WRITES);
+    WrittenIds[WrittenCount++] = ((rpcProxy_CommonHeader_t*) messagePtr)->id;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * RPC Proxy stand-in: send a message the way rpcProxy_SendMsg() does, returning the lane's
+ * decision instead of hiding it.
+ *
+ * @return
+ *      - LE_OK, if the message has been written,
+ *      - LE_WOULD_BLOCK, if it has been queued,
+ *      - otherwise, the error from rpcProxyNetwork_AdmitMsg().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AdmitAndWrite
+(
+    void* messagePtr    ///< [IN] Proxy Message.
+)
+{
+    NetworkRecord_t* networkRecordPtr =
+        le_hashmap_Get(rpcProxyNetwork_GetNetworkRecordHashMapByName(), SYSTEM_NAME);
+
+    if ((networkRecordPtr == NULL) || (networkRecordPtr->state == NETWORK_DOWN))
+    {
+        return LE_COMM_ERROR;
+    }
+
+    le_result_t result = rpcProxyNetwork_AdmitMsg(SYSTEM_NAME, networkRecordPtr, messagePtr);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    return rpcProxy_WriteMsg(SYSTEM_NAME, networkRecordPtr, messagePtr);
+}
+
+le_result_t rpcProxy_SendMsg
+(
+    const char* systemName,
+    void* messagePtr
+)
+{
+    LE_UNUSED(systemName);
+
+    le_result_t result = AdmitAndWrite(messagePtr);
+    return (result == LE_WOULD_BLOCK) ? LE_OK : result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stand-ins for the parts of the RPC Proxy that the Network Service uses, but which aren't needed
+ * by this test.
+ */
+//--------------------------------------------------------------------------------------------------
+rpcProxy_SystemServiceConfig_t* rpcProxyConfig_GetSystemServiceArray
+(
+    uint32_t index
+)
+{
+    static rpcProxy_SystemServiceConfig_t systemServiceArray[] =
+    {
+        { SYSTEM_NAME, "link", NULL, NULL, 0, NULL },
+        { NULL, NULL, NULL, NULL, 0, NULL }
+    };
+
+    LE_ASSERT(index < NUM_ARRAY_MEMBERS(systemServiceArray));
+    return &systemServiceArray[index];
+}
+
+le_hashmap_Ref_t rpcProxy_GetExpiryTimerRefByProxyId
+(
+    void
+)
+{
+    static le_hashmap_Ref_t expiryTimerRefByProxyId = NULL;
+
+    if (expiryTimerRefByProxyId == NULL)
+    {
+        expiryTimerRefByProxyId = le_hashmap_Create("FlowControlExpiryTimers",
+                                                    4,
+                                                    le_hashmap_HashVoidPointer,
+                                                    le_hashmap_EqualsVoidPointer);
+    }
+
+    return expiryTimerRefByProxyId;
+}
+
+uint32_t rpcProxy_GenerateProxyMessageId
+(
+    void
+)
+{
+    static uint32_t nextId = CONTROL_ID_BASE + 500;
+
+    return nextId++;
+}
+
+void rpcProxy_AsyncRecvHandler
+(
+    void* handle,
+    short events
+)
+{
+    LE_UNUSED(handle);
+    LE_UNUSED(events);
+}
+
+le_result_t rpcProxy_RecvStream
+(
+    void* handle,
+    StreamState_t* streamStatePtr,
+    void* proxyMessagePtr
+)
+{
+    LE_UNUSED(handle);
+    LE_UNUSED(streamStatePtr);
+    LE_UNUSED(proxyMessagePtr);
+
+    return LE_FAULT;
+}
+
+void rpcProxy_AdvertiseServices
+(
+    const char* systemName
+)
+{
+    LE_UNUSED(systemName);
+}
+
+void rpcProxy_HideServices
+(
+    const char* systemName
+)
+{
+    LE_UNUSED(systemName);
+}
+
+void rpcProxy_DisconnectSessions
+(
+    const char* systemName
+)
+{
+    LE_UNUSED(systemName);
+}
+
+void rpcFStream_DeleteStreamsBySystemName
+(
+    const char* systemName
+)
+{
+    LE_UNUSED(systemName);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a Client-Request.  Unless stated otherwise, it needs a response.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SendRequestMsg
+(
+    uint32_t id,                ///< [IN] Proxy Message ID.
+    le_msg_MessageRef_t msgRef  ///< [IN] IPC message carried by the request.
+)
+{
+    rpcProxy_Message_t message;
+
+    memset(&message, 0, sizeof(message));
+    message.commonHeader.id = id;
+    message.commonHeader.serviceId = SERVICE_ID;
+    message.commonHeader.type = RPC_PROXY_CLIENT_REQUEST;
+    message.msgRef = msgRef;
+
+    return AdmitAndWrite(&message);
+}
+
+static le_result_t SendRequest
+(
+    uint32_t id     ///< [IN] Proxy Message ID.
+)
+{
+    return SendRequestMsg(id, NeedsResponseMsgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a File Stream message.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SendBulk
+(
+    uint32_t id     ///< [IN] Proxy Message ID.
+)
+{
+    static rpcProxy_FileStreamMessage_t message;
+
+    memset(&message, 0, sizeof(message));
+    message.commonHeader.id = id;
+    message.commonHeader.serviceId = SERVICE_ID;
+    message.commonHeader.type = RPC_PROXY_FILESTREAM_MESSAGE;
+    message.metaData.fileStreamId = 1;
+    message.metaData.isFileStreamValid = true;
+    message.payloadSize = 1;
+
+    return AdmitAndWrite(&message);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a control message (a Keep-Alive Request).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SendControl
+(
+    uint32_t id     ///< [IN] Proxy Message ID.
+)
+{
+    rpcProxy_KeepAliveMessage_t message;
+
+    memset(&message, 0, sizeof(message));
+    message.commonHeader.id = id;
+    message.commonHeader.type = RPC_PROXY_KEEPALIVE_REQUEST;
+
+    return AdmitAndWrite(&message);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that exactly the given messages have been written since the last check, in order.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckWritten
+(
+    const char* what,       ///< [IN] Description of the check.
+    const uint32_t* idsPtr, ///< [IN] Expected Proxy Message IDs.
+    size_t count            ///< [IN] Number of expected messages.
+)
+{
+    bool match = (WrittenCount - CheckedCount == count);
+    size_t i;
+
+    for (i = 0; match && (i < count); i++)
+    {
+        match = (WrittenIds[CheckedCount + i] == idsPtr[i]);
+    }
+
+    if (!match)
+    {
+        for (i = CheckedCount; i < WrittenCount; i++)
+        {
+            LE_TEST_INFO("written[%" PRIuS "] = %" PRIu32, i, WrittenIds[i]);
+        }
+    }
+
+    LE_TEST_OK(match, "%s", what);
+    CheckedCount = WrittenCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the flow control state of the link.
+ */
+//--------------------------------------------------------------------------------------------------
+static NetworkFlowControl_t* GetFlowControl
+(
+    void
+)
+{
+    NetworkRecord_t* networkRecordPtr =
+        le_hashmap_Get(rpcProxyNetwork_GetNetworkRecordHashMapByName(), SYSTEM_NAME);
+
+    LE_ASSERT(networkRecordPtr != NULL);
+    return &networkRecordPtr->flowControl;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bring the link down and check that everything waiting on it has been dropped, then bring it back
+ * up and check that its window is whole again.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckLinkReset
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    CheckWritten("nothing queued is written after the link went down", NULL, 0);
+
+    LE_TEST_OK(rpcProxyNetwork_CreateNetworkCommunicationChannel(SYSTEM_NAME) == LE_OK,
+               "link is back up");
+    LE_TEST_OK(SendRequest(600) == LE_OK, "Client-Request is written at once on the new link");
+
+    uint32_t expected[] = { 600 };
+    CheckWritten("only the new Client-Request is written", expected, NUM_ARRAY_MEMBERS(expected));
+
+    LE_TEST_EXIT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the queued Client-Requests that are still wanted go out in order once credits come
+ * back, then take the link down with messages still waiting.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckQueueDrained
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    NetworkFlowControl_t* flowControlPtr = GetFlowControl();
+    size_t sent = (QueuedCount < WINDOW) ? QueuedCount : WINDOW;
+    uint32_t id;
+
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    CheckWritten("queued Client-Requests are written in order, without the ones that ended",
+                 QueuedIds, sent);
+
+    // Fill the window, then leave a Client-Request and a bulk message waiting
+    for (id = 500; flowControlPtr->credits > 0; id++)
+    {
+        SendRequest(id);
+    }
+    CheckedCount = WrittenCount;
+
+    LE_TEST_OK(SendRequest(id) == LE_WOULD_BLOCK, "Client-Request waits for the window");
+    LE_TEST_OK(SendBulk(BULK_ID_BASE + 2) == LE_WOULD_BLOCK, "bulk message is queued");
+
+    rpcProxyNetwork_DeleteNetworkCommunicationChannel(SYSTEM_NAME);
+
+    LE_TEST_OK(flowControlPtr->credits == WINDOW, "link down returns all credits");
+    LE_TEST_OK(le_dls_IsEmpty(&flowControlPtr->inFlightList), "link down forgets requests in flight");
+    LE_TEST_OK((flowControlPtr->queueDepth[NETWORK_LANE_REQUEST] == 0) &&
+               (flowControlPtr->queueDepth[NETWORK_LANE_BULK] == 0) &&
+               le_dls_IsEmpty(&flowControlPtr->queue[NETWORK_LANE_REQUEST]) &&
+               le_dls_IsEmpty(&flowControlPtr->queue[NETWORK_LANE_BULK]),
+               "link down empties the queues");
+
+    // Requests from before the reset are not known any more
+    rpcProxyNetwork_CompleteRequest(id, LE_TERMINATED);
+    rpcProxyNetwork_CompleteRequest(1, LE_OK);
+    LE_TEST_OK(flowControlPtr->credits == WINDOW, "completing a forgotten request does nothing");
+
+    le_event_QueueFunction(CheckLinkReset, NULL, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a bulk message only waits for the Client-Requests queued before it, then fill the
+ * request queue, and end some of the queued requests without sending them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckBulkReleased
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    NetworkFlowControl_t* flowControlPtr = GetFlowControl();
+    uint32_t id;
+    size_t i;
+
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    uint32_t expected[] = { WINDOW + 1, BULK_ID_BASE + 1 };
+    CheckWritten("queued Client-Request is written before the bulk message behind it",
+                 expected, NUM_ARRAY_MEMBERS(expected));
+    LE_TEST_OK((flowControlPtr->credits == 0) &&
+               (flowControlPtr->queueDepth[NETWORK_LANE_REQUEST] == 1),
+               "Client-Request queued after the bulk message still waits for the window");
+
+    // Fill the request queue (WINDOW + 2 is already in it)
+    QueuedCount = 0;
+    QueuedIds[QueuedCount++] = WINDOW + 2;
+    for (id = WINDOW + 3; id < WINDOW + 2 + QUEUE_SIZE; id++)
+    {
+        if (SendRequest(id) != LE_WOULD_BLOCK)
+        {
+            break;
+        }
+        QueuedIds[QueuedCount++] = id;
+    }
+    LE_TEST_OK(QueuedCount == QUEUE_SIZE, "request queue takes %d Client-Requests", QUEUE_SIZE);
+    LE_TEST_OK(SendRequest(id) == LE_NO_MEMORY, "Client-Request is refused when the queue is full");
+
+    // One queued request times out, and the session of another is closed
+    rpcProxyNetwork_CompleteRequest(QueuedIds[1], LE_TIMEOUT);
+    rpcProxyNetwork_CompleteRequest(QueuedIds[2], LE_TERMINATED);
+    LE_TEST_OK(flowControlPtr->queueDepth[NETWORK_LANE_REQUEST] == QUEUE_SIZE - 2,
+               "ended Client-Requests leave the queue");
+    LE_TEST_OK(flowControlPtr->credits == 0, "ending queued Client-Requests returns no credit");
+    memmove(&QueuedIds[1], &QueuedIds[3], (QueuedCount - 3) * sizeof(QueuedIds[0]));
+    QueuedCount -= 2;
+
+    // Answer everything in flight
+    for (i = 2; i <= WINDOW + 1; i++)
+    {
+        rpcProxyNetwork_CompleteRequest(i, LE_OK);
+    }
+    CheckWritten("nothing is written until the queue is serviced", NULL, 0);
+
+    le_event_QueueFunction(CheckQueueDrained, NULL, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that nothing has overtaken the Client-Request queued when the window ran out, then give
+ * back one credit.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckBulkWaits
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    CheckWritten("bulk message doesn't overtake the queued Client-Request", NULL, 0);
+
+    rpcProxyNetwork_CompleteRequest(1, LE_OK);
+    LE_TEST_OK(GetFlowControl()->credits == 1, "Server-Response returns a credit");
+
+    le_event_QueueFunction(CheckBulkReleased, NULL, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Use up the window, and queue Client-Requests with bulk and control messages in between.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ExhaustWindow
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    uint32_t expected[WINDOW];
+    uint32_t id;
+    int okCount = 0;
+
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    LE_TEST_ASSERT(rpcProxyNetwork_CreateNetworkCommunicationChannel(SYSTEM_NAME) == LE_OK,
+                   "link is up");
+
+    LE_TEST_OK(SendRequestMsg(900, NoResponseMsgRef) == LE_OK,
+               "Client-Request without a response is written at once");
+    LE_TEST_OK(GetFlowControl()->credits == WINDOW, "it takes no credit");
+    CheckedCount = WrittenCount;
+
+    for (id = 1; id <= WINDOW; id++)
+    {
+        expected[id - 1] = id;
+        if (SendRequest(id) == LE_OK)
+        {
+            okCount++;
+        }
+    }
+    LE_TEST_OK(okCount == WINDOW, "%d Client-Requests are written at once", WINDOW);
+    CheckWritten("window's worth of Client-Requests is written in order", expected, WINDOW);
+    LE_TEST_OK(GetFlowControl()->credits == 0, "window is exhausted");
+
+    LE_TEST_OK(SendRequest(WINDOW + 1) == LE_WOULD_BLOCK,
+               "Client-Request waits when the window is exhausted");
+    LE_TEST_OK(SendBulk(BULK_ID_BASE + 1) == LE_WOULD_BLOCK, "bulk message is queued");
+    LE_TEST_OK(SendControl(CONTROL_ID_BASE + 1) == LE_OK, "control message is written at once");
+    LE_TEST_OK(SendRequest(WINDOW + 2) == LE_WOULD_BLOCK, "next Client-Request waits too");
+
+    uint32_t control[] = { CONTROL_ID_BASE + 1 };
+    CheckWritten("only the control message has been written", control, NUM_ARRAY_MEMBERS(control));
+
+    // Let the bulk lane be serviced before checking it
+    le_event_QueueFunction(CheckBulkWaits, NULL, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive the IPC messages used as the payload of the Client-Requests.  Once both have arrived,
+ * start the test.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MsgRecvHandler
+(
+    le_msg_MessageRef_t msgRef,
+    void* contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    if (le_msg_NeedsResponse(msgRef))
+    {
+        NeedsResponseMsgRef = msgRef;
+    }
+    else
+    {
+        NoResponseMsgRef = msgRef;
+    }
+
+    if ((NeedsResponseMsgRef != NULL) && (NoResponseMsgRef != NULL))
+    {
+        le_event_QueueFunction(ExhaustWindow, NULL, NULL);
+    }
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    LE_TEST_INFO("Window %d, request queue %d", WINDOW, QUEUE_SIZE);
+    LE_TEST_ASSERT(QUEUE_SIZE >= 3, "request queue is large enough for the test");
+
+    rpcProxyNetwork_InitializeOnce();
+
+    le_msg_ServiceRef_t serviceRef =
+        le_msg_InitLocalService(&FlowControlService,
+                                "rpcFlowControl",
+                                le_mem_InitStaticPool(FlowControlMessage,
+                                                      2,
+                                                      LE_MSG_LOCAL_HEADER_SIZE +
+                                                      MAX_PAYLOAD_SIZE));
+    le_msg_SetServiceRecvHandler(serviceRef, MsgRecvHandler, NULL);
+    le_msg_AdvertiseService(serviceRef);
+
+    le_msg_SessionRef_t sessionRef = le_msg_CreateLocalSession(&FlowControlService);
+    le_msg_OpenSessionSync(sessionRef);
+
+    le_msg_RequestResponse(le_msg_CreateMsg(sessionRef), NULL, NULL);
+    le_msg_Send(le_msg_CreateMsg(sessionRef));
+}
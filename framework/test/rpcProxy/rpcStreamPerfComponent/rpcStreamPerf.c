@@ -0,0 +1,388 @@
+/**
+ * This module is a microbenchmark for the RPC Proxy's outgoing message stream.  It measures how
+ * many proxied calls per second rpcProxy_SendVariableLengthMsg() can write to a local socket pair
+ * (standing in for the le_comm network link), and how many writes it makes per message.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "timing.h"
+#include "le_rpcProxy.h"
+#include "le_rpcProxyNetwork.h"
+#include "le_rpcProxyEventHandler.h"
+
+#include "cbor.h"
+
+#include <sys/uio.h>
+
+/// Number of messages sent in each run.
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_MESSAGES     1000
+#else
+#   define NUM_MESSAGES     100000
+#endif
+
+/// Maximum size of an IPC message payload.
+#define MAX_PAYLOAD_SIZE    512
+
+/// Protocol of the IPC messages being proxied.
+#define PROTOCOL_ID         "rpcStreamPerf"
+
+/// Session the IPC messages belong to.  It is never opened.
+static le_msg_SessionRef_t SessionRef;
+
+/// Socket the receiving thread reads from.
+static int ReceiveFd;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write all of a buffer to the socket standing in for the network link.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteAll
+(
+    int fd,             ///< [IN] Socket.
+    const void* buf,    ///< [IN] Data.
+    size_t len          ///< [IN] Size of data.
+)
+{
+    const uint8_t* dataPtr = buf;
+
+    while (len > 0)
+    {
+        ssize_t result = write(fd, dataPtr, len);
+
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return LE_COMM_ERROR;
+        }
+
+        dataPtr += result;
+        len -= result;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * le_comm stand-in: send data to the far side.  The handle is the socket's file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_comm_Send
+(
+    void* handle,
+    const void* buf,
+    size_t len
+)
+{
+    return WriteAll((int)(intptr_t)handle, buf, len);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * le_comm stand-in: send a list of data segments to the far side, with one writev() call (unless
+ * the socket accepts only some of the data).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_comm_SendVector
+(
+    void* handle,
+    const le_comm_Segment_t* segments,
+    size_t count
+)
+{
+    int fd = (int)(intptr_t)handle;
+    struct iovec iov[IOV_MAX];
+    size_t total = 0;
+    ssize_t result;
+    size_t i;
+
+    LE_ASSERT(count <= IOV_MAX);
+
+    for (i = 0; i < count; i++)
+    {
+        iov[i].iov_base = (void*)segments[i].buf;
+        iov[i].iov_len = segments[i].len;
+        total += segments[i].len;
+    }
+
+    do
+    {
+        result = writev(fd, iov, count);
+    }
+    while ((result < 0) && (errno == EINTR));
+
+    if (result < 0)
+    {
+        return LE_COMM_ERROR;
+    }
+
+    // Finish off anything the socket didn't take.
+    for (i = 0; (i < count) && ((size_t)result < total); i++)
+    {
+        if ((size_t)result >= segments[i].len)
+        {
+            result -= segments[i].len;
+            total -= segments[i].len;
+            continue;
+        }
+
+        if (WriteAll(fd, (const uint8_t*)segments[i].buf + result,
+                     segments[i].len - result) != LE_OK)
+        {
+            return LE_COMM_ERROR;
+        }
+        total -= segments[i].len;
+        result = 0;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stand-ins for the parts of the RPC Proxy that the stream uses, but which aren't needed to send
+ * the messages used by this benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcEventHandler_RepackOutgoingContext
+(
+    le_pack_SemanticTag_t    tagId,
+    void*                    contextPtr,
+    void**                   contextPtrPtr,
+    rpcProxy_Message_t*      proxyMessagePtr
+)
+{
+    LE_UNUSED(tagId);
+    LE_UNUSED(proxyMessagePtr);
+
+    *contextPtrPtr = contextPtr;
+    return LE_OK;
+}
+
+le_result_t rpcEventHandler_RepackIncomingContext
+(
+    le_pack_SemanticTag_t    tagId,
+    void*                    contextPtr,
+    void**                   contextPtrPtr,
+    rpcProxy_Message_t*      proxyMessagePtr
+)
+{
+    LE_UNUSED(tagId);
+    LE_UNUSED(proxyMessagePtr);
+
+    *contextPtrPtr = contextPtr;
+    return LE_OK;
+}
+
+void rpcProxyNetwork_DeleteNetworkCommunicationChannelByHandle
+(
+    void* handle
+)
+{
+    LE_TEST_FATAL("Unexpected deletion of communication channel %p", handle);
+}
+
+le_msg_MessageRef_t rpcProxy_GetMsgRefById
+(
+    uint32_t proxyId
+)
+{
+    LE_UNUSED(proxyId);
+    return NULL;
+}
+
+le_msg_ServiceRef_t rpcProxy_GetServiceRefById
+(
+    uint32_t serviceId
+)
+{
+    LE_UNUSED(serviceId);
+    return NULL;
+}
+
+le_msg_SessionRef_t rpcProxy_GetSessionRefById
+(
+    uint32_t serviceId
+)
+{
+    LE_UNUSED(serviceId);
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receiving thread: reads everything sent until the sending side is shut down.
+ *
+ * @return The number of bytes received, cast to a pointer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ReceiveThread
+(
+    void* contextPtr    ///< [IN] Unused.
+)
+{
+    static uint8_t buffer[64 * 1024];
+    size_t total = 0;
+    ssize_t result;
+
+    LE_UNUSED(contextPtr);
+
+    while ((result = read(ReceiveFd, buffer, sizeof(buffer))) != 0)
+    {
+        if (result < 0)
+        {
+            if (errno != EINTR)
+            {
+                LE_TEST_FATAL("Receive failed (%m)");
+            }
+            continue;
+        }
+        total += result;
+    }
+
+    return (void*)(uintptr_t)total;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build an IPC message holding a function call with a string and a byte array parameter.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_msg_MessageRef_t BuildIpcMessage
+(
+    size_t stringLen,   ///< [IN] Length of the string parameter.
+    size_t arrayLen     ///< [IN] Length of the byte array parameter.
+)
+{
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(SessionRef);
+    uint8_t* bufPtr = le_msg_GetPayloadPtr(msgRef);
+    uint8_t* endPtr = bufPtr + le_msg_GetMaxPayloadSize(msgRef);
+    uint32_t id = 3;
+
+    memcpy(bufPtr, &id, sizeof(id));
+    bufPtr += sizeof(id);
+
+    bufPtr += cbor_encode_indef_array_start(bufPtr, endPtr - bufPtr);
+    bufPtr += cbor_encode_uint(42, bufPtr, endPtr - bufPtr);
+    bufPtr += cbor_encode_uint(0x12345678, bufPtr, endPtr - bufPtr);
+    bufPtr += cbor_encode_string_start(stringLen, bufPtr, endPtr - bufPtr);
+    LE_ASSERT(bufPtr + stringLen + arrayLen + 16 < endPtr);
+    memset(bufPtr, 's', stringLen);
+    bufPtr += stringLen;
+    bufPtr += cbor_encode_bytestring_start(arrayLen, bufPtr, endPtr - bufPtr);
+    memset(bufPtr, 0xa5, arrayLen);
+    bufPtr += arrayLen;
+    bufPtr += cbor_encode_uint(7, bufPtr, endPtr - bufPtr);
+    bufPtr += cbor_encode_break(bufPtr, endPtr - bufPtr);
+
+    return msgRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send NUM_MESSAGES copies of a message over a fresh socket pair and report the results.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunTest
+(
+    const char* name,       ///< [IN] Name of the test.
+    void* messagePtr        ///< [IN] Proxy message to send.
+)
+{
+    int fds[2];
+    uint64_t writeTotal = 0;
+    void* receivedPtr;
+    int i;
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+    {
+        LE_TEST_FATAL("Failed to create socket pair (%m)");
+    }
+    ReceiveFd = fds[1];
+
+    le_thread_Ref_t receiver = le_thread_Create("rpcPerfRecv", ReceiveThread, NULL);
+    le_thread_SetJoinable(receiver);
+    le_thread_Start(receiver);
+
+    uint64_t startUs = timing_GetTimeUs();
+
+    for (i = 0; i < NUM_MESSAGES; i++)
+    {
+        uint32_t writeCount = 0;
+
+        if (rpcProxy_SendVariableLengthMsg((void*)(intptr_t)fds[0], messagePtr,
+                                           &writeCount) != LE_OK)
+        {
+            LE_TEST_FATAL("Failed to send %s message", name);
+        }
+        writeTotal += writeCount;
+    }
+
+    shutdown(fds[0], SHUT_WR);
+    le_thread_Join(receiver, &receivedPtr);
+
+    uint64_t elapsedUs = timing_GetTimeUs() - startUs;
+    size_t received = (size_t)(uintptr_t)receivedPtr;
+
+    close(fds[0]);
+    close(fds[1]);
+
+    LE_TEST_OK(received > 0, "%s: sent %d messages, %" PRIuS " bytes each",
+               name, NUM_MESSAGES, received / NUM_MESSAGES);
+    LE_TEST_INFO("%s: %" PRIu64 " messages/s, %.1f MB/s, %.2f writes per message",
+                 name,
+                 (uint64_t)NUM_MESSAGES * 1000000 / elapsedUs,
+                 (double)received / elapsedUs,
+                 (double)writeTotal / NUM_MESSAGES);
+}
+
+
+COMPONENT_INIT
+{
+    static rpcProxy_FileStreamMessage_t fileStreamMessage;
+    rpcProxy_Message_t ipcMessage;
+
+    LE_TEST_PLAN(3);
+
+    le_msg_ProtocolRef_t protocolRef = le_msg_GetProtocolRef(PROTOCOL_ID, MAX_PAYLOAD_SIZE);
+    SessionRef = le_msg_CreateSession(protocolRef, "rpcStreamPerf");
+
+    memset(&ipcMessage, 0, sizeof(ipcMessage));
+    ipcMessage.commonHeader.id = 1;
+    ipcMessage.commonHeader.serviceId = 2;
+    ipcMessage.commonHeader.type = RPC_PROXY_CLIENT_REQUEST;
+
+    ipcMessage.msgRef = BuildIpcMessage(16, 16);
+    RunTest("small call", &ipcMessage);
+    le_msg_ReleaseMsg(ipcMessage.msgRef);
+
+    ipcMessage.msgRef = BuildIpcMessage(200, 256);
+    RunTest("large call", &ipcMessage);
+    le_msg_ReleaseMsg(ipcMessage.msgRef);
+
+    fileStreamMessage.commonHeader.id = 1;
+    fileStreamMessage.commonHeader.serviceId = 2;
+    fileStreamMessage.commonHeader.type = RPC_PROXY_FILESTREAM_MESSAGE;
+    fileStreamMessage.metaData.fileStreamId = 5;
+    fileStreamMessage.metaData.fileStreamFlags = 1;
+    fileStreamMessage.metaData.isFileStreamValid = true;
+    fileStreamMessage.payloadSize = sizeof(fileStreamMessage.payload);
+    memset(fileStreamMessage.payload, 0x5a, sizeof(fileStreamMessage.payload));
+    RunTest("file stream", &fileStreamMessage);
+
+    LE_TEST_EXIT;
+}
@@ -16,7 +16,7 @@
 
 // One test per timer, plus some additional tests after
 #define TESTS_PER_TIMER 1
-#define ADDITIONAL_TEST_COUNT 18
+#define ADDITIONAL_TEST_COUNT 23
 
 // Format and log time values
 #define LOG_TIME_MSG(msg, tm) \
@@ -212,6 +212,36 @@ static void MediumTimerExpiryHandler
 }
 
 
+static void SlackTimerExpiryHandler
+(
+    le_timer_Ref_t timerRef    ///< This timer has expired
+)
+{
+    // The slack timer expires at 3.5 seconds, but has 1 second of slack, so it should be
+    // delivered on the same wakeup as the medium timer, at 4 seconds.
+    le_clk_Time_t expiryInterval = { 3, 500000 };
+    le_clk_Time_t expectedInterval = { 4, 0 };
+    le_clk_Time_t* startTimePtr = pthread_getspecific(StartTimeKey);
+    LE_ASSERT(startTimePtr != NULL);
+    le_clk_Time_t diffTime = le_clk_Sub( le_clk_GetRelativeTime(), *startTimePtr);
+    bool testFailed = le_clk_GreaterThan(expiryInterval, diffTime) ||
+                      le_clk_GreaterThan(le_clk_Sub(diffTime, expectedInterval), TimerTolerance);
+    LE_TEST_OK(!testFailed, "slack timer expired with the medium timer");
+    if ( testFailed )
+    {
+        LOG_TIME_MSG("Expected Duration", expectedInterval);
+        LOG_TIME_MSG("Actual Duration", diffTime);
+    }
+
+    // Verify that mediumTimer (passed in as contextPtr) has already expired
+    le_timer_Ref_t mediumTimer = le_timer_GetContextPtr(timerRef);
+    uint32_t expiryCount = le_timer_GetExpiryCount(mediumTimer);
+
+    LE_TEST_OK(expiryCount == 1, "Medium timer expired before slack timer (expired %"PRIu32
+               " times)", expiryCount);
+}
+
+
 static void AdditionalTests
 (
     le_timer_Ref_t oldTimer
@@ -222,6 +252,7 @@ static void AdditionalTests
     le_timer_Ref_t mediumTimer;
     le_timer_Ref_t veryShortTimer;
     le_timer_Ref_t longTimer;
+    le_timer_Ref_t slackTimer;
     le_clk_Time_t oneSecInterval = { 1, 0 };
 
     LE_TEST_INFO("\n ==================== Additional Tests =================");
@@ -265,6 +296,13 @@ static void AdditionalTests
     le_timer_SetHandler(longTimer, LongTimerExpiryHandler);
     le_timer_SetContextPtr(longTimer, mediumTimer); // checks that medium timer expired.
     LE_TEST_OK(le_timer_GetMsInterval(longTimer) == 5000, "set long timer interval");
+
+    slackTimer = le_timer_Create("slack timer");
+    LE_TEST_ASSERT(slackTimer, "created slack timer");
+    le_timer_SetMsInterval(slackTimer, 3500);
+    LE_TEST_OK(le_timer_SetMsSlack(slackTimer, 1000) == LE_OK, "set slack timer slack");
+    le_timer_SetHandler(slackTimer, SlackTimerExpiryHandler);
+    le_timer_SetContextPtr(slackTimer, mediumTimer); // checks that medium timer expired first.
     LE_TEST_INFO("Finished creating new timers; verify that default pool was not expanded");
 
     le_clk_Time_t* startTimePtr = pthread_getspecific(StartTimeKey);
@@ -274,6 +312,9 @@ static void AdditionalTests
     le_timer_Start(mediumTimer);
     le_timer_Start(veryShortTimer);
     le_timer_Start(longTimer);
+    le_timer_Start(slackTimer);
+    LE_TEST_OK(le_timer_SetMsSlack(slackTimer, 0) == LE_BUSY,
+               "Cannot change slack of a running timer");
 
     // Sleep 1 second for testing purpose only
     le_thread_Sleep(1);
@@ -0,0 +1,107 @@
+/**
+ * Timing helpers shared by the performance tests.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "timing.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current time, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t timing_GetTimeUs
+(
+    void
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    return (uint64_t)now.sec * 1000000 + now.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear a set of samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void timing_InitStats
+(
+    timing_Stats_t* statsPtr    ///< [OUT] Samples to clear.
+)
+{
+    statsPtr->minUs = UINT64_MAX;
+    statsPtr->maxUs = 0;
+    statsPtr->totalUs = 0;
+    statsPtr->count = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a sample to a set.
+ */
+//--------------------------------------------------------------------------------------------------
+void timing_AddSample
+(
+    timing_Stats_t* statsPtr,   ///< [IN/OUT] Samples to add to.
+    uint64_t        elapsedUs   ///< [IN] Time of the sample.
+)
+{
+    statsPtr->totalUs += elapsedUs;
+    statsPtr->count++;
+
+    if (elapsedUs < statsPtr->minUs)
+    {
+        statsPtr->minUs = elapsedUs;
+    }
+    if (elapsedUs > statsPtr->maxUs)
+    {
+        statsPtr->maxUs = elapsedUs;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make TIMING_WARMUP_COUNT untimed calls, then time a number of calls, one sample each.
+ *
+ * @return The number of timed calls that didn't give the expected result.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t timing_TimeCalls
+(
+    timing_CallFunc_t   callFunc,   ///< [IN] Function to call.
+    void*               contextPtr, ///< [IN] Context to give the function.
+    uint32_t            callCount,  ///< [IN] Number of calls to time.
+    timing_Stats_t*     statsPtr    ///< [OUT] Times of the calls.
+)
+{
+    uint32_t failCount = 0;
+    uint32_t i;
+
+    for (i = 0; i < TIMING_WARMUP_COUNT; i++)
+    {
+        callFunc(i, contextPtr);
+    }
+
+    timing_InitStats(statsPtr);
+
+    for (i = 0; i < callCount; i++)
+    {
+        uint64_t startUs = timing_GetTimeUs();
+        bool isOk = callFunc(i, contextPtr);
+        timing_AddSample(statsPtr, timing_GetTimeUs() - startUs);
+
+        if (!isOk)
+        {
+            failCount++;
+        }
+    }
+
+    return failCount;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file timing.h
+ *
+ * Timing helpers shared by the performance tests: reading the clock in microseconds, keeping the
+ * minimum, maximum and total of a set of timed samples, and timing a number of calls after a few
+ * untimed warm-up calls.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef TIMING_TIMING_H
+#define TIMING_TIMING_H
+
+/// Number of untimed calls made first, to get pools and caches warmed up.
+#define TIMING_WARMUP_COUNT     100
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Times of a set of samples, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t minUs;         ///< Shortest sample.
+    uint64_t maxUs;         ///< Longest sample.
+    uint64_t totalUs;       ///< Sum of the samples.
+    uint32_t count;         ///< Number of samples.
+}
+timing_Stats_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function called by timing_TimeCalls() for each call to time.
+ *
+ * @return true if the call gave the expected result.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef bool (*timing_CallFunc_t)
+(
+    uint32_t    index,      ///< [IN] Number of the call, counting from 0.
+    void*       contextPtr  ///< [IN] Context given to timing_TimeCalls().
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current time, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t timing_GetTimeUs
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear a set of samples.
+ */
+//--------------------------------------------------------------------------------------------------
+void timing_InitStats
+(
+    timing_Stats_t* statsPtr    ///< [OUT] Samples to clear.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a sample to a set.
+ */
+//--------------------------------------------------------------------------------------------------
+void timing_AddSample
+(
+    timing_Stats_t* statsPtr,   ///< [IN/OUT] Samples to add to.
+    uint64_t        elapsedUs   ///< [IN] Time of the sample.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make TIMING_WARMUP_COUNT untimed calls, then time a number of calls, one sample each.
+ *
+ * @return The number of timed calls that didn't give the expected result.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t timing_TimeCalls
+(
+    timing_CallFunc_t   callFunc,   ///< [IN] Function to call.
+    void*               contextPtr, ///< [IN] Context to give the function.
+    uint32_t            callCount,  ///< [IN] Number of calls to time.
+    timing_Stats_t*     statsPtr    ///< [OUT] Times of the calls.
+);
+
+#endif
@@ -507,6 +507,17 @@ class EventFunction(Function):
         self.event = eventObj
 
 
+def GetMessagePadding():
+    """
+    Get number of bytes reserved in every message buffer on top of its packed parameters, for
+    required output parameters, array headers and (with RPC) tags.
+    """
+    padding = 8
+    if (os.environ.get('LE_CONFIG_RPC') == "y"):
+        # Include two 1-byte TagIDs
+        padding = padding + 3 + 3
+    return padding
+
 #---------------------------------------------------------------------------------------------------
 # AST definition
 #---------------------------------------------------------------------------------------------------
@@ -671,11 +682,7 @@ class Interface(object):
         the return value (if the function has one), and all input and output parameters.
         optional 3 bytes for async tag : only needed if there's handler
         """
-        padding = 8
-        if (os.environ.get('LE_CONFIG_RPC') == "y"):
-            # Include two 1-byte TagIDs
-            padding = padding + 3 + 3
-        return padding + max([1] +
+        return GetMessagePadding() + max([1] +
                        [function.GetMessageSize() for function in self.functions.values()] +
                        [handler.GetMessageSize()
                         for handler in self.types.values() if isinstance(handler, HandlerType)])
@@ -40,6 +40,8 @@ Filters = { 'DecorateName':        codeGenHelpers.DecorateName,
             'CAPIParameters':        codeGenHelpers.IterCAPIParameters,
             'MaxCOutputBuffers':     codeGenHelpers.GetMaxCOutputBuffers,
             'LocalMessageSize':      codeGenHelpers.GetLocalMessageSize,
+            'MessageSize':           codeGenHelpers.GetMessageSize,
+            'MessageSizeClasses':    codeGenHelpers.GetMessageSizeClasses,
             'SizePointerTag':        codeGenHelpers.GetSizePointerTag}
 
 
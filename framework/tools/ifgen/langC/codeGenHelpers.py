@@ -401,6 +401,39 @@ def GetLocalMessageSize(interface, pointerSize):
                     for handler in interface.types.values()
                     if isinstance(handler, interfaceIR.HandlerType)])
 
+def GetMessageSize(messageObj):
+    """
+    Get size of largest possible message to a single function or handler, including the 4-byte
+    message ID.  This is never more than the size of the interface's message type.
+    """
+    return interfaceIR.UINT32_TYPE.size + \
+        interfaceIR.GetMessagePadding() + \
+        messageObj.GetMessageSize()
+
+def GetMessageSizeClasses(interface, maxClasses=3):
+    """
+    Get message sizes to create separate message pools for, largest first.
+
+    Starting from the interface's largest message, a function or handler's message size becomes a
+    new size class if it is at most a quarter of the previous class, so each class is small enough
+    to be worth its own pool.
+    """
+    sizes = set([GetMessageSize(function) for function in interface.functions.values()] +
+                [GetMessageSize(handler)
+                 for handler in interface.types.values()
+                 if isinstance(handler, interfaceIR.HandlerType)])
+
+    classes = []
+    currentSize = interfaceIR.UINT32_TYPE.size + interface.GetMessageSize()
+    for size in sorted(sizes, reverse=True):
+        if len(classes) >= maxClasses:
+            break
+        if size * 4 <= currentSize:
+            classes.append(size)
+            currentSize = size
+
+    return classes
+
 def GetCOutputBufferCount(function):
     outputCount = 0
     for parameter in function.parameters:
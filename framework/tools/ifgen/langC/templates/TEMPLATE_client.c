@@ -127,9 +127,25 @@ static le_result_t InitClientForThread
 
     sessionRef = le_msg_CreateLocalSession(LE_CDATA_THIS->_ClientServicePtr);
 {%- else %}
+    {%- set sizeClasses = interface|MessageSizeClasses %}
     le_msg_ProtocolRef_t protocolRef;
-
-    protocolRef = le_msg_GetProtocolRef(PROTOCOL_ID_STR, sizeof(_Message_t));
+    {%- if sizeClasses %}
+    // Smaller message sizes to keep separate pools for, so that small messages don't take up
+    // blocks big enough for the largest one.
+    static const size_t sizeClasses[] = { {{sizeClasses|join(", ")}} };
+    {%- endif %}
+
+    protocolRef = le_msg_GetProtocolRefWithPools(PROTOCOL_ID_STR,
+                                                 sizeof(_Message_t),
+    {%- if sizeClasses %}
+                                                 sizeClasses,
+                                                 NUM_ARRAY_MEMBERS(sizeClasses),
+    {%- else %}
+                                                 NULL,
+                                                 0,
+    {%- endif %}
+                                                 LE_MEM_BLOCKS({{apiName}}_Messages,
+                                                               HIGH_MESSAGE_COUNT));
     sessionRef = le_msg_CreateSession(protocolRef, SERVICE_INSTANCE_NAME);
 {%- endif %}
     le_result_t result = ifgen_{{apiBaseName}}_OpenSession(sessionRef, isBlocking);
@@ -422,7 +422,7 @@ LE_SHARED {{function.returnType|FormatType(useBaseName=True)}} ifgen_{{apiBaseNa
 
 
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(_ifgen_sessionRef);
+    _msgRef = le_msg_CreateSizedMsg(_ifgen_sessionRef, {{function|MessageSize}});
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_{{apiBaseName}}_{{function.name}};
     _msgBufPtr = _msgPtr->buffer;
@@ -464,6 +464,7 @@ LE_SHARED {{function.returnType|FormatType(useBaseName=True)}} ifgen_{{apiBaseNa
     {{- pack.PackInputs(function.parameters,initiatorWaits=True) }}
     {%- endif %}
     le_pack_PackEndOfIndefArray(&_msgBufPtr);
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
 
     // Send a request to the server and get the response.
     TRACE("Sending message to server and waiting for response : %ti bytes sent",
@@ -27,6 +27,9 @@
 #define _MAX_MSG_SIZE IFGEN_{{apiBaseName|upper}}_LOCAL_MSG_SIZE
 {%- else %}
 #define _MAX_MSG_SIZE IFGEN_{{apiBaseName|upper}}_MSG_SIZE
+
+// Expected number of simultaneous messages of each size
+#define HIGH_MESSAGE_COUNT 10
 {%- endif %}
 
 // Define the message type for communicating between client and server
@@ -454,9 +454,25 @@ void {{apiName}}_AdvertiseService
 
     // Start the server side of the service
     {%- if not args.localService %}
+    {%- set sizeClasses = interface|MessageSizeClasses %}
     le_msg_ProtocolRef_t protocolRef;
+    {%- if sizeClasses %}
+    // Smaller message sizes to keep separate pools for, so that small messages don't take up
+    // blocks big enough for the largest one.
+    static const size_t sizeClasses[] = { {{sizeClasses|join(", ")}} };
+    {%- endif %}
 
-    protocolRef = le_msg_GetProtocolRef(PROTOCOL_ID_STR, sizeof(_Message_t));
+    protocolRef = le_msg_GetProtocolRefWithPools(PROTOCOL_ID_STR,
+                                                 sizeof(_Message_t),
+    {%- if sizeClasses %}
+                                                 sizeClasses,
+                                                 NUM_ARRAY_MEMBERS(sizeClasses),
+    {%- else %}
+                                                 NULL,
+                                                 0,
+    {%- endif %}
+                                                 LE_MEM_BLOCKS({{apiName}}_Messages,
+                                                               HIGH_MESSAGE_COUNT));
     LE_CDATA_THIS->_ServerServiceRef = le_msg_CreateService(protocolRef, SERVICE_INSTANCE_NAME);
     {%- endif %}
     le_msg_SetServiceRecvHandler(LE_CDATA_THIS->_ServerServiceRef, ServerMsgRecvHandler, NULL);
@@ -584,7 +600,8 @@ static void AsyncResponse_{{apiName}}_{{function.name}}
     __attribute__((unused)) uint8_t* _msgBufPtr;
 
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(serverDataPtr->clientSessionRef);
+    _msgRef = le_msg_CreateSizedMsg(serverDataPtr->clientSessionRef,
+                                    {{handler.apiType|MessageSize}});
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_{{apiBaseName}}_{{function.name}};
     _msgBufPtr = _msgPtr->buffer;
@@ -605,6 +622,7 @@ static void AsyncResponse_{{apiName}}_{{function.name}}
     {{ pack.PackInputs(handler.apiType.parameters) }}
 
     le_pack_PackEndOfIndefArray(&_msgBufPtr);
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
 
     // Send the async response to the client
     TRACE("Sending message to client session %p : %ti bytes sent",
@@ -682,6 +700,7 @@ void {{apiName}}_{{function.name}}Respond
     {{- pack.PackOutputs(function.parameters,initiatorWaits=True) }}
 
     le_pack_PackEndOfIndefArray(&_msgBufPtr);
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
 
     {%- if args.localService %}
 
@@ -990,6 +1009,7 @@ static void Handle_{{apiName}}_{{function.name}}
     // Pack any "out" parameters
     {{- pack.PackOutputs(function.parameters,initiatorWaits=True) }}
     le_pack_PackEndOfIndefArray(&_msgBufPtr);
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
 
     // Return the response
     TRACE("Sending response to client session %p : %ti bytes sent",
@@ -2092,7 +2092,11 @@ static ColumnInfo_t SessionObjTableInfo[] =
     {"INTERFACE NAME", "%*s", NULL, "%*s", LIMIT_MAX_IPC_INTERFACE_NAME_BYTES, true,  0, true},
     {"STATE",          "%*s", NULL, "%*s", 0,                                  true,  0, true},
     {"THREAD NAME",    "%*s", NULL, "%*s", MAX_THREAD_NAME_SIZE,               true,  0, true},
-    {"FD",             "%*s", NULL, "%*d", sizeof(int),                        false, 0, false}
+    {"FD",             "%*s", NULL, "%*d", sizeof(int),                        false, 0, false},
+    {"TX MSGS",        "%*s", NULL, "%*zu", sizeof(size_t),                    false, 0, false},
+    {"TX CALLS",       "%*s", NULL, "%*zu", sizeof(size_t),                    false, 0, false},
+    {"RX MSGS",        "%*s", NULL, "%*zu", sizeof(size_t),                    false, 0, false},
+    {"RX CALLS",       "%*s", NULL, "%*zu", sizeof(size_t),                    false, 0, false}
 };
 static size_t SessionObjTableInfoSize = NUM_ARRAY_MEMBERS(SessionObjTableInfo);
 #endif
@@ -4114,6 +4118,14 @@ static int PrintSessionObjInfo
                                                  SessionObjTableInfoSize, &index);
         FillIntColField(sessionObjRef->socketFd, SessionObjTableInfo,
                                                  SessionObjTableInfoSize, &index);
+        FillSizeTColField(sessionObjRef->txMsgCount,  SessionObjTableInfo,
+                                                      SessionObjTableInfoSize, &index);
+        FillSizeTColField(sessionObjRef->txCallCount, SessionObjTableInfo,
+                                                      SessionObjTableInfoSize, &index);
+        FillSizeTColField(sessionObjRef->rxMsgCount,  SessionObjTableInfo,
+                                                      SessionObjTableInfoSize, &index);
+        FillSizeTColField(sessionObjRef->rxCallCount, SessionObjTableInfo,
+                                                      SessionObjTableInfoSize, &index);
 
         PrintInfo(SessionObjTableInfo, SessionObjTableInfoSize);
         lineCount++;
@@ -4142,6 +4154,14 @@ static int PrintSessionObjInfo
                                                  SessionObjTableInfoSize, &index, &printed);
         ExportIntToJson(sessionObjRef->socketFd, SessionObjTableInfo,
                                                  SessionObjTableInfoSize, &index, &printed);
+        ExportSizeTToJson(sessionObjRef->txMsgCount,  SessionObjTableInfo,
+                                                      SessionObjTableInfoSize, &index, &printed);
+        ExportSizeTToJson(sessionObjRef->txCallCount, SessionObjTableInfo,
+                                                      SessionObjTableInfoSize, &index, &printed);
+        ExportSizeTToJson(sessionObjRef->rxMsgCount,  SessionObjTableInfo,
+                                                      SessionObjTableInfoSize, &index, &printed);
+        ExportSizeTToJson(sessionObjRef->rxCallCount, SessionObjTableInfo,
+                                                      SessionObjTableInfoSize, &index, &printed);
 
         printf("]");
     }
@@ -53,6 +53,7 @@ $ log stoptrace keyword processName/componentName
 #include "log.h"
 #include "logDaemon.h"
 #include "limit.h"
+#include "fileDescriptor.h"
 #include <ctype.h>
 
 
@@ -119,6 +120,7 @@ static void PrintHelpAndExit
         "    log trace KEYWORD_STR [DESTINATION]\n"
         "    log stoptrace KEYWORD_STR [DESTINATION]\n"
         "    log forget PROCESS_NAME\n"
+        "    log dump\n"
         "\n"
         "DESCRIPTION:\n"
         "    log list            Lists all processes/components registered with the\n"
@@ -146,6 +148,9 @@ static void PrintHelpAndExit
         "                        Future processes with that name will have default\n"
         "                        settings.\n"
         "\n"
+        "    log dump            Prints the most recent messages collected by the log\n"
+        "                        daemon from processes that use binary logging.\n"
+        "\n"
         "The [DESTINATION] is optional and specifies the process and component to\n"
         "send the command to.  The [DESTINATION] must be in this format:\n"
         "\n"
@@ -184,8 +189,33 @@ static void MsgReceiveHandler
 )
 {
     const char* responseStr = le_msg_GetPayloadPtr(msgRef);
+    int fd = le_msg_GetFd(msgRef);
+
+    if (fd >= 0)
+    {
+        // The Log Control Daemon sent us a file (e.g., a log dump), so copy it to stdout.
+        char buffer[4096];
+        ssize_t bytesRead;
+
+        fflush(stdout);
+
+        while ((bytesRead = fd_ReadSize(fd, buffer, sizeof(buffer))) > 0)
+        {
+            if (fd_WriteSize(STDOUT_FILENO, buffer, bytesRead) != bytesRead)
+            {
+                ErrorOccurred = true;
+                break;
+            }
+        }
+
+        fd_Close(fd);
+    }
+
     // Print out whatever the Log Control Daemon sent us.
-    printf("%s\n", responseStr);
+    if ((fd < 0) || (responseStr[0] != '\0'))
+    {
+        printf("%s\n", responseStr);
+    }
 
     // If the first character of the response is a '*', then there has been an error.
     if (responseStr[0] == '*')
@@ -522,6 +552,12 @@ static void CommandArgHandler
 
         // This command has no parameters and no destination.
     }
+    else if (strcmp(command, "dump") == 0)
+    {
+        Command = LOG_CMD_DUMP;
+
+        // This command has no parameters and no destination.
+    }
     else if (strcmp(command, "forget") == 0)
     {
         Command = LOG_CMD_FORGET_PROCESS;
@@ -574,8 +610,9 @@ COMPONENT_INIT
             break;
 
         case LOG_CMD_LIST_COMPONENTS:
+        case LOG_CMD_DUMP:
 
-            // This one has no arguments.
+            // These have no arguments.
 
             break;
 